@@ -1448,7 +1448,9 @@ void init_pypddl(py::module &m) {
       .def(py::init<const Task &>(), py::arg("task"), py::keep_alive<1, 2>())
       .def("get_applicable_actions",
            &ApplicableActionsGenerator::get_applicable_actions,
-           py::arg("state"), py::arg("check_numeric") = true);
+           py::arg("state"), py::arg("check_numeric") = true)
+      .def_property_readonly("num_ground_actions",
+                             &ApplicableActionsGenerator::num_ground_actions);
 
   py::class_<SuccessorGenerator>(m, "_PDDL_SuccessorGenerator_")
       .def(py::init<const Task &>(), py::arg("task"), py::keep_alive<1, 2>())
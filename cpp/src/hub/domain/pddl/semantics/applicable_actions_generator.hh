@@ -6,22 +6,16 @@
 #define SKDECIDE_PDDL_SEMANTICS_APPLICABLE_ACTIONS_GENERATOR_HH
 
 #include <memory>
-#include <string>
-#include <unordered_map>
 #include <vector>
 
 #include "state.hh"
 
-namespace Clingo {
-class Control;
-class Symbol;
-} // namespace Clingo
-
 namespace skdecide {
 
 namespace pddl {
 
 class Task;
+class GroundActionTree;
 
 struct GroundAction {
   int action_id;
@@ -41,6 +35,13 @@ struct GroundAction {
   }
 };
 
+/**
+ * @brief Computes the ground actions applicable in a state.
+ *
+ * The actions are grounded once with Clingo at construction and compiled into
+ * a GroundActionTree, so that no solver is invoked per state. The generator
+ * is read-only after construction and can thus be shared between threads.
+ */
 class ApplicableActionsGenerator {
 public:
   ApplicableActionsGenerator(const Task &task);
@@ -49,21 +50,11 @@ public:
   std::vector<GroundAction>
   get_applicable_actions(const State &state, bool check_numeric = true) const;
 
-private:
-  void set_state(const State &state) const;
-  void clear_state() const;
+  std::size_t num_ground_actions() const;
 
+private:
   const Task &_task;
-  std::unique_ptr<Clingo::Control> _ctl;
-  std::string _asp_program;
-
-  struct PredicateExternalInfo {
-    std::string safe_name;
-    int arity;
-  };
-  std::vector<PredicateExternalInfo> _pred_externals;
-
-  bool _has_numeric_preconditions;
+  std::unique_ptr<GroundActionTree> _actions;
 };
 
 } // namespace pddl
@@ -0,0 +1,823 @@
+/* Copyright (c) AIRBUS and its affiliates.
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#include "compiled_operator.hh"
+#include "task.hh"
+
+#include "../aggregation_effect.hh"
+#include "../aggregation_formula.hh"
+#include "../assignment_effect.hh"
+#include "../comparison_formula.hh"
+#include "../conditional_effect.hh"
+#include "../duration_expression.hh"
+#include "../equality_formula.hh"
+#include "../function_expression.hh"
+#include "../imply_formula.hh"
+#include "../minus_expression.hh"
+#include "../negation_effect.hh"
+#include "../negation_formula.hh"
+#include "../numerical_expression.hh"
+#include "../operation_expression.hh"
+#include "../operator.hh"
+#include "../optimization_expression.hh"
+#include "../predicate.hh"
+#include "../predicate_effect.hh"
+#include "../predicate_formula.hh"
+#include "../probabilistic_effect.hh"
+#include "../quantified_effect.hh"
+#include "../quantified_formula.hh"
+#include "../reward_expression.hh"
+#include "../term.hh"
+#include "../timed_effect.hh"
+#include "../timed_expression.hh"
+#include "../timed_formula.hh"
+#include "../totalcost_expression.hh"
+#include "../totaltime_expression.hh"
+#include "../type.hh"
+#include "../variable.hh"
+
+#include "../impl/aggregation_effect_impl.hh"
+#include "../impl/aggregation_formula_impl.hh"
+#include "../impl/assignment_effect_impl.hh"
+#include "../impl/binary_expression_impl.hh"
+#include "../impl/binary_formula_impl.hh"
+#include "../impl/comparison_formula_impl.hh"
+#include "../impl/quantified_effect_impl.hh"
+#include "../impl/quantified_formula_impl.hh"
+
+#include <cmath>
+#include <stdexcept>
+
+namespace skdecide {
+
+namespace pddl {
+
+namespace {
+
+// Calls f() for each assignment of the quantified slots, in the order of the
+// lifted semantics, until f() returns false; returns false if interrupted
+template <typename Tquantifier, typename Function>
+bool for_each_assignment(const Tquantifier &quantifier, std::vector<int> &slots,
+                         const Function &f) {
+  std::size_t nb = quantifier.slots.size();
+  for (auto &domain : quantifier.domains) {
+    if (domain.empty()) {
+      return true;
+    }
+  }
+  std::vector<std::size_t> positions(nb, 0);
+  for (std::size_t i = 0; i < nb; ++i) {
+    slots[quantifier.slots[i]] = quantifier.domains[i][0];
+  }
+  while (true) {
+    if (!f()) {
+      return false;
+    }
+    // Odometer increment, last variable first
+    std::size_t i = nb;
+    while (i > 0) {
+      --i;
+      if (++positions[i] < quantifier.domains[i].size()) {
+        slots[quantifier.slots[i]] = quantifier.domains[i][positions[i]];
+        break;
+      }
+      positions[i] = 0;
+      slots[quantifier.slots[i]] = quantifier.domains[i][0];
+      if (i == 0) {
+        return true;
+      }
+    }
+    if (nb == 0) {
+      return true;
+    }
+  }
+}
+
+} // namespace
+
+// Slot values of the ground operator being evaluated, and scratch tuple for
+// atom lookups
+struct CompiledOperator::Context {
+  const Task &task;
+  std::vector<int> slots;
+  GroundTuple tuple;
+};
+
+CompiledOperator::CompiledOperator(const Task &task,
+                                   std::vector<std::string> parameters,
+                                   const std::shared_ptr<Formula> &condition,
+                                   const std::shared_ptr<Effect> &effect)
+    : _parameters(std::move(parameters)),
+      _nb_slots(static_cast<int>(_parameters.size())), _condition(-1),
+      _effect(-1) {
+  Scope scope;
+  for (std::size_t i = 0; i < _parameters.size(); ++i) {
+    scope.emplace_back(_parameters[i], static_cast<int>(i));
+  }
+  if (condition) {
+    _condition = compile_formula(task, condition, scope);
+  }
+  if (effect) {
+    _effect = compile_effect(task, effect, scope);
+  }
+}
+
+template <typename Toperator>
+std::shared_ptr<const CompiledOperator>
+CompiledOperator::compile(const Task &task, const Toperator &op) {
+  std::vector<std::string> parameters;
+  for (auto &var : op.get_variables()) {
+    parameters.push_back(var->get_name());
+  }
+  return std::make_shared<CompiledOperator>(
+      task, std::move(parameters), op.get_condition(), op.get_effect());
+}
+
+template std::shared_ptr<const CompiledOperator>
+CompiledOperator::compile(const Task &, const Action &);
+template std::shared_ptr<const CompiledOperator>
+CompiledOperator::compile(const Task &, const DurativeAction &);
+template std::shared_ptr<const CompiledOperator>
+CompiledOperator::compile(const Task &, const Event &);
+template std::shared_ptr<const CompiledOperator>
+CompiledOperator::compile(const Task &, const Process &);
+
+std::vector<int> CompiledOperator::arguments(const Binding &binding) const {
+  std::vector<int> result;
+  result.reserve(_parameters.size());
+  for (auto &name : _parameters) {
+    auto it = binding.find(name);
+    if (it == binding.end()) {
+      throw std::runtime_error("Unbound variable: " + name);
+    }
+    result.push_back(it->second);
+  }
+  return result;
+}
+
+// === Compilation ===
+
+bool CompiledOperator::compile_term(const Task &task,
+                                    const std::shared_ptr<Term> &term,
+                                    const Scope &scope, int &result) {
+  const std::string &name = term->get_name();
+  if (!name.empty() && name[0] == '?') {
+    // Innermost variables shadow the outer ones
+    for (auto it = scope.rbegin(); it != scope.rend(); ++it) {
+      if (it->first == name) {
+        result = it->second;
+        return true;
+      }
+    }
+    return false;
+  }
+  try {
+    result = -(task.object_id(name) + 1);
+  } catch (const std::runtime_error &) {
+    return false;
+  }
+  return true;
+}
+
+bool CompiledOperator::compile_terms(
+    const Task &task, const std::vector<std::shared_ptr<Term>> &terms,
+    const Scope &scope, std::vector<int> &result) {
+  result.resize(terms.size());
+  for (std::size_t i = 0; i < terms.size(); ++i) {
+    if (!compile_term(task, terms[i], scope, result[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename Tvariables>
+CompiledOperator::Quantifier
+CompiledOperator::compile_quantifier(const Task &task,
+                                     const Tvariables &variables,
+                                     Scope &scope) {
+  Quantifier quantifier;
+  for (auto &var : variables) {
+    auto &types = var->get_types();
+    std::string type_name =
+        types.empty() ? "object" : (*types.begin())->get_name();
+    quantifier.slots.push_back(_nb_slots);
+    quantifier.domains.push_back(task.objects_of_type(type_name));
+    scope.emplace_back(var->get_name(), _nb_slots++);
+  }
+  return quantifier;
+}
+
+int CompiledOperator::lifted_formula(const std::shared_ptr<Formula> &formula,
+                                     const Scope &scope) {
+  FormulaNode node;
+  node.kind = FormulaKind::Lifted;
+  node.lifted = static_cast<int>(_lifted_formulas.size());
+  _lifted_formulas.push_back({formula, scope});
+  _formulas.push_back(std::move(node));
+  return static_cast<int>(_formulas.size()) - 1;
+}
+
+int CompiledOperator::lifted_expression(
+    const std::shared_ptr<Expression> &expression, const Scope &scope) {
+  ExpressionNode node;
+  node.kind = ExpressionKind::Lifted;
+  node.lifted = static_cast<int>(_lifted_expressions.size());
+  _lifted_expressions.push_back({expression, scope});
+  _expressions.push_back(std::move(node));
+  return static_cast<int>(_expressions.size()) - 1;
+}
+
+int CompiledOperator::lifted_effect(const std::shared_ptr<Effect> &effect,
+                                    const Scope &scope) {
+  EffectNode node;
+  node.kind = EffectKind::Lifted;
+  node.lifted = static_cast<int>(_lifted_effects.size());
+  _lifted_effects.push_back({effect, scope});
+  _effects.push_back(std::move(node));
+  return static_cast<int>(_effects.size()) - 1;
+}
+
+int CompiledOperator::compile_formula(const Task &task,
+                                      const std::shared_ptr<Formula> &formula,
+                                      const Scope &scope) {
+  FormulaNode node;
+  Formula *f = formula.get();
+
+  if (auto *pf = dynamic_cast<PredicateFormula *>(f)) {
+    node.kind = FormulaKind::Atom;
+    try {
+      node.atom.symbol = task.predicate_id(pf->get_predicate()->get_name());
+    } catch (const std::runtime_error &) {
+      return lifted_formula(formula, scope);
+    }
+    if (!compile_terms(task, pf->get_terms(), scope, node.atom.terms)) {
+      return lifted_formula(formula, scope);
+    }
+  } else if (auto *nf = dynamic_cast<NegationFormula *>(f)) {
+    node.kind = FormulaKind::Not;
+    node.children.push_back(compile_formula(task, nf->get_formula(), scope));
+  } else if (auto *cf = dynamic_cast<ConjunctionFormula *>(f)) {
+    node.kind = FormulaKind::And;
+    for (auto &sub : cf->get_formulas()) {
+      node.children.push_back(compile_formula(task, sub, scope));
+    }
+  } else if (auto *df = dynamic_cast<DisjunctionFormula *>(f)) {
+    node.kind = FormulaKind::Or;
+    for (auto &sub : df->get_formulas()) {
+      node.children.push_back(compile_formula(task, sub, scope));
+    }
+  } else if (auto *imf = dynamic_cast<ImplyFormula *>(f)) {
+    node.kind = FormulaKind::Imply;
+    node.children.push_back(
+        compile_formula(task, imf->get_left_formula(), scope));
+    node.children.push_back(
+        compile_formula(task, imf->get_right_formula(), scope));
+  } else if (auto *ef = dynamic_cast<EqualityFormula *>(f)) {
+    auto &terms = ef->get_terms();
+    if (terms.size() < 2) {
+      node.kind = FormulaKind::And; // always holds
+    } else {
+      node.kind = FormulaKind::Equal;
+      if (!compile_terms(task, {terms[0], terms[1]}, scope, node.atom.terms)) {
+        return lifted_formula(formula, scope);
+      }
+    }
+  } else if (auto *uf = dynamic_cast<UniversalFormula *>(f)) {
+    Scope inner = scope;
+    node.kind = FormulaKind::Forall;
+    node.quantifier = compile_quantifier(task, uf->get_variables(), inner);
+    node.children.push_back(compile_formula(task, uf->get_formula(), inner));
+  } else if (auto *xf = dynamic_cast<ExistentialFormula *>(f)) {
+    Scope inner = scope;
+    node.kind = FormulaKind::Exists;
+    node.quantifier = compile_quantifier(task, xf->get_variables(), inner);
+    node.children.push_back(compile_formula(task, xf->get_formula(), inner));
+  } else if (auto *tf = dynamic_cast<AtStartFormula *>(f)) {
+    return compile_formula(task, tf->get_formula(), scope);
+  } else if (auto *tf = dynamic_cast<AtEndFormula *>(f)) {
+    return compile_formula(task, tf->get_formula(), scope);
+  } else if (auto *tf = dynamic_cast<OverAllFormula *>(f)) {
+    return compile_formula(task, tf->get_formula(), scope);
+  } else {
+    auto comparison = [this, &task, &node, &scope](FormulaKind kind,
+                                            const auto &cmp) {
+      node.kind = kind;
+      node.children.push_back(
+          compile_expression(task, cmp.get_left_expression(), scope));
+      node.children.push_back(
+          compile_expression(task, cmp.get_right_expression(), scope));
+    };
+    if (auto *cmp = dynamic_cast<GreaterFormula *>(f)) {
+      comparison(FormulaKind::Greater, *cmp);
+    } else if (auto *cmp = dynamic_cast<GreaterEqFormula *>(f)) {
+      comparison(FormulaKind::GreaterEq, *cmp);
+    } else if (auto *cmp = dynamic_cast<LessFormula *>(f)) {
+      comparison(FormulaKind::Less, *cmp);
+    } else if (auto *cmp = dynamic_cast<LessEqFormula *>(f)) {
+      comparison(FormulaKind::LessEq, *cmp);
+    } else if (auto *cmp = dynamic_cast<EqFormula *>(f)) {
+      comparison(FormulaKind::Eq, *cmp);
+    } else {
+      return lifted_formula(formula, scope);
+    }
+  }
+
+  _formulas.push_back(std::move(node));
+  return static_cast<int>(_formulas.size()) - 1;
+}
+
+int CompiledOperator::compile_expression(
+    const Task &task, const std::shared_ptr<Expression> &expression,
+    const Scope &scope) {
+  ExpressionNode node;
+  Expression *e = expression.get();
+
+  auto fluent = [&node](int fid) {
+    // Undefined total-cost or reward functions evaluate to 0
+    if (fid < 0) {
+      node.kind = ExpressionKind::Number;
+      node.value = 0.0;
+    } else {
+      node.kind = ExpressionKind::Fluent;
+      node.atom.symbol = fid;
+    }
+  };
+  auto binary = [this, &task, &node, &scope](ExpressionKind kind,
+                                             const auto &op) {
+    node.kind = kind;
+    node.children.push_back(
+        compile_expression(task, op.get_left_expression(), scope));
+    node.children.push_back(
+        compile_expression(task, op.get_right_expression(), scope));
+  };
+
+  if (auto *ne = dynamic_cast<NumericalExpression *>(e)) {
+    node.kind = ExpressionKind::Number;
+    node.value = ne->get_number()->as_double();
+  } else if (auto *fe = dynamic_cast<FunctionExpression *>(e)) {
+    node.kind = ExpressionKind::Fluent;
+    try {
+      node.atom.symbol = task.function_id(fe->get_function()->get_name());
+    } catch (const std::runtime_error &) {
+      return lifted_expression(expression, scope);
+    }
+    if (!compile_terms(task, fe->get_terms(), scope, node.atom.terms)) {
+      return lifted_expression(expression, scope);
+    }
+  } else if (auto *op = dynamic_cast<AddExpression *>(e)) {
+    binary(ExpressionKind::Add, *op);
+  } else if (auto *op = dynamic_cast<SubExpression *>(e)) {
+    binary(ExpressionKind::Sub, *op);
+  } else if (auto *op = dynamic_cast<MulExpression *>(e)) {
+    binary(ExpressionKind::Mul, *op);
+  } else if (auto *op = dynamic_cast<DivExpression *>(e)) {
+    binary(ExpressionKind::Div, *op);
+  } else if (auto *me = dynamic_cast<MinusExpression *>(e)) {
+    node.kind = ExpressionKind::Minus;
+    node.children.push_back(
+        compile_expression(task, me->get_expression(), scope));
+  } else if (auto *oe = dynamic_cast<MinimizeExpression *>(e)) {
+    return compile_expression(task, oe->get_expression(), scope);
+  } else if (auto *oe = dynamic_cast<MaximizeExpression *>(e)) {
+    return compile_expression(task, oe->get_expression(), scope);
+  } else if (dynamic_cast<TotalCostExpression *>(e)) {
+    fluent(task.total_cost_function());
+  } else if (dynamic_cast<RewardExpression *>(e)) {
+    fluent(task.reward_function());
+  } else if (dynamic_cast<TotalTimeExpression *>(e)) {
+    node.kind = ExpressionKind::TotalTime;
+  } else if (dynamic_cast<TimeExpression *>(e)) {
+    node.kind = ExpressionKind::Time;
+  } else if (dynamic_cast<DurationExpression *>(e)) {
+    node.kind = ExpressionKind::Duration;
+  } else {
+    return lifted_expression(expression, scope);
+  }
+
+  _expressions.push_back(std::move(node));
+  return static_cast<int>(_expressions.size()) - 1;
+}
+
+int CompiledOperator::compile_effect(const Task &task,
+                                     const std::shared_ptr<Effect> &effect,
+                                     const Scope &scope) {
+  EffectNode node;
+  Effect *e = effect.get();
+
+  auto assignment = [this, &task, &node, &scope](EffectKind kind,
+                                                 const auto &ae) {
+    node.kind = kind;
+    auto &function = ae.get_function();
+    try {
+      node.atom.symbol =
+          task.function_id(function->get_function()->get_name());
+    } catch (const std::runtime_error &) {
+      return false;
+    }
+    if (!compile_terms(task, function->get_terms(), scope, node.atom.terms)) {
+      return false;
+    }
+    node.expression = compile_expression(task, ae.get_expression(), scope);
+    return true;
+  };
+
+  if (auto *pe = dynamic_cast<PredicateEffect *>(e)) {
+    node.kind = EffectKind::Add;
+    try {
+      node.atom.symbol = task.predicate_id(pe->get_predicate()->get_name());
+    } catch (const std::runtime_error &) {
+      return lifted_effect(effect, scope);
+    }
+    if (!compile_terms(task, pe->get_terms(), scope, node.atom.terms)) {
+      return lifted_effect(effect, scope);
+    }
+  } else if (auto *ne = dynamic_cast<NegationEffect *>(e)) {
+    auto &inner = ne->get_effect();
+    node.kind = EffectKind::Delete;
+    try {
+      node.atom.symbol =
+          task.predicate_id(inner->get_predicate()->get_name());
+    } catch (const std::runtime_error &) {
+      return lifted_effect(effect, scope);
+    }
+    if (!compile_terms(task, inner->get_terms(), scope, node.atom.terms)) {
+      return lifted_effect(effect, scope);
+    }
+  } else if (auto *ce = dynamic_cast<ConjunctionEffect *>(e)) {
+    node.kind = EffectKind::And;
+    for (auto &sub : ce->get_effects()) {
+      node.children.push_back(compile_effect(task, sub, scope));
+    }
+  } else if (auto *de = dynamic_cast<DisjunctionEffect *>(e)) {
+    node.kind = EffectKind::Oneof;
+    for (auto &sub : de->get_effects()) {
+      node.children.push_back(compile_effect(task, sub, scope));
+    }
+  } else if (auto *we = dynamic_cast<ConditionalEffect *>(e)) {
+    auto &condition = we->BinaryEffect::get_condition();
+    auto &inner = we->BinaryEffect::get_effect();
+    if (!condition || !inner) {
+      node.kind = EffectKind::And; // no-op
+    } else {
+      node.kind = EffectKind::When;
+      node.condition = compile_formula(task, condition, scope);
+      node.children.push_back(compile_effect(task, inner, scope));
+    }
+  } else if (auto *ue = dynamic_cast<UniversalEffect *>(e)) {
+    Scope inner = scope;
+    node.kind = EffectKind::Forall;
+    node.quantifier = compile_quantifier(task, ue->get_variables(), inner);
+    node.children.push_back(compile_effect(task, 
+        ue->QuantifiedEffect<UniversalEffect>::get_effect(), inner));
+  } else if (auto *xe = dynamic_cast<ExistentialEffect *>(e)) {
+    Scope inner = scope;
+    node.kind = EffectKind::Exists;
+    node.quantifier = compile_quantifier(task, xe->get_variables(), inner);
+    node.children.push_back(compile_effect(task, 
+        xe->QuantifiedEffect<ExistentialEffect>::get_effect(), inner));
+  } else if (auto *pe = dynamic_cast<ProbabilisticEffect *>(e)) {
+    node.kind = EffectKind::Probabilistic;
+    for (auto &[probability, outcome] : pe->get_outcomes()) {
+      node.probabilities.push_back(probability);
+      node.children.push_back(compile_effect(task, outcome, scope));
+    }
+  } else if (auto *ae = dynamic_cast<AssignEffect *>(e)) {
+    if (!assignment(EffectKind::Assign, *ae)) {
+      return lifted_effect(effect, scope);
+    }
+  } else if (auto *ae = dynamic_cast<IncreaseEffect *>(e)) {
+    if (!assignment(EffectKind::Increase, *ae)) {
+      return lifted_effect(effect, scope);
+    }
+  } else if (auto *ae = dynamic_cast<DecreaseEffect *>(e)) {
+    if (!assignment(EffectKind::Decrease, *ae)) {
+      return lifted_effect(effect, scope);
+    }
+  } else if (auto *ae = dynamic_cast<ScaleUpEffect *>(e)) {
+    if (!assignment(EffectKind::ScaleUp, *ae)) {
+      return lifted_effect(effect, scope);
+    }
+  } else if (auto *ae = dynamic_cast<ScaleDownEffect *>(e)) {
+    if (!assignment(EffectKind::ScaleDown, *ae)) {
+      return lifted_effect(effect, scope);
+    }
+  } else if (auto *te = dynamic_cast<AtStartEffect *>(e)) {
+    return compile_effect(task, te->get_effect(), scope);
+  } else if (auto *te = dynamic_cast<AtEndEffect *>(e)) {
+    return compile_effect(task, te->get_effect(), scope);
+  } else if (auto *te = dynamic_cast<AtTimeEffect *>(e)) {
+    return compile_effect(task, te->get_effect(), scope);
+  } else {
+    return lifted_effect(effect, scope);
+  }
+
+  _effects.push_back(std::move(node));
+  return static_cast<int>(_effects.size()) - 1;
+}
+
+// === Evaluation ===
+
+bool CompiledOperator::holds(const State &state, const Task &task,
+                             const std::vector<int> &arguments) const {
+  if (_condition < 0) {
+    return true;
+  }
+  if (arguments.size() != _parameters.size()) {
+    throw std::runtime_error("Wrong number of operator arguments");
+  }
+  Context context{task, arguments, {}};
+  context.slots.resize(_nb_slots);
+  return holds(_condition, state, context);
+}
+
+CompiledOperator::Outcomes
+CompiledOperator::apply(const State &state, const Task &task,
+                        const std::vector<int> &arguments) const {
+  Outcomes outcomes;
+  outcomes.emplace_back(1.0, state.copy());
+  if (_effect < 0) {
+    return outcomes;
+  }
+  if (arguments.size() != _parameters.size()) {
+    throw std::runtime_error("Wrong number of operator arguments");
+  }
+  Context context{task, arguments, {}};
+  context.slots.resize(_nb_slots);
+  apply(_effect, outcomes, context);
+  return outcomes;
+}
+
+const GroundTuple &CompiledOperator::ground(const Atom &atom,
+                                            Context &context) const {
+  context.tuple.resize(atom.terms.size());
+  for (std::size_t i = 0; i < atom.terms.size(); ++i) {
+    int term = atom.terms[i];
+    context.tuple[i] = term >= 0 ? context.slots[term] : -(term + 1);
+  }
+  return context.tuple;
+}
+
+namespace {
+
+template <typename Tlifted, typename Tcontext>
+Binding lifted_binding(const Tlifted &lifted, const Tcontext &context) {
+  Binding binding;
+  for (auto &[name, slot] : lifted.scope) {
+    binding[name] = context.slots[slot];
+  }
+  return binding;
+}
+
+} // namespace
+
+bool CompiledOperator::holds(int formula, const State &state,
+                             Context &context) const {
+  const FormulaNode &node = _formulas[formula];
+  switch (node.kind) {
+  case FormulaKind::Atom:
+    return state.atoms[node.atom.symbol].count(ground(node.atom, context)) > 0;
+  case FormulaKind::Not:
+    return !holds(node.children[0], state, context);
+  case FormulaKind::And:
+    for (int child : node.children) {
+      if (!holds(child, state, context)) {
+        return false;
+      }
+    }
+    return true;
+  case FormulaKind::Or:
+    for (int child : node.children) {
+      if (holds(child, state, context)) {
+        return true;
+      }
+    }
+    return false;
+  case FormulaKind::Imply:
+    return !holds(node.children[0], state, context) ||
+           holds(node.children[1], state, context);
+  case FormulaKind::Equal: {
+    auto &tuple = ground(node.atom, context);
+    return tuple[0] == tuple[1];
+  }
+  case FormulaKind::Forall:
+    return for_each_assignment(node.quantifier, context.slots, [&]() {
+      return holds(node.children[0], state, context);
+    });
+  case FormulaKind::Exists:
+    return !for_each_assignment(node.quantifier, context.slots, [&]() {
+      return !holds(node.children[0], state, context);
+    });
+  case FormulaKind::Greater:
+    return evaluate(node.children[0], state, context) >
+           evaluate(node.children[1], state, context);
+  case FormulaKind::GreaterEq:
+    return evaluate(node.children[0], state, context) >=
+           evaluate(node.children[1], state, context);
+  case FormulaKind::Less:
+    return evaluate(node.children[0], state, context) <
+           evaluate(node.children[1], state, context);
+  case FormulaKind::LessEq:
+    return evaluate(node.children[0], state, context) <=
+           evaluate(node.children[1], state, context);
+  case FormulaKind::Eq:
+    return std::abs(evaluate(node.children[0], state, context) -
+                    evaluate(node.children[1], state, context)) < 1e-9;
+  case FormulaKind::Lifted: {
+    auto &lifted = _lifted_formulas[node.lifted];
+    return lifted.node->holds(state, context.task,
+                              lifted_binding(lifted, context));
+  }
+  }
+  return false;
+}
+
+double CompiledOperator::evaluate(int expression, const State &state,
+                                  Context &context) const {
+  const ExpressionNode &node = _expressions[expression];
+  switch (node.kind) {
+  case ExpressionKind::Number:
+    return node.value;
+  case ExpressionKind::Fluent: {
+    auto &fmap = state.fluents[node.atom.symbol];
+    auto it = fmap.find(ground(node.atom, context));
+    return it != fmap.end() ? it->second : 0.0;
+  }
+  case ExpressionKind::Add:
+    return evaluate(node.children[0], state, context) +
+           evaluate(node.children[1], state, context);
+  case ExpressionKind::Sub:
+    return evaluate(node.children[0], state, context) -
+           evaluate(node.children[1], state, context);
+  case ExpressionKind::Mul:
+    return evaluate(node.children[0], state, context) *
+           evaluate(node.children[1], state, context);
+  case ExpressionKind::Div:
+    return evaluate(node.children[0], state, context) /
+           evaluate(node.children[1], state, context);
+  case ExpressionKind::Minus:
+    return -evaluate(node.children[0], state, context);
+  case ExpressionKind::TotalTime:
+    return state.time;
+  case ExpressionKind::Time:
+    return state.dt;
+  case ExpressionKind::Duration:
+    return state.duration;
+  case ExpressionKind::Lifted: {
+    auto &lifted = _lifted_expressions[node.lifted];
+    return lifted.node->evaluate(state, context.task,
+                                 lifted_binding(lifted, context));
+  }
+  }
+  return 0.0;
+}
+
+// Applies the effect to each outcome, replacing it by its own outcomes
+// weighted by its probability: like the sequential application of the
+// lifted semantics, but modifying the outcome states in place
+void CompiledOperator::apply(int effect, Outcomes &outcomes,
+                             Context &context) const {
+  const EffectNode &node = _effects[effect];
+
+  // Effects with several outcomes per state, or whose condition must be
+  // evaluated per state: applies f(state, outcomes of the state) to each
+  // outcome
+  auto branch = [&outcomes](const auto &f) {
+    Outcomes result;
+    for (auto &[p, s] : outcomes) {
+      Outcomes sub;
+      f(s, sub);
+      for (auto &[cp, cs] : sub) {
+        result.emplace_back(p * cp, std::move(cs));
+      }
+    }
+    outcomes = std::move(result);
+  };
+
+  switch (node.kind) {
+  case EffectKind::Add:
+    for (auto &[p, s] : outcomes) {
+      s.atoms[node.atom.symbol].insert(ground(node.atom, context));
+    }
+    break;
+  case EffectKind::Delete:
+    for (auto &[p, s] : outcomes) {
+      s.atoms[node.atom.symbol].erase(ground(node.atom, context));
+    }
+    break;
+  case EffectKind::And:
+    for (int child : node.children) {
+      apply(child, outcomes, context);
+    }
+    break;
+  case EffectKind::When:
+    if (outcomes.size() == 1) {
+      if (holds(node.condition, outcomes[0].second, context)) {
+        apply(node.children[0], outcomes, context);
+      }
+    } else {
+      branch([&](State &s, Outcomes &sub) {
+        bool triggered = holds(node.condition, s, context);
+        sub.emplace_back(1.0, std::move(s));
+        if (triggered) {
+          apply(node.children[0], sub, context);
+        }
+      });
+    }
+    break;
+  case EffectKind::Forall:
+    for_each_assignment(node.quantifier, context.slots, [&]() {
+      apply(node.children[0], outcomes, context);
+      return true;
+    });
+    break;
+  case EffectKind::Exists:
+    // First assignment of the variables, no-op if there is none
+    for_each_assignment(node.quantifier, context.slots, [&]() {
+      apply(node.children[0], outcomes, context);
+      return false;
+    });
+    break;
+  case EffectKind::Oneof:
+    if (node.children.empty()) {
+      break;
+    }
+    branch([&](State &s, Outcomes &sub) {
+      double weight = 1.0 / static_cast<double>(node.children.size());
+      for (std::size_t i = 0; i < node.children.size(); ++i) {
+        Outcomes child;
+        child.emplace_back(
+            1.0, i + 1 < node.children.size() ? s.copy() : std::move(s));
+        apply(node.children[i], child, context);
+        for (auto &[cp, cs] : child) {
+          sub.emplace_back(weight * cp, std::move(cs));
+        }
+      }
+    });
+    break;
+  case EffectKind::Probabilistic:
+    branch([&](State &s, Outcomes &sub) {
+      double total = 0.0;
+      for (double probability : node.probabilities) {
+        total += probability;
+      }
+      bool remainder = total < 1.0 - 1e-9;
+      for (std::size_t i = 0; i < node.children.size(); ++i) {
+        Outcomes child;
+        child.emplace_back(1.0, (remainder || i + 1 < node.children.size())
+                                    ? s.copy()
+                                    : std::move(s));
+        apply(node.children[i], child, context);
+        for (auto &[cp, cs] : child) {
+          sub.emplace_back(node.probabilities[i] * cp, std::move(cs));
+        }
+      }
+      if (remainder) {
+        sub.emplace_back(1.0 - total, std::move(s));
+      }
+    });
+    break;
+  case EffectKind::Assign:
+  case EffectKind::Increase:
+  case EffectKind::Decrease:
+  case EffectKind::ScaleUp:
+  case EffectKind::ScaleDown:
+    for (auto &[p, s] : outcomes) {
+      // The value is computed on the state before the assignment
+      double value = evaluate(node.expression, s, context);
+      double &fluent =
+          s.fluents[node.atom.symbol][ground(node.atom, context)];
+      switch (node.kind) {
+      case EffectKind::Assign:
+        fluent = value;
+        break;
+      case EffectKind::Increase:
+        fluent += value;
+        break;
+      case EffectKind::Decrease:
+        fluent -= value;
+        break;
+      case EffectKind::ScaleUp:
+        fluent *= value;
+        break;
+      default:
+        fluent /= value;
+        break;
+      }
+    }
+    break;
+  case EffectKind::Lifted: {
+    auto &lifted = _lifted_effects[node.lifted];
+    Binding binding = lifted_binding(lifted, context);
+    branch([&](State &s, Outcomes &sub) {
+      sub = lifted.node->apply(s, context.task, binding);
+    });
+    break;
+  }
+  }
+}
+
+} // namespace pddl
+
+} // namespace skdecide
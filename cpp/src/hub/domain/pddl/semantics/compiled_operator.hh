@@ -0,0 +1,212 @@
+/* Copyright (c) AIRBUS and its affiliates.
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#ifndef SKDECIDE_PDDL_SEMANTICS_COMPILED_OPERATOR_HH
+#define SKDECIDE_PDDL_SEMANTICS_COMPILED_OPERATOR_HH
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "state.hh"
+
+namespace skdecide {
+
+namespace pddl {
+
+class Task;
+class Term;
+class Formula;
+class Effect;
+class Expression;
+
+/**
+ * @brief Precondition and effect of an operator schema (action, durative
+ * action, event or process) compiled for evaluation on integer bindings.
+ *
+ * Variables are resolved once and for all to slots of a flat array of object
+ * ids, the operator parameters first in their declaration order followed by
+ * the variables of the nested quantifiers; predicates and functions are
+ * resolved to their ids, constants to their object ids and the domains of
+ * quantified variables to their lists of objects. Evaluating the formulas and
+ * applying the effects of a ground operator then neither hashes nor compares
+ * any string, and effects are applied in place on the outcome states instead
+ * of copying the state at each node of the effect. The semantics are the ones
+ * of Formula::holds(), Expression::evaluate() and Effect::apply().
+ *
+ * Nodes with no compiled counterpart (derived predicates, constraints,
+ * goal-achieved and violation expressions...) are evaluated by their lifted
+ * implementation on a Binding rebuilt from the slots in scope.
+ */
+class CompiledOperator {
+public:
+  using Outcomes = std::vector<std::pair<double, State>>;
+
+  CompiledOperator(const Task &task, std::vector<std::string> parameters,
+                   const std::shared_ptr<Formula> &condition,
+                   const std::shared_ptr<Effect> &effect);
+
+  template <typename Toperator>
+  static std::shared_ptr<const CompiledOperator> compile(const Task &task,
+                                                         const Toperator &op);
+
+  const std::vector<std::string> &parameters() const { return _parameters; }
+
+  // Object ids of the parameters in the given lifted binding
+  std::vector<int> arguments(const Binding &binding) const;
+
+  bool has_condition() const { return _condition >= 0; }
+  bool has_effect() const { return _effect >= 0; }
+
+  // The arguments are the object ids of the parameters; a missing condition
+  // holds and a missing effect leaves the state unchanged
+  bool holds(const State &state, const Task &task,
+             const std::vector<int> &arguments) const;
+  Outcomes apply(const State &state, const Task &task,
+                 const std::vector<int> &arguments) const;
+
+private:
+  // Terms are slot indices if non-negative, -(object id + 1) otherwise
+  struct Atom {
+    int symbol; // predicate or function id
+    std::vector<int> terms;
+  };
+
+  struct Quantifier {
+    std::vector<int> slots;
+    std::vector<std::vector<int>> domains;
+  };
+
+  // Slots in scope of a lifted node, by variable name
+  using Scope = std::vector<std::pair<std::string, int>>;
+
+  enum class FormulaKind {
+    Atom,
+    Not,
+    And,
+    Or,
+    Imply,
+    Equal,
+    Forall,
+    Exists,
+    Greater,
+    GreaterEq,
+    Less,
+    LessEq,
+    Eq,
+    Lifted
+  };
+
+  struct FormulaNode {
+    FormulaKind kind;
+    Atom atom;                 // Atom; terms of Equal
+    std::vector<int> children; // formulas, or expressions of comparisons
+    Quantifier quantifier;     // Forall, Exists
+    int lifted = -1;
+  };
+
+  enum class ExpressionKind {
+    Number,
+    Fluent,
+    Add,
+    Sub,
+    Mul,
+    Div,
+    Minus,
+    TotalTime,
+    Time,
+    Duration,
+    Lifted
+  };
+
+  struct ExpressionNode {
+    ExpressionKind kind;
+    double value = 0.0; // Number
+    Atom atom;          // Fluent
+    std::vector<int> children;
+    int lifted = -1;
+  };
+
+  enum class EffectKind {
+    Add,
+    Delete,
+    And,
+    Oneof,
+    When,
+    Forall,
+    Exists,
+    Probabilistic,
+    Assign,
+    Increase,
+    Decrease,
+    ScaleUp,
+    ScaleDown,
+    Lifted
+  };
+
+  struct EffectNode {
+    EffectKind kind;
+    Atom atom; // Add, Delete, assigned fluent
+    std::vector<int> children;
+    std::vector<double> probabilities; // Probabilistic
+    int condition = -1;                // When
+    int expression = -1;               // assignments
+    Quantifier quantifier;             // Forall, Exists
+    int lifted = -1;
+  };
+
+  template <typename T> struct Lifted {
+    std::shared_ptr<T> node;
+    Scope scope;
+  };
+
+  struct Context;
+
+  std::vector<std::string> _parameters;
+  int _nb_slots;
+  int _condition;
+  int _effect;
+
+  std::vector<FormulaNode> _formulas;
+  std::vector<ExpressionNode> _expressions;
+  std::vector<EffectNode> _effects;
+  std::vector<Lifted<Formula>> _lifted_formulas;
+  std::vector<Lifted<Expression>> _lifted_expressions;
+  std::vector<Lifted<Effect>> _lifted_effects;
+
+  // Compilation: the scope maps the variables to their slots
+  static bool compile_term(const Task &task, const std::shared_ptr<Term> &term,
+                           const Scope &scope, int &result);
+  static bool compile_terms(const Task &task,
+                            const std::vector<std::shared_ptr<Term>> &terms,
+                            const Scope &scope, std::vector<int> &result);
+  template <typename Tvariables>
+  Quantifier compile_quantifier(const Task &task, const Tvariables &variables,
+                                Scope &scope);
+  int compile_formula(const Task &task, const std::shared_ptr<Formula> &formula,
+                      const Scope &scope);
+  int compile_expression(const Task &task,
+                         const std::shared_ptr<Expression> &expression,
+                         const Scope &scope);
+  int compile_effect(const Task &task, const std::shared_ptr<Effect> &effect,
+                     const Scope &scope);
+  int lifted_formula(const std::shared_ptr<Formula> &formula,
+                     const Scope &scope);
+  int lifted_expression(const std::shared_ptr<Expression> &expression,
+                        const Scope &scope);
+  int lifted_effect(const std::shared_ptr<Effect> &effect, const Scope &scope);
+
+  // Evaluation
+  const GroundTuple &ground(const Atom &atom, Context &context) const;
+  bool holds(int formula, const State &state, Context &context) const;
+  double evaluate(int expression, const State &state, Context &context) const;
+  void apply(int effect, Outcomes &outcomes, Context &context) const;
+};
+
+} // namespace pddl
+
+} // namespace skdecide
+
+#endif // SKDECIDE_PDDL_SEMANTICS_COMPILED_OPERATOR_HH
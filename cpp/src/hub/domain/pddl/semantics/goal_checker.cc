@@ -3,23 +3,25 @@
  * LICENSE file in the root directory of this source tree.
  */
 #include "goal_checker.hh"
+#include "compiled_operator.hh"
 #include "task.hh"
 
-#include "../formula.hh"
-
 namespace skdecide {
 
 namespace pddl {
 
-GoalChecker::GoalChecker(const Task &task) : _task(task) {}
+GoalChecker::GoalChecker(const Task &task) : _task(task) {
+  if (_task.goal()) {
+    _goal = std::make_shared<CompiledOperator>(
+        _task, std::vector<std::string>(), _task.goal(), nullptr);
+  }
+}
 
 bool GoalChecker::is_goal(const State &state) const {
-  auto &goal = _task.goal();
-  if (!goal) {
+  if (!_goal) {
     return false;
   }
-  Binding empty_binding;
-  return goal->holds(state, _task, empty_binding);
+  return _goal->holds(state, _task, {});
 }
 
 } // namespace pddl
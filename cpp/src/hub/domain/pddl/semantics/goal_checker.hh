@@ -5,6 +5,8 @@
 #ifndef SKDECIDE_PDDL_SEMANTICS_GOAL_CHECKER_HH
 #define SKDECIDE_PDDL_SEMANTICS_GOAL_CHECKER_HH
 
+#include <memory>
+
 #include "state.hh"
 
 namespace skdecide {
@@ -12,6 +14,7 @@ namespace skdecide {
 namespace pddl {
 
 class Task;
+class CompiledOperator;
 
 class GoalChecker {
 public:
@@ -21,6 +24,7 @@ public:
 
 private:
   const Task &_task;
+  std::shared_ptr<const CompiledOperator> _goal;
 };
 
 } // namespace pddl
@@ -0,0 +1,329 @@
+/* Copyright (c) AIRBUS and its affiliates.
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#include "ground_action_tree.hh"
+#include "compiled_operator.hh"
+#include "task.hh"
+
+#include "../aggregation_formula.hh"
+#include "../equality_formula.hh"
+#include "../negation_formula.hh"
+#include "../operator.hh"
+#include "../predicate.hh"
+#include "../predicate_formula.hh"
+#include "../term.hh"
+#include "../variable.hh"
+
+#include "../impl/aggregation_formula_impl.hh"
+
+#include <algorithm>
+#include <clingo.hh>
+#include <optional>
+
+namespace skdecide {
+
+namespace pddl {
+
+template <typename Toperator>
+std::vector<GroundActionTree::Schema> GroundActionTree::schemas(
+    const std::vector<std::shared_ptr<Toperator>> &operators,
+    const std::vector<std::shared_ptr<const CompiledOperator>> &compiled) {
+  std::vector<Schema> result;
+  result.reserve(operators.size());
+  for (std::size_t i = 0; i < operators.size(); ++i) {
+    Schema schema;
+    for (auto &var : operators[i]->get_variables()) {
+      schema.parameters.push_back(var->get_name());
+    }
+    schema.condition = operators[i]->get_condition();
+    schema.compiled = compiled[i];
+    result.push_back(std::move(schema));
+  }
+  return result;
+}
+
+template std::vector<GroundActionTree::Schema> GroundActionTree::schemas(
+    const std::vector<std::shared_ptr<Action>> &,
+    const std::vector<std::shared_ptr<const CompiledOperator>> &);
+template std::vector<GroundActionTree::Schema> GroundActionTree::schemas(
+    const std::vector<std::shared_ptr<DurativeAction>> &,
+    const std::vector<std::shared_ptr<const CompiledOperator>> &);
+template std::vector<GroundActionTree::Schema> GroundActionTree::schemas(
+    const std::vector<std::shared_ptr<Event>> &,
+    const std::vector<std::shared_ptr<const CompiledOperator>> &);
+template std::vector<GroundActionTree::Schema> GroundActionTree::schemas(
+    const std::vector<std::shared_ptr<Process>> &,
+    const std::vector<std::shared_ptr<const CompiledOperator>> &);
+
+GroundActionTree::GroundActionTree(const Task &task, const Clingo::Control &ctl,
+                                   const std::string &head_prefix,
+                                   std::vector<Schema> schemas)
+    : _task(task), _schemas(std::move(schemas)), _nb_facts(0) {
+  _facts.resize(_task.num_predicates());
+  std::vector<std::vector<Literal>> literals;
+  auto atoms = ctl.symbolic_atoms();
+
+  for (std::size_t op_id = 0; op_id < _schemas.size(); ++op_id) {
+    auto &schema = _schemas[op_id];
+    std::string head = head_prefix + std::to_string(op_id);
+    Clingo::Signature signature(
+        head.c_str(), static_cast<uint32_t>(schema.parameters.size()));
+
+    for (auto it = atoms.begin(signature); it != atoms.end(); ++it) {
+      GroundAction ga;
+      ga.action_id = static_cast<int>(op_id);
+      auto args = it->symbol().arguments();
+      ga.arguments.reserve(args.size());
+      for (std::size_t i = 0; i < args.size(); ++i) {
+        int obj_id = args[i].number();
+        ga.arguments.push_back(obj_id);
+        ga.binding[schema.parameters[i]] = obj_id;
+      }
+
+      std::vector<Literal> op_literals;
+      bool needs_check = false;
+      if (schema.condition &&
+          !compile_condition(schema.condition, ga.binding, true, op_literals,
+                             needs_check)) {
+        continue;
+      }
+      std::sort(op_literals.begin(), op_literals.end());
+      op_literals.erase(std::unique(op_literals.begin(), op_literals.end(),
+                                    [](const Literal &a, const Literal &b) {
+                                      return a.fact == b.fact &&
+                                             a.positive == b.positive;
+                                    }),
+                        op_literals.end());
+      // A fact required to be both true and false
+      if (std::adjacent_find(op_literals.begin(), op_literals.end(),
+                             [](const Literal &a, const Literal &b) {
+                               return a.fact == b.fact;
+                             }) != op_literals.end()) {
+        continue;
+      }
+
+      _ground_operators.push_back(std::move(ga));
+      _needs_check.push_back(needs_check);
+      literals.push_back(std::move(op_literals));
+    }
+  }
+
+  build_tree(literals);
+}
+
+int GroundActionTree::fact_id(int predicate_id, const GroundTuple &tuple) {
+  auto res = _facts[predicate_id].emplace(tuple, _nb_facts);
+  if (res.second) {
+    ++_nb_facts;
+  }
+  return res.first->second;
+}
+
+// Mirrors Task::generate_formula_asp_body() so that the compiled literals are
+// exactly the ones the ASP encoding used to check for each state
+bool GroundActionTree::compile_condition(
+    const std::shared_ptr<Formula> &formula, const Binding &binding,
+    bool positive, std::vector<Literal> &literals, bool &needs_check) {
+  auto resolve = [this, &binding](
+                     const std::shared_ptr<Term> &term) -> std::optional<int> {
+    const std::string &name = term->get_name();
+    if (!name.empty() && name[0] == '?') {
+      auto it = binding.find(name);
+      if (it == binding.end()) {
+        return std::nullopt;
+      }
+      return it->second;
+    }
+    return _task.object_id(name);
+  };
+
+  if (auto *pf = dynamic_cast<PredicateFormula *>(formula.get())) {
+    GroundTuple tuple;
+    tuple.reserve(pf->get_terms().size());
+    for (auto &term : pf->get_terms()) {
+      auto obj_id = resolve(term);
+      if (!obj_id) {
+        // The atom does not exist, hence never holds
+        return !positive;
+      }
+      tuple.push_back(*obj_id);
+    }
+    int pid = _task.predicate_id(pf->get_predicate()->get_name());
+    literals.push_back({fact_id(pid, tuple), positive});
+    return true;
+  } else if (auto *nf = dynamic_cast<NegationFormula *>(formula.get())) {
+    return compile_condition(nf->get_formula(), binding, !positive, literals,
+                             needs_check);
+  } else if (auto *cf = dynamic_cast<ConjunctionFormula *>(formula.get())) {
+    for (auto &sub : cf->get_formulas()) {
+      if (!compile_condition(sub, binding, positive, literals, needs_check)) {
+        return false;
+      }
+    }
+    return true;
+  } else if (auto *ef = dynamic_cast<EqualityFormula *>(formula.get())) {
+    auto &terms = ef->get_terms();
+    if (terms.size() < 2) {
+      return true;
+    }
+    auto first = resolve(terms[0]);
+    auto second = resolve(terms[1]);
+    if (!first || !second) {
+      needs_check = true;
+      return true;
+    }
+    return (*first == *second) == positive;
+  } else {
+    needs_check = true;
+    return true;
+  }
+}
+
+void GroundActionTree::build_tree(
+    const std::vector<std::vector<Literal>> &literals) {
+  // (ground operator, index of its next literal to test)
+  using Cursors = std::vector<std::pair<std::size_t, std::size_t>>;
+  struct Item {
+    int node;
+    Cursors operators;
+  };
+
+  auto new_node = [this]() {
+    _nodes.push_back({-1, -1, -1, -1, 0, 0});
+    return static_cast<int>(_nodes.size()) - 1;
+  };
+
+  Cursors all;
+  all.reserve(literals.size());
+  for (std::size_t op = 0; op < literals.size(); ++op) {
+    all.emplace_back(op, 0);
+  }
+  std::vector<Item> stack;
+  stack.push_back({new_node(), std::move(all)});
+
+  // Iterative construction: chains of "don't care" children can be as long
+  // as the number of facts
+  while (!stack.empty()) {
+    Item item = std::move(stack.back());
+    stack.pop_back();
+
+    // Operators with no literal left are applicable once the node is reached
+    int fact = -1;
+    _nodes[item.node].first_operator = _node_operators.size();
+    for (auto &[op, cursor] : item.operators) {
+      if (cursor == literals[op].size()) {
+        _node_operators.push_back(op);
+      } else if (fact < 0 || literals[op][cursor].fact < fact) {
+        fact = literals[op][cursor].fact;
+      }
+    }
+    _nodes[item.node].nb_operators =
+        _node_operators.size() - _nodes[item.node].first_operator;
+    if (fact < 0) {
+      continue;
+    }
+
+    // Branch on the smallest fact tested by the remaining operators
+    Cursors on_true, on_false, dont_care;
+    for (auto &[op, cursor] : item.operators) {
+      if (cursor == literals[op].size()) {
+        continue;
+      }
+      const Literal &lit = literals[op][cursor];
+      if (lit.fact != fact) {
+        dont_care.emplace_back(op, cursor);
+      } else if (lit.positive) {
+        on_true.emplace_back(op, cursor + 1);
+      } else {
+        on_false.emplace_back(op, cursor + 1);
+      }
+    }
+    _nodes[item.node].fact = fact;
+    if (!on_true.empty()) {
+      int child = new_node();
+      _nodes[item.node].on_true = child;
+      stack.push_back({child, std::move(on_true)});
+    }
+    if (!on_false.empty()) {
+      int child = new_node();
+      _nodes[item.node].on_false = child;
+      stack.push_back({child, std::move(on_false)});
+    }
+    if (!dont_care.empty()) {
+      int child = new_node();
+      _nodes[item.node].dont_care = child;
+      stack.push_back({child, std::move(dont_care)});
+    }
+  }
+}
+
+std::vector<GroundAction>
+GroundActionTree::get_applicable(const State &state,
+                                 bool check_conditions) const {
+  // Mark the facts of the state, looking up the smallest of the state atoms
+  // and the tree facts of each predicate
+  std::vector<char> truth(_nb_facts, 0);
+  std::size_t nb_predicates = std::min(_facts.size(), state.atoms.size());
+  for (std::size_t pid = 0; pid < nb_predicates; ++pid) {
+    auto &facts = _facts[pid];
+    auto &atoms = state.atoms[pid];
+    if (facts.empty() || atoms.empty()) {
+      continue;
+    }
+    if (atoms.size() < facts.size()) {
+      for (auto &tuple : atoms) {
+        auto it = facts.find(tuple);
+        if (it != facts.end()) {
+          truth[it->second] = 1;
+        }
+      }
+    } else {
+      for (auto &[tuple, fact] : facts) {
+        if (atoms.count(tuple) > 0) {
+          truth[fact] = 1;
+        }
+      }
+    }
+  }
+
+  std::vector<std::size_t> applicable;
+  std::vector<int> stack;
+  if (!_nodes.empty()) {
+    stack.push_back(0);
+  }
+  while (!stack.empty()) {
+    const Node &node = _nodes[stack.back()];
+    stack.pop_back();
+    applicable.insert(
+        applicable.end(), _node_operators.begin() + node.first_operator,
+        _node_operators.begin() + node.first_operator + node.nb_operators);
+    if (node.fact >= 0) {
+      int next = truth[node.fact] ? node.on_true : node.on_false;
+      if (next >= 0) {
+        stack.push_back(next);
+      }
+      if (node.dont_care >= 0) {
+        stack.push_back(node.dont_care);
+      }
+    }
+  }
+  // Keep the grounding order whatever the shape of the tree
+  std::sort(applicable.begin(), applicable.end());
+
+  std::vector<GroundAction> result;
+  result.reserve(applicable.size());
+  for (std::size_t op : applicable) {
+    const GroundAction &ga = _ground_operators[op];
+    if (check_conditions && _needs_check[op] &&
+        !_schemas[ga.action_id].compiled->holds(state, _task, ga.arguments)) {
+      continue;
+    }
+    result.push_back(ga);
+  }
+  return result;
+}
+
+} // namespace pddl
+
+} // namespace skdecide
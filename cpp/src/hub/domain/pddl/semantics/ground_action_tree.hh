@@ -0,0 +1,118 @@
+/* Copyright (c) AIRBUS and its affiliates.
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#ifndef SKDECIDE_PDDL_SEMANTICS_GROUND_ACTION_TREE_HH
+#define SKDECIDE_PDDL_SEMANTICS_GROUND_ACTION_TREE_HH
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "applicable_actions_generator.hh"
+#include "state.hh"
+
+namespace Clingo {
+class Control;
+} // namespace Clingo
+
+namespace skdecide {
+
+namespace pddl {
+
+class Task;
+class Formula;
+class CompiledOperator;
+
+/**
+ * @brief Table of the ground instances of one kind of operators (actions,
+ * durative actions, processes or events), compiled once into a successor
+ * generator decision tree over fact ids à la Fast Downward.
+ *
+ * The ground instances are the '<head_prefix><operator_id>' atoms of an ASP
+ * program generated by Task::generate_asp_program() and already grounded by
+ * Clingo, i.e. the type-consistent parameter tuples. The precondition
+ * fragments encoded in the ASP program (predicates, negations, conjunctions
+ * and equalities) are compiled into literals over fact ids, i.e. ids of the
+ * ground atoms (predicate id, object ids) they refer to. Each inner node of
+ * the tree tests one fact and has a child for the ground operators requiring
+ * the fact, one for those requiring its negation and one for those which do
+ * not care about it; ground operators whose literals are all satisfied along
+ * the path to a node are stored in that node. Computing the applicable ground
+ * operators of a state then only requires to mark the facts of the state and
+ * to walk the branches of the tree which are consistent with them, without
+ * any solver invocation.
+ *
+ * Preconditions which are not compiled (numeric comparisons, quantifiers,
+ * disjunctions, timed formulas...) are checked on the compiled operator if
+ * requested, like the ASP encoding used to do.
+ */
+class GroundActionTree {
+public:
+  struct Schema {
+    std::vector<std::string> parameters;
+    std::shared_ptr<Formula> condition;
+    std::shared_ptr<const CompiledOperator> compiled;
+  };
+
+  // The compiled operators are indexed like the operators
+  template <typename Toperator>
+  static std::vector<Schema>
+  schemas(const std::vector<std::shared_ptr<Toperator>> &operators,
+          const std::vector<std::shared_ptr<const CompiledOperator>> &compiled);
+
+  GroundActionTree(const Task &task, const Clingo::Control &ctl,
+                   const std::string &head_prefix,
+                   std::vector<Schema> schemas);
+
+  std::size_t size() const { return _ground_operators.size(); }
+
+  std::vector<GroundAction> get_applicable(const State &state,
+                                           bool check_conditions) const;
+
+private:
+  struct Literal {
+    int fact;
+    bool positive;
+
+    bool operator<(const Literal &other) const {
+      return fact < other.fact ||
+             (fact == other.fact && positive < other.positive);
+    }
+  };
+
+  // Returns false if the ground operator can never be applicable
+  bool compile_condition(const std::shared_ptr<Formula> &formula,
+                         const Binding &binding, bool positive,
+                         std::vector<Literal> &literals, bool &needs_check);
+  int fact_id(int predicate_id, const GroundTuple &tuple);
+  void build_tree(const std::vector<std::vector<Literal>> &literals);
+
+  struct Node {
+    int fact; // -1 for leaves
+    int on_true;
+    int on_false;
+    int dont_care;
+    std::size_t first_operator;
+    std::size_t nb_operators;
+  };
+
+  const Task &_task;
+  std::vector<Schema> _schemas;
+  std::vector<GroundAction> _ground_operators;
+  std::vector<bool> _needs_check;
+
+  // Fact ids of the ground atoms tested by the tree, indexed by predicate id
+  std::vector<std::unordered_map<GroundTuple, int, GroundTupleHash>> _facts;
+  int _nb_facts;
+
+  std::vector<Node> _nodes;
+  std::vector<std::size_t> _node_operators;
+};
+
+} // namespace pddl
+
+} // namespace skdecide
+
+#endif // SKDECIDE_PDDL_SEMANTICS_GROUND_ACTION_TREE_HH
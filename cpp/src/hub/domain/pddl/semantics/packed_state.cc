@@ -0,0 +1,224 @@
+/* Copyright (c) AIRBUS and its affiliates.
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#include "packed_state.hh"
+#include "task.hh"
+
+#include "../domain.hh"
+#include "../function.hh"
+#include "../predicate.hh"
+#include "../type.hh"
+#include "../variable.hh"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+
+namespace skdecide {
+
+namespace pddl {
+
+namespace {
+
+std::size_t saturating_add(std::size_t a, std::size_t b) {
+  return (a == FactIndex::npos || b > FactIndex::npos - a - 1) ? FactIndex::npos
+                                                               : a + b;
+}
+
+std::size_t saturating_mul(std::size_t a, std::size_t b) {
+  if (a == FactIndex::npos || b == FactIndex::npos) {
+    return FactIndex::npos;
+  }
+  return (b != 0 && a > (FactIndex::npos - 1) / b) ? FactIndex::npos : a * b;
+}
+
+} // namespace
+
+FactIndex::FactIndex(const Task &task) {
+  _num_facts = build(task, false, _predicates);
+  _num_fluents = build(task, true, _functions);
+}
+
+std::size_t FactIndex::build(const Task &task, bool functions,
+                             std::vector<Symbol> &symbols) {
+  std::vector<int> all_objects(task.num_objects());
+  for (int o = 0; o < task.num_objects(); ++o) {
+    all_objects[o] = o;
+  }
+
+  int nb_symbols = functions ? task.num_functions() : task.num_predicates();
+  symbols.resize(nb_symbols);
+  std::size_t offset = 0;
+  for (int id = 0; id < nb_symbols; ++id) {
+    const auto &variables =
+        functions
+            ? task.domain()->get_function(task.function_name(id))
+                  ->get_variables()
+            : task.domain()->get_predicate(task.predicate_name(id))
+                  ->get_variables();
+    Symbol &symbol = symbols[id];
+    symbol.offset = offset;
+    symbol.size = 1;
+    for (auto &var : variables) {
+      auto &types = var->get_types();
+      std::string type_name =
+          types.empty() ? "object" : (*types.begin())->get_name();
+      // Objects of subtypes are not always propagated to 'object'
+      std::vector<int> domain = (type_name == "object")
+                                    ? all_objects
+                                    : task.objects_of_type(type_name);
+      std::sort(domain.begin(), domain.end());
+      domain.erase(std::unique(domain.begin(), domain.end()), domain.end());
+      std::vector<int> positions(task.num_objects(), -1);
+      for (std::size_t i = 0; i < domain.size(); ++i) {
+        positions[domain[i]] = static_cast<int>(i);
+      }
+      symbol.size = saturating_mul(symbol.size, domain.size());
+      symbol.domains.push_back(std::move(domain));
+      symbol.positions.push_back(std::move(positions));
+    }
+    offset = saturating_add(offset, symbol.size);
+  }
+  return offset;
+}
+
+std::size_t FactIndex::encode(const std::vector<Symbol> &symbols, int id,
+                              const GroundTuple &tuple) {
+  const Symbol &symbol = symbols[id];
+  if (tuple.size() != symbol.domains.size() || symbol.offset == npos ||
+      symbol.size == npos) {
+    return npos;
+  }
+  std::size_t index = 0;
+  for (std::size_t i = 0; i < tuple.size(); ++i) {
+    auto &positions = symbol.positions[i];
+    if (tuple[i] < 0 || tuple[i] >= static_cast<int>(positions.size()) ||
+        positions[tuple[i]] < 0) {
+      return npos;
+    }
+    index = index * symbol.domains[i].size() + positions[tuple[i]];
+  }
+  return saturating_add(symbol.offset, index);
+}
+
+std::pair<int, GroundTuple>
+FactIndex::decode(const std::vector<Symbol> &symbols, std::size_t index) {
+  // Last symbol whose offset is not greater than the index: symbols with no
+  // ground instance share their offset with the next one
+  auto it = std::upper_bound(
+      symbols.begin(), symbols.end(), index,
+      [](std::size_t i, const Symbol &s) { return i < s.offset; });
+  int id = static_cast<int>(it - symbols.begin()) - 1;
+  const Symbol &symbol = symbols[id];
+  std::size_t local = index - symbol.offset;
+  GroundTuple tuple(symbol.domains.size());
+  for (std::size_t i = tuple.size(); i-- > 0;) {
+    std::size_t radix = symbol.domains[i].size();
+    tuple[i] = symbol.domains[i][local % radix];
+    local /= radix;
+  }
+  return {id, std::move(tuple)};
+}
+
+PackedState FactIndex::empty_state() const {
+  PackedState state;
+  state.words.assign((_num_facts + 63) / 64, 0);
+  state.fluents.assign(_num_fluents, std::numeric_limits<double>::quiet_NaN());
+  return state;
+}
+
+void FactIndex::add(PackedState &state, std::size_t fact) const {
+  std::uint64_t mask = std::uint64_t(1) << (fact & 63);
+  std::uint64_t &word = state.words[fact >> 6];
+  if (!(word & mask)) {
+    word |= mask;
+    auto [pid, tuple] = decode(_predicates, fact);
+    state.hash ^= zobrist_atom_key(pid, tuple);
+  }
+}
+
+void FactIndex::remove(PackedState &state, std::size_t fact) const {
+  std::uint64_t mask = std::uint64_t(1) << (fact & 63);
+  std::uint64_t &word = state.words[fact >> 6];
+  if (word & mask) {
+    word &= ~mask;
+    auto [pid, tuple] = decode(_predicates, fact);
+    state.hash ^= zobrist_atom_key(pid, tuple);
+  }
+}
+
+void FactIndex::assign(PackedState &state, std::size_t fluent,
+                       double value) const {
+  double &current = state.fluents[fluent];
+  if (current == value || (std::isnan(current) && std::isnan(value))) {
+    return;
+  }
+  auto [fid, tuple] = decode(_functions, fluent);
+  if (!std::isnan(current)) {
+    state.hash ^= zobrist_fluent_key(fid, tuple, current);
+  }
+  if (!std::isnan(value)) {
+    state.hash ^= zobrist_fluent_key(fid, tuple, value);
+  }
+  current = value;
+}
+
+std::optional<PackedState> FactIndex::pack(const State &state) const {
+  if (_num_facts == npos || _num_fluents == npos) {
+    return std::nullopt;
+  }
+  if (state.atoms.size() > _predicates.size() ||
+      state.fluents.size() > _functions.size()) {
+    return std::nullopt;
+  }
+  PackedState packed = empty_state();
+  for (std::size_t pid = 0; pid < state.atoms.size(); ++pid) {
+    for (auto &tuple : state.atoms[pid]) {
+      std::size_t fact = fact_id(static_cast<int>(pid), tuple);
+      if (fact == npos) {
+        return std::nullopt;
+      }
+      // The key is computed from the lifted atom rather than decoded
+      packed.words[fact >> 6] |= std::uint64_t(1) << (fact & 63);
+      packed.hash ^= zobrist_atom_key(static_cast<int>(pid), tuple);
+    }
+  }
+  for (std::size_t fid = 0; fid < state.fluents.size(); ++fid) {
+    for (auto &[tuple, value] : state.fluents[fid]) {
+      std::size_t fluent = fluent_id(static_cast<int>(fid), tuple);
+      if (fluent == npos || std::isnan(value)) {
+        return std::nullopt;
+      }
+      packed.fluents[fluent] = value;
+      packed.hash ^= zobrist_fluent_key(static_cast<int>(fid), tuple, value);
+    }
+  }
+  return packed;
+}
+
+State FactIndex::unpack(const PackedState &state) const {
+  State result;
+  result.atoms.resize(_predicates.size());
+  result.fluents.resize(_functions.size());
+  for (std::size_t w = 0; w < state.words.size(); ++w) {
+    std::uint64_t word = state.words[w];
+    while (word) {
+      std::size_t fact = w * 64 + std::countr_zero(word);
+      word &= word - 1;
+      auto [pid, tuple] = decode(_predicates, fact);
+      result.atoms[pid].insert(std::move(tuple));
+    }
+  }
+  for (std::size_t fluent = 0; fluent < state.fluents.size(); ++fluent) {
+    if (state.defined(fluent)) {
+      auto [fid, tuple] = decode(_functions, fluent);
+      result.fluents[fid][std::move(tuple)] = state.fluents[fluent];
+    }
+  }
+  return result;
+}
+
+} // namespace pddl
+
+} // namespace skdecide
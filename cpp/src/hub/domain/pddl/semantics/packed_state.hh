@@ -0,0 +1,134 @@
+/* Copyright (c) AIRBUS and its affiliates.
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#ifndef SKDECIDE_PDDL_SEMANTICS_PACKED_STATE_HH
+#define SKDECIDE_PDDL_SEMANTICS_PACKED_STATE_HH
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "state.hh"
+
+namespace skdecide {
+
+namespace pddl {
+
+class Task;
+
+/**
+ * @brief Grounded representation of the atoms and fluents of a state: atoms
+ * are bits of a packed bitset indexed by the fact ids of a FactIndex, fluents
+ * are entries of a dense vector indexed by its fluent ids (NaN for undefined
+ * fluents). The Zobrist hash of the atoms and fluents is maintained
+ * incrementally and equals State::zobrist_hash() of the lifted state.
+ *
+ * Temporal members of the lifted state (time, active durative actions) are
+ * not represented.
+ */
+struct PackedState {
+  std::vector<std::uint64_t> words;
+  std::vector<double> fluents;
+  std::uint64_t hash = 0;
+
+  bool test(std::size_t fact) const {
+    return (words[fact >> 6] >> (fact & 63)) & 1;
+  }
+
+  bool defined(std::size_t fluent) const {
+    return !std::isnan(fluents[fluent]);
+  }
+
+  bool operator==(const PackedState &other) const {
+    if (hash != other.hash || words != other.words ||
+        fluents.size() != other.fluents.size()) {
+      return false;
+    }
+    for (std::size_t i = 0; i < fluents.size(); ++i) {
+      if (fluents[i] != other.fluents[i] &&
+          !(std::isnan(fluents[i]) && std::isnan(other.fluents[i]))) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+/**
+ * @brief Dense index of the ground atoms (facts) and ground fluents of a task.
+ *
+ * The ground atoms of a predicate are the tuples of objects of the types of
+ * its parameters, numbered in mixed radix after the ones of the previous
+ * predicates, so that fact ids are computed arithmetically without any hash
+ * table (same for fluents and functions). Atoms outside the typed domain of
+ * their predicate have no id.
+ */
+class FactIndex {
+public:
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  FactIndex(const Task &task);
+
+  // May be npos if the number of ground atoms overflows
+  std::size_t num_facts() const { return _num_facts; }
+  std::size_t num_fluents() const { return _num_fluents; }
+
+  // Returns npos for atoms outside the typed domain of the predicate
+  std::size_t fact_id(int predicate_id, const GroundTuple &tuple) const {
+    return encode(_predicates, predicate_id, tuple);
+  }
+  std::pair<int, GroundTuple> fact(std::size_t fact_id) const {
+    return decode(_predicates, fact_id);
+  }
+
+  std::size_t fluent_id(int function_id, const GroundTuple &tuple) const {
+    return encode(_functions, function_id, tuple);
+  }
+  std::pair<int, GroundTuple> fluent(std::size_t fluent_id) const {
+    return decode(_functions, fluent_id);
+  }
+
+  PackedState empty_state() const;
+
+  // Incremental updates of a packed state and of its Zobrist hash
+  void add(PackedState &state, std::size_t fact) const;
+  void remove(PackedState &state, std::size_t fact) const;
+  // Assigning NaN undefines the fluent
+  void assign(PackedState &state, std::size_t fluent, double value) const;
+
+  // Returns nullopt if some atom or fluent of the state has no id
+  std::optional<PackedState> pack(const State &state) const;
+  State unpack(const PackedState &state) const;
+
+private:
+  struct Symbol {
+    std::size_t offset;
+    std::size_t size;
+    // Objects of each parameter, and their indices in the parameter domain
+    // (-1 for objects outside the domain)
+    std::vector<std::vector<int>> domains;
+    std::vector<std::vector<int>> positions;
+  };
+
+  std::vector<Symbol> _predicates;
+  std::vector<Symbol> _functions;
+  std::size_t _num_facts;
+  std::size_t _num_fluents;
+
+  static std::size_t build(const Task &task, bool functions,
+                           std::vector<Symbol> &symbols);
+  static std::size_t encode(const std::vector<Symbol> &symbols, int id,
+                            const GroundTuple &tuple);
+  static std::pair<int, GroundTuple> decode(const std::vector<Symbol> &symbols,
+                                            std::size_t index);
+};
+
+} // namespace pddl
+
+} // namespace skdecide
+
+#endif // SKDECIDE_PDDL_SEMANTICS_PACKED_STATE_HH
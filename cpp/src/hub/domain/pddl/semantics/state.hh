@@ -7,6 +7,8 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <functional>
 #include <string>
 #include <unordered_map>
@@ -33,6 +35,36 @@ using TupleSet = std::unordered_set<GroundTuple, GroundTupleHash>;
 using FluentMap = std::unordered_map<GroundTuple, double, GroundTupleHash>;
 using Binding = std::unordered_map<std::string, int>;
 
+inline std::uint64_t zobrist_mix(std::uint64_t x) {
+  // splitmix64 finalizer
+  x += 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+inline std::uint64_t zobrist_atom_key(int predicate_id,
+                                      const GroundTuple &tuple) {
+  std::uint64_t h = zobrist_mix(static_cast<std::uint64_t>(predicate_id));
+  for (int v : tuple) {
+    h = zobrist_mix(h ^ static_cast<std::uint32_t>(v));
+  }
+  return h;
+}
+
+inline std::uint64_t
+zobrist_fluent_key(int function_id, const GroundTuple &tuple, double value) {
+  // 0.0 and -0.0 compare equal hence must hash equally
+  value = (value == 0.0) ? 0.0 : value;
+  std::uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  std::uint64_t h = zobrist_mix(~static_cast<std::uint64_t>(function_id));
+  for (int v : tuple) {
+    h = zobrist_mix(h ^ static_cast<std::uint32_t>(v));
+  }
+  return zobrist_mix(h ^ bits);
+}
+
 struct ActiveDurativeAction {
   int action_id;
   Binding binding;
@@ -61,42 +93,33 @@ struct State {
            active_durative_actions == other.active_durative_actions;
   }
 
-  std::size_t hash() const {
-    std::size_t seed = 0;
-    GroundTupleHash th;
+  /**
+   * @brief Zobrist hash of the atoms and fluents, i.e. the xor of one
+   * pseudo-random key per true atom and per (fluent, value) pair: it does not
+   * depend on the iteration order of the sets, and it can be maintained
+   * incrementally by packed states (see PackedState)
+   */
+  std::uint64_t zobrist_hash() const {
+    std::uint64_t h = 0;
     for (std::size_t i = 0; i < atoms.size(); ++i) {
-      seed ^=
-          std::hash<std::size_t>{}(i) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-      // Sort element hashes for order-independence: TupleSet is an
-      // unordered_set whose iteration order may differ across copies.
-      std::vector<std::size_t> hashes;
-      hashes.reserve(atoms[i].size());
       for (auto &t : atoms[i]) {
-        hashes.push_back(th(t));
-      }
-      std::sort(hashes.begin(), hashes.end());
-      for (auto h : hashes) {
-        seed ^= h + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        h ^= zobrist_atom_key(static_cast<int>(i), t);
       }
     }
     for (std::size_t i = 0; i < fluents.size(); ++i) {
-      seed ^=
-          std::hash<std::size_t>{}(i) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-      // Sort entry hashes for order-independence: FluentMap is an
-      // unordered_map whose iteration order may differ across copies.
-      std::vector<std::size_t> hashes;
-      hashes.reserve(fluents[i].size());
       for (auto &[k, v] : fluents[i]) {
-        std::size_t entry_hash = th(k);
-        entry_hash ^= std::hash<double>{}(v) + 0x9e3779b9 + (entry_hash << 6) +
-                      (entry_hash >> 2);
-        hashes.push_back(entry_hash);
-      }
-      std::sort(hashes.begin(), hashes.end());
-      for (auto h : hashes) {
-        seed ^= h + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        h ^= zobrist_fluent_key(static_cast<int>(i), k, v);
       }
     }
+    return h;
+  }
+
+  std::size_t hash() const { return hash(zobrist_hash()); }
+
+  // Combines the (possibly cached) Zobrist hash of the atoms and fluents with
+  // the temporal members of the state
+  std::size_t hash(std::uint64_t zobrist) const {
+    std::size_t seed = static_cast<std::size_t>(zobrist);
     seed ^= std::hash<double>{}(time) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
     for (auto &ada : active_durative_actions) {
       seed ^= std::hash<int>{}(ada.action_id) + 0x9e3779b9 + (seed << 6) +
@@ -3,10 +3,9 @@
  * LICENSE file in the root directory of this source tree.
  */
 #include "successor_generator.hh"
+#include "compiled_operator.hh"
 #include "task.hh"
 
-#include "../operator.hh"
-
 namespace skdecide {
 
 namespace pddl {
@@ -16,12 +15,12 @@ SuccessorGenerator::SuccessorGenerator(const Task &task) : _task(task) {}
 std::vector<Successor>
 SuccessorGenerator::get_successors(const State &state,
                                    const GroundAction &action) const {
-  auto &effect = _task.actions()[action.action_id]->get_effect();
-  if (!effect) {
+  auto &op = *_task.compiled_actions()[action.action_id];
+  if (!op.has_effect()) {
     return {{state.copy(), 1.0}};
   }
 
-  auto outcomes = effect->apply(state, _task, action.binding);
+  auto outcomes = op.apply(state, _task, action.arguments);
   std::vector<Successor> result;
   result.reserve(outcomes.size());
   for (auto &[prob, s] : outcomes) {
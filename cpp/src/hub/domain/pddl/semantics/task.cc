@@ -3,6 +3,8 @@
  * LICENSE file in the root directory of this source tree.
  */
 #include "task.hh"
+#include "compiled_operator.hh"
+#include "packed_state.hh"
 
 #include <algorithm>
 #include <sstream>
@@ -33,6 +35,22 @@ namespace skdecide {
 
 namespace pddl {
 
+namespace {
+
+template <typename Toperator>
+Task::CompiledOperators
+compile_operators(const Task &task,
+                  const std::vector<std::shared_ptr<Toperator>> &operators) {
+  Task::CompiledOperators result;
+  result.reserve(operators.size());
+  for (auto &op : operators) {
+    result.push_back(CompiledOperator::compile(task, *op));
+  }
+  return result;
+}
+
+} // namespace
+
 Task::Task(const DomainPtr &domain, const ProblemPtr &problem)
     : _domain(domain), _problem(problem) {
   assign_object_ids();
@@ -55,6 +73,12 @@ Task::Task(const DomainPtr &domain, const ProblemPtr &problem)
   }
 
   build_initial_state();
+  _fact_index = std::make_shared<FactIndex>(*this);
+
+  _compiled_actions = compile_operators(*this, _actions);
+  _compiled_events = compile_operators(*this, _events);
+  _compiled_processes = compile_operators(*this, _processes);
+  _compiled_durative_actions = compile_operators(*this, _durative_actions);
 }
 
 Task::Task(const Task &other,
@@ -68,7 +92,12 @@ Task::Task(const Task &other,
       _type_parent(other._type_parent), _actions(std::move(custom_actions)),
       _events(other._events), _processes(other._processes),
       _durative_actions(other._durative_actions),
-      _initial_state(other._initial_state) {}
+      _initial_state(other._initial_state), _fact_index(other._fact_index),
+      _compiled_events(other._compiled_events),
+      _compiled_processes(other._compiled_processes),
+      _compiled_durative_actions(other._compiled_durative_actions) {
+  _compiled_actions = compile_operators(*this, _actions);
+}
 
 int Task::num_objects() const { return static_cast<int>(_object_names.size()); }
 
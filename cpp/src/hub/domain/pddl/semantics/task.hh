@@ -24,6 +24,8 @@ class DurativeAction;
 class Event;
 class Process;
 class Formula;
+class FactIndex;
+class CompiledOperator;
 
 class Task {
 public:
@@ -73,6 +75,24 @@ public:
 
   std::string generate_asp_program() const;
 
+  // Dense index of the ground atoms and fluents, for packed states
+  const FactIndex &fact_index() const { return *_fact_index; }
+
+  // Operators compiled for evaluation on integer bindings, indexed like
+  // actions(), events(), processes() and durative_actions()
+  using CompiledOperators =
+      std::vector<std::shared_ptr<const CompiledOperator>>;
+  const CompiledOperators &compiled_actions() const {
+    return _compiled_actions;
+  }
+  const CompiledOperators &compiled_events() const { return _compiled_events; }
+  const CompiledOperators &compiled_processes() const {
+    return _compiled_processes;
+  }
+  const CompiledOperators &compiled_durative_actions() const {
+    return _compiled_durative_actions;
+  }
+
   const DomainPtr &domain() const { return _domain; }
   const ProblemPtr &problem() const { return _problem; }
 
@@ -114,6 +134,13 @@ private:
   std::vector<std::shared_ptr<DurativeAction>> _durative_actions;
 
   State _initial_state;
+
+  std::shared_ptr<const FactIndex> _fact_index;
+
+  CompiledOperators _compiled_actions;
+  CompiledOperators _compiled_events;
+  CompiledOperators _compiled_processes;
+  CompiledOperators _compiled_durative_actions;
 };
 
 } // namespace pddl
@@ -3,7 +3,9 @@
  * LICENSE file in the root directory of this source tree.
  */
 #include "temporal_simulator.hh"
+#include "compiled_operator.hh"
 #include "goal_checker.hh"
+#include "ground_action_tree.hh"
 #include "successor_generator.hh"
 #include "task.hh"
 
@@ -35,65 +37,34 @@ TemporalSimulator::TemporalSimulator(const Task &task, double epsilon,
       _max_cascade_iterations(max_cascade_iterations),
       _event_time_finder(std::move(event_time_finder)) {
 
-  _asp_program = _task.generate_asp_program();
-
-  for (int pid = 0; pid < _task.num_predicates(); ++pid) {
-    std::string pname = _task.predicate_name(pid);
-    std::string safe_pname = pname;
-    std::replace(safe_pname.begin(), safe_pname.end(), '-', '_');
-    auto &pred = _task.domain()->get_predicate(pname);
-    int arity = static_cast<int>(pred->get_variables().size());
-    _pred_externals.push_back({safe_pname, arity});
-  }
-
-  _ctl = std::make_unique<Clingo::Control>();
-  _ctl->add("base", {}, _asp_program.c_str());
-  _ctl->ground({{"base", {}}});
+  Clingo::Control ctl;
+  ctl.add("base", {}, _task.generate_asp_program().c_str());
+  ctl.ground({{"base", {}}});
+  _actions = std::make_unique<GroundActionTree>(
+      _task, ctl, "applicable_",
+      GroundActionTree::schemas(_task.actions(), _task.compiled_actions()));
+  _durative_actions = std::make_unique<GroundActionTree>(
+      _task, ctl, "applicable_da_",
+      GroundActionTree::schemas(_task.durative_actions(),
+                                _task.compiled_durative_actions()));
+  _processes = std::make_unique<GroundActionTree>(
+      _task, ctl, "active_process_",
+      GroundActionTree::schemas(_task.processes(),
+                                _task.compiled_processes()));
+  _events = std::make_unique<GroundActionTree>(
+      _task, ctl, "event_trigger_",
+      GroundActionTree::schemas(_task.events(), _task.compiled_events()));
 }
 
 TemporalSimulator::~TemporalSimulator() = default;
 
-void TemporalSimulator::set_state(const State &state) const {
-  for (int pid = 0; pid < static_cast<int>(_pred_externals.size()); ++pid) {
-    auto &info = _pred_externals[pid];
-    if (pid >= static_cast<int>(state.atoms.size()))
-      continue;
-    auto &atom_set = state.atoms[pid];
-
-    for (auto &tuple : atom_set) {
-      if (info.arity == 0) {
-        auto sym = Clingo::Id(info.safe_name.c_str());
-        _ctl->assign_external(sym, Clingo::TruthValue::True);
-      } else {
-        std::vector<Clingo::Symbol> args;
-        args.reserve(tuple.size());
-        for (int obj_id : tuple) {
-          args.push_back(Clingo::Number(obj_id));
-        }
-        auto sym = Clingo::Function(info.safe_name.c_str(),
-                                    {args.data(), args.size()});
-        _ctl->assign_external(sym, Clingo::TruthValue::True);
-      }
-    }
-  }
-}
-
-void TemporalSimulator::clear_state() const {
-  for (auto &sa : _ctl->symbolic_atoms()) {
-    if (sa.is_external()) {
-      _ctl->assign_external(sa.symbol(), Clingo::TruthValue::False);
-    }
-  }
-}
-
 State TemporalSimulator::apply_action(const State &state,
                                       const GroundAction &action) const {
-  auto &act = _task.actions()[action.action_id];
-  auto &effect = act->get_effect();
-  if (!effect) {
+  auto &op = *_task.compiled_actions()[action.action_id];
+  if (!op.has_effect()) {
     return state.copy();
   }
-  auto outcomes = effect->apply(state, _task, action.binding);
+  auto outcomes = op.apply(state, _task, action.arguments);
   if (outcomes.empty()) {
     return state.copy();
   }
@@ -111,12 +82,11 @@ State TemporalSimulator::integrate_processes(const State &state,
   s.dt = dt;
 
   for (auto &gp : active_procs) {
-    auto &proc = _task.processes()[gp.action_id];
-    auto &effect = proc->get_effect();
-    if (!effect) {
+    auto &op = *_task.compiled_processes()[gp.action_id];
+    if (!op.has_effect()) {
       continue;
     }
-    auto outcomes = effect->apply(s, _task, gp.binding);
+    auto outcomes = op.apply(s, _task, gp.arguments);
     if (!outcomes.empty()) {
       s = std::move(outcomes[0].second);
       s.dt = dt;
@@ -140,12 +110,11 @@ TemporalSimulator::fire_events(const State &state) const {
 
     any_fired = true;
     for (auto &ge : triggered) {
-      auto &event = _task.events()[ge.action_id];
-      auto &effect = event->get_effect();
-      if (!effect) {
+      auto &op = *_task.compiled_events()[ge.action_id];
+      if (!op.has_effect()) {
         continue;
       }
-      auto outcomes = effect->apply(s, _task, ge.binding);
+      auto outcomes = op.apply(s, _task, ge.arguments);
       if (!outcomes.empty()) {
         s = std::move(outcomes[0].second);
       }
@@ -216,16 +185,15 @@ double TemporalSimulator::evaluate_duration(const State &state, int da_id,
 
 State TemporalSimulator::start_durative_action(
     const State &state, const GroundAction &da_action) const {
-  auto &da = _task.durative_actions()[da_action.action_id];
+  auto &op = *_task.compiled_durative_actions()[da_action.action_id];
   double dur = evaluate_duration(state, da_action.action_id, da_action.binding);
 
   State s = state.copy();
 
   // Apply at-start effects
-  auto &effect = da->get_effect();
-  if (effect) {
+  if (op.has_effect()) {
     s.duration = dur;
-    auto outcomes = effect->apply(s, _task, da_action.binding);
+    auto outcomes = op.apply(s, _task, da_action.arguments);
     if (!outcomes.empty()) {
       s = std::move(outcomes[0].second);
     }
@@ -250,15 +218,14 @@ State TemporalSimulator::end_durative_action(const State &state,
   }
 
   auto &ada = state.active_durative_actions[active_index];
-  auto &da = _task.durative_actions()[ada.action_id];
+  auto &op = *_task.compiled_durative_actions()[ada.action_id];
 
   State s = state.copy();
 
   // Apply at-end effects
-  auto &effect = da->get_effect();
-  if (effect) {
+  if (op.has_effect()) {
     s.duration = ada.end_time - ada.start_time;
-    auto outcomes = effect->apply(s, _task, ada.binding);
+    auto outcomes = op.apply(s, _task, op.arguments(ada.binding));
     if (!outcomes.empty()) {
       s = std::move(outcomes[0].second);
     }
@@ -272,12 +239,11 @@ State TemporalSimulator::end_durative_action(const State &state,
 
 bool TemporalSimulator::check_invariants(const State &state) const {
   for (auto &ada : state.active_durative_actions) {
-    auto &da = _task.durative_actions()[ada.action_id];
-    auto &precond = da->get_condition();
-    if (precond) {
+    auto &op = *_task.compiled_durative_actions()[ada.action_id];
+    if (op.has_condition()) {
       State s_check = state.copy();
       s_check.duration = ada.end_time - ada.start_time;
-      if (!precond->holds(s_check, _task, ada.binding)) {
+      if (!op.holds(s_check, _task, op.arguments(ada.binding))) {
         return false;
       }
     }
@@ -367,172 +333,22 @@ State TemporalSimulator::event_step(const State &state,
 
 std::vector<GroundAction>
 TemporalSimulator::get_applicable_actions(const State &state) const {
-  set_state(state);
-
-  std::vector<GroundAction> result;
-
-  auto handle = _ctl->solve();
-  for (auto &model : handle) {
-    auto symbols = model.symbols(Clingo::ShowType::Shown);
-    for (auto &sym : symbols) {
-      std::string name = sym.name();
-      if (name.substr(0, 11) != "applicable_")
-        continue;
-      if (name.find("applicable_da_") == 0)
-        continue;
-
-      int action_id = std::stoi(name.substr(11));
-      auto &act = _task.actions()[action_id];
-      auto &params = act->get_variables();
-
-      GroundAction ga;
-      ga.action_id = action_id;
-
-      auto args = sym.arguments();
-      ga.arguments.reserve(args.size());
-      for (std::size_t i = 0; i < args.size(); ++i) {
-        int obj_id = args[i].number();
-        ga.arguments.push_back(obj_id);
-        ga.binding[params[i]->get_name()] = obj_id;
-      }
-
-      auto &precond = act->get_condition();
-      if (precond && !precond->holds(state, _task, ga.binding)) {
-        continue;
-      }
-
-      result.push_back(std::move(ga));
-    }
-  }
-
-  clear_state();
-  return result;
+  return _actions->get_applicable(state, true);
 }
 
 std::vector<GroundAction>
 TemporalSimulator::get_applicable_durative_actions(const State &state) const {
-  set_state(state);
-
-  std::vector<GroundAction> result;
-
-  auto handle = _ctl->solve();
-  for (auto &model : handle) {
-    auto symbols = model.symbols(Clingo::ShowType::Shown);
-    for (auto &sym : symbols) {
-      std::string name = sym.name();
-      if (name.find("applicable_da_") != 0)
-        continue;
-
-      int da_id = std::stoi(name.substr(14));
-      auto &da = _task.durative_actions()[da_id];
-      auto &params = da->get_variables();
-
-      GroundAction ga;
-      ga.action_id = da_id;
-
-      auto args = sym.arguments();
-      ga.arguments.reserve(args.size());
-      for (std::size_t i = 0; i < args.size(); ++i) {
-        int obj_id = args[i].number();
-        ga.arguments.push_back(obj_id);
-        ga.binding[params[i]->get_name()] = obj_id;
-      }
-
-      auto &precond = da->get_condition();
-      if (precond && !precond->holds(state, _task, ga.binding)) {
-        continue;
-      }
-
-      result.push_back(std::move(ga));
-    }
-  }
-
-  clear_state();
-  return result;
+  return _durative_actions->get_applicable(state, true);
 }
 
 std::vector<GroundAction>
 TemporalSimulator::get_active_processes(const State &state) const {
-  set_state(state);
-
-  std::vector<GroundAction> result;
-
-  auto handle = _ctl->solve();
-  for (auto &model : handle) {
-    auto symbols = model.symbols(Clingo::ShowType::Shown);
-    for (auto &sym : symbols) {
-      std::string name = sym.name();
-      if (name.find("active_process_") != 0)
-        continue;
-
-      int proc_id = std::stoi(name.substr(15));
-      auto &proc = _task.processes()[proc_id];
-      auto &params = proc->get_variables();
-
-      GroundAction ga;
-      ga.action_id = proc_id;
-
-      auto args = sym.arguments();
-      ga.arguments.reserve(args.size());
-      for (std::size_t i = 0; i < args.size(); ++i) {
-        int obj_id = args[i].number();
-        ga.arguments.push_back(obj_id);
-        ga.binding[params[i]->get_name()] = obj_id;
-      }
-
-      auto &precond = proc->get_condition();
-      if (precond && !precond->holds(state, _task, ga.binding)) {
-        continue;
-      }
-
-      result.push_back(std::move(ga));
-    }
-  }
-
-  clear_state();
-  return result;
+  return _processes->get_applicable(state, true);
 }
 
 std::vector<GroundAction>
 TemporalSimulator::get_triggered_events(const State &state) const {
-  set_state(state);
-
-  std::vector<GroundAction> result;
-
-  auto handle = _ctl->solve();
-  for (auto &model : handle) {
-    auto symbols = model.symbols(Clingo::ShowType::Shown);
-    for (auto &sym : symbols) {
-      std::string name = sym.name();
-      if (name.find("event_trigger_") != 0)
-        continue;
-
-      int event_id = std::stoi(name.substr(14));
-      auto &event = _task.events()[event_id];
-      auto &params = event->get_variables();
-
-      GroundAction ga;
-      ga.action_id = event_id;
-
-      auto args = sym.arguments();
-      ga.arguments.reserve(args.size());
-      for (std::size_t i = 0; i < args.size(); ++i) {
-        int obj_id = args[i].number();
-        ga.arguments.push_back(obj_id);
-        ga.binding[params[i]->get_name()] = obj_id;
-      }
-
-      auto &precond = event->get_condition();
-      if (precond && !precond->holds(state, _task, ga.binding)) {
-        continue;
-      }
-
-      result.push_back(std::move(ga));
-    }
-  }
-
-  clear_state();
-  return result;
+  return _events->get_applicable(state, true);
 }
 
 bool TemporalSimulator::is_goal(const State &state) const {
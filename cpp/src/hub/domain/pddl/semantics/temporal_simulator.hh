@@ -14,15 +14,12 @@
 #include "applicable_actions_generator.hh"
 #include "state.hh"
 
-namespace Clingo {
-class Control;
-}
-
 namespace skdecide {
 
 namespace pddl {
 
 class Task;
+class GroundActionTree;
 
 class TemporalSimulator {
 public:
@@ -59,8 +56,12 @@ public:
 
 private:
   const Task &_task;
-  std::unique_ptr<Clingo::Control> _ctl;
-  std::string _asp_program;
+
+  // Ground operators compiled once from the Clingo grounding of the task
+  std::unique_ptr<GroundActionTree> _actions;
+  std::unique_ptr<GroundActionTree> _durative_actions;
+  std::unique_ptr<GroundActionTree> _processes;
+  std::unique_ptr<GroundActionTree> _events;
 
   double _epsilon;
   double _max_event_lookahead;
@@ -68,15 +69,6 @@ private:
 
   EventTimeFinderFn _event_time_finder;
 
-  struct PredicateExternalInfo {
-    std::string safe_name;
-    int arity;
-  };
-  std::vector<PredicateExternalInfo> _pred_externals;
-
-  void set_state(const State &state) const;
-  void clear_state() const;
-
   double evaluate_duration(const State &state, int da_id,
                            const Binding &binding) const;
   double find_next_event_time_binary(const State &state) const;
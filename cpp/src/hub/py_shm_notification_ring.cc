@@ -0,0 +1,27 @@
+/* Copyright (c) AIRBUS and its affiliates.
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#include <pybind11/pybind11.h>
+
+#include "utils/shm_notification_ring.hh"
+
+namespace py = pybind11;
+
+// Producer side of the shared memory IPC transport, used by the processes of
+// the python parallel domain; it mimics the send() and close() methods of the
+// pynng sockets used by the default transport
+void init_pyshm_notification_ring(py::module &m) {
+  py::class_<skdecide::ShmNotificationRing> py_shm_notification_ring(
+      m, "_ShmNotificationRing_");
+  py_shm_notification_ring
+      .def(py::init<const std::string &>(), py::arg("address"))
+      .def("send", &skdecide::ShmNotificationRing::send, py::arg("message"),
+           py::call_guard<py::gil_scoped_release>())
+      .def("close", &skdecide::ShmNotificationRing::close,
+           py::call_guard<py::gil_scoped_release>())
+      .def_static("unlink", &skdecide::ShmNotificationRing::unlink,
+                  py::arg("address"))
+      .def_static("is_address", &skdecide::ShmNotificationRing::is_address,
+                  py::arg("address"));
+}
@@ -43,6 +43,7 @@ void init_pyidual(py::module &m);
 void init_pywitness(py::module &m);
 #endif
 void init_pypddl(py::module &m);
+void init_pyshm_notification_ring(py::module &m);
 
 PYBIND11_MODULE(__skdecide_hub_cpp, m) {
   skdecide::Globals::init();
@@ -80,4 +81,5 @@ PYBIND11_MODULE(__skdecide_hub_cpp, m) {
   init_pywitness(m);
 #endif
   init_pypddl(m);
+  init_pyshm_notification_ring(m);
 }
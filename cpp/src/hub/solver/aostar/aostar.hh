@@ -13,7 +13,9 @@
 #include <chrono>
 
 #include "utils/associative_container_deducer.hh"
+#include "utils/concurrent_set.hh"
 #include "utils/execution.hh"
+#include "utils/node_arena.hh"
 
 namespace skdecide {
 
@@ -189,10 +191,11 @@ private:
   ExecutionPolicy _execution_policy;
 
   struct ActionNode;
+  typedef NodeArena<ActionNode, ExecutionPolicy> ActionArena;
 
   struct StateNode {
     State state;
-    std::list<std::unique_ptr<ActionNode>> actions;
+    std::list<typename ActionArena::Pointer> actions;
     ActionNode *best_action;
     double best_value;
     bool solved;
@@ -219,7 +222,10 @@ private:
     bool operator()(StateNode *&a, StateNode *&b) const;
   };
 
-  typedef typename SetTypeDeducer<StateNode, State>::Set Graph;
+  typedef typename ConcurrentSetTypeDeducer<
+      StateNode, State, ExecutionPolicy, NodeArenaAllocator<StateNode>>::Set
+      Graph;
+  ActionArena _action_arena; // must outlive the graph
   Graph _graph;
 
   typedef std::priority_queue<StateNode *, std::vector<StateNode *>,
@@ -38,6 +38,7 @@ SK_AOSTAR_SOLVER_TEMPLATE_DECL
 void SK_AOSTAR_SOLVER_CLASS::clear() {
   _priority_queue = PriorityQueue();
   _graph.clear();
+  _action_arena.release();
 }
 
 SK_AOSTAR_SOLVER_TEMPLATE_DECL
@@ -179,8 +180,8 @@ void SK_AOSTAR_SOLVER_CLASS::expand_action(StateNode *best_tip_node,
   if (_verbose)
     Logger::debug("Current expanded action: " + a.print() +
                   ExecutionPolicy::print_thread());
-  _execution_policy.protect([&best_tip_node, &a] {
-    best_tip_node->actions.push_back(std::make_unique<ActionNode>(a));
+  _execution_policy.protect([this, &best_tip_node, &a] {
+    best_tip_node->actions.push_back(_action_arena.make(nullptr, a));
   });
   ActionNode &an = *(best_tip_node->actions.back());
   an.parent = best_tip_node;
@@ -190,9 +191,7 @@ void SK_AOSTAR_SOLVER_CLASS::expand_action(StateNode *best_tip_node,
     if (_verbose)
       Logger::debug("Current next state expansion: " + ns.state().print() +
                     ExecutionPolicy::print_thread());
-    std::pair<typename Graph::iterator, bool> i;
-    _execution_policy.protect(
-        [this, &i, &ns] { i = _graph.emplace(ns.state()); });
+    std::pair<typename Graph::iterator, bool> i = _graph.emplace(ns.state());
     StateNode &next_node = const_cast<StateNode &>(
         *(i.first)); // we won't change the real key
                      // (StateNode::state) so we are safe
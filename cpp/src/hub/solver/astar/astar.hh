@@ -16,6 +16,7 @@
 #include "utils/string_converter.hh"
 #include "utils/execution.hh"
 #include "utils/logging.hh"
+#include "utils/node_arena.hh"
 
 namespace skdecide {
 
@@ -217,7 +218,8 @@ private:
     bool operator()(Node *&a, Node *&b) const;
   };
 
-  typedef typename SetTypeDeducer<Node, State>::Set Graph;
+  typedef
+      typename SetTypeDeducer<Node, State, NodeArenaAllocator<Node>>::Set Graph;
   Graph _graph;
 
   typedef std::priority_queue<Node *, std::vector<Node *>, NodeCompare>
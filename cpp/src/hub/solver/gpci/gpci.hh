@@ -131,7 +131,7 @@ private:
   std::chrono::time_point<std::chrono::high_resolution_clock> _start_time;
 
   void enumerate_reachable_states(const State &s);
-  void expand(StateNode &s);
+  std::vector<StateNode *> expand_layer(const std::vector<StateNode *> &layer);
   double probability_update(StateNode &s);
   double cost_update(StateNode &s);
 };
@@ -7,8 +7,9 @@
 
 #include <cmath>
 #include <limits>
-#include <queue>
+#include <algorithm>
 
+#include "utils/batched_domain_calls.hh"
 #include "utils/logging.hh"
 #include "utils/string_converter.hh"
 
@@ -156,7 +157,7 @@ void SK_GPCI_SOLVER_CLASS::enumerate_reachable_states(const State &s) {
   if (_verbose)
     Logger::debug("Enumerating reachable states from " + s.print());
 
-  std::queue<StateNode *> frontier;
+  std::vector<StateNode *> layer;
 
   auto si = _graph.emplace(s);
   StateNode &root = const_cast<StateNode &>(*(si.first));
@@ -168,30 +169,14 @@ void SK_GPCI_SOLVER_CLASS::enumerate_reachable_states(const State &s) {
     } else if (_domain.is_terminal(s)) {
       root.terminal = true;
     } else {
-      frontier.push(&root);
+      layer.push_back(&root);
     }
   } else if (root.actions.empty() && !root.terminal) {
-    frontier.push(&root);
+    layer.push_back(&root);
   }
 
-  while (!frontier.empty()) {
-    StateNode *current = frontier.front();
-    frontier.pop();
-
-    if (current->terminal || !current->actions.empty()) {
-      continue;
-    }
-
-    expand(*current);
-
-    for (const auto &an : current->actions) {
-      for (const auto &outcome : an->outcomes) {
-        StateNode *ns = std::get<2>(outcome);
-        if (ns->actions.empty() && !ns->terminal) {
-          frontier.push(ns);
-        }
-      }
-    }
+  while (!layer.empty()) {
+    layer = expand_layer(layer);
   }
 
   _non_goal_states.clear();
@@ -204,43 +189,108 @@ void SK_GPCI_SOLVER_CLASS::enumerate_reachable_states(const State &s) {
 }
 
 SK_GPCI_SOLVER_TEMPLATE_DECL
-void SK_GPCI_SOLVER_CLASS::expand(StateNode &s) {
+std::vector<typename SK_GPCI_SOLVER_CLASS::StateNode *>
+SK_GPCI_SOLVER_CLASS::expand_layer(const std::vector<StateNode *> &layer) {
   if (_verbose)
-    Logger::debug("Expanding state " + s.state.print());
-
-  auto applicable_actions =
-      _domain.get_applicable_actions(s.state).get_elements();
-
-  std::for_each(
-      ExecutionPolicy::policy, applicable_actions.begin(),
-      applicable_actions.end(), [this, &s](auto a) {
-        _execution_policy.protect(
-            [&s, &a] { s.actions.push_back(std::make_unique<ActionNode>(a)); });
-        ActionNode &an = *(s.actions.back());
-        auto next_states =
-            _domain.get_next_state_distribution(s.state, a).get_values();
-
-        for (auto ns : next_states) {
-          std::pair<typename Graph::iterator, bool> i;
+    Logger::debug("Expanding BFS layer of " +
+                  StringConverter::from(layer.size()) + " states");
+
+  std::vector<const State *> states(layer.size());
+  std::transform(layer.begin(), layer.end(), states.begin(),
+                 [](StateNode *sn) { return &(sn->state); });
+
+  for_each_applicable_actions<ExecutionPolicy>(
+      _domain, states, [this, &layer](const std::size_t &i, auto &actions) {
+        StateNode &s = *layer[i];
+        for (const auto &a : actions.get_elements()) {
+          s.actions.push_back(std::make_unique<ActionNode>(a));
+        }
+      });
+
+  std::vector<const State *> tr_states;
+  std::vector<const Action *> tr_actions;
+  std::vector<ActionNode *> tr_nodes;
+  for (auto *sn : layer) {
+    for (const auto &an : sn->actions) {
+      tr_states.push_back(&(sn->state));
+      tr_actions.push_back(&(an->action));
+      tr_nodes.push_back(an.get());
+    }
+  }
+
+  std::vector<StateNode *> new_nodes;
+  for_each_next_state_distribution<ExecutionPolicy>(
+      _domain, tr_states, tr_actions,
+      [this, &tr_nodes, &new_nodes](const std::size_t &i, auto &distribution) {
+        ActionNode &an = *tr_nodes[i];
+        for (auto ns : distribution.get_values()) {
+          std::pair<typename Graph::iterator, bool> si;
           _execution_policy.protect(
-              [this, &i, &ns] { i = _graph.emplace(ns.state()); });
-          StateNode &next_node = const_cast<StateNode &>(*(i.first));
-          an.outcomes.push_back(std::make_tuple(
-              ns.probability(),
-              _domain.get_transition_value(s.state, a, next_node.state).cost(),
-              &next_node));
-
-          if (i.second) {
-            if (_goal_checker(_domain, next_node.state)) {
-              next_node.goal = true;
-              next_node.terminal = true;
-              next_node.goal_probability = 1.0;
-            } else if (_domain.is_terminal(next_node.state)) {
-              next_node.terminal = true;
-            }
+              [this, &si, &ns] { si = _graph.emplace(ns.state()); });
+          StateNode &next_node = const_cast<StateNode &>(*(si.first));
+          an.outcomes.push_back(
+              std::make_tuple(ns.probability(), 0.0, &next_node));
+          if (si.second) { // new node
+            _execution_policy.protect(
+                [&new_nodes, &next_node] { new_nodes.push_back(&next_node); });
           }
         }
       });
+
+  std::vector<const State *> v_states;
+  std::vector<const Action *> v_actions;
+  std::vector<const State *> v_next_states;
+  std::vector<std::tuple<double, double, StateNode *> *> v_outcomes;
+  for (std::size_t i = 0; i < tr_nodes.size(); i++) {
+    for (auto &o : tr_nodes[i]->outcomes) {
+      v_states.push_back(tr_states[i]);
+      v_actions.push_back(tr_actions[i]);
+      v_next_states.push_back(&(std::get<2>(o)->state));
+      v_outcomes.push_back(&o);
+    }
+  }
+
+  for_each_transition_value<ExecutionPolicy>(
+      _domain, v_states, v_actions, v_next_states,
+      [&v_outcomes](const std::size_t &i, auto &value) {
+        std::get<1>(*v_outcomes[i]) = value.cost();
+      });
+
+  // Goal states are terminal: only test the other new states for termination
+  for_each_index<ExecutionPolicy>(
+      new_nodes.size(), [this, &new_nodes](const std::size_t &i) {
+        StateNode &next_node = *new_nodes[i];
+        if (_goal_checker(_domain, next_node.state)) {
+          next_node.goal = true;
+          next_node.terminal = true;
+          next_node.goal_probability = 1.0;
+        }
+      });
+  std::vector<StateNode *> non_goal_nodes;
+  std::copy_if(new_nodes.begin(), new_nodes.end(),
+               std::back_inserter(non_goal_nodes),
+               [](StateNode *sn) { return !sn->goal; });
+
+  std::vector<const State *> new_states(non_goal_nodes.size());
+  std::transform(non_goal_nodes.begin(), non_goal_nodes.end(),
+                 new_states.begin(),
+                 [](StateNode *sn) { return &(sn->state); });
+  std::vector<StateNode *> next_layer;
+
+  for_each_terminal<ExecutionPolicy>(
+      _domain, new_states,
+      [this, &non_goal_nodes, &next_layer](const std::size_t &i,
+                                           bool terminal) {
+        StateNode &next_node = *non_goal_nodes[i];
+        if (terminal) {
+          next_node.terminal = true;
+        } else {
+          _execution_policy.protect(
+              [&next_layer, &next_node] { next_layer.push_back(&next_node); });
+        }
+      });
+
+  return next_layer;
 }
 
 // Phase 1: P*_n(s) = max_a Σ T(s,a,s') P*_{n-1}(s')
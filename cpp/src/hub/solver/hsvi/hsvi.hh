@@ -13,12 +13,17 @@
 #include <numeric>
 #include <optional>
 #include <set>
+#include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+#include "utils/alpha_vector_matrix.hh"
+#include "utils/belief_vector.hh"
 #include "utils/execution.hh"
 #include "utils/logging.hh"
+#include "utils/observation_transition_tensors.hh"
+#include "utils/pomdp_model_cache.hh"
 
 namespace skdecide {
 
@@ -36,6 +41,16 @@ namespace skdecide {
  * the upper bound (optimistic) and observations via excess uncertainty.
  * Converges when the gap at the initial belief falls below epsilon.
  *
+ * Beliefs are keyed by state hash at the interface of the solver, and
+ * internally represented as BeliefVector objects over the enumerated state
+ * indices so that bound evaluations run as vectorized dot products. The
+ * alpha-vectors are stored as the rows of an AlphaVectorMatrix, so that the
+ * lower bounds of all the posteriors of a belief are evaluated as one blocked
+ * matrix product. The transition and observation probabilities are compiled
+ * into ObservationTransitionTensors, so that belief updates and alpha-vector
+ * backups are sparse matrix products, and the queried model can be saved to
+ * a cache file reloaded by the next solves of the same domain.
+ *
  * @tparam Tdomain Type of the domain class (must be PartiallyObservable)
  * @tparam Texecution_policy Type of the execution policy
  */
@@ -82,6 +97,13 @@ public:
    * @param callback Functor called at each exploration iteration. Returns
    *   true to stop solving. Defaults to never stop.
    * @param verbose Whether to log verbose messages. Defaults to false.
+   * @param model_cache_path Path of the file caching the model queried from
+   *   the domain: the model is loaded from it if it was saved for the same
+   *   states and actions, and otherwise queried from the domain then saved
+   *   to it. The file must be deleted when the dynamics of the domain change.
+   *   With a cache, states, actions and observations are identified by their
+   *   print() (see pomdp_model_cache::stable_id()). Defaults to "" (no
+   *   cache).
    */
   HSVISolver(
       Domain &domain, double epsilon = 0.001, double discount = 0.95,
@@ -91,7 +113,7 @@ public:
       double prob_epsilon = 1e-15, double belief_hash_resolution = 1000.0,
       const CallbackFunctor &callback = [](const HSVISolver &,
                                            Domain &) { return false; },
-      bool verbose = false);
+      bool verbose = false, const std::string &model_cache_path = "");
 
   virtual ~HSVISolver() = default;
 
@@ -117,18 +139,16 @@ public:
   const std::unordered_map<std::size_t, State> &get_index_to_state() const;
 
 protected:
-  struct AlphaVector {
-    std::vector<double> values;
-    Action action;
-    std::size_t id;
-
-    AlphaVector() : id(0) {}
-    AlphaVector(std::size_t num_states, const Action &a, std::size_t vid)
-        : values(num_states, 0.0), action(a), id(vid) {}
+  // Posterior of a belief after an action and an observation of positive
+  // probability
+  struct Successor {
+    std::size_t obs_idx; // index in the observations of the action
+    double obs_probability;
+    BeliefVector belief;
   };
 
   struct BoundPoint {
-    Belief belief;
+    BeliefVector belief;
     double value;
   };
 
@@ -150,6 +170,9 @@ protected:
 
   virtual void make_value_obj(double v, Value &out) const { out.reward(v); }
 
+  // Meaning of the values of the model cache
+  virtual std::string model_value_kind() const { return "reward"; }
+
   virtual double convergence_threshold(std::size_t depth) const {
     return _epsilon * std::pow(_discount, -static_cast<double>(depth));
   }
@@ -165,39 +188,67 @@ protected:
 
   void enumerate_states(const Belief &b0);
   void pre_cache_model();
+  // Queries the transitions, values and observation distributions from the
+  // domain
+  void query_model(pomdp_model_cache::Observations &observations);
+  // Identifier of an observation in the model: its stable_id() if the model
+  // is cached on disk, so that other processes can load the cache, and
+  // otherwise its hash
+  std::size_t observation_id(const Observation &o) const;
   virtual void initialize_alpha_bound();
   virtual void initialize_point_bound();
 
   void create_blind_policy_alphas();
 
-  void explore(const Belief &b, std::size_t depth,
+  void explore(const BeliefVector &b, std::size_t depth,
                std::unordered_set<std::size_t> &closed_list);
 
-  void alpha_backup(const Belief &b);
-  void point_update(const Belief &b);
-
-  double evaluate_alpha(const Belief &b) const;
-  double evaluate_sawtooth(const Belief &b) const;
-  double evaluate_sawtooth_corner(const Belief &b) const;
-
-  virtual double evaluate_upper(const Belief &b) const {
+  // Successors of b for each action (in the order of _action_obs_hashes)
+  std::vector<std::vector<Successor>>
+  compute_successors(const BeliefVector &b) const;
+
+  // Batched evaluate_alpha() and best_alpha_index() of the successors, in the
+  // order of the actions then of the successors of each action
+  void evaluate_alpha(const std::vector<std::vector<Successor>> &successors,
+                      std::vector<double> &values,
+                      std::vector<std::size_t> &indices) const;
+
+  // alpha_values and alpha_indices are the ones computed by evaluate_alpha()
+  // for the successors of b; the alpha_values are then updated with the new
+  // alpha-vector
+  void alpha_backup(const BeliefVector &b,
+                    const std::vector<std::vector<Successor>> &successors,
+                    std::vector<double> &alpha_values,
+                    const std::vector<std::size_t> &alpha_indices);
+  void point_update(const BeliefVector &b,
+                    const std::vector<std::vector<Successor>> &successors,
+                    const std::vector<double> &alpha_values);
+
+  double evaluate_alpha(const BeliefVector &b) const;
+  double evaluate_sawtooth(const BeliefVector &b) const;
+  double evaluate_sawtooth_corner(const BeliefVector &b) const;
+
+  virtual double evaluate_upper(const BeliefVector &b) const {
     return evaluate_sawtooth(b);
   }
 
-  virtual double evaluate_lower(const Belief &b) const {
+  virtual double evaluate_lower(const BeliefVector &b) const {
     return evaluate_alpha(b);
   }
 
-  double dot_product(const AlphaVector &alpha, const Belief &b) const;
-  std::size_t best_alpha_index(const Belief &b) const;
+  std::size_t best_alpha_index(const BeliefVector &b) const;
 
-  Belief compute_posterior(const Belief &b, std::size_t action_idx,
-                           std::size_t obs_hash) const;
+  // Posterior of b after action_idx and obs_idx (index in the observations of
+  // the action), empty if the observation probability (received by
+  // obs_probability if not null) is negligible
+  BeliefVector compute_posterior(const BeliefVector &b, std::size_t action_idx,
+                                 std::size_t obs_idx,
+                                 double *obs_probability = nullptr) const;
 
-  double compute_obs_probability(const Belief &b, std::size_t action_idx,
-                                 std::size_t obs_hash) const;
+  std::size_t belief_hash(const BeliefVector &b) const;
 
-  std::size_t belief_hash(const Belief &b) const;
+  // Converts a belief keyed by state hash, ignoring unknown states
+  BeliefVector to_belief_vector(const Belief &b) const;
 
   void update_current_belief(const Observation &obs);
 
@@ -216,6 +267,7 @@ protected:
   double _belief_hash_resolution;
   CallbackFunctor _callback;
   bool _verbose;
+  std::string _model_cache_path;
 
   ExecutionPolicy _execution_policy;
 
@@ -226,21 +278,19 @@ protected:
   std::unordered_map<std::size_t, std::size_t> _action_hash_to_idx;
   std::vector<std::vector<std::vector<std::pair<double, std::size_t>>>>
       _transitions;
-  std::vector<std::vector<std::unordered_map<std::size_t, double>>> _obs_prob;
   std::vector<std::vector<double>> _values;
-  std::unordered_map<std::size_t, Observation> _obs_objects;
   std::vector<std::vector<std::size_t>> _action_obs_hashes;
+  ObservationTransitionTensors _tensors;
   std::vector<std::size_t> _state_idx_to_hash;
   std::vector<bool> _is_terminal_cache;
 
-  std::vector<AlphaVector> _alpha_vectors;
-  std::size_t _next_alpha_id = 0;
+  AlphaVectorMatrix _alpha_vectors;
 
   std::vector<double> _mdp_values;
   std::vector<BoundPoint> _bound_points;
 
-  Belief _initial_belief;
-  Belief _current_belief;
+  BeliefVector _initial_belief;
+  BeliefVector _current_belief;
   Action _last_action;
   bool _has_last_action = false;
 
@@ -313,6 +363,8 @@ public:
    * @param dead_end_cost Cost assigned to non-goal terminal states (dead
    *   ends). If nullopt, automatically computed from transition costs and
    *   depth/discount. Defaults to nullopt.
+   * @param model_cache_path Path of the file caching the model queried from
+   *   the domain (see HSVISolver). Defaults to "" (no cache).
    */
   GoalHSVISolver(
       Domain &domain, const GoalCheckerFunctor &goal_checker,
@@ -323,7 +375,8 @@ public:
       double prob_epsilon = 1e-15, double belief_hash_resolution = 1000.0,
       const CallbackFunctor &callback = [](const Base &,
                                            Domain &) { return false; },
-      bool verbose = false, std::optional<double> dead_end_cost = std::nullopt);
+      bool verbose = false, std::optional<double> dead_end_cost = std::nullopt,
+      const std::string &model_cache_path = "");
 
   void clear() override;
 
@@ -339,11 +392,12 @@ protected:
   bool _is_better(double a, double b) const override { return a < b; }
   double _get_value(const Value &v) const override { return v.cost(); }
   void make_value_obj(double v, Value &out) const override { out.cost(v); }
+  std::string model_value_kind() const override { return "cost"; }
 
-  double evaluate_upper(const Belief &b) const override {
+  double evaluate_upper(const BeliefVector &b) const override {
     return this->evaluate_alpha(b);
   }
-  double evaluate_lower(const Belief &b) const override {
+  double evaluate_lower(const BeliefVector &b) const override {
     return this->evaluate_sawtooth(b);
   }
 
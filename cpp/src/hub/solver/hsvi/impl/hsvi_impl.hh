@@ -29,7 +29,8 @@ SK_HSVI_CLASS::HSVISolver(Domain &domain, double epsilon, double discount,
                           std::size_t max_vi_iterations,
                           double vi_convergence_factor, double prob_epsilon,
                           double belief_hash_resolution,
-                          const CallbackFunctor &callback, bool verbose)
+                          const CallbackFunctor &callback, bool verbose,
+                          const std::string &model_cache_path)
     : _domain(domain), _epsilon(epsilon), _discount(discount),
       _time_budget(time_budget), _max_sample_depth(max_sample_depth),
       _use_closed_list(use_closed_list), _depth_bound_eta(depth_bound_eta),
@@ -37,7 +38,7 @@ SK_HSVI_CLASS::HSVISolver(Domain &domain, double epsilon, double discount,
       _vi_convergence_factor(vi_convergence_factor),
       _prob_epsilon(prob_epsilon),
       _belief_hash_resolution(belief_hash_resolution), _callback(callback),
-      _verbose(verbose) {}
+      _verbose(verbose), _model_cache_path(model_cache_path) {}
 
 SK_HSVI_TEMPLATE_DECL
 void SK_HSVI_CLASS::clear() {
@@ -47,12 +48,10 @@ void SK_HSVI_CLASS::clear() {
   _actions.clear();
   _action_hash_to_idx.clear();
   _transitions.clear();
-  _obs_prob.clear();
   _values.clear();
-  _obs_objects.clear();
   _action_obs_hashes.clear();
+  _tensors.clear();
   _alpha_vectors.clear();
-  _next_alpha_id = 0;
   _mdp_values.clear();
   _bound_points.clear();
   _is_terminal_cache.clear();
@@ -135,29 +134,61 @@ void SK_HSVI_CLASS::enumerate_states(const Belief &b0) {
 
 SK_HSVI_TEMPLATE_DECL
 void SK_HSVI_CLASS::pre_cache_model() {
-  std::size_t ns = _states.size();
-  std::size_t na = _actions.size();
+  pomdp_model_cache::Observations observations;
+  std::vector<std::size_t> state_ids;
+  std::vector<std::size_t> action_ids;
+  if (!_model_cache_path.empty()) {
+    state_ids = pomdp_model_cache::stable_ids(_states);
+    action_ids = pomdp_model_cache::stable_ids(_actions);
+  }
 
-  _transitions.resize(
-      ns, std::vector<std::vector<std::pair<double, std::size_t>>>(na));
-  _obs_prob.resize(ns,
-                   std::vector<std::unordered_map<std::size_t, double>>(na));
-  _values.resize(ns, std::vector<double>(na, 0.0));
-  _action_obs_hashes.resize(na);
+  if (!_model_cache_path.empty() &&
+      pomdp_model_cache::load(_model_cache_path, model_value_kind(), state_ids,
+                              action_ids, _transitions, _values, observations,
+                              _action_obs_hashes)) {
+    if (_verbose) {
+      Logger::info("HSVI: loaded model from " + _model_cache_path);
+    }
+  } else {
+    query_model(observations);
+    if (!_model_cache_path.empty()) {
+      bool saved = pomdp_model_cache::save(
+          _model_cache_path, model_value_kind(), state_ids, action_ids,
+          _transitions, _values, observations, _action_obs_hashes);
+      if (saved && _verbose) {
+        Logger::info("HSVI: saved model to " + _model_cache_path);
+      }
+    }
+  }
 
-  std::vector<std::unordered_set<std::size_t>> action_obs_sets(na);
+  _tensors.template build<ExecutionPolicy>(_transitions, observations,
+                                           _action_obs_hashes);
 
-  for (std::size_t i = 0; i < ns; ++i) {
-    _transitions[i].resize(na);
-    _obs_prob[i].resize(na);
+  if (_verbose) {
+    Logger::info("HSVI: pre-cached model with " +
+                 std::to_string(_tensors.nb_entries()) +
+                 " transition-observation entries");
   }
+}
+
+SK_HSVI_TEMPLATE_DECL
+void SK_HSVI_CLASS::query_model(
+    pomdp_model_cache::Observations &observations) {
+  std::size_t ns = _states.size();
+  std::size_t na = _actions.size();
+
+  _transitions.assign(
+      ns, std::vector<std::vector<std::pair<double, std::size_t>>>(na));
+  _values.assign(ns, std::vector<double>(na, 0.0));
+  observations.assign(
+      ns, std::vector<std::vector<std::pair<std::size_t, double>>>(na));
 
   std::vector<std::size_t> state_indices(ns);
   std::iota(state_indices.begin(), state_indices.end(), 0);
 
   std::for_each(
       ExecutionPolicy::policy, state_indices.begin(), state_indices.end(),
-      [this, na, &action_obs_sets](std::size_t si) {
+      [this, na](std::size_t si) {
         if (_is_terminal_cache[si])
           return;
 
@@ -181,38 +212,60 @@ void SK_HSVI_CLASS::pre_cache_model() {
             double v = _get_value(
                 _domain.get_transition_value(s, _actions[ai], _states[ns_idx]));
             weighted_value += prob * v;
-
-            auto obs_dist =
-                _domain
-                    .get_observation_distribution(_states[ns_idx], _actions[ai])
-                    .get_values();
-
-            _execution_policy.protect([this, &obs_dist, ns_idx, ai,
-                                       &action_obs_sets] {
-              for (auto od : obs_dist) {
-                std::size_t oh = typename Observation::Hash()(od.observation());
-                _obs_prob[ns_idx][ai][oh] = od.probability();
-                if (_obs_objects.find(oh) == _obs_objects.end()) {
-                  _obs_objects[oh] = od.observation();
-                }
-                action_obs_sets[ai].insert(oh);
-              }
-            });
           }
 
           _values[si][ai] = weighted_value;
         }
       });
 
+  // The observation distribution of each reachable (s', a) is queried once,
+  // rather than once per predecessor of s'
+  std::vector<std::vector<bool>> reachable(ns, std::vector<bool>(na, false));
+  for (std::size_t si = 0; si < ns; ++si) {
+    for (std::size_t ai = 0; ai < na; ++ai) {
+      for (const auto &tr : _transitions[si][ai]) {
+        reachable[tr.second][ai] = true;
+      }
+    }
+  }
+
+  std::vector<std::unordered_set<std::size_t>> action_obs_sets(na);
+
+  std::for_each(
+      ExecutionPolicy::policy, state_indices.begin(), state_indices.end(),
+      [this, na, &reachable, &observations, &action_obs_sets](std::size_t si) {
+        for (std::size_t ai = 0; ai < na; ++ai) {
+          if (!reachable[si][ai])
+            continue;
+
+          auto obs_dist =
+              _domain.get_observation_distribution(_states[si], _actions[ai])
+                  .get_values();
+          for (auto od : obs_dist) {
+            observations[si][ai].emplace_back(
+                observation_id(od.observation()), od.probability());
+          }
+
+          _execution_policy.protect(
+              [&observations, &action_obs_sets, si, ai] {
+                for (const auto &op : observations[si][ai]) {
+                  action_obs_sets[ai].insert(op.first);
+                }
+              });
+        }
+      });
+
+  _action_obs_hashes.assign(na, std::vector<std::size_t>());
   for (std::size_t ai = 0; ai < na; ++ai) {
     _action_obs_hashes[ai].assign(action_obs_sets[ai].begin(),
                                   action_obs_sets[ai].end());
   }
+}
 
-  if (_verbose) {
-    Logger::info("HSVI: pre-cached model with " +
-                 std::to_string(_obs_objects.size()) + " observations");
-  }
+SK_HSVI_TEMPLATE_DECL
+std::size_t SK_HSVI_CLASS::observation_id(const Observation &o) const {
+  return _model_cache_path.empty() ? typename Observation::Hash()(o)
+                                   : pomdp_model_cache::stable_id(o);
 }
 
 SK_HSVI_TEMPLATE_DECL
@@ -224,17 +277,17 @@ void SK_HSVI_CLASS::create_blind_policy_alphas() {
   std::iota(state_indices.begin(), state_indices.end(), 0);
 
   for (std::size_t ai = 0; ai < na; ++ai) {
-    AlphaVector alpha(ns, _actions[ai], _next_alpha_id++);
+    std::vector<double> alpha(ns);
 
     for (std::size_t si = 0; si < ns; ++si) {
       if (_is_terminal_cache[si]) {
-        alpha.values[si] = get_terminal_state_value(si);
+        alpha[si] = get_terminal_state_value(si);
         continue;
       }
       if (_discount < 1.0) {
-        alpha.values[si] = _values[si][ai] / (1.0 - _discount);
+        alpha[si] = _values[si][ai] / (1.0 - _discount);
       } else {
-        alpha.values[si] = _values[si][ai] * _max_sample_depth;
+        alpha[si] = _values[si][ai] * _max_sample_depth;
       }
     }
 
@@ -250,20 +303,20 @@ void SK_HSVI_CLASS::create_blind_policy_alphas() {
             }
             double v = _values[si][ai];
             for (const auto &tr : _transitions[si][ai]) {
-              v += _discount * tr.first * alpha.values[tr.second];
+              v += _discount * tr.first * alpha[tr.second];
             }
             new_values[si] = v;
-            double change = std::abs(v - alpha.values[si]);
+            double change = std::abs(v - alpha[si]);
             _execution_policy.protect([&max_change, change] {
               max_change = std::max(max_change, change);
             });
           });
-      alpha.values = std::move(new_values);
+      alpha = std::move(new_values);
       if (max_change < _epsilon * _vi_convergence_factor)
         break;
     }
 
-    _alpha_vectors.push_back(std::move(alpha));
+    _alpha_vectors.append(alpha.data(), ai);
   }
 }
 
@@ -349,22 +402,25 @@ void SK_HSVI_CLASS::solve(
     const std::vector<std::pair<State, double>> &initial_distribution) {
   _start_time = std::chrono::high_resolution_clock::now();
 
-  _initial_belief.clear();
+  Belief b0;
   for (const auto &p : initial_distribution) {
     std::size_t sh = typename State::Hash()(p.first);
     if (_index_to_state.find(sh) == _index_to_state.end()) {
       _index_to_state[sh] = p.first;
     }
-    _initial_belief[sh] = p.second;
+    b0[sh] = p.second;
   }
 
-  _current_belief = _initial_belief;
   _has_last_action = false;
 
-  enumerate_states(_initial_belief);
+  enumerate_states(b0);
   on_states_enumerated();
   pre_cache_model();
   on_model_cached();
+
+  _initial_belief = to_belief_vector(b0);
+  _current_belief = _initial_belief;
+  _alpha_vectors.reset(_states.size());
   initialize_alpha_bound();
   initialize_point_bound();
   compute_depth_bound();
@@ -422,7 +478,7 @@ void SK_HSVI_CLASS::solve(
 }
 
 SK_HSVI_TEMPLATE_DECL
-void SK_HSVI_CLASS::explore(const Belief &b, std::size_t depth,
+void SK_HSVI_CLASS::explore(const BeliefVector &b, std::size_t depth,
                             std::unordered_set<std::size_t> &closed_list) {
   if (elapsed_ms() >= _time_budget)
     return;
@@ -448,29 +504,23 @@ void SK_HSVI_CLASS::explore(const Belief &b, std::size_t depth,
 
   std::size_t na = _actions.size();
 
+  std::vector<std::vector<Successor>> successors = compute_successors(b);
+
   std::vector<double> q_values(na);
   std::vector<std::size_t> action_indices(na);
   std::iota(action_indices.begin(), action_indices.end(), 0);
 
   std::for_each(ExecutionPolicy::policy, action_indices.begin(),
-                action_indices.end(), [this, &b, &q_values](std::size_t ai) {
+                action_indices.end(),
+                [this, &b, &successors, &q_values](std::size_t ai) {
                   double q = 0.0;
-                  for (const auto &p : b) {
-                    auto it = _state_hash_to_idx.find(p.first);
-                    if (it != _state_hash_to_idx.end()) {
-                      q += p.second * _values[it->second][ai];
-                    }
-                  }
+                  b.for_each([this, &ai, &q](std::size_t si, double p) {
+                    q += p * _values[si][ai];
+                  });
 
-                  for (std::size_t oh : _action_obs_hashes[ai]) {
-                    double obs_p = compute_obs_probability(b, ai, oh);
-                    if (obs_p <= _prob_epsilon)
-                      continue;
-                    Belief posterior = compute_posterior(b, ai, oh);
-                    if (posterior.empty())
-                      continue;
-                    double future = evaluate_sawtooth(posterior);
-                    q += _discount * obs_p * future;
+                  for (const auto &succ : successors[ai]) {
+                    double future = evaluate_sawtooth(succ.belief);
+                    q += _discount * succ.obs_probability * future;
                   }
 
                   q_values[ai] = q;
@@ -485,137 +535,191 @@ void SK_HSVI_CLASS::explore(const Belief &b, std::size_t depth,
     }
   }
 
-  std::size_t best_oh = 0;
   double best_score = -std::numeric_limits<double>::infinity();
-  bool found_obs = false;
-  Belief best_posterior;
-
-  for (std::size_t oh : _action_obs_hashes[best_ai]) {
-    double obs_p = compute_obs_probability(b, best_ai, oh);
-    if (obs_p <= _prob_epsilon)
-      continue;
-
-    Belief posterior = compute_posterior(b, best_ai, oh);
-    if (posterior.empty())
-      continue;
+  const BeliefVector *best_posterior = nullptr;
 
-    double post_ub = evaluate_upper(posterior);
-    double post_lb = evaluate_lower(posterior);
+  for (const auto &succ : successors[best_ai]) {
+    double post_ub = evaluate_upper(succ.belief);
+    double post_lb = evaluate_lower(succ.belief);
     double excess = post_ub - post_lb - threshold;
 
     if (excess <= 0)
       continue;
 
-    double score = obs_p * excess;
+    double score = succ.obs_probability * excess;
     if (score > best_score) {
       best_score = score;
-      best_oh = oh;
-      best_posterior = std::move(posterior);
-      found_obs = true;
+      best_posterior = &succ.belief;
     }
   }
 
-  if (found_obs) {
-    explore(best_posterior, depth + 1, closed_list);
+  if (best_posterior != nullptr) {
+    explore(*best_posterior, depth + 1, closed_list);
   }
 
-  alpha_backup(b);
-  point_update(b);
+  // The posteriors do not depend on the bounds updated by the recursive
+  // exploration, so that they are reused by the backups
+  std::vector<double> alpha_values;
+  std::vector<std::size_t> alpha_indices;
+  evaluate_alpha(successors, alpha_values, alpha_indices);
+  alpha_backup(b, successors, alpha_values, alpha_indices);
+  point_update(b, successors, alpha_values);
 }
 
 SK_HSVI_TEMPLATE_DECL
-void SK_HSVI_CLASS::alpha_backup(const Belief &b) {
-  std::size_t ns = _states.size();
+std::vector<std::vector<typename SK_HSVI_CLASS::Successor>>
+SK_HSVI_CLASS::compute_successors(const BeliefVector &b) const {
   std::size_t na = _actions.size();
-
-  struct AlphaCandidate {
-    AlphaVector alpha;
-    double q_val;
-  };
-  std::vector<AlphaCandidate> candidates(na);
-
+  std::vector<std::vector<Successor>> successors(na);
   std::vector<std::size_t> action_indices(na);
   std::iota(action_indices.begin(), action_indices.end(), 0);
 
   std::for_each(ExecutionPolicy::policy, action_indices.begin(),
                 action_indices.end(),
-                [this, ns, &b, &candidates](std::size_t ai) {
-                  AlphaVector g_a(ns, _actions[ai], 0);
-
-                  for (std::size_t si = 0; si < ns; ++si) {
-                    g_a.values[si] = _values[si][ai];
+                [this, &b, &successors](std::size_t ai) {
+                  for (std::size_t oi = 0; oi < _tensors.nb_observations(ai);
+                       ++oi) {
+                    double obs_p = 0.0;
+                    BeliefVector posterior =
+                        compute_posterior(b, ai, oi, &obs_p);
+                    if (!posterior.empty()) {
+                      successors[ai].push_back(
+                          {oi, obs_p, std::move(posterior)});
+                    }
                   }
+                });
 
-                  for (std::size_t oh : _action_obs_hashes[ai]) {
-                    Belief posterior = compute_posterior(b, ai, oh);
-                    if (posterior.empty())
-                      continue;
+  return successors;
+}
 
-                    std::size_t best_idx = best_alpha_index(posterior);
-                    const AlphaVector &alpha_ao = _alpha_vectors[best_idx];
+SK_HSVI_TEMPLATE_DECL
+void SK_HSVI_CLASS::evaluate_alpha(
+    const std::vector<std::vector<Successor>> &successors,
+    std::vector<double> &values, std::vector<std::size_t> &indices) const {
+  std::vector<const BeliefVector *> beliefs;
+  for (const auto &action_successors : successors) {
+    for (const auto &succ : action_successors) {
+      beliefs.push_back(&succ.belief);
+    }
+  }
 
-                    for (std::size_t si = 0; si < ns; ++si) {
-                      double contrib = 0.0;
-                      for (const auto &tr : _transitions[si][ai]) {
-                        auto obs_it = _obs_prob[tr.second][ai].find(oh);
-                        double z = (obs_it != _obs_prob[tr.second][ai].end())
-                                       ? obs_it->second
-                                       : 0.0;
-                        contrib += tr.first * z * alpha_ao.values[tr.second];
-                      }
-                      g_a.values[si] += _discount * contrib;
-                    }
-                  }
+  if (_alpha_vectors.empty()) {
+    values.assign(beliefs.size(), 0.0);
+    indices.assign(beliefs.size(), 0);
+    return;
+  }
 
-                  for (std::size_t si = 0; si < ns; ++si) {
-                    if (_is_terminal_cache[si]) {
-                      g_a.values[si] = get_terminal_state_value(si);
-                    }
-                  }
+  _alpha_vectors.template best_dots<ExecutionPolicy>(
+      beliefs, [this](double x, double y) { return _is_better(x, y); },
+      _best_init(), values, indices);
+}
 
-                  double q_val = dot_product(g_a, b);
-                  candidates[ai] = {std::move(g_a), q_val};
-                });
+SK_HSVI_TEMPLATE_DECL
+void SK_HSVI_CLASS::alpha_backup(
+    const BeliefVector &b,
+    const std::vector<std::vector<Successor>> &successors,
+    std::vector<double> &alpha_values,
+    const std::vector<std::size_t> &alpha_indices) {
+  std::size_t ns = _states.size();
+  std::size_t na = _actions.size();
+
+  // Position of the first successor of each action in alpha_indices
+  std::vector<std::size_t> offsets(na, 0);
+  for (std::size_t ai = 1; ai < na; ++ai) {
+    offsets[ai] = offsets[ai - 1] + successors[ai - 1].size();
+  }
+
+  std::vector<std::vector<double>> candidates(na);
+  std::vector<double> candidate_q_values(na);
+
+  std::vector<std::size_t> action_indices(na);
+  std::iota(action_indices.begin(), action_indices.end(), 0);
+
+  std::for_each(
+      ExecutionPolicy::policy, action_indices.begin(), action_indices.end(),
+      [this, ns, &b, &successors, &alpha_indices, &offsets, &candidates,
+       &candidate_q_values](std::size_t ai) {
+        std::vector<double> g_a(ns);
+
+        for (std::size_t si = 0; si < ns; ++si) {
+          g_a[si] = _values[si][ai];
+        }
+
+        for (std::size_t k = 0; k < successors[ai].size(); ++k) {
+          std::size_t oi = successors[ai][k].obs_idx;
+          const double *alpha_ao =
+              _alpha_vectors.row(alpha_indices[offsets[ai] + k]);
+
+          for (std::size_t si = 0; si < ns; ++si) {
+            g_a[si] += _discount * _tensors.back_project(ai, oi, si, alpha_ao);
+          }
+        }
+
+        for (std::size_t si = 0; si < ns; ++si) {
+          if (_is_terminal_cache[si]) {
+            g_a[si] = get_terminal_state_value(si);
+          }
+        }
+
+        candidate_q_values[ai] = b.dot(g_a.data());
+        candidates[ai] = std::move(g_a);
+      });
 
   double best_q = _best_init();
   std::size_t best_ai = 0;
   for (std::size_t ai = 0; ai < na; ++ai) {
-    if (_is_better(candidates[ai].q_val, best_q)) {
-      best_q = candidates[ai].q_val;
+    if (_is_better(candidate_q_values[ai], best_q)) {
+      best_q = candidate_q_values[ai];
       best_ai = ai;
     }
   }
 
-  candidates[best_ai].alpha.id = _next_alpha_id++;
-  _alpha_vectors.push_back(std::move(candidates[best_ai].alpha));
+  _alpha_vectors.append(candidates[best_ai].data(), best_ai);
+
+  // The new alpha-vector is the last row of the matrix, so that it only
+  // replaces the previous best ones if it is strictly better
+  const double *new_alpha = _alpha_vectors.row(_alpha_vectors.nb_rows() - 1);
+  bool first_alpha = (_alpha_vectors.size() == 1);
+  std::size_t k = 0;
+  for (const auto &action_successors : successors) {
+    for (const auto &succ : action_successors) {
+      double v = succ.belief.dot(new_alpha);
+      if (first_alpha || _is_better(v, alpha_values[k])) {
+        alpha_values[k] = v;
+      }
+      ++k;
+    }
+  }
 }
 
 SK_HSVI_TEMPLATE_DECL
-void SK_HSVI_CLASS::point_update(const Belief &b) {
+void SK_HSVI_CLASS::point_update(
+    const BeliefVector &b,
+    const std::vector<std::vector<Successor>> &successors,
+    const std::vector<double> &alpha_values) {
   std::size_t na = _actions.size();
 
+  std::vector<std::size_t> offsets(na, 0);
+  for (std::size_t ai = 1; ai < na; ++ai) {
+    offsets[ai] = offsets[ai - 1] + successors[ai - 1].size();
+  }
+
   std::vector<double> q_values(na);
   std::vector<std::size_t> action_indices(na);
   std::iota(action_indices.begin(), action_indices.end(), 0);
 
   std::for_each(ExecutionPolicy::policy, action_indices.begin(),
-                action_indices.end(), [this, &b, &q_values](std::size_t ai) {
+                action_indices.end(),
+                [this, &b, &successors, &alpha_values, &offsets,
+                 &q_values](std::size_t ai) {
                   double q = 0.0;
-                  for (const auto &p : b) {
-                    auto it = _state_hash_to_idx.find(p.first);
-                    if (it != _state_hash_to_idx.end()) {
-                      q += p.second * _values[it->second][ai];
-                    }
-                  }
+                  b.for_each([this, &ai, &q](std::size_t si, double p) {
+                    q += p * _values[si][ai];
+                  });
 
-                  for (std::size_t oh : _action_obs_hashes[ai]) {
-                    double obs_p = compute_obs_probability(b, ai, oh);
-                    if (obs_p <= _prob_epsilon)
-                      continue;
-                    Belief posterior = compute_posterior(b, ai, oh);
-                    if (posterior.empty())
-                      continue;
-                    q += _discount * obs_p * evaluate_alpha(posterior);
+                  for (std::size_t k = 0; k < successors[ai].size(); ++k) {
+                    q += _discount * successors[ai][k].obs_probability *
+                         alpha_values[offsets[ai] + k];
                   }
 
                   q_values[ai] = q;
@@ -636,50 +740,40 @@ void SK_HSVI_CLASS::point_update(const Belief &b) {
 }
 
 SK_HSVI_TEMPLATE_DECL
-double SK_HSVI_CLASS::evaluate_alpha(const Belief &b) const {
+double SK_HSVI_CLASS::evaluate_alpha(const BeliefVector &b) const {
   if (_alpha_vectors.empty())
     return 0.0;
 
   double best = _best_init();
-  for (const auto &alpha : _alpha_vectors) {
-    double val = dot_product(alpha, b);
-    best = _better(best, val);
-  }
+  _alpha_vectors.best_dot(
+      b, [this](double x, double y) { return _is_better(x, y); },
+      _best_init(), best);
   return best;
 }
 
 SK_HSVI_TEMPLATE_DECL
-double SK_HSVI_CLASS::evaluate_sawtooth_corner(const Belief &b) const {
-  double v = 0.0;
-  for (const auto &p : b) {
-    auto it = _state_hash_to_idx.find(p.first);
-    if (it != _state_hash_to_idx.end()) {
-      v += p.second * _mdp_values[it->second];
-    }
-  }
-  return v;
+double SK_HSVI_CLASS::evaluate_sawtooth_corner(const BeliefVector &b) const {
+  return b.dot(_mdp_values.data());
 }
 
 SK_HSVI_TEMPLATE_DECL
-double SK_HSVI_CLASS::evaluate_sawtooth(const Belief &b) const {
+double SK_HSVI_CLASS::evaluate_sawtooth(const BeliefVector &b) const {
   double v_corner = evaluate_sawtooth_corner(b);
 
   for (const auto &pt : _bound_points) {
     double c = std::numeric_limits<double>::infinity();
     bool valid = true;
 
-    for (const auto &p : pt.belief) {
-      if (p.second <= 0.0)
-        continue;
-      auto it = b.find(p.first);
-      double b_s = (it != b.end()) ? it->second : 0.0;
-      double ratio = b_s / p.second;
+    pt.belief.for_each([&b, &c, &valid](std::size_t si, double pt_s) {
+      if (!valid)
+        return;
+      double ratio = b[si] / pt_s;
       if (ratio <= 0.0) {
         valid = false;
-        break;
+        return;
       }
       c = std::min(c, ratio);
-    }
+    });
 
     if (!valid || c <= 0.0 || std::isinf(c))
       continue;
@@ -691,17 +785,13 @@ double SK_HSVI_CLASS::evaluate_sawtooth(const Belief &b) const {
     }
 
     double v_res = 0.0;
-    for (const auto &p : b) {
-      auto pt_it = pt.belief.find(p.first);
-      double pt_s = (pt_it != pt.belief.end()) ? pt_it->second : 0.0;
-      double res = (p.second - c * pt_s) / one_minus_c;
+    b.for_each([this, &pt, &c, &one_minus_c, &v_res](std::size_t si,
+                                                      double b_s) {
+      double res = (b_s - c * pt.belief[si]) / one_minus_c;
       if (res > 0.0) {
-        auto idx_it = _state_hash_to_idx.find(p.first);
-        if (idx_it != _state_hash_to_idx.end()) {
-          v_res += res * _mdp_values[idx_it->second];
-        }
+        v_res += res * _mdp_values[si];
       }
-    }
+    });
 
     double candidate = c * pt.value + one_minus_c * v_res;
     v_corner = _better(v_corner, candidate);
@@ -711,108 +801,50 @@ double SK_HSVI_CLASS::evaluate_sawtooth(const Belief &b) const {
 }
 
 SK_HSVI_TEMPLATE_DECL
-double SK_HSVI_CLASS::dot_product(const AlphaVector &alpha,
-                                  const Belief &b) const {
-  double result = 0.0;
-  for (const auto &p : b) {
-    auto it = _state_hash_to_idx.find(p.first);
-    if (it != _state_hash_to_idx.end()) {
-      result += alpha.values[it->second] * p.second;
-    }
-  }
-  return result;
-}
-
-SK_HSVI_TEMPLATE_DECL
-std::size_t SK_HSVI_CLASS::best_alpha_index(const Belief &b) const {
-  std::size_t best_idx = 0;
+std::size_t SK_HSVI_CLASS::best_alpha_index(const BeliefVector &b) const {
   double best_val = _best_init();
-  for (std::size_t i = 0; i < _alpha_vectors.size(); ++i) {
-    double val = dot_product(_alpha_vectors[i], b);
-    if (_is_better(val, best_val)) {
-      best_val = val;
-      best_idx = i;
-    }
-  }
-  return best_idx;
+  return _alpha_vectors.best_dot(
+      b, [this](double x, double y) { return _is_better(x, y); },
+      _best_init(), best_val);
 }
 
 SK_HSVI_TEMPLATE_DECL
-typename SK_HSVI_CLASS::Belief
-SK_HSVI_CLASS::compute_posterior(const Belief &b, std::size_t action_idx,
-                                 std::size_t obs_hash) const {
-  std::unordered_map<std::size_t, double> b_predicted;
-  for (const auto &p : b) {
-    auto it = _state_hash_to_idx.find(p.first);
-    if (it == _state_hash_to_idx.end())
-      continue;
-    std::size_t si = it->second;
-    for (const auto &tr : _transitions[si][action_idx]) {
-      std::size_t ns_hash = _state_idx_to_hash[tr.second];
-      b_predicted[ns_hash] += p.second * tr.first;
-    }
-  }
-
-  Belief posterior;
+BeliefVector SK_HSVI_CLASS::compute_posterior(const BeliefVector &b,
+                                              std::size_t action_idx,
+                                              std::size_t obs_idx,
+                                              double *obs_probability) const {
   double normalizer = 0.0;
+  BeliefVector posterior =
+      _tensors.posterior(b, action_idx, obs_idx, _prob_epsilon, normalizer);
 
-  for (const auto &p : b_predicted) {
-    auto idx_it = _state_hash_to_idx.find(p.first);
-    if (idx_it == _state_hash_to_idx.end())
-      continue;
-    std::size_t ns_idx = idx_it->second;
-
-    auto obs_it = _obs_prob[ns_idx][action_idx].find(obs_hash);
-    double z =
-        (obs_it != _obs_prob[ns_idx][action_idx].end()) ? obs_it->second : 0.0;
-
-    double val = z * p.second;
-    if (val > 0.0) {
-      posterior[p.first] = val;
-      normalizer += val;
-    }
+  if (obs_probability != nullptr) {
+    *obs_probability = normalizer;
   }
-
-  if (normalizer > _prob_epsilon) {
-    for (auto &p : posterior) {
-      p.second /= normalizer;
-    }
-  } else {
-    posterior.clear();
-  }
-
   return posterior;
 }
 
 SK_HSVI_TEMPLATE_DECL
-double SK_HSVI_CLASS::compute_obs_probability(const Belief &b,
-                                              std::size_t action_idx,
-                                              std::size_t obs_hash) const {
-  double prob = 0.0;
-  for (const auto &p : b) {
-    auto idx_it = _state_hash_to_idx.find(p.first);
-    if (idx_it == _state_hash_to_idx.end())
-      continue;
-    std::size_t si = idx_it->second;
-    for (const auto &tr : _transitions[si][action_idx]) {
-      auto obs_it = _obs_prob[tr.second][action_idx].find(obs_hash);
-      if (obs_it != _obs_prob[tr.second][action_idx].end()) {
-        prob += p.second * tr.first * obs_it->second;
-      }
-    }
-  }
-  return prob;
+std::size_t SK_HSVI_CLASS::belief_hash(const BeliefVector &b) const {
+  std::size_t seed = 0;
+  b.for_each([this, &seed](std::size_t si, double p) {
+    std::size_t disc =
+        static_cast<std::size_t>(std::ceil(p * _belief_hash_resolution));
+    seed ^= _state_idx_to_hash[si] * 2654435761UL + disc;
+  });
+  return seed;
 }
 
 SK_HSVI_TEMPLATE_DECL
-std::size_t SK_HSVI_CLASS::belief_hash(const Belief &b) const {
-  std::size_t seed = 0;
+BeliefVector SK_HSVI_CLASS::to_belief_vector(const Belief &b) const {
+  std::vector<std::pair<std::size_t, double>> entries;
+  entries.reserve(b.size());
   for (const auto &p : b) {
-    std::size_t disc =
-        static_cast<std::size_t>(std::ceil(p.second * _belief_hash_resolution));
-    seed ^= p.first * 2654435761UL + disc;
+    auto it = _state_hash_to_idx.find(p.first);
+    if (it != _state_hash_to_idx.end() && it->second < _transitions.size()) {
+      entries.emplace_back(it->second, p.second);
+    }
   }
-  return seed;
+  return BeliefVector(_transitions.size(), std::move(entries));
 }
 
 SK_HSVI_TEMPLATE_DECL
@@ -826,9 +858,14 @@ void SK_HSVI_CLASS::update_current_belief(const Observation &obs) {
     return;
   std::size_t ai = ai_it->second;
 
-  std::size_t oh = typename Observation::Hash()(obs);
+  std::size_t oi = _tensors.observation_index(ai, observation_id(obs));
+  if (oi == _tensors.nb_observations(ai)) {
+    Logger::warn("HSVI: observation " + obs.print() +
+                 " is not in the model, the belief is not updated");
+    return;
+  }
 
-  Belief posterior = compute_posterior(_current_belief, ai, oh);
+  BeliefVector posterior = compute_posterior(_current_belief, ai, oi);
   if (!posterior.empty()) {
     _current_belief = std::move(posterior);
   }
@@ -865,14 +902,14 @@ void SK_HSVI_CLASS::reset_belief() {
 SK_HSVI_TEMPLATE_DECL
 const typename SK_HSVI_CLASS::Action &
 SK_HSVI_CLASS::get_best_action_from_belief(const Belief &b) const {
-  std::size_t idx = best_alpha_index(b);
-  return _alpha_vectors[idx].action;
+  std::size_t idx = best_alpha_index(to_belief_vector(b));
+  return _actions[_alpha_vectors.action(idx)];
 }
 
 SK_HSVI_TEMPLATE_DECL
 typename SK_HSVI_CLASS::Value
 SK_HSVI_CLASS::get_best_value_from_belief(const Belief &b) const {
-  double v = evaluate_alpha(b);
+  double v = evaluate_alpha(to_belief_vector(b));
   Value val;
   make_value_obj(v, val);
   return val;
@@ -940,11 +977,12 @@ SK_GOAL_HSVI_CLASS::GoalHSVISolver(
     bool use_closed_list, double depth_bound_eta, std::size_t max_vi_iterations,
     double vi_convergence_factor, double prob_epsilon,
     double belief_hash_resolution, const CallbackFunctor &callback,
-    bool verbose, std::optional<double> dead_end_cost)
+    bool verbose, std::optional<double> dead_end_cost,
+    const std::string &model_cache_path)
     : Base(domain, epsilon, discount, time_budget, max_sample_depth,
            use_closed_list, depth_bound_eta, max_vi_iterations,
            vi_convergence_factor, prob_epsilon, belief_hash_resolution,
-           callback, verbose),
+           callback, verbose, model_cache_path),
       _goal_checker(goal_checker), _user_dead_end_cost(dead_end_cost) {}
 
 SK_GOAL_HSVI_TEMPLATE_DECL
@@ -1044,10 +1082,7 @@ void SK_GOAL_HSVI_CLASS::initialize_alpha_bound() {
       break;
   }
 
-  typename Base::AlphaVector alpha(ns, this->_actions[0],
-                                   this->_next_alpha_id++);
-  alpha.values = unif_values;
-  this->_alpha_vectors.push_back(std::move(alpha));
+  this->_alpha_vectors.append(unif_values.data(), 0);
 
   // Blind policy alpha-vectors (shared)
   this->create_blind_policy_alphas();
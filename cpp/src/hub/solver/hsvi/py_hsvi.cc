@@ -15,7 +15,7 @@ void init_pyhsvi(py::module &m) {
                     std::size_t, bool, double, std::size_t, double, double,
                     double, bool,
                     const std::function<py::bool_(const py::object &)> &,
-                    bool>(),
+                    bool, const std::string &>(),
            py::arg("solver"), py::arg("domain"), py::arg("epsilon") = 0.001,
            py::arg("discount") = 0.95, py::arg("time_budget") = 300000,
            py::arg("max_sample_depth") = 100,
@@ -25,7 +25,7 @@ void init_pyhsvi(py::module &m) {
            py::arg("prob_epsilon") = 1e-15,
            py::arg("belief_hash_resolution") = 1000.0,
            py::arg("parallel") = false, py::arg("callback") = nullptr,
-           py::arg("verbose") = false)
+           py::arg("verbose") = false, py::arg("model_cache_path") = "")
       .def("close", &skdecide::PyHSVISolver::close)
       .def("clear", &skdecide::PyHSVISolver::clear)
       .def("solve", &skdecide::PyHSVISolver::solve, py::arg("distribution"))
@@ -60,7 +60,7 @@ void init_pyhsvi(py::module &m) {
                     double, double, std::size_t, std::size_t, bool, double,
                     std::size_t, double, double, double, bool,
                     const std::function<py::bool_(const py::object &)> &, bool,
-                    std::optional<double>>(),
+                    std::optional<double>, const std::string &>(),
            py::arg("solver"), py::arg("domain"), py::arg("goal_checker"),
            py::arg("epsilon") = 0.001, py::arg("discount") = 1.0,
            py::arg("time_budget") = 300000, py::arg("max_sample_depth") = 100,
@@ -70,7 +70,8 @@ void init_pyhsvi(py::module &m) {
            py::arg("prob_epsilon") = 1e-15,
            py::arg("belief_hash_resolution") = 1000.0,
            py::arg("parallel") = false, py::arg("callback") = nullptr,
-           py::arg("verbose") = false, py::arg("dead_end_cost") = py::none())
+           py::arg("verbose") = false, py::arg("dead_end_cost") = py::none(),
+           py::arg("model_cache_path") = "")
       .def("close", &skdecide::PyGoalHSVISolver::close)
       .def("clear", &skdecide::PyGoalHSVISolver::clear)
       .def("solve", &skdecide::PyGoalHSVISolver::solve, py::arg("distribution"))
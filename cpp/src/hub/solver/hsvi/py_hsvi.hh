@@ -73,7 +73,8 @@ protected:
         double vi_convergence_factor, double prob_epsilon,
         double belief_hash_resolution,
         const std::function<py::bool_(const py::object &)> &callback,
-        bool verbose, std::optional<double> dead_end_cost = std::nullopt)
+        bool verbose, std::optional<double> dead_end_cost,
+        const std::string &model_cache_path)
         : _callback(callback) {
 
       _pysolver = std::make_unique<py::object>(solver);
@@ -120,7 +121,7 @@ protected:
               }
               return false;
             },
-            verbose, dead_end_cost);
+            verbose, dead_end_cost, model_cache_path);
       } else {
         _solver = std::make_unique<SolverType>(
             *_domain, epsilon, discount, time_budget, max_sample_depth,
@@ -144,7 +145,7 @@ protected:
               }
               return false;
             },
-            verbose);
+            verbose, model_cache_path);
       }
 
       _stdout_redirect = std::make_unique<py::scoped_ostream_redirect>(
@@ -352,7 +353,7 @@ public:
       double vi_convergence_factor = 0.01, double prob_epsilon = 1e-15,
       double belief_hash_resolution = 1000.0, bool parallel = false,
       const std::function<py::bool_(const py::object &)> &callback = nullptr,
-      bool verbose = false) {
+      bool verbose = false, const std::string &model_cache_path = "") {
     TemplateInstantiator::select(ExecutionSelector(parallel),
                                  SolverInstantiator(_implementation))
         .instantiate(solver, domain,
@@ -361,7 +362,8 @@ public:
                      epsilon, discount, time_budget, max_sample_depth,
                      use_closed_list, depth_bound_eta, max_vi_iterations,
                      vi_convergence_factor, prob_epsilon,
-                     belief_hash_resolution, callback, verbose);
+                     belief_hash_resolution, callback, verbose, std::nullopt,
+                     model_cache_path);
   }
 };
 
@@ -392,14 +394,15 @@ public:
       bool parallel = false,
       const std::function<py::bool_(const py::object &)> &callback = nullptr,
       bool verbose = false,
-      std::optional<double> dead_end_cost = std::nullopt) {
+      std::optional<double> dead_end_cost = std::nullopt,
+      const std::string &model_cache_path = "") {
     TemplateInstantiator::select(ExecutionSelector(parallel),
                                  SolverInstantiator(_implementation))
         .instantiate(solver, domain, &goal_checker, epsilon, discount,
                      time_budget, max_sample_depth, use_closed_list,
                      depth_bound_eta, max_vi_iterations, vi_convergence_factor,
                      prob_epsilon, belief_hash_resolution, callback, verbose,
-                     dead_end_cost);
+                     dead_end_cost, model_cache_path);
   }
 };
 
@@ -18,6 +18,7 @@
 
 #include "Highs.h"
 #include "utils/associative_container_deducer.hh"
+#include "utils/compressed_lp_matrix.hh"
 #include "utils/execution.hh"
 #include "utils/logging.hh"
 #include "utils/string_converter.hh"
@@ -168,6 +169,10 @@ private:
     bool terminal;
     std::size_t index;
     std::vector<std::pair<ActionNode *, double>> action_probabilities;
+    bool heuristic_evaluated;
+    double heuristic_cost;
+    std::vector<double> secondary_heuristic_costs;
+    bool lp_fringe; // unexpanded non-terminal successor of some LP column
 
     struct Key {
       const State &operator()(const StateNode &sn) const { return sn.state; }
@@ -220,6 +225,12 @@ private:
   std::vector<double> _lp_col_c9;
   std::vector<std::vector<double>> _lp_col_c11;
 
+  // Columns added since the last call to HiGHS, and fringe states of the LP
+  // (lazily compacted when they get expanded)
+  CompressedLPMatrix<HighsInt> _lp_new_cols;
+  std::vector<double> _lp_new_col_costs;
+  std::vector<StateNode *> _lp_fringe;
+
   bool _lp_initialized = false;
 
   void expand_states(std::vector<StateNode *> &fr);
@@ -228,10 +239,14 @@ private:
                  const std::vector<StateNode *> &newly_expanded);
   void extract_solution();
 
-  double compute_sa_obj_cost(ActionNode *an) const;
+  void evaluate_heuristics(StateNode *sn);
+  double sink_cost(StateNode *sn);
+  double sink_secondary_cost(StateNode *sn, std::size_t j);
+  double compute_sa_obj_cost(ActionNode *an);
   double compute_sa_c9_coeff(ActionNode *an) const;
   void add_sa_column(StateNode *sn, ActionNode *an, const State &s0);
   void add_xd_column(StateNode *sn);
+  void flush_lp_columns();
 };
 
 } // namespace skdecide
@@ -8,8 +8,6 @@
 #include <algorithm>
 #include <cmath>
 #include <limits>
-#include <map>
-#include <set>
 #include <vector>
 
 #include "Highs.h"
@@ -26,7 +24,8 @@ namespace skdecide {
 SK_IDUAL_TEMPLATE_DECL
 SK_IDUAL_CLASS::StateNode::StateNode(const State &s)
     : state(s), best_action(nullptr), best_value(0.0), expanded(false),
-      goal(false), terminal(false), index(0) {}
+      goal(false), terminal(false), index(0), heuristic_evaluated(false),
+      heuristic_cost(0.0), lp_fringe(false) {}
 
 SK_IDUAL_TEMPLATE_DECL
 SK_IDUAL_CLASS::ActionNode::ActionNode(const Action &a)
@@ -81,6 +80,9 @@ void SK_IDUAL_CLASS::clear() {
   _lp_col_obj.clear();
   _lp_col_c9.clear();
   _lp_col_c11.clear();
+  _lp_new_cols.clear();
+  _lp_new_col_costs.clear();
+  _lp_fringe.clear();
   _lp_initialized = false;
 }
 
@@ -143,10 +145,52 @@ void SK_IDUAL_CLASS::expand_states(std::vector<StateNode *> &fr) {
   }
 }
 
+// --- Helpers: costs of the sink states of the LP ---
+
+// Evaluates the (secondary) heuristics of a state once, when it first
+// becomes a sink of the LP, and caches them for the later updates of the
+// columns leading to the state
+SK_IDUAL_TEMPLATE_DECL
+void SK_IDUAL_CLASS::evaluate_heuristics(StateNode *sn) {
+  if (sn->heuristic_evaluated)
+    return;
+  sn->heuristic_cost = _heuristic(_domain, sn->state).cost();
+  if constexpr (has_get_constraints<Domain>::value) {
+    sn->secondary_heuristic_costs.resize(_n_constraints, 0.0);
+    if (_secondary_heuristic) {
+      for (std::size_t j = 0; j < _n_constraints; ++j) {
+        sn->secondary_heuristic_costs[j] =
+            _secondary_heuristic(_domain, sn->state, j);
+      }
+    }
+  }
+  sn->heuristic_evaluated = true;
+}
+
+SK_IDUAL_TEMPLATE_DECL
+double SK_IDUAL_CLASS::sink_cost(StateNode *sn) {
+  if (sn->goal)
+    return 0.0;
+  if (sn->terminal)
+    return sn->best_value;
+  evaluate_heuristics(sn);
+  return sn->heuristic_cost;
+}
+
+SK_IDUAL_TEMPLATE_DECL
+double SK_IDUAL_CLASS::sink_secondary_cost(StateNode *sn, std::size_t j) {
+  if (sn->goal)
+    return 0.0;
+  if (sn->terminal)
+    return _dead_end_costs[j];
+  evaluate_heuristics(sn);
+  return sn->secondary_heuristic_costs[j];
+}
+
 // --- Helper: compute objective cost for a column x(s,a) ---
 
 SK_IDUAL_TEMPLATE_DECL
-double SK_IDUAL_CLASS::compute_sa_obj_cost(ActionNode *an) const {
+double SK_IDUAL_CLASS::compute_sa_obj_cost(ActionNode *an) {
   double cost = 0.0;
   for (const auto &outcome : an->outcomes) {
     StateNode *ns = std::get<2>(outcome);
@@ -154,13 +198,7 @@ double SK_IDUAL_CLASS::compute_sa_obj_cost(ActionNode *an) const {
     double tcost = std::get<1>(outcome);
     cost += prob * tcost;
     if (!ns->expanded || ns->goal) {
-      if (!ns->goal) {
-        if (ns->terminal) {
-          cost += prob * ns->best_value;
-        } else {
-          cost += prob * _heuristic(_domain, ns->state).cost();
-        }
-      }
+      cost += prob * sink_cost(ns);
     }
   }
   return cost;
@@ -182,6 +220,7 @@ double SK_IDUAL_CLASS::compute_sa_c9_coeff(ActionNode *an) const {
 }
 
 // --- Helper: add a column for x(s,a) and record tracking data ---
+// The column is buffered in _lp_new_cols until flush_lp_columns()
 
 SK_IDUAL_TEMPLATE_DECL
 void SK_IDUAL_CLASS::add_sa_column(StateNode *sn, ActionNode *an,
@@ -189,10 +228,8 @@ void SK_IDUAL_CLASS::add_sa_column(StateNode *sn, ActionNode *an,
   double cost = compute_sa_obj_cost(an);
   double c9_coeff = compute_sa_c9_coeff(an);
 
-  std::map<HighsInt, double> coeff_map;
-
   // Outflow: +1 in this state's flow row
-  coeff_map[_lp_flow_row.at(sn)] += 1.0;
+  _lp_new_cols.add(_lp_flow_row.at(sn), 1.0);
 
   // Inflow: -prob in each expanded successor's flow row
   for (const auto &outcome : an->outcomes) {
@@ -201,15 +238,13 @@ void SK_IDUAL_CLASS::add_sa_column(StateNode *sn, ActionNode *an,
     if (ns->expanded && !ns->goal) {
       auto it = _lp_flow_row.find(ns);
       if (it != _lp_flow_row.end()) {
-        coeff_map[it->second] -= prob;
+        _lp_new_cols.add(it->second, -prob);
       }
     }
   }
 
   // C9
-  if (std::abs(c9_coeff) > _lp_tolerance) {
-    coeff_map[_lp_c9_row] += c9_coeff;
-  }
+  _lp_new_cols.add(_lp_c9_row, c9_coeff);
 
   // C11
   if constexpr (has_get_constraints<Domain>::value) {
@@ -219,45 +254,32 @@ void SK_IDUAL_CLASS::add_sa_column(StateNode *sn, ActionNode *an,
         StateNode *ns = std::get<2>(outcome);
         double prob = std::get<0>(outcome);
         if (!ns->expanded || ns->goal) {
-          if (!ns->goal) {
-            if (ns->terminal) {
-              cj += prob * _dead_end_costs[j];
-            } else if (_secondary_heuristic) {
-              cj += prob * _secondary_heuristic(_domain, ns->state, j);
-            }
-          }
+          cj += prob * sink_secondary_cost(ns, j);
         }
       }
       _lp_col_c11[j].push_back(cj);
-      if (std::abs(cj) > _lp_tolerance) {
-        coeff_map[_lp_c11_rows[j]] += cj;
-      }
+      _lp_new_cols.add(_lp_c11_rows[j], cj);
     }
   }
 
-  std::vector<HighsInt> indices;
-  std::vector<double> values;
-  for (const auto &[row, val] : coeff_map) {
-    if (std::abs(val) > _lp_tolerance) {
-      indices.push_back(row);
-      values.push_back(val);
-    }
-  }
+  _lp_new_cols.close(_lp_tolerance);
+  _lp_new_col_costs.push_back(cost);
 
   HighsInt new_col = static_cast<HighsInt>(_lp_col_info.size());
-  _highs->addCol(cost, 0.0, _lp_infinity, static_cast<HighsInt>(indices.size()),
-                 indices.data(), values.data());
-
   _lp_col_info.push_back({sn, an});
   _lp_state_sa_cols[sn].push_back(new_col);
   _lp_col_obj.push_back(cost);
   _lp_col_c9.push_back(c9_coeff);
 
-  // Update successor index
+  // Update successor index and fringe states
   for (const auto &outcome : an->outcomes) {
     StateNode *ns = std::get<2>(outcome);
     double prob = std::get<0>(outcome);
     _lp_succ_to_cols[ns].push_back({new_col, prob});
+    if (!ns->expanded && !ns->terminal && !ns->lp_fringe) {
+      ns->lp_fringe = true;
+      _lp_fringe.push_back(ns);
+    }
   }
 }
 
@@ -267,29 +289,23 @@ SK_IDUAL_TEMPLATE_DECL
 void SK_IDUAL_CLASS::add_xd_column(StateNode *sn) {
   double tv = _terminal_value(sn->state).cost();
 
-  std::vector<HighsInt> indices;
-  std::vector<double> values;
-
   // Outflow: +1 in flow row
-  indices.push_back(_lp_flow_row.at(sn));
-  values.push_back(1.0);
+  _lp_new_cols.add(_lp_flow_row.at(sn), 1.0);
 
   // C9: +1
-  indices.push_back(_lp_c9_row);
-  values.push_back(1.0);
+  _lp_new_cols.add(_lp_c9_row, 1.0);
 
   // C11: dead_end_costs[j]
   if constexpr (has_get_constraints<Domain>::value) {
     for (std::size_t j = 0; j < _n_constraints; ++j) {
-      indices.push_back(_lp_c11_rows[j]);
-      values.push_back(_dead_end_costs[j]);
+      _lp_new_cols.add(_lp_c11_rows[j], _dead_end_costs[j]);
     }
   }
 
-  HighsInt new_col = static_cast<HighsInt>(_lp_col_info.size());
-  _highs->addCol(tv, 0.0, _lp_infinity, static_cast<HighsInt>(indices.size()),
-                 indices.data(), values.data());
+  _lp_new_cols.close(_lp_tolerance);
+  _lp_new_col_costs.push_back(tv);
 
+  HighsInt new_col = static_cast<HighsInt>(_lp_col_info.size());
   _lp_col_info.push_back({sn, nullptr});
   _lp_state_xd_col[sn] = new_col;
   _lp_col_obj.push_back(tv);
@@ -302,6 +318,23 @@ void SK_IDUAL_CLASS::add_xd_column(StateNode *sn) {
   }
 }
 
+// --- Helper: pass the buffered columns to HiGHS in a single call ---
+
+SK_IDUAL_TEMPLATE_DECL
+void SK_IDUAL_CLASS::flush_lp_columns() {
+  HighsInt nb_new_cols = _lp_new_cols.nb_major();
+  if (nb_new_cols > 0) {
+    std::vector<double> lower(nb_new_cols, 0.0),
+        upper(nb_new_cols, _lp_infinity);
+    _highs->addCols(nb_new_cols, _lp_new_col_costs.data(), lower.data(),
+                    upper.data(), _lp_new_cols.nb_entries(),
+                    _lp_new_cols.start(), _lp_new_cols.index(),
+                    _lp_new_cols.value());
+  }
+  _lp_new_cols.clear();
+  _lp_new_col_costs.clear();
+}
+
 // --- init_lp: build full LP on first iteration ---
 
 SK_IDUAL_TEMPLATE_DECL
@@ -319,6 +352,12 @@ void SK_IDUAL_CLASS::init_lp(const State &s0) {
   _lp_col_obj.clear();
   _lp_col_c9.clear();
   _lp_col_c11.clear();
+  _lp_new_cols.clear();
+  _lp_new_col_costs.clear();
+  for (auto *sn : _lp_fringe) {
+    sn->lp_fringe = false;
+  }
+  _lp_fringe.clear();
 
   if constexpr (has_get_constraints<Domain>::value) {
     _lp_col_c11.resize(_n_constraints);
@@ -333,35 +372,22 @@ void SK_IDUAL_CLASS::init_lp(const State &s0) {
     }
   }
 
-  // Phase 1: Add flow conservation rows (empty initially, columns will
-  // reference them)
-  for (auto *sn : expanded_states) {
-    double alpha = (typename State::Equal()(sn->state, s0)) ? 1.0 : 0.0;
-    HighsInt row = static_cast<HighsInt>(_lp_flow_row.size());
-    _highs->addRow(alpha, alpha, 0, nullptr, nullptr);
-    _lp_flow_row[sn] = row;
-  }
-
-  // Phase 2: Add C9 row (empty, columns will populate it)
-  _lp_c9_row = static_cast<HighsInt>(_lp_flow_row.size());
+  // Add C9 row (empty, columns will populate it)
+  _lp_c9_row = 0;
   _highs->addRow(1.0, 1.0, 0, nullptr, nullptr);
 
-  // Phase 3: Add C11 rows (empty)
+  // Add C11 rows (empty)
   if constexpr (has_get_constraints<Domain>::value) {
     for (std::size_t j = 0; j < _n_constraints; ++j) {
-      HighsInt c11_row = static_cast<HighsInt>(_lp_flow_row.size() + 1 + j);
+      HighsInt c11_row = static_cast<HighsInt>(1 + j);
       _highs->addRow(-_lp_infinity, _cost_bounds[j], 0, nullptr, nullptr);
       _lp_c11_rows.push_back(c11_row);
     }
   }
 
-  // Phase 4: Add columns (x(s,a) and x_D(s)) — these reference the rows above
-  for (auto *sn : expanded_states) {
-    for (auto &an_ptr : sn->actions) {
-      add_sa_column(sn, an_ptr.get(), s0);
-    }
-    add_xd_column(sn);
-  }
+  // The LP has no column yet: adding the flow conservation rows and the
+  // columns of all the expanded states is an update of the empty LP
+  update_lp(s0, expanded_states);
 
   if (_verbose) {
     Logger::debug(
@@ -372,96 +398,88 @@ void SK_IDUAL_CLASS::init_lp(const State &s0) {
 }
 
 // --- update_lp: incremental LP update ---
+// Only the columns leading to the newly expanded states are modified, and
+// the new rows and columns are appended in two bulk calls, so the cost of an
+// update is proportional to the newly expanded fringe. HiGHS keeps the
+// basis of the previous LP (new rows basic, new columns nonbasic) and
+// hot-starts from it.
 
 SK_IDUAL_TEMPLATE_DECL
 void SK_IDUAL_CLASS::update_lp(const State &s0,
                                const std::vector<StateNode *> &newly_expanded) {
 
-  // Phase 1: Update existing columns' objective coefficients
+  // Phase 1: Update the objective, C9 and C11 coefficients of the existing
+  // columns leading to the newly expanded states, which are no longer sinks
+  std::vector<HighsInt> changed_cols;
   for (auto *T : newly_expanded) {
-    double h_T;
-    if (T->goal) {
-      h_T = 0.0;
-    } else if (T->terminal) {
-      h_T = T->best_value;
-    } else {
-      h_T = _heuristic(_domain, T->state).cost();
-    }
-
     auto it = _lp_succ_to_cols.find(T);
-    if (it != _lp_succ_to_cols.end()) {
-      for (const auto &entry : it->second) {
-        _lp_col_obj[entry.col] -= entry.prob * h_T;
-        _highs->changeColCost(entry.col, _lp_col_obj[entry.col]);
-      }
-    }
-  }
+    if (it == _lp_succ_to_cols.end())
+      continue;
 
-  // Phase 2: Update existing columns' C9 coefficients
-  for (auto *T : newly_expanded) {
-    auto it = _lp_succ_to_cols.find(T);
-    if (it != _lp_succ_to_cols.end()) {
-      for (const auto &entry : it->second) {
-        _lp_col_c9[entry.col] -= entry.prob;
-        _highs->changeCoeff(_lp_c9_row, entry.col, _lp_col_c9[entry.col]);
+    double h_T = sink_cost(T);
+    for (const auto &entry : it->second) {
+      _lp_col_obj[entry.col] -= entry.prob * h_T;
+      changed_cols.push_back(entry.col);
+
+      _lp_col_c9[entry.col] -= entry.prob;
+      _highs->changeCoeff(_lp_c9_row, entry.col, _lp_col_c9[entry.col]);
+
+      if constexpr (has_get_constraints<Domain>::value) {
+        for (std::size_t j = 0; j < _n_constraints; ++j) {
+          _lp_col_c11[j][entry.col] -= entry.prob * sink_secondary_cost(T, j);
+          _highs->changeCoeff(_lp_c11_rows[j], entry.col,
+                              _lp_col_c11[j][entry.col]);
+        }
       }
     }
   }
 
-  // Phase 3: Update existing columns' C11 coefficients
-  if constexpr (has_get_constraints<Domain>::value) {
-    for (auto *T : newly_expanded) {
-      auto it = _lp_succ_to_cols.find(T);
-      if (it != _lp_succ_to_cols.end()) {
-        for (const auto &entry : it->second) {
-          for (std::size_t j = 0; j < _n_constraints; ++j) {
-            double sec_h;
-            if (T->goal) {
-              sec_h = 0.0;
-            } else if (T->terminal) {
-              sec_h = _dead_end_costs[j];
-            } else if (_secondary_heuristic) {
-              sec_h = _secondary_heuristic(_domain, T->state, j);
-            } else {
-              sec_h = 0.0;
-            }
-            _lp_col_c11[j][entry.col] -= entry.prob * sec_h;
-            _highs->changeCoeff(_lp_c11_rows[j], entry.col,
-                                _lp_col_c11[j][entry.col]);
-          }
-        }
-      }
+  std::sort(changed_cols.begin(), changed_cols.end());
+  changed_cols.erase(std::unique(changed_cols.begin(), changed_cols.end()),
+                     changed_cols.end());
+  if (!changed_cols.empty()) {
+    std::vector<double> costs;
+    costs.reserve(changed_cols.size());
+    for (HighsInt col : changed_cols) {
+      costs.push_back(_lp_col_obj[col]);
     }
+    _highs->changeColsCost(static_cast<HighsInt>(changed_cols.size()),
+                           changed_cols.data(), costs.data());
   }
 
-  // Phase 4: Add flow conservation rows for newly expanded states
+  // Phase 2: Add flow conservation rows for newly expanded states, with the
+  // inflow from the existing columns that transition to them
+  CompressedLPMatrix<HighsInt> new_rows;
+  std::vector<double> alphas;
+  HighsInt next_row = _highs->getNumRow();
   for (auto *T : newly_expanded) {
-    std::vector<HighsInt> indices;
-    std::vector<double> values;
-
-    // Inflow from existing columns that transition to T
     auto it = _lp_succ_to_cols.find(T);
     if (it != _lp_succ_to_cols.end()) {
       for (const auto &entry : it->second) {
-        indices.push_back(entry.col);
-        values.push_back(-entry.prob);
+        new_rows.add(entry.col, -entry.prob);
       }
     }
+    new_rows.close();
 
-    double alpha = (typename State::Equal()(T->state, s0)) ? 1.0 : 0.0;
-    HighsInt new_row = _highs->getNumRow();
-    _highs->addRow(alpha, alpha, static_cast<HighsInt>(indices.size()),
-                   indices.data(), values.data());
-    _lp_flow_row[T] = new_row;
+    alphas.push_back((typename State::Equal()(T->state, s0)) ? 1.0 : 0.0);
+    _lp_flow_row[T] = next_row++;
+    T->lp_fringe = false;
   }
 
-  // Phase 5: Add new columns for newly expanded states
+  if (!alphas.empty()) {
+    _highs->addRows(static_cast<HighsInt>(alphas.size()), alphas.data(),
+                    alphas.data(), new_rows.nb_entries(), new_rows.start(),
+                    new_rows.index(), new_rows.value());
+  }
+
+  // Phase 3: Add new columns for newly expanded states
   for (auto *T : newly_expanded) {
     for (auto &an_ptr : T->actions) {
       add_sa_column(T, an_ptr.get(), s0);
     }
     add_xd_column(T);
   }
+  flush_lp_columns();
 
   if (_verbose) {
     Logger::debug(
@@ -512,25 +530,24 @@ void SK_IDUAL_CLASS::extract_solution() {
     }
   }
 
-  // Compute fringe reachable: sink states with positive inflow
+  // Compute fringe reachable: sink states with positive inflow, among the
+  // fringe states of the LP (dropping the ones expanded since)
   _fringe_reachable.clear();
-  for (auto &sn_ref : _graph) {
-    StateNode &sn = const_cast<StateNode &>(sn_ref);
-    if (sn.expanded || sn.goal || sn.terminal)
-      continue;
-
-    auto it = _lp_succ_to_cols.find(&sn);
-    if (it == _lp_succ_to_cols.end())
+  std::size_t nb_fringe = 0;
+  for (auto *sn : _lp_fringe) {
+    if (!sn->lp_fringe)
       continue;
+    _lp_fringe[nb_fringe++] = sn;
 
     double inflow = 0.0;
-    for (const auto &entry : it->second) {
+    for (const auto &entry : _lp_succ_to_cols.at(sn)) {
       inflow += col_values[entry.col] * entry.prob;
     }
     if (inflow > _epsilon) {
-      _fringe_reachable.push_back(&sn);
+      _fringe_reachable.push_back(sn);
     }
   }
+  _lp_fringe.resize(nb_fringe);
 }
 
 SK_IDUAL_TEMPLATE_DECL
@@ -17,8 +17,11 @@
 #include <chrono>
 
 #include "utils/associative_container_deducer.hh"
+#include "utils/concurrent_set.hh"
 #include "utils/string_converter.hh"
 #include "utils/execution.hh"
+#include "utils/node_arena.hh"
+#include "utils/outcome_arrays.hh"
 #include "utils/logging.hh"
 
 namespace skdecide {
@@ -64,6 +67,10 @@ public:
    * after each value iteration sweep (matching the paper's Table 7 step 3).
    * When false (default), run value iteration to full convergence before
    * recomputing the graph.
+   * @param compact_backups When true, value iteration sweeps a snapshot of the
+   * best solution graph stored in contiguous arrays (action costs, outcome
+   * probabilities and successor indices, dense state values) instead of the
+   * graph nodes; only used when per_sweep_graph_update is false
    * @param callback Functor called at the beginning of each policy update
    * depth-first search, taking as arguments the solver and the domain, and
    * returning true if the solver must be stopped
@@ -74,6 +81,7 @@ public:
       Domain &domain, const GoalCheckerFunctor &goal_checker,
       const HeuristicFunctor &heuristic, double discount = 1.0,
       double epsilon = 0.001, bool per_sweep_graph_update = false,
+      bool compact_backups = false,
       const CallbackFunctor &callback = [](const ILAOStarSolver &,
                                            Domain &) { return false; },
       bool verbose = false);
@@ -184,15 +192,17 @@ private:
   atomic_double _discount;
   atomic_double _epsilon;
   bool _per_sweep_graph_update;
+  bool _compact_backups;
   CallbackFunctor _callback;
   bool _verbose;
   ExecutionPolicy _execution_policy;
 
   struct ActionNode;
+  typedef NodeArena<ActionNode, ExecutionPolicy> ActionArena;
 
   struct StateNode {
     State state;
-    std::list<std::unique_ptr<ActionNode>> actions;
+    std::list<typename ActionArena::Pointer> actions;
     ActionNode *best_action;
     atomic_double best_value;
     atomic_double first_passage_time;
@@ -210,16 +220,20 @@ private:
 
   struct ActionNode {
     Action action;
-    std::list<std::tuple<double, double, StateNode *>>
-        outcomes; // next state nodes owned by _graph
+    OutcomeArray<StateNode> outcomes; // next state nodes owned by _graph
     double value;
 
     ActionNode(const Action &a);
   };
 
-  typedef typename SetTypeDeducer<StateNode, State>::Set Graph;
+  typedef typename ConcurrentSetTypeDeducer<
+      StateNode, State, ExecutionPolicy, NodeArenaAllocator<StateNode>>::Set
+      Graph;
+  ActionArena _action_arena; // must outlive the graph
   Graph _graph;
   std::unordered_set<StateNode *> _best_solution_graph;
+  CompactBellmanGraph<ExecutionPolicy> _compact_graph;
+  std::vector<StateNode *> _compact_nodes; // indexed as in _compact_graph
   std::chrono::time_point<std::chrono::high_resolution_clock> _start_time;
 
   void expand(StateNode &s);
@@ -228,6 +242,8 @@ private:
   double update(StateNode &s);
   std::pair<double, bool> value_iteration_sweep();
   bool value_iteration();
+  void compile_best_solution_graph();
+  void copy_compact_values();
   bool update_reachability(StateNode &s);
   void compute_reachability();
   double update_mfpt(StateNode &s);
@@ -6,6 +6,7 @@
 #define SKDECIDE_ILAOSTAR_IMPL_HH
 
 #include <queue>
+#include <unordered_map>
 #include <cmath>
 #include <chrono>
 
@@ -25,10 +26,12 @@ SK_ILAOSTAR_SOLVER_TEMPLATE_DECL
 SK_ILAOSTAR_SOLVER_CLASS::ILAOStarSolver(
     Domain &domain, const GoalCheckerFunctor &goal_checker,
     const HeuristicFunctor &heuristic, double discount, double epsilon,
-    bool per_sweep_graph_update, const CallbackFunctor &callback, bool verbose)
+    bool per_sweep_graph_update, bool compact_backups,
+    const CallbackFunctor &callback, bool verbose)
     : _domain(domain), _goal_checker(goal_checker), _heuristic(heuristic),
       _discount(discount), _epsilon(epsilon),
-      _per_sweep_graph_update(per_sweep_graph_update), _callback(callback),
+      _per_sweep_graph_update(per_sweep_graph_update),
+      _compact_backups(compact_backups), _callback(callback),
       _verbose(verbose) {
 
   if (verbose) {
@@ -37,7 +40,13 @@ SK_ILAOSTAR_SOLVER_CLASS::ILAOStarSolver(
 }
 
 SK_ILAOSTAR_SOLVER_TEMPLATE_DECL
-void SK_ILAOSTAR_SOLVER_CLASS::clear() { _graph.clear(); }
+void SK_ILAOSTAR_SOLVER_CLASS::clear() {
+  _best_solution_graph.clear();
+  _compact_graph.clear();
+  _compact_nodes.clear();
+  _graph.clear();
+  _action_arena.release();
+}
 
 SK_ILAOSTAR_SOLVER_TEMPLATE_DECL
 void SK_ILAOSTAR_SOLVER_CLASS::solve(const State &s) {
@@ -232,9 +241,12 @@ void SK_ILAOSTAR_SOLVER_CLASS::expand(StateNode &s) {
         if (_verbose)
           Logger::debug("Current expanded action: " + a.print() +
                         ExecutionPolicy::print_thread());
-        _execution_policy.protect(
-            [&s, &a] { s.actions.push_back(std::make_unique<ActionNode>(a)); });
-        ActionNode &an = *(s.actions.back());
+        ActionNode *new_action = nullptr;
+        _execution_policy.protect([this, &s, &a, &new_action] {
+          s.actions.push_back(_action_arena.make(nullptr, a));
+          new_action = s.actions.back().get();
+        });
+        ActionNode &an = *new_action;
         auto next_states =
             _domain.get_next_state_distribution(s.state, a).get_values();
 
@@ -242,16 +254,15 @@ void SK_ILAOSTAR_SOLVER_CLASS::expand(StateNode &s) {
           if (_verbose)
             Logger::debug("Current next state expansion: " +
                           ns.state().print() + ExecutionPolicy::print_thread());
-          std::pair<typename Graph::iterator, bool> i;
-          _execution_policy.protect(
-              [this, &i, &ns] { i = _graph.emplace(ns.state()); });
+          std::pair<typename Graph::iterator, bool> i =
+              _graph.emplace(ns.state());
           StateNode &next_node = const_cast<StateNode &>(
               *(i.first)); // we won't change the real key (StateNode::state) so
                            // we are safe
-          an.outcomes.push_back(std::make_tuple(
+          an.outcomes.push_back(
               ns.probability(),
               _domain.get_transition_value(s.state, a, next_node.state).cost(),
-              &next_node));
+              &next_node);
 
           if (i.second) { // new node
             if (_goal_checker(_domain, next_node.state)) {
@@ -309,8 +320,7 @@ void SK_ILAOSTAR_SOLVER_CLASS::depth_first_search(StateNode &s) {
       if (_verbose)
         Logger::debug("Visiting successors of state " + cs->state.print());
       visited.insert(cs);
-      for (const auto &o : cs->best_action->outcomes) {
-        StateNode *ns = std::get<2>(o);
+      for (const auto &ns : cs->best_action->outcomes.nodes()) {
         if (visited.find(ns) == visited.end()) {
           open.push(ns);
         }
@@ -338,8 +348,7 @@ void SK_ILAOSTAR_SOLVER_CLASS::compute_best_solution_graph(StateNode &s) {
     std::unordered_set<StateNode *> new_frontier;
     for (const auto &fs : frontier) {
       if (fs->best_action != nullptr) {
-        for (const auto &ns : fs->best_action->outcomes) {
-          StateNode *nst = std::get<2>(ns);
+        for (const auto &nst : fs->best_action->outcomes.nodes()) {
           if ((nst->goal) || (nst->solved)) {
             if (_verbose)
               Logger::debug("Found terminal (either goal or solved) node " +
@@ -373,11 +382,8 @@ double SK_ILAOSTAR_SOLVER_CLASS::update(StateNode &s) {
   s.best_action = nullptr;
 
   for (const auto &a : s.actions) {
-    a->value = 0;
-    for (const auto &o : a->outcomes) {
-      a->value += std::get<0>(o) *
-                  (std::get<1>(o) + (_discount * std::get<2>(o)->best_value));
-    }
+    a->value = a->outcomes.q_value(
+        _discount, [](const StateNode &n) { return (double)n.best_value; });
     if (_verbose)
       Logger::debug("Computed Q-value of action " + a->action.print() + " : " +
                     StringConverter::from(a->value));
@@ -417,10 +423,20 @@ bool SK_ILAOSTAR_SOLVER_CLASS::value_iteration() {
   bool any_action_changed = false;
   double residual = std::numeric_limits<double>::infinity();
 
-  while (residual > _epsilon) {
-    auto result = value_iteration_sweep();
-    residual = result.first;
-    any_action_changed = any_action_changed || result.second;
+  if (_compact_backups) {
+    compile_best_solution_graph();
+    while (residual > _epsilon) {
+      auto result = _compact_graph.sweep(_discount);
+      residual = result.first;
+      any_action_changed = any_action_changed || result.second;
+    }
+    copy_compact_values();
+  } else {
+    while (residual > _epsilon) {
+      auto result = value_iteration_sweep();
+      residual = result.first;
+      any_action_changed = any_action_changed || result.second;
+    }
   }
 
   if (_verbose)
@@ -429,6 +445,76 @@ bool SK_ILAOSTAR_SOLVER_CLASS::value_iteration() {
   return any_action_changed;
 }
 
+SK_ILAOSTAR_SOLVER_TEMPLATE_DECL
+void SK_ILAOSTAR_SOLVER_CLASS::compile_best_solution_graph() {
+  if (_verbose)
+    Logger::debug("Compiling best solution graph of " +
+                  StringConverter::from(_best_solution_graph.size()) +
+                  " states");
+  _compact_graph.clear();
+  _compact_nodes.clear();
+  std::unordered_map<StateNode *, std::size_t> indices;
+
+  // the updated states come first, then the successor states outside of the
+  // best solution graph whose values are constant during value iteration
+  for (const auto &s : _best_solution_graph) {
+    indices.emplace(s, _compact_nodes.size());
+    _compact_nodes.push_back(s);
+  }
+  std::size_t nb_updated_states = _compact_nodes.size();
+  for (const auto &s : _best_solution_graph) {
+    for (const auto &a : s->actions) {
+      for (const auto &ns : a->outcomes.nodes()) {
+        if (indices.emplace(ns, _compact_nodes.size()).second) {
+          _compact_nodes.push_back(ns);
+        }
+      }
+    }
+  }
+
+  for (std::size_t i = 0; i < _compact_nodes.size(); i++) {
+    StateNode &s = *_compact_nodes[i];
+    _compact_graph.add_state(s.best_value);
+    if (i >= nb_updated_states) {
+      continue;
+    }
+    for (const auto &a : s.actions) {
+      _compact_graph.add_action(a->outcomes.expected_cost());
+      if (a.get() == s.best_action) {
+        _compact_graph.set_best_action(_compact_graph.nb_actions() - 1);
+      }
+      for (std::size_t o = 0; o < a->outcomes.size(); o++) {
+        _compact_graph.add_outcome(a->outcomes.probability(o),
+                                   indices[a->outcomes.node(o)]);
+      }
+    }
+  }
+
+  _compact_graph.finalize();
+}
+
+SK_ILAOSTAR_SOLVER_TEMPLATE_DECL
+void SK_ILAOSTAR_SOLVER_CLASS::copy_compact_values() {
+  // the states of the best solution graph come first
+  for (std::size_t i = 0; i < _best_solution_graph.size(); i++) {
+    StateNode &s = *_compact_nodes[i];
+    if (s.actions.empty()) {
+      continue; // constant state
+    }
+    std::size_t a = _compact_graph.first_action(i);
+    s.best_action = nullptr;
+    for (const auto &an : s.actions) {
+      an->value = _compact_graph.q_value(a);
+      if (a == _compact_graph.best_action(i)) {
+        s.best_action = an.get();
+      }
+      a++;
+    }
+    s.best_value = _compact_graph.value(i);
+    s.residual = _compact_graph.residual(i);
+  }
+}
+
 SK_ILAOSTAR_SOLVER_TEMPLATE_DECL
 bool SK_ILAOSTAR_SOLVER_CLASS::update_reachability(StateNode &s) {
   if (_verbose)
@@ -437,8 +523,8 @@ bool SK_ILAOSTAR_SOLVER_CLASS::update_reachability(StateNode &s) {
   bool record = s.reach_tip_node;
   bool reach_tip_node = false;
 
-  for (const auto &o : s.best_action->outcomes) {
-    reach_tip_node = reach_tip_node || (std::get<2>(o)->reach_tip_node);
+  for (const auto &ns : s.best_action->outcomes.nodes()) {
+    reach_tip_node = reach_tip_node || (ns->reach_tip_node);
   }
 
   if (_verbose)
@@ -474,9 +560,10 @@ double SK_ILAOSTAR_SOLVER_CLASS::update_mfpt(StateNode &s) {
   double record_value = s.first_passage_time;
   double first_passage_time = 0;
 
-  for (const auto &o : s.best_action->outcomes) {
-    first_passage_time +=
-        std::get<0>(o) * (1.0 + (std::get<2>(o)->first_passage_time));
+  const auto &outcomes = s.best_action->outcomes;
+  for (std::size_t i = 0; i < outcomes.size(); i++) {
+    first_passage_time += outcomes.probability(i) *
+                          (1.0 + (outcomes.node(i)->first_passage_time));
   }
 
   if (_verbose)
@@ -574,6 +661,7 @@ SK_ILAOSTAR_SOLVER_CLASS::create_from_params(
       params.template get<double>("discount", 1.0),
       params.template get<double>("epsilon", 0.001),
       params.template get<bool>("per_sweep_graph_update", false),
+      params.template get<bool>("compact_backups", false),
       CallbackFunctor([](const ILAOStarSolver &, Domain &) { return false; }),
       params.template get<bool>("verbose", verbose));
 }
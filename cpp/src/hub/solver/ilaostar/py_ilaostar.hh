@@ -53,7 +53,7 @@ private:
         const std::function<py::object(const py::object &, const py::object &)>
             &heuristic,
         double discount = 1.0, double epsilon = 0.001,
-        bool per_sweep_graph_update = false,
+        bool per_sweep_graph_update = false, bool compact_backups = false,
         const std::function<py::bool_(const py::object &)> &callback = nullptr,
         bool verbose = false)
         : _goal_checker(goal_checker), _heuristic(heuristic),
@@ -104,7 +104,7 @@ private:
               throw;
             }
           },
-          discount, epsilon, per_sweep_graph_update,
+          discount, epsilon, per_sweep_graph_update, compact_backups,
           [this](const skdecide::ILAOStarSolver<PyILAOStarDomain<Texecution>,
                                                 Texecution> &s,
                  PyILAOStarDomain<Texecution> &d) -> bool {
@@ -272,14 +272,16 @@ public:
       const std::function<py::object(const py::object &, const py::object &)>
           &heuristic,
       double discount = 1.0, double epsilon = 0.001,
-      bool per_sweep_graph_update = false, bool parallel = false,
+      bool per_sweep_graph_update = false, bool compact_backups = false,
+      bool parallel = false,
       const std::function<py::bool_(const py::object &)> &callback = nullptr,
       bool verbose = false) {
 
     TemplateInstantiator::select(ExecutionSelector(parallel),
                                  SolverInstantiator(_implementation))
         .instantiate(solver, domain, goal_checker, heuristic, discount, epsilon,
-                     per_sweep_graph_update, callback, verbose);
+                     per_sweep_graph_update, compact_backups, callback,
+                     verbose);
   }
 
   void close() { _implementation->close(); }
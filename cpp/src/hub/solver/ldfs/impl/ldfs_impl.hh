@@ -11,8 +11,10 @@
 #include <stack>
 #include <cmath>
 #include <algorithm>
+#include <iterator>
 #include <limits>
 #include <chrono>
+#include <type_traits>
 
 #include "utils/string_converter.hh"
 #include "utils/logging.hh"
@@ -29,8 +31,7 @@ namespace skdecide {
 SK_LDFS_SOLVER_TEMPLATE_DECL
 SK_LDFS_SOLVER_CLASS::StateNode::StateNode(const State &s)
     : state(s), best_action(nullptr), best_value(0.0), goal(false),
-      terminal(false), solved(false), active(false), idx(IDX_UNDEF),
-      low(IDX_UNDEF) {}
+      terminal(false), expanded(false), solved(false), labeling_lane(0) {}
 
 SK_LDFS_SOLVER_TEMPLATE_DECL
 const typename SK_LDFS_SOLVER_CLASS::State &
@@ -57,20 +58,22 @@ SK_LDFS_SOLVER_CLASS::LDFSSolver(Domain &domain,
     : _domain(domain), _goal_checker(goal_checker), _heuristic(heuristic),
       _terminal_value(terminal_value), _discount(discount), _epsilon(epsilon),
       _max_depth(max_depth), _callback(callback), _verbose(verbose),
-      _nb_tip_states(0), _tarjan_index(0) {
+      _nb_tip_states(0), _nb_lanes(1) {
   if (verbose) {
     Logger::check_level(logging::debug, "algorithm LDFS");
   }
+  if constexpr (is_concurrent_execution<ExecutionPolicy>::value) {
+    _nb_lanes = std::max<std::size_t>(1, _domain.get_parallel_capacity());
+  }
 }
 
 SK_LDFS_SOLVER_TEMPLATE_DECL
 void SK_LDFS_SOLVER_CLASS::clear() {
   _graph.clear();
+  _action_arena.release();
   _sccs.clear();
   _nb_tip_states = 0;
-  _tarjan_index = 0;
-  while (!_tarjan_stack.empty())
-    _tarjan_stack.pop();
+  _lanes.clear();
 }
 
 // --- LDFS(MDP)-DRIVER (Figure 4, top) ---
@@ -82,18 +85,30 @@ void SK_LDFS_SOLVER_CLASS::solve(const State &s) {
                  " LDFS solver from state " + s.print());
     _start_time = std::chrono::high_resolution_clock::now();
 
-    auto si = _graph.emplace(s);
-    StateNode &root = const_cast<StateNode &>(*(si.first));
-    if (si.second) {
+    bool inserted = false;
+    StateNode &root = insert_node(s, inserted);
+    if (inserted) {
       root.best_value = _heuristic(_domain, s).cost();
+      root.mutex.unlock();
     }
 
-    while (!root.solved && !_callback(*this, _domain)) {
-      _tarjan_index = 0;
-      ldfs_mdp(root);
-      clear_active_flags();
+    _lanes.clear();
+    for (std::size_t l = 0; l < _nb_lanes; l++) {
+      _lanes.emplace_back(l);
     }
 
+    // Each lane runs LDFS(MDP) iterations until the root is solved, skipping
+    // the states solved by the other lanes
+    for_each_rollout_lane<ExecutionPolicy>(
+        _nb_lanes, [this, &root](const std::size_t &lane_id) {
+          Lane &lane = _lanes[lane_id];
+          while (!root.solved && !_callback(*this, _domain)) {
+            lane.tarjan_index = 0;
+            ldfs_mdp(root, lane);
+            clear_active_flags(lane);
+          }
+        });
+
     Logger::info(
         "LDFS finished from state " + s.print() + " in " +
         StringConverter::from((double)get_solving_time() / (double)1e3) +
@@ -109,87 +124,127 @@ void SK_LDFS_SOLVER_CLASS::solve(const State &s) {
 // --- clear_active_flags (called by driver after each LDFS(MDP) call) ---
 
 SK_LDFS_SOLVER_TEMPLATE_DECL
-void SK_LDFS_SOLVER_CLASS::clear_active_flags() {
-  for (auto &sn : _graph) {
-    StateNode &node = const_cast<StateNode &>(sn);
-    node.active = false;
+void SK_LDFS_SOLVER_CLASS::clear_active_flags(Lane &lane) {
+  for (StateNode *node : lane.active_states) {
+    node->lanes[lane.id].active = false;
   }
+  lane.active_states.clear();
+}
+
+// --- insert_node ---
+//
+// Returns the node of a state, inserting it in the graph if needed. A newly
+// inserted node is returned with its mutex locked: the caller unlocks it once
+// the node is initialized, so that the other lanes wait for the
+// initialization before visiting the node.
+
+SK_LDFS_SOLVER_TEMPLATE_DECL
+typename SK_LDFS_SOLVER_CLASS::StateNode &
+SK_LDFS_SOLVER_CLASS::insert_node(const State &s, bool &inserted) {
+  StateNode *node = nullptr;
+  _execution_policy.protect([this, &s, &inserted, &node] {
+    auto i = _graph.emplace(s);
+    node = &const_cast<StateNode &>(*(i.first));
+    inserted = i.second;
+    if (inserted) {
+      node->lanes.resize(_nb_lanes);
+      node->mutex.lock();
+    }
+  });
+  return *node;
 }
 
 // --- expand ---
 
 SK_LDFS_SOLVER_TEMPLATE_DECL
-void SK_LDFS_SOLVER_CLASS::expand(StateNode &s) {
+void SK_LDFS_SOLVER_CLASS::expand(StateNode &s, const std::size_t *thread_id) {
   if (_verbose)
-    Logger::debug("Expanding state " + s.state.print());
+    Logger::debug("Expanding state " + s.state.print() +
+                  ExecutionPolicy::print_thread());
 
   _nb_tip_states++;
   auto applicable_actions =
-      _domain.get_applicable_actions(s.state).get_elements();
-
-  std::for_each(
-      ExecutionPolicy::policy, applicable_actions.begin(),
-      applicable_actions.end(), [this, &s](auto a) {
-        if (_verbose)
-          Logger::debug("Current expanded action: " + a.print() +
-                        ExecutionPolicy::print_thread());
-        _execution_policy.protect(
-            [&s, &a] { s.actions.push_back(std::make_unique<ActionNode>(a)); });
-        ActionNode &an = *(s.actions.back());
-        auto next_states =
-            _domain.get_next_state_distribution(s.state, a).get_values();
-
-        for (auto ns : next_states) {
-          if (_verbose)
-            Logger::debug("Current next state expansion: " +
-                          ns.state().print() + ExecutionPolicy::print_thread());
-          std::pair<typename Graph::iterator, bool> i;
-          _execution_policy.protect(
-              [this, &i, &ns] { i = _graph.emplace(ns.state()); });
-          StateNode &next_node = const_cast<StateNode &>(*(i.first));
-          an.outcomes.push_back(std::make_tuple(
-              ns.probability(),
-              _domain.get_transition_value(s.state, a, next_node.state).cost(),
-              &next_node));
-
-          if (i.second) { // new node
-            if (_goal_checker(_domain, next_node.state)) {
-              if (_verbose)
-                Logger::debug("Found goal state " + next_node.state.print() +
-                              ExecutionPolicy::print_thread());
-              next_node.goal = true;
-              next_node.best_value = 0.0;
-            } else if (_domain.is_terminal(next_node.state)) {
-              if (_verbose)
-                Logger::debug("Found terminal state " +
-                              next_node.state.print() +
-                              ExecutionPolicy::print_thread());
-              next_node.terminal = true;
-              next_node.best_value = _terminal_value(next_node.state).cost();
-            } else {
-              next_node.best_value =
-                  _heuristic(_domain, next_node.state).cost();
-              if (_verbose)
-                Logger::debug("New state " + next_node.state.print() +
-                              " with initial value " +
-                              StringConverter::from(next_node.best_value) +
-                              ExecutionPolicy::print_thread());
-            }
+      _domain.get_applicable_actions(s.state, thread_id).get_elements();
+
+  auto expand_action = [this, &s, &thread_id](auto a) {
+    if (_verbose)
+      Logger::debug("Current expanded action: " + a.print() +
+                    ExecutionPolicy::print_thread());
+    ActionNode *new_action = nullptr;
+    _execution_policy.protect([this, &s, &a, &new_action] {
+      s.actions.push_back(_action_arena.make(nullptr, a));
+      new_action = s.actions.back().get();
+    });
+    ActionNode &an = *new_action;
+    auto next_states =
+        _domain.get_next_state_distribution(s.state, a, thread_id)
+            .get_values();
+
+    for (auto ns : next_states) {
+      if (_verbose)
+        Logger::debug("Current next state expansion: " + ns.state().print() +
+                      ExecutionPolicy::print_thread());
+      bool inserted = false;
+      StateNode &next_node = insert_node(ns.state(), inserted);
+      an.outcomes.push_back(ns.probability(),
+                            _domain
+                                .get_transition_value(s.state, a,
+                                                      next_node.state,
+                                                      thread_id)
+                                .cost(),
+                            &next_node);
+
+      if (inserted) { // new node, locked until initialized
+        try {
+          if (_goal_checker(_domain, next_node.state)) {
+            if (_verbose)
+              Logger::debug("Found goal state " + next_node.state.print() +
+                            ExecutionPolicy::print_thread());
+            next_node.goal = true;
+            next_node.best_value = 0.0;
+          } else if (_domain.is_terminal(next_node.state, thread_id)) {
+            if (_verbose)
+              Logger::debug("Found terminal state " +
+                            next_node.state.print() +
+                            ExecutionPolicy::print_thread());
+            next_node.terminal = true;
+            next_node.best_value = _terminal_value(next_node.state).cost();
+          } else {
+            next_node.best_value = _heuristic(_domain, next_node.state).cost();
+            if (_verbose)
+              Logger::debug("New state " + next_node.state.print() +
+                            " with initial value " +
+                            StringConverter::from(next_node.best_value) +
+                            ExecutionPolicy::print_thread());
           }
+        } catch (...) {
+          next_node.mutex.unlock();
+          throw;
         }
-      });
+        next_node.mutex.unlock();
+      }
+    }
+  };
+
+  if (thread_id == nullptr) {
+    // Single lane: generate the action transitions in parallel
+    std::for_each(ExecutionPolicy::policy, applicable_actions.begin(),
+                  applicable_actions.end(), expand_action);
+  } else {
+    // Parallel lanes: the lane's domain process serves one query at a time
+    std::for_each(applicable_actions.begin(), applicable_actions.end(),
+                  expand_action);
+  }
 }
 
 // --- q_value (cost minimization) ---
 
 SK_LDFS_SOLVER_TEMPLATE_DECL
 double SK_LDFS_SOLVER_CLASS::q_value(ActionNode &a) {
-  a.value = 0.0;
-  for (const auto &o : a.outcomes) {
-    a.value += std::get<0>(o) *
-               (std::get<1>(o) + _discount * std::get<2>(o)->best_value);
-  }
-  return a.value;
+  double v = a.outcomes.q_value(
+      _discount, [](const StateNode &n) { return (double)n.best_value; });
+  a.value = v;
+  return v;
 }
 
 // --- LDFS(MDP) (Figure 4, bottom) ---
@@ -199,37 +254,57 @@ double SK_LDFS_SOLVER_CLASS::q_value(ActionNode &a) {
 // The nested foreach-action / foreach-successor loops are tracked via
 // iterators stored in the frame. When a child "call" is needed, we push
 // a new frame and continue; when it "returns", we resume the parent frame
-// using _last_rv to pass the return value.
+// using lane.last_rv to pass the return value.
+//
+// The Tarjan indices, lowlinks and ACTIVE flags are the ones of the lane.
+// Lanes other than the first one iterate over the actions of a state from a
+// random action, wrapping around the end of the action list.
 
 SK_LDFS_SOLVER_TEMPLATE_DECL
-void SK_LDFS_SOLVER_CLASS::ldfs_mdp(StateNode &root) {
-  typedef typename std::list<std::unique_ptr<ActionNode>>::iterator ActionIter;
-  typedef typename std::list<std::tuple<double, double, StateNode *>>::iterator
-      OutcomeIter;
+void SK_LDFS_SOLVER_CLASS::ldfs_mdp(StateNode &root, Lane &lane) {
+  typedef
+      typename std::list<typename ActionArena::Pointer>::iterator ActionIter;
 
   struct DFSFrame {
     StateNode *node;
     ActionIter action_it;
-    OutcomeIter outcome_it;
+    std::size_t nb_actions_left; // actions not tried yet from action_it
+    std::size_t outcome_idx;
     ActionNode *current_action;
     StateNode *child_returned; // non-null when resuming after child call
     bool flag;
     bool initialized;
 
     DFSFrame(StateNode *n)
-        : node(n), current_action(nullptr), child_returned(nullptr),
-          flag(false), initialized(false) {}
+        : node(n), nb_actions_left(0), outcome_idx(0),
+          current_action(nullptr), child_returned(nullptr), flag(false),
+          initialized(false) {}
   };
 
+  const std::size_t *thread_id = (_nb_lanes > 1) ? &lane.id : nullptr;
   std::stack<DFSFrame> dfs_stack;
   dfs_stack.push(DFSFrame(&root));
 
   while (!dfs_stack.empty()) {
     DFSFrame &f = dfs_stack.top();
     StateNode *s = f.node;
+    TarjanLabel &sl = s->lanes[lane.id];
 
     // ===== INITIALIZATION (first entry into this frame) =====
     if (!f.initialized) {
+      // Expand on first visit (waits for the lane initializing or expanding
+      // the state, if any)
+      if (!s->solved && !s->expanded) {
+        _execution_policy.protect(
+            [this, &s, &thread_id] {
+              if (!s->goal && !s->terminal && !s->expanded) {
+                expand(*s, thread_id);
+                s->expanded = true;
+              }
+            },
+            s->mutex);
+      }
+
       // "if s is SOLVED or terminal then"
       if (s->solved || s->goal || s->terminal) {
         if (s->goal) {
@@ -238,32 +313,31 @@ void SK_LDFS_SOLVER_CLASS::ldfs_mdp(StateNode &root) {
           s->best_value = _terminal_value(s->state).cost();
         }
         s->solved = true;
-        _last_rv = true;
+        lane.last_rv = true;
         dfs_stack.pop();
         continue;
       }
 
       // "if s is ACTIVE then return false"
-      if (s->active) {
-        _last_rv = false;
+      if (sl.active) {
+        lane.last_rv = false;
         dfs_stack.pop();
         continue;
       }
 
-      // Expand on first visit
-      if (s->actions.empty()) {
-        expand(*s);
-      }
-
       // "Push s into stack; s.idx := s.low := index; index := index + 1"
-      _tarjan_stack.push(s);
-      s->idx = _tarjan_index;
-      s->low = _tarjan_index;
-      _tarjan_index++;
+      lane.tarjan_stack.push(s);
+      sl.idx = lane.tarjan_index;
+      sl.low = lane.tarjan_index;
+      lane.tarjan_index++;
 
       // "flag := false"
       f.flag = false;
       f.action_it = s->actions.begin();
+      f.nb_actions_left = s->actions.size();
+      if (lane.id > 0 && f.nb_actions_left > 1) {
+        std::advance(f.action_it, lane.rng() % f.nb_actions_left);
+      }
       f.current_action = nullptr;
       f.child_returned = nullptr;
       f.initialized = true;
@@ -272,9 +346,9 @@ void SK_LDFS_SOLVER_CLASS::ldfs_mdp(StateNode &root) {
     // ===== HANDLE CHILD RETURN =====
     if (f.child_returned != nullptr) {
       // "flag := LDFS(s', ...) & flag" — apply child's return value
-      f.flag = _last_rv && f.flag;
+      f.flag = lane.last_rv && f.flag;
       // "s.low := min{s.low, s'.low}"
-      s->low = std::min(s->low, f.child_returned->low);
+      sl.low = std::min(sl.low, f.child_returned->lanes[lane.id].low);
       f.child_returned = nullptr;
       // Fall through to continue outcome iteration
     }
@@ -284,12 +358,13 @@ void SK_LDFS_SOLVER_CLASS::ldfs_mdp(StateNode &root) {
     bool pushed_child = false;
 
     if (f.current_action != nullptr) {
-      // We're inside an action's outcome loop — continue from f.outcome_it
-      while (f.outcome_it != f.current_action->outcomes.end()) {
-        StateNode *sp = std::get<2>(*f.outcome_it);
-        ++f.outcome_it;
+      // We're inside an action's outcome loop — continue from f.outcome_idx
+      while (f.outcome_idx < f.current_action->outcomes.size()) {
+        StateNode *sp = f.current_action->outcomes.node(f.outcome_idx);
+        TarjanLabel &spl = sp->lanes[lane.id];
+        ++f.outcome_idx;
 
-        if (sp->idx == IDX_UNDEF) {
+        if (spl.idx == IDX_UNDEF) {
           // Depth limit check: if reached, treat as unsolved
           if (_max_depth > 0 && dfs_stack.size() >= _max_depth) {
             f.flag = false;
@@ -300,9 +375,9 @@ void SK_LDFS_SOLVER_CLASS::ldfs_mdp(StateNode &root) {
           dfs_stack.push(DFSFrame(sp));
           pushed_child = true;
           break;
-        } else if (sp->active) {
+        } else if (spl.active) {
           // "s.low := min{s.low, s'.idx}"
-          s->low = std::min(s->low, sp->idx);
+          sl.low = std::min(sl.low, spl.idx);
         }
       }
 
@@ -313,12 +388,22 @@ void SK_LDFS_SOLVER_CLASS::ldfs_mdp(StateNode &root) {
       // Outcome loop finished for current action
       // "if flag then break"
       if (f.flag) {
-        s->best_action = f.current_action;
+        ActionNode *best_action = f.current_action;
+        _execution_policy.protect(
+            [&s, &best_action] {
+              if (!s->solved && s->labeling_lane == 0) {
+                s->best_action = best_action;
+              }
+            },
+            s->mutex);
         // Skip remaining actions — go to finalization
-        f.action_it = s->actions.end();
+        f.nb_actions_left = 0;
       } else {
         // This action didn't work, try next
-        ++f.action_it;
+        if (++f.action_it == s->actions.end()) {
+          f.action_it = s->actions.begin();
+        }
+        f.nb_actions_left--;
         f.current_action = nullptr;
       }
     }
@@ -327,20 +412,26 @@ void SK_LDFS_SOLVER_CLASS::ldfs_mdp(StateNode &root) {
     if (!pushed_child && f.current_action == nullptr) {
       bool found_action = false;
 
-      while (f.action_it != s->actions.end()) {
+      while (f.nb_actions_left > 0) {
         ActionNode &a = **f.action_it;
 
         // "if Q_V(a,s) - V(s) > ε then continue"
         if (q_value(a) - s->best_value > _epsilon) {
-          ++f.action_it;
+          if (++f.action_it == s->actions.end()) {
+            f.action_it = s->actions.begin();
+          }
+          f.nb_actions_left--;
           continue;
         }
 
         // "Mark s as ACTIVE; flag := true"
-        s->active = true;
+        if (!sl.active) {
+          sl.active = true;
+          lane.active_states.push_back(s);
+        }
         f.flag = true;
         f.current_action = &a;
-        f.outcome_it = a.outcomes.begin();
+        f.outcome_idx = 0;
         found_action = true;
         break;
       }
@@ -358,10 +449,11 @@ void SK_LDFS_SOLVER_CLASS::ldfs_mdp(StateNode &root) {
 
     // "while stack.top.idx > s.idx do
     //    stack.top.idx := stack.top.low := ∞; Pop stack"
-    while (!_tarjan_stack.empty() && _tarjan_stack.top()->idx > s->idx) {
-      _tarjan_stack.top()->idx = IDX_UNDEF;
-      _tarjan_stack.top()->low = IDX_UNDEF;
-      _tarjan_stack.pop();
+    while (!lane.tarjan_stack.empty() &&
+           lane.tarjan_stack.top()->lanes[lane.id].idx > sl.idx) {
+      lane.tarjan_stack.top()->lanes[lane.id].idx = IDX_UNDEF;
+      lane.tarjan_stack.top()->lanes[lane.id].low = IDX_UNDEF;
+      lane.tarjan_stack.pop();
     }
 
     if (!f.flag) {
@@ -375,42 +467,44 @@ void SK_LDFS_SOLVER_CLASS::ldfs_mdp(StateNode &root) {
           best_act = a_ptr.get();
         }
       }
-      s->best_value = best_val;
-      s->best_action = best_act;
+      _execution_policy.protect(
+          [&s, &best_val, &best_act] {
+            if (!s->solved && s->labeling_lane == 0) {
+              s->best_value = best_val;
+              s->best_action = best_act;
+            }
+          },
+          s->mutex);
 
       if (_verbose)
         Logger::debug("Updated state " + s->state.print() + " to value " +
-                      StringConverter::from(s->best_value));
+                      StringConverter::from(best_val) +
+                      ExecutionPolicy::print_thread());
 
       // "s.idx := s.low := ∞; Pop stack"
-      s->idx = IDX_UNDEF;
-      s->low = IDX_UNDEF;
-      if (!_tarjan_stack.empty() && _tarjan_stack.top() == s) {
-        _tarjan_stack.pop();
+      sl.idx = IDX_UNDEF;
+      sl.low = IDX_UNDEF;
+      if (!lane.tarjan_stack.empty() && lane.tarjan_stack.top() == s) {
+        lane.tarjan_stack.pop();
       }
 
-      _last_rv = false;
-    } else if (s->low == s->idx) {
+      lane.last_rv = false;
+    } else if (sl.low == sl.idx) {
       // SCC root: "while stack.top.idx ≥ s.idx do
       //   Mark s as SOLVED; stack.top.idx := stack.top.low := ∞; Pop stack"
       std::vector<StateNode *> scc;
-      while (!_tarjan_stack.empty() && _tarjan_stack.top()->idx >= s->idx) {
-        StateNode *w = _tarjan_stack.top();
-        w->solved = true;
-        w->idx = IDX_UNDEF;
-        w->low = IDX_UNDEF;
+      while (!lane.tarjan_stack.empty() &&
+             lane.tarjan_stack.top()->lanes[lane.id].idx >= sl.idx) {
+        StateNode *w = lane.tarjan_stack.top();
+        w->lanes[lane.id].idx = IDX_UNDEF;
+        w->lanes[lane.id].low = IDX_UNDEF;
         scc.push_back(w);
-        _tarjan_stack.pop();
-
-        if (_verbose)
-          Logger::debug("Labeling state " + w->state.print() + " as solved");
+        lane.tarjan_stack.pop();
       }
-      _sccs.push_back(std::move(scc));
-
-      _last_rv = true;
+      lane.last_rv = label_solved(scc, lane);
     } else {
       // Part of larger SCC, not root — just return flag
-      _last_rv = f.flag;
+      lane.last_rv = f.flag;
     }
 
     // "return flag"
@@ -418,6 +512,87 @@ void SK_LDFS_SOLVER_CLASS::ldfs_mdp(StateNode &root) {
   }
 }
 
+// --- label_solved ---
+//
+// Labels the states of an SCC found consistent by a lane as solved. Another
+// lane may have updated some of them since the lane checked them, so the
+// states are first frozen (their value and best action do not change any
+// more), then each state must still be ε-consistent with a best action whose
+// successors are solved or in the SCC. Returns false, leaving the states
+// unsolved, if the check fails or if another lane is labeling one of the
+// states; the next iterations revisit them. With a single lane the check
+// always succeeds.
+
+SK_LDFS_SOLVER_TEMPLATE_DECL
+bool SK_LDFS_SOLVER_CLASS::label_solved(const std::vector<StateNode *> &scc,
+                                        Lane &lane) {
+  const std::size_t label = lane.id + 1;
+  std::size_t nb_frozen = 0;
+  bool consistent = true;
+
+  for (; nb_frozen < scc.size() && consistent; nb_frozen++) {
+    StateNode *w = scc[nb_frozen];
+    _execution_policy.protect(
+        [&w, &label, &consistent] {
+          if (w->labeling_lane == 0) {
+            w->labeling_lane = label;
+          } else {
+            consistent = false;
+          }
+        },
+        w->mutex);
+  }
+
+  if (!consistent) {
+    nb_frozen--; // the last state is frozen by another lane
+  } else {
+    for (StateNode *w : scc) {
+      if (w->solved) {
+        continue;
+      }
+      ActionNode *a = w->best_action;
+      if (a == nullptr || q_value(*a) - w->best_value > _epsilon) {
+        consistent = false;
+        break;
+      }
+      for (StateNode *n : a->outcomes.nodes()) {
+        if (!n->solved && n->labeling_lane != label) {
+          consistent = false;
+          break;
+        }
+      }
+      if (!consistent) {
+        break;
+      }
+    }
+  }
+
+  std::vector<StateNode *> labeled; // states not solved by another lane
+  for (std::size_t i = 0; i < nb_frozen; i++) {
+    StateNode *w = scc[i];
+    _execution_policy.protect(
+        [&w, &consistent, &labeled] {
+          if (consistent && !w->solved) {
+            w->solved = true;
+            labeled.push_back(w);
+          }
+          w->labeling_lane = 0;
+        },
+        w->mutex);
+
+    if (_verbose && consistent)
+      Logger::debug("Labeling state " + w->state.print() + " as solved" +
+                    ExecutionPolicy::print_thread());
+  }
+
+  if (!labeled.empty()) {
+    _execution_policy.protect(
+        [this, &labeled] { _sccs.push_back(std::move(labeled)); },
+        _sccs_mutex);
+  }
+  return consistent;
+}
+
 // --- Accessors ---
 
 SK_LDFS_SOLVER_TEMPLATE_DECL
@@ -578,7 +753,7 @@ SK_IDASTAR_SOLVER_CLASS::get_plan(const typename Tdomain::State &s) const {
     if (si->best_action->outcomes.empty()) {
       break;
     }
-    auto *next = std::get<2>(si->best_action->outcomes.front());
+    auto *next = si->best_action->outcomes.node(0);
     if (next->goal || next->terminal) {
       break;
     }
@@ -13,10 +13,14 @@
 #include <list>
 #include <chrono>
 #include <limits>
+#include <random>
 
 #include "utils/associative_container_deducer.hh"
 #include "utils/string_converter.hh"
 #include "utils/execution.hh"
+#include "utils/node_arena.hh"
+#include "utils/outcome_arrays.hh"
+#include "utils/rollout_lanes.hh"
 #include "utils/logging.hh"
 #include "hub/solver/inner_solver/inner_solver_traits.hh"
 
@@ -46,9 +50,23 @@ namespace skdecide {
  * A goal_checker functor is required: without goal states and discount=1.0,
  * the algorithm will not converge.
  *
+ * With ParallelExecution, one lane per domain process (see
+ * Domain::get_parallel_capacity()) runs its own LDFS(MDP) iterations from the
+ * initial state on its own thread. The lanes share the explored graph, the
+ * value function and the solved labels, so that a lane skips the components
+ * solved by the others, but each lane has its own Tarjan indices and ACTIVE
+ * flags. Lanes other than the first one try the consistent actions of a state
+ * starting from a random action, which spreads the lanes over the different
+ * sub-regions of the problem. A state is expanded, Bellman-updated or labeled
+ * solved under its own mutex; values are read without locking. Since the other
+ * lanes may update the states of an SCC while a lane traverses it, the SCC's
+ * states are frozen and their consistency is checked again before labeling
+ * them solved. With a single lane, action transitions are generated in
+ * parallel instead.
+ *
  * @tparam Tdomain Type of the domain class
  * @tparam Texecution_policy Type of the execution policy (SequentialExecution
- * or ParallelExecution for parallel action-transition generation)
+ * or ParallelExecution for parallel lanes)
  */
 template <typename Tdomain, typename Texecution_policy = SequentialExecution>
 class LDFSSolver {
@@ -131,6 +149,15 @@ protected:
   static constexpr std::size_t IDX_UNDEF =
       std::numeric_limits<std::size_t>::max();
 
+  // Tarjan index, lowlink and ACTIVE flag of a state in the DFS of one lane
+  struct TarjanLabel {
+    std::size_t idx;
+    std::size_t low;
+    bool active;
+
+    TarjanLabel() : idx(IDX_UNDEF), low(IDX_UNDEF), active(false) {}
+  };
+
   Domain &_domain;
   GoalCheckerFunctor _goal_checker;
   HeuristicFunctor _heuristic;
@@ -143,18 +170,22 @@ protected:
   ExecutionPolicy _execution_policy;
 
   struct ActionNode;
+  typedef NodeArena<ActionNode, ExecutionPolicy> ActionArena;
 
   struct StateNode {
     State state;
-    std::list<std::unique_ptr<ActionNode>> actions;
+    std::list<typename ActionArena::Pointer> actions;
     ActionNode *best_action;
     atomic_double best_value;
     bool goal;
     bool terminal;
-    bool solved;
-    bool active;
-    std::size_t idx;
-    std::size_t low;
+    atomic_bool expanded;
+    atomic_bool solved;
+    // 1 + id of the lane checking the state's SCC before labeling it solved
+    // (0 if none): the state's value and best action are frozen meanwhile
+    typename ExecutionPolicy::template atomic<std::size_t> labeling_lane;
+    std::vector<TarjanLabel> lanes; // sized to _nb_lanes when inserted
+    typename ExecutionPolicy::Mutex mutex;
 
     StateNode(const State &s);
 
@@ -165,27 +196,42 @@ protected:
 
   struct ActionNode {
     Action action;
-    std::list<std::tuple<double, double, StateNode *>>
-        outcomes; // (probability, cost, next_state_node)
-    double value;
+    OutcomeArray<StateNode> outcomes; // next state nodes owned by _graph
+    atomic_double value;
 
     ActionNode(const Action &a);
   };
 
-  typedef typename SetTypeDeducer<StateNode, State>::Set Graph;
+  // DFS state of a lane, i.e. of one thread running LDFS(MDP) iterations
+  struct Lane {
+    std::size_t id;
+    std::size_t tarjan_index;
+    std::stack<StateNode *> tarjan_stack;
+    std::vector<StateNode *> active_states; // states marked ACTIVE
+    std::minstd_rand rng;                   // first action tried in a state
+    bool last_rv;
+
+    Lane(std::size_t lane_id)
+        : id(lane_id), tarjan_index(0), rng(lane_id), last_rv(false) {}
+  };
+
+  typedef typename SetTypeDeducer<StateNode, State,
+                                  NodeArenaAllocator<StateNode>>::Set Graph;
+  ActionArena _action_arena; // must outlive the graph
   Graph _graph;
   std::vector<std::vector<StateNode *>> _sccs;
-  std::size_t _nb_tip_states;
-  std::size_t _tarjan_index;
-  std::stack<StateNode *> _tarjan_stack;
+  typename ExecutionPolicy::Mutex _sccs_mutex;
+  typename ExecutionPolicy::template atomic<std::size_t> _nb_tip_states;
+  std::size_t _nb_lanes;
+  std::vector<Lane> _lanes;
   std::chrono::time_point<std::chrono::high_resolution_clock> _start_time;
 
-  void expand(StateNode &s);
+  StateNode &insert_node(const State &s, bool &inserted);
+  void expand(StateNode &s, const std::size_t *thread_id);
   double q_value(ActionNode &a);
-  void ldfs_mdp(StateNode &root);
-  void clear_active_flags();
-
-  bool _last_rv;
+  void ldfs_mdp(StateNode &root, Lane &lane);
+  bool label_solved(const std::vector<StateNode *> &scc, Lane &lane);
+  void clear_active_flags(Lane &lane);
 };
 
 /**
@@ -133,6 +133,8 @@ protected:
                  PyLDFSDomain<Texecution> &d) -> bool {
             if (_callback) {
               try {
+                // Called by the rollout lanes, which run without the GIL
+                typename skdecide::GilControl<Texecution>::Acquire acquire;
                 return _callback(*_pysolver);
               } catch (const std::exception &e) {
                 Logger::error(std::string("SKDECIDE exception when calling "
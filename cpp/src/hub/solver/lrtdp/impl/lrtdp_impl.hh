@@ -5,8 +5,7 @@
 #ifndef SKDECIDE_LRTDP_IMPL_HH
 #define SKDECIDE_LRTDP_IMPL_HH
 
-#include <boost/range/irange.hpp>
-
+#include "utils/rollout_lanes.hh"
 #include "utils/string_converter.hh"
 #include "utils/logging.hh"
 
@@ -34,7 +33,8 @@ SK_LRTDP_SOLVER_CLASS::LRTDPSolver(
       _residual_moving_average_window(residual_moving_average_window),
       _epsilon(epsilon), _discount(discount),
       _online_node_garbage(online_node_garbage), _callback(callback),
-      _verbose(verbose), _current_state(nullptr), _nb_rollouts(0) {
+      _verbose(verbose), _action_arena(domain.get_parallel_capacity()),
+      _current_state(nullptr), _nb_rollouts(0) {
 
   if (verbose) {
     Logger::check_level(logging::debug, "algorithm LRTDP");
@@ -42,10 +42,30 @@ SK_LRTDP_SOLVER_CLASS::LRTDPSolver(
 
   std::random_device rd;
   _gen = std::make_unique<std::mt19937>(rd());
+
+  _compactor = std::make_unique<Compactor>(
+      [this](StateNode &n, std::vector<StateNode *> &children) {
+        _execution_policy.protect(
+            [&n, &children]() {
+              for (const auto &action : n.actions) {
+                children.insert(children.end(),
+                                action->outcomes.nodes().begin(),
+                                action->outcomes.nodes().end());
+              }
+            },
+            n.mutex);
+      },
+      [this](StateNode &n, const std::function<bool(StateNode *)> &) {
+        _graph.erase(StateNode(n.state));
+      });
 }
 
 SK_LRTDP_SOLVER_TEMPLATE_DECL
-void SK_LRTDP_SOLVER_CLASS::clear() { _graph.clear(); }
+void SK_LRTDP_SOLVER_CLASS::clear() {
+  _compactor->cancel();
+  _graph.clear();
+  _action_arena.release();
+}
 
 SK_LRTDP_SOLVER_TEMPLATE_DECL
 void SK_LRTDP_SOLVER_CLASS::solve(const State &s) {
@@ -58,6 +78,7 @@ void SK_LRTDP_SOLVER_CLASS::solve(const State &s) {
     StateNode &root_node = const_cast<StateNode &>(
         *(si.first)); // we won't change the real key (StateNode::state) so we
                       // are safe
+    retain(root_node);
 
     if (si.second) {
       root_node.best_value = _heuristic(_domain, s, nullptr).cost();
@@ -77,29 +98,31 @@ void SK_LRTDP_SOLVER_CLASS::solve(const State &s) {
     _nb_rollouts = 0;
     _residual_moving_average = 0.0;
     _residuals.clear();
-    boost::integer_range<std::size_t> parallel_rollouts(
-        0, _domain.get_parallel_capacity());
-
-    std::for_each(ExecutionPolicy::policy, parallel_rollouts.begin(),
-                  parallel_rollouts.end(),
-                  [this, &root_node](const std::size_t &thread_id) {
-                    do {
-                      if (_verbose)
-                        Logger::debug("Starting rollout " +
-                                      StringConverter::from(_nb_rollouts) +
-                                      ExecutionPolicy::print_thread());
-                      _nb_rollouts++;
-                      double root_node_record_value = root_node.best_value;
-                      trial(&root_node, &thread_id);
-                      update_residual_moving_average(root_node,
-                                                     root_node_record_value);
-                    } while (!_callback(*this, _domain, &thread_id) &&
-                             (get_solving_time() < _time_budget) &&
-                             (!_use_labels || !root_node.solved) &&
-                             (_use_labels ||
-                              ((_nb_rollouts < _rollout_budget) &&
-                               (get_residual_moving_average() > _epsilon))));
-                  });
+    for_each_rollout_lane<ExecutionPolicy>(
+        _domain.get_parallel_capacity(),
+        [this, &root_node](const std::size_t &thread_id) {
+          do {
+            if (_verbose)
+              Logger::debug("Starting rollout " +
+                            StringConverter::from(_nb_rollouts) +
+                            ExecutionPolicy::print_thread());
+            _nb_rollouts++;
+            {
+              // The compactor can't erase nodes during the trial
+              auto guard = _compactor->guard();
+              double root_node_record_value = root_node.best_value;
+              trial(&root_node, &thread_id);
+              update_residual_moving_average(root_node,
+                                             root_node_record_value);
+            }
+            _compactor->step();
+          } while (!_callback(*this, _domain, &thread_id) &&
+                   (get_solving_time() < _time_budget) &&
+                   (!_use_labels || !root_node.solved) &&
+                   (_use_labels ||
+                    ((_nb_rollouts < _rollout_budget) &&
+                     (get_residual_moving_average() > _epsilon))));
+        });
 
     Logger::info(
         "LRTDP finished to solve from state " + s.print() + " in " +
@@ -117,6 +140,8 @@ void SK_LRTDP_SOLVER_CLASS::solve(const State &s) {
 SK_LRTDP_SOLVER_TEMPLATE_DECL
 bool SK_LRTDP_SOLVER_CLASS::is_solution_defined_for(const State &s) {
   bool res;
+  // The guard is always taken before the protection, as in the rollouts
+  auto guard = _compactor->guard();
   _execution_policy.protect([this, &s, &res]() {
     auto si = _graph.find(s);
     if ((si == _graph.end()) || (si->best_action == nullptr)) {
@@ -133,29 +158,28 @@ SK_LRTDP_SOLVER_TEMPLATE_DECL
 const typename SK_LRTDP_SOLVER_CLASS::Action &
 SK_LRTDP_SOLVER_CLASS::get_best_action(const State &s) {
   ActionNode *best_action = nullptr;
+  // Joins the compaction outside the protection since the compaction can wait
+  // for guarded threads which wait for the protection
+  _compactor->finish(); // usually already completed during the search
   _execution_policy.protect([this, &s, &best_action]() {
     auto si = _graph.find(s);
     if ((si != _graph.end()) && (si->best_action != nullptr)) {
       if (_verbose) {
         std::string str = "(";
-        for (const auto &o : si->best_action->outcomes) {
-          str += "\n    " + std::get<2>(o)->state.print();
+        for (const auto &ns : si->best_action->outcomes.nodes()) {
+          str += "\n    " + ns->state.print();
         }
         str += "\n)";
         Logger::debug("Best action's outcomes:\n" + str);
       }
-      if (_online_node_garbage && _current_state) {
-        std::unordered_set<StateNode *> root_subgraph, child_subgraph;
-        compute_reachable_subgraph(_current_state, root_subgraph);
-        compute_reachable_subgraph(
-            const_cast<StateNode *>(&(*si)),
-            child_subgraph); // we won't change the real key (StateNode::state)
-                             // so we are safe
-        remove_subgraph(root_subgraph, child_subgraph);
+      // we won't change the real key (StateNode::state) so we are safe
+      StateNode *child = const_cast<StateNode *>(&(*si));
+      if (_online_node_garbage) {
+        // The nodes which are no more reachable are reclaimed during the next
+        // search
+        _compactor->retire(_current_state, *child);
       }
-      _current_state =
-          const_cast<StateNode *>(&(*si)); // we won't change the real key
-                                           // (StateNode::state) so we are safe
+      _current_state = child;
       best_action = si->best_action;
     }
   });
@@ -171,28 +195,34 @@ SK_LRTDP_SOLVER_CLASS::get_best_action(const State &s) {
 SK_LRTDP_SOLVER_TEMPLATE_DECL
 typename SK_LRTDP_SOLVER_CLASS::Value
 SK_LRTDP_SOLVER_CLASS::get_best_value(const State &s) {
-  const atomic_double *best_value = nullptr;
-  _execution_policy.protect([this, &s, &best_value]() {
+  bool found = false;
+  double best_value = 0.0;
+  auto guard = _compactor->guard();
+  _execution_policy.protect([this, &s, &found, &best_value]() {
     auto si = _graph.find(s);
     if (si != _graph.end()) {
-      best_value = &(si->best_value);
+      found = true;
+      best_value = si->best_value;
     }
   });
-  if (best_value == nullptr) {
+  if (!found) {
     Logger::error("SKDECIDE exception: no best action found in state " +
                   s.print());
     throw std::runtime_error(
         "SKDECIDE exception: no best action found in state " + s.print());
   }
   Value val;
-  val.cost(*best_value);
+  val.cost(best_value);
   return val;
 }
 
 SK_LRTDP_SOLVER_TEMPLATE_DECL
 std::size_t SK_LRTDP_SOLVER_CLASS::get_nb_explored_states() {
   std::size_t sz = 0;
-  _execution_policy.protect([this, &sz]() { sz = _graph.size(); });
+  auto guard = _compactor->guard();
+  _execution_policy.protect([this, &sz]() {
+    sz = _graph.size();
+  });
   return sz;
 }
 
@@ -236,6 +266,7 @@ SK_LRTDP_SOLVER_TEMPLATE_DECL typename MapTypeDeducer<
               typename SK_LRTDP_SOLVER_CLASS::Value>>::Map
 SK_LRTDP_SOLVER_CLASS::get_policy() {
   typename MapTypeDeducer<State, std::pair<Action, Value>>::Map p;
+  auto guard = _compactor->guard();
   _execution_policy.protect([this, &p]() {
     for (auto &n : _graph) {
       if (n.best_action != nullptr) {
@@ -261,26 +292,23 @@ void SK_LRTDP_SOLVER_CLASS::expand(StateNode *s, const std::size_t *thread_id) {
     if (_verbose)
       Logger::debug("Current expanded action: " + a.print() +
                     ExecutionPolicy::print_thread());
-    s->actions.push_back(std::make_unique<ActionNode>(a));
+    s->actions.push_back(_action_arena.make(thread_id, a));
     ActionNode &an = *(s->actions.back());
     auto next_states =
         _domain.get_next_state_distribution(s->state, a, thread_id)
             .get_values();
-    std::vector<double> outcome_weights;
 
     for (auto ns : next_states) {
-      std::pair<typename Graph::iterator, bool> i;
-      _execution_policy.protect(
-          [this, &i, &ns]() { i = _graph.emplace(ns.state()); });
+      std::pair<typename Graph::iterator, bool> i = _graph.emplace(ns.state());
       StateNode &next_node = const_cast<StateNode &>(
           *(i.first)); // we won't change the real key (StateNode::state) so
                        // we are safe
-      an.outcomes.push_back(std::make_tuple(
+      retain(next_node);
+      an.outcomes.push_back(
           ns.probability(),
           _domain.get_transition_value(s->state, a, next_node.state, thread_id)
               .cost(),
-          &next_node));
-      outcome_weights.push_back(std::get<0>(an.outcomes.back()));
+          &next_node);
       if (_verbose)
         Logger::debug(
             "Current next state expansion: " + next_node.state.print() +
@@ -312,19 +340,15 @@ void SK_LRTDP_SOLVER_CLASS::expand(StateNode *s, const std::size_t *thread_id) {
       }
     }
 
-    an.dist = std::discrete_distribution<>(outcome_weights.begin(),
-                                           outcome_weights.end());
+    an.dist = std::discrete_distribution<>(an.outcomes.probabilities().begin(),
+                                           an.outcomes.probabilities().end());
   }
 }
 
 SK_LRTDP_SOLVER_TEMPLATE_DECL
 double SK_LRTDP_SOLVER_CLASS::q_value(ActionNode *a) {
-  a->value = 0;
-  for (const auto &o : a->outcomes) {
-    a->value = a->value +
-               (std::get<0>(o) *
-                (std::get<1>(o) + (_discount * std::get<2>(o)->best_value)));
-  }
+  a->value = a->outcomes.q_value(
+      _discount, [](const StateNode &n) { return (double)n.best_value; });
   if (_verbose)
     Logger::debug("Updated Q-value of action " + a->action.print() +
                   " with value " + StringConverter::from(a->value) +
@@ -375,7 +399,7 @@ SK_LRTDP_SOLVER_CLASS::pick_next_state(ActionNode *a) {
   StateNode *s = nullptr;
   _execution_policy.protect(
       [&a, &s, this]() {
-        s = std::get<2>(a->outcomes[a->dist(*_gen)]);
+        s = a->outcomes.node(a->dist(*_gen));
         if (_verbose)
           Logger::debug("Picked next state " + s->state.print() +
                         " from action " + a->action.print() +
@@ -436,8 +460,7 @@ bool SK_LRTDP_SOLVER_CLASS::check_solved(StateNode *s,
 
           ActionNode *a = cs->best_action; // best action updated when calling
                                            // residual(cs, thread_id)
-          for (const auto &o : a->outcomes) {
-            StateNode *ns = std::get<2>(o);
+          for (const auto &ns : a->outcomes.nodes()) {
             if (!(ns->solved) && (visited.find(ns) == visited.end())) {
               open.push(ns);
             }
@@ -515,35 +538,9 @@ void SK_LRTDP_SOLVER_CLASS::trial(StateNode *s, const std::size_t *thread_id) {
 }
 
 SK_LRTDP_SOLVER_TEMPLATE_DECL
-void SK_LRTDP_SOLVER_CLASS::compute_reachable_subgraph(
-    StateNode *node, std::unordered_set<StateNode *> &subgraph) {
-  std::unordered_set<StateNode *> frontier;
-  frontier.insert(node);
-  subgraph.insert(node);
-  while (!frontier.empty()) {
-    std::unordered_set<StateNode *> new_frontier;
-    for (auto &n : frontier) {
-      for (auto &action : n->actions) {
-        for (auto &outcome : action->outcomes) {
-          if (subgraph.find(std::get<2>(outcome)) == subgraph.end()) {
-            new_frontier.insert(std::get<2>(outcome));
-            subgraph.insert(std::get<2>(outcome));
-          }
-        }
-      }
-    }
-    frontier = new_frontier;
-  }
-}
-
-SK_LRTDP_SOLVER_TEMPLATE_DECL
-void SK_LRTDP_SOLVER_CLASS::remove_subgraph(
-    std::unordered_set<StateNode *> &root_subgraph,
-    std::unordered_set<StateNode *> &child_subgraph) {
-  for (auto &n : root_subgraph) {
-    if (child_subgraph.find(n) == child_subgraph.end()) {
-      _graph.erase(StateNode(n->state));
-    }
+void SK_LRTDP_SOLVER_CLASS::retain(StateNode &node) {
+  if (_online_node_garbage) {
+    _compactor->retain(node);
   }
 }
 
@@ -578,7 +575,7 @@ SK_LRTDP_SOLVER_TEMPLATE_DECL
 SK_LRTDP_SOLVER_CLASS::StateNode::StateNode(const State &s)
     : state(s), best_action(nullptr),
       best_value(std::numeric_limits<double>::infinity()), goal(false),
-      solved(false) {}
+      solved(false), epoch(0) {}
 
 SK_LRTDP_SOLVER_TEMPLATE_DECL
 const typename SK_LRTDP_SOLVER_CLASS::State &
@@ -598,6 +595,7 @@ SK_LRTDP_SOLVER_TEMPLATE_DECL
 typename SetTypeDeducer<typename SK_LRTDP_SOLVER_CLASS::State>::Set
 SK_LRTDP_SOLVER_CLASS::get_explored_states() const {
   typename SetTypeDeducer<State>::Set explored;
+  auto guard = _compactor->guard();
   for (const auto &sn : _graph) {
     explored.insert(sn.state);
   }
@@ -608,6 +606,7 @@ SK_LRTDP_SOLVER_TEMPLATE_DECL
 typename SetTypeDeducer<typename SK_LRTDP_SOLVER_CLASS::State>::Set
 SK_LRTDP_SOLVER_CLASS::get_solved_states() const {
   typename SetTypeDeducer<State>::Set solved;
+  auto guard = _compactor->guard();
   for (const auto &sn : _graph) {
     if (sn.solved) {
       solved.insert(sn.state);
@@ -650,13 +649,14 @@ SK_LRTASTAR_SOLVER_TEMPLATE_DECL
 std::vector<typename Tdomain::Action>
 SK_LRTASTAR_SOLVER_CLASS::get_plan(const State &s) const {
   std::vector<Action> plan;
+  auto guard = this->_compactor->guard();
   auto si = this->_graph.find(s);
   while (si != this->_graph.end() && si->best_action != nullptr) {
     plan.push_back(si->best_action->action);
     if (si->best_action->outcomes.empty()) {
       break;
     }
-    auto *next = std::get<2>(si->best_action->outcomes.front());
+    auto *next = si->best_action->outcomes.node(0);
     if (next->goal) {
       break;
     }
@@ -17,8 +17,12 @@
 #include <random>
 
 #include "utils/associative_container_deducer.hh"
+#include "utils/concurrent_set.hh"
 #include "utils/string_converter.hh"
 #include "utils/execution.hh"
+#include "utils/graph_compactor.hh"
+#include "utils/node_arena.hh"
+#include "utils/outcome_arrays.hh"
 #include "utils/logging.hh"
 #include "hub/solver/inner_solver/inner_solver_traits.hh"
 
@@ -83,7 +87,9 @@ public:
    * @param discount Value function's discount factor
    * @param online_node_garbage Boolean indicating whether the search graph
    * which is no more reachable from the root solving state should be
-   * deleted (true) or not (false)
+   * deleted (true) or not (false); the unreachable nodes are reclaimed
+   * incrementally during the next search (in the background with parallel
+   * execution policies) instead of when getting the best action
    * @param callback Functor called at the end of each LRTDP trial (rollout),
    * taking as arguments the solver, the domain and the thread ID from which it
    * is called, and returning true if the solver must be stopped
@@ -250,20 +256,22 @@ protected:
   std::unique_ptr<std::mt19937> _gen;
   typename ExecutionPolicy::Mutex _gen_mutex;
   typename ExecutionPolicy::Mutex _time_mutex;
-  typename ExecutionPolicy::Mutex _residuals_protect;
+  typename ExecutionPolicy::SpinMutex _residuals_protect;
 
   atomic_double _residual_moving_average;
   std::list<double> _residuals;
 
   struct ActionNode;
+  typedef NodeArena<ActionNode, ExecutionPolicy> ActionArena;
 
   struct StateNode {
     State state;
-    std::list<std::unique_ptr<ActionNode>> actions;
+    std::list<typename ActionArena::Pointer> actions;
     ActionNode *best_action;
     atomic_double best_value;
     atomic_double goal;
     atomic_bool solved;
+    atomic_size_t epoch; // root epoch of the node's last retention
     typename ExecutionPolicy::Mutex mutex;
 
     StateNode(const State &s);
@@ -275,17 +283,21 @@ protected:
 
   struct ActionNode {
     Action action;
-    std::vector<std::tuple<double, double, StateNode *>>
-        outcomes; // next state nodes owned by _graph
+    OutcomeArray<StateNode> outcomes; // next state nodes owned by _graph
     std::discrete_distribution<> dist;
     atomic_double value;
 
     ActionNode(const Action &a);
   };
 
-  typedef typename SetTypeDeducer<StateNode, State>::Set Graph;
+  typedef typename ConcurrentSetTypeDeducer<
+      StateNode, State, ExecutionPolicy, NodeArenaAllocator<StateNode>>::Set
+      Graph;
+  typedef GraphCompactor<ExecutionPolicy, StateNode> Compactor;
+  ActionArena _action_arena; // must outlive the graph
   Graph _graph;
   StateNode *_current_state;
+  std::unique_ptr<Compactor> _compactor;
   atomic_size_t _nb_rollouts;
   std::chrono::time_point<std::chrono::high_resolution_clock> _start_time;
 
@@ -297,10 +309,7 @@ protected:
   double residual(StateNode *s, const std::size_t *thread_id);
   bool check_solved(StateNode *s, const std::size_t *thread_id);
   void trial(StateNode *s, const std::size_t *thread_id);
-  void compute_reachable_subgraph(StateNode *node,
-                                  std::unordered_set<StateNode *> &subgraph);
-  void remove_subgraph(std::unordered_set<StateNode *> &root_subgraph,
-                       std::unordered_set<StateNode *> &child_subgraph);
+  void retain(StateNode &node);
   void update_residual_moving_average(const StateNode &node,
                                       const double &node_record_value);
 };
@@ -22,10 +22,36 @@ SK_MCTS_DEFAULT_ROLLOUT_POLICY_CLASS::DefaultRolloutPolicy(
     const PolicyFunctor &policy)
     : _policy(policy) {}
 
+SK_MCTS_DEFAULT_ROLLOUT_POLICY_TEMPLATE_DECL
+typename SK_MCTS_DEFAULT_ROLLOUT_POLICY_CLASS::PolicyFunctor
+SK_MCTS_DEFAULT_ROLLOUT_POLICY_CLASS::random_policy() {
+  return [](typename Tsolver::Domain &domain,
+            const typename Tsolver::Domain::State &state,
+            const std::size_t *thread_id) {
+    return domain.get_applicable_actions(state, thread_id).sample();
+  };
+}
+
 SK_MCTS_DEFAULT_ROLLOUT_POLICY_TEMPLATE_DECL
 void SK_MCTS_DEFAULT_ROLLOUT_POLICY_CLASS::operator()(
     Tsolver &solver, const std::size_t *thread_id,
     typename Tsolver::StateNode &n, std::size_t d) const {
+  double reward = simulate(solver, thread_id, n, d);
+  // since we can come to state n after exhausting the depth, n might be
+  // already visited so don't erase its value but rather update it
+  update_running_mean(n.visits_count, n.value, reward);
+}
+
+SK_MCTS_DEFAULT_ROLLOUT_POLICY_TEMPLATE_DECL
+std::size_t SK_MCTS_DEFAULT_ROLLOUT_POLICY_CLASS::lanes_per_leaf(
+    std::size_t nb_lanes) const {
+  return 1;
+}
+
+SK_MCTS_DEFAULT_ROLLOUT_POLICY_TEMPLATE_DECL
+double SK_MCTS_DEFAULT_ROLLOUT_POLICY_CLASS::simulate(
+    Tsolver &solver, const std::size_t *thread_id,
+    typename Tsolver::StateNode &n, std::size_t d) const {
   try {
     typename Tsolver::Domain::State current_state;
     bool termination;
@@ -65,15 +91,7 @@ void SK_MCTS_DEFAULT_ROLLOUT_POLICY_CLASS::operator()(
       }
     }
 
-    // since we can come to state n after exhausting the depth, n might be
-    // already visited so don't erase its value but rather update it
-    solver.execution_policy().protect(
-        [&n, &reward]() {
-          n.value = ((n.visits_count * n.value) + reward) /
-                    ((double)(n.visits_count + 1));
-          n.visits_count += 1;
-        },
-        n.mutex);
+    return reward;
   } catch (const std::exception &e) {
     solver.execution_policy().protect(
         [&n, &e]() {
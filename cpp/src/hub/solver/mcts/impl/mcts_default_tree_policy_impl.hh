@@ -17,6 +17,26 @@ namespace skdecide {
 
 #define SK_MCTS_DEFAULT_TREE_POLICY_CLASS DefaultTreePolicy<Tsolver>
 
+SK_MCTS_DEFAULT_TREE_POLICY_TEMPLATE_DECL
+SK_MCTS_DEFAULT_TREE_POLICY_CLASS::DefaultTreePolicy(double virtual_loss)
+    : _virtual_loss(virtual_loss) {}
+
+SK_MCTS_DEFAULT_TREE_POLICY_TEMPLATE_DECL
+SK_MCTS_DEFAULT_TREE_POLICY_CLASS::DefaultTreePolicy(
+    const DefaultTreePolicy &other)
+    : _virtual_loss((double)other._virtual_loss) {}
+
+SK_MCTS_DEFAULT_TREE_POLICY_TEMPLATE_DECL
+double SK_MCTS_DEFAULT_TREE_POLICY_CLASS::virtual_loss() const {
+  return _virtual_loss;
+}
+
+SK_MCTS_DEFAULT_TREE_POLICY_TEMPLATE_DECL
+std::size_t
+SK_MCTS_DEFAULT_TREE_POLICY_CLASS::nb_trees(std::size_t nb_lanes) const {
+  return 1;
+}
+
 SK_MCTS_DEFAULT_TREE_POLICY_TEMPLATE_DECL
 typename Tsolver::StateNode *SK_MCTS_DEFAULT_TREE_POLICY_CLASS::operator()(
     Tsolver &solver,
@@ -37,6 +57,9 @@ typename Tsolver::StateNode *SK_MCTS_DEFAULT_TREE_POLICY_CLASS::operator()(
 
     solver.transition_mode().init_rollout(solver, thread_id);
     typename Tsolver::StateNode *current_node = &n;
+    double virtual_loss = _virtual_loss;
+    typename Tsolver::VirtualLossPath &path =
+        solver.virtual_loss_path(thread_id);
 
     while (!(current_node->terminal) && d < solver.max_depth()) {
       typename Tsolver::StateNode *next_node =
@@ -57,6 +80,14 @@ typename Tsolver::StateNode *SK_MCTS_DEFAULT_TREE_POLICY_CLASS::operator()(
           // mode.
           break;
         } else {
+          if (virtual_loss > 0.0) {
+            // Reverted by the back-propagator once the trajectory is finished
+            action->virtual_visits_count += 1;
+            atomic_add(action->virtual_loss, virtual_loss);
+            current_node->virtual_visits_count += 1;
+            path.emplace_back(action, virtual_loss);
+          }
+
           next_node = solver.transition_mode().random_next_node(
               solver, thread_id, *action);
 
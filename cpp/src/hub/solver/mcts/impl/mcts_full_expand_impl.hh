@@ -49,15 +49,14 @@ struct FullExpand<Tsolver>::ExpandActionImplementation::Impl<
       std::vector<double> outcome_weights;
 
       for (auto ns : next_states) {
-        std::pair<typename Tsolver::Graph::iterator, bool> i;
-
-        solver.execution_policy().protect(
-            [&i, &solver, &ns]() { i = solver.graph().emplace(ns.state()); });
+        std::pair<typename Tsolver::Graph::iterator, bool> i =
+            solver.graph(thread_id).emplace(ns.state());
 
         typename Tsolver::StateNode &next_node =
             const_cast<typename Tsolver::StateNode &>(
                 *(i.first)); // we won't change the real key (StateNode::state)
                              // so we are safe
+        solver.retain(next_node, thread_id);
         double reward = 0.0;
 
         solver.execution_policy().protect(
@@ -139,10 +138,10 @@ struct FullExpand<Tsolver>::ExpandActionImplementation::Impl<
         std::size_t outcome_id = 0;
 
         solver.execution_policy().protect(
-            [&outcome_id, &action, &solver]() {
-              outcome_id = action.dist(solver.gen());
+            [&outcome_id, &action, &solver, &thread_id]() {
+              outcome_id = action.dist(solver.gen(thread_id));
             },
-            solver.gen_mutex());
+            solver.gen_mutex(thread_id));
 
         typename Tsolver::StateNode *outcome = nullptr;
 
@@ -159,10 +158,10 @@ struct FullExpand<Tsolver>::ExpandActionImplementation::Impl<
         std::size_t outcome_id = 0;
 
         solver.execution_policy().protect(
-            [&outcome_id, &odist, &solver]() {
-              outcome_id = odist(solver.gen());
+            [&outcome_id, &odist, &solver, &thread_id]() {
+              outcome_id = odist(solver.gen(thread_id));
             },
-            solver.gen_mutex());
+            solver.gen_mutex(thread_id));
 
         return untried_outcomes[outcome_id];
       }
@@ -212,16 +211,14 @@ struct FullExpand<Tsolver>::ExpandActionImplementation::Impl<
       typename Tsolver::Domain::EnvironmentOutcome to =
           solver.transition_mode().random_next_outcome(
               solver, thread_id, state.state, action.action);
-      std::pair<typename Tsolver::Graph::iterator, bool> i;
-
-      solver.execution_policy().protect([&i, &solver, &to]() {
-        i = solver.graph().emplace(to.observation());
-      });
+      std::pair<typename Tsolver::Graph::iterator, bool> i =
+          solver.graph(thread_id).emplace(to.observation());
 
       typename Tsolver::StateNode &next_node =
           const_cast<typename Tsolver::StateNode &>(
               *(i.first)); // we won't change the real key (StateNode::state) so
                            // we are safe
+      solver.retain(next_node, thread_id);
 
       solver.execution_policy().protect(
           [&action, &next_node, &to]() {
@@ -397,10 +394,10 @@ SK_MCTS_FULL_EXPAND_CLASS::operator()(Tsolver &solver,
       std::discrete_distribution<> odist(weights.begin(), weights.end());
       std::size_t outcome_id = 0;
       solver.execution_policy().protect(
-          [&outcome_id, &odist, &solver]() {
-            outcome_id = odist(solver.gen());
+          [&outcome_id, &odist, &solver, &thread_id]() {
+            outcome_id = odist(solver.gen(thread_id));
           },
-          solver.gen_mutex());
+          solver.gen_mutex(thread_id));
       auto &uo = untried_outcomes[outcome_id];
 
       if (uo.second == nullptr) { // unexpanded action
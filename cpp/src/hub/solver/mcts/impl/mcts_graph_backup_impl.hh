@@ -31,15 +31,10 @@ struct GraphBackup<Tsolver>::UpdateFrontierImplementation {
       for (auto &a : f->parents) {
         double q_value =
             a->outcomes[f].first + (solver.discount() * (f->value));
-        a->value = (((a->visits_count) * (a->value)) + q_value) /
-                   ((double)(a->visits_count + 1));
-        a->visits_count += 1;
+        update_running_mean(a->visits_count, a->value, q_value);
         typename Tsolver::StateNode *parent_node = a->parent;
-        parent_node->value =
-            (((parent_node->visits_count) * (parent_node->value)) +
-             (a->value)) /
-            ((double)(parent_node->visits_count + 1));
-        parent_node->visits_count += 1;
+        update_running_mean(parent_node->visits_count, parent_node->value,
+                            a->value);
         new_frontier.insert(parent_node);
         if (solver.verbose()) {
           Logger::debug(
@@ -54,8 +49,8 @@ struct GraphBackup<Tsolver>::UpdateFrontierImplementation {
 
   template <typename Texecution_policy>
   struct Impl<Texecution_policy,
-              typename std::enable_if<std::is_same<
-                  Texecution_policy, ParallelExecution>::value>::type> {
+              typename std::enable_if<!std::is_same<
+                  Texecution_policy, SequentialExecution>::value>::type> {
 
     static void update_frontier(
         Tsolver &solver,
@@ -69,30 +64,29 @@ struct GraphBackup<Tsolver>::UpdateFrontierImplementation {
           },
           f->mutex);
       for (auto &a : parents) {
-        solver.execution_policy().protect(
-            [&a, &solver, &f, &new_frontier]() {
-              double q_value =
-                  a->outcomes[f].first + (solver.discount() * (f->value));
-              a->value = (((a->visits_count) * (a->value)) + q_value) /
-                         ((double)(a->visits_count + 1));
-              a->visits_count += 1;
-              typename Tsolver::StateNode *parent_node = a->parent;
-              parent_node->value =
-                  (((parent_node->visits_count) * (parent_node->value)) +
-                   (a->value)) /
-                  ((double)(parent_node->visits_count + 1));
-              parent_node->visits_count += 1;
-              new_frontier.insert(parent_node);
-              if (solver.verbose()) {
+        // The outcomes map is modified by the expanders under the parent's
+        // mutex, but the value statistics are updated without any lock
+        double reward = solver.execution_policy().protect(
+            [&a, &f]() { return a->outcomes.find(f)->second.first; },
+            a->parent->mutex);
+        double q_value = reward + (solver.discount() * (f->value));
+        update_running_mean(a->visits_count, a->value, q_value);
+        typename Tsolver::StateNode *parent_node = a->parent;
+        update_running_mean(parent_node->visits_count, parent_node->value,
+                            a->value);
+        new_frontier.insert(parent_node);
+        if (solver.verbose()) {
+          solver.execution_policy().protect(
+              [&parent_node]() {
                 Logger::debug(
                     "Updating state " + parent_node->state.print() +
                     ": value=" + StringConverter::from(parent_node->value) +
                     ", visits=" +
                     StringConverter::from(parent_node->visits_count) +
                     Tsolver::ExecutionPolicy::print_thread());
-              }
-            },
-            a->parent->mutex);
+              },
+              parent_node->mutex);
+        }
       }
     }
   };
@@ -130,6 +124,14 @@ void SK_MCTS_GRAPH_BACKUP_CLASS::operator()(
 
     frontier = new_frontier;
   }
+
+  typename Tsolver::VirtualLossPath &path = solver.virtual_loss_path(thread_id);
+  for (auto &vl : path) {
+    vl.first->virtual_visits_count -= 1;
+    atomic_add(vl.first->virtual_loss, -vl.second);
+    vl.first->parent->virtual_visits_count -= 1;
+  }
+  path.clear();
 }
 
 SK_MCTS_GRAPH_BACKUP_TEMPLATE_DECL
@@ -5,11 +5,12 @@
 #ifndef SKDECIDE_MCTS_IMPL_HH
 #define SKDECIDE_MCTS_IMPL_HH
 
-#include <boost/range/irange.hpp>
+#include <algorithm>
 #include <iostream>
 
 #include "utils/string_converter.hh"
 #include "utils/execution.hh"
+#include "utils/rollout_lanes.hh"
 #include "utils/logging.hh"
 
 namespace skdecide {
@@ -34,14 +35,16 @@ namespace skdecide {
 SK_MCTS_SOLVER_TEMPLATE_DECL
 SK_MCTS_SOLVER_CLASS::ActionNode::ActionNode(const Action &a)
     : action(a), expansions_count(0), value(0.0), visits_count(0),
-      parent(nullptr) {}
+      virtual_visits_count(0), virtual_loss(0.0), parent(nullptr) {}
 
 SK_MCTS_SOLVER_TEMPLATE_DECL
 SK_MCTS_SOLVER_CLASS::ActionNode::ActionNode(const ActionNode &a)
     : action(a.action), outcomes(a.outcomes),
       dist_to_outcome(a.dist_to_outcome), dist(a.dist),
       expansions_count((std::size_t)a.expansions_count), value((double)a.value),
-      visits_count((std::size_t)a.visits_count), parent(a.parent) {}
+      visits_count((std::size_t)a.visits_count),
+      virtual_visits_count((std::size_t)a.virtual_visits_count),
+      virtual_loss((double)a.virtual_loss), parent(a.parent) {}
 
 SK_MCTS_SOLVER_TEMPLATE_DECL
 const typename SK_MCTS_SOLVER_CLASS::Action &
@@ -52,14 +55,15 @@ SK_MCTS_SOLVER_CLASS::ActionNode::Key::operator()(const ActionNode &an) const {
 SK_MCTS_SOLVER_TEMPLATE_DECL
 SK_MCTS_SOLVER_CLASS::StateNode::StateNode(const State &s)
     : state(s), terminal(false), expanded(false), expansions_count(0),
-      value(0.0), visits_count(0) {}
+      value(0.0), visits_count(0), virtual_visits_count(0), epoch(0) {}
 
 SK_MCTS_SOLVER_TEMPLATE_DECL
 SK_MCTS_SOLVER_CLASS::StateNode::StateNode(const StateNode &s)
     : state(s.state), terminal((bool)s.terminal), expanded((bool)s.expanded),
       expansions_count((std::size_t)s.expansions_count), actions(s.actions),
       value((double)s.value), visits_count((std::size_t)s.visits_count),
-      parents(s.parents) {}
+      virtual_visits_count((std::size_t)s.virtual_visits_count),
+      epoch((std::size_t)s.epoch), parents(s.parents) {}
 
 SK_MCTS_SOLVER_TEMPLATE_DECL
 const typename SK_MCTS_SOLVER_CLASS::State &
@@ -89,19 +93,60 @@ SK_MCTS_SOLVER_CLASS::MCTSSolver(
       _action_selector_optimization(std::move(action_selector_optimization)),
       _action_selector_execution(std::move(action_selector_execution)),
       _rollout_policy(std::move(rollout_policy)),
-      _back_propagator(std::move(back_propagator)), _current_state(nullptr),
-      _residual_moving_average(0) {
+      _back_propagator(std::move(back_propagator)),
+      _lanes_per_leaf(std::max<std::size_t>(
+          1, _rollout_policy->lanes_per_leaf(domain.get_parallel_capacity()))),
+      _graphs(std::max<std::size_t>(
+          1, _tree_policy->nb_trees(domain.get_parallel_capacity() /
+                                    _lanes_per_leaf))),
+      _current_states(_graphs.size(), nullptr),
+      _gen_mutexes(_graphs.size()), _residual_moving_average(0) {
 
   if (verbose) {
     Logger::check_level(logging::debug, "algorithm MCTS");
   }
 
   std::random_device rd;
-  _gen = std::make_unique<std::mt19937>(rd());
+  for (std::size_t t = 0; t < _graphs.size(); t++) {
+    _gens.emplace_back(rd());
+    Graph &graph = _graphs[t];
+    _compactors.push_back(std::make_unique<Compactor>(
+        [this](StateNode &n, std::vector<StateNode *> &children) {
+          _execution_policy->protect(
+              [&n, &children]() {
+                for (const auto &action : n.actions) {
+                  for (const auto &outcome : action.outcomes) {
+                    children.push_back(outcome.first);
+                  }
+                }
+              },
+              n.mutex);
+        },
+        [&graph](StateNode &n,
+                 const std::function<bool(StateNode *)> &alive) {
+          for (auto &action : n.actions) {
+            for (auto &outcome : action.outcomes) {
+              if (alive(outcome.first)) {
+                // we won't change the real key (ActionNode::action) so we are
+                // safe
+                outcome.first->parents.erase(
+                    &const_cast<ActionNode &>(action));
+              }
+            }
+          }
+          graph.erase(StateNode(n.state));
+        }));
+  }
 }
 
 SK_MCTS_SOLVER_TEMPLATE_DECL
-void SK_MCTS_SOLVER_CLASS::clear() { _graph.clear(); }
+void SK_MCTS_SOLVER_CLASS::clear() {
+  for (std::size_t t = 0; t < _graphs.size(); t++) {
+    _compactors[t]->cancel();
+    _graphs[t].clear();
+    _current_states[t] = nullptr;
+  }
+}
 
 SK_MCTS_SOLVER_TEMPLATE_DECL
 void SK_MCTS_SOLVER_CLASS::solve(const State &s) {
@@ -113,29 +158,46 @@ void SK_MCTS_SOLVER_CLASS::solve(const State &s) {
     _residual_moving_average = 0.0;
     _residuals.clear();
 
-    // Get the root node
-    auto si = _graph.emplace(s);
-    StateNode &root_node = const_cast<StateNode &>(
-        *(si.first)); // we won't change the real key (StateNode::state) so we
-                      // are safe
-
-    boost::integer_range<std::size_t> parallel_rollouts(
-        0, _domain.get_parallel_capacity());
+    // Get the root node of each tree
+    std::vector<StateNode *> root_nodes;
+    for (auto &g : _graphs) {
+      auto si = g.emplace(s);
+      root_nodes.push_back(const_cast<StateNode *>(
+          &(*(si.first)))); // we won't change the real key (StateNode::state)
+                            // so we are safe
+      if (_online_node_garbage) {
+        _compactors[root_nodes.size() - 1]->retain(*root_nodes.back());
+      }
+    }
 
-    std::for_each(
-        ExecutionPolicy::policy, parallel_rollouts.begin(),
-        parallel_rollouts.end(),
-        [this, &root_node](const std::size_t &thread_id) {
+    _virtual_loss_paths.clear();
+    _virtual_loss_paths.resize(std::max<std::size_t>(
+        std::size_t(1), _domain.get_parallel_capacity()));
+
+    // Each tree lane uses _lanes_per_leaf consecutive domain lanes, the first
+    // of which is its thread ID
+    for_each_rollout_lane<ExecutionPolicy>(
+        _domain.get_parallel_capacity() / _lanes_per_leaf,
+        [this, &root_nodes](const std::size_t &lane) {
+          const std::size_t thread_id = lane * _lanes_per_leaf;
+          StateNode &root_node = *(root_nodes[tree_index(&thread_id)]);
+          Compactor &compactor = *(_compactors[tree_index(&thread_id)]);
           do {
-            std::size_t depth = 0;
-            double root_node_record_value = root_node.value;
-            StateNode *sn = (*_tree_policy)(*this, &thread_id, *_expander,
-                                            *_action_selector_optimization,
-                                            root_node, depth);
-            (*_rollout_policy)(*this, &thread_id, *sn, depth);
-            (*_back_propagator)(*this, &thread_id, *sn);
-            update_residual_moving_average(root_node, root_node_record_value);
-            _nb_rollouts++;
+            {
+              // The compactor can't erase nodes during the rollout
+              auto guard = compactor.guard();
+              std::size_t depth = 0;
+              double root_node_record_value = root_node.value;
+              StateNode *sn = (*_tree_policy)(*this, &thread_id, *_expander,
+                                              *_action_selector_optimization,
+                                              root_node, depth);
+              (*_rollout_policy)(*this, &thread_id, *sn, depth);
+              (*_back_propagator)(*this, &thread_id, *sn);
+              update_residual_moving_average(root_node,
+                                             root_node_record_value);
+              _nb_rollouts++;
+            }
+            compactor.step();
           } while (!_callback(*this, _domain, &thread_id) &&
                    (get_solving_time() < _time_budget) &&
                    (_nb_rollouts < _rollout_budget) &&
@@ -156,12 +218,15 @@ void SK_MCTS_SOLVER_CLASS::solve(const State &s) {
 SK_MCTS_SOLVER_TEMPLATE_DECL
 bool SK_MCTS_SOLVER_CLASS::is_solution_defined_for(const State &s) {
   bool res;
-  _execution_policy->protect([this, &s, &res]() {
-    auto si = _graph.find(s);
-    if (si == _graph.end()) {
+  std::unique_ptr<StateNode> merged;
+  // The guards are always taken before the protection, as in the rollouts
+  auto guards = guard_graphs();
+  _execution_policy->protect([this, &s, &res, &merged]() {
+    const StateNode *node = find_node(s, merged);
+    if (node == nullptr) {
       res = false;
     } else {
-      res = (*_action_selector_execution)(*this, nullptr, *si) != nullptr;
+      res = (*_action_selector_execution)(*this, nullptr, *node) != nullptr;
     }
   });
   return res;
@@ -171,10 +236,16 @@ SK_MCTS_SOLVER_TEMPLATE_DECL
 typename SK_MCTS_SOLVER_CLASS::Action
 SK_MCTS_SOLVER_CLASS::get_best_action(const State &s) {
   ActionNode *action = nullptr;
-  _execution_policy->protect([this, &s, &action]() {
-    auto si = _graph.find(s);
-    if (si != _graph.end()) {
-      action = (*_action_selector_execution)(*this, nullptr, *si);
+  std::unique_ptr<StateNode> merged;
+  // Joins the compactions outside the protection since the compactions can
+  // wait for guarded threads which wait for the protection
+  for (auto &c : _compactors) {
+    c->finish(); // usually already completed during the search
+  }
+  _execution_policy->protect([this, &s, &action, &merged]() {
+    const StateNode *node = find_node(s, merged);
+    if (node != nullptr) {
+      action = (*_action_selector_execution)(*this, nullptr, *node);
     }
     if (action != nullptr) {
       if (_verbose) {
@@ -185,18 +256,20 @@ SK_MCTS_SOLVER_CLASS::get_best_action(const State &s) {
         str += "\n)";
         Logger::debug("Best action's known outcomes:\n" + str);
       }
-      if (_online_node_garbage && _current_state) {
-        std::unordered_set<StateNode *> root_subgraph, child_subgraph;
-        compute_reachable_subgraph(_current_state, root_subgraph);
-        compute_reachable_subgraph(
-            const_cast<StateNode *>(&(*si)),
-            child_subgraph); // we won't change the real key (StateNode::state)
-                             // so we are safe
-        remove_subgraph(root_subgraph, child_subgraph);
+      for (std::size_t t = 0; t < _graphs.size(); t++) {
+        auto si = _graphs[t].find(s);
+        if (si == _graphs[t].end()) {
+          continue;
+        }
+        // we won't change the real key (StateNode::state) so we are safe
+        StateNode *child = const_cast<StateNode *>(&(*si));
+        if (_online_node_garbage) {
+          // The nodes which are no more reachable are reclaimed during the
+          // next search
+          _compactors[t]->retire(_current_states[t], *child);
+        }
+        _current_states[t] = child;
       }
-      _current_state =
-          const_cast<StateNode *>(&(*si)); // we won't change the real key
-                                           // (StateNode::state) so we are safe
       _action_prefix.push_back(action->action);
     }
   });
@@ -212,28 +285,41 @@ SK_MCTS_SOLVER_CLASS::get_best_action(const State &s) {
 SK_MCTS_SOLVER_TEMPLATE_DECL
 typename SK_MCTS_SOLVER_CLASS::Value
 SK_MCTS_SOLVER_CLASS::get_best_value(const State &s) {
-  ActionNode *action = nullptr;
-  _execution_policy->protect([this, &s, &action]() {
-    auto si = _graph.find(StateNode(s));
-    if (si != _graph.end()) {
-      action = (*_action_selector_execution)(*this, nullptr, *si);
+  bool found = false;
+  double value = 0.0;
+  auto guards = guard_graphs();
+  _execution_policy->protect([this, &s, &found, &value]() {
+    std::unique_ptr<StateNode> merged;
+    const StateNode *node = find_node(s, merged);
+    if (node != nullptr) {
+      ActionNode *action =
+          (*_action_selector_execution)(*this, nullptr, *node);
+      if (action != nullptr) {
+        found = true;
+        value = action->value;
+      }
     }
   });
-  if (action == nullptr) {
+  if (!found) {
     Logger::error("SKDECIDE exception: no best action found in state " +
                   s.print());
     throw std::runtime_error(
         "SKDECIDE exception: no best action found in state " + s.print());
   }
   Value val;
-  val.reward(action->value);
+  val.reward(value);
   return val;
 }
 
 SK_MCTS_SOLVER_TEMPLATE_DECL
 std::size_t SK_MCTS_SOLVER_CLASS::get_nb_explored_states() {
   std::size_t sz = 0;
-  _execution_policy->protect([this, &sz]() { sz = _graph.size(); });
+  auto guards = guard_graphs();
+  _execution_policy->protect([this, &sz]() {
+    for (auto &g : _graphs) {
+      sz += g.size();
+    }
+  });
   return sz;
 }
 
@@ -277,13 +363,24 @@ typename MapTypeDeducer<typename SK_MCTS_SOLVER_CLASS::State,
                                   typename SK_MCTS_SOLVER_CLASS::Value>>::Map
 SK_MCTS_SOLVER_CLASS::get_policy() {
   typename MapTypeDeducer<State, std::pair<Action, Value>>::Map p;
+  auto guards = guard_graphs();
   _execution_policy->protect([this, &p]() {
-    for (auto &n : _graph) {
-      ActionNode *action = (*_action_selector_execution)(*this, nullptr, n);
-      if (action != nullptr) {
-        Value val;
-        val.reward(action->value);
-        p.insert(std::make_pair(n.state, std::make_pair(action->action, val)));
+    for (auto &g : _graphs) {
+      for (auto &n : g) {
+        if (_graphs.size() > 1 && p.find(n.state) != p.end()) {
+          continue; // already merged from a previous tree
+        }
+        std::unique_ptr<StateNode> merged;
+        const StateNode *node =
+            (_graphs.size() == 1) ? &n : find_node(n.state, merged);
+        ActionNode *action =
+            (*_action_selector_execution)(*this, nullptr, *node);
+        if (action != nullptr) {
+          Value val;
+          val.reward(action->value);
+          p.insert(
+              std::make_pair(n.state, std::make_pair(action->action, val)));
+        }
       }
     }
   });
@@ -358,8 +455,23 @@ SK_MCTS_SOLVER_CLASS::back_propagator() {
 }
 
 SK_MCTS_SOLVER_TEMPLATE_DECL
-typename SK_MCTS_SOLVER_CLASS::Graph &SK_MCTS_SOLVER_CLASS::graph() {
-  return _graph;
+typename SK_MCTS_SOLVER_CLASS::Graph &
+SK_MCTS_SOLVER_CLASS::graph(const std::size_t *thread_id) {
+  return _graphs[tree_index(thread_id)];
+}
+
+SK_MCTS_SOLVER_TEMPLATE_DECL
+typename SK_MCTS_SOLVER_CLASS::VirtualLossPath &
+SK_MCTS_SOLVER_CLASS::virtual_loss_path(const std::size_t *thread_id) {
+  return _virtual_loss_paths[(thread_id != nullptr) ? (*thread_id) : 0];
+}
+
+SK_MCTS_SOLVER_TEMPLATE_DECL
+void SK_MCTS_SOLVER_CLASS::retain(StateNode &node,
+                                  const std::size_t *thread_id) {
+  if (_online_node_garbage) {
+    _compactors[tree_index(thread_id)]->retain(node);
+  }
 }
 
 SK_MCTS_SOLVER_TEMPLATE_DECL
@@ -369,64 +481,80 @@ SK_MCTS_SOLVER_CLASS::action_prefix() const {
 }
 
 SK_MCTS_SOLVER_TEMPLATE_DECL
-std::mt19937 &SK_MCTS_SOLVER_CLASS::gen() { return *_gen; }
+std::mt19937 &SK_MCTS_SOLVER_CLASS::gen(const std::size_t *thread_id) {
+  return _gens[tree_index(thread_id)];
+}
 
 SK_MCTS_SOLVER_TEMPLATE_DECL
 typename SK_MCTS_SOLVER_CLASS::ExecutionPolicy::Mutex &
-SK_MCTS_SOLVER_CLASS::gen_mutex() {
-  return _gen_mutex;
+SK_MCTS_SOLVER_CLASS::gen_mutex(const std::size_t *thread_id) {
+  return _gen_mutexes[tree_index(thread_id)];
 }
 
 SK_MCTS_SOLVER_TEMPLATE_DECL
 bool SK_MCTS_SOLVER_CLASS::verbose() const { return _verbose; }
 
 SK_MCTS_SOLVER_TEMPLATE_DECL
-void SK_MCTS_SOLVER_CLASS::compute_reachable_subgraph(
-    StateNode *node, std::unordered_set<StateNode *> &subgraph) {
-  std::unordered_set<StateNode *> frontier;
-  frontier.insert(node);
-  subgraph.insert(node);
-  while (!frontier.empty()) {
-    std::unordered_set<StateNode *> new_frontier;
-    for (auto &n : frontier) {
-      for (auto &action : n->actions) {
-        for (auto &outcome : action.outcomes) {
-          if (subgraph.find(outcome.first) == subgraph.end()) {
-            new_frontier.insert(outcome.first);
-            subgraph.insert(outcome.first);
-          }
-        }
-      }
-    }
-    frontier = new_frontier;
+std::size_t
+SK_MCTS_SOLVER_CLASS::tree_index(const std::size_t *thread_id) const {
+  if (thread_id == nullptr || _graphs.size() == 1) {
+    return 0;
+  } else {
+    return ((*thread_id) / _lanes_per_leaf) % _graphs.size();
   }
 }
 
 SK_MCTS_SOLVER_TEMPLATE_DECL
-void SK_MCTS_SOLVER_CLASS::remove_subgraph(
-    std::unordered_set<StateNode *> &root_subgraph,
-    std::unordered_set<StateNode *> &child_subgraph) {
-  std::unordered_set<StateNode *> removed_subgraph;
-  // First pass: look for nodes in root_subgraph but not child_subgraph and
-  // remove those nodes from their children's parents Don't actually remove
-  // those nodes in the first pass otherwise some children to remove won't exist
-  // anymore when looking for their parents
-  for (auto &n : root_subgraph) {
-    if (child_subgraph.find(n) == child_subgraph.end()) {
-      for (auto &action : n->actions) {
-        for (auto &outcome : action.outcomes) {
-          // we won't change the real key (ActionNode::action) so we are safe
-          outcome.first->parents.erase(&const_cast<ActionNode &>(action));
-        }
+const typename SK_MCTS_SOLVER_CLASS::StateNode *
+SK_MCTS_SOLVER_CLASS::find_node(const State &s,
+                                std::unique_ptr<StateNode> &merged) {
+  if (_graphs.size() == 1) {
+    auto si = _graphs[0].find(s);
+    return (si != _graphs[0].end()) ? &(*si) : nullptr;
+  }
+
+  // Weighted average of the values by the visits counts
+  auto merge = [](auto &visits_count, auto &value, const std::size_t &count,
+                  const double &v) {
+    if (visits_count + count > 0) {
+      value = ((visits_count * value) + (count * v)) /
+              ((double)(visits_count + count));
+    }
+    visits_count += count;
+  };
+
+  for (auto &g : _graphs) {
+    auto si = g.find(s);
+    if (si == g.end()) {
+      continue;
+    } else if (!merged) {
+      merged = std::make_unique<StateNode>(*si);
+      continue;
+    }
+    merge(merged->visits_count, merged->value, si->visits_count, si->value);
+    for (const auto &a : si->actions) {
+      auto ai = merged->actions.find(ActionNode(a.action));
+      if (ai == merged->actions.end()) {
+        merged->actions.insert(a);
+      } else {
+        // we won't change the real key (ActionNode::action) so we are safe
+        ActionNode &ma = const_cast<ActionNode &>(*ai);
+        merge(ma.visits_count, ma.value, a.visits_count, a.value);
       }
-      removed_subgraph.insert(n);
     }
   }
-  // Second pass: actually remove nodes in root_subgraph but not in
-  // child_subgraph
-  for (auto &n : removed_subgraph) {
-    _graph.erase(StateNode(n->state));
+  return merged.get();
+}
+
+SK_MCTS_SOLVER_TEMPLATE_DECL
+std::vector<typename SK_MCTS_SOLVER_CLASS::Compactor::Guard>
+SK_MCTS_SOLVER_CLASS::guard_graphs() {
+  std::vector<typename Compactor::Guard> guards;
+  guards.reserve(_compactors.size());
+  for (auto &c : _compactors) {
+    guards.push_back(c->guard());
   }
+  return guards;
 }
 
 SK_MCTS_SOLVER_TEMPLATE_DECL
@@ -0,0 +1,174 @@
+/* Copyright (c) AIRBUS and its affiliates.
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#ifndef SKDECIDE_MCTS_LEAF_PARALLEL_ROLLOUT_POLICY_IMPL_HH
+#define SKDECIDE_MCTS_LEAF_PARALLEL_ROLLOUT_POLICY_IMPL_HH
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#include "utils/execution.hh"
+
+#include "mcts_default_rollout_policy_impl.hh"
+
+namespace skdecide {
+
+// === LeafParallelRolloutPolicy implementation ===
+
+#define SK_MCTS_LEAF_PARALLEL_ROLLOUT_POLICY_TEMPLATE_DECL                     \
+  template <typename Tsolver>
+
+#define SK_MCTS_LEAF_PARALLEL_ROLLOUT_POLICY_CLASS                             \
+  LeafParallelRolloutPolicy<Tsolver>
+
+SK_MCTS_LEAF_PARALLEL_ROLLOUT_POLICY_TEMPLATE_DECL
+SK_MCTS_LEAF_PARALLEL_ROLLOUT_POLICY_CLASS::LeafParallelRolloutPolicy(
+    std::size_t nb_rollouts, const PolicyFunctor &policy)
+    : DefaultRolloutPolicy<Tsolver>(policy),
+      _nb_rollouts(std::max<std::size_t>(1, nb_rollouts)) {}
+
+SK_MCTS_LEAF_PARALLEL_ROLLOUT_POLICY_TEMPLATE_DECL
+SK_MCTS_LEAF_PARALLEL_ROLLOUT_POLICY_CLASS::~LeafParallelRolloutPolicy() {
+  for (auto &group : _groups) {
+    if (!group) {
+      continue;
+    }
+    {
+      std::lock_guard<std::mutex> lock(group->mutex);
+      group->stop = true;
+    }
+    group->work_condition.notify_all();
+    for (auto &t : group->threads) {
+      t.join();
+    }
+  }
+}
+
+SK_MCTS_LEAF_PARALLEL_ROLLOUT_POLICY_TEMPLATE_DECL
+void SK_MCTS_LEAF_PARALLEL_ROLLOUT_POLICY_CLASS::operator()(
+    Tsolver &solver, const std::size_t *thread_id,
+    typename Tsolver::StateNode &n, std::size_t d) const {
+  static_assert(!std::is_same<typename Tsolver::TransitionMode,
+                              StepTransitionMode<Tsolver>>::value,
+                "Leaf parallelization cannot simulate trajectories from the "
+                "leaf node on the domain lanes which did not reach it");
+
+  // The solver reserved lanes_per_leaf(capacity) consecutive domain lanes for
+  // this tree lane, starting at its thread ID
+  const std::size_t first_lane = (thread_id != nullptr) ? (*thread_id) : 0;
+  const std::size_t capacity = solver.domain().get_parallel_capacity();
+  const std::size_t nb_lanes = lanes_per_leaf(capacity);
+  double reward = 0.0;
+
+  if constexpr (!is_concurrent_execution<
+                    typename Tsolver::ExecutionPolicy>::value) {
+    for (std::size_t lane = 0; lane < nb_lanes; lane++) {
+      const std::size_t tid = first_lane + lane;
+      reward += this->simulate(solver, &tid, n, d);
+    }
+  } else {
+    std::call_once(_groups_flag, [this, &capacity, &nb_lanes]() {
+      _groups.resize(std::max<std::size_t>(1, capacity / nb_lanes));
+    });
+    std::unique_ptr<RolloutGroup> &group_ptr =
+        _groups[(first_lane / nb_lanes) % _groups.size()];
+    if (!group_ptr) { // only this tree lane uses its group
+      group_ptr = std::make_unique<RolloutGroup>();
+      group_ptr->rewards.resize(nb_lanes, 0.0);
+      for (std::size_t lane = 1; lane < nb_lanes; lane++) {
+        group_ptr->threads.emplace_back(
+            [this, &group = *group_ptr, first_lane, lane]() {
+              run_helper(group, first_lane + lane, lane);
+            });
+      }
+    }
+    RolloutGroup &group = *group_ptr;
+
+    {
+      std::lock_guard<std::mutex> lock(group.mutex);
+      group.solver = &solver;
+      group.node = &n;
+      group.depth = d;
+      group.nb_pending = nb_lanes - 1;
+      group.error = nullptr;
+      group.generation++;
+    }
+    group.work_condition.notify_all();
+
+    std::exception_ptr error;
+    try {
+      group.rewards[0] = this->simulate(solver, &first_lane, n, d);
+    } catch (...) {
+      error = std::current_exception();
+    }
+
+    // The helpers must be done with the leaf before returning, even on errors
+    std::unique_lock<std::mutex> lock(group.mutex);
+    group.done_condition.wait(lock,
+                              [&group]() { return group.nb_pending == 0; });
+    if (!error) {
+      error = group.error;
+    }
+    if (error) {
+      std::rethrow_exception(error);
+    }
+    for (const auto &r : group.rewards) {
+      reward += r;
+    }
+  }
+
+  // since we can come to state n after exhausting the depth, n might be
+  // already visited so don't erase its value but rather update it
+  update_running_mean(n.visits_count, n.value, reward / ((double)nb_lanes));
+}
+
+SK_MCTS_LEAF_PARALLEL_ROLLOUT_POLICY_TEMPLATE_DECL
+void SK_MCTS_LEAF_PARALLEL_ROLLOUT_POLICY_CLASS::run_helper(
+    RolloutGroup &group, std::size_t thread_id, std::size_t lane) const {
+  std::size_t generation = 0;
+  while (true) {
+    std::unique_lock<std::mutex> lock(group.mutex);
+    group.work_condition.wait(lock, [&group, &generation]() {
+      return group.stop || group.generation != generation;
+    });
+    if (group.stop) {
+      return;
+    }
+    generation = group.generation;
+    Tsolver &solver = *group.solver;
+    typename Tsolver::StateNode &n = *group.node;
+    std::size_t d = group.depth;
+    lock.unlock();
+
+    double reward = 0.0;
+    std::exception_ptr error;
+    try {
+      reward = this->simulate(solver, &thread_id, n, d);
+    } catch (...) {
+      error = std::current_exception();
+    }
+
+    lock.lock();
+    group.rewards[lane] = reward;
+    if (error && !group.error) {
+      group.error = error;
+    }
+    if (--group.nb_pending == 0) {
+      group.done_condition.notify_one();
+    }
+  }
+}
+
+SK_MCTS_LEAF_PARALLEL_ROLLOUT_POLICY_TEMPLATE_DECL
+std::size_t SK_MCTS_LEAF_PARALLEL_ROLLOUT_POLICY_CLASS::lanes_per_leaf(
+    std::size_t nb_lanes) const {
+  return std::max<std::size_t>(1, std::min(_nb_rollouts, nb_lanes));
+}
+
+} // namespace skdecide
+
+#endif // SKDECIDE_MCTS_LEAF_PARALLEL_ROLLOUT_POLICY_IMPL_HH
@@ -52,10 +52,10 @@ SK_MCTS_PARTIAL_EXPAND_CLASS::operator()(Tsolver &solver,
     bool dist_res = false;
 
     solver.execution_policy().protect(
-        [&dist_res, &solver, &dist_state_expansion]() {
-          dist_res = dist_state_expansion(solver.gen());
+        [&dist_res, &solver, &dist_state_expansion, &thread_id]() {
+          dist_res = dist_state_expansion(solver.gen(thread_id));
         },
-        solver.gen_mutex());
+        solver.gen_mutex(thread_id));
 
     if (dist_res) {
       typename Tsolver::Domain::Action action =
@@ -97,10 +97,10 @@ SK_MCTS_PARTIAL_EXPAND_CLASS::operator()(Tsolver &solver,
       std::size_t action_id = 0;
 
       solver.execution_policy().protect(
-          [&action_id, &solver, &dist_known_actions]() {
-            action_id = dist_known_actions(solver.gen());
+          [&action_id, &solver, &dist_known_actions, &thread_id]() {
+            action_id = dist_known_actions(solver.gen(thread_id));
           },
-          solver.gen_mutex());
+          solver.gen_mutex(thread_id));
 
       action_node = actions[action_id];
       if (solver.verbose()) {
@@ -120,24 +120,22 @@ SK_MCTS_PARTIAL_EXPAND_CLASS::operator()(Tsolver &solver,
     typename Tsolver::StateNode *ns = nullptr;
 
     solver.execution_policy().protect(
-        [&dist_res, &solver, &dist_action_expansion]() {
-          dist_res = dist_action_expansion(solver.gen());
+        [&dist_res, &solver, &dist_action_expansion, &thread_id]() {
+          dist_res = dist_action_expansion(solver.gen(thread_id));
         },
-        solver.gen_mutex());
+        solver.gen_mutex(thread_id));
 
     if (dist_res) {
       typename Tsolver::Domain::EnvironmentOutcome to =
           solver.transition_mode().random_next_outcome(
               solver, thread_id, n.state, action_node->action);
-      std::pair<typename Tsolver::Graph::iterator, bool> s;
-
-      solver.execution_policy().protect([&s, &solver, &to]() {
-        s = solver.graph().emplace(to.observation());
-      });
+      std::pair<typename Tsolver::Graph::iterator, bool> s =
+          solver.graph(thread_id).emplace(to.observation());
 
       ns = &const_cast<typename Tsolver::StateNode &>(
           *(s.first)); // we won't change the real key (StateNode::state) so we
                        // are safe
+      solver.retain(*ns, thread_id);
 
       if (s.second) { // new state
         solver.execution_policy().protect(
@@ -0,0 +1,32 @@
+/* Copyright (c) AIRBUS and its affiliates.
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#ifndef SKDECIDE_MCTS_ROOT_PARALLEL_TREE_POLICY_IMPL_HH
+#define SKDECIDE_MCTS_ROOT_PARALLEL_TREE_POLICY_IMPL_HH
+
+#include "mcts_default_tree_policy_impl.hh"
+
+namespace skdecide {
+
+// === RootParallelTreePolicy implementation ===
+
+#define SK_MCTS_ROOT_PARALLEL_TREE_POLICY_TEMPLATE_DECL                        \
+  template <typename Tsolver>
+
+#define SK_MCTS_ROOT_PARALLEL_TREE_POLICY_CLASS RootParallelTreePolicy<Tsolver>
+
+SK_MCTS_ROOT_PARALLEL_TREE_POLICY_TEMPLATE_DECL
+SK_MCTS_ROOT_PARALLEL_TREE_POLICY_CLASS::RootParallelTreePolicy(
+    double virtual_loss)
+    : DefaultTreePolicy<Tsolver>(virtual_loss) {}
+
+SK_MCTS_ROOT_PARALLEL_TREE_POLICY_TEMPLATE_DECL
+std::size_t
+SK_MCTS_ROOT_PARALLEL_TREE_POLICY_CLASS::nb_trees(std::size_t nb_lanes) const {
+  return nb_lanes;
+}
+
+} // namespace skdecide
+
+#endif // SKDECIDE_MCTS_ROOT_PARALLEL_TREE_POLICY_IMPL_HH
@@ -34,12 +34,13 @@ SK_MCTS_SAMPLE_TRANSITION_MODE_CLASS::random_next_node(
   typename Tsolver::StateNode *n = nullptr;
 
   solver.execution_policy().protect(
-      [&n, &action, &solver]() {
+      [&n, &action, &solver, &thread_id]() {
         solver.execution_policy().protect(
-            [&n, &action, &solver]() {
-              n = action.dist_to_outcome[action.dist(solver.gen())]->first;
+            [&n, &action, &solver, &thread_id]() {
+              n = action.dist_to_outcome[action.dist(solver.gen(thread_id))]
+                      ->first;
             },
-            solver.gen_mutex());
+            solver.gen_mutex(thread_id));
       },
       action.parent->mutex);
 
@@ -41,15 +41,19 @@ SK_MCTS_STEP_TRANSITION_MODE_CLASS::random_next_node(
   auto outcome = solver.domain().step(action.action, thread_id);
   typename Tsolver::StateNode *n = nullptr;
 
-  solver.execution_policy().protect([&n, &solver, &outcome]() {
-    auto si =
-        solver.graph().find(typename Tsolver::StateNode(outcome.observation()));
-    if (si != solver.graph().end()) {
+  solver.execution_policy().protect([&n, &solver, &outcome, &thread_id]() {
+    auto si = solver.graph(thread_id).find(
+        typename Tsolver::StateNode(outcome.observation()));
+    if (si != solver.graph(thread_id).end()) {
       // we won't change the real key (ActionNode::action) so we are safe
       n = &const_cast<typename Tsolver::StateNode &>(*si);
     }
   });
 
+  if (n != nullptr) {
+    solver.retain(*n, thread_id);
+  }
+
   return n;
 }
 
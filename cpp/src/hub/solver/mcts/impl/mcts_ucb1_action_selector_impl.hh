@@ -35,12 +35,22 @@ typename Tsolver::ActionNode *SK_MCTS_UCB1_ACTION_SELECTOR_CLASS::operator()(
 
   solver.execution_policy().protect(
       [this, &n, &best_value, &best_action, &solver]() {
+        // Virtual visits of the trajectories being simulated by concurrent
+        // threads count as visits whose value is penalized by the virtual loss
+        double n_visits = (double)(n.visits_count + n.virtual_visits_count);
         for (const auto &a : n.actions) {
           if (a.visits_count > 0) {
+            double a_visits = (double)a.visits_count;
+            double a_value = a.value;
+            std::size_t a_virtual_visits = a.virtual_visits_count;
+            if (a_virtual_visits > 0) {
+              a_value = ((a_visits * a_value) - a.virtual_loss) /
+                        (a_visits + a_virtual_visits);
+              a_visits += a_virtual_visits;
+            }
             double tentative_value =
-                a.value + (2.0 * _ucb_constant *
-                           std::sqrt((2.0 * std::log((double)n.visits_count)) /
-                                     ((double)a.visits_count)));
+                a_value + (2.0 * _ucb_constant *
+                           std::sqrt((2.0 * std::log(n_visits)) / a_visits));
 
             if (tentative_value > best_value) {
               best_value = tentative_value;
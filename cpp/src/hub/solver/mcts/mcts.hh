@@ -23,9 +23,16 @@
 #include <list>
 #include <chrono>
 #include <random>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <exception>
 
 #include "utils/associative_container_deducer.hh"
+#include "utils/concurrent_set.hh"
 #include "utils/execution.hh"
+#include "utils/graph_compactor.hh"
+#include "utils/node_arena.hh"
 
 namespace skdecide {
 
@@ -71,15 +78,45 @@ template <typename Tsolver> struct DistributionTransitionMode {
                    typename Tsolver::ActionNode &action) const;
 };
 
-/** Default tree policy as used in UCT */
+/** Default tree policy as used in UCT, with optional virtual loss for tree
+ * parallelization: each action selected along a trajectory receives a virtual
+ * visit penalized by the virtual loss magnitude until the trajectory is
+ * back-propagated, which diverts concurrent threads towards other branches of
+ * the tree (a magnitude of 0 deactivates virtual losses) */
 template <typename Tsolver> class DefaultTreePolicy {
 public:
+  DefaultTreePolicy(double virtual_loss = 0.0);
+
+  DefaultTreePolicy(const DefaultTreePolicy &other);
+
   typename Tsolver::StateNode *operator()(
       Tsolver &solver,
       const std::size_t *thread_id, // for parallelisation
       const typename Tsolver::Expander &expander,
       const typename Tsolver::ActionSelectorOptimization &action_selector,
       typename Tsolver::StateNode &n, std::size_t &d) const;
+
+  double virtual_loss() const;
+
+  // Number of trees searched by the solver's lanes (a single shared tree)
+  std::size_t nb_trees(std::size_t nb_lanes) const;
+
+private:
+  typename Tsolver::ExecutionPolicy::template atomic<double> _virtual_loss;
+};
+
+/** Root parallelization: each lane of the solver searches its own private
+ * tree with its own random generator, so that lanes never contend on the same
+ * nodes, and the statistics of the root actions (more generally of the
+ * actions of any state) of all the trees are merged when querying the solver's
+ * policy */
+template <typename Tsolver>
+class RootParallelTreePolicy : public DefaultTreePolicy<Tsolver> {
+public:
+  RootParallelTreePolicy(double virtual_loss = 0.0);
+
+  // One private tree per lane
+  std::size_t nb_trees(std::size_t nb_lanes) const;
 };
 
 /** Test if a given node needs to be expanded by assuming that applicable
@@ -205,19 +242,72 @@ public:
       const std::size_t *)>
       PolicyFunctor;
 
-  DefaultRolloutPolicy(
+  DefaultRolloutPolicy(const PolicyFunctor &policy = random_policy());
+
+  void operator()(Tsolver &solver, const std::size_t *thread_id,
+                  typename Tsolver::StateNode &n, std::size_t d) const;
+
+  // Number of domain lanes used by each rollout (a single one)
+  std::size_t lanes_per_leaf(std::size_t nb_lanes) const;
+
+  static PolicyFunctor random_policy();
+
+protected:
+  PolicyFunctor _policy;
+
+  // Returns the discounted reward of a trajectory simulated from n
+  double simulate(Tsolver &solver, const std::size_t *thread_id,
+                  typename Tsolver::StateNode &n, std::size_t d) const;
+};
+
+/** Leaf parallelization: simulates nb_rollouts trajectories concurrently from
+ * the leaf node reached by the tree policy, each on its own domain lane, and
+ * updates the leaf with their average reward. The solver then runs one tree
+ * lane per group of nb_rollouts domain lanes. Requires a transition mode which
+ * does not depend on the current state of the domain lanes (i.e. not
+ * 'StepTransitionMode'). With concurrent execution policies, the extra domain
+ * lanes of each tree lane are served by helper threads started at the first
+ * leaf and kept waiting for the next leaves until the policy is destroyed */
+template <typename Tsolver>
+class LeafParallelRolloutPolicy : public DefaultRolloutPolicy<Tsolver> {
+public:
+  typedef typename DefaultRolloutPolicy<Tsolver>::PolicyFunctor PolicyFunctor;
+
+  LeafParallelRolloutPolicy(
+      std::size_t nb_rollouts = 4,
       const PolicyFunctor &policy =
-          [](typename Tsolver::Domain &domain,
-             const typename Tsolver::Domain::State &state,
-             const std::size_t *thread_id) {
-            return domain.get_applicable_actions(state, thread_id).sample();
-          });
+          DefaultRolloutPolicy<Tsolver>::random_policy());
+  ~LeafParallelRolloutPolicy();
 
   void operator()(Tsolver &solver, const std::size_t *thread_id,
                   typename Tsolver::StateNode &n, std::size_t d) const;
 
+  // nb_rollouts domain lanes per leaf, within the available lanes
+  std::size_t lanes_per_leaf(std::size_t nb_lanes) const;
+
 private:
-  PolicyFunctor _policy;
+  // Helper threads of a tree lane and the leaf they currently simulate from
+  struct RolloutGroup {
+    std::mutex mutex;
+    std::condition_variable work_condition;
+    std::condition_variable done_condition;
+    std::size_t generation = 0; // incremented for each new leaf
+    std::size_t nb_pending = 0; // helpers still simulating the current leaf
+    bool stop = false;
+    Tsolver *solver = nullptr;
+    typename Tsolver::StateNode *node = nullptr;
+    std::size_t depth = 0;
+    std::vector<double> rewards;
+    std::exception_ptr error;
+    std::vector<std::thread> threads;
+  };
+
+  std::size_t _nb_rollouts;
+  mutable std::once_flag _groups_flag;
+  mutable std::vector<std::unique_ptr<RolloutGroup>> _groups;
+
+  void run_helper(RolloutGroup &group, std::size_t thread_id,
+                  std::size_t lane) const;
 };
 
 /** Void rollout policy */
@@ -226,10 +316,12 @@ public:
   VoidRolloutPolicy() {}
   void operator()(Tsolver &solver, const std::size_t *thread_id,
                   typename Tsolver::StateNode &n, std::size_t d) const {}
+  std::size_t lanes_per_leaf(std::size_t nb_lanes) const { return 1; }
 };
 
 /** Graph backup: update Q values using the graph ancestors (rather than
- * only the trajectory leading to n) */
+ * only the trajectory leading to n), then revert the virtual losses applied by
+ * the tree policy along the trajectory leading to n */
 template <typename Tsolver> struct GraphBackup {
   void operator()(Tsolver &solver, const std::size_t *thread_id,
                   typename Tsolver::StateNode &n) const;
@@ -262,9 +354,11 @@ template <typename Tsolver> struct GraphBackup {
  * trajectories with, respectively, the 'step' or 'sample' or
  * 'get_next_state_distribution' method of the domain depending on the
  * domain's dynamics capabilities)
- * @tparam TtreePolicy Type of the tree policy class (currently only
+ * @tparam TtreePolicy Type of the tree policy class (one of:
  * 'DefaultTreePolicy' which rollouts a random trajectory from the current root
- * solving state until reaching a non-expanded state node of the tree)
+ * solving state until reaching a non-expanded state node of the tree shared by
+ * all the threads, or 'RootParallelTreePolicy' which does the same in a private
+ * tree per thread whose statistics are merged when querying the policy)
  * @tparam Texpander Type of the expander class when a state needs to be
  * expanded (one of: 'FullExpand' if applicable actions and next states
  * should be all enumerated for each transition function, or 'PartialExpand' if
@@ -284,11 +378,13 @@ template <typename Tsolver> struct GraphBackup {
  * @tparam TrolloutPolicy Type of the rollout policy class (one of:
  * 'DefaultRolloutPolicy' to simulate trajectories starting in a non-expanded
  * state node of the tree by applying actions from a given policy or by sampling
- * random applicable actions in each visited state if no policy is provided, or
- * 'VoidRolloutPolicy' to deactivate the simulation of trajectories from
- * non-expanded state nodes, in which latter case it is advised to provide a
- * heuristic function in the constructor of the expander instance to initialize
- * non-expanded state nodes' values)
+ * random applicable actions in each visited state if no policy is provided,
+ * 'LeafParallelRolloutPolicy' to average several such trajectories simulated
+ * concurrently on different domain lanes, or 'VoidRolloutPolicy' to
+ * deactivate the simulation of trajectories from non-expanded state nodes, in
+ * which latter case it is advised to provide a heuristic function in the
+ * constructor of the expander instance to initialize non-expanded state nodes'
+ * values)
  * @tparam TbackPropagator Type of the back propagator class (currently only
  * 'GraphBackup' which back-propagates empirical Q-values from non-expanded
  * state nodes up to the root node of the tree along the tree policy's sampled
@@ -342,6 +438,8 @@ public:
     atomic_size_t expansions_count; // used only for partial expansion mode
     atomic_double value;
     atomic_size_t visits_count;
+    atomic_size_t virtual_visits_count; // pending trajectories of the threads
+    atomic_double virtual_loss;         // sum of their virtual losses
     StateNode *parent;
 
     ActionNode(const Action &a);
@@ -361,6 +459,8 @@ public:
     ActionSet actions;
     atomic_double value;
     atomic_size_t visits_count;
+    atomic_size_t virtual_visits_count; // pending trajectories of the threads
+    atomic_size_t epoch; // root epoch of the node's last retention
     std::unordered_set<ActionNode *> parents;
     mutable typename ExecutionPolicy::Mutex mutex;
 
@@ -372,9 +472,14 @@ public:
     };
   };
 
-  typedef typename SetTypeDeducer<StateNode, State>::Set Graph;
+  typedef typename ConcurrentSetTypeDeducer<
+      StateNode, State, ExecutionPolicy, NodeArenaAllocator<StateNode>>::Set
+      Graph;
+  typedef GraphCompactor<ExecutionPolicy, StateNode> Compactor;
   typedef std::function<bool(const MCTSSolver &, Domain &, const std::size_t *)>
       CallbackFunctor;
+  // Actions of a trajectory and virtual losses applied to them
+  typedef std::vector<std::pair<ActionNode *, double>> VirtualLossPath;
 
   /**
    * @brief Constructs a new MCTSSolver object
@@ -395,7 +500,9 @@ public:
    * @param discount Value function's discount factor
    * @param online_node_garbage Boolean indicating whether the search graph
    * which is no more reachable from the root solving state should be
-   * deleted (true) or not (false)
+   * deleted (true) or not (false); the unreachable nodes are reclaimed
+   * incrementally during the next search (in the background with parallel
+   * execution policies) instead of when getting the best action
    * @param callback Functor called at the end of each MCTS trial rollout,
    * taking as arguments the solver, the domain and the thread ID from which it
    * is called, and returning true if the solver must be stopped
@@ -494,7 +601,8 @@ public:
   /**
    * @brief Get the number of states present in the search graph (which can be
    * lower than the number of actually explored states if node garbage was
-   * set to true in the MCTSSolver instance's constructor)
+   * set to true in the MCTSSolver instance's constructor), summed over the
+   * private trees of the threads with 'RootParallelTreePolicy'
    *
    * @return std::size_t Number of states present in the search graph
    */
@@ -568,9 +676,16 @@ public:
   const RolloutPolicy &rollout_policy();
   const BackPropagator &back_propagator();
 
-  Graph &graph();
-  std::mt19937 &gen();
-  typename ExecutionPolicy::Mutex &gen_mutex();
+  // The graph, random generator and its mutex are the ones of the tree
+  // searched by the given thread (the first tree if thread_id is nullptr)
+  Graph &graph(const std::size_t *thread_id = nullptr);
+  VirtualLossPath &virtual_loss_path(const std::size_t *thread_id);
+  // Write barrier of the node garbage compaction, to be called on each node
+  // got from the graph by inserting or finding a state
+  void retain(StateNode &node, const std::size_t *thread_id = nullptr);
+  std::mt19937 &gen(const std::size_t *thread_id = nullptr);
+  typename ExecutionPolicy::Mutex &
+  gen_mutex(const std::size_t *thread_id = nullptr);
   bool verbose() const;
 
 private:
@@ -597,22 +712,28 @@ private:
   std::unique_ptr<RolloutPolicy> _rollout_policy;
   std::unique_ptr<BackPropagator> _back_propagator;
 
-  Graph _graph;
-  StateNode *_current_state;
+  std::size_t _lanes_per_leaf; // domain lanes used by each tree lane
+  std::vector<Graph> _graphs;  // one per tree
+  std::vector<StateNode *> _current_states;
+  std::vector<std::unique_ptr<Compactor>> _compactors; // one per tree
+  std::vector<VirtualLossPath> _virtual_loss_paths; // one per rollout lane
   std::list<Action> _action_prefix;
 
-  std::unique_ptr<std::mt19937> _gen;
-  typename ExecutionPolicy::Mutex _gen_mutex;
+  std::vector<std::mt19937> _gens;
+  std::vector<typename ExecutionPolicy::Mutex> _gen_mutexes;
   typename ExecutionPolicy::Mutex _time_mutex;
-  typename ExecutionPolicy::Mutex _residuals_protect;
+  typename ExecutionPolicy::SpinMutex _residuals_protect;
 
   atomic_double _residual_moving_average;
   std::list<double> _residuals;
 
-  void compute_reachable_subgraph(StateNode *node,
-                                  std::unordered_set<StateNode *> &subgraph);
-  void remove_subgraph(std::unordered_set<StateNode *> &root_subgraph,
-                       std::unordered_set<StateNode *> &child_subgraph);
+  std::size_t tree_index(const std::size_t *thread_id) const;
+  // Returns the node of s if there is a single tree, otherwise the merge of
+  // the nodes of s in all the trees built in 'merged' (nullptr if not found)
+  const StateNode *find_node(const State &s,
+                             std::unique_ptr<StateNode> &merged);
+  // Guards of the graphs against their compactors for the queries
+  std::vector<typename Compactor::Guard> guard_graphs();
   void update_residual_moving_average(const StateNode &node,
                                       const double &node_record_value);
 }; // MCTSSolver class
@@ -636,11 +757,13 @@ using UCTSolver =
 #include "impl/mcts_sample_transition_mode_impl.hh"
 #include "impl/mcts_distribution_transition_mode_impl.hh"
 #include "impl/mcts_default_tree_policy_impl.hh"
+#include "impl/mcts_root_parallel_tree_policy_impl.hh"
 #include "impl/mcts_full_expand_impl.hh"
 #include "impl/mcts_partial_expand_impl.hh"
 #include "impl/mcts_ucb1_action_selector_impl.hh"
 #include "impl/mcts_best_qvalue_action_selector_impl.hh"
 #include "impl/mcts_default_rollout_policy_impl.hh"
+#include "impl/mcts_leaf_parallel_rollout_policy_impl.hh"
 #include "impl/mcts_graph_backup_impl.hh"
 #endif
 
@@ -13,7 +13,7 @@ PyMCTSSolver::PyMCTSSolver(
     py::object &solver, py::object &domain, std::size_t time_budget,
     std::size_t rollout_budget, std::size_t max_depth,
     std::size_t residual_moving_average_window, double epsilon, double discount,
-    double ucb_constant, bool online_node_garbage,
+    double ucb_constant, double virtual_loss, bool online_node_garbage,
     const CustomPolicyFunctor &custom_policy, const HeuristicFunctor &heuristic,
     double state_expansion_rate, double action_expansion_rate,
     PyMCTSOptions::TransitionMode transition_mode,
@@ -35,9 +35,9 @@ PyMCTSSolver::PyMCTSSolver(
                                 heuristic))
       .instantiate(solver, domain, time_budget, rollout_budget, max_depth,
                    residual_moving_average_window, epsilon, discount,
-                   ucb_constant, online_node_garbage, _filtered_custom_policy,
-                   heuristic, state_expansion_rate, action_expansion_rate,
-                   callback, verbose);
+                   ucb_constant, virtual_loss, online_node_garbage,
+                   _filtered_custom_policy, heuristic, state_expansion_rate,
+                   action_expansion_rate, callback, verbose);
 }
 
 } // namespace skdecide
@@ -80,7 +80,7 @@ void init_pymcts(py::module &m) {
                py::object &, // Python solver
                py::object &, // Python domain
                std::size_t, std::size_t, std::size_t, std::size_t, double,
-               double, double, bool,
+               double, double, double, bool,
                const std::function<py::object(
                    const py::object &, const py::object &,
                    const py::object & // last arg used for
@@ -109,6 +109,7 @@ void init_pymcts(py::module &m) {
            py::arg("epsilon") = 0.0, // not a stopping criterion by default
            py::arg("discount") = 1.0,
            py::arg("ucb_constant") = 1.0 / std::sqrt(2.0),
+           py::arg("virtual_loss") = 0.0,
            py::arg("online_node_garbage") = false,
            py::arg("custom_policy") = nullptr, py::arg("heuristic") = nullptr,
            py::arg("state_expansion_rate") = 0.1,
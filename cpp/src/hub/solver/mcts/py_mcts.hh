@@ -42,8 +42,8 @@ using PyMCTSDomain = PythonDomainProxy<Texecution>;
   py::object &solver, py::object &domain, std::size_t time_budget,             \
       std::size_t rollout_budget, std::size_t max_depth,                       \
       std::size_t residual_moving_average_window, double epsilon,              \
-      double discount, double ucb_constant, bool online_node_garbage,          \
-      const CustomPolicyFunctor &custom_policy,                                \
+      double discount, double ucb_constant, double virtual_loss,               \
+      bool online_node_garbage, const CustomPolicyFunctor &custom_policy,      \
       const HeuristicFunctor &heuristic, double state_expansion_rate,          \
       double action_expansion_rate, const CallbackFunctor &callback,           \
       bool verbose
@@ -51,8 +51,8 @@ using PyMCTSDomain = PythonDomainProxy<Texecution>;
 #define MCTS_SOLVER_ARGS                                                       \
   solver, domain, time_budget, rollout_budget, max_depth,                      \
       residual_moving_average_window, epsilon, discount, ucb_constant,         \
-      online_node_garbage, custom_policy, heuristic, state_expansion_rate,     \
-      action_expansion_rate, callback, verbose
+      virtual_loss, online_node_garbage, custom_policy, heuristic,             \
+      state_expansion_rate, action_expansion_rate, callback, verbose
 
 class PyMCTSSolver {
 public:
@@ -115,7 +115,8 @@ private:
       _solver = std::make_unique<PyMCTSSolver>(
           *_domain, time_budget, rollout_budget, max_depth,
           residual_moving_average_window, epsilon, discount,
-          online_node_garbage, init_callback(), verbose, init_tree_policy(),
+          online_node_garbage, init_callback(), verbose,
+          init_tree_policy(virtual_loss),
           init_expander(_heuristic, state_expansion_rate,
                         action_expansion_rate),
           init_action_selector<TactionSelectorOptimization<PyMCTSSolver>>(
@@ -167,8 +168,9 @@ private:
       };
     }
 
-    std::unique_ptr<TtreePolicy<PyMCTSSolver>> init_tree_policy() {
-      return std::make_unique<TtreePolicy<PyMCTSSolver>>();
+    std::unique_ptr<TtreePolicy<PyMCTSSolver>>
+    init_tree_policy(double virtual_loss) {
+      return std::make_unique<TtreePolicy<PyMCTSSolver>>(virtual_loss);
     }
 
     std::function<std::pair<typename PyMCTSDomain<Texecution>::Value,
@@ -720,7 +722,7 @@ public:
                double epsilon = 0.0, // not a stopping criterion by default
                double discount = 1.0,
                double ucb_constant = 1.0 / std::sqrt(2.0),
-               bool online_node_garbage = false,
+               double virtual_loss = 0.0, bool online_node_garbage = false,
                const CustomPolicyFunctor &custom_policy = nullptr,
                const HeuristicFunctor &heuristic = nullptr,
                double state_expansion_rate = 0.1,
@@ -8,10 +8,11 @@
 #include <algorithm>
 #include <cmath>
 #include <limits>
-#include <map>
 #include <vector>
 
 #include "Highs.h"
+#include "utils/batched_domain_calls.hh"
+#include "utils/compressed_lp_matrix.hh"
 #include "utils/logging.hh"
 #include "utils/string_converter.hh"
 
@@ -40,13 +41,13 @@ SK_MDPLP_CLASS::MDPLPSolver(Domain &domain, const HeuristicFunctor &heuristic,
                             const TerminalValueFunctor &terminal_value,
                             LPVariant variant, double discount, double epsilon,
                             double lp_infinity,
-                            std::size_t lp_callback_interval,
+                            std::size_t lp_callback_interval, bool warm_start,
                             const CallbackFunctor &callback, bool verbose)
     : _domain(domain), _heuristic(heuristic), _terminal_value(terminal_value),
       _variant(variant), _discount(discount), _epsilon(epsilon),
       _lp_infinity(lp_infinity), _lp_callback_interval(lp_callback_interval),
-      _callback(callback), _verbose(verbose), _nb_lp_variables(0),
-      _nb_lp_constraints(0) {
+      _warm_start(warm_start), _callback(callback), _verbose(verbose),
+      _nb_lp_variables(0), _nb_lp_constraints(0), _nb_lp_iterations(0) {
   if (verbose) {
     Logger::check_level(logging::debug, "algorithm MDPLP");
   }
@@ -58,56 +59,103 @@ void SK_MDPLP_CLASS::clear() {
   _non_terminal_states.clear();
   _nb_lp_variables = 0;
   _nb_lp_constraints = 0;
+  _nb_lp_iterations = 0;
 }
 
-// --- Expand ---
+// --- Layer expansion ---
 
 SK_MDPLP_TEMPLATE_DECL
-void SK_MDPLP_CLASS::expand(StateNode &s) {
-  auto applicable_actions =
-      _domain.get_applicable_actions(s.state).get_elements();
-
-  std::for_each(
-      ExecutionPolicy::policy, applicable_actions.begin(),
-      applicable_actions.end(), [this, &s](auto a) {
-        if (_verbose)
-          Logger::debug("MDPLP expanding action: " + a.print() +
-                        ExecutionPolicy::print_thread());
-        _execution_policy.protect(
-            [&s, &a] { s.actions.push_back(std::make_unique<ActionNode>(a)); });
-        ActionNode &an = *(s.actions.back());
-
-        auto next_states =
-            _domain.get_next_state_distribution(s.state, a).get_values();
-        for (auto ns : next_states) {
+std::vector<typename SK_MDPLP_CLASS::StateNode *>
+SK_MDPLP_CLASS::expand_layer(const std::vector<StateNode *> &layer) {
+  std::vector<const State *> states(layer.size());
+  std::transform(layer.begin(), layer.end(), states.begin(),
+                 [](StateNode *sn) { return &(sn->state); });
+
+  for_each_applicable_actions<ExecutionPolicy>(
+      _domain, states, [this, &layer](const std::size_t &i, auto &actions) {
+        StateNode &s = *layer[i];
+        for (const auto &a : actions.get_elements()) {
+          if (_verbose)
+            Logger::debug("MDPLP expanding action: " + a.print() +
+                          ExecutionPolicy::print_thread());
+          s.actions.push_back(std::make_unique<ActionNode>(a));
+        }
+      });
+
+  std::vector<const State *> tr_states;
+  std::vector<const Action *> tr_actions;
+  std::vector<ActionNode *> tr_nodes;
+  for (auto *sn : layer) {
+    for (const auto &an : sn->actions) {
+      tr_states.push_back(&(sn->state));
+      tr_actions.push_back(&(an->action));
+      tr_nodes.push_back(an.get());
+    }
+  }
+
+  std::vector<StateNode *> new_nodes;
+  for_each_next_state_distribution<ExecutionPolicy>(
+      _domain, tr_states, tr_actions,
+      [this, &tr_nodes, &new_nodes](const std::size_t &i, auto &distribution) {
+        ActionNode &an = *tr_nodes[i];
+        for (auto ns : distribution.get_values()) {
           std::pair<typename Graph::iterator, bool> si;
           _execution_policy.protect(
               [this, &si, &ns] { si = _graph.emplace(ns.state()); });
           StateNode &next_node = const_cast<StateNode &>(*(si.first));
-
+          an.outcomes.push_back(
+              std::make_tuple(ns.probability(), 0.0, &next_node));
           if (si.second) {
-            if (_domain.is_terminal(ns.state())) {
-              next_node.terminal = true;
-              next_node.best_value = _terminal_value(ns.state()).cost();
-            }
+            _execution_policy.protect(
+                [&new_nodes, &next_node] { new_nodes.push_back(&next_node); });
           }
+        }
+      });
+
+  std::vector<const State *> v_states;
+  std::vector<const Action *> v_actions;
+  std::vector<const State *> v_next_states;
+  std::vector<std::tuple<double, double, StateNode *> *> v_outcomes;
+  for (std::size_t i = 0; i < tr_nodes.size(); i++) {
+    for (auto &o : tr_nodes[i]->outcomes) {
+      v_states.push_back(tr_states[i]);
+      v_actions.push_back(tr_actions[i]);
+      v_next_states.push_back(&(std::get<2>(o)->state));
+      v_outcomes.push_back(&o);
+    }
+  }
+
+  for_each_transition_value<ExecutionPolicy>(
+      _domain, v_states, v_actions, v_next_states,
+      [&v_outcomes](const std::size_t &i, auto &value) {
+        std::get<1>(*v_outcomes[i]) = value.cost();
+      });
 
-          double cost =
-              _domain.get_transition_value(s.state, a, next_node.state).cost();
-          _execution_policy.protect([&an, &ns, cost, &next_node] {
-            an.outcomes.push_back(
-                std::make_tuple(ns.probability(), cost, &next_node));
-          });
+  std::vector<const State *> new_states(new_nodes.size());
+  std::transform(new_nodes.begin(), new_nodes.end(), new_states.begin(),
+                 [](StateNode *sn) { return &(sn->state); });
+  std::vector<StateNode *> next_layer;
+
+  for_each_terminal<ExecutionPolicy>(
+      _domain, new_states,
+      [this, &new_nodes, &next_layer](const std::size_t &i, bool terminal) {
+        StateNode &next_node = *new_nodes[i];
+        if (terminal) {
+          next_node.terminal = true;
+          next_node.best_value = _terminal_value(next_node.state).cost();
+        } else {
+          _execution_policy.protect(
+              [&next_layer, &next_node] { next_layer.push_back(&next_node); });
         }
       });
+
+  return next_layer;
 }
 
 // --- BFS state enumeration ---
 
 SK_MDPLP_TEMPLATE_DECL
 void SK_MDPLP_CLASS::enumerate_reachable_states(const State &s) {
-  std::queue<StateNode *> frontier;
-
   auto si = _graph.emplace(s);
   StateNode &root = const_cast<StateNode &>(*(si.first));
   if (si.second) {
@@ -117,39 +165,32 @@ void SK_MDPLP_CLASS::enumerate_reachable_states(const State &s) {
     }
   }
 
-  if (!root.terminal) {
-    frontier.push(&root);
+  std::vector<StateNode *> layer;
+  if (!root.terminal && root.actions.empty()) {
+    layer.push_back(&root);
   }
 
-  while (!frontier.empty()) {
-    StateNode *current = frontier.front();
-    frontier.pop();
-
-    if (current->terminal || !current->actions.empty()) {
-      continue;
-    }
-
-    expand(*current);
-
-    for (const auto &an : current->actions) {
-      for (const auto &outcome : an->outcomes) {
-        StateNode *ns = std::get<2>(outcome);
-        if (ns->actions.empty() && !ns->terminal) {
-          frontier.push(ns);
-        }
-      }
-    }
+  while (!layer.empty()) {
+    layer = expand_layer(layer);
   }
 
+  // Non-terminal states come first so that their index is also the index of
+  // their LP column (primal) or flow conservation row (dual)
   _non_terminal_states.clear();
-  std::size_t idx = 0;
   for (auto &sn : _graph) {
     StateNode &node = const_cast<StateNode &>(sn);
-    node.index = idx++;
     if (!node.terminal) {
+      node.index = _non_terminal_states.size();
       _non_terminal_states.push_back(&node);
     }
   }
+  std::size_t idx = _non_terminal_states.size();
+  for (auto &sn : _graph) {
+    StateNode &node = const_cast<StateNode &>(sn);
+    if (node.terminal) {
+      node.index = idx++;
+    }
+  }
 
   if (_verbose) {
     Logger::debug("MDPLP: enumerated " + StringConverter::from(_graph.size()) +
@@ -159,37 +200,27 @@ void SK_MDPLP_CLASS::enumerate_reachable_states(const State &s) {
   }
 }
 
-// --- Primal LP using HiGHS ---
+// --- LP using HiGHS ---
 
 SK_MDPLP_TEMPLATE_DECL
 void SK_MDPLP_CLASS::solve_primal_lp() {
-  Highs highs;
-  highs.setOptionValue("output_flag", _verbose);
-
-  std::size_t n_vars = _non_terminal_states.size();
-  std::map<std::size_t, std::size_t> index_to_col;
-
-  // Add variables: V(s) ≥ 0 for each non-terminal state
-  for (std::size_t i = 0; i < _non_terminal_states.size(); ++i) {
-    highs.addVar(0.0, _lp_infinity);
-    index_to_col[_non_terminal_states[i]->index] = i;
+  if (!_highs) {
+    _highs = std::make_unique<Highs>();
+    _highs->setOptionValue("output_flag", _verbose);
   }
 
-  // Objective: max Σ V(s) (primal for cost minimization)
-  for (std::size_t i = 0; i < n_vars; ++i) {
-    highs.changeColCost(static_cast<HighsInt>(i), 1.0);
-  }
-  highs.changeObjectiveSense(ObjSense::kMaximize);
+  // Columns: V(s) ≥ 0 for each non-terminal state (column = state index)
+  std::size_t n_vars = _non_terminal_states.size();
+  std::vector<double> col_cost(n_vars, 1.0), col_lower(n_vars, 0.0),
+      col_upper(n_vars, _lp_infinity);
 
-  // Constraints: V(s) ≤ C(s,a) + γ Σ P(s'|s,a) V(s') for all s, a
-  std::size_t n_constraints = 0;
+  // Rows: V(s) - γ Σ P(s'|s,a) V(s') ≤ C(s,a) for all s, a, stored in
+  // compressed sparse row layout
+  CompressedLPMatrix<HighsInt> matrix(n_vars);
+  std::vector<double> row_lower, row_upper;
   for (auto *sn : _non_terminal_states) {
-    std::size_t col_s = index_to_col.at(sn->index);
-
     for (const auto &an : sn->actions) {
-      // Aggregate coefficients by column to handle self-loops
-      std::map<HighsInt, double> coeff_map;
-      coeff_map[static_cast<HighsInt>(col_s)] = 1.0;
+      matrix.add(static_cast<HighsInt>(sn->index), 1.0);
 
       double rhs_const = 0.0;
       bool cost_set = false;
@@ -207,28 +238,26 @@ void SK_MDPLP_CLASS::solve_primal_lp() {
         if (ns->terminal) {
           rhs_const += prob * _discount * ns->best_value;
         } else {
-          auto it = index_to_col.find(ns->index);
-          if (it != index_to_col.end()) {
-            coeff_map[static_cast<HighsInt>(it->second)] -= prob * _discount;
-          }
+          matrix.add(static_cast<HighsInt>(ns->index), -prob * _discount);
         }
       }
 
-      std::vector<HighsInt> cols;
-      std::vector<double> vals;
-      for (const auto &[c, v] : coeff_map) {
-        cols.push_back(c);
-        vals.push_back(v);
-      }
-
-      highs.addRow(-_lp_infinity, rhs_const, static_cast<HighsInt>(cols.size()),
-                   cols.data(), vals.data());
-      n_constraints++;
+      matrix.close();
+      row_lower.push_back(-_lp_infinity);
+      row_upper.push_back(rhs_const);
     }
   }
 
+  // Objective: max Σ V(s)
+  _highs->passModel(
+      static_cast<HighsInt>(n_vars), matrix.nb_major(), matrix.nb_entries(),
+      static_cast<HighsInt>(MatrixFormat::kRowwise),
+      static_cast<HighsInt>(ObjSense::kMaximize), 0.0, col_cost.data(),
+      col_lower.data(), col_upper.data(), row_lower.data(), row_upper.data(),
+      matrix.start(), matrix.index(), matrix.value());
+
   _nb_lp_variables = n_vars;
-  _nb_lp_constraints = n_constraints;
+  _nb_lp_constraints = row_lower.size();
 
   if (_verbose) {
     Logger::debug("MDPLP primal: " + StringConverter::from(_nb_lp_variables) +
@@ -236,143 +265,60 @@ void SK_MDPLP_CLASS::solve_primal_lp() {
                   " constraints");
   }
 
-  if (_lp_callback_interval > 0) {
-    struct LPInterruptData {
-      std::size_t interval;
-      std::size_t last_interrupt_iter = 0;
-    };
-    LPInterruptData cb_data{_lp_callback_interval};
-
-    highs.setCallback(
-        [](const int, const std::string &, const HighsCallbackDataOut *data_out,
-           HighsCallbackDataIn *data_in, void *user_data) {
-          auto *d = static_cast<LPInterruptData *>(user_data);
-          auto iter =
-              static_cast<std::size_t>(data_out->simplex_iteration_count);
-          if (iter - d->last_interrupt_iter >= d->interval) {
-            d->last_interrupt_iter = iter;
-            data_in->user_interrupt = 1;
-          }
-        },
-        &cb_data);
-    highs.startCallback(kCallbackSimplexInterrupt);
-
-    while (true) {
-      highs.run();
-      auto ms = highs.getModelStatus();
-      if (ms == HighsModelStatus::kOptimal)
-        break;
-
-      if (ms == HighsModelStatus::kInfeasible ||
-          ms == HighsModelStatus::kUnbounded ||
-          ms == HighsModelStatus::kSolveError) {
-        throw std::runtime_error("MDPLP primal LP failed: " +
-                                 highs.modelStatusToString(ms));
-      }
-
-      const auto &col_value = highs.getSolution().col_value;
-      if (!col_value.empty()) {
-        for (auto *sn : _non_terminal_states) {
-          sn->best_value = col_value[index_to_col.at(sn->index)];
-        }
-        extract_policy_from_values();
-        _last_callback_event = LPCallbackEvent::LPProgress;
-        if (_callback(*this, _domain))
-          break;
-      }
-    }
-  } else {
-    highs.run();
-    HighsModelStatus model_status = highs.getModelStatus();
-    if (model_status != HighsModelStatus::kOptimal) {
-      throw std::runtime_error("MDPLP primal LP not optimal: " +
-                               highs.modelStatusToString(model_status));
-    }
-  }
-
-  const std::vector<double> &solution = highs.getSolution().col_value;
-  for (auto *sn : _non_terminal_states) {
-    sn->best_value = solution[index_to_col.at(sn->index)];
-  }
+  run_lp("MDPLP primal");
 }
 
-// --- Dual LP using HiGHS ---
-
 SK_MDPLP_TEMPLATE_DECL
 void SK_MDPLP_CLASS::solve_dual_lp(const State &s0) {
-  Highs highs;
-  highs.setOptionValue("output_flag", _verbose);
-
-  // Variables: x(s,a) ≥ 0 for each (state, action) pair
-  struct SAVar {
-    std::size_t col;
-    StateNode *sn;
-    ActionNode *an;
-  };
-  std::vector<SAVar> sa_vars;
-  std::map<std::size_t, std::vector<std::size_t>> state_to_vars;
-
-  std::size_t col = 0;
-  for (auto *sn : _non_terminal_states) {
-    for (auto &an : sn->actions) {
-      highs.addVar(0.0, _lp_infinity);
-      sa_vars.push_back({col, sn, an.get()});
-      state_to_vars[sn->index].push_back(col);
-      col++;
-    }
-  }
-
-  std::size_t n_vars = col;
-
-  // Objective: min Σ C(s,a) x(s,a)
-  for (const auto &sa : sa_vars) {
-    double cost = 0.0;
-    if (!sa.an->outcomes.empty()) {
-      cost = std::get<1>(sa.an->outcomes.front());
-    }
-    highs.changeColCost(static_cast<HighsInt>(sa.col), cost);
+  if (!_highs) {
+    _highs = std::make_unique<Highs>();
+    _highs->setOptionValue("output_flag", _verbose);
   }
-  highs.changeObjectiveSense(ObjSense::kMinimize);
 
-  // Flow conservation constraints:
-  // Σ_a x(s,a) - γ Σ_{s',a'} P(s|s',a') x(s',a') = α(s)
-  // Aggregate coefficients per column to handle self-loops (same variable
-  // appears in both outflow and inflow terms).
-  std::size_t n_constraints = 0;
+  // Columns: x(s,a) ≥ 0 for each (state, action) pair with cost C(s,a),
+  // stored in compressed sparse column layout. Column x(s,a) has a +1
+  // outflow coefficient in the flow conservation row of s and a -γ P(s'|s,a)
+  // inflow coefficient in the row of each non-terminal successor s' (merged
+  // with the outflow coefficient for self-loops).
+  CompressedLPMatrix<HighsInt> matrix(_non_terminal_states.size());
+  std::vector<double> col_cost, col_lower, col_upper;
   for (auto *sn : _non_terminal_states) {
-    std::map<HighsInt, double> coeff_map;
-
-    // Outflow: +1 for each x(s,a)
-    for (std::size_t var_col : state_to_vars.at(sn->index)) {
-      coeff_map[static_cast<HighsInt>(var_col)] += 1.0;
-    }
-
-    // Inflow: -γ P(s|s',a') for each x(s',a') that transitions to s
-    for (const auto &sa : sa_vars) {
-      for (const auto &outcome : sa.an->outcomes) {
+    for (auto &an : sn->actions) {
+      matrix.add(static_cast<HighsInt>(sn->index), 1.0);
+      for (const auto &outcome : an->outcomes) {
         StateNode *ns = std::get<2>(outcome);
-        if (ns->index == sn->index) {
-          double prob = std::get<0>(outcome);
-          coeff_map[static_cast<HighsInt>(sa.col)] -= _discount * prob;
+        if (!ns->terminal) {
+          matrix.add(static_cast<HighsInt>(ns->index),
+                     -_discount * std::get<0>(outcome));
         }
       }
-    }
+      matrix.close();
 
-    std::vector<HighsInt> cols;
-    std::vector<double> vals;
-    for (const auto &[c, v] : coeff_map) {
-      cols.push_back(c);
-      vals.push_back(v);
+      col_cost.push_back(
+          an->outcomes.empty() ? 0.0 : std::get<1>(an->outcomes.front()));
+      col_lower.push_back(0.0);
+      col_upper.push_back(_lp_infinity);
     }
+  }
 
-    double alpha = (typename State::Equal()(sn->state, s0)) ? 1.0 : 0.0;
-    highs.addRow(alpha, alpha, static_cast<HighsInt>(cols.size()), cols.data(),
-                 vals.data());
-    n_constraints++;
+  // Rows: Σ_a x(s,a) - γ Σ_{s',a'} P(s|s',a') x(s',a') = α(s)
+  std::vector<double> alpha(_non_terminal_states.size(), 0.0);
+  for (auto *sn : _non_terminal_states) {
+    if (typename State::Equal()(sn->state, s0)) {
+      alpha[sn->index] = 1.0;
+    }
   }
 
-  _nb_lp_variables = n_vars;
-  _nb_lp_constraints = n_constraints;
+  // Objective: min Σ C(s,a) x(s,a)
+  _highs->passModel(
+      matrix.nb_major(), static_cast<HighsInt>(alpha.size()),
+      matrix.nb_entries(), static_cast<HighsInt>(MatrixFormat::kColwise),
+      static_cast<HighsInt>(ObjSense::kMinimize), 0.0, col_cost.data(),
+      col_lower.data(), col_upper.data(), alpha.data(), alpha.data(),
+      matrix.start(), matrix.index(), matrix.value());
+
+  _nb_lp_variables = col_cost.size();
+  _nb_lp_constraints = alpha.size();
 
   if (_verbose) {
     Logger::debug("MDPLP dual: " + StringConverter::from(_nb_lp_variables) +
@@ -380,6 +326,35 @@ void SK_MDPLP_CLASS::solve_dual_lp(const State &s0) {
                   " constraints");
   }
 
+  // V*(s) = row dual of flow conservation constraint (LP strong duality)
+  run_lp("MDPLP dual");
+  extract_policy_from_values();
+}
+
+// Runs the LP loaded in _highs and reads V(s) from the column values (primal)
+// or from the row duals (dual)
+SK_MDPLP_TEMPLATE_DECL
+void SK_MDPLP_CLASS::run_lp(const char *name) {
+  Highs &highs = *_highs;
+  _nb_lp_iterations = 0;
+  set_lp_basis();
+
+  auto read_values = [this, &highs]() {
+    const HighsSolution &solution = highs.getSolution();
+    const std::vector<double> &values = (_variant == LPVariant::Primal)
+                                            ? solution.col_value
+                                            : solution.row_dual;
+    if (values.size() < _non_terminal_states.size()) {
+      return false;
+    }
+    for (auto *sn : _non_terminal_states) {
+      sn->best_value = values[sn->index];
+    }
+    return true;
+  };
+
+  HighsModelStatus model_status = HighsModelStatus::kNotset;
+
   if (_lp_callback_interval > 0) {
     struct LPInterruptData {
       std::size_t interval;
@@ -403,44 +378,117 @@ void SK_MDPLP_CLASS::solve_dual_lp(const State &s0) {
 
     while (true) {
       highs.run();
-      auto ms = highs.getModelStatus();
-      if (ms == HighsModelStatus::kOptimal)
+      _nb_lp_iterations += highs.getInfo().simplex_iteration_count;
+      model_status = highs.getModelStatus();
+      if (model_status == HighsModelStatus::kOptimal)
         break;
 
-      if (ms == HighsModelStatus::kInfeasible ||
-          ms == HighsModelStatus::kUnbounded ||
-          ms == HighsModelStatus::kSolveError) {
-        throw std::runtime_error("MDPLP dual LP failed: " +
-                                 highs.modelStatusToString(ms));
+      if (model_status == HighsModelStatus::kInfeasible ||
+          model_status == HighsModelStatus::kUnbounded ||
+          model_status == HighsModelStatus::kSolveError) {
+        highs.stopCallback(kCallbackSimplexInterrupt);
+        throw std::runtime_error(std::string(name) + " LP failed: " +
+                                 highs.modelStatusToString(model_status));
       }
 
-      const auto &row_dual = highs.getSolution().row_dual;
-      if (!row_dual.empty()) {
-        for (std::size_t i = 0; i < _non_terminal_states.size(); ++i) {
-          _non_terminal_states[i]->best_value = row_dual[i];
-        }
+      if (read_values()) {
         extract_policy_from_values();
         _last_callback_event = LPCallbackEvent::LPProgress;
         if (_callback(*this, _domain))
           break;
       }
     }
+
+    highs.stopCallback(kCallbackSimplexInterrupt);
   } else {
     highs.run();
-    HighsModelStatus dual_model_status = highs.getModelStatus();
-    if (dual_model_status != HighsModelStatus::kOptimal) {
-      throw std::runtime_error("MDPLP dual LP not optimal: " +
-                               highs.modelStatusToString(dual_model_status));
+    _nb_lp_iterations = highs.getInfo().simplex_iteration_count;
+    model_status = highs.getModelStatus();
+    if (model_status != HighsModelStatus::kOptimal) {
+      throw std::runtime_error(std::string(name) + " LP not optimal: " +
+                               highs.modelStatusToString(model_status));
     }
   }
 
-  // V*(s) = row dual of flow conservation constraint (LP strong duality)
-  const std::vector<double> &row_duals = highs.getSolution().row_dual;
-  for (std::size_t i = 0; i < _non_terminal_states.size(); ++i) {
-    _non_terminal_states[i]->best_value = row_duals[i];
+  read_values();
+
+  if (model_status == HighsModelStatus::kOptimal) {
+    record_lp_basis();
   }
+}
 
-  extract_policy_from_values();
+// Starts the LP from the basis recorded at the end of the previous solve:
+// the states (resp. actions) not in the previous LP get a nonbasic column in
+// the primal (resp. dual) and a basic row in the dual (resp. primal), which
+// keeps as many basic variables as rows
+SK_MDPLP_TEMPLATE_DECL
+void SK_MDPLP_CLASS::set_lp_basis() {
+  if (!_warm_start || _lp_basis.empty()) {
+    return;
+  }
+
+  bool primal = (_variant == LPVariant::Primal);
+  HighsBasis basis;
+  std::vector<HighsBasisStatus> &state_status =
+      primal ? basis.col_status : basis.row_status;
+  std::vector<HighsBasisStatus> &action_status =
+      primal ? basis.row_status : basis.col_status;
+  HighsBasisStatus new_state_status =
+      primal ? HighsBasisStatus::kLower : HighsBasisStatus::kBasic;
+  HighsBasisStatus new_action_status =
+      primal ? HighsBasisStatus::kBasic : HighsBasisStatus::kLower;
+  std::size_t nb_recorded = 0;
+
+  for (auto *sn : _non_terminal_states) {
+    auto it = _lp_basis.find(sn->state);
+    if (it == _lp_basis.end()) {
+      state_status.push_back(new_state_status);
+      action_status.insert(action_status.end(), sn->actions.size(),
+                           new_action_status);
+      continue;
+    }
+    nb_recorded++;
+    state_status.push_back(it->second.state_status);
+    std::size_t a = 0;
+    for (std::size_t i = 0; i < sn->actions.size(); i++) {
+      action_status.push_back(a < it->second.action_status.size()
+                                  ? it->second.action_status[a++]
+                                  : new_action_status);
+    }
+  }
+
+  basis.valid = true;
+  basis.alien = false;
+  if (nb_recorded == 0 || _highs->setBasis(basis) != HighsStatus::kOk) {
+    if (_verbose) {
+      Logger::debug("MDPLP: previous basis does not fit the LP, cold start");
+    }
+  }
+}
+
+SK_MDPLP_TEMPLATE_DECL
+void SK_MDPLP_CLASS::record_lp_basis() {
+  _lp_basis.clear();
+  const HighsBasis &basis = _highs->getBasis();
+  if (!_warm_start || !basis.valid) {
+    return;
+  }
+
+  bool primal = (_variant == LPVariant::Primal);
+  const std::vector<HighsBasisStatus> &state_status =
+      primal ? basis.col_status : basis.row_status;
+  const std::vector<HighsBasisStatus> &action_status =
+      primal ? basis.row_status : basis.col_status;
+  std::size_t a = 0;
+
+  for (auto *sn : _non_terminal_states) {
+    LPBasisRecord &record = _lp_basis[sn->state];
+    record.state_status = state_status[sn->index];
+    record.action_status.assign(
+        action_status.begin() + a,
+        action_status.begin() + a + sn->actions.size());
+    a += sn->actions.size();
+  }
 }
 
 // --- Extract policy from values ---
@@ -555,6 +603,11 @@ std::size_t SK_MDPLP_CLASS::get_nb_lp_constraints() const {
   return _nb_lp_constraints;
 }
 
+SK_MDPLP_TEMPLATE_DECL
+std::size_t SK_MDPLP_CLASS::get_nb_lp_iterations() const {
+  return _nb_lp_iterations;
+}
+
 SK_MDPLP_TEMPLATE_DECL
 std::size_t SK_MDPLP_CLASS::get_solving_time() const {
   return static_cast<std::size_t>(
@@ -597,12 +650,13 @@ SK_SSPLP_CLASS::SSPLPSolver(Domain &domain,
                             const HeuristicFunctor &heuristic,
                             LPVariant variant, double epsilon,
                             double lp_infinity,
-                            std::size_t lp_callback_interval,
+                            std::size_t lp_callback_interval, bool warm_start,
                             const CallbackFunctor &callback, bool verbose)
     : _domain(domain), _goal_checker(goal_checker), _heuristic(heuristic),
       _variant(variant), _epsilon(epsilon), _lp_infinity(lp_infinity),
-      _lp_callback_interval(lp_callback_interval), _callback(callback),
-      _verbose(verbose), _nb_lp_variables(0), _nb_lp_constraints(0) {
+      _lp_callback_interval(lp_callback_interval), _warm_start(warm_start),
+      _callback(callback), _verbose(verbose), _nb_lp_variables(0),
+      _nb_lp_constraints(0), _nb_lp_iterations(0) {
   if (verbose) {
     Logger::check_level(logging::debug, "algorithm SSPLP");
   }
@@ -614,53 +668,100 @@ void SK_SSPLP_CLASS::clear() {
   _non_goal_states.clear();
   _nb_lp_variables = 0;
   _nb_lp_constraints = 0;
+  _nb_lp_iterations = 0;
 }
 
 SK_SSPLP_TEMPLATE_DECL
-void SK_SSPLP_CLASS::expand(StateNode &s) {
-  auto applicable_actions =
-      _domain.get_applicable_actions(s.state).get_elements();
-
-  std::for_each(
-      ExecutionPolicy::policy, applicable_actions.begin(),
-      applicable_actions.end(), [this, &s](auto a) {
-        if (_verbose)
-          Logger::debug("SSPLP expanding action: " + a.print() +
-                        ExecutionPolicy::print_thread());
-        _execution_policy.protect(
-            [&s, &a] { s.actions.push_back(std::make_unique<ActionNode>(a)); });
-        ActionNode &an = *(s.actions.back());
-
-        auto next_states =
-            _domain.get_next_state_distribution(s.state, a).get_values();
-        for (auto ns : next_states) {
+std::vector<typename SK_SSPLP_CLASS::StateNode *>
+SK_SSPLP_CLASS::expand_layer(const std::vector<StateNode *> &layer) {
+  std::vector<const State *> states(layer.size());
+  std::transform(layer.begin(), layer.end(), states.begin(),
+                 [](StateNode *sn) { return &(sn->state); });
+
+  for_each_applicable_actions<ExecutionPolicy>(
+      _domain, states, [this, &layer](const std::size_t &i, auto &actions) {
+        StateNode &s = *layer[i];
+        for (const auto &a : actions.get_elements()) {
+          if (_verbose)
+            Logger::debug("SSPLP expanding action: " + a.print() +
+                          ExecutionPolicy::print_thread());
+          s.actions.push_back(std::make_unique<ActionNode>(a));
+        }
+      });
+
+  std::vector<const State *> tr_states;
+  std::vector<const Action *> tr_actions;
+  std::vector<ActionNode *> tr_nodes;
+  for (auto *sn : layer) {
+    for (const auto &an : sn->actions) {
+      tr_states.push_back(&(sn->state));
+      tr_actions.push_back(&(an->action));
+      tr_nodes.push_back(an.get());
+    }
+  }
+
+  std::vector<StateNode *> new_nodes;
+  for_each_next_state_distribution<ExecutionPolicy>(
+      _domain, tr_states, tr_actions,
+      [this, &tr_nodes, &new_nodes](const std::size_t &i, auto &distribution) {
+        ActionNode &an = *tr_nodes[i];
+        for (auto ns : distribution.get_values()) {
           std::pair<typename Graph::iterator, bool> si;
           _execution_policy.protect(
               [this, &si, &ns] { si = _graph.emplace(ns.state()); });
           StateNode &next_node = const_cast<StateNode &>(*(si.first));
-
+          an.outcomes.push_back(
+              std::make_tuple(ns.probability(), 0.0, &next_node));
           if (si.second) {
-            bool is_goal = _goal_checker(_domain, ns.state());
-            bool is_terminal = _domain.is_terminal(ns.state());
-            next_node.goal = is_goal;
-            next_node.terminal = is_terminal || is_goal;
-            next_node.best_value = 0.0;
+            _execution_policy.protect(
+                [&new_nodes, &next_node] { new_nodes.push_back(&next_node); });
           }
+        }
+      });
+
+  std::vector<const State *> v_states;
+  std::vector<const Action *> v_actions;
+  std::vector<const State *> v_next_states;
+  std::vector<std::tuple<double, double, StateNode *> *> v_outcomes;
+  for (std::size_t i = 0; i < tr_nodes.size(); i++) {
+    for (auto &o : tr_nodes[i]->outcomes) {
+      v_states.push_back(tr_states[i]);
+      v_actions.push_back(tr_actions[i]);
+      v_next_states.push_back(&(std::get<2>(o)->state));
+      v_outcomes.push_back(&o);
+    }
+  }
+
+  for_each_transition_value<ExecutionPolicy>(
+      _domain, v_states, v_actions, v_next_states,
+      [&v_outcomes](const std::size_t &i, auto &value) {
+        std::get<1>(*v_outcomes[i]) = value.cost();
+      });
 
-          double cost =
-              _domain.get_transition_value(s.state, a, next_node.state).cost();
-          _execution_policy.protect([&an, &ns, cost, &next_node] {
-            an.outcomes.push_back(
-                std::make_tuple(ns.probability(), cost, &next_node));
-          });
+  std::vector<const State *> new_states(new_nodes.size());
+  std::transform(new_nodes.begin(), new_nodes.end(), new_states.begin(),
+                 [](StateNode *sn) { return &(sn->state); });
+  std::vector<StateNode *> next_layer;
+
+  for_each_terminal<ExecutionPolicy>(
+      _domain, new_states,
+      [this, &new_nodes, &next_layer](const std::size_t &i, bool terminal) {
+        StateNode &next_node = *new_nodes[i];
+        bool is_goal = _goal_checker(_domain, next_node.state);
+        next_node.goal = is_goal;
+        next_node.terminal = terminal || is_goal;
+        next_node.best_value = 0.0;
+        if (!next_node.terminal) {
+          _execution_policy.protect(
+              [&next_layer, &next_node] { next_layer.push_back(&next_node); });
         }
       });
+
+  return next_layer;
 }
 
 SK_SSPLP_TEMPLATE_DECL
 void SK_SSPLP_CLASS::enumerate_reachable_states(const State &s) {
-  std::queue<StateNode *> frontier;
-
   auto si = _graph.emplace(s);
   StateNode &root = const_cast<StateNode &>(*(si.first));
   if (si.second) {
@@ -671,39 +772,32 @@ void SK_SSPLP_CLASS::enumerate_reachable_states(const State &s) {
     root.best_value = 0.0;
   }
 
-  if (!root.terminal) {
-    frontier.push(&root);
+  std::vector<StateNode *> layer;
+  if (!root.terminal && root.actions.empty()) {
+    layer.push_back(&root);
   }
 
-  while (!frontier.empty()) {
-    StateNode *current = frontier.front();
-    frontier.pop();
-
-    if (current->terminal || !current->actions.empty()) {
-      continue;
-    }
-
-    expand(*current);
-
-    for (const auto &an : current->actions) {
-      for (const auto &outcome : an->outcomes) {
-        StateNode *ns = std::get<2>(outcome);
-        if (ns->actions.empty() && !ns->terminal) {
-          frontier.push(ns);
-        }
-      }
-    }
+  while (!layer.empty()) {
+    layer = expand_layer(layer);
   }
 
+  // Non-goal states come first so that their index is also the index of
+  // their LP column (primal) or flow conservation row (dual)
   _non_goal_states.clear();
-  std::size_t idx = 0;
   for (auto &sn : _graph) {
     StateNode &node = const_cast<StateNode &>(sn);
-    node.index = idx++;
     if (!node.terminal) {
+      node.index = _non_goal_states.size();
       _non_goal_states.push_back(&node);
     }
   }
+  std::size_t idx = _non_goal_states.size();
+  for (auto &sn : _graph) {
+    StateNode &node = const_cast<StateNode &>(sn);
+    if (node.terminal) {
+      node.index = idx++;
+    }
+  }
 
   if (_verbose) {
     Logger::debug("SSPLP: enumerated " + StringConverter::from(_graph.size()) +
@@ -716,31 +810,30 @@ void SK_SSPLP_CLASS::enumerate_reachable_states(const State &s) {
 // max  Σ V(s)
 // s.t. V(s) ≤ C(s,a) + Σ P(s'|s,a) V(s')   ∀ non-goal s, a
 //      V(g) = 0                                ∀ goal g
+//
+// Dual LP for SSP (undiscounted, γ=1):
+// min  Σ C(s,a) x(s,a)
+// s.t. Σ_a x(s,a) - Σ_{s',a'} P(s|s',a') x(s',a') = α(s)  ∀ non-goal s
+//      x(s,a) ≥ 0
 SK_SSPLP_TEMPLATE_DECL
 void SK_SSPLP_CLASS::solve_primal_lp() {
-  Highs highs;
-  highs.setOptionValue("output_flag", _verbose);
-
-  std::size_t n_vars = _non_goal_states.size();
-  std::map<std::size_t, std::size_t> index_to_col;
-
-  for (std::size_t i = 0; i < _non_goal_states.size(); ++i) {
-    highs.addVar(0.0, _lp_infinity);
-    index_to_col[_non_goal_states[i]->index] = i;
+  if (!_highs) {
+    _highs = std::make_unique<Highs>();
+    _highs->setOptionValue("output_flag", _verbose);
   }
 
-  for (std::size_t i = 0; i < n_vars; ++i) {
-    highs.changeColCost(static_cast<HighsInt>(i), 1.0);
-  }
-  highs.changeObjectiveSense(ObjSense::kMaximize);
+  // Columns: V(s) ≥ 0 for each non-goal state (column index = state index)
+  std::size_t n_vars = _non_goal_states.size();
+  std::vector<double> col_cost(n_vars, 1.0), col_lower(n_vars, 0.0),
+      col_upper(n_vars, _lp_infinity);
 
-  std::size_t n_constraints = 0;
+  // Rows: V(s) - Σ P(s'|s,a) V(s') ≤ C(s,a) for all s, a, stored in
+  // compressed sparse row layout
+  CompressedLPMatrix<HighsInt> matrix(n_vars);
+  std::vector<double> row_lower, row_upper;
   for (auto *sn : _non_goal_states) {
-    std::size_t col_s = index_to_col.at(sn->index);
-
     for (const auto &an : sn->actions) {
-      std::map<HighsInt, double> coeff_map;
-      coeff_map[static_cast<HighsInt>(col_s)] = 1.0;
+      matrix.add(static_cast<HighsInt>(sn->index), 1.0);
 
       double rhs_const = 0.0;
       bool cost_set = false;
@@ -757,28 +850,26 @@ void SK_SSPLP_CLASS::solve_primal_lp() {
 
         // Goal/terminal states have V=0, so no contribution
         if (!ns->terminal) {
-          auto it = index_to_col.find(ns->index);
-          if (it != index_to_col.end()) {
-            coeff_map[static_cast<HighsInt>(it->second)] -= prob;
-          }
+          matrix.add(static_cast<HighsInt>(ns->index), -prob);
         }
       }
 
-      std::vector<HighsInt> cols;
-      std::vector<double> vals;
-      for (const auto &[c, v] : coeff_map) {
-        cols.push_back(c);
-        vals.push_back(v);
-      }
-
-      highs.addRow(-_lp_infinity, rhs_const, static_cast<HighsInt>(cols.size()),
-                   cols.data(), vals.data());
-      n_constraints++;
+      matrix.close();
+      row_lower.push_back(-_lp_infinity);
+      row_upper.push_back(rhs_const);
     }
   }
 
+  // Objective: max Σ V(s)
+  _highs->passModel(
+      static_cast<HighsInt>(n_vars), matrix.nb_major(), matrix.nb_entries(),
+      static_cast<HighsInt>(MatrixFormat::kRowwise),
+      static_cast<HighsInt>(ObjSense::kMaximize), 0.0, col_cost.data(),
+      col_lower.data(), col_upper.data(), row_lower.data(), row_upper.data(),
+      matrix.start(), matrix.index(), matrix.value());
+
   _nb_lp_variables = n_vars;
-  _nb_lp_constraints = n_constraints;
+  _nb_lp_constraints = row_lower.size();
 
   if (_verbose) {
     Logger::debug("SSPLP primal: " + StringConverter::from(_nb_lp_variables) +
@@ -786,138 +877,60 @@ void SK_SSPLP_CLASS::solve_primal_lp() {
                   " constraints");
   }
 
-  if (_lp_callback_interval > 0) {
-    struct LPInterruptData {
-      std::size_t interval;
-      std::size_t last_interrupt_iter = 0;
-    };
-    LPInterruptData cb_data{_lp_callback_interval};
-
-    highs.setCallback(
-        [](const int, const std::string &, const HighsCallbackDataOut *data_out,
-           HighsCallbackDataIn *data_in, void *user_data) {
-          auto *d = static_cast<LPInterruptData *>(user_data);
-          auto iter =
-              static_cast<std::size_t>(data_out->simplex_iteration_count);
-          if (iter - d->last_interrupt_iter >= d->interval) {
-            d->last_interrupt_iter = iter;
-            data_in->user_interrupt = 1;
-          }
-        },
-        &cb_data);
-    highs.startCallback(kCallbackSimplexInterrupt);
-
-    while (true) {
-      highs.run();
-      auto ms = highs.getModelStatus();
-      if (ms == HighsModelStatus::kOptimal)
-        break;
-
-      if (ms == HighsModelStatus::kInfeasible ||
-          ms == HighsModelStatus::kUnbounded ||
-          ms == HighsModelStatus::kSolveError) {
-        throw std::runtime_error("SSPLP primal LP failed: " +
-                                 highs.modelStatusToString(ms));
-      }
-
-      const auto &col_value = highs.getSolution().col_value;
-      if (!col_value.empty()) {
-        for (auto *sn : _non_goal_states) {
-          sn->best_value = col_value[index_to_col.at(sn->index)];
-        }
-        extract_policy_from_values();
-        _last_callback_event = LPCallbackEvent::LPProgress;
-        if (_callback(*this, _domain))
-          break;
-      }
-    }
-  } else {
-    highs.run();
-    HighsModelStatus model_status = highs.getModelStatus();
-    if (model_status != HighsModelStatus::kOptimal) {
-      throw std::runtime_error("SSPLP primal LP not optimal: " +
-                               highs.modelStatusToString(model_status));
-    }
-  }
-
-  const std::vector<double> &solution = highs.getSolution().col_value;
-  for (auto *sn : _non_goal_states) {
-    sn->best_value = solution[index_to_col.at(sn->index)];
-  }
+  run_lp("SSPLP primal");
 }
 
-// Dual LP for SSP (undiscounted, γ=1):
-// min  Σ C(s,a) x(s,a)
-// s.t. Σ_a x(s,a) - Σ_{s',a'} P(s|s',a') x(s',a') = α(s)  ∀ non-goal s
-//      x(s,a) ≥ 0
 SK_SSPLP_TEMPLATE_DECL
 void SK_SSPLP_CLASS::solve_dual_lp(const State &s0) {
-  Highs highs;
-  highs.setOptionValue("output_flag", _verbose);
-
-  struct SAVar {
-    std::size_t col;
-    StateNode *sn;
-    ActionNode *an;
-  };
-  std::vector<SAVar> sa_vars;
-  std::map<std::size_t, std::vector<std::size_t>> state_to_vars;
-
-  std::size_t col = 0;
-  for (auto *sn : _non_goal_states) {
-    for (auto &an : sn->actions) {
-      highs.addVar(0.0, _lp_infinity);
-      sa_vars.push_back({col, sn, an.get()});
-      state_to_vars[sn->index].push_back(col);
-      col++;
-    }
+  if (!_highs) {
+    _highs = std::make_unique<Highs>();
+    _highs->setOptionValue("output_flag", _verbose);
   }
 
-  std::size_t n_vars = col;
-
-  for (const auto &sa : sa_vars) {
-    double cost = 0.0;
-    if (!sa.an->outcomes.empty()) {
-      cost = std::get<1>(sa.an->outcomes.front());
-    }
-    highs.changeColCost(static_cast<HighsInt>(sa.col), cost);
-  }
-  highs.changeObjectiveSense(ObjSense::kMinimize);
-
-  // Aggregate coefficients per column to handle self-loops
-  std::size_t n_constraints = 0;
+  // Columns: x(s,a) ≥ 0 for each (state, action) pair with cost C(s,a),
+  // stored in compressed sparse column layout. Column x(s,a) has a +1
+  // outflow coefficient in the flow conservation row of s and a -P(s'|s,a)
+  // inflow coefficient in the row of each non-goal successor s' (merged
+  // with the outflow coefficient for self-loops).
+  CompressedLPMatrix<HighsInt> matrix(_non_goal_states.size());
+  std::vector<double> col_cost, col_lower, col_upper;
   for (auto *sn : _non_goal_states) {
-    std::map<HighsInt, double> coeff_map;
-
-    for (std::size_t var_col : state_to_vars.at(sn->index)) {
-      coeff_map[static_cast<HighsInt>(var_col)] += 1.0;
-    }
-
-    for (const auto &sa : sa_vars) {
-      for (const auto &outcome : sa.an->outcomes) {
+    for (auto &an : sn->actions) {
+      matrix.add(static_cast<HighsInt>(sn->index), 1.0);
+      for (const auto &outcome : an->outcomes) {
         StateNode *ns = std::get<2>(outcome);
-        if (ns->index == sn->index) {
-          double prob = std::get<0>(outcome);
-          coeff_map[static_cast<HighsInt>(sa.col)] -= prob;
+        if (!ns->terminal) {
+          matrix.add(static_cast<HighsInt>(ns->index),
+                     -std::get<0>(outcome));
         }
       }
-    }
+      matrix.close();
 
-    std::vector<HighsInt> cols;
-    std::vector<double> vals;
-    for (const auto &[c, v] : coeff_map) {
-      cols.push_back(c);
-      vals.push_back(v);
+      col_cost.push_back(
+          an->outcomes.empty() ? 0.0 : std::get<1>(an->outcomes.front()));
+      col_lower.push_back(0.0);
+      col_upper.push_back(_lp_infinity);
     }
+  }
 
-    double alpha = (typename State::Equal()(sn->state, s0)) ? 1.0 : 0.0;
-    highs.addRow(alpha, alpha, static_cast<HighsInt>(cols.size()), cols.data(),
-                 vals.data());
-    n_constraints++;
+  // Rows: Σ_a x(s,a) - Σ_{s',a'} P(s|s',a') x(s',a') = α(s)
+  std::vector<double> alpha(_non_goal_states.size(), 0.0);
+  for (auto *sn : _non_goal_states) {
+    if (typename State::Equal()(sn->state, s0)) {
+      alpha[sn->index] = 1.0;
+    }
   }
 
-  _nb_lp_variables = n_vars;
-  _nb_lp_constraints = n_constraints;
+  // Objective: min Σ C(s,a) x(s,a)
+  _highs->passModel(
+      matrix.nb_major(), static_cast<HighsInt>(alpha.size()),
+      matrix.nb_entries(), static_cast<HighsInt>(MatrixFormat::kColwise),
+      static_cast<HighsInt>(ObjSense::kMinimize), 0.0, col_cost.data(),
+      col_lower.data(), col_upper.data(), alpha.data(), alpha.data(),
+      matrix.start(), matrix.index(), matrix.value());
+
+  _nb_lp_variables = col_cost.size();
+  _nb_lp_constraints = alpha.size();
 
   if (_verbose) {
     Logger::debug("SSPLP dual: " + StringConverter::from(_nb_lp_variables) +
@@ -925,6 +938,35 @@ void SK_SSPLP_CLASS::solve_dual_lp(const State &s0) {
                   " constraints");
   }
 
+  // V*(s) = row dual of flow conservation constraint (LP strong duality)
+  run_lp("SSPLP dual");
+  extract_policy_from_values();
+}
+
+// Runs the LP loaded in _highs and reads V(s) from the column values (primal)
+// or from the row duals (dual)
+SK_SSPLP_TEMPLATE_DECL
+void SK_SSPLP_CLASS::run_lp(const char *name) {
+  Highs &highs = *_highs;
+  _nb_lp_iterations = 0;
+  set_lp_basis();
+
+  auto read_values = [this, &highs]() {
+    const HighsSolution &solution = highs.getSolution();
+    const std::vector<double> &values = (_variant == LPVariant::Primal)
+                                            ? solution.col_value
+                                            : solution.row_dual;
+    if (values.size() < _non_goal_states.size()) {
+      return false;
+    }
+    for (auto *sn : _non_goal_states) {
+      sn->best_value = values[sn->index];
+    }
+    return true;
+  };
+
+  HighsModelStatus model_status = HighsModelStatus::kNotset;
+
   if (_lp_callback_interval > 0) {
     struct LPInterruptData {
       std::size_t interval;
@@ -948,44 +990,117 @@ void SK_SSPLP_CLASS::solve_dual_lp(const State &s0) {
 
     while (true) {
       highs.run();
-      auto ms = highs.getModelStatus();
-      if (ms == HighsModelStatus::kOptimal)
+      _nb_lp_iterations += highs.getInfo().simplex_iteration_count;
+      model_status = highs.getModelStatus();
+      if (model_status == HighsModelStatus::kOptimal)
         break;
 
-      if (ms == HighsModelStatus::kInfeasible ||
-          ms == HighsModelStatus::kUnbounded ||
-          ms == HighsModelStatus::kSolveError) {
-        throw std::runtime_error("SSPLP dual LP failed: " +
-                                 highs.modelStatusToString(ms));
+      if (model_status == HighsModelStatus::kInfeasible ||
+          model_status == HighsModelStatus::kUnbounded ||
+          model_status == HighsModelStatus::kSolveError) {
+        highs.stopCallback(kCallbackSimplexInterrupt);
+        throw std::runtime_error(std::string(name) + " LP failed: " +
+                                 highs.modelStatusToString(model_status));
       }
 
-      const auto &row_dual = highs.getSolution().row_dual;
-      if (!row_dual.empty()) {
-        for (std::size_t i = 0; i < _non_goal_states.size(); ++i) {
-          _non_goal_states[i]->best_value = row_dual[i];
-        }
+      if (read_values()) {
         extract_policy_from_values();
         _last_callback_event = LPCallbackEvent::LPProgress;
         if (_callback(*this, _domain))
           break;
       }
     }
+
+    highs.stopCallback(kCallbackSimplexInterrupt);
   } else {
     highs.run();
-    HighsModelStatus dual_model_status = highs.getModelStatus();
-    if (dual_model_status != HighsModelStatus::kOptimal) {
-      throw std::runtime_error("SSPLP dual LP not optimal: " +
-                               highs.modelStatusToString(dual_model_status));
+    _nb_lp_iterations = highs.getInfo().simplex_iteration_count;
+    model_status = highs.getModelStatus();
+    if (model_status != HighsModelStatus::kOptimal) {
+      throw std::runtime_error(std::string(name) + " LP not optimal: " +
+                               highs.modelStatusToString(model_status));
     }
   }
 
-  // V*(s) = row dual of flow conservation constraint (LP strong duality)
-  const std::vector<double> &row_duals = highs.getSolution().row_dual;
-  for (std::size_t i = 0; i < _non_goal_states.size(); ++i) {
-    _non_goal_states[i]->best_value = row_duals[i];
+  read_values();
+
+  if (model_status == HighsModelStatus::kOptimal) {
+    record_lp_basis();
   }
+}
 
-  extract_policy_from_values();
+// Starts the LP from the basis recorded at the end of the previous solve:
+// the states (resp. actions) not in the previous LP get a nonbasic column in
+// the primal (resp. dual) and a basic row in the dual (resp. primal), which
+// keeps as many basic variables as rows
+SK_SSPLP_TEMPLATE_DECL
+void SK_SSPLP_CLASS::set_lp_basis() {
+  if (!_warm_start || _lp_basis.empty()) {
+    return;
+  }
+
+  bool primal = (_variant == LPVariant::Primal);
+  HighsBasis basis;
+  std::vector<HighsBasisStatus> &state_status =
+      primal ? basis.col_status : basis.row_status;
+  std::vector<HighsBasisStatus> &action_status =
+      primal ? basis.row_status : basis.col_status;
+  HighsBasisStatus new_state_status =
+      primal ? HighsBasisStatus::kLower : HighsBasisStatus::kBasic;
+  HighsBasisStatus new_action_status =
+      primal ? HighsBasisStatus::kBasic : HighsBasisStatus::kLower;
+  std::size_t nb_recorded = 0;
+
+  for (auto *sn : _non_goal_states) {
+    auto it = _lp_basis.find(sn->state);
+    if (it == _lp_basis.end()) {
+      state_status.push_back(new_state_status);
+      action_status.insert(action_status.end(), sn->actions.size(),
+                           new_action_status);
+      continue;
+    }
+    nb_recorded++;
+    state_status.push_back(it->second.state_status);
+    std::size_t a = 0;
+    for (std::size_t i = 0; i < sn->actions.size(); i++) {
+      action_status.push_back(a < it->second.action_status.size()
+                                  ? it->second.action_status[a++]
+                                  : new_action_status);
+    }
+  }
+
+  basis.valid = true;
+  basis.alien = false;
+  if (nb_recorded == 0 || _highs->setBasis(basis) != HighsStatus::kOk) {
+    if (_verbose) {
+      Logger::debug("SSPLP: previous basis does not fit the LP, cold start");
+    }
+  }
+}
+
+SK_SSPLP_TEMPLATE_DECL
+void SK_SSPLP_CLASS::record_lp_basis() {
+  _lp_basis.clear();
+  const HighsBasis &basis = _highs->getBasis();
+  if (!_warm_start || !basis.valid) {
+    return;
+  }
+
+  bool primal = (_variant == LPVariant::Primal);
+  const std::vector<HighsBasisStatus> &state_status =
+      primal ? basis.col_status : basis.row_status;
+  const std::vector<HighsBasisStatus> &action_status =
+      primal ? basis.row_status : basis.col_status;
+  std::size_t a = 0;
+
+  for (auto *sn : _non_goal_states) {
+    LPBasisRecord &record = _lp_basis[sn->state];
+    record.state_status = state_status[sn->index];
+    record.action_status.assign(
+        action_status.begin() + a,
+        action_status.begin() + a + sn->actions.size());
+    a += sn->actions.size();
+  }
 }
 
 SK_SSPLP_TEMPLATE_DECL
@@ -1091,6 +1206,11 @@ std::size_t SK_SSPLP_CLASS::get_nb_lp_constraints() const {
   return _nb_lp_constraints;
 }
 
+SK_SSPLP_TEMPLATE_DECL
+std::size_t SK_SSPLP_CLASS::get_nb_lp_iterations() const {
+  return _nb_lp_iterations;
+}
+
 SK_SSPLP_TEMPLATE_DECL
 std::size_t SK_SSPLP_CLASS::get_solving_time() const {
   return static_cast<std::size_t>(
@@ -1122,6 +1242,7 @@ std::unique_ptr<SK_MDPLP_CLASS> SK_MDPLP_CLASS::create_from_params(
       params.template get<double>("discount", 0.99),
       params.template get<double>("epsilon", 0.001),
       params.template get<double>("lp_infinity", 1e20), std::size_t(0),
+      params.template get<bool>("warm_start", true),
       CallbackFunctor([](const MDPLPSolver &, Domain &) { return false; }),
       params.template get<bool>("verbose", verbose));
 }
@@ -1138,6 +1259,7 @@ std::unique_ptr<SK_SSPLP_CLASS> SK_SSPLP_CLASS::create_from_params(
       domain, goal_checker, heuristic, LPVariant::Dual,
       params.template get<double>("epsilon", 0.001),
       params.template get<double>("lp_infinity", 1e20), std::size_t(0),
+      params.template get<bool>("warm_start", true),
       CallbackFunctor([](const SSPLPSolver &, Domain &) { return false; }),
       params.template get<bool>("verbose", verbose));
 }
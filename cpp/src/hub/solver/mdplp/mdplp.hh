@@ -14,6 +14,7 @@
 #include <tuple>
 #include <vector>
 
+#include "Highs.h"
 #include "utils/associative_container_deducer.hh"
 #include "utils/execution.hh"
 #include "utils/logging.hh"
@@ -37,7 +38,18 @@ inline LPVariant lp_variant_from_string(const std::string &s) {
  *
  * Enumerates the full reachable state space via BFS, then solves a linear
  * program using HiGHS. Supports both primal (value variables) and dual
- * (occupation measure) formulations.
+ * (occupation measure) formulations. The LP is assembled directly in
+ * compressed sparse row (primal) or column (dual) arrays and passed to HiGHS
+ * in a single call.
+ *
+ * The HiGHS instance is kept between calls to solve(), and so is the optimal
+ * basis of the last LP, recorded per state (and per action of each state).
+ * The next LP starts from this basis, completed with slack rows and
+ * nonbasic columns for the new states and actions. This lets small changes
+ * of the domain (e.g. new costs after clear(), or extra states reachable from
+ * another initial state) re-solve in a few simplex iterations. If the basis
+ * does not fit the new LP (e.g. states removed or actions reordered), HiGHS
+ * starts from scratch.
  *
  * @tparam Tdomain Domain type
  * @tparam Texecution_policy Execution policy
@@ -81,6 +93,8 @@ public:
    * @param lp_callback_interval Fire the callback every N simplex iterations
    *   during the LP solve, reporting intermediate values. 0 disables LP-level
    *   callbacks. Defaults to 0.
+   * @param warm_start Whether to start each LP from the optimal basis of the
+   *   previous solve() (kept across clear()). Defaults to true.
    * @param callback Functor called after solving or during LP iterations;
    *   return true to stop early. Defaults to never stop.
    * @param verbose Whether to log progress messages. Defaults to false.
@@ -91,7 +105,7 @@ public:
           [](const State &) { return Value(0.0, false); },
       LPVariant variant = LPVariant::Dual, double discount = 0.99,
       double epsilon = 0.001, double lp_infinity = 1e20,
-      std::size_t lp_callback_interval = 0,
+      std::size_t lp_callback_interval = 0, bool warm_start = true,
       const CallbackFunctor &callback = [](const MDPLPSolver &,
                                            Domain &) { return false; },
       bool verbose = false);
@@ -106,6 +120,7 @@ public:
   std::size_t get_nb_states() const;
   std::size_t get_nb_lp_variables() const;
   std::size_t get_nb_lp_constraints() const;
+  std::size_t get_nb_lp_iterations() const;
   std::size_t get_solving_time() const;
   typename SetTypeDeducer<State>::Set get_explored_states() const;
   LPCallbackEvent get_callback_event() const { return _last_callback_event; }
@@ -127,6 +142,7 @@ private:
   double _epsilon;
   double _lp_infinity;
   std::size_t _lp_callback_interval;
+  bool _warm_start;
   CallbackFunctor _callback;
   bool _verbose;
   LPCallbackEvent _last_callback_event = LPCallbackEvent::SolverIteration;
@@ -164,12 +180,27 @@ private:
 
   std::size_t _nb_lp_variables;
   std::size_t _nb_lp_constraints;
+  std::size_t _nb_lp_iterations;
   std::chrono::time_point<std::chrono::high_resolution_clock> _start_time;
 
+  // Basis status of the LP column or row of a state (value variable in the
+  // primal, flow conservation row in the dual) and of the rows or columns of
+  // its actions (Bellman rows in the primal, occupation measures in the dual)
+  struct LPBasisRecord {
+    HighsBasisStatus state_status;
+    std::vector<HighsBasisStatus> action_status;
+  };
+
+  std::unique_ptr<Highs> _highs;
+  typename MapTypeDeducer<State, LPBasisRecord>::Map _lp_basis;
+
   void enumerate_reachable_states(const State &s);
-  void expand(StateNode &s);
+  std::vector<StateNode *> expand_layer(const std::vector<StateNode *> &layer);
   void solve_primal_lp();
   void solve_dual_lp(const State &s0);
+  void run_lp(const char *name);
+  void set_lp_basis();
+  void record_lp_basis();
   void extract_policy_from_values();
 };
 
@@ -178,7 +209,8 @@ private:
  *
  * Like MDPLPSolver but for Stochastic Shortest Path problems: discount=1,
  * goal states with V(g)=0, positive costs. The LP is feasible when a proper
- * policy exists (all states can reach a goal).
+ * policy exists (all states can reach a goal). The LP is built in bulk and
+ * warm-started from the basis of the previous solve() like in MDPLPSolver.
  */
 template <typename Tdomain, typename Texecution_policy = SequentialExecution>
 class SSPLPSolver {
@@ -216,6 +248,8 @@ public:
    * @param lp_callback_interval Fire the callback every N simplex iterations
    *   during the LP solve, reporting intermediate values. 0 disables LP-level
    *   callbacks. Defaults to 0.
+   * @param warm_start Whether to start each LP from the optimal basis of the
+   *   previous solve() (kept across clear()). Defaults to true.
    * @param callback Functor called after solving or during LP iterations;
    *   return true to stop early. Defaults to never stop.
    * @param verbose Whether to log progress messages. Defaults to false.
@@ -224,7 +258,7 @@ public:
       Domain &domain, const GoalCheckerFunctor &goal_checker,
       const HeuristicFunctor &heuristic, LPVariant variant = LPVariant::Dual,
       double epsilon = 0.001, double lp_infinity = 1e20,
-      std::size_t lp_callback_interval = 0,
+      std::size_t lp_callback_interval = 0, bool warm_start = true,
       const CallbackFunctor &callback = [](const SSPLPSolver &,
                                            Domain &) { return false; },
       bool verbose = false);
@@ -239,6 +273,7 @@ public:
   std::size_t get_nb_states() const;
   std::size_t get_nb_lp_variables() const;
   std::size_t get_nb_lp_constraints() const;
+  std::size_t get_nb_lp_iterations() const;
   std::size_t get_solving_time() const;
   typename SetTypeDeducer<State>::Set get_explored_states() const;
   LPCallbackEvent get_callback_event() const { return _last_callback_event; }
@@ -259,6 +294,7 @@ private:
   double _epsilon;
   double _lp_infinity;
   std::size_t _lp_callback_interval;
+  bool _warm_start;
   CallbackFunctor _callback;
   bool _verbose;
   LPCallbackEvent _last_callback_event = LPCallbackEvent::SolverIteration;
@@ -297,12 +333,27 @@ private:
 
   std::size_t _nb_lp_variables;
   std::size_t _nb_lp_constraints;
+  std::size_t _nb_lp_iterations;
   std::chrono::time_point<std::chrono::high_resolution_clock> _start_time;
 
+  // Basis status of the LP column or row of a state (value variable in the
+  // primal, flow conservation row in the dual) and of the rows or columns of
+  // its actions (Bellman rows in the primal, occupation measures in the dual)
+  struct LPBasisRecord {
+    HighsBasisStatus state_status;
+    std::vector<HighsBasisStatus> action_status;
+  };
+
+  std::unique_ptr<Highs> _highs;
+  typename MapTypeDeducer<State, LPBasisRecord>::Map _lp_basis;
+
   void enumerate_reachable_states(const State &s);
-  void expand(StateNode &s);
+  std::vector<StateNode *> expand_layer(const std::vector<StateNode *> &layer);
   void solve_primal_lp();
   void solve_dual_lp(const State &s0);
+  void run_lp(const char *name);
+  void set_lp_basis();
+  void record_lp_basis();
   void extract_policy_from_values();
 };
 
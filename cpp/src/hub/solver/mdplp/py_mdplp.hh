@@ -38,6 +38,7 @@ private:
     virtual py::int_ get_nb_states() = 0;
     virtual py::int_ get_nb_lp_variables() = 0;
     virtual py::int_ get_nb_lp_constraints() = 0;
+    virtual py::int_ get_nb_lp_iterations() = 0;
     virtual py::int_ get_solving_time() = 0;
     virtual py::set get_explored_states() = 0;
     virtual py::str get_callback_event() = 0;
@@ -57,7 +58,7 @@ private:
             &heuristic,
         const std::function<py::object(const py::object &)> &terminal_value,
         const std::string &variant_str, double discount, double epsilon,
-        double lp_infinity, std::size_t lp_callback_interval,
+        double lp_infinity, std::size_t lp_callback_interval, bool warm_start,
         const std::function<py::bool_(const py::object &)> &callback,
         bool verbose)
         : _heuristic(heuristic), _terminal_value(terminal_value),
@@ -95,7 +96,7 @@ private:
             }
           },
           lp_variant_from_string(variant_str), discount, epsilon, lp_infinity,
-          lp_callback_interval,
+          lp_callback_interval, warm_start,
           [this](const MDPLPSolver<Domain, Texecution> &, Domain &) -> bool {
             if (_callback) {
               try {
@@ -158,6 +159,9 @@ private:
     virtual py::int_ get_nb_lp_constraints() {
       return _solver->get_nb_lp_constraints();
     }
+    virtual py::int_ get_nb_lp_iterations() {
+      return _solver->get_nb_lp_iterations();
+    }
     virtual py::int_ get_solving_time() { return _solver->get_solving_time(); }
     virtual py::set get_explored_states() {
       py::set s;
@@ -232,14 +236,15 @@ public:
       const std::function<py::object(const py::object &)> &terminal_value,
       const std::string &variant = "dual", double discount = 0.99,
       double epsilon = 0.001, double lp_infinity = 1e20,
-      std::size_t lp_callback_interval = 0, bool parallel = false,
+      std::size_t lp_callback_interval = 0, bool warm_start = true,
+      bool parallel = false,
       const std::function<py::bool_(const py::object &)> &callback = nullptr,
       bool verbose = false) {
     TemplateInstantiator::select(ExecutionSelector(parallel),
                                  SolverInstantiator(_implementation))
         .instantiate(solver, domain, heuristic, terminal_value, variant,
                      discount, epsilon, lp_infinity, lp_callback_interval,
-                     callback, verbose);
+                     warm_start, callback, verbose);
   }
 
   void close() { _implementation->close(); }
@@ -265,6 +270,9 @@ public:
   py::int_ get_nb_lp_constraints() {
     return _implementation->get_nb_lp_constraints();
   }
+  py::int_ get_nb_lp_iterations() {
+    return _implementation->get_nb_lp_iterations();
+  }
   py::int_ get_solving_time() { return _implementation->get_solving_time(); }
   py::set get_explored_states() {
     return _implementation->get_explored_states();
@@ -290,6 +298,7 @@ private:
     virtual py::int_ get_nb_states() = 0;
     virtual py::int_ get_nb_lp_variables() = 0;
     virtual py::int_ get_nb_lp_constraints() = 0;
+    virtual py::int_ get_nb_lp_iterations() = 0;
     virtual py::int_ get_solving_time() = 0;
     virtual py::set get_explored_states() = 0;
     virtual py::str get_callback_event() = 0;
@@ -311,7 +320,7 @@ private:
         const std::function<py::object(const py::object &, const py::object &)>
             &heuristic,
         const std::string &variant_str, double epsilon, double lp_infinity,
-        std::size_t lp_callback_interval,
+        std::size_t lp_callback_interval, bool warm_start,
         const std::function<py::bool_(const py::object &)> &callback,
         bool verbose)
         : _goal_checker(goal_checker), _heuristic(heuristic),
@@ -354,7 +363,7 @@ private:
             }
           },
           lp_variant_from_string(variant_str), epsilon, lp_infinity,
-          lp_callback_interval,
+          lp_callback_interval, warm_start,
           [this](const SSPLPSolver<Domain, Texecution> &, Domain &) -> bool {
             if (_callback) {
               try {
@@ -417,6 +426,9 @@ private:
     virtual py::int_ get_nb_lp_constraints() {
       return _solver->get_nb_lp_constraints();
     }
+    virtual py::int_ get_nb_lp_iterations() {
+      return _solver->get_nb_lp_iterations();
+    }
     virtual py::int_ get_solving_time() { return _solver->get_solving_time(); }
     virtual py::set get_explored_states() {
       py::set s;
@@ -493,13 +505,14 @@ public:
           &heuristic,
       const std::string &variant = "dual", double epsilon = 0.001,
       double lp_infinity = 1e20, std::size_t lp_callback_interval = 0,
-      bool parallel = false,
+      bool warm_start = true, bool parallel = false,
       const std::function<py::bool_(const py::object &)> &callback = nullptr,
       bool verbose = false) {
     TemplateInstantiator::select(ExecutionSelector(parallel),
                                  SolverInstantiator(_implementation))
         .instantiate(solver, domain, goal_checker, heuristic, variant, epsilon,
-                     lp_infinity, lp_callback_interval, callback, verbose);
+                     lp_infinity, lp_callback_interval, warm_start, callback,
+                     verbose);
   }
 
   void close() { _implementation->close(); }
@@ -525,6 +538,9 @@ public:
   py::int_ get_nb_lp_constraints() {
     return _implementation->get_nb_lp_constraints();
   }
+  py::int_ get_nb_lp_iterations() {
+    return _implementation->get_nb_lp_iterations();
+  }
   py::int_ get_solving_time() { return _implementation->get_solving_time(); }
   py::set get_explored_states() {
     return _implementation->get_explored_states();
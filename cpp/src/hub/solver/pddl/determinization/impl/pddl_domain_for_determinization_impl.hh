@@ -12,9 +12,13 @@ namespace skdecide {
 namespace pddl {
 
 inline PddlDomainForDeterminization::PddlDomainForDeterminization(
-    const Task &task)
+    const Task &task, std::size_t max_packed_facts)
     : _task(task), _aops_gen(task), _succ_gen(task) {
   _total_cost_idx = task.total_cost_function();
+  if (task.fact_index().num_facts() <= max_packed_facts &&
+      task.fact_index().num_fluents() <= max_packed_facts) {
+    _fact_index = &task.fact_index();
+  }
 }
 
 inline PddlDomainForDeterminization::ActionSpace
@@ -35,8 +39,11 @@ PddlDomainForDeterminization::get_next_state_distribution(
   NextStateDistribution result;
   result._values.reserve(succs.size());
   for (auto &succ : succs) {
-    result._values.push_back(
-        {PddlState(std::move(succ.state)), succ.probability});
+    PddlState ns(std::move(succ.state));
+    if (_fact_index) {
+      ns.packed = _fact_index->pack(ns);
+    }
+    result._values.push_back({std::move(ns), succ.probability});
   }
   return result;
 }
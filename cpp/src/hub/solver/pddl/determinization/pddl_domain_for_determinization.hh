@@ -60,8 +60,12 @@ public:
   /**
    * @param task Parsed PPDDL task providing action schemas with stochastic
    *        effects, initial state, goal, and (optional) total-cost function.
+   * @param max_packed_facts Maximum number of ground atoms of the task's
+   *        fact index for states to carry a packed copy of their atoms and
+   *        fluents (0 disables packed states).
    */
-  PddlDomainForDeterminization(const Task &task);
+  PddlDomainForDeterminization(const Task &task,
+                               std::size_t max_packed_facts = 1 << 16);
 
   ActionSpace get_applicable_actions(const State &s) const;
   NextStateDistribution get_next_state_distribution(const State &s,
@@ -75,6 +79,7 @@ private:
   const Task &_task;
   mutable ApplicableActionsGenerator _aops_gen;
   mutable SuccessorGenerator _succ_gen;
+  const FactIndex *_fact_index = nullptr; // null if states are not packed
   int _total_cost_idx = -1;
 };
 
@@ -9,9 +9,23 @@ namespace skdecide {
 
 namespace pddl {
 
-inline PddlDeterministicDomain::PddlDeterministicDomain(const Task &task)
+inline PddlDeterministicDomain::PddlDeterministicDomain(
+    const Task &task, std::size_t max_packed_facts)
     : _task(task), _aops_gen(task), _succ_gen(task) {
   _total_cost_idx = task.total_cost_function();
+  if (task.fact_index().num_facts() <= max_packed_facts &&
+      task.fact_index().num_fluents() <= max_packed_facts) {
+    _fact_index = &task.fact_index();
+  }
+}
+
+inline PddlDeterministicDomain::State
+PddlDeterministicDomain::get_initial_state() const {
+  State s(_task.initial_state());
+  if (_fact_index) {
+    s.packed = _fact_index->pack(s);
+  }
+  return s;
 }
 
 inline PddlDeterministicDomain::ActionSpace
@@ -28,7 +42,11 @@ PddlDeterministicDomain::get_applicable_actions(const State &s) const {
 inline PddlDeterministicDomain::State
 PddlDeterministicDomain::get_next_state(const State &s, const Action &a) const {
   auto succs = _succ_gen.get_successors(s, a);
-  return State(std::move(succs[0].state));
+  State ns(std::move(succs[0].state));
+  if (_fact_index) {
+    ns.packed = _fact_index->pack(ns);
+  }
+  return ns;
 }
 
 inline PddlDeterministicDomain::Value
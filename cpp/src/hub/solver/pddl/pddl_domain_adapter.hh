@@ -5,10 +5,12 @@
 #ifndef SKDECIDE_PDDL_DOMAIN_ADAPTER_HH
 #define SKDECIDE_PDDL_DOMAIN_ADAPTER_HH
 
+#include <optional>
 #include <string>
 #include <vector>
 
 #include "hub/domain/pddl/semantics/applicable_actions_generator.hh"
+#include "hub/domain/pddl/semantics/packed_state.hh"
 #include "hub/domain/pddl/semantics/state.hh"
 #include "hub/domain/pddl/semantics/successor_generator.hh"
 #include "hub/domain/pddl/semantics/task.hh"
@@ -23,18 +25,29 @@ struct PddlState : State {
   PddlState(const State &s) : State(s) {}
   PddlState(State &&s) : State(std::move(s)) {}
 
+  // Grounded copy of the atoms and fluents, set by PddlDeterministicDomain
+  // when the fact index of the task is small enough: hashing then reads the
+  // cached Zobrist hash and comparing states compares bitset words
+  std::optional<PackedState> packed;
+
   struct Hash {
-    std::size_t operator()(const PddlState &s) const { return s.hash(); }
+    std::size_t operator()(const PddlState &s) const {
+      return s.packed ? s.State::hash(s.packed->hash) : s.State::hash();
+    }
   };
 
   struct Equal {
     bool operator()(const PddlState &a, const PddlState &b) const {
-      return a == b;
+      if (a.packed && b.packed) {
+        return *a.packed == *b.packed && a.time == b.time &&
+               a.active_durative_actions == b.active_durative_actions;
+      }
+      return static_cast<const State &>(a) == static_cast<const State &>(b);
     }
   };
 
   std::string print() const {
-    return "PddlState(hash=" + std::to_string(hash()) + ")";
+    return "PddlState(hash=" + std::to_string(Hash()(*this)) + ")";
   }
 };
 
@@ -96,9 +109,14 @@ public:
   /**
    * @param task Parsed PDDL task providing the action schemas, initial state,
    *        goal description, and (optional) total-cost numeric function.
+   * @param max_packed_facts Maximum number of ground atoms of the task's
+   *        fact index for states to carry a packed copy of their atoms and
+   *        fluents (0 disables packed states).
    */
-  PddlDeterministicDomain(const Task &task);
+  PddlDeterministicDomain(const Task &task,
+                          std::size_t max_packed_facts = 1 << 16);
 
+  State get_initial_state() const;
   ActionSpace get_applicable_actions(const State &s) const;
   State get_next_state(const State &s, const Action &a) const;
   const Task &task() const { return _task; }
@@ -109,6 +127,7 @@ private:
   const Task &_task;
   mutable ApplicableActionsGenerator _aops_gen;
   SuccessorGenerator _succ_gen;
+  const FactIndex *_fact_index = nullptr; // null if states are not packed
   int _total_cost_idx = -1;
 };
 
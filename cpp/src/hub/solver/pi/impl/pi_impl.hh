@@ -5,12 +5,13 @@
 #ifndef SKDECIDE_PI_IMPL_HH
 #define SKDECIDE_PI_IMPL_HH
 
-#include <queue>
 #include <cmath>
 #include <algorithm>
+#include <functional>
 #include <limits>
 #include <chrono>
 
+#include "utils/batched_domain_calls.hh"
 #include "utils/string_converter.hh"
 #include "utils/logging.hh"
 
@@ -28,7 +29,7 @@ namespace skdecide {
 SK_PI_SOLVER_TEMPLATE_DECL
 SK_PI_SOLVER_CLASS::StateNode::StateNode(const State &s)
     : state(s), best_action(nullptr), best_value(0.0), terminal(false),
-      dead_end(false), policy_changed(false) {}
+      dead_end(false), policy_changed(false), idx(IDX_UNDEF) {}
 
 SK_PI_SOLVER_TEMPLATE_DECL
 const typename SK_PI_SOLVER_CLASS::State &
@@ -50,11 +51,12 @@ SK_PI_SOLVER_CLASS::PISolver(Domain &domain, const HeuristicFunctor &heuristic,
                              const InitialPolicyFunctor &initial_policy,
                              double discount, double epsilon,
                              std::size_t max_eval_sweeps,
+                             PIEvaluationMode evaluation_mode,
                              const CallbackFunctor &callback, bool verbose)
     : _domain(domain), _heuristic(heuristic), _terminal_value(terminal_value),
       _initial_policy(initial_policy), _discount(discount), _epsilon(epsilon),
-      _max_eval_sweeps(max_eval_sweeps), _callback(callback), _verbose(verbose),
-      _nb_iterations(0) {
+      _max_eval_sweeps(max_eval_sweeps), _evaluation_mode(evaluation_mode),
+      _callback(callback), _verbose(verbose), _nb_iterations(0) {
   if (verbose) {
     Logger::check_level(logging::debug, "algorithm Policy Iteration");
   }
@@ -65,6 +67,16 @@ void SK_PI_SOLVER_CLASS::clear() {
   _graph.clear();
   _non_terminal_states.clear();
   _nb_iterations = 0;
+  _values.clear();
+  _policy.clear();
+  _first_action.clear();
+  _action_nodes.clear();
+  _expected_rewards.clear();
+  _first_outcome.clear();
+  _probabilities.clear();
+  _successors.clear();
+  _residuals.clear();
+  _row_blocks.clear();
 }
 
 // --- solve ---
@@ -83,18 +95,24 @@ void SK_PI_SOLVER_CLASS::solve(const State &s) {
                  StringConverter::from(_non_terminal_states.size()) +
                  " non-terminal)");
 
-    // Phase 2: initialize policy
+    // Phase 2: compile the transitions and initialize policy
+    compile_transitions();
     initialize_policy();
 
     // Phase 3: iterate policy evaluation and improvement
     _nb_iterations = 0;
     bool stable = false;
+    bool evaluated = false;
 
-    while (!stable && !_callback(*this, _domain)) {
+    // With discount < 1, modified policy iteration must carry on evaluating
+    // a stable policy until its evaluation converges; with discount = 1, the
+    // evaluation of a stable improper policy would never converge
+    while (!(stable && (evaluated || _discount >= 1.0)) &&
+           !_callback(*this, _domain)) {
       _nb_iterations++;
 
-      // Policy evaluation: Gauss-Seidel sweeps until V^pi converges
-      evaluate_policy();
+      // Policy evaluation: solve (I - gamma * P_pi) V^pi = R_pi
+      evaluated = evaluate_policy();
 
       // Policy improvement: greedy action selection
       stable = !improve_policy();
@@ -125,7 +143,7 @@ void SK_PI_SOLVER_CLASS::enumerate_reachable_states(const State &s) {
   if (_verbose)
     Logger::debug("Enumerating reachable states from " + s.print());
 
-  std::queue<StateNode *> frontier;
+  std::vector<StateNode *> layer;
 
   auto si = _graph.emplace(s);
   StateNode &root = const_cast<StateNode &>(*(si.first));
@@ -135,30 +153,14 @@ void SK_PI_SOLVER_CLASS::enumerate_reachable_states(const State &s) {
       root.best_value = _terminal_value(s).reward();
     } else {
       root.best_value = _heuristic(_domain, s).reward();
-      frontier.push(&root);
+      layer.push_back(&root);
     }
   } else if (root.actions.empty() && !root.terminal && !root.dead_end) {
-    frontier.push(&root);
+    layer.push_back(&root);
   }
 
-  while (!frontier.empty()) {
-    StateNode *current = frontier.front();
-    frontier.pop();
-
-    if (current->terminal || current->dead_end || !current->actions.empty()) {
-      continue;
-    }
-
-    expand(*current);
-
-    for (const auto &an : current->actions) {
-      for (const auto &outcome : an->outcomes) {
-        StateNode *ns = std::get<2>(outcome);
-        if (ns->actions.empty() && !ns->terminal && !ns->dead_end) {
-          frontier.push(ns);
-        }
-      }
-    }
+  while (!layer.empty()) {
+    layer = expand_layer(layer);
   }
 
   _non_terminal_states.clear();
@@ -170,62 +172,172 @@ void SK_PI_SOLVER_CLASS::enumerate_reachable_states(const State &s) {
   }
 }
 
-// --- expand (same as VI) ---
+// --- expand_layer (same as VI) ---
 
 SK_PI_SOLVER_TEMPLATE_DECL
-void SK_PI_SOLVER_CLASS::expand(StateNode &s) {
+std::vector<typename SK_PI_SOLVER_CLASS::StateNode *>
+SK_PI_SOLVER_CLASS::expand_layer(const std::vector<StateNode *> &layer) {
   if (_verbose)
-    Logger::debug("Expanding state " + s.state.print());
-
-  auto applicable_actions =
-      _domain.get_applicable_actions(s.state).get_elements();
-
-  std::for_each(
-      ExecutionPolicy::policy, applicable_actions.begin(),
-      applicable_actions.end(), [this, &s](auto a) {
-        if (_verbose)
-          Logger::debug("Current expanded action: " + a.print() +
-                        ExecutionPolicy::print_thread());
-        _execution_policy.protect(
-            [&s, &a] { s.actions.push_back(std::make_unique<ActionNode>(a)); });
-        ActionNode &an = *(s.actions.back());
-        auto next_states =
-            _domain.get_next_state_distribution(s.state, a).get_values();
-
-        for (auto ns : next_states) {
+    Logger::debug("Expanding BFS layer of " +
+                  StringConverter::from(layer.size()) + " states");
+
+  std::vector<const State *> states(layer.size());
+  std::transform(layer.begin(), layer.end(), states.begin(),
+                 [](StateNode *sn) { return &(sn->state); });
+
+  for_each_applicable_actions<ExecutionPolicy>(
+      _domain, states, [this, &layer](const std::size_t &i, auto &actions) {
+        StateNode &s = *layer[i];
+        for (const auto &a : actions.get_elements()) {
+          if (_verbose)
+            Logger::debug("Current expanded action: " + a.print() +
+                          " in state " + s.state.print() +
+                          ExecutionPolicy::print_thread());
+          s.actions.push_back(std::make_unique<ActionNode>(a));
+        }
+      });
+
+  std::vector<const State *> tr_states;
+  std::vector<const Action *> tr_actions;
+  std::vector<ActionNode *> tr_nodes;
+  for (auto *sn : layer) {
+    for (const auto &an : sn->actions) {
+      tr_states.push_back(&(sn->state));
+      tr_actions.push_back(&(an->action));
+      tr_nodes.push_back(an.get());
+    }
+  }
+
+  std::vector<StateNode *> new_nodes;
+  for_each_next_state_distribution<ExecutionPolicy>(
+      _domain, tr_states, tr_actions,
+      [this, &tr_nodes, &new_nodes](const std::size_t &i, auto &distribution) {
+        ActionNode &an = *tr_nodes[i];
+        for (auto ns : distribution.get_values()) {
           if (_verbose)
             Logger::debug("Current next state expansion: " +
                           ns.state().print() + ExecutionPolicy::print_thread());
-          std::pair<typename Graph::iterator, bool> i;
+          std::pair<typename Graph::iterator, bool> si;
           _execution_policy.protect(
-              [this, &i, &ns] { i = _graph.emplace(ns.state()); });
-          StateNode &next_node = const_cast<StateNode &>(*(i.first));
-          an.outcomes.push_back(std::make_tuple(
-              ns.probability(),
-              _domain.get_transition_value(s.state, a, next_node.state)
-                  .reward(),
-              &next_node));
-
-          if (i.second) { // new node
-            if (_domain.is_terminal(next_node.state)) {
-              if (_verbose)
-                Logger::debug("Found terminal state " +
-                              next_node.state.print() +
-                              ExecutionPolicy::print_thread());
-              next_node.terminal = true;
-              next_node.best_value = _terminal_value(next_node.state).reward();
-            } else {
-              next_node.best_value =
-                  _heuristic(_domain, next_node.state).reward();
-              if (_verbose)
-                Logger::debug("New state " + next_node.state.print() +
-                              " with initial value " +
-                              StringConverter::from(next_node.best_value) +
-                              ExecutionPolicy::print_thread());
-            }
+              [this, &si, &ns] { si = _graph.emplace(ns.state()); });
+          StateNode &next_node = const_cast<StateNode &>(*(si.first));
+          an.outcomes.push_back(
+              std::make_tuple(ns.probability(), 0.0, &next_node));
+          if (si.second) { // new node
+            _execution_policy.protect(
+                [&new_nodes, &next_node] { new_nodes.push_back(&next_node); });
           }
         }
       });
+
+  std::vector<const State *> v_states;
+  std::vector<const Action *> v_actions;
+  std::vector<const State *> v_next_states;
+  std::vector<std::tuple<double, double, StateNode *> *> v_outcomes;
+  for (std::size_t i = 0; i < tr_nodes.size(); i++) {
+    for (auto &o : tr_nodes[i]->outcomes) {
+      v_states.push_back(tr_states[i]);
+      v_actions.push_back(tr_actions[i]);
+      v_next_states.push_back(&(std::get<2>(o)->state));
+      v_outcomes.push_back(&o);
+    }
+  }
+
+  for_each_transition_value<ExecutionPolicy>(
+      _domain, v_states, v_actions, v_next_states,
+      [&v_outcomes](const std::size_t &i, auto &value) {
+        std::get<1>(*v_outcomes[i]) = value.reward();
+      });
+
+  std::vector<const State *> new_states(new_nodes.size());
+  std::transform(new_nodes.begin(), new_nodes.end(), new_states.begin(),
+                 [](StateNode *sn) { return &(sn->state); });
+  std::vector<StateNode *> next_layer;
+
+  for_each_terminal<ExecutionPolicy>(
+      _domain, new_states,
+      [this, &new_nodes, &next_layer](const std::size_t &i, bool terminal) {
+        StateNode &next_node = *new_nodes[i];
+        if (terminal) {
+          if (_verbose)
+            Logger::debug("Found terminal state " + next_node.state.print() +
+                          ExecutionPolicy::print_thread());
+          next_node.terminal = true;
+          next_node.best_value = _terminal_value(next_node.state).reward();
+        } else {
+          next_node.best_value = _heuristic(_domain, next_node.state).reward();
+          if (_verbose)
+            Logger::debug("New state " + next_node.state.print() +
+                          " with initial value " +
+                          StringConverter::from(next_node.best_value) +
+                          ExecutionPolicy::print_thread());
+          _execution_policy.protect(
+              [&next_layer, &next_node] { next_layer.push_back(&next_node); });
+        }
+      });
+
+  return next_layer;
+}
+
+// --- compile_transitions ---
+
+SK_PI_SOLVER_TEMPLATE_DECL
+void SK_PI_SOLVER_CLASS::compile_transitions() {
+  std::size_t nb_states = 0;
+  for (auto *sn : _non_terminal_states) {
+    sn->idx = nb_states++;
+  }
+  for (auto &sn : _graph) {
+    StateNode &node = const_cast<StateNode &>(sn);
+    if (node.terminal || node.dead_end) {
+      node.idx = nb_states++;
+    }
+  }
+
+  _values = std::vector<atomic_double>(nb_states);
+  for (const auto &sn : _graph) {
+    _values[sn.idx] = (double)sn.best_value;
+  }
+
+  _first_action.assign(1, 0);
+  _action_nodes.clear();
+  _expected_rewards.clear();
+  _first_outcome.assign(1, 0);
+  _probabilities.clear();
+  _successors.clear();
+
+  for (auto *sn : _non_terminal_states) {
+    for (const auto &an : sn->actions) {
+      double expected_reward = 0.0;
+      for (const auto &outcome : an->outcomes) {
+        expected_reward += std::get<0>(outcome) * std::get<1>(outcome);
+        _probabilities.push_back(std::get<0>(outcome));
+        _successors.push_back(std::get<2>(outcome)->idx);
+      }
+      _action_nodes.push_back(an.get());
+      _expected_rewards.push_back(expected_reward);
+      _first_outcome.push_back(_probabilities.size());
+    }
+    _first_action.push_back(_action_nodes.size());
+  }
+
+  _policy.assign(_non_terminal_states.size(), IDX_UNDEF);
+  _residuals.assign(_non_terminal_states.size(), 0.0);
+
+  // Blocks of consecutive rows processed by the same thread
+  static constexpr std::size_t block_size = 256;
+  _row_blocks.clear();
+  for (std::size_t i = 0; i < _non_terminal_states.size(); i += block_size) {
+    _row_blocks.push_back(std::make_pair(
+        i, std::min(i + block_size, _non_terminal_states.size())));
+  }
+
+  if (_verbose) {
+    Logger::debug("Policy Iteration: compiled " +
+                  StringConverter::from(_action_nodes.size()) +
+                  " actions and " +
+                  StringConverter::from(_probabilities.size()) + " outcomes");
+  }
 }
 
 // --- initialize_policy ---
@@ -233,115 +345,321 @@ void SK_PI_SOLVER_CLASS::expand(StateNode &s) {
 SK_PI_SOLVER_TEMPLATE_DECL
 void SK_PI_SOLVER_CLASS::initialize_policy() {
   for (auto *sn : _non_terminal_states) {
-    if (sn->dead_end || sn->actions.empty()) {
+    std::size_t i = sn->idx;
+    if (_first_action[i] == _first_action[i + 1]) {
       continue;
     }
 
+    _policy[i] = _first_action[i];
     if (_initial_policy) {
       Action target = _initial_policy(_domain, sn->state);
-      sn->best_action = nullptr;
-      for (const auto &an : sn->actions) {
-        if (typename Action::Equal()(an->action, target)) {
-          sn->best_action = an.get();
+      for (std::size_t a = _first_action[i]; a < _first_action[i + 1]; a++) {
+        if (typename Action::Equal()(_action_nodes[a]->action, target)) {
+          _policy[i] = a;
           break;
         }
       }
-      if (sn->best_action == nullptr) {
-        sn->best_action = sn->actions.front().get();
-      }
-    } else {
-      sn->best_action = sn->actions.front().get();
     }
+    sn->best_action = _action_nodes[_policy[i]];
   }
 }
 
-// --- evaluate_policy (Gauss-Seidel sweeps on current policy) ---
+// --- evaluate_policy (returns true if the evaluation converged) ---
 
 SK_PI_SOLVER_TEMPLATE_DECL
 bool SK_PI_SOLVER_CLASS::evaluate_policy() {
   bool converged = false;
+
+  if (_evaluation_mode == PIEvaluationMode::BiCGSTAB) {
+    converged = bicgstab_evaluation();
+    if (!converged) {
+      if (_verbose) {
+        Logger::debug("Policy Iteration: BiCGSTAB did not converge, falling "
+                      "back to Gauss-Seidel sweeps");
+      }
+      converged = gauss_seidel_evaluation();
+    }
+  } else {
+    converged = gauss_seidel_evaluation();
+  }
+
+  copy_values();
+  return converged;
+}
+
+// --- gauss_seidel_evaluation (in-place sweeps on current policy) ---
+
+SK_PI_SOLVER_TEMPLATE_DECL
+bool SK_PI_SOLVER_CLASS::gauss_seidel_evaluation() {
+  const double discount = _discount;
   std::size_t sweep = 0;
 
-  while (!converged) {
+  while (true) {
     sweep++;
+
+    for_each_row([this, &discount](const std::size_t &i) {
+      std::size_t a = _policy[i];
+      if (a == IDX_UNDEF) {
+        _residuals[i] = 0.0;
+        return;
+      }
+
+      double v = 0.0;
+      for (std::size_t o = _first_outcome[a]; o < _first_outcome[a + 1]; o++) {
+        v += _probabilities[o] * _values[_successors[o]];
+      }
+      v = _expected_rewards[a] + (discount * v);
+      _residuals[i] = std::abs(v - _values[i]);
+      _values[i] = v;
+    });
+
     double max_residual = 0.0;
+    for (const auto &r : _residuals) {
+      max_residual = std::max(max_residual, r);
+    }
 
-    std::for_each(
-        ExecutionPolicy::policy, _non_terminal_states.begin(),
-        _non_terminal_states.end(), [this, &max_residual](StateNode *sn) {
-          if (sn->dead_end || sn->best_action == nullptr) {
-            return;
-          }
+    if (max_residual < _epsilon) {
+      return true;
+    }
 
-          double old_value = sn->best_value;
-          double new_value = 0.0;
+    if (_max_eval_sweeps > 0 && sweep >= _max_eval_sweeps) {
+      return false;
+    }
+  }
+}
 
-          for (const auto &outcome : sn->best_action->outcomes) {
-            double prob = std::get<0>(outcome);
-            double reward = std::get<1>(outcome);
-            StateNode *next = std::get<2>(outcome);
-            new_value += prob * (reward + _discount * next->best_value);
-          }
+// --- bicgstab_evaluation (Jacobi-preconditioned BiCGSTAB) ---
 
-          sn->best_value = new_value;
-          double residual = std::abs(new_value - old_value);
+SK_PI_SOLVER_TEMPLATE_DECL
+bool SK_PI_SOLVER_CLASS::bicgstab_evaluation() {
+  const std::size_t n = _non_terminal_states.size();
+  const double discount = _discount;
+  const double epsilon = _epsilon;
+
+  // Right-hand side R_pi plus the discounted values of the terminal and
+  // dead-end successors, and diagonal of (I - gamma * P_pi)
+  std::vector<double> x(n), b(n), diagonal(n);
+  for_each_row([this, &n, &discount, &x, &b, &diagonal](const std::size_t &i) {
+    x[i] = _values[i];
+    diagonal[i] = 1.0;
+    std::size_t a = _policy[i];
+    if (a == IDX_UNDEF) {
+      b[i] = x[i];
+      return;
+    }
 
-          _execution_policy.protect([&max_residual, &residual] {
-            max_residual = std::max(max_residual, residual);
-          });
-        });
+    b[i] = _expected_rewards[a];
+    for (std::size_t o = _first_outcome[a]; o < _first_outcome[a + 1]; o++) {
+      if (_successors[o] >= n) {
+        b[i] += discount * _probabilities[o] * _values[_successors[o]];
+      } else if (_successors[o] == i) {
+        diagonal[i] -= discount * _probabilities[o];
+      }
+    }
+    if (diagonal[i] <= std::numeric_limits<double>::epsilon()) {
+      diagonal[i] = 1.0; // absorbing self-loop with discount = 1
+    }
+  });
+
+  auto dot = [this](const std::vector<double> &u,
+                    const std::vector<double> &w) {
+    return reduce_rows([&u, &w](const std::size_t &i) { return u[i] * w[i]; },
+                       std::plus<double>(), 0.0);
+  };
+  auto max_norm = [this](const std::vector<double> &u) {
+    return reduce_rows(
+        [&u](const std::size_t &i) {
+          return std::isnan(u[i]) ? std::numeric_limits<double>::infinity()
+                                  : std::abs(u[i]);
+        },
+        [](const double &l, const double &r) { return std::max(l, r); }, 0.0);
+  };
+
+  std::vector<double> r(n), r0(n), p(n, 0.0), v(n, 0.0), ph(n), s(n), sh(n),
+      t(n);
+  policy_matrix_product(x, t);
+  for_each_row([&r, &r0, &b, &t](const std::size_t &i) {
+    r[i] = b[i] - t[i];
+    r0[i] = r[i];
+  });
+
+  // BiCGSTAB converges in at most n iterations in exact arithmetic
+  std::size_t max_iterations =
+      (_max_eval_sweeps > 0) ? _max_eval_sweeps
+                             : std::max<std::size_t>(2 * n, 100);
+  double rho = 1.0, alpha = 1.0, omega = 1.0;
+  bool converged = (max_norm(r) < epsilon);
+
+  for (std::size_t k = 0; !converged && k < max_iterations; k++) {
+    double next_rho = dot(r0, r);
+    if (next_rho == 0.0 || !std::isfinite(next_rho)) {
+      break; // breakdown
+    }
 
-    converged = (max_residual < _epsilon);
+    double beta = (next_rho / rho) * (alpha / omega);
+    for_each_row([&](const std::size_t &i) {
+      p[i] = r[i] + beta * (p[i] - omega * v[i]);
+      ph[i] = p[i] / diagonal[i];
+    });
+    policy_matrix_product(ph, v);
+
+    double r0v = dot(r0, v);
+    if (r0v == 0.0) {
+      break;
+    }
+    alpha = next_rho / r0v;
+    for_each_row([&](const std::size_t &i) {
+      s[i] = r[i] - alpha * v[i];
+      sh[i] = s[i] / diagonal[i];
+    });
+
+    if (max_norm(s) < epsilon) {
+      for_each_row([&](const std::size_t &i) { x[i] += alpha * ph[i]; });
+      converged = true;
+      break;
+    }
 
-    if (_discount >= 1.0 && _max_eval_sweeps > 0 && sweep >= _max_eval_sweeps) {
+    policy_matrix_product(sh, t);
+    double tt = dot(t, t);
+    if (tt == 0.0) {
       break;
     }
+    omega = dot(t, s) / tt;
+    for_each_row([&](const std::size_t &i) {
+      x[i] += alpha * ph[i] + omega * sh[i];
+      r[i] = s[i] - omega * t[i];
+    });
+
+    converged = (max_norm(r) < epsilon);
+    if (omega == 0.0) {
+      break;
+    }
+    rho = next_rho;
+  }
+
+  if (converged) {
+    // The recursively updated residual may drift from the true one
+    policy_matrix_product(x, t);
+    for_each_row([&r, &b, &t](const std::size_t &i) { r[i] = b[i] - t[i]; });
+    converged = (max_norm(r) < epsilon);
+  }
+
+  if (converged) {
+    for_each_row([this, &x](const std::size_t &i) { _values[i] = x[i]; });
   }
 
   return converged;
 }
 
+// --- policy_matrix_product (y = (I - gamma * P_pi) x on non-terminals) ---
+
+SK_PI_SOLVER_TEMPLATE_DECL
+void SK_PI_SOLVER_CLASS::policy_matrix_product(const std::vector<double> &x,
+                                               std::vector<double> &y) {
+  const std::size_t n = _non_terminal_states.size();
+  const double discount = _discount;
+
+  for_each_row([this, &n, &discount, &x, &y](const std::size_t &i) {
+    std::size_t a = _policy[i];
+    y[i] = x[i];
+    if (a == IDX_UNDEF) {
+      return;
+    }
+
+    double v = 0.0;
+    for (std::size_t o = _first_outcome[a]; o < _first_outcome[a + 1]; o++) {
+      if (_successors[o] < n) {
+        v += _probabilities[o] * x[_successors[o]];
+      }
+    }
+    y[i] -= discount * v;
+  });
+}
+
 // --- improve_policy (greedy action selection, returns true if changed) ---
 
 SK_PI_SOLVER_TEMPLATE_DECL
 bool SK_PI_SOLVER_CLASS::improve_policy() {
-  bool any_changed = false;
+  const double discount = _discount;
+  atomic_bool any_changed = false;
 
-  for (auto *sn : _non_terminal_states) {
-    if (sn->dead_end || sn->actions.empty()) {
-      continue;
+  for_each_row([this, &discount, &any_changed](const std::size_t &i) {
+    if (_first_action[i] == _first_action[i + 1]) {
+      return;
     }
 
+    StateNode *sn = _non_terminal_states[i];
     sn->policy_changed = false;
     double best_value = -std::numeric_limits<double>::infinity();
-    ActionNode *best_action = nullptr;
+    std::size_t best_action = IDX_UNDEF;
 
-    for (const auto &an : sn->actions) {
+    for (std::size_t a = _first_action[i]; a < _first_action[i + 1]; a++) {
       double q_value = 0.0;
-      for (const auto &outcome : an->outcomes) {
-        double prob = std::get<0>(outcome);
-        double reward = std::get<1>(outcome);
-        StateNode *next = std::get<2>(outcome);
-        q_value += prob * (reward + _discount * next->best_value);
+      for (std::size_t o = _first_outcome[a]; o < _first_outcome[a + 1]; o++) {
+        q_value += _probabilities[o] * _values[_successors[o]];
       }
-      an->value = q_value;
+      q_value = _expected_rewards[a] + (discount * q_value);
+      _action_nodes[a]->value = q_value;
 
       if (q_value > best_value) {
         best_value = q_value;
-        best_action = an.get();
+        best_action = a;
       }
     }
 
-    if (best_action != sn->best_action) {
-      sn->best_action = best_action;
+    if (best_action != _policy[i]) {
+      _policy[i] = best_action;
+      sn->best_action = _action_nodes[best_action];
       sn->policy_changed = true;
       any_changed = true;
     }
-  }
+  });
 
   return any_changed;
 }
 
+// --- copy_values (from the compiled transitions to the graph) ---
+
+SK_PI_SOLVER_TEMPLATE_DECL
+void SK_PI_SOLVER_CLASS::copy_values() {
+  for_each_row([this](const std::size_t &i) {
+    _non_terminal_states[i]->best_value = (double)_values[i];
+  });
+}
+
+// --- Row blocks ---
+
+SK_PI_SOLVER_TEMPLATE_DECL
+template <typename Function>
+void SK_PI_SOLVER_CLASS::for_each_row(const Function &f) {
+  std::for_each(ExecutionPolicy::policy, _row_blocks.begin(), _row_blocks.end(),
+                [&f](const std::pair<std::size_t, std::size_t> &block) {
+                  for (std::size_t i = block.first; i < block.second; i++) {
+                    f(i);
+                  }
+                });
+}
+
+SK_PI_SOLVER_TEMPLATE_DECL
+template <typename Function, typename Reduce>
+double SK_PI_SOLVER_CLASS::reduce_rows(const Function &f, const Reduce &reduce,
+                                       double init) {
+  std::vector<double> partials(_row_blocks.size(), init);
+  std::for_each(ExecutionPolicy::policy, _row_blocks.begin(), _row_blocks.end(),
+                [this, &f, &reduce, &partials](
+                    const std::pair<std::size_t, std::size_t> &block) {
+                  double &partial = partials[&block - _row_blocks.data()];
+                  for (std::size_t i = block.first; i < block.second; i++) {
+                    partial = reduce(partial, f(i));
+                  }
+                });
+  double result = init;
+  for (const auto &partial : partials) {
+    result = reduce(result, partial);
+  }
+  return result;
+}
+
 // --- Accessors ---
 
 SK_PI_SOLVER_TEMPLATE_DECL
@@ -461,6 +779,8 @@ std::unique_ptr<SK_PI_SOLVER_CLASS> SK_PI_SOLVER_CLASS::create_from_params(
       params.template get<double>("discount", 0.999),
       params.template get<double>("epsilon", 0.001),
       params.template get<std::size_t>("max_eval_sweeps", 0),
+      pi_evaluation_mode_from_string(params.template get<std::string>(
+          "evaluation_mode", std::string("gauss_seidel"))),
       CallbackFunctor([](const PISolver &, Domain &) { return false; }),
       params.template get<bool>("verbose", verbose));
 }
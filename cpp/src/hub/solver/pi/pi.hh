@@ -7,7 +7,10 @@
 #define SKDECIDE_PI_HH
 
 #include <functional>
+#include <limits>
 #include <memory>
+#include <stdexcept>
+#include <string>
 #include <unordered_set>
 #include <vector>
 #include <list>
@@ -20,6 +23,17 @@
 
 namespace skdecide {
 
+enum class PIEvaluationMode { GaussSeidel, BiCGSTAB };
+
+inline PIEvaluationMode pi_evaluation_mode_from_string(const std::string &s) {
+  if (s == "gauss_seidel")
+    return PIEvaluationMode::GaussSeidel;
+  if (s == "bicgstab")
+    return PIEvaluationMode::BiCGSTAB;
+  throw std::invalid_argument("Unknown PI evaluation mode: '" + s +
+                              "'. Use 'gauss_seidel' or 'bicgstab'.");
+}
+
 /**
  * @brief Policy Iteration solver for Markov Decision Processes.
  *
@@ -28,20 +42,40 @@ namespace skdecide {
  * 1. **State enumeration**: BFS from the initial state, expanding all
  *    reachable states via get_applicable_actions() and
  *    get_next_state_distribution(). All transition probabilities and rewards
- *    are cached in a graph. States where is_terminal() returns true are
+ *    are cached in a graph. Each BFS layer is expanded with one batch of
+ *    domain calls per kind of query (see utils/batched_domain_calls.hh).
+ *    States where is_terminal() returns true are
  *    treated as absorbing states whose value is set by the terminal_value
  *    functor (defaults to reward=0 for goal-like terminals; a large negative
- *    reward can be returned for dead-end-like terminals).
+ *    reward can be returned for dead-end-like terminals). The enumerated MDP
+ *    is then compiled once in compressed sparse row layout: the actions of
+ *    each state, the outcomes of each action and the state values are stored
+ *    in contiguous arrays that the next phases read instead of the graph.
  *
- * 2. **Policy evaluation**: For the current policy pi, iteratively computes
- *    V^pi(s) = R(s,pi(s)) + gamma * sum_s' P(s'|s,pi(s)) * V^pi(s') using
- *    Gauss-Seidel sweeps until the maximum residual drops below epsilon.
+ * 2. **Policy evaluation**: For the current policy pi, solves the linear
+ *    system (I - gamma * P_pi) V^pi = R_pi, i.e. V^pi(s) = R(s,pi(s)) +
+ *    gamma * sum_s' P(s'|s,pi(s)) * V^pi(s'), until the maximum Bellman
+ *    residual drops below epsilon. Depending on the evaluation mode
+ *    (PIEvaluationMode), the system is solved with:
+ *    - GaussSeidel (default): in-place sweeps over the states.
+ *    - BiCGSTAB: the BiCGSTAB Krylov solver with a Jacobi (diagonal)
+ *      preconditioner, whose sparse matrix-vector products and dot products
+ *      are computed over blocks of rows in parallel with ParallelExecution.
+ *      If the solver breaks down or does not converge (e.g. the system is
+ *      singular because the policy never reaches a terminal state with
+ *      gamma = 1), the evaluation falls back to Gauss-Seidel sweeps.
+ *    Both modes are warm-started from the values of the previous policy.
  *
  * 3. **Policy improvement**: For each state, greedily selects the action
  *    maximizing Q(s,a) = R(s,a) + gamma * sum_s' P(s'|s,a) * V(s'). If
  *    the policy changes, go back to step 2. Otherwise, the algorithm has
  *    converged to the optimal policy.
  *
+ * **Modified policy iteration**: A positive max_eval_sweeps bounds the
+ * number of Gauss-Seidel sweeps (or BiCGSTAB iterations) of each policy
+ * evaluation. The algorithm then only stops once the policy is stable and
+ * its last evaluation converged.
+ *
  * **Heuristic initialization (non-standard extension)**: Classical PI
  * initializes V(s) = 0 for all states. This implementation accepts an
  * optional heuristic functor h(s) returning a Value used to initialize
@@ -56,7 +90,8 @@ namespace skdecide {
  * @tparam Tdomain Type of the domain class
  * @tparam Texecution_policy Type of the execution policy (SequentialExecution
  * for sequential evaluation sweeps, or ParallelExecution for Jacobi-style
- * parallel evaluation and parallel action-transition generation)
+ * parallel evaluation, parallel policy improvement over the states and
+ * parallel action-transition generation)
  */
 template <typename Tdomain, typename Texecution_policy = SequentialExecution>
 class PISolver {
@@ -91,9 +126,12 @@ public:
    * @param discount Discount factor gamma in [0, 1]. Defaults to 0.999.
    * @param epsilon Maximum Bellman residual for policy evaluation convergence.
    *   Defaults to 0.001.
-   * @param max_eval_sweeps Maximum Gauss-Seidel sweeps per policy evaluation
-   *   phase. 0 means unlimited (exact evaluation). A positive value yields
-   *   modified policy iteration, useful when discount=1.0. Defaults to 0.
+   * @param max_eval_sweeps Maximum Gauss-Seidel sweeps (or BiCGSTAB
+   *   iterations) per policy evaluation phase. 0 means unlimited (exact
+   *   evaluation). A positive value yields modified policy iteration, useful
+   *   when discount=1.0. Defaults to 0.
+   * @param evaluation_mode Linear solver of the policy evaluation phase (see
+   *   PIEvaluationMode). Defaults to PIEvaluationMode::GaussSeidel.
    * @param callback Functor called at the end of each evaluate/improve
    *   iteration; return true to stop early. Defaults to never stop.
    * @param verbose Whether to log progress messages. Defaults to false.
@@ -105,6 +143,7 @@ public:
       const InitialPolicyFunctor &initial_policy = nullptr,
       double discount = 0.999, double epsilon = 0.001,
       std::size_t max_eval_sweeps = 0,
+      PIEvaluationMode evaluation_mode = PIEvaluationMode::GaussSeidel,
       const CallbackFunctor &callback = [](const PISolver &,
                                            Domain &) { return false; },
       bool verbose = false);
@@ -155,10 +194,14 @@ private:
   atomic_double _discount;
   atomic_double _epsilon;
   std::size_t _max_eval_sweeps;
+  PIEvaluationMode _evaluation_mode;
   CallbackFunctor _callback;
   bool _verbose;
   ExecutionPolicy _execution_policy;
 
+  static constexpr std::size_t IDX_UNDEF =
+      std::numeric_limits<std::size_t>::max();
+
   struct ActionNode;
 
   struct StateNode {
@@ -169,6 +212,7 @@ private:
     bool terminal;
     bool dead_end;
     bool policy_changed;
+    std::size_t idx; // row of the state in the compiled transitions
 
     StateNode(const State &s);
 
@@ -192,11 +236,36 @@ private:
   std::size_t _nb_iterations;
   std::chrono::time_point<std::chrono::high_resolution_clock> _start_time;
 
+  // Enumerated MDP in compressed sparse row layout. The non-terminal states
+  // are the first rows (in the order of _non_terminal_states), followed by
+  // the terminal and dead-end states whose values are fixed.
+  std::vector<atomic_double> _values;     // one per state
+  std::vector<std::size_t> _policy;       // one action per non-terminal state
+  std::vector<std::size_t> _first_action; // nb_non_terminal_states + 1
+  std::vector<ActionNode *> _action_nodes;
+  std::vector<double> _expected_rewards;   // one per action
+  std::vector<std::size_t> _first_outcome; // nb_actions + 1 offsets
+  std::vector<double> _probabilities;
+  std::vector<std::size_t> _successors;
+  std::vector<double> _residuals; // one per non-terminal state
+  std::vector<std::pair<std::size_t, std::size_t>> _row_blocks;
+
   void enumerate_reachable_states(const State &s);
-  void expand(StateNode &s);
+  std::vector<StateNode *> expand_layer(const std::vector<StateNode *> &layer);
+  void compile_transitions();
   void initialize_policy();
   bool evaluate_policy();
+  bool gauss_seidel_evaluation();
+  bool bicgstab_evaluation();
+  void policy_matrix_product(const std::vector<double> &x,
+                             std::vector<double> &y);
   bool improve_policy();
+  void copy_values();
+
+  template <typename Function> void for_each_row(const Function &f);
+
+  template <typename Function, typename Reduce>
+  double reduce_rows(const Function &f, const Reduce &reduce, double init);
 };
 
 } // namespace skdecide
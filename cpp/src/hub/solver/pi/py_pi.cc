@@ -17,13 +17,14 @@ void init_pypi(py::module &m) {
                     const std::function<py::object(const py::object &)> &,
                     const std::function<py::object(const py::object &,
                                                    const py::object &)> &,
-                    double, double, std::size_t, bool,
+                    double, double, std::size_t, const std::string &, bool,
                     const std::function<py::bool_(const py::object &)> &,
                     bool>(),
            py::arg("solver"), py::arg("domain"), py::arg("heuristic"),
            py::arg("terminal_value") = nullptr,
            py::arg("initial_policy") = nullptr, py::arg("discount") = 0.999,
            py::arg("epsilon") = 0.001, py::arg("max_eval_sweeps") = 0,
+           py::arg("evaluation_mode") = "gauss_seidel",
            py::arg("parallel") = false, py::arg("callback") = nullptr,
            py::arg("verbose") = false)
       .def("close", &skdecide::PyPISolver::close)
@@ -54,6 +54,7 @@ private:
             &initial_policy,
         double discount = 0.999, double epsilon = 0.001,
         std::size_t max_eval_sweeps = 0,
+        const std::string &evaluation_mode_str = "gauss_seidel",
         const std::function<py::bool_(const py::object &)> &callback = nullptr,
         bool verbose = false)
         : _heuristic(heuristic), _terminal_value(terminal_value),
@@ -127,6 +128,7 @@ private:
                         })
               : nullptr,
           discount, epsilon, max_eval_sweeps,
+          pi_evaluation_mode_from_string(evaluation_mode_str),
           [this](
               const skdecide::PISolver<PyPIDomain<Texecution>, Texecution> &s,
               PyPIDomain<Texecution> &d) -> bool {
@@ -297,14 +299,17 @@ public:
       const std::function<py::object(const py::object &, const py::object &)>
           &initial_policy = nullptr,
       double discount = 0.999, double epsilon = 0.001,
-      std::size_t max_eval_sweeps = 0, bool parallel = false,
+      std::size_t max_eval_sweeps = 0,
+      const std::string &evaluation_mode = "gauss_seidel",
+      bool parallel = false,
       const std::function<py::bool_(const py::object &)> &callback = nullptr,
       bool verbose = false) {
 
     TemplateInstantiator::select(ExecutionSelector(parallel),
                                  SolverInstantiator(_implementation))
         .instantiate(solver, domain, heuristic, terminal_value, initial_policy,
-                     discount, epsilon, max_eval_sweeps, callback, verbose);
+                     discount, epsilon, max_eval_sweeps, evaluation_mode,
+                     callback, verbose);
   }
 
   void close() { _implementation->close(); }
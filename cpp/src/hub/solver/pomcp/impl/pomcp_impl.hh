@@ -10,7 +10,7 @@
 #include <sstream>
 #include <stdexcept>
 
-#include <boost/range/irange.hpp>
+#include "utils/rollout_lanes.hh"
 
 namespace skdecide {
 
@@ -26,21 +26,35 @@ SK_POMCP_CLASS::POMCPSolver(Domain &domain, double exploration_constant,
                             std::size_t time_budget,
                             std::size_t num_particles_belief_update,
                             double ess_threshold_ratio,
-                            const CallbackFunctor &callback, bool verbose)
+                            const CallbackFunctor &callback, bool verbose,
+                            double virtual_loss)
     : _domain(domain), _exploration_constant(exploration_constant),
       _discount(discount), _num_simulations(num_simulations),
       _max_depth(max_depth), _epsilon(epsilon), _time_budget(time_budget),
       _num_particles_belief(num_particles_belief_update),
       _ess_threshold_ratio(ess_threshold_ratio), _callback(callback),
-      _verbose(verbose), _rng(std::random_device{}()) {
+      _verbose(verbose), _virtual_loss(virtual_loss),
+      _rng(std::random_device{}()),
+      _history_arena(domain.get_parallel_capacity()) {
   if (verbose) {
     Logger::check_level(logging::debug, "algorithm POMCP");
   }
+  std::size_t nb_lanes =
+      std::max<std::size_t>(std::size_t(1), _domain.get_parallel_capacity());
+  _lane_rngs.resize(nb_lanes);
+  _lane_states.resize(nb_lanes);
+  _particle_buffers.resize(nb_lanes);
 }
 
+SK_POMCP_TEMPLATE_DECL
+SK_POMCP_CLASS::~POMCPSolver() { clear(); }
+
 SK_POMCP_TEMPLATE_DECL
 void SK_POMCP_CLASS::clear() {
-  _current_tree.reset();
+  clear_particle_buffers();
+  destroy_tree(_current_tree);
+  _current_tree = nullptr;
+  _history_arena.release();
   _last_action.reset();
   _belief_particles.clear();
   _index_to_state.clear();
@@ -60,7 +74,7 @@ void SK_POMCP_CLASS::solve(
 
   _belief_particles = initial_distribution;
 
-  _current_tree = std::make_unique<HistoryNode>();
+  _current_tree = _history_arena.create(nullptr);
   _nb_tree_nodes = 1;
 
   std::vector<double> probs;
@@ -94,43 +108,38 @@ void SK_POMCP_CLASS::search(HistoryNode *root) {
     return;
   }
 
-  boost::integer_range<std::size_t> parallel_rollouts(
-      0, _domain.get_parallel_capacity());
+  for (std::size_t l = 0; l < _lane_rngs.size(); l++) {
+    _lane_rngs[l].seed(_rng() + l);
+  }
 
-  std::for_each(
-      ExecutionPolicy::policy, parallel_rollouts.begin(),
-      parallel_rollouts.end(), [this, root](const std::size_t &thread_id) {
-        std::mt19937 thread_rng;
-        _execution_policy.protect(
-            [this, &thread_rng, &thread_id]() {
-              thread_rng.seed(_rng() + thread_id);
-            },
-            _gen_mutex);
+  // The root's particles and the state index are only read by the lanes,
+  // which record their new particles and states in their own buffers
+  for_each_rollout_lane<ExecutionPolicy>(
+      _domain.get_parallel_capacity(),
+      [this, root](const std::size_t &thread_id) {
+        std::mt19937 &rng = lane_rng(&thread_id);
+        std::uniform_int_distribution<std::size_t> particle_dist(
+            0, root->particles.size() - 1);
 
         std::size_t sim_count = 0;
         do {
-          State s;
-          _execution_policy.protect(
-              [&root, &s, &thread_rng]() {
-                std::uniform_int_distribution<std::size_t> particle_dist(
-                    0, root->particles.size() - 1);
-                s = root->particles[particle_dist(thread_rng)];
-              },
-              root->mutex);
-
-          simulate(s, root, 0, &thread_id);
+          simulate(root->particles[particle_dist(rng)], root, 0, &thread_id);
           sim_count++;
         } while (!_callback(*this, _domain) &&
                  (_time_budget == 0 || elapsed_ms() < _time_budget) &&
                  sim_count < _num_simulations);
       });
 
+  merge_lane_states();
+
   double best_val = -std::numeric_limits<double>::infinity();
   bool found = false;
-  for (auto &[key, an] : root->action_children) {
-    if (an->visits_count > 0 && an->value > best_val) {
-      best_val = an->value;
-      _best_action_cache = an->action;
+  for (std::size_t i = 0; i < root->nb_action_children; i++) {
+    const ActionNode &an = root->action_children[i];
+    if (an.visits_count > 0 && an.value > best_val) {
+      best_val = an.value;
+      _best_action_cache = an.action;
+      _best_action_idx = i;
       found = true;
     }
   }
@@ -156,39 +165,46 @@ double SK_POMCP_CLASS::simulate(const State &s, HistoryNode *h,
   if (_domain.is_terminal(s, thread_id))
     return 0.0;
 
-  bool is_leaf = false;
-  _execution_policy.protect(
-      [&h, &is_leaf]() { is_leaf = h->action_children.empty(); }, h->mutex);
+  auto &particles = _particle_buffers[lane(thread_id)];
 
-  if (is_leaf) {
-    _execution_policy.protect(
-        [this, &h, &s, &thread_id]() {
-          if (h->action_children.empty()) {
-            expand(h, s, thread_id);
-          }
-        },
-        h->mutex);
+  // Lanes reaching the node while another one expands it also roll out
+  if (!h->expanded) {
+    bool expanding;
+    if constexpr (!is_concurrent_execution<ExecutionPolicy>::value) {
+      expanding = h->expanding;
+      h->expanding = true;
+    } else {
+      expanding = h->expanding.exchange(true);
+    }
+    if (!expanding) {
+      expand(h, s, thread_id);
+      h->expanded = true;
+    }
 
     double v = rollout(s, depth, thread_id);
 
-    _execution_policy.protect(
-        [&h, &s]() {
-          h->visits_count++;
-          h->particles.push_back(s);
-        },
-        h->mutex);
+    h->visits_count++;
+    particles.emplace_back(h, s);
 
     return v;
   }
 
-  ActionNode *an = nullptr;
-  _execution_policy.protect([this, &h, &an]() { an = select_action_ucb1(h); },
-                            h->mutex);
+  ActionNode *an = select_action_ucb1(h);
 
   if (!an) {
     return 0.0;
   }
 
+  bool apply_virtual_loss =
+      is_concurrent_execution<ExecutionPolicy>::value &&
+      _virtual_loss > 0.0;
+  if (apply_virtual_loss) {
+    // Reverted once the simulation is back-propagated
+    an->virtual_visits_count += 1;
+    atomic_add(an->virtual_loss, _virtual_loss);
+    h->virtual_visits_count += 1;
+  }
+
   SimulationResult result = simulate_transition(s, an->action, thread_id);
 
   double R;
@@ -196,37 +212,20 @@ double SK_POMCP_CLASS::simulate(const State &s, HistoryNode *h,
     R = result.reward;
   } else {
     std::size_t obs_hash = typename Observation::Hash()(result.observation);
-
-    HistoryNode *child = nullptr;
-    _execution_policy.protect(
-        [this, &an, &obs_hash, &child]() {
-          auto it = an->observation_children.find(obs_hash);
-          if (it == an->observation_children.end()) {
-            auto new_child = std::make_unique<HistoryNode>();
-            new_child->parent = an;
-            it =
-                an->observation_children.emplace(obs_hash, std::move(new_child))
-                    .first;
-            ++_nb_tree_nodes;
-          }
-          child = it->second.get();
-        },
-        an->mutex);
-
+    HistoryNode *child = get_observation_child(an, obs_hash, thread_id);
     R = result.reward +
         _discount * simulate(result.next_state, child, depth + 1, thread_id);
   }
 
-  _execution_policy.protect(
-      [&h, &s]() {
-        h->particles.push_back(s);
-        h->visits_count++;
-      },
-      h->mutex);
+  particles.emplace_back(h, s);
+  h->visits_count++;
+  update_running_mean(an->visits_count, an->value, R);
 
-  an->visits_count++;
-  double n = static_cast<double>(an->visits_count);
-  an->value = (double)an->value + (R - (double)an->value) / n;
+  if (apply_virtual_loss) {
+    an->virtual_visits_count -= 1;
+    atomic_add(an->virtual_loss, -_virtual_loss);
+    h->virtual_visits_count -= 1;
+  }
 
   return R;
 }
@@ -251,15 +250,10 @@ double SK_POMCP_CLASS::rollout(const State &s, std::size_t depth,
   if (action_vec.empty())
     return 0.0;
 
-  std::size_t action_idx;
-  _execution_policy.protect(
-      [this, &action_idx, &action_vec]() {
-        std::uniform_int_distribution<std::size_t> action_dist(
-            0, action_vec.size() - 1);
-        action_idx = action_dist(_rng);
-      },
-      _gen_mutex);
-  const Action &action = action_vec[action_idx];
+  std::mt19937 &rng = lane_rng(thread_id);
+  std::uniform_int_distribution<std::size_t> action_dist(
+      0, action_vec.size() - 1);
+  const Action &action = action_vec[action_dist(rng)];
 
   auto next_dist =
       _domain.get_next_state_distribution(s, action, thread_id).get_values();
@@ -273,15 +267,9 @@ double SK_POMCP_CLASS::rollout(const State &s, std::size_t depth,
   if (t_states.empty())
     return 0.0;
 
-  std::size_t ns_idx;
-  _execution_policy.protect(
-      [this, &ns_idx, &t_probs]() {
-        std::discrete_distribution<std::size_t> t_dist(t_probs.begin(),
-                                                       t_probs.end());
-        ns_idx = t_dist(_rng);
-      },
-      _gen_mutex);
-  const State &next_state = t_states[ns_idx];
+  std::discrete_distribution<std::size_t> t_dist(t_probs.begin(),
+                                                 t_probs.end());
+  const State &next_state = t_states[t_dist(rng)];
 
   double reward =
       _domain.get_transition_value(s, action, next_state, thread_id).reward();
@@ -300,18 +288,27 @@ typename SK_POMCP_CLASS::ActionNode *
 SK_POMCP_CLASS::select_action_ucb1(HistoryNode *h) {
   ActionNode *best = nullptr;
   double best_score = -std::numeric_limits<double>::infinity();
-  double log_n = std::log(static_cast<double>(h->visits_count));
-
-  for (auto &[key, an] : h->action_children) {
-    if (an->visits_count == 0) {
-      return an.get();
+  // Concurrent lanes may back-propagate an action before its history node
+  double log_n = std::log(static_cast<double>(std::max<std::size_t>(
+      h->visits_count + h->virtual_visits_count, 1)));
+
+  for (std::size_t i = 0; i < h->nb_action_children; i++) {
+    ActionNode &an = h->action_children[i];
+    std::size_t visits = an.visits_count;
+    std::size_t virtual_visits = an.virtual_visits_count;
+    if (visits + virtual_visits == 0) {
+      return &an;
+    }
+    double value = an.value;
+    if (virtual_visits > 0) {
+      value = ((visits * value) - an.virtual_loss) /
+              static_cast<double>(visits + virtual_visits);
     }
-    double score = an->value +
-                   _exploration_constant *
-                       std::sqrt(log_n / static_cast<double>(an->visits_count));
+    double n = static_cast<double>(visits + virtual_visits);
+    double score = value + _exploration_constant * std::sqrt(log_n / n);
     if (score > best_score) {
       best_score = score;
-      best = an.get();
+      best = &an;
     }
   }
   return best;
@@ -323,10 +320,76 @@ SK_POMCP_TEMPLATE_DECL
 void SK_POMCP_CLASS::expand(HistoryNode *h, const State &s,
                             const std::size_t *thread_id) {
   auto actions = _domain.get_applicable_actions(s, thread_id);
+  std::vector<Action> action_vec;
   for (auto a : actions.get_elements()) {
-    auto an = std::make_unique<ActionNode>(a, h);
-    h->action_children.emplace(a, std::move(an));
+    action_vec.push_back(a);
+  }
+  h->action_children = std::make_unique<ActionNode[]>(action_vec.size());
+  for (std::size_t i = 0; i < action_vec.size(); i++) {
+    h->action_children[i].action = action_vec[i];
+    h->action_children[i].parent = h;
   }
+  h->nb_action_children = action_vec.size();
+}
+
+// --- Observation children: lock-free lists of history nodes ---
+
+SK_POMCP_TEMPLATE_DECL
+typename SK_POMCP_CLASS::HistoryNode *
+SK_POMCP_CLASS::get_observation_child(ActionNode *an, std::size_t obs_hash,
+                                      const std::size_t *thread_id) {
+  auto &head = an->observation_children[obs_hash % nb_observation_buckets];
+  HistoryNode *first = head;
+  for (HistoryNode *c = first; c != nullptr; c = c->next_sibling) {
+    if (c->observation_hash == obs_hash) {
+      return c;
+    }
+  }
+
+  HistoryNode *child = _history_arena.create(thread_id);
+  child->parent = an;
+  child->observation_hash = obs_hash;
+  if constexpr (!is_concurrent_execution<ExecutionPolicy>::value) {
+    child->next_sibling = first;
+    head = child;
+  } else {
+    // Children are only pushed in front of the list: when another lane pushed
+    // some meanwhile, only these ones need to be checked again
+    child->next_sibling = first;
+    while (!head.compare_exchange_weak(child->next_sibling, child)) {
+      for (HistoryNode *c = child->next_sibling; c != first;
+           c = c->next_sibling) {
+        if (c->observation_hash == obs_hash) {
+          _history_arena.destroy(child);
+          return c;
+        }
+      }
+      first = child->next_sibling;
+    }
+  }
+  ++_nb_tree_nodes;
+  return child;
+}
+
+// Destroys the tree rooted at h but its subtree kept, and returns the number
+// of destroyed history nodes
+SK_POMCP_TEMPLATE_DECL
+std::size_t SK_POMCP_CLASS::destroy_tree(HistoryNode *h, HistoryNode *kept) {
+  if (h == nullptr || h == kept) {
+    return 0;
+  }
+  std::size_t nb = 1;
+  for (std::size_t i = 0; i < h->nb_action_children; i++) {
+    for (HistoryNode *c : h->action_children[i].observation_children) {
+      while (c != nullptr) {
+        HistoryNode *next = c->next_sibling;
+        nb += destroy_tree(c, kept);
+        c = next;
+      }
+    }
+  }
+  _history_arena.destroy(h);
+  return nb;
 }
 
 // --- Simulate transition: call domain methods ---
@@ -349,16 +412,11 @@ SK_POMCP_CLASS::simulate_transition(const State &s, const Action &a,
     return {s, Observation(), 0.0, true};
   }
 
-  std::size_t ns_idx;
-  _execution_policy.protect(
-      [this, &ns_idx, &t_probs]() {
-        std::discrete_distribution<std::size_t> t_dist(t_probs.begin(),
-                                                       t_probs.end());
-        ns_idx = t_dist(_rng);
-      },
-      _gen_mutex);
-  State next_state = t_states[ns_idx];
-  get_state_index(next_state);
+  std::mt19937 &rng = lane_rng(thread_id);
+  std::discrete_distribution<std::size_t> t_dist(t_probs.begin(),
+                                                 t_probs.end());
+  State next_state = t_states[t_dist(rng)];
+  record_state(next_state, thread_id);
 
   double reward =
       _domain.get_transition_value(s, a, next_state, thread_id).reward();
@@ -376,15 +434,9 @@ SK_POMCP_CLASS::simulate_transition(const State &s, const Action &a,
 
   Observation obs;
   if (!o_obs.empty()) {
-    std::size_t o_idx;
-    _execution_policy.protect(
-        [this, &o_idx, &o_probs]() {
-          std::discrete_distribution<std::size_t> o_dist(o_probs.begin(),
-                                                         o_probs.end());
-          o_idx = o_dist(_rng);
-        },
-        _gen_mutex);
-    obs = o_obs[o_idx];
+    std::discrete_distribution<std::size_t> o_dist(o_probs.begin(),
+                                                   o_probs.end());
+    obs = o_obs[o_dist(rng)];
   }
 
   return {next_state, obs, reward, terminal};
@@ -507,19 +559,20 @@ void SK_POMCP_CLASS::plan_from_belief(const Belief &b) {
     throw std::runtime_error("POMCP: empty belief, cannot plan");
   }
 
-  auto root = std::make_unique<HistoryNode>();
+  // The previous tree is discarded with the particles buffered for it
+  clear_particle_buffers();
+  destroy_tree(_current_tree);
+  _current_tree = _history_arena.create(nullptr);
+  _nb_tree_nodes = 1;
 
   std::discrete_distribution<std::size_t> belief_dist(probs.begin(),
                                                       probs.end());
   for (std::size_t i = 0; i < _num_particles_belief; ++i) {
     std::size_t idx = belief_dist(_rng);
-    root->particles.push_back(states[idx]);
+    _current_tree->particles.push_back(states[idx]);
   }
 
-  _current_tree = std::move(root);
-  _nb_tree_nodes = 1;
-
-  search(_current_tree.get());
+  search(_current_tree);
 }
 
 // --- Observation-based interface ---
@@ -528,22 +581,33 @@ SK_POMCP_TEMPLATE_DECL
 const typename SK_POMCP_CLASS::Action &
 SK_POMCP_CLASS::get_best_action(const Observation &obs) {
   if (_last_action && _current_tree) {
-    auto action_it = _current_tree->action_children.find(*_last_action);
-    if (action_it != _current_tree->action_children.end()) {
+    // The particles of the kept subtree were buffered by the last search
+    merge_particle_buffers();
+    HistoryNode *subtree = nullptr;
+    if (_last_action_idx < _current_tree->nb_action_children) {
       std::size_t obs_hash = typename Observation::Hash()(obs);
-      auto obs_it = action_it->second->observation_children.find(obs_hash);
-      if (obs_it != action_it->second->observation_children.end()) {
-        auto subtree = std::move(obs_it->second);
-        subtree->parent = nullptr;
-        _current_tree = std::move(subtree);
-      } else {
-        _current_tree = std::make_unique<HistoryNode>();
-        _nb_tree_nodes = 1;
+      ActionNode &an = _current_tree->action_children[_last_action_idx];
+      for (HistoryNode *c =
+               an.observation_children[obs_hash % nb_observation_buckets];
+           c != nullptr; c = c->next_sibling) {
+        if (c->observation_hash == obs_hash) {
+          subtree = c;
+          break;
+        }
       }
+    }
+    _nb_tree_nodes -= destroy_tree(_current_tree, subtree);
+    if (subtree != nullptr) {
+      subtree->parent = nullptr;
+      subtree->next_sibling = nullptr;
+      _current_tree = subtree;
     } else {
-      _current_tree = std::make_unique<HistoryNode>();
+      _current_tree = _history_arena.create(nullptr);
       _nb_tree_nodes = 1;
     }
+  } else if (!_current_tree) {
+    _current_tree = _history_arena.create(nullptr);
+    _nb_tree_nodes = 1;
   }
 
   update_belief_particles(obs);
@@ -561,9 +625,10 @@ SK_POMCP_CLASS::get_best_action(const Observation &obs) {
     }
   }
 
-  search(_current_tree.get());
+  search(_current_tree);
 
   _last_action = std::make_unique<Action>(_best_action_cache);
+  _last_action_idx = _best_action_idx;
   return _best_action_cache;
 }
 
@@ -584,7 +649,9 @@ bool SK_POMCP_CLASS::is_solution_defined_for(const Observation &obs) {
 SK_POMCP_TEMPLATE_DECL
 void SK_POMCP_CLASS::reset_belief() {
   _last_action.reset();
-  _current_tree.reset();
+  clear_particle_buffers();
+  destroy_tree(_current_tree);
+  _current_tree = nullptr;
 }
 
 // --- Belief-based interface ---
@@ -645,9 +712,63 @@ SK_POMCP_CLASS::get_index_to_state() const {
   return _index_to_state;
 }
 
+// --- Per-lane buffers ---
+
+SK_POMCP_TEMPLATE_DECL
+std::size_t SK_POMCP_CLASS::lane(const std::size_t *thread_id) const {
+  return (thread_id != nullptr) ? (*thread_id) : 0;
+}
+
+SK_POMCP_TEMPLATE_DECL
+std::mt19937 &SK_POMCP_CLASS::lane_rng(const std::size_t *thread_id) {
+  return _lane_rngs[lane(thread_id)];
+}
+
+// Records a state met by a simulation, _index_to_state being read-only during
+// the search
+SK_POMCP_TEMPLATE_DECL
+void SK_POMCP_CLASS::record_state(const State &s,
+                                  const std::size_t *thread_id) {
+  std::size_t h = typename State::Hash()(s);
+  if (_index_to_state.find(h) == _index_to_state.end()) {
+    _lane_states[lane(thread_id)].emplace(h, s);
+  }
+}
+
+SK_POMCP_TEMPLATE_DECL
+void SK_POMCP_CLASS::merge_lane_states() {
+  for (auto &states : _lane_states) {
+    _index_to_state.insert(states.begin(), states.end());
+    states.clear();
+  }
+}
+
+// Appends the buffered particles to their history nodes, in the order of the
+// lanes then of the simulations
+SK_POMCP_TEMPLATE_DECL
+void SK_POMCP_CLASS::merge_particle_buffers() {
+  for (auto &particles : _particle_buffers) {
+    for (auto &p : particles) {
+      p.first->particles.push_back(std::move(p.second));
+    }
+    particles.clear();
+  }
+}
+
+SK_POMCP_TEMPLATE_DECL
+void SK_POMCP_CLASS::clear_particle_buffers() {
+  for (auto &particles : _particle_buffers) {
+    particles.clear();
+  }
+}
+
+// Elapsed time of the current search, whose start time is only written
+// before the lanes are launched, hence read by them without locking
 SK_POMCP_TEMPLATE_DECL
 std::size_t SK_POMCP_CLASS::elapsed_ms() const {
-  return const_cast<POMCPSolver *>(this)->get_solving_time();
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::high_resolution_clock::now() - _start_time)
+      .count();
 }
 
 } // namespace skdecide
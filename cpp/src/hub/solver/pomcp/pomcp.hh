@@ -5,18 +5,20 @@
 #ifndef SKDECIDE_POMCP_HH
 #define SKDECIDE_POMCP_HH
 
+#include <array>
 #include <chrono>
 #include <cmath>
 #include <functional>
 #include <limits>
 #include <memory>
 #include <random>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
-#include "utils/associative_container_deducer.hh"
 #include "utils/execution.hh"
 #include "utils/logging.hh"
+#include "utils/node_arena.hh"
 
 namespace skdecide {
 
@@ -31,6 +33,18 @@ namespace skdecide {
  * particles from the current belief, runs Monte Carlo simulations
  * through the history tree, and selects actions via UCB1.
  *
+ * With parallel execution policies, the rollout lanes simulate concurrently
+ * in the same history tree without locking its nodes: visit counts and action
+ * values are atomics updated with lock-free running means, a history node's
+ * actions are created once by the lane claiming its expansion, and the
+ * observation children of an action are lock-free lists in which new children
+ * are inserted with a compare-and-swap. Actions of in-flight simulations
+ * receive an optional virtual loss which diverts the other lanes towards
+ * other branches. Each lane has its own random generator, allocates history
+ * nodes from its own lane of the node arena, and appends the particles of the
+ * nodes it visits to its own buffer: buffered particles are merged into
+ * their nodes only when the tree is reused from one of its nodes.
+ *
  * @tparam Tdomain Type of the domain class (must be PartiallyObservable)
  * @tparam Texecution_policy Type of the execution policy
  */
@@ -46,35 +60,58 @@ public:
 
   typedef typename ExecutionPolicy::template atomic<std::size_t> atomic_size_t;
   typedef typename ExecutionPolicy::template atomic<double> atomic_double;
+  typedef typename ExecutionPolicy::template atomic<bool> atomic_bool;
+
+  struct HistoryNode;
+  typedef typename ExecutionPolicy::template atomic<HistoryNode *>
+      atomic_history_node_ptr;
 
   typedef std::unordered_map<std::size_t, double> Belief;
 
   typedef std::function<bool(const POMCPSolver &, Domain &)> CallbackFunctor;
 
+  // Observation children of an action node are spread over this number of
+  // lock-free lists according to the observation hashes
+  static constexpr std::size_t nb_observation_buckets = 16;
+
   struct ActionNode;
 
   struct HistoryNode {
     atomic_size_t visits_count = 0;
+    atomic_size_t virtual_visits_count = 0; // pending simulations of the lanes
+    // Particles merged from the lanes' buffers (see merge_particle_buffers())
     std::vector<State> particles;
-    typename MapTypeDeducer<Action, std::unique_ptr<ActionNode>>::Map
-        action_children;
+    // Set by the lane claiming the node's expansion, and by the same lane
+    // once the action children can be read
+    atomic_bool expanding = false;
+    atomic_bool expanded = false;
+    std::unique_ptr<ActionNode[]> action_children;
+    std::size_t nb_action_children = 0;
     ActionNode *parent = nullptr;
-    mutable typename ExecutionPolicy::Mutex mutex;
+    // Observation of the node and next sibling in its parent's list
+    std::size_t observation_hash = 0;
+    HistoryNode *next_sibling = nullptr;
   };
 
   struct ActionNode {
     Action action;
     atomic_size_t visits_count = 0;
     atomic_double value = 0.0;
-    std::unordered_map<std::size_t, std::unique_ptr<HistoryNode>>
+    atomic_size_t virtual_visits_count = 0; // pending simulations of the lanes
+    atomic_double virtual_loss = 0.0;       // sum of their virtual losses
+    std::array<atomic_history_node_ptr, nb_observation_buckets>
         observation_children;
     HistoryNode *parent = nullptr;
-    mutable typename ExecutionPolicy::Mutex mutex;
 
-    ActionNode() {}
-    ActionNode(const Action &a, HistoryNode *p) : action(a), parent(p) {}
+    ActionNode() {
+      for (auto &c : observation_children) {
+        c = nullptr;
+      }
+    }
   };
 
+  typedef NodeArena<HistoryNode, ExecutionPolicy> HistoryArena;
+
   /**
    * @brief Construct a new POMCPSolver.
    *
@@ -98,6 +135,11 @@ public:
    * @param callback Functor called at each simulation iteration. Returns
    *   true to stop planning. Defaults to never stop.
    * @param verbose Whether to log verbose messages. Defaults to false.
+   * @param virtual_loss Virtual loss applied to the actions of the
+   *   simulations in flight with parallel execution policies, which diverts
+   *   concurrent lanes towards other branches of the tree until the
+   *   simulations are back-propagated (0 deactivates virtual losses).
+   *   Defaults to 0.
    */
   POMCPSolver(
       Domain &domain, double exploration_constant = 1.0 / std::sqrt(2.0),
@@ -108,7 +150,9 @@ public:
       double ess_threshold_ratio = 2.0,
       const CallbackFunctor &callback = [](const POMCPSolver &,
                                            Domain &) { return false; },
-      bool verbose = false);
+      bool verbose = false, double virtual_loss = 0.0);
+
+  ~POMCPSolver();
 
   void clear();
 
@@ -137,6 +181,9 @@ private:
                  const std::size_t *thread_id);
   ActionNode *select_action_ucb1(HistoryNode *h);
   void expand(HistoryNode *h, const State &s, const std::size_t *thread_id);
+  HistoryNode *get_observation_child(ActionNode *an, std::size_t obs_hash,
+                                     const std::size_t *thread_id);
+  std::size_t destroy_tree(HistoryNode *h, HistoryNode *kept = nullptr);
 
   struct SimulationResult {
     State next_state;
@@ -147,6 +194,13 @@ private:
   SimulationResult simulate_transition(const State &s, const Action &a,
                                        const std::size_t *thread_id);
 
+  std::size_t lane(const std::size_t *thread_id) const;
+  std::mt19937 &lane_rng(const std::size_t *thread_id);
+  void record_state(const State &s, const std::size_t *thread_id);
+  void merge_lane_states();
+  void merge_particle_buffers();
+  void clear_particle_buffers();
+
   void update_belief_particles(const Observation &obs);
   void plan_from_belief(const Belief &b);
   Belief particles_to_belief() const;
@@ -164,9 +218,9 @@ private:
   double _ess_threshold_ratio;
   CallbackFunctor _callback;
   bool _verbose;
+  double _virtual_loss;
 
   ExecutionPolicy _execution_policy;
-  typename ExecutionPolicy::Mutex _gen_mutex;
   typename ExecutionPolicy::Mutex _state_index_mutex;
   typename ExecutionPolicy::Mutex _time_mutex;
 
@@ -174,12 +228,22 @@ private:
 
   std::mt19937 _rng;
 
+  // One entry per rollout lane: random generator, states met by the lane's
+  // simulations which are not yet in _index_to_state (merged after the
+  // search), and particles of the history nodes visited by the lane
+  std::vector<std::mt19937> _lane_rngs;
+  std::vector<std::unordered_map<std::size_t, State>> _lane_states;
+  std::vector<std::vector<std::pair<HistoryNode *, State>>> _particle_buffers;
+
   std::vector<std::pair<State, double>> _belief_particles;
   std::unique_ptr<Action> _last_action;
+  std::size_t _last_action_idx = 0; // among the root's action children
   bool _has_solution = false;
 
-  std::unique_ptr<HistoryNode> _current_tree;
+  HistoryArena _history_arena; // must outlive the tree
+  HistoryNode *_current_tree = nullptr;
   Action _best_action_cache;
+  std::size_t _best_action_idx = 0;
   double _best_value_cache = 0.0;
   atomic_size_t _nb_tree_nodes = 0;
   std::chrono::time_point<std::chrono::high_resolution_clock> _start_time;
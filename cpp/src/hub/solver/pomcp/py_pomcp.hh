@@ -55,7 +55,7 @@ private:
         std::size_t max_depth = 100, double epsilon = 0.001,
         std::size_t time_budget = 0,
         std::size_t num_particles_belief_update = 500,
-        double ess_threshold_ratio = 2.0,
+        double ess_threshold_ratio = 2.0, double virtual_loss = 0.0,
         const std::function<py::bool_(const py::object &)> &callback = nullptr,
         bool verbose = false)
         : _callback(callback) {
@@ -87,7 +87,7 @@ private:
                 }
                 return false;
               },
-              verbose);
+              verbose, virtual_loss);
 
       _stdout_redirect = std::make_unique<py::scoped_ostream_redirect>(
           std::cout, py::module::import("sys").attr("stdout"));
@@ -258,15 +258,16 @@ public:
       std::size_t max_depth = 100, double epsilon = 0.001,
       std::size_t time_budget = 0,
       std::size_t num_particles_belief_update = 500,
-      double ess_threshold_ratio = 2.0, bool parallel = false,
+      double ess_threshold_ratio = 2.0, double virtual_loss = 0.0,
+      bool parallel = false,
       const std::function<py::bool_(const py::object &)> &callback = nullptr,
       bool verbose = false) {
     TemplateInstantiator::select(ExecutionSelector(parallel),
                                  SolverInstantiator(_implementation))
         .instantiate(solver, domain, exploration_constant, discount,
                      num_simulations, max_depth, epsilon, time_budget,
-                     num_particles_belief_update, ess_threshold_ratio, callback,
-                     verbose);
+                     num_particles_belief_update, ess_threshold_ratio,
+                     virtual_loss, callback, verbose);
   }
 
   void close() { _implementation->close(); }
@@ -5,11 +5,11 @@
 #ifndef SKDECIDE_RIW_IMPL_HH
 #define SKDECIDE_RIW_IMPL_HH
 
-#include <boost/range/irange.hpp>
 #include <iostream>
 
 #include "utils/string_converter.hh"
 #include "utils/execution.hh"
+#include "utils/rollout_lanes.hh"
 #include "utils/logging.hh"
 
 namespace skdecide {
@@ -548,7 +548,7 @@ template <typename TTexecution_policy>
 struct SK_RIW_SOLVER_CLASS::UpdateFrontierImplementation<
     TTexecution_policy,
     typename std::enable_if<
-        std::is_same<TTexecution_policy, ParallelExecution>::value>::type> {
+        !std::is_same<TTexecution_policy, SequentialExecution>::value>::type> {
   static void update_frontier(TTexecution_policy &execution_policy,
                               const double &discount,
                               std::unordered_set<Node *> &new_frontier,
@@ -638,7 +638,7 @@ SK_RIW_SOLVER_CLASS::WidthSolver::WidthSolver(
     RolloutPolicy &rollout_policy, ExecutionPolicy &execution_policy,
     std::mt19937 &gen, typename ExecutionPolicy::Mutex &gen_mutex,
     typename ExecutionPolicy::Mutex &time_mutex,
-    typename ExecutionPolicy::Mutex &residuals_protect,
+    typename ExecutionPolicy::SpinMutex &residuals_protect,
     const CallbackFunctor &callback, const atomic_bool &verbose)
     : _parent_solver(parent_solver), _domain(domain),
       _state_features(state_features), _time_budget(time_budget),
@@ -688,14 +688,11 @@ bool SK_RIW_SOLVER_CLASS::WidthSolver::solve(const State &s,
     novelty(feature_tuples, root_node,
             true); // initialize feature_tuples with the root node's bits
 
-    boost::integer_range<std::size_t> parallel_rollouts(
-        0, _domain.get_parallel_capacity());
     _residual_moving_average = 0.0;
     _residuals.clear();
 
-    std::for_each(
-        ExecutionPolicy::policy, parallel_rollouts.begin(),
-        parallel_rollouts.end(),
+    for_each_rollout_lane<ExecutionPolicy>(
+        _domain.get_parallel_capacity(),
         [this, &root_node, &feature_tuples, &nb_rollouts, &states_pruned,
          &reached_end_of_trajectory_once](const std::size_t &thread_id) {
           // Start rollouts
@@ -1012,15 +1009,12 @@ bool SK_RIW_SOLVER_CLASS::WidthSolver::fill_child_node(
         },
         node->mutex);
 
-    _execution_policy.protect(
-        [this, &node_child, &thread_id, &new_node, &outcome]() {
-          auto i = _graph.emplace(Node(outcome->observation(), _domain,
-                                       _state_features, thread_id));
-          new_node = i.second;
-          node_child =
-              &const_cast<Node &>(*(i.first)); // we won't change the real key
-                                               // (Node::state) so we are safe
-        });
+    auto i = _graph.emplace(
+        Node(outcome->observation(), _domain, _state_features, thread_id));
+    new_node = i.second;
+    node_child = &const_cast<Node &>(*(i.first)); // we won't change the real
+                                                  // key (Node::state) so we
+                                                  // are safe
     Node &next_node = *node_child;
     double reward = outcome->transition_value().reward();
     _execution_policy.protect(
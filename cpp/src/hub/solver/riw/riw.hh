@@ -18,7 +18,9 @@
 #include <boost/container_hash/hash.hpp>
 
 #include "utils/associative_container_deducer.hh"
+#include "utils/concurrent_set.hh"
 #include "utils/execution.hh"
+#include "utils/node_arena.hh"
 
 namespace skdecide {
 
@@ -333,7 +335,7 @@ private:
   std::unique_ptr<std::mt19937> _gen;
   typename ExecutionPolicy::Mutex _gen_mutex;
   typename ExecutionPolicy::Mutex _time_mutex;
-  typename ExecutionPolicy::Mutex _residuals_protect;
+  typename ExecutionPolicy::SpinMutex _residuals_protect;
 
   atomic_double _residual_moving_average;
   std::list<double> _residuals;
@@ -364,7 +366,9 @@ private:
     };
   };
 
-  typedef typename SetTypeDeducer<Node, HashingPolicy>::Set Graph;
+  typedef typename ConcurrentSetTypeDeducer<
+      Node, HashingPolicy, ExecutionPolicy, NodeArenaAllocator<Node>>::Set
+      Graph;
   Graph _graph;
 
   typedef std::vector<
@@ -403,7 +407,7 @@ private:
         RolloutPolicy &rollout_policy, ExecutionPolicy &execution_policy,
         std::mt19937 &gen, typename ExecutionPolicy::Mutex &gen_mutex,
         typename ExecutionPolicy::Mutex &time_mutex,
-        typename ExecutionPolicy::Mutex &residuals_protect,
+        typename ExecutionPolicy::SpinMutex &residuals_protect,
         const CallbackFunctor &callback, const atomic_bool &verbose);
 
     // solves from state s
@@ -434,7 +438,7 @@ private:
     std::mt19937 &_gen;
     typename ExecutionPolicy::Mutex &_gen_mutex;
     typename ExecutionPolicy::Mutex &_time_mutex;
-    typename ExecutionPolicy::Mutex &_residuals_protect;
+    typename ExecutionPolicy::SpinMutex &_residuals_protect;
     const CallbackFunctor &_callback;
     const atomic_bool &_verbose;
 
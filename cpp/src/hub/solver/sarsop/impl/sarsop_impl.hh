@@ -14,9 +14,12 @@
 #include <numeric>
 #include <queue>
 #include <stdexcept>
+#include <thread>
+#include <type_traits>
 #include <unordered_set>
 
 #include "utils/logging.hh"
+#include "utils/rollout_lanes.hh"
 #include "utils/string_converter.hh"
 
 namespace skdecide {
@@ -35,7 +38,8 @@ SK_SARSOP_CLASS::SARSOPSolver(
     std::size_t max_vi_iterations, double vi_convergence_factor,
     std::size_t max_sample_depth, double prob_epsilon,
     double ub_improvement_epsilon, std::size_t pruning_interval,
-    std::size_t logging_interval, const CallbackFunctor &callback, bool verbose)
+    std::size_t logging_interval, const CallbackFunctor &callback, bool verbose,
+    const std::string &model_cache_path, std::size_t nb_sampling_threads)
     : _domain(domain), _epsilon(epsilon), _discount(discount),
       _time_budget(time_budget), _max_beliefs(max_beliefs),
       _pruning_delta(pruning_delta), _max_vi_iterations(max_vi_iterations),
@@ -43,11 +47,20 @@ SK_SARSOP_CLASS::SARSOPSolver(
       _max_sample_depth(max_sample_depth), _prob_epsilon(prob_epsilon),
       _ub_improvement_epsilon(ub_improvement_epsilon),
       _pruning_interval(pruning_interval), _logging_interval(logging_interval),
-      _callback(callback), _verbose(verbose), _next_alpha_id(0), _nb_beliefs(0),
+      _callback(callback), _verbose(verbose),
+      _model_cache_path(model_cache_path), _nb_sampling_threads(1),
+      _nb_beliefs(0), _node_mutexes(nb_node_mutexes), _nb_iterations(0),
+      _stop_trials(false), _pruning_requested(false), _stop_pruning(false),
       _has_solution(false) {
   if (verbose) {
     Logger::check_level(logging::debug, "algorithm SARSOP");
   }
+  if constexpr (is_concurrent_execution<ExecutionPolicy>::value) {
+    _nb_sampling_threads =
+        (nb_sampling_threads > 0)
+            ? nb_sampling_threads
+            : std::max<std::size_t>(1, std::thread::hardware_concurrency());
+  }
 }
 
 SK_SARSOP_TEMPLATE_DECL
@@ -56,18 +69,17 @@ void SK_SARSOP_CLASS::clear() {
   _state_hash_to_idx.clear();
   _index_to_state.clear();
   _transitions.clear();
-  _obs_prob.clear();
-  _obs_objects.clear();
   _rewards.clear();
   _actions.clear();
   _action_hash_to_idx.clear();
   _action_obs_hashes.clear();
+  _tensors.clear();
   _alpha_vectors.clear();
-  _next_alpha_id = 0;
   _mdp_values.clear();
   _ub_points.clear();
   _root.reset();
   _nb_beliefs = 0;
+  _nb_iterations = 0;
   _current_belief.clear();
   _last_action.reset();
   _has_solution = false;
@@ -173,28 +185,59 @@ void SK_SARSOP_CLASS::enumerate_states(const Belief &b0) {
 
 SK_SARSOP_TEMPLATE_DECL
 void SK_SARSOP_CLASS::pre_cache_model() {
-  std::size_t ns = _states.size();
-  std::size_t na = _actions.size();
+  pomdp_model_cache::Observations observations;
+  std::vector<std::size_t> state_ids;
+  std::vector<std::size_t> action_ids;
+  if (!_model_cache_path.empty()) {
+    state_ids = pomdp_model_cache::stable_ids(_states);
+    action_ids = pomdp_model_cache::stable_ids(_actions);
+  }
 
-  _transitions.resize(ns);
-  _obs_prob.resize(ns);
-  _rewards.resize(ns, std::vector<double>(na, 0.0));
-  _action_obs_hashes.resize(na);
+  if (!_model_cache_path.empty() &&
+      pomdp_model_cache::load(_model_cache_path, "reward", state_ids,
+                              action_ids, _transitions, _rewards, observations,
+                              _action_obs_hashes)) {
+    if (_verbose)
+      Logger::debug("SARSOP: loaded model from " + _model_cache_path);
+  } else {
+    query_model(observations);
+    if (!_model_cache_path.empty()) {
+      bool saved = pomdp_model_cache::save(
+          _model_cache_path, "reward", state_ids, action_ids, _transitions,
+          _rewards, observations, _action_obs_hashes);
+      if (saved && _verbose)
+        Logger::debug("SARSOP: saved model to " + _model_cache_path);
+    }
+  }
 
-  // Track which observations we've seen per action
-  std::vector<std::unordered_set<std::size_t>> action_obs_sets(na);
+  // Compile T x O matrices for the belief updates and the backups
+  _tensors.template build<ExecutionPolicy>(_transitions, observations,
+                                           _action_obs_hashes);
 
-  for (std::size_t i = 0; i < ns; ++i) {
-    _transitions[i].resize(na);
-    _obs_prob[i].resize(na);
-  }
+  if (_verbose)
+    Logger::debug("SARSOP: model pre-cached with " +
+                  std::to_string(_tensors.nb_entries()) +
+                  " transition-observation entries");
+}
+
+SK_SARSOP_TEMPLATE_DECL
+void SK_SARSOP_CLASS::query_model(
+    pomdp_model_cache::Observations &observations) {
+  std::size_t ns = _states.size();
+  std::size_t na = _actions.size();
+
+  _transitions.assign(
+      ns, std::vector<std::vector<std::pair<double, std::size_t>>>(na));
+  _rewards.assign(ns, std::vector<double>(na, 0.0));
+  observations.assign(
+      ns, std::vector<std::vector<std::pair<std::size_t, double>>>(na));
 
   std::vector<std::size_t> state_indices(ns);
   std::iota(state_indices.begin(), state_indices.end(), 0);
 
   std::for_each(
       ExecutionPolicy::policy, state_indices.begin(), state_indices.end(),
-      [this, na, &action_obs_sets](std::size_t si) {
+      [this, na](std::size_t si) {
         const State &s = _states[si];
         if (_domain.is_terminal(s))
           return;
@@ -218,146 +261,171 @@ void SK_SARSOP_CLASS::pre_cache_model() {
                 _domain.get_transition_value(s, _actions[ai], _states[ns_idx])
                     .reward();
             weighted_reward += prob * r;
-
-            auto obs_dist =
-                _domain
-                    .get_observation_distribution(_states[ns_idx], _actions[ai])
-                    .get_values();
-
-            _execution_policy.protect([this, &obs_dist, ns_idx, ai,
-                                       &action_obs_sets] {
-              for (auto od : obs_dist) {
-                std::size_t oh = typename Observation::Hash()(od.observation());
-                _obs_prob[ns_idx][ai][oh] = od.probability();
-                if (_obs_objects.find(oh) == _obs_objects.end()) {
-                  _obs_objects[oh] = od.observation();
-                }
-                action_obs_sets[ai].insert(oh);
-              }
-            });
           }
 
           _rewards[si][ai] = weighted_reward;
         }
       });
 
+  // Query the observation distribution of each reachable (s', a) once rather
+  // than once per predecessor of s'
+  std::vector<std::vector<bool>> reachable(ns, std::vector<bool>(na, false));
+  for (std::size_t si = 0; si < ns; ++si) {
+    for (std::size_t ai = 0; ai < na; ++ai) {
+      for (const auto &tr : _transitions[si][ai]) {
+        reachable[tr.second][ai] = true;
+      }
+    }
+  }
+
+  // Track which observations we've seen per action
+  std::vector<std::unordered_set<std::size_t>> action_obs_sets(na);
+
+  std::for_each(
+      ExecutionPolicy::policy, state_indices.begin(), state_indices.end(),
+      [this, na, &reachable, &observations, &action_obs_sets](std::size_t si) {
+        for (std::size_t ai = 0; ai < na; ++ai) {
+          if (!reachable[si][ai])
+            continue;
+
+          auto obs_dist =
+              _domain.get_observation_distribution(_states[si], _actions[ai])
+                  .get_values();
+          for (auto od : obs_dist) {
+            observations[si][ai].emplace_back(
+                observation_id(od.observation()), od.probability());
+          }
+
+          _execution_policy.protect(
+              [&observations, &action_obs_sets, si, ai] {
+                for (const auto &op : observations[si][ai]) {
+                  action_obs_sets[ai].insert(op.first);
+                }
+              });
+        }
+      });
+
   // Flatten observation sets to vectors for iteration
+  _action_obs_hashes.assign(na, std::vector<std::size_t>());
   for (std::size_t ai = 0; ai < na; ++ai) {
     _action_obs_hashes[ai].assign(action_obs_sets[ai].begin(),
                                   action_obs_sets[ai].end());
   }
+}
 
-  if (_verbose)
-    Logger::debug("SARSOP: model pre-cached");
+SK_SARSOP_TEMPLATE_DECL
+std::size_t SK_SARSOP_CLASS::observation_id(const Observation &o) const {
+  return _model_cache_path.empty() ? typename Observation::Hash()(o)
+                                   : pomdp_model_cache::stable_id(o);
 }
 
 // --- Alpha-vector operations ---
 
 SK_SARSOP_TEMPLATE_DECL
-double SK_SARSOP_CLASS::dot_product(const AlphaVector &alpha,
-                                    const Belief &b) const {
-  double result = 0.0;
-  for (const auto &p : b) {
-    auto it = _state_hash_to_idx.find(p.first);
-    if (it != _state_hash_to_idx.end()) {
-      result += alpha.values[it->second] * p.second;
-    }
-  }
-  return result;
+double SK_SARSOP_CLASS::evaluate_lower(const BeliefVector &b) const {
+  double best = -std::numeric_limits<double>::infinity();
+  _alpha_vectors.snapshot().best_dot(
+      b, [](double x, double y) { return x > y; },
+      -std::numeric_limits<double>::infinity(), best);
+  return best;
 }
 
 SK_SARSOP_TEMPLATE_DECL
-double SK_SARSOP_CLASS::evaluate_lower(const Belief &b) const {
-  if (_alpha_vectors.empty())
-    return -std::numeric_limits<double>::infinity();
+std::size_t
+SK_SARSOP_CLASS::best_alpha_index(const AlphaVectors &alpha_vectors,
+                                  const BeliefVector &b) const {
   double best = -std::numeric_limits<double>::infinity();
-  for (const auto &alpha : _alpha_vectors) {
-    double v = dot_product(alpha, b);
-    if (v > best)
-      best = v;
+  return alpha_vectors.best_dot(
+      b, [](double x, double y) { return x > y; },
+      -std::numeric_limits<double>::infinity(), best);
+}
+
+SK_SARSOP_TEMPLATE_DECL
+void SK_SARSOP_CLASS::best_alpha_dots(
+    const AlphaVectors &alpha_vectors,
+    const std::vector<const BeliefVector *> &beliefs,
+    std::vector<double> &values, std::vector<std::size_t> &indices) const {
+  auto is_better = [](double x, double y) { return x > y; };
+  if (_nb_sampling_threads > 1) {
+    alpha_vectors.template best_dots<SequentialExecution>(
+        beliefs, is_better, -std::numeric_limits<double>::infinity(), values,
+        indices);
+  } else {
+    alpha_vectors.template best_dots<ExecutionPolicy>(
+        beliefs, is_better, -std::numeric_limits<double>::infinity(), values,
+        indices);
   }
-  return best;
 }
 
 SK_SARSOP_TEMPLATE_DECL
-std::size_t SK_SARSOP_CLASS::best_alpha_index(const Belief &b) const {
-  double best = -std::numeric_limits<double>::infinity();
-  std::size_t best_idx = 0;
-  for (std::size_t i = 0; i < _alpha_vectors.size(); ++i) {
-    double v = dot_product(_alpha_vectors[i], b);
-    if (v > best) {
-      best = v;
-      best_idx = i;
-    }
+template <typename Function>
+void SK_SARSOP_CLASS::for_each_index(std::size_t n, const Function &f) const {
+  std::vector<std::size_t> indices(n);
+  std::iota(indices.begin(), indices.end(), 0);
+  if (_nb_sampling_threads > 1) {
+    // The sampling threads already occupy the cores
+    std::for_each(indices.begin(), indices.end(), f);
+  } else {
+    std::for_each(ExecutionPolicy::policy, indices.begin(), indices.end(), f);
   }
-  return best_idx;
 }
 
 // --- Upper bound ---
 
 SK_SARSOP_TEMPLATE_DECL
-double SK_SARSOP_CLASS::evaluate_upper_corner(const Belief &b) const {
-  double v = 0.0;
-  for (const auto &p : b) {
-    auto it = _state_hash_to_idx.find(p.first);
-    if (it != _state_hash_to_idx.end()) {
-      v += p.second * _mdp_values[it->second];
-    }
-  }
-  return v;
+double SK_SARSOP_CLASS::evaluate_upper_corner(const BeliefVector &b) const {
+  return b.dot(_mdp_values.data());
 }
 
 SK_SARSOP_TEMPLATE_DECL
-double SK_SARSOP_CLASS::evaluate_upper(const Belief &b) const {
+double SK_SARSOP_CLASS::evaluate_upper(const BeliefVector &b) const {
   double v_corner = evaluate_upper_corner(b);
 
-  for (const auto &pt : _ub_points) {
+  // Interior points appended concurrently after size() are ignored
+  _ub_points.for_each(0, _ub_points.size(), [this, &b, &v_corner](
+                                                std::size_t,
+                                                const UpperBoundPoint &pt) {
     // Compute c = min_{s in support(b_i)} b(s) / b_i(s)
     double c = std::numeric_limits<double>::infinity();
     bool valid = true;
-    for (const auto &p : pt.belief) {
-      if (p.second <= 0.0)
-        continue;
-      auto it = b.find(p.first);
-      double b_s = (it != b.end()) ? it->second : 0.0;
-      double ratio = b_s / p.second;
+    pt.belief.for_each([&b, &c, &valid](std::size_t si, double pt_s) {
+      if (!valid)
+        return;
+      double ratio = b[si] / pt_s;
       if (ratio <= 0.0) {
         valid = false;
-        break;
+        return;
       }
       c = std::min(c, ratio);
-    }
+    });
     if (!valid || c <= 0.0 || std::isinf(c))
-      continue;
+      return;
 
     // Compute residual belief and its corner value
-    Belief b_res;
     double one_minus_c = 1.0 - c;
     if (one_minus_c <= _prob_epsilon) {
       // c >= 1: the point fully covers the belief
       v_corner = std::min(v_corner, pt.value);
-      continue;
+      return;
     }
     double v_res = 0.0;
-    for (const auto &p : b) {
-      auto pt_it = pt.belief.find(p.first);
-      double pt_s = (pt_it != pt.belief.end()) ? pt_it->second : 0.0;
-      double res = (p.second - c * pt_s) / one_minus_c;
+    b.for_each([this, &pt, &c, &one_minus_c, &v_res](std::size_t si,
+                                                      double b_s) {
+      double res = (b_s - c * pt.belief[si]) / one_minus_c;
       if (res > 0.0) {
-        auto idx_it = _state_hash_to_idx.find(p.first);
-        if (idx_it != _state_hash_to_idx.end()) {
-          v_res += res * _mdp_values[idx_it->second];
-        }
+        v_res += res * _mdp_values[si];
       }
-    }
+    });
 
     double candidate = c * pt.value + one_minus_c * v_res;
     v_corner = std::min(v_corner, candidate);
-  }
+  });
 
   return v_corner;
 }
 
+// Called with the mutex of the node locked
+
 SK_SARSOP_TEMPLATE_DECL
 void SK_SARSOP_CLASS::update_upper_bound(BeliefTreeNode *node) {
   if (!node->expanded)
@@ -384,7 +452,12 @@ void SK_SARSOP_CLASS::update_upper_bound(BeliefTreeNode *node) {
 
   // Add interior point only if the upper bound actually improved
   if (node->upper_bound < old_ub - _ub_improvement_epsilon) {
-    _ub_points.push_back({node->belief, node->upper_bound});
+    _execution_policy.protect(
+        [this, node] {
+          _ub_points.emplace_back(
+              UpperBoundPoint{node->belief, node->upper_bound});
+        },
+        _ub_points_mutex);
   }
 }
 
@@ -398,12 +471,12 @@ void SK_SARSOP_CLASS::initialize_lower_bound() {
   // Blind policy: for each action a, compute the fixed-action value
   // alpha_a(s) = R(s,a) + gamma * sum_{s'} T(s'|s,a) * alpha_a(s')
   for (std::size_t ai = 0; ai < na; ++ai) {
-    AlphaVector alpha(ns, _actions[ai], _next_alpha_id++);
+    std::vector<double> alpha(ns, 0.0);
 
     // Initialize with R(s,a) / (1-gamma) if discount < 1
     if (_discount < 1.0) {
       for (std::size_t si = 0; si < ns; ++si) {
-        alpha.values[si] = _rewards[si][ai] / (1.0 - _discount);
+        alpha[si] = _rewards[si][ai] / (1.0 - _discount);
       }
     }
 
@@ -420,20 +493,20 @@ void SK_SARSOP_CLASS::initialize_lower_bound() {
           [this, ai, &alpha, &new_values, &max_change](std::size_t si) {
             double v = _rewards[si][ai];
             for (const auto &tr : _transitions[si][ai]) {
-              v += _discount * tr.first * alpha.values[tr.second];
+              v += _discount * tr.first * alpha[tr.second];
             }
             new_values[si] = v;
-            double change = std::abs(v - alpha.values[si]);
+            double change = std::abs(v - alpha[si]);
             _execution_policy.protect([&max_change, change] {
               max_change = std::max(max_change, change);
             });
           });
-      alpha.values = std::move(new_values);
+      alpha = std::move(new_values);
       if (max_change < _epsilon * _vi_convergence_factor)
         break;
     }
 
-    _alpha_vectors.push_back(std::move(alpha));
+    _alpha_vectors.append(alpha.data(), ai);
   }
 
   if (_verbose)
@@ -501,48 +574,25 @@ void SK_SARSOP_CLASS::initialize_upper_bound() {
 // --- Belief operations ---
 
 SK_SARSOP_TEMPLATE_DECL
-typename SK_SARSOP_CLASS::Belief
-SK_SARSOP_CLASS::compute_posterior(const Belief &b, std::size_t action_idx,
-                                   std::size_t obs_hash) const {
-  // Prediction: b_a(s') = sum_s T(s'|s,a) * b(s)
-  Belief b_a;
-  for (const auto &p : b) {
-    auto idx_it = _state_hash_to_idx.find(p.first);
-    if (idx_it == _state_hash_to_idx.end())
-      continue;
-    std::size_t si = idx_it->second;
-    for (const auto &tr : _transitions[si][action_idx]) {
-      std::size_t ns_hash = typename State::Hash()(_states[tr.second]);
-      b_a[ns_hash] += p.second * tr.first;
-    }
-  }
-
-  // Posterior: b^o_a(s') = Z(o|s',a) * b_a(s') / P(o|b,a)
-  Belief posterior;
+BeliefVector SK_SARSOP_CLASS::compute_posterior(const BeliefVector &b,
+                                                std::size_t action_idx,
+                                                std::size_t obs_idx) const {
+  // b^o_a(s') = sum_s b(s) T(s'|s,a) Z(o|s',a) / P(o|b,a)
   double normalizer = 0.0;
-  for (const auto &p : b_a) {
-    auto idx_it = _state_hash_to_idx.find(p.first);
-    if (idx_it == _state_hash_to_idx.end())
-      continue;
-    std::size_t sp_idx = idx_it->second;
-    auto obs_it = _obs_prob[sp_idx][action_idx].find(obs_hash);
-    double z =
-        (obs_it != _obs_prob[sp_idx][action_idx].end()) ? obs_it->second : 0.0;
-    double val = z * p.second;
-    if (val > 0.0) {
-      posterior[p.first] = val;
-      normalizer += val;
-    }
-  }
+  return _tensors.posterior(b, action_idx, obs_idx, 0.0, normalizer);
+}
 
-  // Normalize
-  if (normalizer > 0.0) {
-    for (auto &p : posterior) {
-      p.second /= normalizer;
+SK_SARSOP_TEMPLATE_DECL
+BeliefVector SK_SARSOP_CLASS::to_belief_vector(const Belief &b) const {
+  std::vector<std::pair<std::size_t, double>> entries;
+  entries.reserve(b.size());
+  for (const auto &p : b) {
+    auto it = _state_hash_to_idx.find(p.first);
+    if (it != _state_hash_to_idx.end()) {
+      entries.emplace_back(it->second, p.second);
     }
   }
-
-  return posterior;
+  return BeliefVector(_states.size(), std::move(entries));
 }
 
 // --- Belief tree ---
@@ -551,9 +601,10 @@ SK_SARSOP_TEMPLATE_DECL
 void SK_SARSOP_CLASS::initialize_belief_node(BeliefTreeNode *node) {
   node->lower_bound = evaluate_lower(node->belief);
   node->upper_bound = evaluate_upper(node->belief);
-  node->best_alpha_idx = best_alpha_index(node->belief);
 }
 
+// Called with the mutex of the node locked
+
 SK_SARSOP_TEMPLATE_DECL
 void SK_SARSOP_CLASS::expand_node(BeliefTreeNode *node) {
   if (node->expanded)
@@ -562,42 +613,31 @@ void SK_SARSOP_CLASS::expand_node(BeliefTreeNode *node) {
   std::size_t na = _actions.size();
   node->action_edges.reserve(na);
 
+  // Children in creation order, with their action and observation
+  // probability
+  struct NewChild {
+    std::size_t action_idx;
+    double obs_probability;
+    BeliefTreeNode *node;
+  };
+  std::vector<NewChild> new_children;
+
   for (std::size_t ai = 0; ai < na; ++ai) {
     node->action_edges.emplace_back(_actions[ai]);
     auto &ae = node->action_edges.back();
 
     // Expected immediate reward: R(b,a) = sum_s b(s) * R(s,a)
     ae.expected_reward = 0.0;
-    for (const auto &bp : node->belief) {
-      auto idx_it = _state_hash_to_idx.find(bp.first);
-      if (idx_it != _state_hash_to_idx.end()) {
-        ae.expected_reward += bp.second * _rewards[idx_it->second][ai];
-      }
-    }
-
-    // Compute P(o|b,a) for each observation
-    // P(o|b,a) = sum_s sum_{s'} b(s) T(s'|s,a) Z(o|s',a)
-    for (const auto &bp : node->belief) {
-      auto idx_it = _state_hash_to_idx.find(bp.first);
-      if (idx_it == _state_hash_to_idx.end())
-        continue;
-      std::size_t si = idx_it->second;
-      for (const auto &tr : _transitions[si][ai]) {
-        for (const auto &op : _obs_prob[tr.second][ai]) {
-          ae.obs_probs[op.first] += bp.second * tr.first * op.second;
-        }
-      }
-    }
-
-    // Create children for observations with positive probability
-    ae.q_lower = ae.expected_reward;
-    ae.q_upper = ae.expected_reward;
-
-    for (const auto &op : ae.obs_probs) {
-      if (op.second <= _prob_epsilon)
-        continue;
-
-      Belief posterior = compute_posterior(node->belief, ai, op.first);
+    node->belief.for_each([this, &ai, &ae](std::size_t si, double p) {
+      ae.expected_reward += p * _rewards[si][ai];
+    });
+
+    // Create children for observations with positive probability, whose
+    // posterior mass is P(o|b,a) = sum_s sum_{s'} b(s) T(s'|s,a) Z(o|s',a)
+    for (std::size_t oi = 0; oi < _tensors.nb_observations(ai); ++oi) {
+      double obs_p = 0.0;
+      BeliefVector posterior =
+          _tensors.posterior(node->belief, ai, oi, _prob_epsilon, obs_p);
       if (posterior.empty())
         continue;
 
@@ -605,16 +645,41 @@ void SK_SARSOP_CLASS::expand_node(BeliefTreeNode *node) {
       child->belief = std::move(posterior);
       child->parent = node;
       child->depth = node->depth + 1;
-      initialize_belief_node(child.get());
-      _nb_beliefs++;
-
-      ae.q_lower += _discount * op.second * child->lower_bound;
-      ae.q_upper += _discount * op.second * child->upper_bound;
+      child->id = _nb_beliefs++;
+      new_children.push_back({ai, obs_p, child.get()});
 
-      ae.children[op.first] = std::move(child);
+      ae.obs_probs[oi] = obs_p;
+      ae.children[oi] = std::move(child);
     }
   }
 
+  // Initialize the bounds of all the children at once
+  std::vector<const BeliefVector *> beliefs(new_children.size());
+  for (std::size_t k = 0; k < new_children.size(); ++k) {
+    beliefs[k] = &new_children[k].node->belief;
+  }
+  std::vector<double> lower_bounds;
+  std::vector<std::size_t> alpha_indices;
+  best_alpha_dots(_alpha_vectors.snapshot(), beliefs, lower_bounds,
+                  alpha_indices);
+
+  for_each_index(new_children.size(),
+                 [this, &new_children, &lower_bounds](std::size_t k) {
+                   BeliefTreeNode *child = new_children[k].node;
+                   child->lower_bound = lower_bounds[k];
+                   child->upper_bound = evaluate_upper(child->belief);
+                 });
+
+  for (auto &ae : node->action_edges) {
+    ae.q_lower = ae.expected_reward;
+    ae.q_upper = ae.expected_reward;
+  }
+  for (const auto &nc : new_children) {
+    auto &ae = node->action_edges[nc.action_idx];
+    ae.q_lower += _discount * nc.obs_probability * nc.node->lower_bound;
+    ae.q_upper += _discount * nc.obs_probability * nc.node->upper_bound;
+  }
+
   node->expanded = true;
 
   // Update node bounds from action edges
@@ -632,61 +697,76 @@ void SK_SARSOP_CLASS::expand_node(BeliefTreeNode *node) {
 
 // --- SARSOP core: sample ---
 
+SK_SARSOP_TEMPLATE_DECL
+typename SK_SARSOP_CLASS::ExecutionPolicy::Mutex &
+SK_SARSOP_CLASS::node_mutex(const BeliefTreeNode *node) {
+  return _node_mutexes[node->id % nb_node_mutexes];
+}
+
 SK_SARSOP_TEMPLATE_DECL
 std::vector<typename SK_SARSOP_CLASS::BeliefTreeNode *>
 SK_SARSOP_CLASS::sample() {
   std::vector<BeliefTreeNode *> path;
   BeliefTreeNode *node = _root.get();
+  node->nb_active_trials++;
   path.push_back(node);
 
   std::size_t max_depth = _max_sample_depth;
 
-  while (node->depth < max_depth && !node->pruned) {
+  // Trials in progress stop expanding nodes once another thread has stopped
+  // the trials, e.g. because of the belief budget
+  while (node->depth < max_depth && !node->pruned && !_stop_trials) {
     double gap = node->upper_bound - node->lower_bound;
     if (gap < _epsilon)
       break;
 
-    if (!node->expanded) {
-      expand_node(node);
-      if (node->action_edges.empty())
-        break;
-    }
-
-    // Pick action with max Q_upper
-    double best_q = -std::numeric_limits<double>::infinity();
-    std::size_t best_a_idx = 0;
-    for (std::size_t ai = 0; ai < node->action_edges.size(); ++ai) {
-      if (node->action_edges[ai].q_upper > best_q) {
-        best_q = node->action_edges[ai].q_upper;
-        best_a_idx = ai;
-      }
-    }
-
-    auto &ae = node->action_edges[best_a_idx];
-    if (ae.children.empty())
-      break;
-
-    // Pick observation with largest weighted gap at successor
-    double best_gap = -std::numeric_limits<double>::infinity();
-    std::size_t best_obs_hash = 0;
     BeliefTreeNode *best_child = nullptr;
 
-    for (auto &child_entry : ae.children) {
-      BeliefTreeNode *child = child_entry.second.get();
-      auto obs_it = ae.obs_probs.find(child_entry.first);
-      double obs_p = (obs_it != ae.obs_probs.end()) ? obs_it->second : 0.0;
-      double child_gap = obs_p * (child->upper_bound - child->lower_bound);
-      if (child_gap > best_gap) {
-        best_gap = child_gap;
-        best_obs_hash = child_entry.first;
-        best_child = child;
-      }
-    }
+    _execution_policy.protect(
+        [this, &node, &best_child] {
+          if (!node->expanded) {
+            expand_node(node);
+          }
+          if (node->action_edges.empty())
+            return;
+
+          // Pick action with max Q_upper
+          double best_q = -std::numeric_limits<double>::infinity();
+          std::size_t best_a_idx = 0;
+          for (std::size_t ai = 0; ai < node->action_edges.size(); ++ai) {
+            if (node->action_edges[ai].q_upper > best_q) {
+              best_q = node->action_edges[ai].q_upper;
+              best_a_idx = ai;
+            }
+          }
+
+          // Pick observation with largest weighted gap at successor, divided
+          // by one plus the number of other trials going through the
+          // successor so that concurrent trials spread over the observations
+          auto &ae = node->action_edges[best_a_idx];
+          double best_gap = -std::numeric_limits<double>::infinity();
+
+          for (auto &child_entry : ae.children) {
+            BeliefTreeNode *child = child_entry.second.get();
+            auto obs_it = ae.obs_probs.find(child_entry.first);
+            double obs_p =
+                (obs_it != ae.obs_probs.end()) ? obs_it->second : 0.0;
+            double child_gap = obs_p *
+                               (child->upper_bound - child->lower_bound) /
+                               (1.0 + child->nb_active_trials);
+            if (child_gap > best_gap) {
+              best_gap = child_gap;
+              best_child = child;
+            }
+          }
+        },
+        node_mutex(node));
 
     if (best_child == nullptr)
       break;
 
     node = best_child;
+    node->nb_active_trials++;
     path.push_back(node);
   }
 
@@ -696,61 +776,84 @@ SK_SARSOP_CLASS::sample() {
 // --- SARSOP core: backup ---
 
 SK_SARSOP_TEMPLATE_DECL
-typename SK_SARSOP_CLASS::AlphaVector
-SK_SARSOP_CLASS::backup_belief(BeliefTreeNode *node) {
+void SK_SARSOP_CLASS::backup_belief(BeliefTreeNode *node) {
   std::size_t ns = _states.size();
   std::size_t na = _actions.size();
 
-  double best_q = -std::numeric_limits<double>::infinity();
-  AlphaVector best_alpha;
+  // Posterior beliefs tau(b,a,o) for each action and observation
+  struct Successor {
+    std::size_t obs_idx;
+    BeliefVector belief;
+  };
+  std::vector<std::vector<Successor>> successors(na);
+
+  for_each_index(na, [this, node, &successors](std::size_t ai) {
+    for (std::size_t oi = 0; oi < _tensors.nb_observations(ai); ++oi) {
+      BeliefVector posterior = compute_posterior(node->belief, ai, oi);
+      if (!posterior.empty()) {
+        successors[ai].push_back({oi, std::move(posterior)});
+      }
+    }
+  });
 
+  // Find best alpha for each posterior belief, as one batched product
+  std::vector<const BeliefVector *> beliefs;
+  std::vector<std::size_t> offsets(na, 0);
   for (std::size_t ai = 0; ai < na; ++ai) {
-    AlphaVector g_a(ns, _actions[ai], _next_alpha_id);
-
-    // Start with R(s,a)
-    for (std::size_t si = 0; si < ns; ++si) {
-      g_a.values[si] = _rewards[si][ai];
+    offsets[ai] = beliefs.size();
+    for (const auto &succ : successors[ai]) {
+      beliefs.push_back(&succ.belief);
     }
+  }
+  // The rows are read from the snapshot on which they were selected, which
+  // concurrent prunings do not renumber
+  AlphaVectors alpha_vectors = _alpha_vectors.snapshot();
+  std::vector<double> best_values;
+  std::vector<std::size_t> best_indices;
+  best_alpha_dots(alpha_vectors, beliefs, best_values, best_indices);
+
+  std::vector<std::vector<double>> candidates(na);
+  std::vector<double> q_values(na);
+
+  for_each_index(
+      na, [this, ns, node, &successors, &offsets, &alpha_vectors,
+           &best_indices, &candidates, &q_values](std::size_t ai) {
+        // Start with R(s,a)
+        std::vector<double> g_a(ns);
+        for (std::size_t si = 0; si < ns; ++si) {
+          g_a[si] = _rewards[si][ai];
+        }
 
-    // For each observation, add gamma * g_{a,o}(s)
-    for (std::size_t oh : _action_obs_hashes[ai]) {
-      // Find best alpha for posterior belief tau(b,a,o)
-      Belief posterior = compute_posterior(node->belief, ai, oh);
-      if (posterior.empty())
-        continue;
-
-      std::size_t best_idx = best_alpha_index(posterior);
-      const AlphaVector &alpha_ao = _alpha_vectors[best_idx];
+        // For each observation, add gamma * g_{a,o}(s)
+        for (std::size_t k = 0; k < successors[ai].size(); ++k) {
+          std::size_t oi = successors[ai][k].obs_idx;
+          const double *alpha_ao =
+              alpha_vectors.row(best_indices[offsets[ai] + k]);
 
-      // g_{a,o}(s) = sum_{s'} T(s,a,s') * Z(o|s',a) * alpha_{a,o}(s')
-      for (std::size_t si = 0; si < ns; ++si) {
-        double contrib = 0.0;
-        for (const auto &tr : _transitions[si][ai]) {
-          auto obs_it = _obs_prob[tr.second][ai].find(oh);
-          double z =
-              (obs_it != _obs_prob[tr.second][ai].end()) ? obs_it->second : 0.0;
-          contrib += tr.first * z * alpha_ao.values[tr.second];
+          // g_{a,o}(s) = sum_{s'} T(s,a,s') * Z(o|s',a) * alpha_{a,o}(s')
+          for (std::size_t si = 0; si < ns; ++si) {
+            g_a[si] += _discount * _tensors.back_project(ai, oi, si, alpha_ao);
+          }
         }
-        g_a.values[si] += _discount * contrib;
-      }
-    }
 
-    // Compute Q(b,a) = g_a . b
-    double q_val = dot_product(g_a, node->belief);
-    if (q_val > best_q) {
-      best_q = q_val;
-      best_alpha = std::move(g_a);
+        // Compute Q(b,a) = g_a . b
+        q_values[ai] = node->belief.dot(g_a.data());
+        candidates[ai] = std::move(g_a);
+      });
+
+  double best_q = -std::numeric_limits<double>::infinity();
+  std::size_t best_ai = 0;
+  for (std::size_t ai = 0; ai < na; ++ai) {
+    if (q_values[ai] > best_q) {
+      best_q = q_values[ai];
+      best_ai = ai;
     }
   }
 
-  best_alpha.id = _next_alpha_id++;
-  _alpha_vectors.push_back(best_alpha);
+  _alpha_vectors.append(candidates[best_ai].data(), best_ai);
 
   // Update node bounds
   node->lower_bound = best_q;
-  node->best_alpha_idx = _alpha_vectors.size() - 1;
-
-  return best_alpha;
 }
 
 SK_SARSOP_TEMPLATE_DECL
@@ -759,7 +862,77 @@ void SK_SARSOP_CLASS::backup(const std::vector<BeliefTreeNode *> &path) {
   for (auto it = path.rbegin(); it != path.rend(); ++it) {
     BeliefTreeNode *node = *it;
     backup_belief(node);
-    update_upper_bound(node);
+    _execution_policy.protect([this, node] { update_upper_bound(node); },
+                              node_mutex(node));
+    node->nb_active_trials--;
+  }
+}
+
+// --- SARSOP core: trials ---
+
+SK_SARSOP_TEMPLATE_DECL
+bool SK_SARSOP_CLASS::stop_trials() {
+  if (_stop_trials)
+    return true;
+
+  std::string reason;
+  double gap = _root->upper_bound - _root->lower_bound;
+  if (gap < _epsilon) {
+    reason = "converged at gap = " + std::to_string(gap);
+  } else if (elapsed_ms() >= _time_budget) {
+    reason = "time budget reached";
+  } else if (_nb_beliefs >= _max_beliefs) {
+    reason = "belief budget reached";
+  } else if (_callback(*this, _domain)) {
+    reason = "stopped by callback";
+  } else {
+    return false;
+  }
+
+  _execution_policy.protect([this, &reason] {
+    if (!_stop_trials) {
+      _stop_trials = true;
+      if (_verbose)
+        Logger::debug("SARSOP: " + reason);
+    }
+  });
+  return true;
+}
+
+SK_SARSOP_TEMPLATE_DECL
+void SK_SARSOP_CLASS::run_trials() {
+  while (!stop_trials()) {
+    auto path = sample();
+    backup(path);
+
+    std::size_t iteration = _nb_iterations++;
+
+    // Prune periodically
+    if (_pruning_interval > 0 && iteration % _pruning_interval == 0) {
+      request_pruning();
+    }
+
+    // Update root bounds after backup
+    double lower_bound = evaluate_lower(_root->belief);
+    double upper_bound = evaluate_upper(_root->belief);
+    _execution_policy.protect(
+        [this, &lower_bound, &upper_bound] {
+          if (lower_bound > _root->lower_bound)
+            _root->lower_bound = lower_bound;
+          if (upper_bound < _root->upper_bound)
+            _root->upper_bound = upper_bound;
+        },
+        node_mutex(_root.get()));
+
+    if (_verbose && _logging_interval > 0 &&
+        (iteration + 1) % _logging_interval == 0) {
+      Logger::debug(
+          "SARSOP: iteration " + std::to_string(iteration + 1) +
+          ", gap = " + std::to_string(_root->upper_bound - _root->lower_bound) +
+          ", alpha-vectors = " + std::to_string(_alpha_vectors.size()) +
+          ", beliefs = " + std::to_string(_nb_beliefs) +
+          ExecutionPolicy::print_thread());
+    }
   }
 }
 
@@ -767,53 +940,88 @@ void SK_SARSOP_CLASS::backup(const std::vector<BeliefTreeNode *> &path) {
 
 SK_SARSOP_TEMPLATE_DECL
 void SK_SARSOP_CLASS::prune() {
-  if (_alpha_vectors.size() <= 1)
+  AlphaVectors alpha_vectors = _alpha_vectors.snapshot();
+  std::size_t nb_alpha_vectors = alpha_vectors.size();
+  if (nb_alpha_vectors <= 1)
     return;
 
   // Delta-dominance pruning: remove alpha_i if there exists alpha_j
   // such that alpha_j(s) >= alpha_i(s) - delta for all s
   std::size_t ns = _states.size();
-  std::vector<bool> dominated(_alpha_vectors.size(), false);
+  std::vector<const double *> rows(nb_alpha_vectors);
+  for (std::size_t i = 0; i < nb_alpha_vectors; ++i) {
+    rows[i] = alpha_vectors.row(i);
+  }
+  std::vector<bool> removed(nb_alpha_vectors, false);
+  std::vector<std::size_t> kept;
 
-  for (std::size_t i = 0; i < _alpha_vectors.size(); ++i) {
-    if (dominated[i])
-      continue;
-    for (std::size_t j = 0; j < _alpha_vectors.size(); ++j) {
-      if (i == j || dominated[j])
+  for (std::size_t i = 0; i < nb_alpha_vectors; ++i) {
+    const double *alpha_i = rows[i];
+    for (std::size_t j = 0; j < nb_alpha_vectors; ++j) {
+      if (i == j || removed[j])
         continue;
       // Check if j dominates i (j >= i - delta for all s)
+      const double *alpha_j = rows[j];
       bool j_dominates_i = true;
       for (std::size_t s = 0; s < ns; ++s) {
-        if (_alpha_vectors[j].values[s] <
-            _alpha_vectors[i].values[s] - _pruning_delta) {
+        if (alpha_j[s] < alpha_i[s] - _pruning_delta) {
           j_dominates_i = false;
           break;
         }
       }
       if (j_dominates_i) {
-        dominated[i] = true;
+        removed[i] = true;
         break;
       }
     }
-  }
-
-  // Remove dominated vectors
-  std::vector<AlphaVector> survivors;
-  survivors.reserve(_alpha_vectors.size());
-  for (std::size_t i = 0; i < _alpha_vectors.size(); ++i) {
-    if (!dominated[i]) {
-      survivors.push_back(std::move(_alpha_vectors[i]));
+    if (!removed[i]) {
+      kept.push_back(i);
     }
   }
 
-  if (_verbose && survivors.size() < _alpha_vectors.size()) {
+  // The alpha-vectors appended since the snapshot are kept, and the
+  // evaluations running on older snapshots are unaffected
+  if (kept.size() == nb_alpha_vectors ||
+      !_alpha_vectors.replace(alpha_vectors, kept))
+    return;
+
+  if (_verbose) {
     Logger::debug("SARSOP: pruned " +
-                  std::to_string(_alpha_vectors.size() - survivors.size()) +
-                  " alpha-vectors, " + std::to_string(survivors.size()) +
+                  std::to_string(nb_alpha_vectors - kept.size()) +
+                  " alpha-vectors, " + std::to_string(_alpha_vectors.size()) +
                   " remaining");
   }
+}
+
+SK_SARSOP_TEMPLATE_DECL
+void SK_SARSOP_CLASS::request_pruning() {
+  if constexpr (!is_concurrent_execution<ExecutionPolicy>::value) {
+    prune();
+  } else {
+    {
+      std::lock_guard<std::mutex> lock(_pruning_mutex);
+      _pruning_requested = true;
+    }
+    _pruning_condition.notify_one();
+  }
+}
 
-  _alpha_vectors = std::move(survivors);
+// Loop of the background pruning thread, which coalesces the requests made
+// while it is pruning
+
+SK_SARSOP_TEMPLATE_DECL
+void SK_SARSOP_CLASS::run_pruning() {
+  std::unique_lock<std::mutex> lock(_pruning_mutex);
+  while (true) {
+    _pruning_condition.wait(
+        lock, [this] { return _pruning_requested || _stop_pruning; });
+    if (_stop_pruning)
+      break;
+    _pruning_requested = false;
+    lock.unlock();
+    prune();
+    lock.lock();
+  }
 }
 
 // --- solve ---
@@ -836,12 +1044,13 @@ void SK_SARSOP_CLASS::solve(
   pre_cache_model();
 
   // Initialize bounds
+  _alpha_vectors.reset(_states.size());
   initialize_lower_bound();
   initialize_upper_bound();
 
   // Build root belief tree node
   _root = std::make_unique<BeliefTreeNode>();
-  _root->belief = b0;
+  _root->belief = to_belief_vector(b0);
   initialize_belief_node(_root.get());
   _nb_beliefs = 1;
 
@@ -849,71 +1058,52 @@ void SK_SARSOP_CLASS::solve(
     Logger::debug(
         "SARSOP: initial lower bound = " + std::to_string(_root->lower_bound) +
         ", upper bound = " + std::to_string(_root->upper_bound) +
-        ", gap = " + std::to_string(_root->upper_bound - _root->lower_bound));
+        ", gap = " + std::to_string(_root->upper_bound - _root->lower_bound) +
+        ", sampling threads = " + std::to_string(_nb_sampling_threads));
   }
 
-  // Main loop
-  std::size_t iteration = 0;
-  while (true) {
-    double gap = _root->upper_bound - _root->lower_bound;
-    if (gap < _epsilon) {
-      if (_verbose)
-        Logger::debug("SARSOP: converged at gap = " + std::to_string(gap));
-      break;
+  // Main loop, run by each sampling thread while the background thread
+  // prunes the alpha-vectors on request
+  _stop_trials = false;
+  std::thread pruning_thread;
+  if constexpr (is_concurrent_execution<ExecutionPolicy>::value) {
+    if (_pruning_interval > 0) {
+      _pruning_requested = false;
+      _stop_pruning = false;
+      pruning_thread = std::thread([this] { run_pruning(); });
     }
-    if (elapsed_ms() >= _time_budget) {
-      if (_verbose)
-        Logger::debug("SARSOP: time budget reached");
-      break;
-    }
-    if (_nb_beliefs >= _max_beliefs) {
-      if (_verbose)
-        Logger::debug("SARSOP: belief budget reached");
-      break;
-    }
-    if (_callback(*this, _domain)) {
-      if (_verbose)
-        Logger::debug("SARSOP: stopped by callback");
-      break;
-    }
-
-    auto path = sample();
-    backup(path);
-
-    // Prune periodically
-    if (_pruning_interval > 0 && iteration % _pruning_interval == 0) {
-      prune();
-    }
-
-    // Update root bounds after backup
-    _root->lower_bound =
-        std::max(_root->lower_bound, evaluate_lower(_root->belief));
-    _root->upper_bound =
-        std::min(_root->upper_bound, evaluate_upper(_root->belief));
-
-    ++iteration;
-
-    if (_verbose && _logging_interval > 0 &&
-        iteration % _logging_interval == 0) {
-      Logger::debug(
-          "SARSOP: iteration " + std::to_string(iteration) +
-          ", gap = " + std::to_string(_root->upper_bound - _root->lower_bound) +
-          ", alpha-vectors = " + std::to_string(_alpha_vectors.size()) +
-          ", beliefs = " + std::to_string(_nb_beliefs));
+  }
+  auto stop_pruning = [this, &pruning_thread] {
+    if (pruning_thread.joinable()) {
+      {
+        std::lock_guard<std::mutex> lock(_pruning_mutex);
+        _stop_pruning = true;
+      }
+      _pruning_condition.notify_one();
+      pruning_thread.join();
     }
+  };
+  try {
+    for_each_rollout_lane<ExecutionPolicy>(
+        _nb_sampling_threads,
+        [this](const std::size_t &) { run_trials(); });
+  } catch (...) {
+    stop_pruning();
+    throw;
   }
+  stop_pruning();
 
   // Final prune
   prune();
 
   // Set up belief tracking
-  _current_belief = b0;
+  _current_belief = _root->belief;
   _last_action.reset();
   _has_solution = true;
 
   if (_verbose)
     Logger::debug("SARSOP: solved in " + std::to_string(elapsed_ms()) + "ms, " +
-                  std::to_string(iteration) + " iterations, " +
+                  std::to_string(_nb_iterations) + " iterations, " +
                   std::to_string(_alpha_vectors.size()) + " alpha-vectors, " +
                   std::to_string(_nb_beliefs) + " beliefs, final gap = " +
                   std::to_string(_root->upper_bound - _root->lower_bound));
@@ -932,8 +1122,16 @@ void SK_SARSOP_CLASS::update_current_belief(const Observation &obs) {
   if (ait == _action_hash_to_idx.end())
     return;
 
-  std::size_t obs_hash = typename Observation::Hash()(obs);
-  Belief posterior = compute_posterior(_current_belief, ait->second, obs_hash);
+  std::size_t obs_idx =
+      _tensors.observation_index(ait->second, observation_id(obs));
+  if (obs_idx == _tensors.nb_observations(ait->second)) {
+    Logger::warn("SARSOP: observation " + obs.print() +
+                 " is not in the model, the belief is not updated");
+    return;
+  }
+
+  BeliefVector posterior =
+      compute_posterior(_current_belief, ait->second, obs_idx);
   if (!posterior.empty()) {
     _current_belief = std::move(posterior);
   }
@@ -943,9 +1141,11 @@ SK_SARSOP_TEMPLATE_DECL
 const typename SK_SARSOP_CLASS::Action &
 SK_SARSOP_CLASS::get_best_action(const Observation &obs) {
   update_current_belief(obs);
-  std::size_t idx = best_alpha_index(_current_belief);
-  _last_action = std::make_unique<Action>(_alpha_vectors[idx].action);
-  return _alpha_vectors[idx].action;
+  AlphaVectors alpha_vectors = _alpha_vectors.snapshot();
+  std::size_t idx = best_alpha_index(alpha_vectors, _current_belief);
+  const Action &a = _actions[alpha_vectors.action(idx)];
+  _last_action = std::make_unique<Action>(a);
+  return a;
 }
 
 SK_SARSOP_TEMPLATE_DECL
@@ -974,14 +1174,15 @@ void SK_SARSOP_CLASS::reset_belief() {
 SK_SARSOP_TEMPLATE_DECL
 const typename SK_SARSOP_CLASS::Action &
 SK_SARSOP_CLASS::get_best_action_from_belief(const Belief &b) {
-  std::size_t idx = best_alpha_index(b);
-  return _alpha_vectors[idx].action;
+  AlphaVectors alpha_vectors = _alpha_vectors.snapshot();
+  std::size_t idx = best_alpha_index(alpha_vectors, to_belief_vector(b));
+  return _actions[alpha_vectors.action(idx)];
 }
 
 SK_SARSOP_TEMPLATE_DECL
 typename SK_SARSOP_CLASS::Value
 SK_SARSOP_CLASS::get_best_value_from_belief(const Belief &b) {
-  double v = evaluate_lower(b);
+  double v = evaluate_lower(to_belief_vector(b));
   return Value(v, true);
 }
 
@@ -1011,12 +1212,14 @@ std::size_t SK_SARSOP_CLASS::get_solving_time() const {
 
 SK_SARSOP_TEMPLATE_DECL
 double SK_SARSOP_CLASS::get_initial_lower_bound() const {
-  return _root ? _root->lower_bound : -std::numeric_limits<double>::infinity();
+  return _root ? double(_root->lower_bound)
+               : -std::numeric_limits<double>::infinity();
 }
 
 SK_SARSOP_TEMPLATE_DECL
 double SK_SARSOP_CLASS::get_initial_upper_bound() const {
-  return _root ? _root->upper_bound : std::numeric_limits<double>::infinity();
+  return _root ? double(_root->upper_bound)
+               : std::numeric_limits<double>::infinity();
 }
 
 SK_SARSOP_TEMPLATE_DECL
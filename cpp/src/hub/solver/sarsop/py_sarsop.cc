@@ -16,7 +16,7 @@ void init_pysarsop(py::module &m) {
                     std::size_t, double, std::size_t, double, std::size_t,
                     double, double, std::size_t, std::size_t, bool,
                     const std::function<py::bool_(const py::object &)> &,
-                    bool>(),
+                    bool, const std::string &, std::size_t>(),
            py::arg("solver"), py::arg("domain"), py::arg("epsilon") = 0.001,
            py::arg("discount") = 0.95, py::arg("time_budget") = 300000,
            py::arg("max_beliefs") = 100000, py::arg("pruning_delta") = 1e-6,
@@ -26,7 +26,8 @@ void init_pysarsop(py::module &m) {
            py::arg("ub_improvement_epsilon") = 1e-10,
            py::arg("pruning_interval") = 10, py::arg("logging_interval") = 50,
            py::arg("parallel") = false, py::arg("callback") = nullptr,
-           py::arg("verbose") = false)
+           py::arg("verbose") = false, py::arg("model_cache_path") = "",
+           py::arg("nb_sampling_threads") = 0)
       .def("close", &skdecide::PySARSOPSolver::close)
       .def("clear", &skdecide::PySARSOPSolver::clear)
       .def("solve", &skdecide::PySARSOPSolver::solve, py::arg("distribution"))
@@ -64,7 +64,8 @@ private:
         double prob_epsilon = 1e-15, double ub_improvement_epsilon = 1e-10,
         std::size_t pruning_interval = 10, std::size_t logging_interval = 50,
         const std::function<py::bool_(const py::object &)> &callback = nullptr,
-        bool verbose = false)
+        bool verbose = false, const std::string &model_cache_path = "",
+        std::size_t nb_sampling_threads = 0)
         : _callback(callback) {
 
       _pysolver = std::make_unique<py::object>(solver);
@@ -79,6 +80,8 @@ private:
                  PySARSOPDomain<Texecution> &d) -> bool {
             if (_callback) {
               try {
+                // Called by the sampling threads, which run without the GIL
+                typename GilControl<Texecution>::Acquire acquire;
                 return _callback(*_pysolver);
               } catch (const std::exception &e) {
                 Logger::error(std::string("SKDECIDE exception when calling "
@@ -89,7 +92,7 @@ private:
             }
             return false;
           },
-          verbose);
+          verbose, model_cache_path, nb_sampling_threads);
       _stdout_redirect = std::make_unique<py::scoped_ostream_redirect>(
           std::cout, py::module::import("sys").attr("stdout"));
       _stderr_redirect = std::make_unique<py::scoped_estream_redirect>(
@@ -260,14 +263,15 @@ public:
       double ub_improvement_epsilon = 1e-10, std::size_t pruning_interval = 10,
       std::size_t logging_interval = 50, bool parallel = false,
       const std::function<py::bool_(const py::object &)> &callback = nullptr,
-      bool verbose = false) {
+      bool verbose = false, const std::string &model_cache_path = "",
+      std::size_t nb_sampling_threads = 0) {
     TemplateInstantiator::select(ExecutionSelector(parallel),
                                  SolverInstantiator(_implementation))
         .instantiate(solver, domain, epsilon, discount, time_budget,
                      max_beliefs, pruning_delta, max_vi_iterations,
                      vi_convergence_factor, max_sample_depth, prob_epsilon,
                      ub_improvement_epsilon, pruning_interval, logging_interval,
-                     callback, verbose);
+                     callback, verbose, model_cache_path, nb_sampling_threads);
   }
 
   void close() { _implementation->close(); }
@@ -7,15 +7,23 @@
 
 #include <chrono>
 #include <cmath>
+#include <condition_variable>
 #include <functional>
 #include <limits>
 #include <list>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "utils/belief_vector.hh"
+#include "utils/concurrent_alpha_vector_store.hh"
+#include "utils/concurrent_append_buffer.hh"
 #include "utils/execution.hh"
 #include "utils/logging.hh"
+#include "utils/observation_transition_tensors.hh"
+#include "utils/pomdp_model_cache.hh"
 
 namespace skdecide {
 
@@ -32,6 +40,27 @@ namespace skdecide {
  * It focuses exploration on beliefs reachable under the (unknown) optimal
  * policy via guided belief tree sampling.
  *
+ * Beliefs are keyed by state hash at the interface of the solver, and
+ * internally represented as BeliefVector objects over the enumerated state
+ * indices so that bound evaluations run as vectorized dot products. The
+ * alpha-vectors are stored in a ConcurrentAlphaVectorStore, so that the
+ * lower bounds of all the children of a belief node are evaluated as one
+ * blocked matrix product. The transition and observation probabilities are
+ * compiled into ObservationTransitionTensors, so that belief updates and
+ * alpha-vector backups are sparse matrix products, and the queried model can
+ * be saved to a cache file reloaded by the next solves of the same domain.
+ *
+ * With a parallel execution policy, several threads sample belief tree trials
+ * and back them up concurrently. The expansion of a belief node and the
+ * update of its action edges are protected by one of a fixed set of mutexes
+ * (lock striping), while the bounds of the nodes are atomics read without
+ * locking. A thread descending the tree divides the weighted gaps of the
+ * children by one plus the number of trials going through them, so that the
+ * threads spread over different branches. Bound evaluations run on snapshots
+ * of the alpha-vector set, and pruning runs on a background thread which
+ * swaps in the compacted set. With a single sampling thread, the inner loops
+ * of the expansions and backups are parallelized instead.
+ *
  * @tparam Tdomain Type of the domain class (must be PartiallyObservable)
  * @tparam Texecution_policy Type of the execution policy
  */
@@ -80,6 +109,17 @@ public:
    * @param callback Functor called at the end of each iteration. Returns
    *   true to stop solving. Defaults to never stop.
    * @param verbose Whether to log verbose messages. Defaults to false.
+   * @param model_cache_path Path of the file caching the model queried from
+   *   the domain: the model is loaded from it if it was saved for the same
+   *   states and actions, and otherwise queried from the domain then saved
+   *   to it. The file must be deleted when the dynamics of the domain change.
+   *   With a cache, states, actions and observations are identified by their
+   *   print() (see pomdp_model_cache::stable_id()). Defaults to "" (no
+   *   cache).
+   * @param nb_sampling_threads Number of threads sampling belief tree trials
+   *   concurrently with a parallel execution policy, 0 meaning the number of
+   *   hardware threads. Ignored (1 thread) with the sequential execution
+   *   policy. Defaults to 0.
    */
   SARSOPSolver(
       Domain &domain, double epsilon = 0.001, double discount = 0.95,
@@ -90,7 +130,8 @@ public:
       std::size_t pruning_interval = 10, std::size_t logging_interval = 50,
       const CallbackFunctor &callback = [](const SARSOPSolver &,
                                            Domain &) { return false; },
-      bool verbose = false);
+      bool verbose = false, const std::string &model_cache_path = "",
+      std::size_t nb_sampling_threads = 0);
 
   void clear();
 
@@ -120,27 +161,24 @@ public:
   const std::unordered_map<std::size_t, State> &get_index_to_state() const;
 
 private:
-  struct AlphaVector {
-    std::vector<double> values;
-    Action action;
-    std::size_t id;
+  typedef typename ExecutionPolicy::template atomic<double> atomic_double;
+  typedef typename ExecutionPolicy::template atomic<std::size_t> atomic_size_t;
+  typedef ConcurrentAlphaVectorStore::Snapshot AlphaVectors;
 
-    AlphaVector() : id(0) {}
-    AlphaVector(std::size_t num_states, const Action &a, std::size_t vid)
-        : values(num_states, 0.0), action(a), id(vid) {}
-  };
+  // Number of mutexes protecting the belief tree nodes
+  static constexpr std::size_t nb_node_mutexes = 256;
 
   struct BeliefTreeNode {
-    Belief belief;
-    double lower_bound;
-    double upper_bound;
-    std::size_t best_alpha_idx;
+    BeliefVector belief;
+    atomic_double lower_bound;
+    atomic_double upper_bound;
 
     struct ActionEdge {
       Action action;
       double q_lower;
       double q_upper;
       double expected_reward;
+      // Children and observation probabilities keyed by observation index
       std::unordered_map<std::size_t, std::shared_ptr<BeliefTreeNode>> children;
       std::unordered_map<std::size_t, double> obs_probs;
 
@@ -151,18 +189,22 @@ private:
     std::vector<ActionEdge> action_edges;
     BeliefTreeNode *parent;
     std::size_t depth;
+    // Creation rank of the node, which selects its mutex
+    std::size_t id;
+    // Number of trials currently going through the node
+    atomic_size_t nb_active_trials;
     bool pruned;
     bool expanded;
 
     BeliefTreeNode()
         : lower_bound(-std::numeric_limits<double>::infinity()),
           upper_bound(std::numeric_limits<double>::infinity()),
-          best_alpha_idx(0), parent(nullptr), depth(0), pruned(false),
-          expanded(false) {}
+          parent(nullptr), depth(0), id(0), nb_active_trials(0),
+          pruned(false), expanded(false) {}
   };
 
   struct UpperBoundPoint {
-    Belief belief;
+    BeliefVector belief;
     double value;
   };
 
@@ -181,6 +223,8 @@ private:
   std::size_t _logging_interval;
   CallbackFunctor _callback;
   bool _verbose;
+  std::string _model_cache_path;
+  std::size_t _nb_sampling_threads;
   ExecutionPolicy _execution_policy;
 
   // State enumeration
@@ -191,28 +235,40 @@ private:
   // Pre-cached model
   std::vector<std::vector<std::vector<std::pair<double, std::size_t>>>>
       _transitions;
-  std::vector<std::vector<std::unordered_map<std::size_t, double>>> _obs_prob;
-  std::unordered_map<std::size_t, Observation> _obs_objects;
   std::vector<std::vector<double>> _rewards;
   std::vector<Action> _actions;
   std::unordered_map<std::size_t, std::size_t> _action_hash_to_idx;
-  // All unique observation hashes reachable per action
+  // All unique observation identifiers (see observation_id()) reachable per
+  // action
   std::vector<std::vector<std::size_t>> _action_obs_hashes;
+  // T x O matrices of the actions and of their observations
+  ObservationTransitionTensors _tensors;
 
   // Alpha-vector set (lower bound)
-  std::vector<AlphaVector> _alpha_vectors;
-  std::size_t _next_alpha_id;
+  ConcurrentAlphaVectorStore _alpha_vectors;
 
-  // Upper bound
+  // Upper bound (interior points appended under _ub_points_mutex)
   std::vector<double> _mdp_values;
-  std::vector<UpperBoundPoint> _ub_points;
+  ConcurrentAppendBuffer<UpperBoundPoint> _ub_points;
+  typename ExecutionPolicy::Mutex _ub_points_mutex;
 
   // Belief tree
   std::unique_ptr<BeliefTreeNode> _root;
-  std::size_t _nb_beliefs;
+  atomic_size_t _nb_beliefs;
+  std::vector<typename ExecutionPolicy::Mutex> _node_mutexes;
+
+  // Trials
+  atomic_size_t _nb_iterations;
+  typename ExecutionPolicy::template atomic<bool> _stop_trials;
+
+  // Background pruning
+  std::mutex _pruning_mutex;
+  std::condition_variable _pruning_condition;
+  bool _pruning_requested;
+  bool _stop_pruning;
 
   // Belief tracking for observation-based interface
-  Belief _current_belief;
+  BeliefVector _current_belief;
   std::unique_ptr<Action> _last_action;
   bool _has_solution;
 
@@ -224,34 +280,56 @@ private:
 
   // Model pre-caching
   void pre_cache_model();
+  void query_model(pomdp_model_cache::Observations &observations);
+  // Identifier of an observation in the model: its stable_id() if the model
+  // is cached on disk, so that other processes can load the cache, and
+  // otherwise its hash
+  std::size_t observation_id(const Observation &o) const;
 
   // Bound initialization
   void initialize_lower_bound();
   void initialize_upper_bound();
 
   // Alpha-vector operations
-  double dot_product(const AlphaVector &alpha, const Belief &b) const;
-  double evaluate_lower(const Belief &b) const;
-  std::size_t best_alpha_index(const Belief &b) const;
+  double evaluate_lower(const BeliefVector &b) const;
+  std::size_t best_alpha_index(const AlphaVectors &alpha_vectors,
+                               const BeliefVector &b) const;
+  void best_alpha_dots(const AlphaVectors &alpha_vectors,
+                       const std::vector<const BeliefVector *> &beliefs,
+                       std::vector<double> &values,
+                       std::vector<std::size_t> &indices) const;
+
+  // Runs f(i) for i in [0, n) with the execution policy if a single thread
+  // samples the trials, and sequentially otherwise
+  template <typename Function>
+  void for_each_index(std::size_t n, const Function &f) const;
 
   // Upper bound
-  double evaluate_upper(const Belief &b) const;
-  double evaluate_upper_corner(const Belief &b) const;
+  double evaluate_upper(const BeliefVector &b) const;
+  double evaluate_upper_corner(const BeliefVector &b) const;
   void update_upper_bound(BeliefTreeNode *node);
 
-  // Belief operations
-  Belief compute_posterior(const Belief &b, std::size_t action_idx,
-                           std::size_t obs_hash) const;
+  // Belief operations (obs_idx is the index in the observations of the action)
+  BeliefVector compute_posterior(const BeliefVector &b, std::size_t action_idx,
+                                 std::size_t obs_idx) const;
+
+  // Converts a belief keyed by state hash, ignoring unknown states
+  BeliefVector to_belief_vector(const Belief &b) const;
 
   // Belief tree
   void initialize_belief_node(BeliefTreeNode *node);
   void expand_node(BeliefTreeNode *node);
 
   // SARSOP core
+  typename ExecutionPolicy::Mutex &node_mutex(const BeliefTreeNode *node);
   std::vector<BeliefTreeNode *> sample();
-  AlphaVector backup_belief(BeliefTreeNode *node);
+  void backup_belief(BeliefTreeNode *node);
   void backup(const std::vector<BeliefTreeNode *> &path);
+  void run_trials();
+  bool stop_trials();
   void prune();
+  void request_pruning();
+  void run_pruning();
 
   // Belief tracking
   void update_current_belief(const Observation &obs);
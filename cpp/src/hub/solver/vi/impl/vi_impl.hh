@@ -5,12 +5,14 @@
 #ifndef SKDECIDE_VI_IMPL_HH
 #define SKDECIDE_VI_IMPL_HH
 
-#include <queue>
 #include <cmath>
 #include <algorithm>
 #include <limits>
 #include <chrono>
+#include <queue>
+#include <unordered_map>
 
+#include "utils/batched_domain_calls.hh"
 #include "utils/string_converter.hh"
 #include "utils/logging.hh"
 
@@ -28,7 +30,9 @@ namespace skdecide {
 SK_VI_SOLVER_TEMPLATE_DECL
 SK_VI_SOLVER_CLASS::StateNode::StateNode(const State &s)
     : state(s), best_action(nullptr), best_value(0.0), terminal(false),
-      converged(false), updated_in_last_sweep(false) {}
+      converged(false), updated_in_last_sweep(false), next_value(0.0),
+      residual(0.0), priority(0.0), idx(IDX_UNDEF), low(IDX_UNDEF),
+      on_stack(false) {}
 
 SK_VI_SOLVER_TEMPLATE_DECL
 const typename SK_VI_SOLVER_CLASS::State &
@@ -48,11 +52,12 @@ SK_VI_SOLVER_TEMPLATE_DECL
 SK_VI_SOLVER_CLASS::VISolver(Domain &domain, const HeuristicFunctor &heuristic,
                              const TerminalValueFunctor &terminal_value,
                              double discount, double epsilon,
-                             std::size_t max_sweeps,
+                             std::size_t max_sweeps, VISweepMode sweep_mode,
                              const CallbackFunctor &callback, bool verbose)
     : _domain(domain), _heuristic(heuristic), _terminal_value(terminal_value),
       _discount(discount), _epsilon(epsilon), _max_sweeps(max_sweeps),
-      _callback(callback), _verbose(verbose), _nb_iterations(0) {
+      _sweep_mode(sweep_mode), _callback(callback), _verbose(verbose),
+      _nb_iterations(0), _nb_backups(0) {
   if (verbose) {
     Logger::check_level(logging::debug, "algorithm Value Iteration");
   }
@@ -62,7 +67,9 @@ SK_VI_SOLVER_TEMPLATE_DECL
 void SK_VI_SOLVER_CLASS::clear() {
   _graph.clear();
   _non_terminal_states.clear();
+  _sccs.clear();
   _nb_iterations = 0;
+  _nb_backups = 0;
 }
 
 // --- solve ---
@@ -81,46 +88,19 @@ void SK_VI_SOLVER_CLASS::solve(const State &s) {
                  StringConverter::from(_non_terminal_states.size()) +
                  " non-terminal)");
 
-    // Phase 2: iterate synchronous Bellman backups (reward maximization)
+    // Phase 2: iterate Bellman backups (reward maximization)
     _nb_iterations = 0;
-    bool converged = false;
-
-    while (!converged && !_callback(*this, _domain)) {
-      _nb_iterations++;
-      double max_residual = 0.0;
-
-      for (auto *sn : _non_terminal_states) {
-        sn->updated_in_last_sweep = false;
-      }
-
-      std::for_each(ExecutionPolicy::policy, _non_terminal_states.begin(),
-                    _non_terminal_states.end(),
-                    [this, &max_residual](StateNode *sn) {
-                      double residual = bellman_update(*sn);
-                      sn->converged = (residual < _epsilon);
-                      sn->updated_in_last_sweep = (residual >= _epsilon);
-                      _execution_policy.protect([&max_residual, &residual] {
-                        max_residual = std::max(max_residual, residual);
-                      });
-                    });
-
-      converged = (max_residual < _epsilon);
-
-      if (_discount >= 1.0 && _max_sweeps > 0 &&
-          _nb_iterations >= _max_sweeps) {
-        if (_verbose) {
-          Logger::debug("Value Iteration: reached max_sweeps limit (" +
-                        StringConverter::from(_max_sweeps) + ")");
-        }
-        break;
-      }
-
-      if (_verbose) {
-        Logger::debug(
-            "Value Iteration: iteration " +
-            StringConverter::from(_nb_iterations) +
-            ", max residual = " + StringConverter::from(max_residual));
-      }
+    _nb_backups = 0;
+
+    switch (_sweep_mode) {
+    case VISweepMode::Prioritized:
+      prioritized_sweeping();
+      break;
+    case VISweepMode::Topological:
+      topological_value_iteration();
+      break;
+    default:
+      value_iteration();
     }
 
     Logger::info(
@@ -142,7 +122,7 @@ void SK_VI_SOLVER_CLASS::enumerate_reachable_states(const State &s) {
   if (_verbose)
     Logger::debug("Enumerating reachable states from " + s.print());
 
-  std::queue<StateNode *> frontier;
+  std::vector<StateNode *> layer;
 
   auto si = _graph.emplace(s);
   StateNode &root = const_cast<StateNode &>(*(si.first));
@@ -152,105 +132,133 @@ void SK_VI_SOLVER_CLASS::enumerate_reachable_states(const State &s) {
       root.best_value = _terminal_value(s).reward();
     } else {
       root.best_value = _heuristic(_domain, s).reward();
-      frontier.push(&root);
+      layer.push_back(&root);
+      _non_terminal_states.push_back(&root);
     }
   } else if (root.actions.empty() && !root.terminal) {
-    frontier.push(&root);
+    layer.push_back(&root);
   }
 
-  while (!frontier.empty()) {
-    StateNode *current = frontier.front();
-    frontier.pop();
+  // the non-terminal states are appended in order of discovery
+  while (!layer.empty()) {
+    layer = expand_layer(layer);
+    _non_terminal_states.insert(_non_terminal_states.end(), layer.begin(),
+                                layer.end());
+  }
+}
 
-    if (current->terminal || !current->actions.empty()) {
-      continue;
-    }
+// --- expand_layer ---
+
+SK_VI_SOLVER_TEMPLATE_DECL
+std::vector<typename SK_VI_SOLVER_CLASS::StateNode *>
+SK_VI_SOLVER_CLASS::expand_layer(const std::vector<StateNode *> &layer) {
+  if (_verbose)
+    Logger::debug("Expanding BFS layer of " +
+                  StringConverter::from(layer.size()) + " states");
 
-    expand(*current);
+  std::vector<const State *> states(layer.size());
+  std::transform(layer.begin(), layer.end(), states.begin(),
+                 [](StateNode *sn) { return &(sn->state); });
 
-    for (const auto &an : current->actions) {
-      for (const auto &outcome : an->outcomes) {
-        StateNode *ns = std::get<2>(outcome);
-        if (ns->actions.empty() && !ns->terminal) {
-          frontier.push(ns);
+  for_each_applicable_actions<ExecutionPolicy>(
+      _domain, states, [this, &layer](const std::size_t &i, auto &actions) {
+        StateNode &s = *layer[i];
+        for (const auto &a : actions.get_elements()) {
+          if (_verbose)
+            Logger::debug("Current expanded action: " + a.print() +
+                          " in state " + s.state.print() +
+                          ExecutionPolicy::print_thread());
+          s.actions.push_back(std::make_unique<ActionNode>(a));
         }
-      }
-    }
-  }
+      });
 
-  // Build non-terminal state ordering for iteration
-  _non_terminal_states.clear();
-  for (auto &sn : _graph) {
-    StateNode &node = const_cast<StateNode &>(sn);
-    if (!node.terminal) {
-      _non_terminal_states.push_back(&node);
+  std::vector<const State *> tr_states;
+  std::vector<const Action *> tr_actions;
+  std::vector<ActionNode *> tr_nodes;
+  for (auto *sn : layer) {
+    for (const auto &an : sn->actions) {
+      tr_states.push_back(&(sn->state));
+      tr_actions.push_back(&(an->action));
+      tr_nodes.push_back(an.get());
     }
   }
-}
 
-// --- expand ---
-
-SK_VI_SOLVER_TEMPLATE_DECL
-void SK_VI_SOLVER_CLASS::expand(StateNode &s) {
-  if (_verbose)
-    Logger::debug("Expanding state " + s.state.print());
-
-  auto applicable_actions =
-      _domain.get_applicable_actions(s.state).get_elements();
-
-  std::for_each(
-      ExecutionPolicy::policy, applicable_actions.begin(),
-      applicable_actions.end(), [this, &s](auto a) {
-        if (_verbose)
-          Logger::debug("Current expanded action: " + a.print() +
-                        ExecutionPolicy::print_thread());
-        _execution_policy.protect(
-            [&s, &a] { s.actions.push_back(std::make_unique<ActionNode>(a)); });
-        ActionNode &an = *(s.actions.back());
-        auto next_states =
-            _domain.get_next_state_distribution(s.state, a).get_values();
-
-        for (auto ns : next_states) {
+  std::vector<StateNode *> new_nodes;
+  for_each_next_state_distribution<ExecutionPolicy>(
+      _domain, tr_states, tr_actions,
+      [this, &tr_nodes, &new_nodes](const std::size_t &i, auto &distribution) {
+        ActionNode &an = *tr_nodes[i];
+        for (auto ns : distribution.get_values()) {
           if (_verbose)
             Logger::debug("Current next state expansion: " +
                           ns.state().print() + ExecutionPolicy::print_thread());
-          std::pair<typename Graph::iterator, bool> i;
+          std::pair<typename Graph::iterator, bool> si;
           _execution_policy.protect(
-              [this, &i, &ns] { i = _graph.emplace(ns.state()); });
-          StateNode &next_node = const_cast<StateNode &>(*(i.first));
-          an.outcomes.push_back(std::make_tuple(
-              ns.probability(),
-              _domain.get_transition_value(s.state, a, next_node.state)
-                  .reward(),
-              &next_node));
-
-          if (i.second) { // new node
-            if (_domain.is_terminal(next_node.state)) {
-              if (_verbose)
-                Logger::debug("Found terminal state " +
-                              next_node.state.print() +
-                              ExecutionPolicy::print_thread());
-              next_node.terminal = true;
-              next_node.best_value = _terminal_value(next_node.state).reward();
-            } else {
-              next_node.best_value =
-                  _heuristic(_domain, next_node.state).reward();
-              if (_verbose)
-                Logger::debug("New state " + next_node.state.print() +
-                              " with initial value " +
-                              StringConverter::from(next_node.best_value) +
-                              ExecutionPolicy::print_thread());
-            }
+              [this, &si, &ns] { si = _graph.emplace(ns.state()); });
+          StateNode &next_node = const_cast<StateNode &>(*(si.first));
+          an.outcomes.push_back(
+              std::make_tuple(ns.probability(), 0.0, &next_node));
+          if (si.second) { // new node
+            _execution_policy.protect(
+                [&new_nodes, &next_node] { new_nodes.push_back(&next_node); });
           }
         }
       });
+
+  std::vector<const State *> v_states;
+  std::vector<const Action *> v_actions;
+  std::vector<const State *> v_next_states;
+  std::vector<std::tuple<double, double, StateNode *> *> v_outcomes;
+  for (std::size_t i = 0; i < tr_nodes.size(); i++) {
+    for (auto &o : tr_nodes[i]->outcomes) {
+      v_states.push_back(tr_states[i]);
+      v_actions.push_back(tr_actions[i]);
+      v_next_states.push_back(&(std::get<2>(o)->state));
+      v_outcomes.push_back(&o);
+    }
+  }
+
+  for_each_transition_value<ExecutionPolicy>(
+      _domain, v_states, v_actions, v_next_states,
+      [&v_outcomes](const std::size_t &i, auto &value) {
+        std::get<1>(*v_outcomes[i]) = value.reward();
+      });
+
+  std::vector<const State *> new_states(new_nodes.size());
+  std::transform(new_nodes.begin(), new_nodes.end(), new_states.begin(),
+                 [](StateNode *sn) { return &(sn->state); });
+  std::vector<StateNode *> next_layer;
+
+  for_each_terminal<ExecutionPolicy>(
+      _domain, new_states,
+      [this, &new_nodes, &next_layer](const std::size_t &i, bool terminal) {
+        StateNode &next_node = *new_nodes[i];
+        if (terminal) {
+          if (_verbose)
+            Logger::debug("Found terminal state " + next_node.state.print() +
+                          ExecutionPolicy::print_thread());
+          next_node.terminal = true;
+          next_node.best_value = _terminal_value(next_node.state).reward();
+        } else {
+          next_node.best_value = _heuristic(_domain, next_node.state).reward();
+          if (_verbose)
+            Logger::debug("New state " + next_node.state.print() +
+                          " with initial value " +
+                          StringConverter::from(next_node.best_value) +
+                          ExecutionPolicy::print_thread());
+          _execution_policy.protect(
+              [&next_layer, &next_node] { next_layer.push_back(&next_node); });
+        }
+      });
+
+  return next_layer;
 }
 
-// --- bellman_update (reward maximization) ---
+// --- bellman_backup (reward maximization) ---
 
 SK_VI_SOLVER_TEMPLATE_DECL
-double SK_VI_SOLVER_CLASS::bellman_update(StateNode &s) {
-  double old_value = s.best_value;
+double SK_VI_SOLVER_CLASS::bellman_backup(StateNode &s) {
+  double discount = _discount;
   double best_value = -std::numeric_limits<double>::infinity();
   ActionNode *best_action = nullptr;
 
@@ -260,7 +268,7 @@ double SK_VI_SOLVER_CLASS::bellman_update(StateNode &s) {
       double prob = std::get<0>(outcome);
       double reward = std::get<1>(outcome);
       StateNode *next = std::get<2>(outcome);
-      q_value += prob * (reward + _discount * next->best_value);
+      q_value += prob * (reward + discount * next->best_value);
     }
     an->value = q_value;
 
@@ -270,10 +278,303 @@ double SK_VI_SOLVER_CLASS::bellman_update(StateNode &s) {
     }
   }
 
-  s.best_value = best_value;
+  s.next_value = best_value;
   s.best_action = best_action;
+  s.residual = std::abs(best_value - s.best_value);
+  return s.residual;
+}
+
+// --- sweep ---
+
+SK_VI_SOLVER_TEMPLATE_DECL
+double SK_VI_SOLVER_CLASS::sweep(const std::vector<StateNode *> &states,
+                                 bool jacobi) {
+  if (jacobi) {
+    std::for_each(ExecutionPolicy::policy, states.begin(), states.end(),
+                  [this](StateNode *sn) { bellman_backup(*sn); });
+  } else { // in place, in reverse order
+    std::for_each(ExecutionPolicy::policy, states.rbegin(), states.rend(),
+                  [this](StateNode *sn) {
+                    bellman_backup(*sn);
+                    sn->best_value = sn->next_value;
+                  });
+  }
+
+  _nb_backups += states.size();
+
+  // max-reduction of the residuals stored by the (parallel) backups
+  double max_residual = 0.0;
+  for (auto *sn : states) {
+    if (jacobi) {
+      sn->best_value = sn->next_value;
+    }
+    sn->converged = (sn->residual < _epsilon);
+    sn->updated_in_last_sweep = (sn->residual >= _epsilon);
+    max_residual = std::max(max_residual, sn->residual);
+  }
+  return max_residual;
+}
+
+// --- value_iteration (Jacobi or Gauss-Seidel sweeps) ---
+
+SK_VI_SOLVER_TEMPLATE_DECL
+void SK_VI_SOLVER_CLASS::value_iteration() {
+  bool converged = false;
+
+  while (!converged && !_callback(*this, _domain)) {
+    _nb_iterations++;
+    double max_residual =
+        sweep(_non_terminal_states, _sweep_mode == VISweepMode::Jacobi);
+    converged = (max_residual < _epsilon);
+
+    if (reached_max_sweeps(_nb_iterations)) {
+      if (_verbose) {
+        Logger::debug("Value Iteration: reached max_sweeps limit (" +
+                      StringConverter::from(_max_sweeps) + ")");
+      }
+      break;
+    }
+
+    if (_verbose) {
+      Logger::debug("Value Iteration: iteration " +
+                    StringConverter::from(_nb_iterations) +
+                    ", max residual = " + StringConverter::from(max_residual));
+    }
+  }
+}
+
+// --- prioritized_sweeping ---
+
+SK_VI_SOLVER_TEMPLATE_DECL
+void SK_VI_SOLVER_CLASS::prioritized_sweeping() {
+  compute_predecessors();
+  double discount = _discount;
+
+  // max-heap of (residual bound, state) entries; an entry is stale if its
+  // bound differs from the state's current bound
+  typedef std::pair<double, StateNode *> Entry;
+  std::priority_queue<Entry> heap;
+
+  // every state is backed up at least once
+  for (auto *sn : _non_terminal_states) {
+    sn->priority = std::numeric_limits<double>::infinity();
+    sn->converged = false;
+    sn->updated_in_last_sweep = false;
+    heap.emplace(sn->priority, sn);
+  }
+
+  while (!heap.empty()) {
+    Entry e = heap.top();
+    heap.pop();
+    StateNode *sn = e.second;
+    if (e.first != sn->priority) {
+      continue; // stale entry
+    }
 
-  return std::abs(best_value - old_value);
+    sn->priority = 0.0;
+    double delta = bellman_backup(*sn);
+    sn->best_value = sn->next_value;
+    sn->updated_in_last_sweep = (delta >= _epsilon);
+    _nb_backups++;
+
+    if (delta > 0.0) {
+      for (const auto &p : sn->predecessors) {
+        p.first->priority += discount * p.second * delta;
+        if (p.first->priority >= _epsilon) {
+          heap.emplace(p.first->priority, p.first);
+        }
+      }
+    }
+
+    if (end_of_sweep_equivalent() || reached_max_sweeps(_nb_iterations)) {
+      break;
+    }
+  }
+
+  for (auto *sn : _non_terminal_states) {
+    sn->converged = (sn->priority < _epsilon);
+  }
+  _nb_iterations = (_non_terminal_states.empty())
+                       ? 0
+                       : ((_nb_backups + _non_terminal_states.size() - 1) /
+                          _non_terminal_states.size());
+}
+
+// --- topological_value_iteration ---
+
+SK_VI_SOLVER_TEMPLATE_DECL
+void SK_VI_SOLVER_CLASS::topological_value_iteration() {
+  compute_sccs();
+  if (_verbose)
+    Logger::debug("Value Iteration: computed " +
+                  StringConverter::from(_sccs.size()) +
+                  " strongly connected components");
+
+  for (auto *sn : _non_terminal_states) {
+    sn->converged = false;
+    sn->updated_in_last_sweep = false;
+  }
+
+  bool stopped = false;
+  for (const auto &scc : _sccs) {
+    // a single state without self-loop converges with a single backup
+    bool acyclic = (scc.size() == 1);
+    if (acyclic) {
+      for (const auto &an : scc.front()->actions) {
+        for (const auto &outcome : an->outcomes) {
+          acyclic = acyclic && (std::get<2>(outcome) != scc.front());
+        }
+      }
+    }
+
+    std::size_t nb_sweeps = 0;
+    double max_residual = std::numeric_limits<double>::infinity();
+    while (max_residual >= _epsilon) {
+      max_residual = sweep(scc, false);
+      nb_sweeps++;
+      if (acyclic) {
+        scc.front()->converged = true;
+      }
+      if (end_of_sweep_equivalent()) {
+        stopped = true;
+        break;
+      }
+      if (acyclic || reached_max_sweeps(nb_sweeps)) {
+        break;
+      }
+    }
+    if (stopped) {
+      break;
+    }
+  }
+
+  _nb_iterations = (_non_terminal_states.empty())
+                       ? 0
+                       : ((_nb_backups + _non_terminal_states.size() - 1) /
+                          _non_terminal_states.size());
+}
+
+// --- compute_predecessors ---
+
+SK_VI_SOLVER_TEMPLATE_DECL
+void SK_VI_SOLVER_CLASS::compute_predecessors() {
+  for (auto *sn : _non_terminal_states) {
+    sn->predecessors.clear();
+  }
+  std::unordered_map<StateNode *, double> max_probabilities;
+  for (auto *sn : _non_terminal_states) {
+    max_probabilities.clear();
+    for (const auto &an : sn->actions) {
+      for (const auto &outcome : an->outcomes) {
+        StateNode *next = std::get<2>(outcome);
+        if (!next->terminal) {
+          double &p = max_probabilities[next];
+          p = std::max(p, std::get<0>(outcome));
+        }
+      }
+    }
+    for (const auto &mp : max_probabilities) {
+      mp.first->predecessors.emplace_back(sn, mp.second);
+    }
+  }
+}
+
+// --- compute_sccs (iterative Tarjan) ---
+
+SK_VI_SOLVER_TEMPLATE_DECL
+void SK_VI_SOLVER_CLASS::compute_sccs() {
+  _sccs.clear();
+  for (auto *sn : _non_terminal_states) {
+    sn->idx = IDX_UNDEF;
+    sn->low = IDX_UNDEF;
+    sn->on_stack = false;
+  }
+
+  struct Frame {
+    StateNode *node;
+    std::vector<StateNode *> successors;
+    std::size_t next;
+  };
+
+  std::size_t index = 0;
+  std::vector<StateNode *> tarjan_stack;
+  std::vector<Frame> frames;
+
+  auto visit = [&index, &tarjan_stack, &frames](StateNode *sn) {
+    sn->idx = index;
+    sn->low = index;
+    index++;
+    tarjan_stack.push_back(sn);
+    sn->on_stack = true;
+    frames.push_back(Frame{sn, {}, 0});
+    for (const auto &an : sn->actions) {
+      for (const auto &outcome : an->outcomes) {
+        if (!std::get<2>(outcome)->terminal) {
+          frames.back().successors.push_back(std::get<2>(outcome));
+        }
+      }
+    }
+  };
+
+  for (auto *root : _non_terminal_states) {
+    if (root->idx != IDX_UNDEF) {
+      continue;
+    }
+    visit(root);
+    while (!frames.empty()) {
+      Frame &f = frames.back();
+      StateNode *sn = f.node;
+      if (f.next < f.successors.size()) {
+        StateNode *next = f.successors[f.next++];
+        if (next->idx == IDX_UNDEF) {
+          visit(next); // invalidates f
+        } else if (next->on_stack) {
+          sn->low = std::min(sn->low, next->idx);
+        }
+      } else {
+        if (sn->low == sn->idx) { // sn is the root of an SCC
+          _sccs.emplace_back();
+          StateNode *member = nullptr;
+          do {
+            member = tarjan_stack.back();
+            tarjan_stack.pop_back();
+            member->on_stack = false;
+            _sccs.back().push_back(member);
+          } while (member != sn);
+        }
+        frames.pop_back();
+        if (!frames.empty()) {
+          StateNode *parent = frames.back().node;
+          parent->low = std::min(parent->low, sn->low);
+        }
+      }
+    }
+  }
+}
+
+// --- end_of_sweep_equivalent ---
+
+SK_VI_SOLVER_TEMPLATE_DECL
+bool SK_VI_SOLVER_CLASS::end_of_sweep_equivalent() {
+  if (_nb_backups < (_nb_iterations + 1) * _non_terminal_states.size()) {
+    return false;
+  }
+  _nb_iterations = _nb_backups / _non_terminal_states.size();
+  if (_verbose) {
+    Logger::debug("Value Iteration: iteration " +
+                  StringConverter::from(_nb_iterations) + " (" +
+                  StringConverter::from(_nb_backups) + " backups)");
+  }
+  bool stop = _callback(*this, _domain);
+  for (auto *sn : _non_terminal_states) {
+    sn->updated_in_last_sweep = false;
+  }
+  return stop;
+}
+
+SK_VI_SOLVER_TEMPLATE_DECL
+bool SK_VI_SOLVER_CLASS::reached_max_sweeps(std::size_t nb_sweeps) const {
+  return _discount >= 1.0 && _max_sweeps > 0 && nb_sweeps >= _max_sweeps;
 }
 
 // --- Accessors ---
@@ -395,6 +696,8 @@ std::unique_ptr<SK_VI_SOLVER_CLASS> SK_VI_SOLVER_CLASS::create_from_params(
       params.template get<double>("discount", 1.0),
       params.template get<double>("epsilon", 0.001),
       params.template get<std::size_t>("max_sweeps", 0),
+      vi_sweep_mode_from_string(params.template get<std::string>(
+          "sweep_mode", std::string("jacobi"))),
       CallbackFunctor([](const VISolver &, Domain &) { return false; }),
       params.template get<bool>("verbose", verbose));
 }
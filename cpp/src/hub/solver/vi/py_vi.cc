@@ -15,13 +15,14 @@ void init_pyvi(py::module &m) {
                     const std::function<py::object(const py::object &,
                                                    const py::object &)> &,
                     const std::function<py::object(const py::object &)> &,
-                    double, double, std::size_t, bool,
+                    double, double, std::size_t, const std::string &,
+                    bool,
                     const std::function<py::bool_(const py::object &)> &,
                     bool>(),
            py::arg("solver"), py::arg("domain"), py::arg("heuristic"),
            py::arg("terminal_value") = nullptr, py::arg("discount") = 0.999,
            py::arg("epsilon") = 0.001, py::arg("max_sweeps") = 0,
-           py::arg("parallel") = false, py::arg("callback") = nullptr,
+           py::arg("sweep_mode") = "jacobi", py::arg("parallel") = false, py::arg("callback") = nullptr,
            py::arg("verbose") = false)
       .def("close", &skdecide::PyVISolver::close)
       .def("clear", &skdecide::PyVISolver::clear)
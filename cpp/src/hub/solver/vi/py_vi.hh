@@ -53,6 +53,7 @@ private:
         const std::function<py::object(const py::object &)> &terminal_value,
         double discount = 0.999, double epsilon = 0.001,
         std::size_t max_sweeps = 0,
+        const std::string &sweep_mode_str = "jacobi",
         const std::function<py::bool_(const py::object &)> &callback = nullptr,
         bool verbose = false)
         : _heuristic(heuristic), _terminal_value(terminal_value),
@@ -101,6 +102,7 @@ private:
             }
           },
           discount, epsilon, max_sweeps,
+          vi_sweep_mode_from_string(sweep_mode_str),
           [this](
               const skdecide::VISolver<PyVIDomain<Texecution>, Texecution> &s,
               PyVIDomain<Texecution> &d) -> bool {
@@ -281,14 +283,15 @@ public:
       const std::function<py::object(const py::object &)> &terminal_value =
           nullptr,
       double discount = 0.999, double epsilon = 0.001,
-      std::size_t max_sweeps = 0, bool parallel = false,
+      std::size_t max_sweeps = 0, const std::string &sweep_mode = "jacobi",
+      bool parallel = false,
       const std::function<py::bool_(const py::object &)> &callback = nullptr,
       bool verbose = false) {
 
     TemplateInstantiator::select(ExecutionSelector(parallel),
                                  SolverInstantiator(_implementation))
         .instantiate(solver, domain, heuristic, terminal_value, discount,
-                     epsilon, max_sweeps, callback, verbose);
+                     epsilon, max_sweeps, sweep_mode, callback, verbose);
   }
 
   void close() { _implementation->close(); }
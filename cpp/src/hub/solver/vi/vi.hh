@@ -7,7 +7,10 @@
 #define SKDECIDE_VI_HH
 
 #include <functional>
+#include <limits>
 #include <memory>
+#include <stdexcept>
+#include <string>
 #include <unordered_set>
 #include <vector>
 #include <list>
@@ -20,6 +23,22 @@
 
 namespace skdecide {
 
+enum class VISweepMode { Jacobi, GaussSeidel, Prioritized, Topological };
+
+inline VISweepMode vi_sweep_mode_from_string(const std::string &s) {
+  if (s == "jacobi")
+    return VISweepMode::Jacobi;
+  if (s == "gauss_seidel")
+    return VISweepMode::GaussSeidel;
+  if (s == "prioritized")
+    return VISweepMode::Prioritized;
+  if (s == "topological")
+    return VISweepMode::Topological;
+  throw std::invalid_argument("Unknown VI sweep mode: '" + s +
+                              "'. Use 'jacobi', 'gauss_seidel', "
+                              "'prioritized' or 'topological'.");
+}
+
 /**
  * @brief Value Iteration solver for Markov Decision Processes.
  *
@@ -28,17 +47,40 @@ namespace skdecide {
  * 1. **State enumeration**: BFS from the initial state, expanding all
  *    reachable states via get_applicable_actions() and
  *    get_next_state_distribution(). All transition probabilities and costs
- *    are cached in a graph. States where is_terminal() returns true are
+ *    are cached in a graph. Each BFS layer is expanded with one batch of
+ *    domain calls per kind of query, which the domain can answer at once if
+ *    it provides batched methods (see utils/batched_domain_calls.hh), e.g.
+ *    Python domains implementing get_next_state_distribution_batch().
+ *    States where is_terminal() returns true are
  *    treated as absorbing states whose value is set by the terminal_value
  *    functor (defaults to reward=0, which models goal-like terminals; a
  *    large negative reward can be returned for dead-end-like terminals).
  *
- * 2. **Synchronous Bellman sweeps**: Iterates over all non-terminal states,
- *    applying the Bellman backup V(s) = max_a [R(s,a) + gamma * sum_s'
- *    P(s'|s,a) * V(s')] until the maximum residual across all states drops
- *    below epsilon. With ParallelExecution, Bellman updates are applied to
- *    all states simultaneously within each sweep (Jacobi-style), which
- *    preserves convergence guarantees.
+ * 2. **Bellman sweeps**: Applies the Bellman backup V(s) = max_a [R(s,a) +
+ *    gamma * sum_s' P(s'|s,a) * V(s')] to the non-terminal states until the
+ *    maximum residual across all states drops below epsilon, in one of the
+ *    following modes (VISweepMode):
+ *    - Jacobi (default): synchronous sweeps over all states, the backups of
+ *      a sweep reading the values of the previous sweep; with
+ *      ParallelExecution, the backups of a sweep run in parallel.
+ *    - GaussSeidel: in-place sweeps over all states in reverse order of
+ *      discovery (farthest states first), each backup reading the values
+ *      already updated in the sweep; with ParallelExecution, the in-place
+ *      backups run in parallel (asynchronous value iteration).
+ *    - Prioritized: prioritized sweeping, repeatedly backing up the state
+ *      with the largest bound on its Bellman residual taken from a heap; the
+ *      bound of a state grows by gamma * P(s'|s,a) * |dV(s')| when a
+ *      successor s' changes and is reset when the state is backed up, and
+ *      the solver stops when all bounds are below epsilon. The backups are
+ *      sequential whatever the execution policy.
+ *    - Topological: topological value iteration, computing the strongly
+ *      connected components of the enumerated graph (Tarjan) and running
+ *      in-place sweeps on each component until convergence, in reverse
+ *      topological order so that the successors of a component have
+ *      converged before it is swept; with ParallelExecution, the backups of
+ *      a component's sweep run in parallel.
+ *    The residuals of the parallel backups are stored in the states and
+ *    reduced once the backups completed, rather than under a lock.
  *
  * **Heuristic initialization (non-standard extension)**: Classical Value
  * Iteration initializes V(s) = 0 for all states. This implementation
@@ -51,9 +93,9 @@ namespace skdecide {
  *
  * @tparam Tdomain Type of the domain class
  * @tparam Texecution_policy Type of the execution policy (SequentialExecution
- * for sequential Bellman sweeps, or ParallelExecution for Jacobi-style
- * parallel updates within each sweep and parallel action-transition
- * generation during state enumeration)
+ * for sequential Bellman sweeps, or ParallelExecution for parallel updates
+ * within each sweep and parallel action-transition generation during state
+ * enumeration)
  */
 template <typename Tdomain, typename Texecution_policy = SequentialExecution>
 class VISolver {
@@ -83,7 +125,11 @@ public:
    * @param discount Discount factor gamma in [0, 1]. Defaults to 0.999.
    * @param epsilon Maximum Bellman residual for convergence. Defaults to 0.001.
    * @param max_sweeps Maximum number of Bellman sweeps. 0 means unlimited.
-   *   Useful when discount=1.0 to prevent divergence. Defaults to 0.
+   *   Useful when discount=1.0 to prevent divergence. In topological mode,
+   *   it bounds the number of sweeps of each strongly connected component.
+   *   Defaults to 0.
+   * @param sweep_mode Order of the Bellman backups (see VISweepMode).
+   *   Defaults to VISweepMode::Jacobi.
    * @param callback Functor called at the end of each Bellman sweep; return
    *   true to stop early. Defaults to never stop.
    * @param verbose Whether to log progress messages. Defaults to false.
@@ -94,6 +140,7 @@ public:
           [](const State &) { return Value(0.0, true); },
       double discount = 0.999, double epsilon = 0.001,
       std::size_t max_sweeps = 0,
+      VISweepMode sweep_mode = VISweepMode::Jacobi,
       const CallbackFunctor &callback = [](const VISolver &,
                                            Domain &) { return false; },
       bool verbose = false);
@@ -126,12 +173,16 @@ private:
   typedef typename ExecutionPolicy::template atomic<double> atomic_double;
   typedef typename ExecutionPolicy::template atomic<bool> atomic_bool;
 
+  static constexpr std::size_t IDX_UNDEF =
+      std::numeric_limits<std::size_t>::max();
+
   Domain &_domain;
   HeuristicFunctor _heuristic;
   TerminalValueFunctor _terminal_value;
   atomic_double _discount;
   atomic_double _epsilon;
   std::size_t _max_sweeps;
+  VISweepMode _sweep_mode;
   CallbackFunctor _callback;
   bool _verbose;
   ExecutionPolicy _execution_policy;
@@ -146,6 +197,15 @@ private:
     bool terminal;
     bool converged;
     bool updated_in_last_sweep;
+    double next_value; // value computed by the last backup
+    double residual;   // residual of the last backup
+    double priority;   // bound on the residual (prioritized sweeping)
+    // non-terminal predecessors with the largest probability of reaching
+    // this state from them (prioritized sweeping)
+    std::vector<std::pair<StateNode *, double>> predecessors;
+    std::size_t idx; // Tarjan index (topological value iteration)
+    std::size_t low;
+    bool on_stack;
 
     StateNode(const State &s);
 
@@ -165,13 +225,33 @@ private:
 
   typedef typename SetTypeDeducer<StateNode, State>::Set Graph;
   Graph _graph;
-  std::vector<StateNode *> _non_terminal_states;
+  std::vector<StateNode *> _non_terminal_states; // in order of discovery
+  std::vector<std::vector<StateNode *>>
+      _sccs; // in reverse topological order
   std::size_t _nb_iterations;
+  std::size_t _nb_backups;
   std::chrono::time_point<std::chrono::high_resolution_clock> _start_time;
 
   void enumerate_reachable_states(const State &s);
-  void expand(StateNode &s);
-  double bellman_update(StateNode &s);
+  // Expands all the states of a BFS layer with one batch of domain calls per
+  // kind of query, and returns the newly discovered non-terminal states
+  std::vector<StateNode *> expand_layer(const std::vector<StateNode *> &layer);
+  // Computes the Bellman backup of a state (best action, next value and
+  // residual) without updating its value, and returns the residual
+  double bellman_backup(StateNode &s);
+  // Runs one sweep over the given states, in place unless jacobi is true,
+  // and returns the maximum residual
+  double sweep(const std::vector<StateNode *> &states, bool jacobi);
+  void value_iteration();
+  void prioritized_sweeping();
+  void topological_value_iteration();
+  void compute_predecessors();
+  void compute_sccs();
+  // Calls the callback each time the number of backups reaches a multiple of
+  // the number of non-terminal states (counted as a sweep), and returns true
+  // if the solver must stop
+  bool end_of_sweep_equivalent();
+  bool reached_max_sweeps(std::size_t nb_sweeps) const;
 };
 
 } // namespace skdecide
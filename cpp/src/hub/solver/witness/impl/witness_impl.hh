@@ -17,6 +17,7 @@
 #include <unordered_set>
 
 #include "Highs.h"
+#include "utils/belief_vector.hh"
 #include "utils/logging.hh"
 #include "utils/string_converter.hh"
 
@@ -47,13 +48,11 @@ void SK_WITNESS_CLASS::clear() {
   _state_hash_to_idx.clear();
   _index_to_state.clear();
   _transitions.clear();
-  _obs_prob.clear();
-  _obs_objects.clear();
   _rewards.clear();
   _actions.clear();
   _action_hash_to_idx.clear();
   _action_obs_hashes.clear();
-  _obs_hash_to_pos.clear();
+  _tensors.clear();
   _alpha_vectors.clear();
   _current_belief.clear();
   _last_action.reset();
@@ -153,15 +152,18 @@ void SK_WITNESS_CLASS::pre_cache_model() {
   std::size_t na = _actions.size();
 
   _transitions.resize(ns);
-  _obs_prob.resize(ns);
   _rewards.resize(ns, std::vector<double>(na, 0.0));
   _action_obs_hashes.resize(na);
 
+  // Observation distributions of the reachable (s', a), queried once each
+  std::vector<std::vector<std::unordered_map<std::size_t, double>>>
+      observations(ns,
+                   std::vector<std::unordered_map<std::size_t, double>>(na));
+  std::vector<std::vector<bool>> reachable(ns, std::vector<bool>(na, false));
   std::vector<std::unordered_set<std::size_t>> action_obs_sets(na);
 
   for (std::size_t i = 0; i < ns; ++i) {
     _transitions[i].resize(na);
-    _obs_prob[i].resize(na);
   }
 
   for (std::size_t si = 0; si < ns; ++si) {
@@ -189,16 +191,17 @@ void SK_WITNESS_CLASS::pre_cache_model() {
                 .reward();
         weighted_reward += prob * r;
 
+        if (reachable[ns_idx][ai])
+          continue;
+        reachable[ns_idx][ai] = true;
+
         auto obs_dist =
             _domain.get_observation_distribution(_states[ns_idx], _actions[ai])
                 .get_values();
 
         for (auto od : obs_dist) {
           std::size_t oh = typename Observation::Hash()(od.observation());
-          _obs_prob[ns_idx][ai][oh] = od.probability();
-          if (_obs_objects.find(oh) == _obs_objects.end()) {
-            _obs_objects[oh] = od.observation();
-          }
+          observations[ns_idx][ai][oh] = od.probability();
           action_obs_sets[ai].insert(oh);
         }
       }
@@ -212,12 +215,8 @@ void SK_WITNESS_CLASS::pre_cache_model() {
                                   action_obs_sets[ai].end());
   }
 
-  _obs_hash_to_pos.resize(na);
-  for (std::size_t ai = 0; ai < na; ++ai) {
-    for (std::size_t p = 0; p < _action_obs_hashes[ai].size(); ++p) {
-      _obs_hash_to_pos[ai][_action_obs_hashes[ai][p]] = p;
-    }
-  }
+  _tensors.template build<ExecutionPolicy>(_transitions, observations,
+                                           _action_obs_hashes);
 
   if (_verbose)
     Logger::debug("Witness: model pre-cached");
@@ -241,11 +240,7 @@ double SK_WITNESS_CLASS::dot_product(const AlphaVector &alpha,
 SK_WITNESS_TEMPLATE_DECL
 double SK_WITNESS_CLASS::dot_product_dense(const std::vector<double> &alpha,
                                            const std::vector<double> &b) const {
-  double result = 0.0;
-  for (std::size_t i = 0; i < alpha.size(); ++i) {
-    result += alpha[i] * b[i];
-  }
-  return result;
+  return belief_kernels::dense_dot(alpha.data(), b.data(), alpha.size());
 }
 
 SK_WITNESS_TEMPLATE_DECL
@@ -281,19 +276,12 @@ SK_WITNESS_TEMPLATE_DECL
 std::vector<double>
 SK_WITNESS_CLASS::compute_back(const std::vector<double> &alpha_values,
                                std::size_t action_idx,
-                               std::size_t obs_hash) const {
+                               std::size_t obs_idx) const {
   std::size_t ns = _states.size();
   std::vector<double> result(ns, 0.0);
   for (std::size_t si = 0; si < ns; ++si) {
-    double val = 0.0;
-    for (const auto &tr : _transitions[si][action_idx]) {
-      auto obs_it = _obs_prob[tr.second][action_idx].find(obs_hash);
-      double z = (obs_it != _obs_prob[tr.second][action_idx].end())
-                     ? obs_it->second
-                     : 0.0;
-      val += alpha_values[tr.second] * tr.first * z;
-    }
-    result[si] = val;
+    result[si] =
+        _tensors.back_project(action_idx, obs_idx, si, alpha_values.data());
   }
   return result;
 }
@@ -310,8 +298,7 @@ SK_WITNESS_CLASS::precompute_back_vectors(
 
   for (std::size_t ai = 0; ai < num_alphas; ++ai) {
     for (std::size_t op = 0; op < num_obs; ++op) {
-      back_vecs[ai][op] = compute_back(v_prev[ai].values, action_idx,
-                                       _action_obs_hashes[action_idx][op]);
+      back_vecs[ai][op] = compute_back(v_prev[ai].values, action_idx, op);
     }
   }
   return back_vecs;
@@ -646,35 +633,27 @@ SK_WITNESS_TEMPLATE_DECL
 typename SK_WITNESS_CLASS::Belief
 SK_WITNESS_CLASS::compute_posterior(const Belief &b, std::size_t action_idx,
                                     std::size_t obs_hash) const {
-  // Prediction: b_a(s') = sum_s T(s'|s,a) * b(s)
-  Belief b_a;
-  for (const auto &p : b) {
-    auto idx_it = _state_hash_to_idx.find(p.first);
-    if (idx_it == _state_hash_to_idx.end())
-      continue;
-    std::size_t si = idx_it->second;
-    for (const auto &tr : _transitions[si][action_idx]) {
-      std::size_t ns_hash = typename State::Hash()(_states[tr.second]);
-      b_a[ns_hash] += p.second * tr.first;
-    }
-  }
-
-  // Posterior: b^o_a(s') = Z(o|s',a) * b_a(s') / P(o|b,a)
   Belief posterior;
+  std::size_t obs_idx = _tensors.observation_index(action_idx, obs_hash);
+  if (obs_idx == _tensors.nb_observations(action_idx))
+    return posterior;
+
+  // b^o_a(s') = sum_s b(s) T(s'|s,a) Z(o|s',a) / P(o|b,a)
   double normalizer = 0.0;
-  for (const auto &p : b_a) {
+  for (const auto &p : b) {
     auto idx_it = _state_hash_to_idx.find(p.first);
     if (idx_it == _state_hash_to_idx.end())
       continue;
-    std::size_t sp_idx = idx_it->second;
-    auto obs_it = _obs_prob[sp_idx][action_idx].find(obs_hash);
-    double z =
-        (obs_it != _obs_prob[sp_idx][action_idx].end()) ? obs_it->second : 0.0;
-    double val = z * p.second;
-    if (val > 0.0) {
-      posterior[p.first] = val;
-      normalizer += val;
-    }
+    _tensors.for_each(
+        action_idx, obs_idx, idx_it->second,
+        [this, &p, &posterior, &normalizer](std::size_t sp_idx, double prob) {
+          double val = p.second * prob;
+          if (val > 0.0) {
+            std::size_t ns_hash = typename State::Hash()(_states[sp_idx]);
+            posterior[ns_hash] += val;
+            normalizer += val;
+          }
+        });
   }
 
   if (normalizer > 0.0) {
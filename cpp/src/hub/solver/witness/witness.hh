@@ -16,6 +16,7 @@
 
 #include "utils/execution.hh"
 #include "utils/logging.hh"
+#include "utils/observation_transition_tensors.hh"
 
 namespace skdecide {
 
@@ -141,13 +142,11 @@ private:
 
   std::vector<std::vector<std::vector<std::pair<double, std::size_t>>>>
       _transitions;
-  std::vector<std::vector<std::unordered_map<std::size_t, double>>> _obs_prob;
-  std::unordered_map<std::size_t, Observation> _obs_objects;
   std::vector<std::vector<double>> _rewards;
   std::vector<Action> _actions;
   std::unordered_map<std::size_t, std::size_t> _action_hash_to_idx;
   std::vector<std::vector<std::size_t>> _action_obs_hashes;
-  std::vector<std::unordered_map<std::size_t, std::size_t>> _obs_hash_to_pos;
+  ObservationTransitionTensors _tensors;
 
   std::vector<AlphaVector> _alpha_vectors;
 
@@ -171,7 +170,7 @@ private:
 
   std::vector<double> compute_back(const std::vector<double> &alpha_values,
                                    std::size_t action_idx,
-                                   std::size_t obs_hash) const;
+                                   std::size_t obs_idx) const;
 
   std::vector<std::vector<std::vector<double>>>
   precompute_back_vectors(const std::vector<AlphaVector> &v_prev,
@@ -0,0 +1,191 @@
+/* Copyright (c) AIRBUS and its affiliates.
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#ifndef SKDECIDE_ALPHA_VECTOR_MATRIX_HH
+#define SKDECIDE_ALPHA_VECTOR_MATRIX_HH
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+#include "utils/belief_vector.hh"
+#include "utils/execution.hh"
+
+namespace skdecide {
+
+/**
+ * @brief Set of alpha-vectors stored as a single row-major matrix (one row of
+ * nb_states values per alpha-vector) with a parallel array of action indices.
+ * Rows are padded to whole cache lines and the matrix is cache line aligned,
+ * so that every row starts on an aligned address. Appending a row is O(1)
+ * amortized. Removed rows (e.g. pruned alpha-vectors) are skipped by the
+ * evaluations and only dropped once they make up max_removed_ratio of the
+ * rows (see compact_if_needed()), so that row indices change at most once
+ * every few pruning passes.
+ */
+class AlphaVectorMatrix {
+public:
+  static constexpr double max_removed_ratio = 0.5;
+  // Approximate size in bytes of the tiles of rows multiplied with a block of
+  // beliefs, chosen to stay in the L2 cache
+  static constexpr std::size_t tile_bytes = 128 * 1024;
+  static constexpr std::size_t belief_block_size = 8;
+
+  explicit AlphaVectorMatrix(std::size_t nb_states = 0) { reset(nb_states); }
+
+  void reset(std::size_t nb_states) {
+    _nb_states = nb_states;
+    _stride = (nb_states + row_alignment - 1) / row_alignment * row_alignment;
+    clear();
+  }
+
+  void clear() {
+    _values.clear();
+    _actions.clear();
+    _removed.clear();
+    _nb_removed = 0;
+  }
+
+  std::size_t nb_states() const { return _nb_states; }
+  // Number of rows including the removed ones not yet compacted
+  std::size_t nb_rows() const { return _actions.size(); }
+  // Number of alpha-vectors
+  std::size_t size() const { return _actions.size() - _nb_removed; }
+  bool empty() const { return size() == 0; }
+
+  const double *row(std::size_t i) const {
+    return _values.data() + i * _stride;
+  }
+  double *row(std::size_t i) { return _values.data() + i * _stride; }
+  std::size_t action(std::size_t i) const { return _actions[i]; }
+  bool removed(std::size_t i) const { return _removed[i]; }
+
+  // Appends a zero-filled row whose values can be written through the
+  // returned pointer until the next change of the matrix
+  double *append(std::size_t action_idx) {
+    _values.resize(_values.size() + _stride, 0.0);
+    _actions.push_back(action_idx);
+    _removed.push_back(false);
+    return row(_actions.size() - 1);
+  }
+
+  void append(const double *values, std::size_t action_idx) {
+    std::copy(values, values + _nb_states, append(action_idx));
+  }
+
+  // Marks row i as removed, which keeps the indices of the rows unchanged
+  void remove(std::size_t i) {
+    if (!_removed[i]) {
+      _removed[i] = true;
+      _nb_removed++;
+    }
+  }
+
+  // Compacts the matrix if the removed rows make up more than
+  // max_removed_ratio of the rows, returning whether it did
+  bool compact_if_needed() {
+    if (static_cast<double>(_nb_removed) >
+        max_removed_ratio * static_cast<double>(_actions.size())) {
+      compact();
+      return true;
+    }
+    return false;
+  }
+
+  // Physically drops the removed rows, keeping the order of the other ones
+  void compact() {
+    std::size_t last = 0;
+    for (std::size_t i = 0; i < _actions.size(); i++) {
+      if (!_removed[i]) {
+        if (last != i) {
+          std::copy(row(i), row(i) + _stride, row(last));
+          _actions[last] = _actions[i];
+        }
+        last++;
+      }
+    }
+    _values.resize(last * _stride);
+    _actions.resize(last);
+    _removed.assign(last, false);
+    _nb_removed = 0;
+  }
+
+  /** Index of the (non removed) row maximizing (according to is_better) its
+   * dot product with b, the first one in case of ties; best receives the dot
+   * product of the returned row (or init if there is no row) */
+  template <typename Tis_better>
+  std::size_t best_dot(const BeliefVector &b, const Tis_better &is_better,
+                       double init, double &best) const {
+    std::size_t best_idx = 0;
+    best = init;
+    for (std::size_t i = 0; i < _actions.size(); i++) {
+      if (!_removed[i]) {
+        double v = b.dot(row(i));
+        if (is_better(v, best)) {
+          best = v;
+          best_idx = i;
+        }
+      }
+    }
+    return best_idx;
+  }
+
+  /** Batched best_dot() of all the beliefs, which is a blocked product of the
+   * matrix with the beliefs: blocks of beliefs are processed in parallel
+   * according to the execution policy, each one being multiplied with a
+   * cache-sized tile of rows at a time so that the rows are read from memory
+   * once per block of beliefs rather than once per belief. The results are
+   * the ones of best_dot() whatever the execution policy. */
+  template <typename Texecution_policy, typename Tis_better>
+  void best_dots(const std::vector<const BeliefVector *> &beliefs,
+                 const Tis_better &is_better, double init,
+                 std::vector<double> &best,
+                 std::vector<std::size_t> &best_indices) const {
+    best.assign(beliefs.size(), init);
+    best_indices.assign(beliefs.size(), 0);
+    std::size_t tile_size = std::max<std::size_t>(
+        1, tile_bytes / (sizeof(double) * std::max(_stride, row_alignment)));
+    std::vector<std::size_t> blocks(
+        (beliefs.size() + belief_block_size - 1) / belief_block_size);
+    std::iota(blocks.begin(), blocks.end(), 0);
+    std::for_each(
+        Texecution_policy::policy, blocks.begin(), blocks.end(),
+        [this, &beliefs, &is_better, &best, &best_indices,
+         &tile_size](const std::size_t &block) {
+          std::size_t first = block * belief_block_size;
+          std::size_t last =
+              std::min(first + belief_block_size, beliefs.size());
+          for (std::size_t t = 0; t < _actions.size(); t += tile_size) {
+            std::size_t tile_end = std::min(t + tile_size, _actions.size());
+            for (std::size_t k = first; k < last; k++) {
+              for (std::size_t i = t; i < tile_end; i++) {
+                if (!_removed[i]) {
+                  double v = beliefs[k]->dot(row(i));
+                  if (is_better(v, best[k])) {
+                    best[k] = v;
+                    best_indices[k] = i;
+                  }
+                }
+              }
+            }
+          }
+        });
+  }
+
+private:
+  // Number of doubles per cache line
+  static constexpr std::size_t row_alignment = 64 / sizeof(double);
+
+  std::size_t _nb_states;
+  std::size_t _stride;
+  BeliefVector::Values _values;
+  std::vector<std::size_t> _actions;
+  std::vector<bool> _removed;
+  std::size_t _nb_removed;
+};
+
+} // namespace skdecide
+
+#endif // SKDECIDE_ALPHA_VECTOR_MATRIX_HH
@@ -10,6 +10,7 @@
 #include <set>
 #include <unordered_map>
 #include <map>
+#include <memory>
 
 namespace skdecide {
 
@@ -95,13 +96,15 @@ template <typename T> struct Less {
   }
 };
 
-template <typename Key, typename RealKey = Key> struct SetTypeDeducer {
+template <typename Key, typename RealKey = Key,
+          typename Alloc = std::allocator<Key>>
+struct SetTypeDeducer {
   typedef typename std::conditional<
       has_hash<RealKey>::value && has_equal<RealKey>::value,
-      std::unordered_set<Key, Hash<RealKey>, Equal<RealKey>>,
+      std::unordered_set<Key, Hash<RealKey>, Equal<RealKey>, Alloc>,
       typename std::conditional<has_less<RealKey>::value,
-                                std::set<Key, Less<RealKey>>, void>::type>::type
-      Set;
+                                std::set<Key, Less<RealKey>, Alloc>,
+                                void>::type>::type Set;
   static_assert(std::is_same<Key, RealKey>::value || has_key<Key>::value,
                 "Key must contain a 'struct Key {...}' accessing type if Key "
                 "is different from RealKey");
@@ -0,0 +1,170 @@
+/* Copyright (c) AIRBUS and its affiliates.
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#ifndef SKDECIDE_BATCHED_DOMAIN_CALLS_HH
+#define SKDECIDE_BATCHED_DOMAIN_CALLS_HH
+
+#include <algorithm>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "utils/execution.hh"
+
+namespace skdecide {
+
+/**
+ * Helpers issuing a whole set of domain queries at once, typically all the
+ * queries of a layer of a breadth-first state enumeration. When the domain
+ * provides the corresponding batched method (e.g. PythonDomainProxy, which
+ * then crosses the C++/Python boundary once per batch instead of once per
+ * query), the queries are sent in one call; otherwise the scalar method is
+ * called for each query in parallel according to the execution policy. In
+ * both cases, the function f(i, result) is then applied in parallel to the
+ * result of each query i.
+ */
+
+template <typename Tdomain, typename = void>
+struct has_applicable_actions_batch : std::false_type {};
+
+template <typename Tdomain>
+struct has_applicable_actions_batch<
+    Tdomain, std::void_t<decltype(std::declval<Tdomain &>()
+                                      .get_applicable_actions_batch(
+                                          std::declval<const std::vector<
+                                              const typename Tdomain::State *>
+                                                           &>()))>>
+    : std::true_type {};
+
+template <typename Tdomain, typename = void>
+struct has_next_state_distribution_batch : std::false_type {};
+
+template <typename Tdomain>
+struct has_next_state_distribution_batch<
+    Tdomain,
+    std::void_t<decltype(std::declval<Tdomain &>()
+                             .get_next_state_distribution_batch(
+                                 std::declval<const std::vector<
+                                     const typename Tdomain::State *> &>(),
+                                 std::declval<const std::vector<
+                                     const typename Tdomain::Action *> &>()))>>
+    : std::true_type {};
+
+template <typename Tdomain, typename = void>
+struct has_transition_value_batch : std::false_type {};
+
+template <typename Tdomain>
+struct has_transition_value_batch<
+    Tdomain,
+    std::void_t<decltype(std::declval<Tdomain &>().get_transition_value_batch(
+        std::declval<const std::vector<const typename Tdomain::State *> &>(),
+        std::declval<const std::vector<const typename Tdomain::Action *> &>(),
+        std::declval<
+            const std::vector<const typename Tdomain::State *> &>()))>>
+    : std::true_type {};
+
+template <typename Tdomain, typename = void>
+struct has_terminal_batch : std::false_type {};
+
+template <typename Tdomain>
+struct has_terminal_batch<
+    Tdomain,
+    std::void_t<decltype(std::declval<Tdomain &>().is_terminal_batch(
+        std::declval<
+            const std::vector<const typename Tdomain::State *> &>()))>>
+    : std::true_type {};
+
+template <typename Texecution_policy, typename Function>
+void for_each_index(std::size_t n, const Function &f) {
+  std::vector<std::size_t> indices(n);
+  std::iota(indices.begin(), indices.end(), 0);
+  std::for_each(Texecution_policy::policy, indices.begin(), indices.end(), f);
+}
+
+template <typename Texecution_policy, typename Tdomain, typename Function>
+void for_each_applicable_actions(
+    Tdomain &domain, const std::vector<const typename Tdomain::State *> &states,
+    const Function &f) {
+  if constexpr (has_applicable_actions_batch<Tdomain>::value) {
+    auto results = domain.get_applicable_actions_batch(states);
+    for_each_index<Texecution_policy>(
+        states.size(), [&results, &f](const std::size_t &i) {
+          f(i, results[i]);
+        });
+  } else {
+    for_each_index<Texecution_policy>(
+        states.size(), [&domain, &states, &f](const std::size_t &i) {
+          auto result = domain.get_applicable_actions(*states[i]);
+          f(i, result);
+        });
+  }
+}
+
+template <typename Texecution_policy, typename Tdomain, typename Function>
+void for_each_next_state_distribution(
+    Tdomain &domain, const std::vector<const typename Tdomain::State *> &states,
+    const std::vector<const typename Tdomain::Action *> &actions,
+    const Function &f) {
+  if constexpr (has_next_state_distribution_batch<Tdomain>::value) {
+    auto results = domain.get_next_state_distribution_batch(states, actions);
+    for_each_index<Texecution_policy>(
+        states.size(), [&results, &f](const std::size_t &i) {
+          f(i, results[i]);
+        });
+  } else {
+    for_each_index<Texecution_policy>(
+        states.size(), [&domain, &states, &actions, &f](const std::size_t &i) {
+          auto result =
+              domain.get_next_state_distribution(*states[i], *actions[i]);
+          f(i, result);
+        });
+  }
+}
+
+template <typename Texecution_policy, typename Tdomain, typename Function>
+void for_each_transition_value(
+    Tdomain &domain, const std::vector<const typename Tdomain::State *> &states,
+    const std::vector<const typename Tdomain::Action *> &actions,
+    const std::vector<const typename Tdomain::State *> &next_states,
+    const Function &f) {
+  if constexpr (has_transition_value_batch<Tdomain>::value) {
+    auto results =
+        domain.get_transition_value_batch(states, actions, next_states);
+    for_each_index<Texecution_policy>(
+        states.size(), [&results, &f](const std::size_t &i) {
+          f(i, results[i]);
+        });
+  } else {
+    for_each_index<Texecution_policy>(
+        states.size(),
+        [&domain, &states, &actions, &next_states, &f](const std::size_t &i) {
+          auto result = domain.get_transition_value(*states[i], *actions[i],
+                                                    *next_states[i]);
+          f(i, result);
+        });
+  }
+}
+
+template <typename Texecution_policy, typename Tdomain, typename Function>
+void for_each_terminal(
+    Tdomain &domain, const std::vector<const typename Tdomain::State *> &states,
+    const Function &f) {
+  if constexpr (has_terminal_batch<Tdomain>::value) {
+    auto results = domain.is_terminal_batch(states);
+    for_each_index<Texecution_policy>(
+        states.size(), [&results, &f](const std::size_t &i) {
+          f(i, static_cast<bool>(results[i]));
+        });
+  } else {
+    for_each_index<Texecution_policy>(
+        states.size(), [&domain, &states, &f](const std::size_t &i) {
+          f(i, static_cast<bool>(domain.is_terminal(*states[i])));
+        });
+  }
+}
+
+} // namespace skdecide
+
+#endif // SKDECIDE_BATCHED_DOMAIN_CALLS_HH
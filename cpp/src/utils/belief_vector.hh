@@ -0,0 +1,415 @@
+/* Copyright (c) AIRBUS and its affiliates.
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#ifndef SKDECIDE_BELIEF_VECTOR_HH
+#define SKDECIDE_BELIEF_VECTOR_HH
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <utility>
+#include <vector>
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+namespace skdecide {
+
+/**
+ * @brief Allocator of memory aligned on Alignment bytes (by default a cache
+ * line, which is also the width of an AVX-512 register)
+ */
+template <typename T, std::size_t Alignment = 64> struct AlignedAllocator {
+  typedef T value_type;
+
+  template <typename U> struct rebind {
+    typedef AlignedAllocator<U, Alignment> other;
+  };
+
+  AlignedAllocator() noexcept = default;
+  template <typename U>
+  AlignedAllocator(const AlignedAllocator<U, Alignment> &) noexcept {}
+
+  T *allocate(std::size_t n) {
+    return static_cast<T *>(
+        ::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+  }
+
+  void deallocate(T *p, std::size_t) noexcept {
+    ::operator delete(p, std::align_val_t(Alignment));
+  }
+
+  template <typename U>
+  bool operator==(const AlignedAllocator<U, Alignment> &) const noexcept {
+    return true;
+  }
+
+  template <typename U>
+  bool operator!=(const AlignedAllocator<U, Alignment> &) const noexcept {
+    return false;
+  }
+};
+
+/**
+ * Vector kernels of the point-based POMDP solvers. They use AVX-512 or AVX2
+ * instructions when the code is compiled for them (e.g. with -march=native,
+ * see the NATIVE_ARCHITECTURE CMake option) and plain loops otherwise.
+ */
+namespace belief_kernels {
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+static_assert(sizeof(std::size_t) == 8,
+              "SIMD gathers expect 64-bit state indices");
+#endif
+
+#if defined(__AVX2__) && !defined(__AVX512F__)
+inline double horizontal_sum(__m256d v) {
+  __m128d lo = _mm256_castpd256_pd128(v);
+  __m128d hi = _mm256_extractf128_pd(v, 1);
+  lo = _mm_add_pd(lo, hi);
+  return _mm_cvtsd_f64(_mm_add_sd(lo, _mm_unpackhi_pd(lo, lo)));
+}
+
+inline __m256d multiply_add(__m256d x, __m256d y, __m256d acc) {
+#if defined(__FMA__)
+  return _mm256_fmadd_pd(x, y, acc);
+#else
+  return _mm256_add_pd(_mm256_mul_pd(x, y), acc);
+#endif
+}
+#endif
+
+// sum_i x[i] * y[i]
+inline double dense_dot(const double *x, const double *y, std::size_t n) {
+  std::size_t i = 0;
+  double result = 0.0;
+#if defined(__AVX512F__)
+  __m512d acc0 = _mm512_setzero_pd();
+  __m512d acc1 = _mm512_setzero_pd();
+  for (; i + 16 <= n; i += 16) {
+    acc0 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i),
+                           acc0);
+    acc1 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i + 8),
+                           _mm512_loadu_pd(y + i + 8), acc1);
+  }
+  for (; i + 8 <= n; i += 8) {
+    acc0 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i),
+                           acc0);
+  }
+  result = _mm512_reduce_add_pd(_mm512_add_pd(acc0, acc1));
+#elif defined(__AVX2__)
+  __m256d acc0 = _mm256_setzero_pd();
+  __m256d acc1 = _mm256_setzero_pd();
+  for (; i + 8 <= n; i += 8) {
+    acc0 = multiply_add(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i), acc0);
+    acc1 = multiply_add(_mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4),
+                        acc1);
+  }
+  for (; i + 4 <= n; i += 4) {
+    acc0 = multiply_add(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i), acc0);
+  }
+  result = horizontal_sum(_mm256_add_pd(acc0, acc1));
+#endif
+  for (; i < n; i++) {
+    result += x[i] * y[i];
+  }
+  return result;
+}
+
+// sum_k values[k] * dense[indices[k]]
+inline double sparse_dot(const std::size_t *indices, const double *values,
+                         std::size_t n, const double *dense) {
+  std::size_t k = 0;
+  double result = 0.0;
+#if defined(__AVX512F__)
+  __m512d acc = _mm512_setzero_pd();
+  for (; k + 8 <= n; k += 8) {
+    __m512i idx = _mm512_loadu_si512(static_cast<const void *>(indices + k));
+    acc = _mm512_fmadd_pd(_mm512_loadu_pd(values + k),
+                          _mm512_i64gather_pd(idx, dense, 8), acc);
+  }
+  result = _mm512_reduce_add_pd(acc);
+#elif defined(__AVX2__)
+  __m256d acc = _mm256_setzero_pd();
+  for (; k + 4 <= n; k += 4) {
+    __m256i idx =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(indices + k));
+    acc = multiply_add(_mm256_loadu_pd(values + k),
+                       _mm256_i64gather_pd(dense, idx, 8), acc);
+  }
+  result = horizontal_sum(acc);
+#endif
+  for (; k < n; k++) {
+    result += values[k] * dense[indices[k]];
+  }
+  return result;
+}
+
+// x[i] *= y[i], returning sum_i x[i] (the mass of a posterior belief)
+inline double multiply_sum(double *x, const double *y, std::size_t n) {
+  std::size_t i = 0;
+  double result = 0.0;
+#if defined(__AVX512F__)
+  __m512d acc = _mm512_setzero_pd();
+  for (; i + 8 <= n; i += 8) {
+    __m512d v = _mm512_mul_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i));
+    _mm512_storeu_pd(x + i, v);
+    acc = _mm512_add_pd(acc, v);
+  }
+  result = _mm512_reduce_add_pd(acc);
+#elif defined(__AVX2__)
+  __m256d acc = _mm256_setzero_pd();
+  for (; i + 4 <= n; i += 4) {
+    __m256d v = _mm256_mul_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i));
+    _mm256_storeu_pd(x + i, v);
+    acc = _mm256_add_pd(acc, v);
+  }
+  result = horizontal_sum(acc);
+#endif
+  for (; i < n; i++) {
+    x[i] *= y[i];
+    result += x[i];
+  }
+  return result;
+}
+
+// x[i] *= factor
+inline void scale(double *x, double factor, std::size_t n) {
+  std::size_t i = 0;
+#if defined(__AVX512F__)
+  __m512d f = _mm512_set1_pd(factor);
+  for (; i + 8 <= n; i += 8) {
+    _mm512_storeu_pd(x + i, _mm512_mul_pd(_mm512_loadu_pd(x + i), f));
+  }
+#elif defined(__AVX2__)
+  __m256d f = _mm256_set1_pd(factor);
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(x + i, _mm256_mul_pd(_mm256_loadu_pd(x + i), f));
+  }
+#endif
+  for (; i < n; i++) {
+    x[i] *= factor;
+  }
+}
+
+} // namespace belief_kernels
+
+/**
+ * @brief Probability distribution over the indices [0, dimension) of the
+ * enumerated states of a POMDP. A belief whose support covers at least
+ * dense_support_ratio of the states is stored as a contiguous aligned array
+ * of dimension probabilities; other beliefs are stored as sorted arrays of
+ * state indices and non-zero probabilities. Dot products with dense vectors
+ * (e.g. alpha-vectors) then run as SIMD (gathered, for sparse beliefs)
+ * multiply-adds instead of one hash map lookup per belief entry.
+ */
+class BeliefVector {
+public:
+  typedef std::vector<double, AlignedAllocator<double>> Values;
+
+  static constexpr double dense_support_ratio = 0.25;
+
+  BeliefVector() : _dimension(0), _support_size(0), _dense(false) {}
+
+  // Builds the belief from (state index, probability) entries; entries with
+  // the same index are summed up and non-positive probabilities are dropped
+  BeliefVector(std::size_t dimension,
+               std::vector<std::pair<std::size_t, double>> entries)
+      : _dimension(dimension), _support_size(0), _dense(false) {
+    std::sort(entries.begin(), entries.end());
+    for (const auto &e : entries) {
+      if (!_indices.empty() && _indices.back() == e.first) {
+        _values.back() += e.second;
+      } else {
+        _indices.push_back(e.first);
+        _values.push_back(e.second);
+      }
+    }
+    std::size_t last = 0;
+    for (std::size_t k = 0; k < _indices.size(); k++) {
+      if (_values[k] > 0.0) {
+        _indices[last] = _indices[k];
+        _values[last] = _values[k];
+        last++;
+      }
+    }
+    _indices.resize(last);
+    _values.resize(last);
+    _support_size = last;
+    densify_if_needed();
+  }
+
+  std::size_t dimension() const { return _dimension; }
+  std::size_t support_size() const { return _support_size; }
+  bool empty() const { return _support_size == 0; }
+  bool is_dense() const { return _dense; }
+
+  void clear() {
+    _support_size = 0;
+    _dense = false;
+    _indices.clear();
+    _values.clear();
+  }
+
+  // Probability of state index i (binary search for sparse beliefs)
+  double operator[](std::size_t i) const {
+    if (_dense) {
+      return i < _values.size() ? _values[i] : 0.0;
+    }
+    auto it = std::lower_bound(_indices.begin(), _indices.end(), i);
+    return (it != _indices.end() && *it == i)
+               ? _values[it - _indices.begin()]
+               : 0.0;
+  }
+
+  // Calls f(state index, probability) for each state of the support in
+  // increasing index order
+  template <typename Function> void for_each(const Function &f) const {
+    if (_dense) {
+      for (std::size_t i = 0; i < _values.size(); i++) {
+        if (_values[i] > 0.0) {
+          f(i, _values[i]);
+        }
+      }
+    } else {
+      for (std::size_t k = 0; k < _indices.size(); k++) {
+        f(_indices[k], _values[k]);
+      }
+    }
+  }
+
+  // sum_s b(s) * v[s] where v has (at least) dimension entries
+  double dot(const double *v) const {
+    return _dense ? belief_kernels::dense_dot(_values.data(), v, _values.size())
+                  : belief_kernels::sparse_dot(_indices.data(), _values.data(),
+                                               _indices.size(), v);
+  }
+
+private:
+  friend class BeliefAccumulator;
+
+  std::size_t _dimension;
+  std::size_t _support_size;
+  bool _dense;
+  std::vector<std::size_t> _indices; // sparse beliefs only
+  Values _values;
+
+  void densify_if_needed() {
+    if (_dense || _dimension == 0 ||
+        static_cast<double>(_support_size) <
+            dense_support_ratio * static_cast<double>(_dimension)) {
+      return;
+    }
+    Values dense(_dimension, 0.0);
+    for (std::size_t k = 0; k < _indices.size(); k++) {
+      dense[_indices[k]] = _values[k];
+    }
+    _values = std::move(dense);
+    _indices.clear();
+    _indices.shrink_to_fit();
+    _dense = true;
+  }
+};
+
+/**
+ * @brief Scratch dense array accumulating the predicted probabilities
+ * sum_s b(s) T(s, a, s') of a belief update. Only the touched entries are
+ * reset between two updates, so that the cost of an update is proportional to
+ * the support of the predicted belief rather than to the number of states.
+ * Meant to be used as a thread_local object by concurrent belief updates.
+ */
+class BeliefAccumulator {
+public:
+  void reset(std::size_t dimension) {
+    for (std::size_t i : _touched) {
+      _predicted[i] = 0.0;
+      _is_touched[i] = false;
+    }
+    _touched.clear();
+    if (_predicted.size() != dimension) {
+      _predicted.assign(dimension, 0.0);
+      _is_touched.assign(dimension, false);
+    }
+  }
+
+  void add(std::size_t i, double p) {
+    if (!_is_touched[i]) {
+      _is_touched[i] = true;
+      _touched.push_back(i);
+    }
+    _predicted[i] += p;
+  }
+
+  /** Returns the posterior belief proportional to weight(s') times the
+   * predicted probability of s' (e.g. the observation likelihood), empty if
+   * its mass is not above mass_epsilon; mass receives the unnormalized mass
+   * (e.g. the probability of the observation) */
+  template <typename Tweight>
+  BeliefVector posterior(const Tweight &weight, double mass_epsilon,
+                         double &mass) {
+    gather();
+    std::size_t n = _touched.size();
+    _weights.resize(n);
+    for (std::size_t k = 0; k < n; k++) {
+      _weights[k] = weight(_touched[k]);
+    }
+    mass = belief_kernels::multiply_sum(_values.data(), _weights.data(), n);
+    return normalize(mass_epsilon, mass);
+  }
+
+  /** Returns the normalized predicted belief, for predictions that already
+   * include the observation likelihood (e.g. products with the matrices of
+   * ObservationTransitionTensors), empty if its mass (received by mass) is not
+   * above mass_epsilon */
+  BeliefVector normalized(double mass_epsilon, double &mass) {
+    gather();
+    mass = 0.0;
+    for (std::size_t k = 0; k < _touched.size(); k++) {
+      mass += _values[k];
+    }
+    return normalize(mass_epsilon, mass);
+  }
+
+private:
+  // Copies the predicted probabilities to _values by increasing state index
+  void gather() {
+    std::sort(_touched.begin(), _touched.end());
+    _values.resize(_touched.size());
+    for (std::size_t k = 0; k < _touched.size(); k++) {
+      _values[k] = _predicted[_touched[k]];
+    }
+  }
+
+  BeliefVector normalize(double mass_epsilon, double mass) {
+    std::size_t n = _touched.size();
+    BeliefVector b;
+    b._dimension = _predicted.size();
+    if (!(mass > mass_epsilon)) {
+      return b;
+    }
+    belief_kernels::scale(_values.data(), 1.0 / mass, n);
+    for (std::size_t k = 0; k < n; k++) {
+      if (_values[k] > 0.0) {
+        b._indices.push_back(_touched[k]);
+        b._values.push_back(_values[k]);
+      }
+    }
+    b._support_size = b._indices.size();
+    b.densify_if_needed();
+    return b;
+  }
+
+  std::vector<double> _predicted;
+  std::vector<bool> _is_touched;
+  std::vector<std::size_t> _touched;
+  BeliefVector::Values _values;
+  BeliefVector::Values _weights;
+};
+
+} // namespace skdecide
+
+#endif // SKDECIDE_BELIEF_VECTOR_HH
@@ -0,0 +1,85 @@
+/* Copyright (c) AIRBUS and its affiliates.
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#ifndef SKDECIDE_COMPRESSED_LP_MATRIX_HH
+#define SKDECIDE_COMPRESSED_LP_MATRIX_HH
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace skdecide {
+
+/**
+ * @brief Sparse LP matrix assembled one major vector (row or column) at a
+ * time in compressed layout, ready to be handed to an LP solver in a single
+ * call (e.g. HiGHS' passModel(), addRows() or addCols()). The entries added
+ * to the current major vector with the same minor index (e.g. the outflow and
+ * inflow coefficients of a self-loop) are merged.
+ *
+ * @tparam Tindex Index type of the LP solver (e.g. HighsInt)
+ */
+template <typename Tindex> class CompressedLPMatrix {
+public:
+  explicit CompressedLPMatrix(std::size_t nb_minor = 0)
+      : _slots(nb_minor, -1), _start(1, 0) {}
+
+  void clear() {
+    _slots.assign(_slots.size(), -1);
+    _start.assign(1, 0);
+    _index.clear();
+    _value.clear();
+  }
+
+  void add(Tindex minor, double value) {
+    if (static_cast<std::size_t>(minor) >= _slots.size()) {
+      _slots.resize(static_cast<std::size_t>(minor) + 1, -1);
+    }
+    if (_slots[minor] >= _start.back()) {
+      _value[_slots[minor]] += value;
+    } else {
+      _slots[minor] = static_cast<Tindex>(_index.size());
+      _index.push_back(minor);
+      _value.push_back(value);
+    }
+  }
+
+  // Ends the current major vector, dropping the entries whose magnitude is
+  // not above tolerance (e.g. cancelled self-loop coefficients)
+  void close(double tolerance = 0.0) {
+    if (tolerance > 0.0) {
+      Tindex last = _start.back();
+      for (Tindex i = _start.back(); i < static_cast<Tindex>(_index.size());
+           i++) {
+        if (std::fabs(_value[i]) > tolerance) {
+          _slots[_index[i]] = last;
+          _index[last] = _index[i];
+          _value[last] = _value[i];
+          last++;
+        } else {
+          _slots[_index[i]] = -1;
+        }
+      }
+      _index.resize(last);
+      _value.resize(last);
+    }
+    _start.push_back(static_cast<Tindex>(_index.size()));
+  }
+
+  Tindex nb_major() const { return static_cast<Tindex>(_start.size() - 1); }
+  Tindex nb_entries() const { return static_cast<Tindex>(_index.size()); }
+  const Tindex *start() const { return _start.data(); }
+  const Tindex *index() const { return _index.data(); }
+  const double *value() const { return _value.data(); }
+
+private:
+  std::vector<Tindex> _slots; // position of each minor index in _index
+  std::vector<Tindex> _start;
+  std::vector<Tindex> _index;
+  std::vector<double> _value;
+};
+
+} // namespace skdecide
+
+#endif // SKDECIDE_COMPRESSED_LP_MATRIX_HH
@@ -0,0 +1,211 @@
+/* Copyright (c) AIRBUS and its affiliates.
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#ifndef SKDECIDE_CONCURRENT_ALPHA_VECTOR_STORE_HH
+#define SKDECIDE_CONCURRENT_ALPHA_VECTOR_STORE_HH
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <vector>
+
+#include "utils/belief_vector.hh"
+#include "utils/concurrent_append_buffer.hh"
+#include "utils/execution.hh"
+
+namespace skdecide {
+
+/**
+ * @brief Set of alpha-vectors (each one with its action index) shared by
+ * threads which concurrently evaluate it, append alpha-vectors to it and
+ * prune it. Evaluations run on a Snapshot of the set, taken in constant time,
+ * which is never modified and stays valid as long as it is held, whatever
+ * the concurrent appends and prunings. Appended rows are stored in a
+ * ConcurrentAppendBuffer, so that appending a row never copies or moves the
+ * other rows. Pruning computes the rows to keep from a snapshot, then
+ * replace() builds the compacted set, which also gets the rows appended
+ * since the snapshot, and swaps it in atomically: the snapshots taken before
+ * keep evaluating the old set, whose memory is released with the last of
+ * them.
+ */
+class ConcurrentAlphaVectorStore {
+private:
+  struct Row {
+    Row(const double *v, std::size_t nb_states, std::size_t action_idx)
+        : values(v, v + nb_states), action(action_idx) {}
+
+    BeliefVector::Values values;
+    std::size_t action;
+  };
+
+  typedef ConcurrentAppendBuffer<Row> Rows;
+
+public:
+  // Approximate size in bytes of the tiles of rows multiplied with a block of
+  // beliefs, chosen to stay in the L2 cache
+  static constexpr std::size_t tile_bytes = 128 * 1024;
+  static constexpr std::size_t belief_block_size = 8;
+
+  class Snapshot {
+  public:
+    Snapshot() : _size(0), _nb_states(0) {}
+
+    std::size_t nb_states() const { return _nb_states; }
+    std::size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+
+    const double *row(std::size_t i) const {
+      return (*_rows)[i].values.data();
+    }
+    std::size_t action(std::size_t i) const { return (*_rows)[i].action; }
+
+    /** Index of the row maximizing (according to is_better) its dot product
+     * with b, the first one in case of ties; best receives the dot product of
+     * the returned row (or init if there is no row) */
+    template <typename Tis_better>
+    std::size_t best_dot(const BeliefVector &b, const Tis_better &is_better,
+                         double init, double &best) const {
+      std::size_t best_idx = 0;
+      best = init;
+      if (_size > 0) {
+        _rows->for_each(0, _size,
+                        [&b, &is_better, &best, &best_idx](std::size_t i,
+                                                           const Row &r) {
+                          double v = b.dot(r.values.data());
+                          if (is_better(v, best)) {
+                            best = v;
+                            best_idx = i;
+                          }
+                        });
+      }
+      return best_idx;
+    }
+
+    /** Batched best_dot() of all the beliefs, computed as a blocked product
+     * of the rows with the beliefs: blocks of beliefs are processed in
+     * parallel according to the execution policy, each one being multiplied
+     * with a cache-sized tile of rows at a time. The results are the ones of
+     * best_dot() whatever the execution policy. */
+    template <typename Texecution_policy, typename Tis_better>
+    void best_dots(const std::vector<const BeliefVector *> &beliefs,
+                   const Tis_better &is_better, double init,
+                   std::vector<double> &best,
+                   std::vector<std::size_t> &best_indices) const {
+      best.assign(beliefs.size(), init);
+      best_indices.assign(beliefs.size(), 0);
+      if (_size == 0)
+        return;
+      std::size_t row_bytes =
+          sizeof(double) * std::max<std::size_t>(_nb_states, 1);
+      std::size_t tile_size = std::max<std::size_t>(1, tile_bytes / row_bytes);
+      std::vector<std::size_t> blocks(
+          (beliefs.size() + belief_block_size - 1) / belief_block_size);
+      std::iota(blocks.begin(), blocks.end(), 0);
+      std::for_each(
+          Texecution_policy::policy, blocks.begin(), blocks.end(),
+          [this, &beliefs, &is_better, &best, &best_indices,
+           &tile_size](const std::size_t &block) {
+            std::size_t first = block * belief_block_size;
+            std::size_t last =
+                std::min(first + belief_block_size, beliefs.size());
+            for (std::size_t t = 0; t < _size; t += tile_size) {
+              std::size_t tile_end = std::min(t + tile_size, _size);
+              for (std::size_t k = first; k < last; k++) {
+                _rows->for_each(t, tile_end,
+                                [&beliefs, &is_better, &best, &best_indices,
+                                 &k](std::size_t i, const Row &r) {
+                                  double v = beliefs[k]->dot(r.values.data());
+                                  if (is_better(v, best[k])) {
+                                    best[k] = v;
+                                    best_indices[k] = i;
+                                  }
+                                });
+              }
+            }
+          });
+    }
+
+  private:
+    friend class ConcurrentAlphaVectorStore;
+
+    Snapshot(std::shared_ptr<const Rows> rows, std::size_t size,
+             std::size_t nb_states)
+        : _rows(std::move(rows)), _size(size), _nb_states(nb_states) {}
+
+    std::shared_ptr<const Rows> _rows;
+    std::size_t _size;
+    std::size_t _nb_states;
+  };
+
+  explicit ConcurrentAlphaVectorStore(std::size_t nb_states = 0) {
+    reset(nb_states);
+  }
+
+  // Not thread safe, as well as clear()
+  void reset(std::size_t nb_states) {
+    _nb_states = nb_states;
+    clear();
+  }
+
+  void clear() { _rows = std::make_shared<Rows>(); }
+
+  std::size_t nb_states() const { return _nb_states; }
+
+  Snapshot snapshot() const {
+    std::shared_ptr<const Rows> rows = current();
+    std::size_t size = rows->size();
+    return Snapshot(std::move(rows), size, _nb_states);
+  }
+
+  std::size_t size() const { return current()->size(); }
+  bool empty() const { return size() == 0; }
+
+  void append(const double *values, std::size_t action_idx) {
+    std::lock_guard<std::mutex> lock(_write_mutex);
+    _rows->emplace_back(values, _nb_states, action_idx);
+  }
+
+  /** Replaces the rows of the snapshot by the ones of indices kept (in
+   * increasing order), followed by the rows appended since the snapshot.
+   * Returns false without changing the set if it was replaced since the
+   * snapshot. */
+  bool replace(const Snapshot &snapshot, const std::vector<std::size_t> &kept) {
+    auto rows = std::make_shared<Rows>();
+    for (std::size_t i : kept) {
+      rows->emplace_back(snapshot.row(i), _nb_states, snapshot.action(i));
+    }
+    std::lock_guard<std::mutex> lock(_write_mutex);
+    if (_rows != snapshot._rows) {
+      return false;
+    }
+    _rows->for_each(snapshot.size(), _rows->size(),
+                    [this, &rows](std::size_t, const Row &r) {
+                      rows->emplace_back(r.values.data(), _nb_states,
+                                         r.action);
+                    });
+    std::lock_guard<SpinMutex> rows_lock(_rows_mutex);
+    _rows = std::move(rows);
+    return true;
+  }
+
+private:
+  std::size_t _nb_states;
+  // Current rows, whose pointer is only changed under both mutexes and read
+  // under one of them
+  std::shared_ptr<Rows> _rows;
+  mutable SpinMutex _rows_mutex;
+  // Serializes the appends and replacements
+  std::mutex _write_mutex;
+
+  std::shared_ptr<const Rows> current() const {
+    std::lock_guard<SpinMutex> lock(_rows_mutex);
+    return _rows;
+  }
+};
+
+} // namespace skdecide
+
+#endif // SKDECIDE_CONCURRENT_ALPHA_VECTOR_STORE_HH
@@ -0,0 +1,123 @@
+/* Copyright (c) AIRBUS and its affiliates.
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#ifndef SKDECIDE_CONCURRENT_APPEND_BUFFER_HH
+#define SKDECIDE_CONCURRENT_APPEND_BUFFER_HH
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace skdecide {
+
+/**
+ * @brief Append-only array whose elements can be read by any number of
+ * threads while another thread appends to it. The elements are stored in
+ * segments of geometrically growing sizes which are never reallocated, so
+ * that appended elements never move: a reader reads size(), which is
+ * published with release semantics once the element is constructed, and may
+ * then access the elements below it without locking. Appends must be
+ * serialized by the caller (e.g. under a mutex).
+ */
+template <typename T> class ConcurrentAppendBuffer {
+public:
+  static constexpr std::size_t first_segment_size = 64;
+  // Enough segments to address any index of a 64-bit size_t
+  static constexpr std::size_t max_segments = 58;
+
+  ConcurrentAppendBuffer() : _size(0) {}
+  ConcurrentAppendBuffer(const ConcurrentAppendBuffer &) = delete;
+  ConcurrentAppendBuffer &operator=(const ConcurrentAppendBuffer &) = delete;
+
+  ~ConcurrentAppendBuffer() { clear(); }
+
+  // Not thread safe: no other thread may access the buffer meanwhile
+  void clear() {
+    std::size_t n = _size.load(std::memory_order_relaxed);
+    for (std::size_t k = 0; k < max_segments && n > 0; k++) {
+      std::size_t m = std::min(n, segment_size(k));
+      for (std::size_t i = 0; i < m; i++) {
+        _segments[k][i].~T();
+      }
+      n -= m;
+    }
+    for (std::size_t k = 0; k < max_segments; k++) {
+      if (_segments[k] != nullptr) {
+        std::allocator<T>().deallocate(_segments[k], segment_size(k));
+        _segments[k] = nullptr;
+      }
+    }
+    _size.store(0, std::memory_order_relaxed);
+  }
+
+  std::size_t size() const { return _size.load(std::memory_order_acquire); }
+  bool empty() const { return size() == 0; }
+
+  const T &operator[](std::size_t i) const {
+    std::size_t k = segment_index(i);
+    return _segments[k][i - segment_start(k)];
+  }
+
+  template <typename... Args> void emplace_back(Args &&...args) {
+    std::size_t i = _size.load(std::memory_order_relaxed);
+    std::size_t k = segment_index(i);
+    if (_segments[k] == nullptr) {
+      _segments[k] = std::allocator<T>().allocate(segment_size(k));
+    }
+    new (_segments[k] + (i - segment_start(k))) T(std::forward<Args>(args)...);
+    _size.store(i + 1, std::memory_order_release);
+  }
+
+  /** Applies f(i, element) to the elements of indices in [first, last), which
+   * must be below size(), walking the segments rather than locating each
+   * element */
+  template <typename Tfunction>
+  void for_each(std::size_t first, std::size_t last,
+                const Tfunction &f) const {
+    if (first >= last)
+      return;
+    std::size_t k = segment_index(first);
+    std::size_t start = segment_start(k);
+    for (std::size_t i = first; i < last; k++) {
+      std::size_t end = std::min(last, start + segment_size(k));
+      const T *segment = _segments[k] - start;
+      for (; i < end; i++) {
+        f(i, segment[i]);
+      }
+      start += segment_size(k);
+    }
+  }
+
+private:
+  std::array<T *, max_segments> _segments{};
+  std::atomic<std::size_t> _size;
+
+  static std::size_t segment_size(std::size_t k) {
+    return first_segment_size << k;
+  }
+
+  // Index of the first element of segment k
+  static std::size_t segment_start(std::size_t k) {
+    return first_segment_size * ((std::size_t(1) << k) - 1);
+  }
+
+  static std::size_t segment_index(std::size_t i) {
+    // Segment k holds the elements i such that
+    // 2^k <= i / first_segment_size + 1 < 2^(k+1)
+    std::size_t q = i / first_segment_size + 1;
+    std::size_t k = 0;
+    while (q >>= 1) {
+      k++;
+    }
+    return k;
+  }
+};
+
+} // namespace skdecide
+
+#endif // SKDECIDE_CONCURRENT_APPEND_BUFFER_HH
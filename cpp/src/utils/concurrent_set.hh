@@ -0,0 +1,279 @@
+/* Copyright (c) AIRBUS and its affiliates.
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#ifndef SKDECIDE_CONCURRENT_SET_HH
+#define SKDECIDE_CONCURRENT_SET_HH
+
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+#include "utils/associative_container_deducer.hh"
+#include "utils/execution.hh"
+
+namespace skdecide {
+
+/**
+ * @brief Set container safe for concurrent insertions, lookups and erasures,
+ * meant to replace search graphs which were previously protected by the
+ * execution policy's global critical section. Elements are distributed over
+ * Nshards independent shards selected from the element's hash value, each
+ * shard being the associative container deduced by SetTypeDeducer and guarded
+ * by its own mutex, so that threads only contend when they hit the same shard.
+ *
+ * Like node-based standard containers, elements are never moved once inserted:
+ * iterators returned by emplace() and find() remain dereferenceable while
+ * other threads keep inserting elements, as long as the pointed element is not
+ * erased. Traversing the whole set (begin()/end()) and clear() must however
+ * not run concurrently with insertions or erasures.
+ *
+ * When RealKey does not define 'Hash' and 'Equal' types but only a 'Less' type,
+ * a single shard is used which amounts to a mutex-protected std::set.
+ *
+ * @tparam Key Type of the elements stored in the set
+ * @tparam RealKey Type of the keys (must be Key, or Key must define a 'Key'
+ * functor accessing the RealKey from a Key object)
+ * @tparam Tmutex Type of the mutex protecting each shard
+ * @tparam Nshards Number of shards (must be a power of 2)
+ * @tparam Alloc Allocator of each shard
+ */
+template <typename Key, typename RealKey, typename Tmutex,
+          std::size_t Nshards = 64, typename Alloc = std::allocator<Key>>
+class ConcurrentSet {
+public:
+  typedef typename SetTypeDeducer<Key, RealKey, Alloc>::Set Set;
+  typedef Key key_type;
+  typedef Key value_type;
+  typedef std::size_t size_type;
+
+  static_assert((Nshards & (Nshards - 1)) == 0 && Nshards > 0,
+                "Number of shards must be a power of 2");
+
+  static constexpr bool is_hashed =
+      has_hash<RealKey>::value && has_equal<RealKey>::value;
+  static constexpr std::size_t nb_shards = is_hashed ? Nshards : 1;
+
+  class const_iterator {
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef Key value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const Key *pointer;
+    typedef const Key &reference;
+
+    const_iterator() : _set(nullptr), _shard(nb_shards), _ptr(nullptr) {}
+
+    reference operator*() const { return *_ptr; }
+    pointer operator->() const { return _ptr; }
+
+    const_iterator &operator++() {
+      ++_it;
+      skip_empty_shards();
+      return *this;
+    }
+
+    const_iterator operator++(int) {
+      const_iterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    bool operator==(const const_iterator &other) const {
+      return _ptr == other._ptr;
+    }
+
+    bool operator!=(const const_iterator &other) const {
+      return _ptr != other._ptr;
+    }
+
+  private:
+    friend class ConcurrentSet;
+
+    const ConcurrentSet *_set;
+    std::size_t _shard;
+    typename Set::const_iterator _it;
+    // Cached element pointer: contrary to the underlying iterator, it is not
+    // invalidated by concurrent rehashes of the shard
+    const Key *_ptr;
+
+    const_iterator(const ConcurrentSet *set, std::size_t shard,
+                   const typename Set::const_iterator &it)
+        : _set(set), _shard(shard), _it(it), _ptr(&(*it)) {}
+
+    // Builds an iterator pointing to the first element found from the
+    // beginning of the given shard
+    const_iterator(const ConcurrentSet *set, std::size_t shard)
+        : _set(set), _shard(shard), _ptr(nullptr) {
+      if (_shard < nb_shards) {
+        _it = _set->_shards[_shard].set.begin();
+        skip_empty_shards();
+      }
+    }
+
+    void skip_empty_shards() {
+      while (_it == _set->_shards[_shard].set.end()) {
+        if (++_shard == nb_shards) {
+          _ptr = nullptr;
+          return;
+        }
+        _it = _set->_shards[_shard].set.begin();
+      }
+      _ptr = &(*_it);
+    }
+  };
+
+  typedef const_iterator iterator;
+
+  ConcurrentSet() {}
+  ConcurrentSet(const ConcurrentSet &) = delete;
+  ConcurrentSet &operator=(const ConcurrentSet &) = delete;
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    if constexpr (!is_hashed || hashes_directly<Args...>::value) {
+      return emplace_in(_shards[shard_index(args...)],
+                        std::forward<Args>(args)...);
+    } else {
+      // The element must be built to get its hash value: build it only once
+      // and move it into its shard
+      static_assert(std::is_move_constructible<Key>::value,
+                    "Elements which are not move-constructible must be "
+                    "emplaced from a Key or a RealKey object");
+      Key k(std::forward<Args>(args)...);
+      Shard &shard = _shards[shard_of(Hash<RealKey>()(k))];
+      return emplace_in(shard, std::move(k));
+    }
+  }
+
+  std::pair<iterator, bool> insert(const Key &k) { return emplace(k); }
+
+  iterator find(const Key &k) const {
+    const Shard &shard = _shards[shard_index(k)];
+    std::lock_guard<Tmutex> lock(shard.mutex);
+    auto i = shard.set.find(k);
+    if (i == shard.set.end()) {
+      return end();
+    } else {
+      return const_iterator(this, &shard - _shards.data(), i);
+    }
+  }
+
+  size_type count(const Key &k) const { return (find(k) != end()) ? 1 : 0; }
+
+  size_type erase(const Key &k) {
+    Shard &shard = _shards[shard_index(k)];
+    std::lock_guard<Tmutex> lock(shard.mutex);
+    return shard.set.erase(k);
+  }
+
+  size_type size() const {
+    size_type sz = 0;
+    for (const auto &shard : _shards) {
+      std::lock_guard<Tmutex> lock(shard.mutex);
+      sz += shard.set.size();
+    }
+    return sz;
+  }
+
+  bool empty() const { return size() == 0; }
+
+  void clear() {
+    for (auto &shard : _shards) {
+      std::lock_guard<Tmutex> lock(shard.mutex);
+      shard.set.clear();
+    }
+  }
+
+  iterator begin() const { return const_iterator(this, 0); }
+  iterator end() const { return const_iterator(); }
+
+private:
+  // Shards are aligned on cache lines to avoid false sharing between the
+  // mutexes of neighbouring shards
+  struct alignas(64) Shard {
+    Set set;
+    mutable Tmutex mutex;
+  };
+
+  std::array<Shard, nb_shards> _shards;
+
+  static std::size_t shard_of(std::size_t h) {
+    if constexpr (nb_shards == 1) {
+      return 0;
+    } else {
+      // Fibonacci hashing: select the shard from the high-order bits of the
+      // mixed hash value, which are uncorrelated with the low-order bits used
+      // by each shard's buckets
+      constexpr unsigned shift = 8 * sizeof(std::uint64_t) - log2(Nshards);
+      return static_cast<std::size_t>(
+          (static_cast<std::uint64_t>(h) * 0x9E3779B97F4A7C15ULL) >> shift);
+    }
+  }
+
+  static constexpr unsigned log2(std::size_t n) {
+    return (n <= 1) ? 0 : 1 + log2(n >> 1);
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace_in(Shard &shard, Args &&...args) {
+    std::lock_guard<Tmutex> lock(shard.mutex);
+    auto i = shard.set.emplace(std::forward<Args>(args)...);
+    return std::make_pair(
+        const_iterator(this, &shard - _shards.data(), i.first), i.second);
+  }
+
+  // True when the emplaced arguments reduce to a single Key or RealKey object
+  // which can be hashed without constructing a temporary element
+  template <typename... Args> struct hashes_directly : std::false_type {};
+
+  template <typename Arg>
+  struct hashes_directly<Arg>
+      : std::integral_constant<
+            bool, (std::is_same<std::decay_t<Arg>, RealKey>::value &&
+                   !std::is_same<Key, RealKey>::value) ||
+                      std::is_convertible<const Arg &, const Key &>::value> {};
+
+  template <typename Arg> static std::size_t shard_index(const Arg &arg) {
+    if constexpr (!is_hashed) {
+      return 0;
+    } else if constexpr (std::is_same<std::decay_t<Arg>, RealKey>::value &&
+                         !std::is_same<Key, RealKey>::value) {
+      return shard_of(typename RealKey::Hash()(arg));
+    } else {
+      return shard_of(Hash<RealKey>()(static_cast<const Key &>(arg)));
+    }
+  }
+
+  template <typename... Args> static std::size_t shard_index(const Args &...) {
+    return 0; // only reached for unhashed sets
+  }
+};
+
+/**
+ * @brief Deduces the type of set to use for search graphs whose nodes are
+ * concurrently inserted by the threads of the given execution policy: a
+ * ConcurrentSet for ParallelExecution, and the (faster) standard container
+ * deduced by SetTypeDeducer for SequentialExecution
+ *
+ * @tparam Key Type of the elements stored in the set
+ * @tparam RealKey Type of the keys (see SetTypeDeducer)
+ * @tparam Texecution_policy Type of the execution policy
+ * @tparam Alloc Allocator of the set (of each shard of a ConcurrentSet)
+ */
+template <typename Key, typename RealKey, typename Texecution_policy,
+          typename Alloc = std::allocator<Key>>
+struct ConcurrentSetTypeDeducer {
+  typedef typename std::conditional<
+      std::is_same<Texecution_policy, SequentialExecution>::value,
+      typename SetTypeDeducer<Key, RealKey, Alloc>::Set,
+      ConcurrentSet<Key, RealKey, typename Texecution_policy::Mutex, 64,
+                    Alloc>>::type Set;
+};
+
+} // namespace skdecide
+
+#endif // SKDECIDE_CONCURRENT_SET_HH
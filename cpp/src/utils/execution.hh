@@ -13,11 +13,72 @@
 #include <omp.h>
 #endif
 #include <atomic>
+#include <mutex>
 #include <thread>
 #include <sstream>
+#include <type_traits>
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) ||             \
+    defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
+#include "utils/work_stealing_scheduler.hh"
 
 namespace skdecide {
 
+/**
+ * @brief Test-and-test-and-set spin lock with exponential backoff, meant to
+ * replace the policies' Mutex type for very short critical sections (e.g.
+ * updating a few counters) where the cost of a system mutex or of an OpenMP
+ * lock dominates the cost of the protected code. Threads spin on a read-only
+ * load to avoid cache line ping-pong, pause for an exponentially growing
+ * number of iterations after each failed acquisition attempt, and eventually
+ * yield to the OS scheduler when the lock is held for a long time.
+ */
+class SpinMutex {
+public:
+  SpinMutex() : _locked(false) {}
+  SpinMutex(const SpinMutex &) = delete;
+  SpinMutex &operator=(const SpinMutex &) = delete;
+
+  inline void lock() {
+    unsigned backoff = 1;
+    while (_locked.exchange(true, std::memory_order_acquire)) {
+      do {
+        if (backoff <= max_backoff) {
+          for (unsigned i = 0; i < backoff; i++) {
+            cpu_relax();
+          }
+          backoff <<= 1;
+        } else {
+          std::this_thread::yield();
+        }
+      } while (_locked.load(std::memory_order_relaxed));
+    }
+  }
+
+  inline bool try_lock() {
+    return !_locked.load(std::memory_order_relaxed) &&
+           !_locked.exchange(true, std::memory_order_acquire);
+  }
+
+  inline void unlock() { _locked.store(false, std::memory_order_release); }
+
+  // Hints the processor that the thread is busy-waiting
+  static inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) ||             \
+    defined(_M_IX86)
+    _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield");
+#endif
+  }
+
+private:
+  static constexpr unsigned max_backoff = 64;
+  std::atomic<bool> _locked;
+};
+
 #if defined(HAS_EXECUTION)
 struct SequentialExecution {
   static constexpr std::execution::sequenced_policy policy =
@@ -36,13 +97,20 @@ struct SequentialExecution {
     void unlock() {}
   };
 
-  template <typename Tmutex>
-  inline void protect(const std::function<void()> &f,
-                      [[maybe_unused]] Tmutex &m) {
-    f();
+  typedef Mutex SpinMutex;
+
+  template <typename Tmutex> struct LockGuard {
+    LockGuard([[maybe_unused]] Tmutex &m) {}
+  };
+
+  template <typename Function, typename Tmutex>
+  inline decltype(auto) protect(Function &&f, [[maybe_unused]] Tmutex &m) {
+    return f();
   }
 
-  inline void protect(const std::function<void()> &f) { f(); }
+  template <typename Function> inline decltype(auto) protect(Function &&f) {
+    return f();
+  }
 
   inline static std::string print_type() { return class_name; }
 
@@ -58,15 +126,21 @@ struct ParallelExecution {
   typedef std::mutex Mutex;
   typedef std::recursive_mutex RecursiveMutex;
 
+  typedef skdecide::SpinMutex SpinMutex;
+
+  template <typename Tmutex> using LockGuard = std::lock_guard<Tmutex>;
+
   Mutex _mutex;
 
-  template <typename Tmutex>
-  inline void protect(const std::function<void()> &f, Tmutex &m) {
-    std::scoped_lock lock(m);
-    f();
+  template <typename Function, typename Tmutex>
+  inline decltype(auto) protect(Function &&f, Tmutex &m) {
+    std::lock_guard<Tmutex> lock(m);
+    return f();
   }
 
-  inline void protect(const std::function<void()> &f) { protect(f, _mutex); }
+  template <typename Function> inline decltype(auto) protect(Function &&f) {
+    return protect(std::forward<Function>(f), _mutex);
+  }
 
   inline static std::string print_type() { return class_name; }
 
@@ -95,13 +169,20 @@ struct SequentialExecution {
     void unlock() {}
   };
 
-  template <typename Tmutex>
-  inline void protect(const std::function<void()> &f,
-                      [[maybe_unused]] Tmutex &m) {
-    f();
+  typedef Mutex SpinMutex;
+
+  template <typename Tmutex> struct LockGuard {
+    LockGuard([[maybe_unused]] Tmutex &m) {}
+  };
+
+  template <typename Function, typename Tmutex>
+  inline decltype(auto) protect(Function &&f, [[maybe_unused]] Tmutex &m) {
+    return f();
   }
 
-  inline void protect(const std::function<void()> &f) { f(); }
+  template <typename Function> inline decltype(auto) protect(Function &&f) {
+    return f();
+  }
 
   inline static std::string print_type() { return class_name; }
 
@@ -138,16 +219,22 @@ struct ParallelExecution {
     omp_nest_lock_t _lock;
   };
 
-  template <typename Tmutex>
-  inline void protect(const std::function<void()> &f, Tmutex &m) {
-    m.lock();
-    f();
-    m.unlock();
+  typedef skdecide::SpinMutex SpinMutex;
+
+  template <typename Tmutex> using LockGuard = std::lock_guard<Tmutex>;
+
+  // Critical section of this policy object (i.e. of the solver owning it),
+  // contrary to unnamed OpenMP critical sections shared by the whole process
+  Mutex _mutex;
+
+  template <typename Function, typename Tmutex>
+  inline decltype(auto) protect(Function &&f, Tmutex &m) {
+    std::lock_guard<Tmutex> lock(m);
+    return f();
   }
 
-  inline void protect(const std::function<void()> &f) {
-#pragma omp critical
-    f();
+  template <typename Function> inline decltype(auto) protect(Function &&f) {
+    return protect(std::forward<Function>(f), _mutex);
   }
 
   inline static std::string print_type() { return class_name; }
@@ -177,13 +264,20 @@ struct SequentialExecution {
     void unlock() {}
   };
 
-  template <typename Tmutex>
-  inline void protect(const std::function<void()> &f,
-                      [[maybe_unused]] Tmutex &m) {
-    f();
+  typedef Mutex SpinMutex;
+
+  template <typename Tmutex> struct LockGuard {
+    LockGuard([[maybe_unused]] Tmutex &m) {}
+  };
+
+  template <typename Function, typename Tmutex>
+  inline decltype(auto) protect(Function &&f, [[maybe_unused]] Tmutex &m) {
+    return f();
   }
 
-  inline void protect(const std::function<void()> &f) { f(); }
+  template <typename Function> inline decltype(auto) protect(Function &&f) {
+    return f();
+  }
 
   inline static std::string print_type() { return class_name; }
 
@@ -210,13 +304,20 @@ struct ParallelExecution {
     void unlock() {}
   };
 
-  template <typename Tmutex>
-  inline void protect(const std::function<void()> &f,
-                      [[maybe_unused]] Tmutex &m) {
-    f();
+  typedef Mutex SpinMutex;
+
+  template <typename Tmutex> struct LockGuard {
+    LockGuard([[maybe_unused]] Tmutex &m) {}
+  };
+
+  template <typename Function, typename Tmutex>
+  inline decltype(auto) protect(Function &&f, [[maybe_unused]] Tmutex &m) {
+    return f();
   }
 
-  inline void protect(const std::function<void()> &f) { f(); }
+  template <typename Function> inline decltype(auto) protect(Function &&f) {
+    return f();
+  }
 
   inline static std::string print_type() { return class_name; }
 
@@ -226,9 +327,130 @@ struct ParallelExecution {
 };
 #endif
 
+/**
+ * @brief Parallel execution policy natively implemented on top of the
+ * process-wide WorkStealingScheduler, independently of the OpenMP or C++-17/TBB
+ * support. Contrary to ParallelExecution under OpenMP, which statically
+ * distributes loop iterations over threads, iterations are dynamically balanced
+ * between threads by work stealing, and parallel loops nested inside parallel
+ * loops spawn subtasks instead of running sequentially. As with TBB, a thread
+ * joining a nested parallel loop executes other pending tasks meanwhile, so
+ * nested parallel loops must not be run while holding a (non-recursive) mutex
+ * that these tasks may also lock.
+ */
+struct WorkStealingExecution {
+  struct Policy {};
+  static constexpr Policy policy = Policy();
+  static constexpr char class_name[] = "parallel (work-stealing)";
+
+  typedef std::mutex Mutex;
+  typedef std::recursive_mutex RecursiveMutex;
+
+  typedef skdecide::SpinMutex SpinMutex;
+
+  template <typename Tmutex> using LockGuard = std::lock_guard<Tmutex>;
+
+  Mutex _mutex;
+
+  template <typename Function, typename Tmutex>
+  inline decltype(auto) protect(Function &&f, Tmutex &m) {
+    std::lock_guard<Tmutex> lock(m);
+    return f();
+  }
+
+  template <typename Function> inline decltype(auto) protect(Function &&f) {
+    return protect(std::forward<Function>(f), _mutex);
+  }
+
+  inline static std::string print_type() { return class_name; }
+
+  inline static std::string print_thread() {
+    std::ostringstream s;
+    s << " [thread " << std::this_thread::get_id() << "]";
+    return s.str();
+  }
+
+  template <typename T> using atomic = std::atomic<T>;
+
+  inline static WorkStealingScheduler &scheduler() {
+    return WorkStealingScheduler::instance();
+  }
+};
+
+/**
+ * @brief True if the execution policy really runs code concurrently, i.e. if
+ * its atomic types are std::atomic: ParallelExecution falls back to sequential
+ * execution, with plain atomic types, when neither C++-17 parallel algorithms
+ * nor OpenMP are available
+ */
+template <typename Texecution_policy>
+struct is_concurrent_execution
+    : std::is_same<typename Texecution_policy::template atomic<int>,
+                   std::atomic<int>> {};
+
+/**
+ * @brief Adds a sample to a running mean and increments its samples count.
+ * The plain overload is used by the sequential execution policy, whose atomic
+ * types are the underlying types, and computes exactly
+ * mean = (count * mean + sample) / (count + 1).
+ */
+template <typename Tcount, typename Tmean>
+inline void update_running_mean(Tcount &count, Tmean &mean,
+                                const double &sample) {
+  mean = ((count * mean) + sample) / ((double)(count + 1));
+  count += 1;
+}
+
+/**
+ * @brief Lock-free overload of update_running_mean for the parallel execution
+ * policies: the count is reserved with a fetch-and-add and the mean is updated
+ * incrementally with a compare-and-swap loop, so that concurrent updates of
+ * the same statistics never wait for a lock. Concurrent samples may be folded
+ * in a different order than their counts were reserved, which only perturbs
+ * the weights of the samples by a few counts.
+ */
+template <typename Tcount>
+inline void update_running_mean(std::atomic<Tcount> &count,
+                                std::atomic<double> &mean,
+                                const double &sample) {
+  double n = (double)(count.fetch_add(1) + 1);
+  double m = mean.load();
+  while (!mean.compare_exchange_weak(m, m + ((sample - m) / n))) {
+  }
+}
+
+/** @brief Adds y to x, with a compare-and-swap loop if x is atomic */
+template <typename T> inline void atomic_add(T &x, const double &y) { x += y; }
+
+inline void atomic_add(std::atomic<double> &x, const double &y) {
+  double v = x.load();
+  while (!x.compare_exchange_weak(v, v + y)) {
+  }
+}
+
+/** @brief Sets x to max(x, y), with a compare-and-swap loop if x is atomic */
+template <typename T> inline void atomic_max(T &x, const double &y) {
+  if (y > x) {
+    x = y;
+  }
+}
+
+inline void atomic_max(std::atomic<double> &x, const double &y) {
+  double v = x.load();
+  while (y > v && !x.compare_exchange_weak(v, y)) {
+  }
+}
+
 } // namespace skdecide
 
 namespace std {
+// parallel std::for_each using the work-stealing scheduler
+template <typename ForwardIt, typename UnaryFunction2>
+void for_each(const skdecide::WorkStealingExecution::Policy &policy,
+              ForwardIt first, ForwardIt last, UnaryFunction2 f) {
+  skdecide::WorkStealingExecution::scheduler().parallel_for(first, last, f);
+}
+
 #if !defined(HAS_EXECUTION)
 template <typename ExecutionPolicy, typename ForwardIt, typename UnaryFunction2>
 void for_each(ExecutionPolicy &&policy, ForwardIt first, ForwardIt last,
@@ -0,0 +1,334 @@
+/* Copyright (c) AIRBUS and its affiliates.
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#ifndef SKDECIDE_GRAPH_COMPACTOR_HH
+#define SKDECIDE_GRAPH_COMPACTOR_HH
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "utils/execution.hh"
+
+namespace skdecide {
+
+/**
+ * @brief Incremental reclamation of the search graph nodes which are no more
+ * reachable from the root solving state once the solver's root moved, meant
+ * to replace the online node garbage collection which computed the subgraphs
+ * reachable from the old and new roots before returning the best action.
+ * Moving the root now only increments the root epoch; a compaction then stamps
+ * the nodes reachable from the new root with the new epoch (mark), collects
+ * the nodes reachable from the old root which are not stamped (collect), and
+ * erases the collected nodes which are still not stamped (erase). With
+ * parallel execution policies the compaction runs on a background thread while
+ * the next search runs, and with the sequential policy it runs by bounded
+ * steps that the solver interleaves with its rollouts.
+ *
+ * The search threads must call retain() on each node they get from the graph
+ * by inserting or finding a state (write barrier): a node which was collected
+ * but is reached again by the search is then stamped with its stale
+ * descendants and kept. The mark and collect traversals run concurrently with
+ * the search, but the collected nodes are erased at once while no search
+ * thread holds a Guard (taken by the solver for each rollout and each query of
+ * the graph) since a collected node reached again after some of its
+ * descendants were erased would keep dangling edges. The graph nodes must
+ * define an 'epoch' member of type Texecution_policy::atomic<std::size_t>
+ * initialized to 0.
+ *
+ * @tparam Texecution_policy Execution policy of the solver
+ * @tparam Tnode Type of the graph nodes
+ */
+template <typename Texecution_policy, typename Tnode> class GraphCompactor {
+public:
+  // Appends the children of a node to the given vector, locking the node if
+  // its children can be concurrently modified by the search threads
+  typedef std::function<void(Tnode &, std::vector<Tnode *> &)> ChildrenFunctor;
+  // Erases a node from the graph; the predicate indicates whether a child of
+  // the node has not been erased yet (e.g. to remove the node from the
+  // parents of its remaining children)
+  typedef std::function<void(Tnode &, const std::function<bool(Tnode *)> &)>
+      EraseFunctor;
+
+  GraphCompactor(const ChildrenFunctor &children, const EraseFunctor &erase,
+                 std::size_t step_budget = 1000)
+      : _children(children), _erase(erase), _step_budget(step_budget),
+        _epoch(0), _active(false), _cancel(false),
+        _phase(Phase::Idle), _readers(0), _writer(false), _waiting_writers(0) {}
+
+  GraphCompactor(const GraphCompactor &) = delete;
+  GraphCompactor &operator=(const GraphCompactor &) = delete;
+
+  ~GraphCompactor() { cancel(); }
+
+  /** Shared access to the graph nodes, preventing the compactor to erase
+   * nodes meanwhile (no-op when no compaction is active) */
+  class Guard {
+  public:
+    Guard(GraphCompactor *compactor) : _compactor(compactor) {
+      if (_compactor != nullptr) {
+        _compactor->lock_shared();
+      }
+    }
+    Guard(const Guard &) = delete;
+    Guard(Guard &&other) noexcept : _compactor(other._compactor) {
+      other._compactor = nullptr;
+    }
+    ~Guard() {
+      if (_compactor != nullptr) {
+        _compactor->unlock_shared();
+      }
+    }
+
+  private:
+    GraphCompactor *_compactor;
+  };
+
+  Guard guard() {
+    if constexpr (is_sequential) {
+      return Guard(nullptr);
+    } else {
+      return Guard(_active ? this : nullptr);
+    }
+  }
+
+  std::size_t epoch() const { return _epoch; }
+
+  bool active() const { return _active; }
+
+  /** Write barrier: stamps the node and its stale descendants with the
+   * current epoch */
+  void retain(Tnode &node) {
+    if (!stamp(node)) {
+      return;
+    }
+    std::vector<Tnode *> stack{&node};
+    std::vector<Tnode *> children;
+    while (!stack.empty()) {
+      Tnode *n = stack.back();
+      stack.pop_back();
+      children.clear();
+      _children(*n, children);
+      for (auto &c : children) {
+        if (stamp(*c)) {
+          stack.push_back(c);
+        }
+      }
+    }
+  }
+
+  /** Moves the root from old_root (nullptr if none) to new_root and starts
+   * reclaiming the nodes which are no more reachable; must not be called while
+   * a search is running (a previous compaction still running is completed
+   * first) */
+  void retire(Tnode *old_root, Tnode &new_root) {
+    finish();
+    _epoch = _epoch + 1;
+    _phase = Phase::Mark;
+    _old_root = old_root;
+    _stack.clear();
+    _candidates.clear();
+    stamp(new_root);
+    _stack.push_back(&new_root);
+    _active = true;
+    if constexpr (!is_sequential) {
+      _cancel = false;
+      _thread = std::thread([this]() {
+        while (!_cancel && run(_step_budget)) {
+        }
+        _active = false;
+      });
+    }
+  }
+
+  /** Runs a bounded compaction step with the sequential execution policy
+   * (no-op with parallel policies whose compaction runs in the background) */
+  void step() {
+    if constexpr (is_sequential) {
+      if (_active) {
+        _active = run(_step_budget);
+      }
+    }
+  }
+
+  /** Completes the active compaction */
+  void finish() {
+    if constexpr (is_sequential) {
+      while (_active) {
+        _active = run(_step_budget);
+      }
+    } else {
+      if (_thread.joinable()) {
+        _thread.join();
+      }
+    }
+  }
+
+  /** Abandons the active compaction (e.g. before clearing the graph) */
+  void cancel() {
+    if constexpr (!is_sequential) {
+      _cancel = true;
+      if (_thread.joinable()) {
+        _thread.join();
+      }
+    }
+    _active = false;
+    _phase = Phase::Idle;
+    _stack.clear();
+    _candidates.clear();
+  }
+
+private:
+  // ParallelExecution without OpenMP nor C++-17 parallelism support runs
+  // sequentially with plain atomic types, hence like SequentialExecution
+  static constexpr bool is_sequential =
+      !is_concurrent_execution<Texecution_policy>::value;
+
+  enum class Phase { Idle, Mark, Collect, Erase };
+
+  ChildrenFunctor _children;
+  EraseFunctor _erase;
+  std::size_t _step_budget; // number of nodes traversed by step()
+  typename Texecution_policy::template atomic<std::size_t> _epoch;
+  typename Texecution_policy::template atomic<bool> _active;
+  std::atomic<bool> _cancel;
+  std::thread _thread;
+
+  // State of the active compaction, only accessed by the compactor
+  Phase _phase;
+  Tnode *_old_root;
+  std::vector<Tnode *> _stack;
+  std::unordered_map<Tnode *, bool> _candidates; // mapped to erased flag
+
+  // Writer-preferring gate between the guards and the erasures, so that the
+  // erasures are not starved by the continuously overlapping rollouts
+  std::mutex _gate_mutex;
+  std::condition_variable _gate;
+  std::size_t _readers;
+  bool _writer;
+  std::size_t _waiting_writers;
+
+  // Returns true if the node was stale
+  bool stamp(Tnode &node) {
+    std::size_t e = _epoch;
+    if constexpr (is_sequential) {
+      if (node.epoch == e) {
+        return false;
+      }
+      node.epoch = e;
+      return true;
+    } else {
+      if (node.epoch.load() == e) {
+        return false;
+      }
+      return node.epoch.exchange(e) != e;
+    }
+  }
+
+  // Runs at most budget units of work and returns false once completed
+  bool run(std::size_t budget) {
+    std::vector<Tnode *> children;
+    while (budget > 0) {
+      switch (_phase) {
+      case Phase::Mark:
+        if (_stack.empty()) {
+          _phase = Phase::Collect;
+          if (_old_root != nullptr && _old_root->epoch != _epoch) {
+            _candidates.emplace(_old_root, false);
+            _stack.push_back(_old_root);
+          }
+        } else {
+          Tnode *n = _stack.back();
+          _stack.pop_back();
+          children.clear();
+          _children(*n, children);
+          for (auto &c : children) {
+            if (stamp(*c)) {
+              _stack.push_back(c);
+            }
+          }
+          budget--;
+        }
+        break;
+      case Phase::Collect:
+        if (_stack.empty()) {
+          _phase = Phase::Erase;
+        } else {
+          Tnode *n = _stack.back();
+          _stack.pop_back();
+          children.clear();
+          _children(*n, children);
+          for (auto &c : children) {
+            if (c->epoch != _epoch && _candidates.emplace(c, false).second) {
+              _stack.push_back(c);
+            }
+          }
+          budget--;
+        }
+        break;
+      case Phase::Erase: {
+        lock();
+        auto alive = [this](Tnode *n) {
+          auto i = _candidates.find(n);
+          return (i == _candidates.end()) || !(i->second);
+        };
+        for (auto &c : _candidates) {
+          if (c.first->epoch != _epoch) { // not reached again by the search
+            _erase(*(c.first), alive);
+            c.second = true;
+          }
+        }
+        unlock();
+        _candidates.clear();
+        _phase = Phase::Idle;
+        budget = 0;
+        break;
+      }
+      case Phase::Idle:
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void lock_shared() {
+    std::unique_lock<std::mutex> lock(_gate_mutex);
+    _gate.wait(lock, [this]() { return !_writer && _waiting_writers == 0; });
+    _readers++;
+  }
+
+  void unlock_shared() {
+    std::lock_guard<std::mutex> lock(_gate_mutex);
+    if (--_readers == 0) {
+      _gate.notify_all();
+    }
+  }
+
+  void lock() {
+    if constexpr (!is_sequential) {
+      std::unique_lock<std::mutex> lock(_gate_mutex);
+      _waiting_writers++;
+      _gate.wait(lock, [this]() { return !_writer && _readers == 0; });
+      _waiting_writers--;
+      _writer = true;
+    }
+  }
+
+  void unlock() {
+    if constexpr (!is_sequential) {
+      std::lock_guard<std::mutex> lock(_gate_mutex);
+      _writer = false;
+      _gate.notify_all();
+    }
+  }
+};
+
+} // namespace skdecide
+
+#endif // SKDECIDE_GRAPH_COMPACTOR_HH
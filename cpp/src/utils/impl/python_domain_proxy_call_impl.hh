@@ -8,9 +8,11 @@
 #include <nngpp/nngpp.h>
 #include <nngpp/protocol/pull0.h>
 
+#include "utils/batched_domain_calls.hh"
 #include "utils/python_gil_control.hh"
 #include "utils/python_globals.hh"
 #include "utils/execution.hh"
+#include "utils/shm_notification_ring.hh"
 #include "utils/logging.hh"
 
 namespace skdecide {
@@ -77,6 +79,48 @@ struct PythonDomainProxy<Texecution, Tagent, Tobservability, Tcontrollability,
       throw err;
     }
   }
+
+  template <typename Targ, typename... Targs>
+  std::vector<std::unique_ptr<py::object>>
+  call_batch(const char *name, const std::vector<const Targ *> &arg,
+             const std::vector<const Targs *> &...args) {
+    try {
+      std::vector<std::unique_ptr<py::object>> results;
+      results.reserve(arg.size());
+      std::string batch_name = std::string(name) + "_batch";
+      if (py::hasattr(*_domain, batch_name.c_str())) {
+        auto to_list = [](const auto &v) {
+          py::list l;
+          for (const auto &o : v) {
+            l.append(o->pyobj());
+          }
+          return l;
+        };
+        py::object r =
+            _domain->attr(batch_name.c_str())(to_list(arg), to_list(args)...);
+        for (auto o : r) {
+          results.push_back(std::make_unique<py::object>(
+              py::reinterpret_borrow<py::object>(o)));
+        }
+        if (results.size() != arg.size()) {
+          throw std::runtime_error("SKDECIDE exception: python domain's " +
+                                   batch_name + "() method must return as "
+                                                "many results as queries");
+        }
+      } else {
+        py::object method = _domain->attr(name);
+        for (std::size_t i = 0; i < arg.size(); i++) {
+          results.push_back(std::make_unique<py::object>(
+              method(arg[i]->pyobj(), args[i]->pyobj()...)));
+        }
+      }
+      return results;
+    } catch (const py::error_already_set *e) {
+      std::runtime_error err(e->what());
+      delete e;
+      throw err;
+    }
+  }
 };
 
 // === PythonDomainProxy::Implementation<ParallelExecution> implementation ===
@@ -91,7 +135,10 @@ struct PythonDomainProxy<Texecution, Tagent, Tobservability, Tcontrollability,
                        TexecutionPolicy, ParallelExecution>::value>::type> {
 
   std::unique_ptr<py::object> _domain;
+  // Connection i is either an nng pipeline socket or, if the python parallel
+  // domain uses the shared memory IPC transport, a notification ring
   std::vector<std::unique_ptr<nng::socket>> _connections;
+  std::vector<std::unique_ptr<ShmNotificationRing>> _shm_connections;
 
   Implementation(const py::object &domain);
   ~Implementation();
@@ -136,6 +183,7 @@ struct PythonDomainProxy<Texecution, Tagent, Tobservability, Tcontrollability,
                                         const Types &...args) {
     std::unique_ptr<py::object> id;
     nng::socket *conn = nullptr;
+    ShmNotificationRing *shm_conn = nullptr;
     {
       typename GilControl<Texecution>::Acquire acquire;
       try {
@@ -149,6 +197,7 @@ struct PythonDomainProxy<Texecution, Tagent, Tobservability, Tcontrollability,
         int did = py::cast<int>(*id);
         if (did >= 0) {
           conn = _connections[(std::size_t)did].get();
+          shm_conn = _shm_connections[(std::size_t)did].get();
         }
       } catch (const py::error_already_set *e) {
         Logger::error("SKDECIDE exception when asynchronously calling "
@@ -160,19 +209,25 @@ struct PythonDomainProxy<Texecution, Tagent, Tobservability, Tcontrollability,
         throw err;
       }
     }
-    if (conn) { // positive id returned (parallel execution, waiting for python
-                // process to return)
+    if (conn || shm_conn) { // positive id returned (parallel execution,
+                            // waiting for python process to return)
       try {
-        nng::msg msg = conn->recv_msg();
-        if (msg.body().size() != 1 ||
-            msg.body().data<char>()[0] != '0') { // error
+        std::string status = [&conn, &shm_conn]() {
+          // never hold the GIL while the python processes work
+          typename GilControl<Texecution>::Yield yield;
+          if (shm_conn) {
+            return shm_conn->recv();
+          }
+          nng::msg msg = conn->recv_msg();
+          return std::string(msg.body().data<char>(), msg.body().size());
+        }();
+        if (status != "0") { // error
           typename GilControl<Texecution>::Acquire acquire;
           id.reset();
-          std::string pyerr(msg.body().data<char>(), msg.body().size());
           throw std::runtime_error(
               "SKDECIDE exception: C++ parallel domain received an exception "
               "from Python parallel domain: " +
-              pyerr);
+              status);
         }
       } catch (const nng::exception &e) {
         std::string err_msg("SKDECIDE exception when waiting for a response "
@@ -226,6 +281,22 @@ struct PythonDomainProxy<Texecution, Tagent, Tobservability, Tcontrollability,
     return do_launch(thread_id, func, args...);
   }
 
+  // Dispatching each query to the first available process of the python
+  // parallel domain is faster than sending the whole batch to a single one
+  template <typename Targ, typename... Targs>
+  std::vector<std::unique_ptr<py::object>>
+  call_batch(const char *name, const std::vector<const Targ *> &arg,
+             const std::vector<const Targs *> &...args) {
+    std::vector<std::unique_ptr<py::object>> results(arg.size());
+    for_each_index<ParallelExecution>(
+        arg.size(), [this, &results, &name, &arg, &args...](
+                        const std::size_t &i) {
+          results[i] =
+              launch(nullptr, name, arg[i]->pyobj(), args[i]->pyobj()...);
+        });
+    return results;
+  }
+
   struct NonTemplateMethods;
 };
 
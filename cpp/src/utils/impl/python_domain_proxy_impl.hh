@@ -1340,9 +1340,17 @@ SK_PY_DOMAIN_PROXY_PAR_IMPL_CLASS::Implementation(const py::object &domain) {
     try {
       py::list ipc_connections = _domain->attr("get_ipc_connections")();
       for (auto f : ipc_connections) {
-        _connections.push_back(
-            std::make_unique<nng::socket>(nng::pull::open()));
-        _connections.back()->listen(std::string(py::str(f)).c_str());
+        std::string address = py::str(f);
+        if (ShmNotificationRing::is_address(address)) {
+          _connections.push_back(nullptr);
+          _shm_connections.push_back(
+              std::make_unique<ShmNotificationRing>(address));
+        } else {
+          _connections.push_back(
+              std::make_unique<nng::socket>(nng::pull::open()));
+          _connections.back()->listen(address.c_str());
+          _shm_connections.push_back(nullptr);
+        }
       }
     } catch (const nng::exception &e) {
       std::string err_msg("SKDECIDE exception when trying to make pipeline "
@@ -1364,6 +1372,7 @@ SK_PY_DOMAIN_PROXY_PAR_IMPL_TEMPLATE_DECL
 void SK_PY_DOMAIN_PROXY_PAR_IMPL_CLASS::close() {
   try {
     _connections.clear();
+    _shm_connections.clear();
   } catch (const nng::exception &e) {
     std::string err_msg("SKDECIDE exception when trying to close pipeline "
                         "connections with the python parallel domain: ");
@@ -1688,6 +1697,117 @@ bool SK_PY_DOMAIN_PROXY_CLASS::is_terminal(const State &s,
   }
 }
 
+SK_PY_DOMAIN_PROXY_TEMPLATE_DECL
+std::vector<typename SK_PY_DOMAIN_PROXY_CLASS::ApplicableActionSpace>
+SK_PY_DOMAIN_PROXY_CLASS::get_applicable_actions_batch(
+    const std::vector<const Memory *> &memories) {
+  try {
+    auto r = _implementation->call_batch("get_applicable_actions", memories);
+    typename GilControl<Texecution>::Acquire acquire;
+    std::vector<ApplicableActionSpace> results;
+    results.reserve(r.size());
+    for (auto &o : r) {
+      results.emplace_back(std::move(o));
+    }
+    return results;
+  } catch (const std::exception &e) {
+    Logger::error(std::string("SKDECIDE exception when getting applicable "
+                              "actions of a batch of ") +
+                  Memory::AgentData::class_name + "s: " +
+                  std::string(e.what()));
+    throw;
+  }
+}
+
+SK_PY_DOMAIN_PROXY_TEMPLATE_DECL
+std::vector<typename SK_PY_DOMAIN_PROXY_CLASS::NextStateDistribution>
+SK_PY_DOMAIN_PROXY_CLASS::get_next_state_distribution_batch(
+    const std::vector<const Memory *> &memories,
+    const std::vector<const Event *> &events) {
+  try {
+    auto r = _implementation->call_batch("get_next_state_distribution",
+                                         memories, events);
+    typename GilControl<Texecution>::Acquire acquire;
+    std::vector<NextStateDistribution> results;
+    results.reserve(r.size());
+    for (auto &o : r) {
+      results.emplace_back(std::move(o));
+    }
+    return results;
+  } catch (const std::exception &e) {
+    Logger::error(std::string("SKDECIDE exception when getting next state "
+                              "distributions of a batch of transitions: ") +
+                  std::string(e.what()));
+    throw;
+  }
+}
+
+SK_PY_DOMAIN_PROXY_TEMPLATE_DECL
+std::vector<typename SK_PY_DOMAIN_PROXY_CLASS::Value>
+SK_PY_DOMAIN_PROXY_CLASS::get_transition_value_batch(
+    const std::vector<const Memory *> &memories,
+    const std::vector<const Event *> &events,
+    const std::vector<const State *> &next_states) {
+  try {
+    auto r = _implementation->call_batch("get_transition_value", memories,
+                                         events, next_states);
+    typename GilControl<Texecution>::Acquire acquire;
+    std::vector<Value> results;
+    results.reserve(r.size());
+    for (auto &o : r) {
+      results.emplace_back(std::move(o));
+    }
+    return results;
+  } catch (const std::exception &e) {
+    Logger::error(std::string("SKDECIDE exception when getting values of a "
+                              "batch of transitions: ") +
+                  std::string(e.what()));
+    throw;
+  }
+}
+
+SK_PY_DOMAIN_PROXY_TEMPLATE_DECL
+std::vector<bool> SK_PY_DOMAIN_PROXY_CLASS::is_goal_batch(
+    const std::vector<const State *> &states) {
+  try {
+    auto r = _implementation->call_batch("is_goal", states);
+    typename GilControl<Texecution>::Acquire acquire;
+    std::vector<bool> results;
+    results.reserve(r.size());
+    for (auto &o : r) {
+      results.push_back(py::cast<bool>(*o));
+      o.reset();
+    }
+    return results;
+  } catch (const std::exception &e) {
+    Logger::error(std::string("SKDECIDE exception when testing goal condition "
+                              "of a batch of states: ") +
+                  std::string(e.what()));
+    throw;
+  }
+}
+
+SK_PY_DOMAIN_PROXY_TEMPLATE_DECL
+std::vector<bool> SK_PY_DOMAIN_PROXY_CLASS::is_terminal_batch(
+    const std::vector<const State *> &states) {
+  try {
+    auto r = _implementation->call_batch("is_terminal", states);
+    typename GilControl<Texecution>::Acquire acquire;
+    std::vector<bool> results;
+    results.reserve(r.size());
+    for (auto &o : r) {
+      results.push_back(py::cast<bool>(*o));
+      o.reset();
+    }
+    return results;
+  } catch (const std::exception &e) {
+    Logger::error(std::string("SKDECIDE exception when testing terminal "
+                              "condition of a batch of states: ") +
+                  std::string(e.what()));
+    throw;
+  }
+}
+
 } // namespace skdecide
 
 #endif // SKDECIDE_PYTHON_DOMAIN_PROXY_IMPL_HH
@@ -0,0 +1,324 @@
+/* Copyright (c) AIRBUS and its affiliates.
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#ifndef SKDECIDE_NODE_ARENA_HH
+#define SKDECIDE_NODE_ARENA_HH
+
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
+#include "utils/execution.hh"
+
+namespace skdecide {
+
+/**
+ * @brief Slab allocator of objects of type T, meant to replace the individual
+ * heap allocations of the search graph nodes (action nodes created with
+ * std::make_unique, state nodes allocated by the graph's node-based set) which
+ * fragment the heap and make clearing large graphs slow. Objects are carved
+ * from chunks of growing size (bump allocation) and freed objects are recycled
+ * through a free list; the chunks are only returned to the system all at once
+ * by release() (or when the arena is destroyed).
+ *
+ * With parallel execution policies, each rollout lane (identified by the
+ * thread_id passed to the solver's functions) allocates from its own cache
+ * (free list and current chunk) without any synchronization, and refills it
+ * from the shared free list or with a new chunk under a spin lock. Objects
+ * are freed to the shared free list, or allocated from it when no thread_id
+ * is given.
+ *
+ * @tparam T Type of the objects
+ * @tparam Texecution_policy Execution policy of the threads allocating objects
+ */
+template <typename T, typename Texecution_policy = SequentialExecution>
+class NodeArena {
+public:
+  struct Deleter {
+    NodeArena *arena;
+    void operator()(T *p) const { arena->destroy(p); }
+  };
+
+  // Owning pointer to an object of the arena
+  typedef std::unique_ptr<T, Deleter> Pointer;
+
+  NodeArena(std::size_t nb_lanes = 1)
+      : _lanes(std::max<std::size_t>(1, nb_lanes)), _free(nullptr),
+        _nb_allocated(0), _nb_deallocated(0), _chunk_size(min_chunk_size),
+        _memory(0) {}
+
+  NodeArena(const NodeArena &) = delete;
+  NodeArena &operator=(const NodeArena &) = delete;
+
+  // Allocates the storage of an object
+  T *allocate(const std::size_t *thread_id = nullptr) {
+    Slot *s = nullptr;
+    if (is_sequential || thread_id != nullptr) {
+      Lane &lane = _lanes[is_sequential ? 0 : (*thread_id) % _lanes.size()];
+      if (lane.free == nullptr && lane.next == lane.end) {
+        refill(lane);
+      }
+      if (lane.free != nullptr) {
+        s = lane.free;
+        lane.free = s->next;
+      } else {
+        s = lane.next++;
+      }
+      lane.nb_allocated++;
+    } else {
+      typename Texecution_policy::template LockGuard<
+          typename Texecution_policy::SpinMutex>
+          lock(_mutex);
+      if (_free == nullptr) {
+        std::size_t sz = _chunk_size;
+        Slot *chunk = new_chunk();
+        for (std::size_t i = 0; i < sz; i++) {
+          chunk[i].next = (i + 1 < sz) ? &chunk[i + 1] : nullptr;
+        }
+        _free = chunk;
+      }
+      s = _free;
+      _free = s->next;
+      _nb_allocated++;
+    }
+    return reinterpret_cast<T *>(s);
+  }
+
+  // Returns the storage of an object to the arena
+  void deallocate(T *p) {
+    Slot *s = reinterpret_cast<Slot *>(p);
+    typename Texecution_policy::template LockGuard<
+        typename Texecution_policy::SpinMutex>
+        lock(_mutex);
+    s->next = _free;
+    _free = s;
+    _nb_deallocated++;
+  }
+
+  template <typename... Args>
+  T *create(const std::size_t *thread_id, Args &&...args) {
+    T *p = allocate(thread_id);
+    try {
+      return new (p) T(std::forward<Args>(args)...);
+    } catch (...) {
+      deallocate(p);
+      throw;
+    }
+  }
+
+  void destroy(T *p) {
+    p->~T();
+    deallocate(p);
+  }
+
+  template <typename... Args>
+  Pointer make(const std::size_t *thread_id, Args &&...args) {
+    return Pointer(create(thread_id, std::forward<Args>(args)...),
+                   Deleter{this});
+  }
+
+  // Number of allocated objects (not to be called concurrently with
+  // allocations)
+  std::size_t size() const {
+    std::size_t sz = _nb_allocated;
+    for (const auto &lane : _lanes) {
+      sz += lane.nb_allocated;
+    }
+    return sz - _nb_deallocated;
+  }
+
+  bool empty() const { return size() == 0; }
+
+  // Number of bytes reserved by the arena
+  std::size_t memory_usage() const { return _memory; }
+
+  // Returns all the chunks to the system if no object is allocated (not to be
+  // called concurrently with allocations)
+  bool release() {
+    if (size() != 0) {
+      return false;
+    }
+    _chunks.clear();
+    for (auto &lane : _lanes) {
+      lane = Lane();
+    }
+    _free = nullptr;
+    _nb_allocated = 0;
+    _nb_deallocated = 0;
+    _chunk_size = min_chunk_size;
+    _memory = 0;
+    return true;
+  }
+
+private:
+  static constexpr bool is_sequential =
+      std::is_same<Texecution_policy, SequentialExecution>::value;
+  static constexpr std::size_t min_chunk_size = 64;
+  static constexpr std::size_t max_chunk_size = 4096;
+  static constexpr std::size_t refill_size = 64;
+
+  union Slot {
+    Slot *next;
+    alignas(T) unsigned char storage[sizeof(T)];
+  };
+
+  // Lanes are aligned on cache lines to avoid false sharing between threads
+  struct alignas(64) Lane {
+    Slot *free = nullptr;
+    Slot *next = nullptr; // bump pointer in the lane's current chunk
+    Slot *end = nullptr;
+    std::size_t nb_allocated = 0;
+  };
+
+  std::vector<Lane> _lanes;
+  std::vector<std::unique_ptr<Slot[]>> _chunks;
+  Slot *_free; // shared free list
+  std::size_t _nb_allocated;
+  std::size_t _nb_deallocated;
+  std::size_t _chunk_size;
+  std::size_t _memory;
+  typename Texecution_policy::SpinMutex _mutex;
+
+  Slot *new_chunk() {
+    _chunks.push_back(std::make_unique<Slot[]>(_chunk_size));
+    _memory += _chunk_size * sizeof(Slot);
+    Slot *chunk = _chunks.back().get();
+    _chunk_size = std::min(2 * _chunk_size, max_chunk_size);
+    return chunk;
+  }
+
+  // Moves up to refill_size slots from the shared free list to the lane, or
+  // gives the lane a new chunk if the shared free list is empty
+  void refill(Lane &lane) {
+    typename Texecution_policy::template LockGuard<
+        typename Texecution_policy::SpinMutex>
+        lock(_mutex);
+    if (_free != nullptr) {
+      Slot *last = _free;
+      for (std::size_t i = 1; i < refill_size && last->next != nullptr; i++) {
+        last = last->next;
+      }
+      lane.free = _free;
+      _free = last->next;
+      last->next = nullptr;
+    } else {
+      std::size_t sz = _chunk_size;
+      lane.next = new_chunk();
+      lane.end = lane.next + sz;
+    }
+  }
+};
+
+// Arenas shared by the rebound copies of a NodeArenaAllocator, one per type of
+// the single objects allocated by the container
+struct NodeArenaPool {
+  struct Entry {
+    std::type_index type;
+    std::shared_ptr<void> arena;
+    std::size_t (*memory_usage)(const void *arena);
+  };
+
+  std::vector<Entry> arenas;
+};
+
+/**
+ * @brief Allocator of node-based standard containers (e.g. the search graphs
+ * deduced by SetTypeDeducer) allocating their single objects from NodeArenas
+ * owned by the container, one per type of object, while arrays (e.g. hash
+ * buckets) go to the standard allocator. The nodes thus come from their own
+ * arena whatever the other single objects allocated by the container (e.g.
+ * the container proxy of MSVC debug builds). Since a container serializes its
+ * own allocations, the arenas are not synchronized. The chunks of an arena
+ * are released once all its objects are freed (e.g. by clear()).
+ *
+ * @tparam T Type of the elements of the container
+ */
+template <typename T> class NodeArenaAllocator {
+public:
+  typedef T value_type;
+  typedef std::false_type propagate_on_container_copy_assignment;
+  typedef std::true_type propagate_on_container_move_assignment;
+  typedef std::true_type propagate_on_container_swap;
+
+  NodeArenaAllocator()
+      : _pool(std::make_shared<NodeArenaPool>()), _arena(nullptr) {}
+
+  // Copies of a container get their own arenas
+  NodeArenaAllocator select_on_container_copy_construction() const {
+    return NodeArenaAllocator();
+  }
+
+  template <typename U>
+  NodeArenaAllocator(const NodeArenaAllocator<U> &other)
+      : _pool(other._pool), _arena(nullptr) {}
+
+  T *allocate(std::size_t n) {
+    if (n == 1) {
+      return arena().allocate();
+    }
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T *p, std::size_t n) {
+    if (n == 1) {
+      NodeArena<T> &a = arena();
+      a.deallocate(p);
+      if (a.empty()) {
+        a.release();
+      }
+    } else {
+      std::allocator<T>().deallocate(p, n);
+    }
+  }
+
+  // Number of bytes reserved by the arenas of the container
+  std::size_t memory_usage() const {
+    std::size_t memory = 0;
+    for (const auto &e : _pool->arenas) {
+      memory += e.memory_usage(e.arena.get());
+    }
+    return memory;
+  }
+
+  template <typename U>
+  bool operator==(const NodeArenaAllocator<U> &other) const {
+    return _pool == other._pool;
+  }
+
+  template <typename U>
+  bool operator!=(const NodeArenaAllocator<U> &other) const {
+    return _pool != other._pool;
+  }
+
+private:
+  template <typename U> friend class NodeArenaAllocator;
+
+  std::shared_ptr<NodeArenaPool> _pool;
+  NodeArena<T> *_arena; // arena of T in the pool, looked up on first use
+
+  NodeArena<T> &arena() {
+    if (_arena == nullptr) {
+      for (const auto &e : _pool->arenas) {
+        if (e.type == typeid(T)) {
+          _arena = static_cast<NodeArena<T> *>(e.arena.get());
+          return *_arena;
+        }
+      }
+      auto arena = std::make_shared<NodeArena<T>>();
+      _arena = arena.get();
+      _pool->arenas.push_back(
+          {typeid(T), std::move(arena), [](const void *a) {
+             return static_cast<const NodeArena<T> *>(a)->memory_usage();
+           }});
+    }
+    return *_arena;
+  }
+};
+
+} // namespace skdecide
+
+#endif // SKDECIDE_NODE_ARENA_HH
@@ -0,0 +1,181 @@
+/* Copyright (c) AIRBUS and its affiliates.
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#ifndef SKDECIDE_OBSERVATION_TRANSITION_TENSORS_HH
+#define SKDECIDE_OBSERVATION_TRANSITION_TENSORS_HH
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "utils/belief_vector.hh"
+#include "utils/execution.hh"
+
+namespace skdecide {
+
+/**
+ * @brief Compiled transition and observation model of an enumerated POMDP:
+ * for each action a and each observation o of a, the sparse matrix
+ * M_{a,o} = T_a diag(O_{a,o}) in CSR layout, i.e. the rows are indexed by the
+ * origin state s and M_{a,o}(s, s') = T(s' | s, a) O(o | s', a). The update of
+ * a belief after (a, o) is then the sparse product b M_{a,o} normalized by its
+ * mass, which is the probability of o, and the backup of an alpha-vector
+ * through (a, o) is the sparse product M_{a,o} alpha, so that neither of them
+ * looks up observation probabilities in hash tables.
+ */
+class ObservationTransitionTensors {
+public:
+  // Successor states and probabilities of the origin states, indexed by
+  // origin state then by action
+  typedef std::vector<std::vector<std::vector<std::pair<double, std::size_t>>>>
+      Transitions;
+
+  void clear() {
+    _nb_states = 0;
+    _matrices.clear();
+    _obs_hashes.clear();
+    _obs_hash_to_idx.clear();
+  }
+
+  /** Builds the matrices from the transitions and the observation
+   * distributions, which are indexed by successor state then by action and
+   * iterate on pairs (observation hash, probability). The observations of
+   * each action are indexed in the order of action_obs_hashes. Actions are
+   * processed in parallel according to the execution policy. */
+  template <typename Texecution_policy, typename Tobservations>
+  void build(const Transitions &transitions,
+             const std::vector<std::vector<Tobservations>> &observations,
+             const std::vector<std::vector<std::size_t>> &action_obs_hashes) {
+    std::size_t na = action_obs_hashes.size();
+    _nb_states = transitions.size();
+    _obs_hashes = action_obs_hashes;
+    _matrices.assign(na, std::vector<Matrix>());
+    _obs_hash_to_idx.assign(na, std::unordered_map<std::size_t, std::size_t>());
+
+    std::vector<std::size_t> action_indices(na);
+    std::iota(action_indices.begin(), action_indices.end(), 0);
+    std::for_each(
+        Texecution_policy::policy, action_indices.begin(), action_indices.end(),
+        [this, &transitions, &observations](const std::size_t &ai) {
+          std::size_t no = _obs_hashes[ai].size();
+          for (std::size_t o = 0; o < no; o++) {
+            _obs_hash_to_idx[ai][_obs_hashes[ai][o]] = o;
+          }
+          std::vector<Matrix> &matrices = _matrices[ai];
+          matrices.resize(no);
+          for (Matrix &m : matrices) {
+            m.start.reserve(_nb_states + 1);
+            m.start.push_back(0);
+          }
+          for (std::size_t si = 0; si < _nb_states; si++) {
+            for (const auto &tr : transitions[si][ai]) {
+              for (const auto &op : observations[tr.second][ai]) {
+                double p = tr.first * op.second;
+                auto it = _obs_hash_to_idx[ai].find(op.first);
+                if (p > 0.0 && it != _obs_hash_to_idx[ai].end()) {
+                  Matrix &m = matrices[it->second];
+                  m.index.push_back(tr.second);
+                  m.value.push_back(p);
+                }
+              }
+            }
+            for (Matrix &m : matrices) {
+              m.start.push_back(m.index.size());
+            }
+          }
+        });
+  }
+
+  std::size_t nb_states() const { return _nb_states; }
+  std::size_t nb_actions() const { return _matrices.size(); }
+
+  std::size_t nb_observations(std::size_t action_idx) const {
+    return _obs_hashes[action_idx].size();
+  }
+
+  std::size_t observation_hash(std::size_t action_idx,
+                               std::size_t obs_idx) const {
+    return _obs_hashes[action_idx][obs_idx];
+  }
+
+  // Index of the observation among the ones of the action, or
+  // nb_observations(action_idx) if the action never yields it
+  std::size_t observation_index(std::size_t action_idx,
+                                std::size_t obs_hash) const {
+    auto it = _obs_hash_to_idx[action_idx].find(obs_hash);
+    return (it != _obs_hash_to_idx[action_idx].end())
+               ? it->second
+               : nb_observations(action_idx);
+  }
+
+  // Number of non-zero entries of all the matrices
+  std::size_t nb_entries() const {
+    std::size_t n = 0;
+    for (const auto &matrices : _matrices) {
+      for (const Matrix &m : matrices) {
+        n += m.index.size();
+      }
+    }
+    return n;
+  }
+
+  /** Applies f(s', p) to the non-zero entries of row si of M_{a,o} */
+  template <typename Tfunction>
+  void for_each(std::size_t action_idx, std::size_t obs_idx, std::size_t si,
+                const Tfunction &f) const {
+    const Matrix &m = _matrices[action_idx][obs_idx];
+    for (std::size_t k = m.start[si]; k < m.start[si + 1]; k++) {
+      f(m.index[k], m.value[k]);
+    }
+  }
+
+  /** Returns (M_{a,o} values)(si) = sum_{s'} T(s' | si, a) O(o | s', a)
+   * values(s') */
+  double back_project(std::size_t action_idx, std::size_t obs_idx,
+                      std::size_t si, const double *values) const {
+    const Matrix &m = _matrices[action_idx][obs_idx];
+    double v = 0.0;
+    for (std::size_t k = m.start[si]; k < m.start[si + 1]; k++) {
+      v += m.value[k] * values[m.index[k]];
+    }
+    return v;
+  }
+
+  /** Returns the posterior of b after (a, o), empty if the probability of o
+   * (received by obs_probability) is not above mass_epsilon */
+  BeliefVector posterior(const BeliefVector &b, std::size_t action_idx,
+                         std::size_t obs_idx, double mass_epsilon,
+                         double &obs_probability) const {
+    // One scratch accumulator per thread: posteriors of different actions are
+    // computed concurrently with ParallelExecution
+    static thread_local BeliefAccumulator b_ao;
+    b_ao.reset(_nb_states);
+    const Matrix &m = _matrices[action_idx][obs_idx];
+    b.for_each([&m](std::size_t si, double p) {
+      for (std::size_t k = m.start[si]; k < m.start[si + 1]; k++) {
+        b_ao.add(m.index[k], p * m.value[k]);
+      }
+    });
+    return b_ao.normalized(mass_epsilon, obs_probability);
+  }
+
+private:
+  struct Matrix {
+    std::vector<std::size_t> start;
+    std::vector<std::size_t> index;
+    std::vector<double> value;
+  };
+
+  std::size_t _nb_states = 0;
+  std::vector<std::vector<Matrix>> _matrices;
+  std::vector<std::vector<std::size_t>> _obs_hashes;
+  std::vector<std::unordered_map<std::size_t, std::size_t>> _obs_hash_to_idx;
+};
+
+} // namespace skdecide
+
+#endif // SKDECIDE_OBSERVATION_TRANSITION_TENSORS_HH
@@ -0,0 +1,230 @@
+/* Copyright (c) AIRBUS and its affiliates.
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#ifndef SKDECIDE_OUTCOME_ARRAYS_HH
+#define SKDECIDE_OUTCOME_ARRAYS_HH
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "utils/execution.hh"
+
+namespace skdecide {
+
+/**
+ * @brief Outcomes of an action node stored as a struct of arrays
+ * (probabilities, transition costs and next state nodes) rather than as a
+ * container of (probability, cost, node) tuples. The expected transition cost
+ * is accumulated when the outcomes are added so that a Bellman backup of the
+ * action is the expected cost plus the discounted dot product of the
+ * probabilities with the next state values.
+ *
+ * @tparam Tnode Type of the next state nodes
+ */
+template <typename Tnode> class OutcomeArray {
+public:
+  OutcomeArray() : _expected_cost(0) {}
+
+  void reserve(std::size_t n) {
+    _probabilities.reserve(n);
+    _costs.reserve(n);
+    _nodes.reserve(n);
+  }
+
+  void push_back(double probability, double cost, Tnode *node) {
+    _probabilities.push_back(probability);
+    _costs.push_back(cost);
+    _nodes.push_back(node);
+    _expected_cost += probability * cost;
+  }
+
+  std::size_t size() const { return _nodes.size(); }
+  bool empty() const { return _nodes.empty(); }
+
+  double probability(std::size_t i) const { return _probabilities[i]; }
+  double cost(std::size_t i) const { return _costs[i]; }
+  Tnode *node(std::size_t i) const { return _nodes[i]; }
+
+  const std::vector<double> &probabilities() const { return _probabilities; }
+  const std::vector<double> &costs() const { return _costs; }
+  const std::vector<Tnode *> &nodes() const { return _nodes; }
+
+  // Sum of the outcome probabilities times the transition costs
+  double expected_cost() const { return _expected_cost; }
+
+  // Expected cost plus discount times the expectation of value(next node)
+  template <typename Tvalue>
+  double q_value(double discount, const Tvalue &value) const {
+    double v = 0;
+    for (std::size_t i = 0; i < _nodes.size(); i++) {
+      v += _probabilities[i] * value(*_nodes[i]);
+    }
+    return _expected_cost + (discount * v);
+  }
+
+private:
+  std::vector<double> _probabilities;
+  std::vector<double> _costs;
+  std::vector<Tnode *> _nodes;
+  double _expected_cost;
+};
+
+/**
+ * @brief Snapshot of the Bellman backups of a fixed set of states in
+ * compressed sparse row layout: the actions of each state are contiguous, and
+ * so are the outcome probabilities and successor indices of each action, while
+ * the state values live in a dense vector indexed by state. A backup of a
+ * state then reads contiguous arrays instead of dereferencing a graph node per
+ * outcome, which pays off when the same states are swept many times (e.g. the
+ * value iteration of ILAO*'s best solution graph).
+ *
+ * States are indexed in the order they are added. The actions of a state must
+ * be added right after the state (or after the actions of the previous state),
+ * and the outcomes of an action right after the action. States without
+ * actions keep their initial value (e.g. tip, goal or solved states at the
+ * boundary of the swept states).
+ *
+ * @tparam Texecution_policy Execution policy of the sweeps
+ */
+template <typename Texecution_policy = SequentialExecution>
+class CompactBellmanGraph {
+public:
+  static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+  CompactBellmanGraph() { clear(); }
+
+  void clear() {
+    _initial_values.clear();
+    _values.clear();
+    _first_action.assign(1, 0);
+    _best_actions.clear();
+    _residuals.clear();
+    _updated_states.clear();
+    _expected_costs.clear();
+    _q_values.clear();
+    _first_outcome.assign(1, 0);
+    _probabilities.clear();
+    _successors.clear();
+  }
+
+  std::size_t nb_states() const { return _best_actions.size(); }
+  std::size_t nb_actions() const { return _expected_costs.size(); }
+
+  std::size_t add_state(double value) {
+    _initial_values.push_back(value);
+    _first_action.push_back(_first_action.back());
+    _best_actions.push_back(npos);
+    _residuals.push_back(0);
+    return _best_actions.size() - 1;
+  }
+
+  // Adds an action to the last added state
+  void add_action(double expected_cost) {
+    if (_first_action[_best_actions.size() - 1] ==
+        _first_action[_best_actions.size()]) {
+      _updated_states.push_back(_best_actions.size() - 1);
+    }
+    _first_action.back()++;
+    _expected_costs.push_back(expected_cost);
+    _q_values.push_back(std::numeric_limits<double>::infinity());
+    _first_outcome.push_back(_first_outcome.back());
+  }
+
+  // Sets the best action of the last added state before the sweeps (e.g. the
+  // action of the current policy)
+  void set_best_action(std::size_t a) { _best_actions.back() = a; }
+
+  // Adds an outcome to the last added action
+  void add_outcome(double probability, std::size_t successor) {
+    _probabilities.push_back(probability);
+    _successors.push_back(successor);
+    _first_outcome.back()++;
+  }
+
+  // Allocates the dense value vector once all the states are added
+  void finalize() {
+    _values = std::vector<atomic_double>(_initial_values.size());
+    for (std::size_t i = 0; i < _initial_values.size(); i++) {
+      _values[i] = _initial_values[i];
+    }
+    _initial_values.clear();
+  }
+
+  /** Updates the values of the states with actions in place and returns the
+   * maximum residual and whether the best action of some state changed */
+  std::pair<double, bool> sweep(double discount) {
+    atomic_double residual = 0;
+    atomic_bool best_action_changed = false;
+
+    std::for_each(Texecution_policy::policy, _updated_states.begin(),
+                  _updated_states.end(),
+                  [this, &discount, &residual, &best_action_changed](
+                      const std::size_t &s) {
+                    std::size_t old_best_action = _best_actions[s];
+                    atomic_max(residual, update(s, discount));
+                    if (_best_actions[s] != old_best_action) {
+                      best_action_changed = true;
+                    }
+                  });
+
+    return {(double)residual, (bool)best_action_changed};
+  }
+
+  double value(std::size_t s) const { return _values[s]; }
+  double residual(std::size_t s) const { return _residuals[s]; }
+  double q_value(std::size_t a) const { return _q_values[a]; }
+
+  // Index of the first action of a state in the order of addition
+  std::size_t first_action(std::size_t s) const { return _first_action[s]; }
+
+  // Index of the best action of a state (npos if the state has no action)
+  std::size_t best_action(std::size_t s) const { return _best_actions[s]; }
+
+private:
+  typedef typename Texecution_policy::template atomic<double> atomic_double;
+  typedef typename Texecution_policy::template atomic<bool> atomic_bool;
+
+  std::vector<double> _initial_values;
+  std::vector<atomic_double> _values;
+  std::vector<std::size_t> _first_action; // nb_states + 1 offsets
+  std::vector<std::size_t> _best_actions;
+  std::vector<double> _residuals;
+  std::vector<std::size_t> _updated_states; // states with actions
+  std::vector<double> _expected_costs;
+  std::vector<double> _q_values;
+  std::vector<std::size_t> _first_outcome; // nb_actions + 1 offsets
+  std::vector<double> _probabilities;
+  std::vector<std::size_t> _successors;
+
+  double update(std::size_t s, double discount) {
+    double record_value = _values[s];
+    double best_value = std::numeric_limits<double>::infinity();
+    std::size_t best_action = npos;
+
+    for (std::size_t a = _first_action[s]; a < _first_action[s + 1]; a++) {
+      double v = 0;
+      for (std::size_t o = _first_outcome[a]; o < _first_outcome[a + 1]; o++) {
+        v += _probabilities[o] * _values[_successors[o]];
+      }
+      double q = _expected_costs[a] + (discount * v);
+      _q_values[a] = q;
+      if (q < best_value) {
+        best_value = q;
+        best_action = a;
+      }
+    }
+
+    _values[s] = best_value;
+    _best_actions[s] = best_action;
+    _residuals[s] = std::fabs(best_value - record_value);
+    return _residuals[s];
+  }
+};
+
+} // namespace skdecide
+
+#endif // SKDECIDE_OUTCOME_ARRAYS_HH
@@ -0,0 +1,357 @@
+/* Copyright (c) AIRBUS and its affiliates.
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#ifndef SKDECIDE_POMDP_MODEL_CACHE_HH
+#define SKDECIDE_POMDP_MODEL_CACHE_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "utils/logging.hh"
+
+namespace skdecide {
+
+/**
+ * Persistence of the model pre-cached by the point-based POMDP solvers
+ * (transitions, expected values and observation distributions of the
+ * enumerated states and actions), so that solving again the same domain
+ * skips the queries of the domain's dynamics. States, actions and
+ * observations are identified in the file by their stable_id(), and states
+ * and actions are remapped on loading to the indices of the loading solver,
+ * whose enumerated states and actions must be exactly the ones of the saved
+ * model. The file is a binary dump in native byte order, meant as a local
+ * cache rather than as an exchange format.
+ */
+namespace pomdp_model_cache {
+
+// Successor states and probabilities, indexed by origin state then by action
+typedef std::vector<std::vector<std::vector<std::pair<double, std::size_t>>>>
+    Transitions;
+// Observation identifiers and probabilities, indexed by successor state then
+// by action
+typedef std::vector<
+    std::vector<std::vector<std::pair<std::size_t, double>>>>
+    Observations;
+
+static constexpr char magic[8] = {'S', 'K', 'P', 'O', 'M', 'D', 'P', 'M'};
+static constexpr std::uint32_t version = 2;
+static constexpr std::uint32_t byte_order_mark = 0x01020304;
+
+class Writer {
+public:
+  explicit Writer(const std::string &path)
+      : _stream(path, std::ios::binary | std::ios::trunc) {}
+
+  bool good() const { return _stream.good(); }
+
+  void bytes(const void *data, std::size_t size) {
+    _stream.write(static_cast<const char *>(data), size);
+  }
+
+  void u64(std::size_t v) {
+    std::uint64_t x = static_cast<std::uint64_t>(v);
+    bytes(&x, sizeof(x));
+  }
+
+  void f64(double v) { bytes(&v, sizeof(v)); }
+
+private:
+  std::ofstream _stream;
+};
+
+class Reader {
+public:
+  explicit Reader(const std::string &path)
+      : _stream(path, std::ios::binary | std::ios::ate), _remaining(0) {
+    if (_stream.good()) {
+      _remaining = static_cast<std::size_t>(_stream.tellg());
+      _stream.seekg(0);
+    }
+  }
+
+  bool good() const { return _stream.good(); }
+
+  void bytes(void *data, std::size_t size) {
+    if (size > _remaining) {
+      _stream.setstate(std::ios::failbit);
+      return;
+    }
+    _stream.read(static_cast<char *>(data), size);
+    _remaining -= size;
+  }
+
+  std::size_t u64() {
+    std::uint64_t x = 0;
+    bytes(&x, sizeof(x));
+    return static_cast<std::size_t>(x);
+  }
+
+  double f64() {
+    double v = 0.0;
+    bytes(&v, sizeof(v));
+    return v;
+  }
+
+  // Reads the number of the following elements, failing if the file is too
+  // short for them so that corrupted counts are not allocated
+  std::size_t count(std::size_t element_size) {
+    std::size_t n = u64();
+    if (n > _remaining / element_size) {
+      _stream.setstate(std::ios::failbit);
+      return 0;
+    }
+    return n;
+  }
+
+private:
+  std::ifstream _stream;
+  std::size_t _remaining;
+};
+
+/** Identifier of a state, action or observation x which, unlike its hash,
+ * is the same in every process: hashes of Python objects (e.g. of strings)
+ * are salted per interpreter (see PYTHONHASHSEED). It is the 64-bit FNV-1a
+ * hash of x.print(), which must thus tell non-equal elements apart and must
+ * not depend on the process (e.g. print memory addresses). */
+template <typename T> std::size_t stable_id(const T &x) {
+  std::uint64_t h = 14695981039346656037ULL;
+  for (unsigned char c : x.print()) {
+    h ^= c;
+    h *= 1099511628211ULL;
+  }
+  return static_cast<std::size_t>(h);
+}
+
+template <typename T>
+std::vector<std::size_t> stable_ids(const std::vector<T> &elements) {
+  std::vector<std::size_t> ids;
+  ids.reserve(elements.size());
+  for (const auto &e : elements) {
+    ids.push_back(stable_id(e));
+  }
+  return ids;
+}
+
+// Inverse of an index to identifier map, empty if two indices share the same
+// identifier (i.e. if the elements cannot be told apart by their print())
+inline std::unordered_map<std::size_t, std::size_t>
+id_to_index(const std::vector<std::size_t> &ids) {
+  std::unordered_map<std::size_t, std::size_t> indices;
+  for (std::size_t i = 0; i < ids.size(); i++) {
+    if (!indices.emplace(ids[i], i).second) {
+      return std::unordered_map<std::size_t, std::size_t>();
+    }
+  }
+  return indices;
+}
+
+inline bool unique_ids(const std::vector<std::size_t> &ids) {
+  return id_to_index(ids).size() == ids.size();
+}
+
+/** Saves the model to path, writing first to a temporary file renamed at the
+ * end so that concurrent solvers never read a partial file. The value kind
+ * (e.g. "reward" or "cost") tells the meaning of the values, which must match
+ * on loading; state_ids and action_ids are the stable_id() of the states and
+ * actions by index. Returns false and logs a warning on failure. */
+inline bool save(const std::string &path, const std::string &value_kind,
+                 const std::vector<std::size_t> &state_ids,
+                 const std::vector<std::size_t> &action_ids,
+                 const Transitions &transitions,
+                 const std::vector<std::vector<double>> &values,
+                 const Observations &observations,
+                 const std::vector<std::vector<std::size_t>> &action_obs_ids) {
+  if (!unique_ids(state_ids) || !unique_ids(action_ids)) {
+    Logger::warn("Not saving the POMDP model cache " + path +
+                 " (states or actions with the same print())");
+    return false;
+  }
+  std::string tmp_path = path + ".tmp";
+  {
+    Writer w(tmp_path);
+    w.bytes(magic, sizeof(magic));
+    w.bytes(&version, sizeof(version));
+    w.bytes(&byte_order_mark, sizeof(byte_order_mark));
+    w.u64(value_kind.size());
+    w.bytes(value_kind.data(), value_kind.size());
+
+    std::size_t ns = state_ids.size();
+    std::size_t na = action_ids.size();
+    w.u64(ns);
+    w.u64(na);
+    for (std::size_t id : state_ids) {
+      w.u64(id);
+    }
+    for (std::size_t id : action_ids) {
+      w.u64(id);
+    }
+
+    for (std::size_t si = 0; si < ns; si++) {
+      for (std::size_t ai = 0; ai < na; ai++) {
+        w.u64(transitions[si][ai].size());
+        for (const auto &tr : transitions[si][ai]) {
+          w.f64(tr.first);
+          w.u64(tr.second);
+        }
+        w.f64(values[si][ai]);
+        w.u64(observations[si][ai].size());
+        for (const auto &op : observations[si][ai]) {
+          w.u64(op.first);
+          w.f64(op.second);
+        }
+      }
+    }
+    for (std::size_t ai = 0; ai < na; ai++) {
+      w.u64(action_obs_ids[ai].size());
+      for (std::size_t oid : action_obs_ids[ai]) {
+        w.u64(oid);
+      }
+    }
+
+    if (!w.good()) {
+      Logger::warn("Failed to write the POMDP model cache " + tmp_path);
+      std::remove(tmp_path.c_str());
+      return false;
+    }
+  }
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    Logger::warn("Failed to rename the POMDP model cache " + tmp_path +
+                 " to " + path);
+    std::remove(tmp_path.c_str());
+    return false;
+  }
+  return true;
+}
+
+/** Loads the model saved in path, remapping its states and actions to the
+ * indices of state_ids and action_ids (the stable_id() of the states and
+ * actions of the loading solver). Returns false, leaving the output model in
+ * an unspecified state, if the file does not exist or was saved for other
+ * states, actions or value kind (the latter cases being logged as
+ * warnings). */
+inline bool load(const std::string &path, const std::string &value_kind,
+                 const std::vector<std::size_t> &state_ids,
+                 const std::vector<std::size_t> &action_ids,
+                 Transitions &transitions,
+                 std::vector<std::vector<double>> &values,
+                 Observations &observations,
+                 std::vector<std::vector<std::size_t>> &action_obs_ids) {
+  Reader r(path);
+  if (!r.good()) {
+    return false;
+  }
+  std::unordered_map<std::size_t, std::size_t> state_id_to_idx =
+      id_to_index(state_ids);
+  std::unordered_map<std::size_t, std::size_t> action_id_to_idx =
+      id_to_index(action_ids);
+  if (state_id_to_idx.size() != state_ids.size() ||
+      action_id_to_idx.size() != action_ids.size()) {
+    Logger::warn("Ignoring the POMDP model cache " + path +
+                 " (states or actions with the same print())");
+    return false;
+  }
+
+  char file_magic[sizeof(magic)];
+  std::uint32_t file_version = 0;
+  std::uint32_t file_byte_order_mark = 0;
+  r.bytes(file_magic, sizeof(file_magic));
+  r.bytes(&file_version, sizeof(file_version));
+  r.bytes(&file_byte_order_mark, sizeof(file_byte_order_mark));
+  if (!r.good() || std::memcmp(file_magic, magic, sizeof(magic)) != 0 ||
+      file_version != version || file_byte_order_mark != byte_order_mark) {
+    Logger::warn("Ignoring the POMDP model cache " + path +
+                 " (not a model cache of this version and platform)");
+    return false;
+  }
+  std::string file_value_kind(r.count(1), '\0');
+  r.bytes(&file_value_kind[0], file_value_kind.size());
+
+  std::size_t ns = state_ids.size();
+  std::size_t na = action_ids.size();
+  if (!r.good() || file_value_kind != value_kind || r.u64() != ns ||
+      r.u64() != na) {
+    Logger::warn("Ignoring the POMDP model cache " + path +
+                 " (saved for another model)");
+    return false;
+  }
+
+  // Indices of the states and actions of the file in the loading solver
+  auto read_indices =
+      [&r](const std::unordered_map<std::size_t, std::size_t> &id_to_idx,
+           std::vector<std::size_t> &indices) {
+        indices.resize(id_to_idx.size());
+        for (std::size_t &idx : indices) {
+          auto it = id_to_idx.find(r.u64());
+          if (it == id_to_idx.end()) {
+            return false;
+          }
+          idx = it->second;
+        }
+        return true;
+      };
+  std::vector<std::size_t> state_idx;
+  std::vector<std::size_t> action_idx;
+  if (!read_indices(state_id_to_idx, state_idx) ||
+      !read_indices(action_id_to_idx, action_idx)) {
+    Logger::warn("Ignoring the POMDP model cache " + path +
+                 " (saved for other states or actions)");
+    return false;
+  }
+
+  transitions.assign(
+      ns, std::vector<std::vector<std::pair<double, std::size_t>>>(na));
+  values.assign(ns, std::vector<double>(na, 0.0));
+  observations.assign(
+      ns, std::vector<std::vector<std::pair<std::size_t, double>>>(na));
+  action_obs_ids.assign(na, std::vector<std::size_t>());
+
+  for (std::size_t si = 0; si < ns && r.good(); si++) {
+    for (std::size_t ai = 0; ai < na && r.good(); ai++) {
+      auto &trs = transitions[state_idx[si]][action_idx[ai]];
+      trs.resize(r.count(2 * sizeof(std::uint64_t)));
+      for (auto &tr : trs) {
+        tr.first = r.f64();
+        std::size_t ns_idx = r.u64();
+        if (ns_idx >= ns) {
+          Logger::warn("Ignoring the corrupted POMDP model cache " + path);
+          return false;
+        }
+        tr.second = state_idx[ns_idx];
+      }
+      values[state_idx[si]][action_idx[ai]] = r.f64();
+      auto &ops = observations[state_idx[si]][action_idx[ai]];
+      ops.resize(r.count(2 * sizeof(std::uint64_t)));
+      for (auto &op : ops) {
+        op.first = r.u64();
+        op.second = r.f64();
+      }
+    }
+  }
+  for (std::size_t ai = 0; ai < na && r.good(); ai++) {
+    auto &ids = action_obs_ids[action_idx[ai]];
+    ids.resize(r.count(sizeof(std::uint64_t)));
+    for (std::size_t &oid : ids) {
+      oid = r.u64();
+    }
+  }
+
+  if (!r.good()) {
+    Logger::warn("Ignoring the truncated POMDP model cache " + path);
+    return false;
+  }
+  return true;
+}
+
+} // namespace pomdp_model_cache
+
+} // namespace skdecide
+
+#endif // SKDECIDE_POMDP_MODEL_CACHE_HH
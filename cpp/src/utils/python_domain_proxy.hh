@@ -469,6 +469,24 @@ public:
   bool is_goal(const State &s, const std::size_t *thread_id = nullptr);
   bool is_terminal(const State &s, const std::size_t *thread_id = nullptr);
 
+  // Batched queries: the i-th result is the one of the scalar query applied
+  // to the i-th elements of the argument vectors. The python domain is called
+  // once if it implements the '<scalar method name>_batch' method taking lists
+  // of arguments and returning a list of results; otherwise the scalar method
+  // is called for each query (in parallel by the processes of the python
+  // parallel domain in parallel mode)
+  std::vector<ApplicableActionSpace>
+  get_applicable_actions_batch(const std::vector<const Memory *> &memories);
+  std::vector<NextStateDistribution>
+  get_next_state_distribution_batch(const std::vector<const Memory *> &memories,
+                                    const std::vector<const Event *> &events);
+  std::vector<Value>
+  get_transition_value_batch(const std::vector<const Memory *> &memories,
+                             const std::vector<const Event *> &events,
+                             const std::vector<const State *> &next_states);
+  std::vector<bool> is_goal_batch(const std::vector<const State *> &states);
+  std::vector<bool> is_terminal_batch(const std::vector<const State *> &states);
+
   template <typename Tfunction, typename... Types>
   std::unique_ptr<py::object> call(const std::size_t *thread_id,
                                    const Tfunction &func, const Types &...args);
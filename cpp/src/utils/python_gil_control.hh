@@ -7,6 +7,8 @@
 
 #include <pybind11/pybind11.h>
 
+#include <optional>
+
 #include "utils/execution.hh"
 
 namespace py = pybind11;
@@ -22,27 +24,71 @@ template <> struct GilControl<skdecide::SequentialExecution> {
   struct Release {
     Release() {}
   };
+  struct Yield {
+    Yield() {}
+  };
 };
 
+/**
+ * @brief GIL management of the parallel execution policy: threads directly
+ * acquire the GIL, which already serializes them, instead of first locking a
+ * process-wide mutex. Threads which already hold the GIL (e.g. nested
+ * acquisitions when converting Python containers, or calls from the Python
+ * interpreter's thread) do not acquire it again, and threads which do not hold
+ * it do not release it.
+ *
+ * Keeping the GIL over several scalar domain calls of a thread is not
+ * supported: between two calls, solver threads lock the solver's mutexes,
+ * and a thread waiting for such a mutex while keeping the GIL would deadlock
+ * with the threads waiting for the GIL while holding the mutex. Batches of
+ * queries instead go through the *_batch() methods of PythonDomainProxy,
+ * which acquire the GIL once per batch. The GIL can't be avoided altogether
+ * with the Python parallel domain either, since the queries are sent to its
+ * processes and their results fetched through Python calls; the GIL is only
+ * released (Yield) while waiting for the processes.
+ */
 template <> struct GilControl<skdecide::ParallelExecution> {
 
-  template <typename GilScopedType> struct GilManager {
-    std::unique_ptr<GilScopedType> _gil;
-    inline static skdecide::ParallelExecution::RecursiveMutex _mutex;
-
-    GilManager() {
-      _mutex.lock();
-      _gil = std::make_unique<GilScopedType>();
+  class Acquire {
+  public:
+    Acquire() {
+      if (!PyGILState_Check()) {
+        _gil.emplace();
+      }
     }
 
-    ~GilManager() {
-      _gil.reset();
-      _mutex.unlock();
+    ~Acquire() { _gil.reset(); }
+
+    Acquire(const Acquire &) = delete;
+    Acquire &operator=(const Acquire &) = delete;
+
+  private:
+    std::optional<py::gil_scoped_acquire> _gil;
+  };
+
+  class Release {
+  public:
+    Release() {
+      if (PyGILState_Check()) {
+        _gil.emplace();
+      }
     }
+
+    ~Release() { _gil.reset(); }
+
+    Release(const Release &) = delete;
+    Release &operator=(const Release &) = delete;
+
+  private:
+    std::optional<py::gil_scoped_release> _gil;
   };
 
-  typedef GilManager<py::gil_scoped_release> Release;
-  typedef GilManager<py::gil_scoped_acquire> Acquire;
+  /**
+   * @brief Temporarily hands the GIL over to other threads if the current
+   * thread holds it; used while waiting for the processes of the Python
+   * parallel domain
+   */
+  typedef Release Yield;
 };
 
 } // namespace skdecide
@@ -0,0 +1,96 @@
+/* Copyright (c) AIRBUS and its affiliates.
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#ifndef SKDECIDE_ROLLOUT_LANES_HH
+#define SKDECIDE_ROLLOUT_LANES_HH
+
+#include <algorithm>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "utils/execution.hh"
+
+namespace skdecide {
+
+/**
+ * @brief Runs f(lane) for each rollout lane in [0, nb_lanes), where lane is
+ * the thread_id passed to the domain, i.e. the index of the domain process
+ * serving the lane when the domain is a python parallel domain.
+ *
+ * Solvers used to dispatch their lanes with std::for_each over the execution
+ * policy, which runs at most one lane per thread of the policy's pool (i.e.
+ * per core): when the domain has more processes than there are cores, the
+ * extra lanes only started after the first ones were finished, and the extra
+ * processes stayed idle although the lanes mostly wait for the processes'
+ * answers. With parallel policies, each lane now runs on its own thread (the
+ * calling thread runs lane 0), which sleeps while waiting for its domain
+ * process, so that all the domain processes have a query in flight. With
+ * policies which do not run code concurrently (see is_concurrent_execution),
+ * lanes run one after the other on the calling thread.
+ *
+ * The parallel loops nested in the lanes (e.g. when expanding states) run on
+ * the pool of the policy, which the lanes share with TBB and the work-stealing
+ * scheduler. With OpenMP however, each lane thread is an initial thread which
+ * would start a full team of threads for each nested parallel loop: the
+ * number of OpenMP threads of each lane is thus divided by the number of
+ * lanes (i.e. nested loops run sequentially when there are more lanes than
+ * cores).
+ *
+ * If some lanes throw, the first exception is rethrown once all the lanes
+ * are finished.
+ */
+template <typename Texecution_policy, typename Function>
+void for_each_rollout_lane(std::size_t nb_lanes, const Function &f) {
+  if constexpr (!is_concurrent_execution<Texecution_policy>::value) {
+    for (std::size_t lane = 0; lane < nb_lanes; lane++) {
+      f(lane);
+    }
+  } else {
+    std::exception_ptr error;
+    std::mutex error_mutex;
+#if !defined(HAS_EXECUTION) && defined(HAS_OPENMP)
+    const int max_threads = omp_get_max_threads();
+    const int lane_threads = (nb_lanes > 1)
+                                 ? std::max(1, max_threads / (int)nb_lanes)
+                                 : max_threads;
+#endif
+    auto run_lane = [&](const std::size_t &lane) {
+      try {
+#if !defined(HAS_EXECUTION) && defined(HAS_OPENMP)
+        omp_set_num_threads(lane_threads);
+#endif
+        f(lane);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (!error) {
+          error = std::current_exception();
+        }
+      }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(nb_lanes > 0 ? nb_lanes - 1 : 0);
+    for (std::size_t lane = 1; lane < nb_lanes; lane++) {
+      threads.emplace_back(run_lane, lane);
+    }
+    if (nb_lanes > 0) {
+      run_lane(0);
+    }
+    for (auto &t : threads) {
+      t.join();
+    }
+#if !defined(HAS_EXECUTION) && defined(HAS_OPENMP)
+    omp_set_num_threads(max_threads); // lane 0 ran on the calling thread
+#endif
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+} // namespace skdecide
+
+#endif // SKDECIDE_ROLLOUT_LANES_HH
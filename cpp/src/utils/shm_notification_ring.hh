@@ -0,0 +1,306 @@
+/* Copyright (c) AIRBUS and its affiliates.
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#ifndef SKDECIDE_SHM_NOTIFICATION_RING_HH
+#define SKDECIDE_SHM_NOTIFICATION_RING_HH
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#if defined(__linux__) || defined(__APPLE__)
+#define SK_SHM_NOTIFICATION_RING_POSIX
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#define SK_SHM_NOTIFICATION_RING_FUTEX
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+#include "utils/execution.hh"
+
+namespace skdecide {
+
+/**
+ * @brief Lock-free single-producer single-consumer ring buffer of fixed-size
+ * message slots living in a named POSIX shared memory segment, used by the
+ * processes of the python parallel domain to notify the C++ parallel domain
+ * proxy that a job is finished (message "0") or failed (error message). It
+ * replaces the nng pipeline sockets for addresses of the form
+ * 'shm://<name>': a notification then only costs a few atomic operations
+ * plus, if the consumer is asleep, one futex wake-up system call (Linux), or
+ * a short sleep (other POSIX systems).
+ *
+ * The segment has a fixed size and its zero-filled initial content is a valid
+ * empty ring, so that both sides can open or create it in any order without
+ * further synchronization. The segment outlives the objects mapping it and
+ * must be removed with unlink() once both sides are closed.
+ *
+ * Messages longer than slot_size bytes are truncated.
+ *
+ * close() may be called while other threads of the process are blocked in
+ * send() or recv() on the same object: they are woken up and throw, and the
+ * segment is only unmapped once they have all returned.
+ */
+class ShmNotificationRing {
+public:
+  static constexpr std::size_t capacity = 64; // must be a power of 2
+  static constexpr std::size_t slot_size = 1020;
+  static constexpr char address_prefix[] = "shm://";
+
+  static_assert((capacity & (capacity - 1)) == 0,
+                "Ring capacity must be a power of 2");
+  static_assert(std::atomic<std::uint32_t>::is_always_lock_free &&
+                    std::atomic<std::uint64_t>::is_always_lock_free,
+                "Shared memory atomics must be lock-free");
+
+  static bool is_address(const std::string &address) {
+    return address.rfind(address_prefix, 0) == 0;
+  }
+
+  /**
+   * @brief Maps the shared memory segment of the given address, creating it
+   * if needed
+   *
+   * @param address Address of the form 'shm://<name>'
+   */
+  explicit ShmNotificationRing(const std::string &address)
+      : _name(segment_name(address)), _ring(nullptr), _closed(true),
+        _nb_users(0) {
+#ifdef SK_SHM_NOTIFICATION_RING_POSIX
+    int fd = ::shm_open(_name.c_str(), O_CREAT | O_RDWR, 0600);
+    if (fd < 0) {
+      throw_system_error("shm_open");
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 ||
+        (static_cast<std::size_t>(st.st_size) < sizeof(Ring) &&
+         ::ftruncate(fd, sizeof(Ring)) != 0)) {
+      int err = errno;
+      ::close(fd);
+      errno = err;
+      throw_system_error("ftruncate");
+    }
+    void *p = ::mmap(nullptr, sizeof(Ring), PROT_READ | PROT_WRITE, MAP_SHARED,
+                     fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) {
+      throw_system_error("mmap");
+    }
+    _ring = static_cast<Ring *>(p);
+    _closed.store(false);
+#else
+    throw std::runtime_error("SKDECIDE exception: shared memory notification "
+                             "rings are not supported on this platform");
+#endif
+  }
+
+  ~ShmNotificationRing() { close(); }
+
+  ShmNotificationRing(const ShmNotificationRing &) = delete;
+  ShmNotificationRing &operator=(const ShmNotificationRing &) = delete;
+
+  void close() {
+#ifdef SK_SHM_NOTIFICATION_RING_POSIX
+    if (_closed.exchange(true)) {
+      return;
+    }
+    // Wakes up the threads of this process sleeping in recv(), which see the
+    // closed flag before sleeping again; the other side only gets a spurious
+    // wake-up
+    _ring->sequence.fetch_add(1, std::memory_order_seq_cst);
+    wake(_ring->sequence, true);
+    while (_nb_users.load() > 0) {
+      std::this_thread::yield();
+    }
+    ::munmap(_ring, sizeof(Ring));
+    _ring = nullptr;
+#endif
+  }
+
+  /**
+   * @brief Removes the shared memory segment of the given address; processes
+   * which already mapped it keep a valid mapping until they close it
+   */
+  static void unlink(const std::string &address) {
+#ifdef SK_SHM_NOTIFICATION_RING_POSIX
+    ::shm_unlink(segment_name(address).c_str());
+#endif
+  }
+
+  /**
+   * @brief Pushes a message (producer side), waiting for a free slot if the
+   * ring is full
+   */
+  void send(const std::string &message) {
+    User user(*this);
+    std::uint64_t tail = _ring->tail.load(std::memory_order_relaxed);
+    for (std::size_t spins = 0;
+         tail - _ring->head.load(std::memory_order_acquire) >= capacity;
+         ++spins) {
+      user.check_open();
+      backoff(spins);
+    }
+    Slot &slot = _ring->slots[tail & (capacity - 1)];
+    slot.size = static_cast<std::uint32_t>(std::min(message.size(), slot_size));
+    std::memcpy(slot.data, message.data(), slot.size);
+    _ring->tail.store(tail + 1, std::memory_order_release);
+    // The sequence number must be bumped after the message is published and
+    // before checking whether the consumer sleeps: along with the consumer
+    // doing the opposite in recv(), it guarantees that a wake-up is never lost
+    _ring->sequence.fetch_add(1, std::memory_order_seq_cst);
+    if (_ring->sleeping.load(std::memory_order_seq_cst) != 0) {
+      wake(_ring->sequence, false);
+    }
+  }
+
+  /**
+   * @brief Pops the oldest message (consumer side), spinning for a short
+   * while before sleeping until a message is available
+   */
+  std::string recv() {
+    User user(*this);
+    std::uint64_t head = _ring->head.load(std::memory_order_relaxed);
+    for (std::size_t spins = 0;
+         _ring->tail.load(std::memory_order_acquire) == head; ++spins) {
+      user.check_open();
+      if (spins < spin_limit()) {
+        SpinMutex::cpu_relax();
+      } else {
+        _ring->sleeping.store(1, std::memory_order_seq_cst);
+        std::uint32_t seq = _ring->sequence.load(std::memory_order_seq_cst);
+        // The closed flag is set before close() bumps the sequence number:
+        // if it is not seen here, the wait below returns on the bump
+        if (!_closed.load(std::memory_order_seq_cst) &&
+            _ring->tail.load(std::memory_order_seq_cst) == head) {
+          wait(_ring->sequence, seq);
+        }
+        _ring->sleeping.store(0, std::memory_order_relaxed);
+      }
+    }
+    const Slot &slot = _ring->slots[head & (capacity - 1)];
+    std::string message(slot.data, slot.size);
+    _ring->head.store(head + 1, std::memory_order_release);
+    return message;
+  }
+
+private:
+  struct Slot {
+    std::uint32_t size;
+    char data[slot_size];
+  };
+
+  // Head and tail are on separate cache lines to avoid false sharing between
+  // the producer and the consumer
+  struct Ring {
+    alignas(64) std::atomic<std::uint64_t> head;
+    alignas(64) std::atomic<std::uint64_t> tail;
+    alignas(64) std::atomic<std::uint32_t> sequence;
+    std::atomic<std::uint32_t> sleeping;
+    alignas(64) Slot slots[capacity];
+  };
+
+  // Spinning only pays off if the other process can run at the same time
+  static std::size_t spin_limit() {
+    static const std::size_t limit =
+        std::thread::hardware_concurrency() > 1 ? 256 : 0;
+    return limit;
+  }
+
+  // Registers an ongoing send() or recv() call, during which close() does not
+  // unmap the segment
+  class User {
+  public:
+    User(ShmNotificationRing &r) : _r(r) {
+      _r._nb_users++;
+      if (_r._closed.load(std::memory_order_seq_cst)) {
+        _r._nb_users--;
+        _r.throw_closed();
+      }
+    }
+
+    ~User() { _r._nb_users--; }
+
+    void check_open() {
+      if (_r._closed.load(std::memory_order_seq_cst)) {
+        _r.throw_closed();
+      }
+    }
+
+  private:
+    ShmNotificationRing &_r;
+  };
+
+  std::string _name;
+  Ring *_ring;
+  std::atomic<bool> _closed;
+  std::atomic<std::size_t> _nb_users;
+
+  static std::string segment_name(const std::string &address) {
+    std::string name = is_address(address)
+                           ? address.substr(std::strlen(address_prefix))
+                           : address;
+    std::replace(name.begin(), name.end(), '/', '_');
+    return "/" + name;
+  }
+
+  [[noreturn]] void throw_closed() const {
+    throw std::runtime_error("SKDECIDE exception: shared memory "
+                             "notification ring " +
+                             _name + " is closed");
+  }
+
+  [[noreturn]] void throw_system_error(const char *call) const {
+    throw std::runtime_error("SKDECIDE exception: " + std::string(call) +
+                             " failed for shared memory segment " + _name +
+                             ": " + std::strerror(errno));
+  }
+
+  static void backoff(std::size_t spins) {
+    if (spins < spin_limit()) {
+      SpinMutex::cpu_relax();
+    } else {
+      std::this_thread::yield();
+    }
+  }
+
+#ifdef SK_SHM_NOTIFICATION_RING_FUTEX
+  // The futex word is shared between processes: FUTEX_PRIVATE_FLAG must not
+  // be used
+  static void wait(std::atomic<std::uint32_t> &word, std::uint32_t expected) {
+    ::syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(&word), FUTEX_WAIT,
+              expected, nullptr, nullptr, 0);
+  }
+
+  static void wake(std::atomic<std::uint32_t> &word, bool all) {
+    ::syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(&word), FUTEX_WAKE,
+              all ? INT_MAX : 1, nullptr, nullptr, 0);
+  }
+#else
+  static void wait(std::atomic<std::uint32_t> &word, std::uint32_t expected) {
+    if (word.load(std::memory_order_acquire) == expected) {
+      std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+  }
+
+  static void wake([[maybe_unused]] std::atomic<std::uint32_t> &word,
+                   [[maybe_unused]] bool all) {}
+#endif
+};
+
+} // namespace skdecide
+
+#endif // SKDECIDE_SHM_NOTIFICATION_RING_HH
@@ -0,0 +1,463 @@
+/* Copyright (c) AIRBUS and its affiliates.
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#ifndef SKDECIDE_WORK_STEALING_SCHEDULER_HH
+#define SKDECIDE_WORK_STEALING_SCHEDULER_HH
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace skdecide {
+
+/**
+ * @brief Chase-Lev deque of pointers ("Dynamic Circular Work-Stealing Deque",
+ * Chase and Lev, SPAA 2005, with the C11 memory orderings of Lê et al., PPoPP
+ * 2013). Its owner thread pushes and pops elements at the bottom of the deque
+ * while any other thread may concurrently steal elements from its top. The
+ * deque is only grown (never shrunk) by its owner.
+ *
+ * @tparam T Type of the pointed elements
+ */
+template <typename T> class WorkStealingDeque {
+public:
+  WorkStealingDeque() : _top(0), _bottom(0), _array(new Array(64)) {
+    _arrays.emplace_back(_array.load(std::memory_order_relaxed));
+  }
+
+  /** @brief Pushes an element at the bottom (owner thread only) */
+  void push(T *t) {
+    std::int64_t b = _bottom.load(std::memory_order_relaxed);
+    std::int64_t tp = _top.load(std::memory_order_acquire);
+    Array *a = _array.load(std::memory_order_relaxed);
+    if (b - tp > a->capacity - 1) {
+      a = grow(a, tp, b);
+    }
+    a->put(b, t);
+    _bottom.store(b + 1, std::memory_order_release);
+  }
+
+  /**
+   * @brief Pops the bottom element (owner thread only), or returns nullptr if
+   * the deque is empty
+   */
+  T *pop() {
+    std::int64_t b = _bottom.load(std::memory_order_relaxed) - 1;
+    Array *a = _array.load(std::memory_order_relaxed);
+    _bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t t = _top.load(std::memory_order_relaxed);
+    T *e = nullptr;
+    if (t <= b) {
+      e = a->get(b);
+      if (t == b) { // last element: race against thieves
+        if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                          std::memory_order_relaxed)) {
+          e = nullptr;
+        }
+        _bottom.store(b + 1, std::memory_order_relaxed);
+      }
+    } else {
+      _bottom.store(b + 1, std::memory_order_relaxed);
+    }
+    return e;
+  }
+
+  /**
+   * @brief Steals the top element (any thread), or returns nullptr if the
+   * deque is empty or if the steal lost a race against another thread
+   */
+  T *steal() {
+    std::int64_t t = _top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t b = _bottom.load(std::memory_order_acquire);
+    if (t < b) {
+      Array *a = _array.load(std::memory_order_acquire);
+      T *e = a->get(t);
+      if (_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                       std::memory_order_relaxed)) {
+        return e;
+      }
+    }
+    return nullptr;
+  }
+
+private:
+  struct Array {
+    std::int64_t capacity;
+    std::unique_ptr<std::atomic<T *>[]> buffer;
+
+    Array(std::int64_t c) : capacity(c), buffer(new std::atomic<T *>[c]) {}
+
+    T *get(std::int64_t i) const {
+      return buffer[i & (capacity - 1)].load(std::memory_order_relaxed);
+    }
+
+    void put(std::int64_t i, T *t) {
+      buffer[i & (capacity - 1)].store(t, std::memory_order_relaxed);
+    }
+  };
+
+  alignas(64) std::atomic<std::int64_t> _top;
+  alignas(64) std::atomic<std::int64_t> _bottom;
+  std::atomic<Array *> _array;
+  // Arrays are retired (not freed) when growing since thieves may still be
+  // reading the previous one
+  std::vector<std::unique_ptr<Array>> _arrays;
+
+  Array *grow(Array *a, std::int64_t t, std::int64_t b) {
+    Array *na = new Array(2 * a->capacity);
+    _arrays.emplace_back(na);
+    for (std::int64_t i = t; i < b; i++) {
+      na->put(i, a->get(i));
+    }
+    _array.store(na, std::memory_order_release);
+    return na;
+  }
+};
+
+/**
+ * @brief Pool of worker threads executing tasks with work stealing. Each
+ * worker owns a WorkStealingDeque: it pushes and pops its own tasks at the
+ * bottom of its deque while idle workers steal tasks from the top of other
+ * workers' deques. Threads which are
+ * not workers of the pool (e.g. the thread calling a solver's solve() method)
+ * submit their tasks to a shared injection queue.
+ *
+ * Joining a group of spawned tasks never blocks the joining thread: it keeps
+ * executing pending tasks until all the tasks of the group are completed,
+ * which makes nested parallel loops (e.g. a parallel expansion of a state
+ * node's actions run from within parallel rollouts) spawn subtasks instead of
+ * being serialized.
+ */
+class WorkStealingScheduler {
+public:
+  class TaskGroup;
+
+  /**
+   * @brief Unit of work scheduled by the pool. Tasks are not owned by the
+   * scheduler: their storage must outlive the completion of the task group to
+   * which they are spawned (which is typically achieved by allocating them on
+   * the stack of the spawning function before it joins the group).
+   */
+  class Task {
+  public:
+    virtual ~Task() {}
+    virtual void execute() = 0;
+
+  private:
+    friend class WorkStealingScheduler;
+    friend class TaskGroup;
+    TaskGroup *_group = nullptr;
+  };
+
+  /**
+   * @brief Set of tasks spawned by a given thread and joined together
+   */
+  class TaskGroup {
+  public:
+    TaskGroup(WorkStealingScheduler &scheduler = instance())
+        : _scheduler(scheduler), _pending(0) {}
+
+    ~TaskGroup() {
+      if (_pending.load(std::memory_order_acquire) > 0) {
+        _scheduler.wait_for(*this);
+      }
+    }
+
+    TaskGroup(const TaskGroup &) = delete;
+    TaskGroup &operator=(const TaskGroup &) = delete;
+
+    /**
+     * @brief Schedules a caller-owned task (no heap allocation)
+     */
+    void spawn(Task &t) {
+      t._group = this;
+      _pending.fetch_add(1, std::memory_order_relaxed);
+      _scheduler.submit(&t);
+    }
+
+    /**
+     * @brief Schedules a function object; the task wrapping it is owned by the
+     * group, which must be fed from a single thread
+     */
+    template <typename Function> void run(Function &&f) {
+      _owned_tasks.push_back(std::make_unique<FunctionTask<Function>>(
+          std::forward<Function>(f)));
+      spawn(*_owned_tasks.back());
+    }
+
+    /**
+     * @brief Executes pending tasks until all the tasks of the group are
+     * completed, then rethrows the first exception thrown by these tasks if
+     * any
+     */
+    void wait() {
+      _scheduler.wait_for(*this);
+      _owned_tasks.clear();
+      if (_exception) {
+        std::exception_ptr e = _exception;
+        _exception = nullptr;
+        std::rethrow_exception(e);
+      }
+    }
+
+  private:
+    friend class WorkStealingScheduler;
+
+    template <typename Function> class FunctionTask : public Task {
+    public:
+      FunctionTask(Function &&f) : _f(std::forward<Function>(f)) {}
+      virtual void execute() { _f(); }
+
+    private:
+      std::decay_t<Function> _f;
+    };
+
+    WorkStealingScheduler &_scheduler;
+    std::atomic<std::size_t> _pending;
+    std::list<std::unique_ptr<Task>> _owned_tasks;
+    std::mutex _exception_mutex;
+    std::exception_ptr _exception;
+
+    void set_exception(std::exception_ptr e) {
+      std::scoped_lock lock(_exception_mutex);
+      if (!_exception) {
+        _exception = e;
+      }
+    }
+  };
+
+  /**
+   * @brief Creates a pool of nb_workers worker threads (in addition to the
+   * threads submitting tasks, which also execute tasks while joining)
+   */
+  explicit WorkStealingScheduler(std::size_t nb_workers)
+      : _stop(false), _nb_sleeping(0) {
+    nb_workers = std::max<std::size_t>(1, nb_workers);
+    for (std::size_t i = 0; i < nb_workers; i++) {
+      _deques.push_back(std::make_unique<Deque>());
+    }
+    for (std::size_t i = 0; i < nb_workers; i++) {
+      _workers.emplace_back([this, i]() { worker_loop(i); });
+    }
+  }
+
+  ~WorkStealingScheduler() {
+    {
+      std::scoped_lock lock(_sleep_mutex);
+      _stop.store(true);
+    }
+    _sleep_cv.notify_all();
+    for (auto &w : _workers) {
+      w.join();
+    }
+  }
+
+  WorkStealingScheduler(const WorkStealingScheduler &) = delete;
+  WorkStealingScheduler &operator=(const WorkStealingScheduler &) = delete;
+
+  /**
+   * @brief Process-wide pool, lazily started with one worker per hardware
+   * thread but the calling one
+   */
+  static WorkStealingScheduler &instance() {
+    static WorkStealingScheduler scheduler(
+        std::max(2u, std::thread::hardware_concurrency()) - 1);
+    return scheduler;
+  }
+
+  std::size_t nb_workers() const { return _workers.size(); }
+
+  /**
+   * @brief Applies f to each element of [first, last) in parallel. The range
+   * is recursively split in halves, one half being spawned and the other one
+   * being processed by the current thread, until chunks reach a grain size
+   * adapted to the range size and to the number of workers so that idle
+   * workers can balance the load by stealing the largest remaining chunks.
+   * Non random-access ranges are first flattened into a vector of iterators.
+   */
+  template <typename Iterator, typename Function>
+  void parallel_for(Iterator first, Iterator last, const Function &f) {
+    if constexpr (std::is_base_of<std::random_access_iterator_tag,
+                                  typename std::iterator_traits<
+                                      Iterator>::iterator_category>::value) {
+      std::size_t n = static_cast<std::size_t>(std::distance(first, last));
+      run_range(first, last, f, grain_size(n));
+    } else {
+      std::vector<Iterator> v;
+      for (Iterator i = first; i != last; i++) {
+        v.push_back(i);
+      }
+      auto fi = [&f](const Iterator &i) { f(*i); };
+      run_range(v.begin(), v.end(), fi, grain_size(v.size()));
+    }
+  }
+
+private:
+  template <typename RandomIt, typename Function>
+  class RangeTask : public Task {
+  public:
+    RangeTask(WorkStealingScheduler &scheduler, RandomIt first, RandomIt last,
+              const Function &f, std::size_t grain)
+        : _scheduler(scheduler), _first(first), _last(last), _f(f),
+          _grain(grain) {}
+
+    virtual void execute() {
+      _scheduler.run_range(_first, _last, _f, _grain);
+    }
+
+  private:
+    WorkStealingScheduler &_scheduler;
+    RandomIt _first;
+    RandomIt _last;
+    const Function &_f;
+    std::size_t _grain;
+  };
+
+  inline static thread_local WorkStealingScheduler *_tl_scheduler = nullptr;
+  inline static thread_local std::size_t _tl_worker = 0;
+
+  typedef WorkStealingDeque<Task> Deque;
+
+  std::vector<std::unique_ptr<Deque>> _deques;
+  std::vector<std::thread> _workers;
+  std::mutex _injection_mutex;
+  std::deque<Task *> _injection_queue;
+  std::atomic<bool> _stop;
+  std::atomic<std::size_t> _nb_sleeping;
+  std::mutex _sleep_mutex;
+  std::condition_variable _sleep_cv;
+
+  std::size_t grain_size(std::size_t n) const {
+    // Aim at about 8 chunks per thread: enough to balance irregular loads
+    // without paying for one task per element on large ranges
+    return std::max<std::size_t>(1, n / (8 * (nb_workers() + 1)));
+  }
+
+  template <typename RandomIt, typename Function>
+  void run_range(RandomIt first, RandomIt last, const Function &f,
+                 std::size_t grain) {
+    if (static_cast<std::size_t>(last - first) <= grain) {
+      for (RandomIt i = first; i != last; i++) {
+        f(*i);
+      }
+    } else {
+      RandomIt mid = first + ((last - first) / 2);
+      TaskGroup group(*this);
+      RangeTask<RandomIt, Function> right(*this, mid, last, f, grain);
+      group.spawn(right);
+      try {
+        run_range(first, mid, f, grain);
+      } catch (...) {
+        group.set_exception(std::current_exception());
+      }
+      group.wait();
+    }
+  }
+
+  bool is_worker() const { return _tl_scheduler == this; }
+
+  void submit(Task *t) {
+    if (is_worker()) {
+      _deques[_tl_worker]->push(t);
+    } else {
+      std::scoped_lock lock(_injection_mutex);
+      _injection_queue.push_back(t);
+    }
+    if (_nb_sleeping.load() > 0) {
+      _sleep_cv.notify_one();
+    }
+  }
+
+  Task *find_task() {
+    Task *t = nullptr;
+    if (is_worker()) {
+      t = _deques[_tl_worker]->pop();
+    }
+    if (!t) {
+      thread_local std::minstd_rand gen(std::random_device{}());
+      std::size_t n = _deques.size();
+      std::size_t start = gen() % n;
+      for (std::size_t i = 0; i < n && !t; i++) {
+        std::size_t victim = (start + i) % n;
+        if (!is_worker() || victim != _tl_worker) {
+          t = _deques[victim]->steal();
+        }
+      }
+    }
+    if (!t) {
+      std::scoped_lock lock(_injection_mutex);
+      if (!_injection_queue.empty()) {
+        t = _injection_queue.front();
+        _injection_queue.pop_front();
+      }
+    }
+    return t;
+  }
+
+  void execute(Task *t) {
+    TaskGroup *group = t->_group;
+    try {
+      t->execute();
+    } catch (...) {
+      group->set_exception(std::current_exception());
+    }
+    // Neither the task nor its group may be accessed after this point since
+    // the joining thread is then free to destroy them
+    group->_pending.fetch_sub(1, std::memory_order_acq_rel);
+  }
+
+  void wait_for(TaskGroup &group) {
+    while (group._pending.load(std::memory_order_acquire) > 0) {
+      Task *t = find_task();
+      if (t) {
+        execute(t);
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  void worker_loop(std::size_t index) {
+    _tl_scheduler = this;
+    _tl_worker = index;
+    std::size_t idle_rounds = 0;
+    while (!_stop.load()) {
+      Task *t = find_task();
+      if (t) {
+        execute(t);
+        idle_rounds = 0;
+      } else if (++idle_rounds < 64) {
+        std::this_thread::yield();
+      } else {
+        // The timed wait bounds the latency of a wake-up notification missed
+        // between the last unsuccessful search and the wait
+        std::unique_lock<std::mutex> lock(_sleep_mutex);
+        _nb_sleeping++;
+        if (!_stop.load()) {
+          _sleep_cv.wait_for(lock, std::chrono::milliseconds(1));
+        }
+        _nb_sleeping--;
+        idle_rounds = 0;
+      }
+    }
+  }
+};
+
+} // namespace skdecide
+
+#endif // SKDECIDE_WORK_STEALING_SCHEDULER_HH
@@ -0,0 +1,257 @@
+/* Copyright (c) AIRBUS and its affiliates.
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "utils/alpha_vector_matrix.hh"
+#include "utils/execution.hh"
+
+namespace {
+
+const auto is_greater = [](double v, double best) { return v > best; };
+const auto is_lower = [](double v, double best) { return v < best; };
+
+std::vector<skdecide::BeliefVector> random_beliefs(std::size_t nb_states,
+                                                   std::size_t nb_beliefs,
+                                                   std::mt19937 &gen) {
+  std::uniform_real_distribution<double> dist(0.0, 1.0);
+  std::vector<skdecide::BeliefVector> beliefs;
+  for (std::size_t k = 0; k < nb_beliefs; k++) {
+    // Alternates sparse (a few states) and dense (most states) beliefs
+    std::size_t support = (k % 2 == 0) ? 1 + gen() % 3 : nb_states;
+    std::vector<std::pair<std::size_t, double>> entries;
+    for (std::size_t i = 0; i < support; i++) {
+      entries.emplace_back(gen() % nb_states, dist(gen));
+    }
+    beliefs.emplace_back(nb_states, std::move(entries));
+  }
+  return beliefs;
+}
+
+std::vector<const skdecide::BeliefVector *>
+pointers(const std::vector<skdecide::BeliefVector> &beliefs) {
+  std::vector<const skdecide::BeliefVector *> result;
+  for (const auto &b : beliefs) {
+    result.push_back(&b);
+  }
+  return result;
+}
+
+template <typename Texecution_policy, typename Tis_better>
+void check_best_dots(const skdecide::AlphaVectorMatrix &m,
+                     const std::vector<skdecide::BeliefVector> &beliefs,
+                     const Tis_better &is_better, double init) {
+  std::vector<double> best;
+  std::vector<std::size_t> best_indices;
+  m.best_dots<Texecution_policy>(pointers(beliefs), is_better, init, best,
+                                 best_indices);
+  REQUIRE(best.size() == beliefs.size());
+  REQUIRE(best_indices.size() == beliefs.size());
+  for (std::size_t k = 0; k < beliefs.size(); k++) {
+    double expected = 0.0;
+    std::size_t expected_index =
+        m.best_dot(beliefs[k], is_better, init, expected);
+    REQUIRE(best_indices[k] == expected_index);
+    REQUIRE(best[k] == expected);
+    if (!m.empty()) {
+      REQUIRE_FALSE(m.removed(best_indices[k]));
+    }
+  }
+}
+
+template <typename Tis_better>
+void check_all_policies(const skdecide::AlphaVectorMatrix &m,
+                        const std::vector<skdecide::BeliefVector> &beliefs,
+                        const Tis_better &is_better, double init) {
+  check_best_dots<skdecide::SequentialExecution>(m, beliefs, is_better, init);
+  check_best_dots<skdecide::ParallelExecution>(m, beliefs, is_better, init);
+  check_best_dots<skdecide::WorkStealingExecution>(m, beliefs, is_better,
+                                                   init);
+}
+
+} // namespace
+
+TEST_CASE("Alpha-vector matrix rows", "[alpha-vectors]") {
+  skdecide::AlphaVectorMatrix m(13);
+  REQUIRE(m.empty());
+  for (std::size_t r = 0; r < 5; r++) {
+    std::vector<double> values(13, static_cast<double>(r));
+    m.append(values.data(), r % 2);
+  }
+  REQUIRE(m.size() == 5);
+  REQUIRE(m.nb_rows() == 5);
+  for (std::size_t r = 0; r < 5; r++) {
+    // Rows start on cache lines whatever the number of states
+    REQUIRE(reinterpret_cast<std::uintptr_t>(m.row(r)) % 64 == 0);
+    REQUIRE(m.action(r) == r % 2);
+    REQUIRE(m.row(r)[12] == static_cast<double>(r));
+  }
+
+  double *row = m.append(7);
+  REQUIRE(m.action(5) == 7);
+  for (std::size_t i = 0; i < 13; i++) {
+    REQUIRE(row[i] == 0.0);
+  }
+
+  m.reset(4);
+  REQUIRE(m.empty());
+  REQUIRE(m.nb_states() == 4);
+}
+
+TEST_CASE("Alpha-vector matrix lazy compaction", "[alpha-vectors]") {
+  const std::size_t nb_states = 5;
+  skdecide::AlphaVectorMatrix m(nb_states);
+  for (std::size_t r = 0; r < 10; r++) {
+    std::vector<double> values(nb_states, 0.0);
+    values[r % nb_states] = static_cast<double>(r);
+    m.append(values.data(), r);
+  }
+
+  // Removing up to max_removed_ratio of the rows keeps the row indices
+  for (std::size_t r = 0; r < 10; r += 2) {
+    m.remove(r);
+    m.remove(r); // removing twice counts once
+    REQUIRE_FALSE(m.compact_if_needed());
+  }
+  REQUIRE(m.size() == 5);
+  REQUIRE(m.nb_rows() == 10);
+  for (std::size_t r = 0; r < 10; r++) {
+    REQUIRE(m.removed(r) == (r % 2 == 0));
+    REQUIRE(m.action(r) == r);
+    REQUIRE(m.row(r)[r % nb_states] == static_cast<double>(r));
+  }
+
+  // Removed rows are skipped even if they are the best ones
+  skdecide::BeliefVector b(nb_states, {{3, 1.0}});
+  double best = 0.0;
+  REQUIRE(m.best_dot(b, is_greater, -1e10, best) == 3);
+  REQUIRE(best == 3.0);
+  m.remove(3);
+  REQUIRE(m.best_dot(b, is_greater, -1e10, best) == 1);
+  REQUIRE(best == 0.0);
+
+  // One more removal goes beyond the ratio: the remaining rows are moved to
+  // the front in the same order, with their actions
+  REQUIRE(m.compact_if_needed());
+  REQUIRE(m.size() == 4);
+  REQUIRE(m.nb_rows() == 4);
+  const std::size_t kept[] = {1, 5, 7, 9};
+  for (std::size_t i = 0; i < 4; i++) {
+    REQUIRE_FALSE(m.removed(i));
+    REQUIRE(m.action(i) == kept[i]);
+    REQUIRE(m.row(i)[kept[i] % nb_states] == static_cast<double>(kept[i]));
+  }
+  REQUIRE_FALSE(m.compact_if_needed());
+
+  // Rows appended after a compaction follow the compacted ones
+  std::vector<double> values(nb_states, 100.0);
+  m.append(values.data(), 42);
+  REQUIRE(m.best_dot(b, is_greater, -1e10, best) == 4);
+  REQUIRE(m.action(4) == 42);
+
+  m.remove(0);
+  m.remove(1);
+  m.remove(2);
+  m.remove(3);
+  m.remove(4);
+  REQUIRE(m.empty());
+  REQUIRE(m.best_dot(b, is_greater, -1e10, best) == 0);
+  REQUIRE(best == -1e10);
+  m.compact();
+  REQUIRE(m.nb_rows() == 0);
+}
+
+TEST_CASE("Alpha-vector matrix batched products", "[alpha-vectors]") {
+  std::mt19937 gen(3);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+
+  // Enough rows of 200 states for several tiles of rows, and enough beliefs
+  // for several blocks of beliefs
+  for (std::size_t nb_states : {1, 5, 13, 200}) {
+    skdecide::AlphaVectorMatrix m(nb_states);
+    std::vector<double> values(nb_states);
+    for (std::size_t r = 0; r < 500; r++) {
+      for (auto &v : values) {
+        v = dist(gen);
+      }
+      m.append(values.data(), r % 7);
+    }
+    auto beliefs = random_beliefs(nb_states, 37, gen);
+    check_all_policies(m, beliefs, is_greater, -1e10);
+    check_all_policies(m, beliefs, is_lower, 1e10);
+
+    for (std::size_t r = 0; r < 500; r += 3) {
+      m.remove(r);
+    }
+    check_all_policies(m, beliefs, is_greater, -1e10);
+
+    // Only the rows 3j+2 are left: the compaction moves them to row j, which
+    // keeps the best rows and their actions
+    for (std::size_t r = 1; r < 500; r += 3) {
+      m.remove(r);
+    }
+    std::vector<double> best;
+    std::vector<std::size_t> best_indices;
+    m.best_dots<skdecide::ParallelExecution>(pointers(beliefs), is_greater,
+                                             -1e10, best, best_indices);
+    std::vector<std::size_t> best_actions;
+    for (std::size_t i : best_indices) {
+      REQUIRE(i % 3 == 2);
+      best_actions.push_back(m.action(i));
+    }
+    std::vector<std::size_t> previous_indices = best_indices;
+    std::vector<double> previous_best = best;
+    REQUIRE(m.compact_if_needed());
+    REQUIRE(m.size() == m.nb_rows());
+    m.best_dots<skdecide::ParallelExecution>(pointers(beliefs), is_greater,
+                                             -1e10, best, best_indices);
+    for (std::size_t k = 0; k < beliefs.size(); k++) {
+      REQUIRE(best_indices[k] == previous_indices[k] / 3);
+      REQUIRE(best[k] == previous_best[k]);
+      REQUIRE(m.action(best_indices[k]) == best_actions[k]);
+    }
+    check_all_policies(m, beliefs, is_greater, -1e10);
+  }
+}
+
+TEST_CASE("Alpha-vector matrix ties", "[alpha-vectors]") {
+  // Copies of the same rows in every tile: the first copy must win whatever
+  // the execution policy, as in best_dot()
+  const std::size_t nb_states = 200;
+  skdecide::AlphaVectorMatrix m(nb_states);
+  std::vector<double> values(nb_states);
+  for (std::size_t r = 0; r < 400; r++) {
+    for (std::size_t i = 0; i < nb_states; i++) {
+      values[i] = static_cast<double>((r % 4) == (i % 4));
+    }
+    m.append(values.data(), r);
+  }
+  m.remove(1);
+
+  std::mt19937 gen(11);
+  auto beliefs = random_beliefs(nb_states, 50, gen);
+  std::vector<std::pair<std::size_t, double>> uniform;
+  for (std::size_t i = 0; i < nb_states; i++) {
+    uniform.emplace_back(i, 1.0 / nb_states);
+  }
+  beliefs.emplace_back(nb_states, uniform);
+  check_all_policies(m, beliefs, is_greater, -1e10);
+  check_all_policies(m, beliefs, is_lower, 1e10);
+
+  std::vector<double> best;
+  std::vector<std::size_t> best_indices;
+  m.best_dots<skdecide::ParallelExecution>(pointers(beliefs), is_greater,
+                                           -1e10, best, best_indices);
+  // The first copies are rows 0 to 3, and row 5 for the removed row 1
+  for (std::size_t k = 0; k < beliefs.size(); k++) {
+    REQUIRE(best_indices[k] < 6);
+  }
+  // All the rows tie on the uniform belief, and row 1 is removed
+  REQUIRE(best_indices.back() == 0);
+}
@@ -0,0 +1,213 @@
+/* Copyright (c) AIRBUS and its affiliates.
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <cstddef>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "utils/belief_vector.hh"
+
+namespace {
+
+// Random values in [-5, 5] with one leading padding value, so that the
+// kernels also run on addresses which are not aligned on a SIMD register
+std::vector<double> random_values(std::size_t n, std::mt19937 &gen) {
+  std::uniform_real_distribution<double> dist(-5.0, 5.0);
+  std::vector<double> values(n + 1);
+  for (auto &v : values) {
+    v = dist(gen);
+  }
+  return values;
+}
+
+std::vector<std::pair<std::size_t, double>>
+random_entries(std::size_t dimension, std::size_t nb_entries,
+               std::mt19937 &gen) {
+  std::uniform_real_distribution<double> dist(0.0, 1.0);
+  std::vector<std::pair<std::size_t, double>> entries;
+  for (std::size_t k = 0; k < nb_entries; k++) {
+    entries.emplace_back(gen() % dimension, dist(gen));
+  }
+  return entries;
+}
+
+} // namespace
+
+TEST_CASE("Belief kernels match scalar loops", "[belief]") {
+  std::mt19937 gen(42);
+
+  // Sizes cover the unrolled SIMD loops, the single register loops and the
+  // scalar remainders of the AVX2 and AVX-512 kernels
+  for (std::size_t n = 0; n <= 40; n++) {
+    std::vector<double> x = random_values(n, gen);
+    std::vector<double> y = random_values(n, gen);
+    const double *xp = x.data() + 1;
+    const double *yp = y.data() + 1;
+
+    double dot = 0.0;
+    for (std::size_t i = 0; i < n; i++) {
+      dot += xp[i] * yp[i];
+    }
+    REQUIRE(skdecide::belief_kernels::dense_dot(xp, yp, n) ==
+            Catch::Approx(dot).margin(1e-12));
+
+    std::vector<std::size_t> indices(n);
+    for (auto &i : indices) {
+      i = gen() % (n + 1);
+    }
+    double sparse = 0.0;
+    for (std::size_t k = 0; k < n; k++) {
+      sparse += xp[k] * y[indices[k]];
+    }
+    REQUIRE(skdecide::belief_kernels::sparse_dot(indices.data(), xp, n,
+                                                 y.data()) ==
+            Catch::Approx(sparse).margin(1e-12));
+
+    std::vector<double> product(x);
+    double sum = skdecide::belief_kernels::multiply_sum(product.data() + 1,
+                                                        yp, n);
+    double expected_sum = 0.0;
+    for (std::size_t i = 0; i < n; i++) {
+      REQUIRE(product[i + 1] == Catch::Approx(xp[i] * yp[i]));
+      expected_sum += xp[i] * yp[i];
+    }
+    REQUIRE(product[0] == x[0]);
+    REQUIRE(sum == Catch::Approx(expected_sum).margin(1e-12));
+
+    std::vector<double> scaled(x);
+    skdecide::belief_kernels::scale(scaled.data() + 1, 0.3, n);
+    for (std::size_t i = 0; i < n; i++) {
+      REQUIRE(scaled[i + 1] == Catch::Approx(0.3 * xp[i]));
+    }
+    REQUIRE(scaled[0] == x[0]);
+  }
+}
+
+TEST_CASE("Belief vectors match their entries", "[belief]") {
+  std::mt19937 gen(7);
+
+  for (std::size_t t = 0; t < 500; t++) {
+    std::size_t dimension = 1 + gen() % 100;
+    auto entries = random_entries(dimension, 1 + gen() % dimension, gen);
+    skdecide::BeliefVector b(dimension, entries);
+
+    std::vector<double> expected(dimension, 0.0);
+    for (const auto &e : entries) {
+      expected[e.first] += e.second;
+    }
+    std::size_t support = 0;
+    for (std::size_t i = 0; i < dimension; i++) {
+      REQUIRE(b[i] == Catch::Approx(expected[i]));
+      support += (expected[i] > 0.0);
+    }
+    REQUIRE(b.support_size() == support);
+    REQUIRE(b.is_dense() ==
+            (static_cast<double>(support) >=
+             skdecide::BeliefVector::dense_support_ratio *
+                 static_cast<double>(dimension)));
+
+    std::size_t previous = 0;
+    std::size_t visited = 0;
+    b.for_each([&](std::size_t i, double p) {
+      REQUIRE((visited == 0 || i > previous));
+      REQUIRE(p == Catch::Approx(expected[i]));
+      previous = i;
+      visited++;
+    });
+    REQUIRE(visited == support);
+
+    std::vector<double> alpha = random_values(dimension, gen);
+    double dot = 0.0;
+    for (std::size_t i = 0; i < dimension; i++) {
+      dot += expected[i] * alpha[i];
+    }
+    REQUIRE(b.dot(alpha.data()) == Catch::Approx(dot).margin(1e-12));
+  }
+}
+
+TEST_CASE("Belief vectors switch between sparse and dense storage",
+          "[belief]") {
+  // 16 states: beliefs whose support covers at least 4 states are dense
+  const std::size_t dimension = 16;
+  const std::size_t threshold = static_cast<std::size_t>(
+      skdecide::BeliefVector::dense_support_ratio * dimension);
+  std::vector<double> alpha(dimension);
+  for (std::size_t i = 0; i < dimension; i++) {
+    alpha[i] = 1.0 + static_cast<double>(i);
+  }
+
+  for (std::size_t support = 1; support <= dimension; support++) {
+    std::vector<std::pair<std::size_t, double>> entries;
+    double dot = 0.0;
+    for (std::size_t k = 0; k < support; k++) {
+      entries.emplace_back(dimension - 1 - 3 * k % dimension,
+                           1.0 / static_cast<double>(support));
+    }
+    for (const auto &e : entries) {
+      dot += e.second * alpha[e.first];
+    }
+    skdecide::BeliefVector b(dimension, entries);
+    REQUIRE(b.is_dense() == (support >= threshold));
+    REQUIRE(b.support_size() == support);
+    REQUIRE(b.dot(alpha.data()) == Catch::Approx(dot));
+  }
+
+  // Zero probabilities do not count in the support
+  skdecide::BeliefVector zeros(
+      dimension, {{0, 0.5}, {1, 0.5}, {2, 0.0}, {3, 0.0}, {4, 0.0}});
+  REQUIRE_FALSE(zeros.is_dense());
+  REQUIRE(zeros.support_size() == 2);
+
+  // A dense belief whose posterior only keeps a few states becomes sparse,
+  // and a sparse belief whose prediction spreads over the states becomes
+  // dense
+  skdecide::BeliefAccumulator accumulator;
+  double mass = 0.0;
+  std::vector<std::pair<std::size_t, double>> uniform_entries;
+  for (std::size_t i = 0; i < dimension; i++) {
+    uniform_entries.emplace_back(i, 1.0 / dimension);
+  }
+  skdecide::BeliefVector uniform(dimension, uniform_entries);
+  REQUIRE(uniform.is_dense());
+
+  accumulator.reset(dimension);
+  uniform.for_each([&accumulator](std::size_t i, double p) {
+    accumulator.add(i, p);
+  });
+  skdecide::BeliefVector narrow = accumulator.posterior(
+      [](std::size_t i) { return i < 2 ? 1.0 : 0.0; }, 1e-12, mass);
+  REQUIRE(mass == Catch::Approx(2.0 / dimension));
+  REQUIRE_FALSE(narrow.is_dense());
+  REQUIRE(narrow.support_size() == 2);
+  REQUIRE(narrow[0] == Catch::Approx(0.5));
+  REQUIRE(narrow[1] == Catch::Approx(0.5));
+  REQUIRE(narrow.dot(alpha.data()) == Catch::Approx(1.5));
+
+  accumulator.reset(dimension);
+  narrow.for_each([&accumulator, dimension](std::size_t i, double p) {
+    for (std::size_t j = i; j < dimension; j += 2) {
+      accumulator.add(j, p / static_cast<double>(dimension / 2));
+    }
+  });
+  skdecide::BeliefVector wide = accumulator.normalized(1e-12, mass);
+  REQUIRE(mass == Catch::Approx(1.0));
+  REQUIRE(wide.is_dense());
+  REQUIRE(wide.support_size() == dimension);
+  for (std::size_t i = 0; i < dimension; i++) {
+    REQUIRE(wide[i] == Catch::Approx(1.0 / dimension));
+  }
+
+  // Observations of zero probability give empty posteriors
+  accumulator.reset(dimension);
+  wide.for_each([&accumulator](std::size_t i, double p) {
+    accumulator.add(i, p);
+  });
+  skdecide::BeliefVector impossible =
+      accumulator.posterior([](std::size_t) { return 0.0; }, 1e-12, mass);
+  REQUIRE(impossible.empty());
+  REQUIRE(impossible.dimension() == dimension);
+}
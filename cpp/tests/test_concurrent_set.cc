@@ -0,0 +1,197 @@
+/* Copyright (c) AIRBUS and its affiliates.
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "utils/concurrent_set.hh"
+
+namespace {
+
+struct State {
+  int value;
+
+  struct Hash {
+    std::size_t operator()(const State &s) const {
+      return std::hash<int>()(s.value);
+    }
+  };
+
+  struct Equal {
+    bool operator()(const State &s1, const State &s2) const {
+      return s1.value == s2.value;
+    }
+  };
+};
+
+struct OrderedState {
+  int value;
+
+  struct Less {
+    bool operator()(const OrderedState &s1, const OrderedState &s2) const {
+      return s1.value < s2.value;
+    }
+  };
+};
+
+// Search graph node counting its constructions and moves
+struct Node {
+  static std::atomic<int> nb_constructions;
+  static std::atomic<int> nb_moves;
+
+  State state;
+  int data;
+
+  Node(const State &s) : state(s), data(0) { nb_constructions++; }
+  Node(int value, int d) : state{value}, data(d) { nb_constructions++; }
+  Node(Node &&n) : state(n.state), data(n.data) { nb_moves++; }
+
+  struct Key {
+    const State &operator()(const Node &n) const { return n.state; }
+  };
+};
+
+std::atomic<int> Node::nb_constructions(0);
+std::atomic<int> Node::nb_moves(0);
+
+// Few shards so that the threads often hit the same shards
+typedef skdecide::ConcurrentSet<Node, State, std::mutex, 4> NodeSet;
+
+} // namespace
+
+TEST_CASE("Concurrent set emplace", "[concurrent-set]") {
+  NodeSet s;
+  REQUIRE(NodeSet::nb_shards == 4);
+  REQUIRE(s.empty());
+  Node::nb_constructions = 0;
+  Node::nb_moves = 0;
+
+  // Emplacing from a RealKey hashes it directly
+  auto i1 = s.emplace(State{3});
+  REQUIRE(i1.second);
+  REQUIRE(i1.first->state.value == 3);
+  REQUIRE(Node::nb_constructions == 1);
+  REQUIRE(Node::nb_moves == 0);
+
+  // Other arguments build the element once, which is then moved into its
+  // shard
+  auto i2 = s.emplace(5, 7);
+  REQUIRE(i2.second);
+  REQUIRE(i2.first->data == 7);
+  REQUIRE(Node::nb_constructions == 2);
+  REQUIRE(Node::nb_moves == 1);
+
+  // Emplacing an existing element returns it unchanged
+  auto i3 = s.emplace(5, 8);
+  REQUIRE_FALSE(i3.second);
+  REQUIRE(i3.first == i2.first);
+  REQUIRE(i3.first->data == 7);
+  REQUIRE(s.emplace(State{3}).first == i1.first);
+
+  REQUIRE(s.size() == 2);
+  REQUIRE(s.find(Node(State{5})) == i2.first);
+  REQUIRE(s.count(Node(State{4})) == 0);
+  REQUIRE(s.find(Node(State{4})) == s.end());
+  REQUIRE(s.erase(Node(State{3})) == 1);
+  REQUIRE(s.erase(Node(State{3})) == 0);
+  REQUIRE(s.size() == 1);
+  s.clear();
+  REQUIRE(s.empty());
+  REQUIRE(s.begin() == s.end());
+}
+
+TEST_CASE("Concurrent set with ordered keys", "[concurrent-set]") {
+  skdecide::ConcurrentSet<OrderedState, OrderedState, std::mutex> s;
+  REQUIRE(s.nb_shards == 1);
+  for (int v : {4, 1, 3, 1}) {
+    s.emplace(OrderedState{v});
+  }
+  std::vector<int> values;
+  for (const auto &e : s) {
+    values.push_back(e.value);
+  }
+  REQUIRE(values == std::vector<int>{1, 3, 4});
+}
+
+TEST_CASE("Concurrent set from several threads", "[concurrent-set]") {
+  const int nb_threads = 8;
+  const int nb_own = 5000;
+  const int nb_common = 1000;
+  NodeSet s;
+  std::atomic<int> nb_common_inserted(0);
+  std::atomic<bool> failed(false);
+
+  // Each thread emplaces its own elements and all the common ones, looks them
+  // up and erases its odd elements. The iterators to its first elements must
+  // remain valid while the other threads insert in all the shards.
+  auto run = [&](int t) {
+    std::vector<NodeSet::iterator> first;
+    for (int i = 0; i < nb_own; i++) {
+      int value = nb_common + t * nb_own + i;
+      auto r = (i % 2 == 0) ? s.emplace(State{value}) : s.emplace(value, t);
+      if (!r.second || r.first->state.value != value) {
+        failed = true;
+      }
+      if (i < 100) {
+        first.push_back(r.first);
+      }
+      int common = (i * 7 + t) % nb_common;
+      auto c = s.emplace(common, t);
+      if (c.second) {
+        nb_common_inserted++;
+      }
+      if (c.first->state.value != common ||
+          s.find(Node(State{common})) != c.first) {
+        failed = true;
+      }
+      if (i % 2 == 1 && i >= 100 && s.erase(Node(State{value})) != 1) {
+        failed = true;
+      }
+    }
+    for (int i = 0; i < 100; i++) {
+      int value = nb_common + t * nb_own + i;
+      if (first[i]->state.value != value ||
+          s.find(Node(State{value})) != first[i]) {
+        failed = true;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < nb_threads; t++) {
+    threads.emplace_back(run, t);
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  REQUIRE_FALSE(failed);
+  REQUIRE(nb_common_inserted == nb_common);
+
+  std::set<int> expected;
+  for (int v = 0; v < nb_common; v++) {
+    expected.insert(v);
+  }
+  for (int t = 0; t < nb_threads; t++) {
+    for (int i = 0; i < nb_own; i++) {
+      if (i % 2 == 0 || i < 100) {
+        expected.insert(nb_common + t * nb_own + i);
+      }
+    }
+  }
+  std::set<int> contents;
+  std::size_t nb_elements = 0;
+  for (const auto &n : s) {
+    contents.insert(n.state.value);
+    nb_elements++;
+  }
+  REQUIRE(nb_elements == expected.size());
+  REQUIRE(contents == expected);
+  REQUIRE(s.size() == expected.size());
+}
@@ -0,0 +1,342 @@
+/* Copyright (c) AIRBUS and its affiliates.
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <algorithm>
+#include <atomic>
+#include <list>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "utils/execution.hh"
+#include "utils/work_stealing_scheduler.hh"
+#include "utils/rollout_lanes.hh"
+#include "hub/solver/lrtdp/lrtdp.hh"
+#include "hub/solver/lrtdp/impl/lrtdp_impl.hh"
+#include "hub/solver/ilaostar/ilaostar.hh"
+#include "hub/solver/ilaostar/impl/ilaostar_impl.hh"
+#include "utils/impl/logging_impl.hh"
+
+namespace {
+
+// Chain of states 0..size where action 'a' moves the agent a+1 steps forward
+// with probability 0.8 (and leaves it in place otherwise) for a cost of a+1
+class ChainDomain {
+public:
+  struct State {
+    int position;
+
+    State(int p = 0) : position(p) {}
+    std::string print() const { return std::to_string(position); }
+
+    struct Hash {
+      std::size_t operator()(const State &s) const {
+        return std::hash<int>()(s.position);
+      }
+    };
+
+    struct Equal {
+      bool operator()(const State &s1, const State &s2) const {
+        return s1.position == s2.position;
+      }
+    };
+  };
+
+  struct Action {
+    int steps;
+
+    Action(int s = 0) : steps(s) {}
+    std::string print() const { return std::to_string(steps); }
+
+    struct Hash {
+      std::size_t operator()(const Action &a) const {
+        return std::hash<int>()(a.steps);
+      }
+    };
+
+    struct Equal {
+      bool operator()(const Action &a1, const Action &a2) const {
+        return a1.steps == a2.steps;
+      }
+    };
+  };
+
+  class Value {
+  public:
+    Value(double v = 0.0, bool reward = true) : _reward(reward ? v : -v) {}
+    double cost() const { return -_reward; }
+    double reward() const { return _reward; }
+    void cost(double c) { _reward = -c; }
+    void reward(double r) { _reward = r; }
+
+  private:
+    double _reward;
+  };
+
+  struct Predicate {
+    bool value;
+
+    Predicate(bool v = false) : value(v) {}
+    operator bool() const { return value; }
+  };
+
+  struct ApplicableActionSpace {
+    std::vector<Action> actions;
+    const std::vector<Action> &get_elements() const { return actions; }
+  };
+
+  struct Outcome {
+    State s;
+    double p;
+    const State &state() const { return s; }
+    const double &probability() const { return p; }
+  };
+
+  struct NextStateDistribution {
+    std::vector<Outcome> outcomes;
+    const std::vector<Outcome> &get_values() const { return outcomes; }
+  };
+
+  ChainDomain(int size) : _size(size) {}
+
+  int size() const { return _size; }
+
+  std::size_t get_parallel_capacity() const { return 4; }
+
+  ApplicableActionSpace get_applicable_actions(const State &,
+                                               const std::size_t * = nullptr) {
+    return ApplicableActionSpace{{Action(0), Action(1)}};
+  }
+
+  NextStateDistribution
+  get_next_state_distribution(const State &s, const Action &a,
+                              const std::size_t * = nullptr) {
+    return NextStateDistribution{
+        {{State(std::min(_size, s.position + 1 + a.steps)), 0.8},
+         {s, 0.2}}};
+  }
+
+  Value get_transition_value(const State &, const Action &a, const State &,
+                             const std::size_t * = nullptr) {
+    return Value(1.0 + a.steps, false);
+  }
+
+  Predicate is_terminal(const State &s, const std::size_t * = nullptr) {
+    return Predicate(s.position == _size);
+  }
+
+private:
+  int _size;
+};
+
+template <typename Texecution_policy> double solve_chain_with_lrtdp() {
+  ChainDomain domain(30);
+  skdecide::LRTDPSolver<ChainDomain, Texecution_policy> solver(
+      domain,
+      [](ChainDomain &d, const ChainDomain::State &s, const std::size_t *) {
+        return ChainDomain::Predicate(s.position == d.size());
+      },
+      [](ChainDomain &, const ChainDomain::State &, const std::size_t *) {
+        return ChainDomain::Value(0.0, false);
+      });
+  solver.solve(ChainDomain::State(0));
+  REQUIRE(solver.is_solution_defined_for(ChainDomain::State(0)));
+  return solver.get_best_value(ChainDomain::State(0)).cost();
+}
+
+template <typename Texecution_policy> double solve_chain_with_ilaostar() {
+  ChainDomain domain(30);
+  skdecide::ILAOStarSolver<ChainDomain, Texecution_policy> solver(
+      domain,
+      [](ChainDomain &d, const ChainDomain::State &s) {
+        return ChainDomain::Predicate(s.position == d.size());
+      },
+      [](ChainDomain &, const ChainDomain::State &) {
+        return ChainDomain::Value(0.0, false);
+      });
+  solver.solve(ChainDomain::State(0));
+  REQUIRE(solver.is_solution_defined_for(ChainDomain::State(0)));
+  return solver.get_best_value(ChainDomain::State(0)).cost();
+}
+
+} // namespace
+
+TEST_CASE("Work-stealing deque order", "[execution]") {
+  skdecide::WorkStealingDeque<int> deque;
+  std::vector<int> v(200);
+  std::iota(v.begin(), v.end(), 0);
+  REQUIRE(deque.pop() == nullptr);
+  REQUIRE(deque.steal() == nullptr);
+  for (auto &i : v) { // grows the initial 64-element array
+    deque.push(&i);
+  }
+  REQUIRE(deque.pop() == &v[199]);
+  REQUIRE(deque.steal() == &v[0]);
+  REQUIRE(deque.steal() == &v[1]);
+  REQUIRE(deque.pop() == &v[198]);
+  int n = 0;
+  while (deque.pop() != nullptr) {
+    n++;
+  }
+  REQUIRE(n == 196);
+  REQUIRE(deque.steal() == nullptr);
+}
+
+TEST_CASE("Work-stealing deque under contention", "[execution]") {
+  const int nb_elements = 100000;
+  const int nb_thieves = 4;
+  skdecide::WorkStealingDeque<int> deque;
+  std::vector<int> v(nb_elements);
+  std::iota(v.begin(), v.end(), 0);
+  std::vector<std::atomic<int>> taken(nb_elements);
+  for (auto &t : taken) {
+    t.store(0);
+  }
+  std::atomic<int> nb_taken(0);
+  std::atomic<bool> done(false);
+
+  std::vector<std::thread> thieves;
+  for (int t = 0; t < nb_thieves; t++) {
+    thieves.emplace_back([&]() {
+      while (!done.load()) {
+        int *e = deque.steal();
+        if (e != nullptr) {
+          taken[*e]++;
+          nb_taken++;
+        }
+      }
+    });
+  }
+
+  // The owner interleaves pushes and pops so that it races with the thieves
+  // on the last elements of the deque
+  for (int i = 0; i < nb_elements; i++) {
+    deque.push(&v[i]);
+    if (i % 3 == 0) {
+      int *e = deque.pop();
+      if (e != nullptr) {
+        taken[*e]++;
+        nb_taken++;
+      }
+    }
+  }
+  while (int *e = deque.pop()) {
+    taken[*e]++;
+    nb_taken++;
+  }
+  while (nb_taken.load() < nb_elements) {
+    std::this_thread::yield();
+  }
+  done.store(true);
+  for (auto &t : thieves) {
+    t.join();
+  }
+
+  REQUIRE(nb_taken.load() == nb_elements);
+  REQUIRE(std::all_of(taken.begin(), taken.end(),
+                      [](const std::atomic<int> &t) { return t.load() == 1; }));
+}
+
+TEST_CASE("Work-stealing scheduler", "[execution]") {
+  skdecide::WorkStealingScheduler scheduler(3);
+  REQUIRE(scheduler.nb_workers() == 3);
+
+  // Nested parallel loops spawn subtasks stolen by the workers
+  std::vector<int> outer(64);
+  std::iota(outer.begin(), outer.end(), 0);
+  std::atomic<long> sum(0);
+  scheduler.parallel_for(outer.begin(), outer.end(), [&](const int &i) {
+    std::vector<int> inner(1000);
+    std::iota(inner.begin(), inner.end(), 0);
+    scheduler.parallel_for(inner.begin(), inner.end(),
+                           [&](const int &j) { sum += i * 1000 + j; });
+  });
+  REQUIRE(sum.load() == (64L * 1000L) * (64L * 1000L - 1L) / 2L);
+
+  // Exceptions thrown by tasks are rethrown when joining their group
+  skdecide::WorkStealingScheduler::TaskGroup group(scheduler);
+  std::atomic<int> nb_runs(0);
+  for (int i = 0; i < 16; i++) {
+    group.run([&nb_runs, i]() {
+      nb_runs++;
+      if (i == 7) {
+        throw std::runtime_error("task failure");
+      }
+    });
+  }
+  REQUIRE_THROWS_AS(group.wait(), std::runtime_error);
+  REQUIRE(nb_runs.load() == 16);
+
+  // Non random-access ranges
+  std::list<int> l(outer.begin(), outer.end());
+  std::atomic<int> lsum(0);
+  scheduler.parallel_for(l.begin(), l.end(), [&](const int &i) { lsum += i; });
+  REQUIRE(lsum.load() == 64 * 63 / 2);
+}
+
+TEST_CASE("Solvers with work-stealing execution", "[execution]") {
+  double lrtdp_seq = solve_chain_with_lrtdp<skdecide::SequentialExecution>();
+  double lrtdp_ws = solve_chain_with_lrtdp<skdecide::WorkStealingExecution>();
+  REQUIRE(lrtdp_ws == Catch::Approx(lrtdp_seq).epsilon(1e-2));
+
+  double ilaostar_seq =
+      solve_chain_with_ilaostar<skdecide::SequentialExecution>();
+  double ilaostar_ws =
+      solve_chain_with_ilaostar<skdecide::WorkStealingExecution>();
+  REQUIRE(ilaostar_ws == Catch::Approx(ilaostar_seq).epsilon(1e-3));
+  REQUIRE(ilaostar_ws == Catch::Approx(lrtdp_seq).epsilon(1e-2));
+}
+
+TEST_CASE("Rollout lanes", "[execution]") {
+  const std::size_t nb_lanes = 6;
+  std::vector<std::atomic<int>> runs(nb_lanes);
+  for (auto &r : runs) {
+    r.store(0);
+  }
+  std::atomic<int> nested_sum(0);
+  skdecide::for_each_rollout_lane<skdecide::ParallelExecution>(
+      nb_lanes, [&](const std::size_t &lane) {
+        runs[lane]++;
+        std::vector<int> v(100);
+        std::iota(v.begin(), v.end(), 0);
+        std::for_each(skdecide::ParallelExecution::policy, v.begin(), v.end(),
+                      [&nested_sum](const int &i) { nested_sum += i; });
+      });
+  REQUIRE(std::all_of(runs.begin(), runs.end(),
+                      [](const std::atomic<int> &r) { return r.load() == 1; }));
+  REQUIRE(nested_sum.load() == (int)nb_lanes * 99 * 50);
+
+#if !defined(HAS_EXECUTION) && defined(HAS_OPENMP)
+  // Each lane gets its share of the OpenMP threads for its nested loops, and
+  // the calling thread gets all of them back
+  const int max_threads = omp_get_max_threads();
+  std::vector<int> lane_threads(nb_lanes, 0);
+  skdecide::for_each_rollout_lane<skdecide::ParallelExecution>(
+      nb_lanes, [&lane_threads](const std::size_t &lane) {
+        lane_threads[lane] = omp_get_max_threads();
+      });
+  for (int t : lane_threads) {
+    REQUIRE(t == std::max(1, max_threads / (int)nb_lanes));
+  }
+  REQUIRE(omp_get_max_threads() == max_threads);
+#endif
+
+  // The first exception is rethrown once all the lanes are finished
+  std::atomic<int> nb_runs(0);
+  REQUIRE_THROWS_AS(
+      skdecide::for_each_rollout_lane<skdecide::WorkStealingExecution>(
+          nb_lanes,
+          [&nb_runs](const std::size_t &lane) {
+            nb_runs++;
+            if (lane % 2 == 1) {
+              throw std::runtime_error("lane failure");
+            }
+          }),
+      std::runtime_error);
+  REQUIRE(nb_runs.load() == (int)nb_lanes);
+}
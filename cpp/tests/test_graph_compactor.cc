@@ -0,0 +1,235 @@
+/* Copyright (c) AIRBUS and its affiliates.
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "utils/execution.hh"
+#include "utils/graph_compactor.hh"
+
+namespace {
+
+// Graph whose nodes are identified by integers, with the edges
+//   0 -> {1, 2}, 1 -> {3}, 2 -> {4}, 3 -> {4}
+// so that moving the root from 0 to 2 makes the nodes 0, 1 and 3 unreachable
+template <typename Texecution_policy> struct TestGraph {
+  struct Node {
+    int id;
+    std::vector<Node *> children;
+    typename Texecution_policy::template atomic<std::size_t> epoch;
+
+    Node(int i) : id(i), epoch(0) {}
+  };
+
+  typedef skdecide::GraphCompactor<Texecution_policy, Node> Compactor;
+
+  std::map<int, std::unique_ptr<Node>> nodes;
+  std::set<int> erased;
+  std::vector<int> erasure_order;
+  // Alive children of the erased nodes when they were erased
+  std::map<int, std::vector<int>> alive_children;
+  std::atomic<bool> blocked;
+
+  TestGraph() : blocked(false) {
+    for (int i = 0; i < 5; i++) {
+      nodes.emplace(i, std::make_unique<Node>(i));
+    }
+    link(0, 1);
+    link(0, 2);
+    link(1, 3);
+    link(2, 4);
+    link(3, 4);
+  }
+
+  void link(int parent, int child) {
+    nodes[parent]->children.push_back(nodes[child].get());
+  }
+
+  Node &operator[](int i) { return *nodes.at(i); }
+
+  // The traversals wait while blocked is set, so that the tests can act
+  // before the background compaction moves on
+  std::unique_ptr<Compactor> compactor(std::size_t step_budget) {
+    return std::make_unique<Compactor>(
+        [this](Node &n, std::vector<Node *> &children) {
+          while (blocked) {
+            std::this_thread::yield();
+          }
+          children.insert(children.end(), n.children.begin(),
+                          n.children.end());
+        },
+        [this](Node &n, const std::function<bool(Node *)> &alive) {
+          for (auto &c : n.children) {
+            if (alive(c)) {
+              alive_children[n.id].push_back(c->id);
+            }
+          }
+          erased.insert(n.id);
+          erasure_order.push_back(n.id);
+        },
+        step_budget);
+  }
+};
+
+} // namespace
+
+TEST_CASE("Graph compactor mark, collect and erase", "[compactor]") {
+  SECTION("Sequential execution") {
+    TestGraph<skdecide::SequentialExecution> g;
+    auto compactor = g.compactor(1000);
+    REQUIRE_FALSE(compactor->active());
+
+    // Moving the root without previous root only stamps the new root's
+    // subgraph
+    compactor->retire(nullptr, g[0]);
+    REQUIRE(compactor->epoch() == 1);
+    compactor->finish();
+    REQUIRE_FALSE(compactor->active());
+    REQUIRE(g.erased.empty());
+    for (int i = 0; i < 5; i++) {
+      REQUIRE(g[i].epoch == 1);
+    }
+
+    compactor->retire(&g[0], g[2]);
+    REQUIRE(compactor->epoch() == 2);
+    REQUIRE(compactor->active());
+    // One step of 1000 nodes is enough for this graph
+    compactor->step();
+    REQUIRE(g.erased == std::set<int>{0, 1, 3});
+    compactor->step();
+    REQUIRE_FALSE(compactor->active());
+    REQUIRE(g[2].epoch == 2);
+    REQUIRE(g[4].epoch == 2);
+
+    // The erased nodes are told about their children which are kept, and
+    // about their collected children only if these are not erased yet
+    auto erased_before = [&g](int n1, int n2) {
+      auto &o = g.erasure_order;
+      return std::find(o.begin(), o.end(), n1) <
+             std::find(o.begin(), o.end(), n2);
+    };
+    REQUIRE(g.alive_children[3] == std::vector<int>{4});
+    REQUIRE(g.alive_children[0] ==
+            (erased_before(0, 1) ? std::vector<int>{1, 2}
+                                 : std::vector<int>{2}));
+    REQUIRE(g.alive_children[1] ==
+            (erased_before(1, 3) ? std::vector<int>{3} : std::vector<int>{}));
+  }
+
+  SECTION("Work-stealing execution") {
+    TestGraph<skdecide::WorkStealingExecution> g;
+    auto compactor = g.compactor(1);
+    compactor->retire(nullptr, g[0]);
+    compactor->finish();
+    compactor->retire(&g[0], g[2]);
+    compactor->finish();
+    REQUIRE_FALSE(compactor->active());
+    REQUIRE(g.erased == std::set<int>{0, 1, 3});
+  }
+}
+
+TEST_CASE("Graph compactor write barrier", "[compactor]") {
+  TestGraph<skdecide::SequentialExecution> g;
+  auto compactor = g.compactor(1);
+  compactor->retire(nullptr, g[0]);
+  compactor->finish();
+
+  // With one node per step, the 5 first steps mark 2 and 4 then collect 0, 1
+  // and 3, and the erasure happens at the 6th step
+  compactor->retire(&g[0], g[2]);
+  for (int s = 0; s < 5; s++) {
+    compactor->step();
+  }
+  REQUIRE(g.erased.empty());
+
+  // The search reaches the collected node 1 again: it is kept with its
+  // descendants, and only the root 0 is erased
+  compactor->retain(g[1]);
+  REQUIRE(g[1].epoch == 2);
+  REQUIRE(g[3].epoch == 2);
+  compactor->finish();
+  REQUIRE(g.erased == std::set<int>{0});
+  REQUIRE(g.alive_children[0] == std::vector<int>{1, 2});
+
+  // Retaining an up-to-date node does nothing
+  compactor->retain(g[2]);
+  REQUIRE(g[2].epoch == 2);
+}
+
+TEST_CASE("Graph compactor guards", "[compactor]") {
+  TestGraph<skdecide::WorkStealingExecution> g;
+  auto compactor = g.compactor(1);
+  compactor->retire(nullptr, g[0]);
+  compactor->finish();
+
+  // No compaction is active: the guard doesn't lock anything
+  { auto guard = compactor->guard(); }
+
+  g.blocked = true;
+  compactor->retire(&g[0], g[2]);
+  {
+    auto guard = compactor->guard();
+    g.blocked = false;
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    // The traversals run concurrently with the guard but not the erasure
+    REQUIRE(g.erased.empty());
+  }
+  compactor->finish();
+  REQUIRE(g.erased == std::set<int>{0, 1, 3});
+}
+
+TEST_CASE("Graph compactor cancellation", "[compactor]") {
+  SECTION("Sequential execution") {
+    TestGraph<skdecide::SequentialExecution> g;
+    auto compactor = g.compactor(1);
+    compactor->retire(nullptr, g[0]);
+    compactor->finish();
+    compactor->retire(&g[0], g[2]);
+    compactor->step();
+    compactor->cancel();
+    REQUIRE_FALSE(compactor->active());
+    compactor->step();
+    compactor->finish();
+    REQUIRE(g.erased.empty());
+
+    // A new compaction after the cancellation starts from scratch
+    compactor->retire(&g[2], g[4]);
+    compactor->finish();
+    REQUIRE(g.erased == std::set<int>{2});
+  }
+
+  SECTION("Work-stealing execution") {
+    TestGraph<skdecide::WorkStealingExecution> g;
+    auto compactor = g.compactor(1);
+    compactor->retire(nullptr, g[0]);
+    compactor->finish();
+
+    g.blocked = true;
+    compactor->retire(&g[0], g[2]);
+    // Unblocks the compaction thread once it is waiting in a traversal, so
+    // that cancel() sets the cancellation flag before the next step
+    std::thread unblock([&g]() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      g.blocked = false;
+    });
+    compactor->cancel();
+    unblock.join();
+    REQUIRE_FALSE(compactor->active());
+    REQUIRE(g.erased.empty());
+
+    // The compactor is destroyed while compacting
+    g.blocked = true;
+    compactor->retire(&g[2], g[4]);
+    g.blocked = false;
+    compactor.reset();
+  }
+}
@@ -0,0 +1,242 @@
+/* Copyright (c) AIRBUS and its affiliates.
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "utils/execution.hh"
+#include "utils/logging.hh"
+#include "hub/solver/mcts/mcts.hh"
+#include "hub/solver/mcts/impl/mcts_impl.hh"
+#include "hub/solver/mcts/impl/mcts_step_transition_mode_impl.hh"
+#include "hub/solver/mcts/impl/mcts_sample_transition_mode_impl.hh"
+#include "hub/solver/mcts/impl/mcts_distribution_transition_mode_impl.hh"
+#include "hub/solver/mcts/impl/mcts_default_tree_policy_impl.hh"
+#include "hub/solver/mcts/impl/mcts_root_parallel_tree_policy_impl.hh"
+#include "hub/solver/mcts/impl/mcts_full_expand_impl.hh"
+#include "hub/solver/mcts/impl/mcts_partial_expand_impl.hh"
+#include "hub/solver/mcts/impl/mcts_ucb1_action_selector_impl.hh"
+#include "hub/solver/mcts/impl/mcts_best_qvalue_action_selector_impl.hh"
+#include "hub/solver/mcts/impl/mcts_default_rollout_policy_impl.hh"
+#include "hub/solver/mcts/impl/mcts_leaf_parallel_rollout_policy_impl.hh"
+#include "hub/solver/mcts/impl/mcts_graph_backup_impl.hh"
+#include "utils/impl/logging_impl.hh"
+
+namespace {
+
+// Corridor of states 0..size where action 'walk' moves the agent one step
+// forward for a cost of 1 and action 'jump' moves it two steps forward for a
+// cost of 1.2, so that jumping is the best action everywhere
+class CorridorDomain {
+public:
+  struct State {
+    int position;
+
+    State(int p = 0) : position(p) {}
+    std::string print() const { return std::to_string(position); }
+
+    struct Hash {
+      std::size_t operator()(const State &s) const {
+        return std::hash<int>()(s.position);
+      }
+    };
+
+    struct Equal {
+      bool operator()(const State &s1, const State &s2) const {
+        return s1.position == s2.position;
+      }
+    };
+  };
+
+  struct Action {
+    int jump;
+
+    Action(int j = 0) : jump(j) {}
+    std::string print() const { return jump ? "jump" : "walk"; }
+
+    struct Hash {
+      std::size_t operator()(const Action &a) const {
+        return std::hash<int>()(a.jump);
+      }
+    };
+
+    struct Equal {
+      bool operator()(const Action &a1, const Action &a2) const {
+        return a1.jump == a2.jump;
+      }
+    };
+  };
+
+  class Value {
+  public:
+    Value(double v = 0.0, bool reward = true) : _reward(reward ? v : -v) {}
+    double cost() const { return -_reward; }
+    double reward() const { return _reward; }
+    void cost(double c) { _reward = -c; }
+    void reward(double r) { _reward = r; }
+
+  private:
+    double _reward;
+  };
+
+  struct Predicate {
+    bool value;
+
+    Predicate(bool v = false) : value(v) {}
+    operator bool() const { return value; }
+  };
+
+  struct ApplicableActionSpace {
+    std::vector<Action> actions;
+    const std::vector<Action> &get_elements() const { return actions; }
+    Action sample() const { return actions[std::rand() % actions.size()]; }
+    bool empty() const { return actions.empty(); }
+  };
+
+  struct Outcome {
+    State s;
+    double p;
+    const State &state() const { return s; }
+    const double &probability() const { return p; }
+  };
+
+  struct NextStateDistribution {
+    std::vector<Outcome> outcomes;
+    const std::vector<Outcome> &get_values() const { return outcomes; }
+  };
+
+  struct EnvironmentOutcome {
+    State s;
+    Value v;
+    bool t;
+    const State &observation() const { return s; }
+    const Value &transition_value() const { return v; }
+    Predicate termination() const { return Predicate(t); }
+  };
+
+  CorridorDomain(int size, std::size_t capacity)
+      : _size(size), _capacity(capacity) {}
+
+  std::size_t get_parallel_capacity() const { return _capacity; }
+
+  ApplicableActionSpace get_applicable_actions(const State &,
+                                               const std::size_t * = nullptr) {
+    return ApplicableActionSpace{{Action(0), Action(1)}};
+  }
+
+  NextStateDistribution
+  get_next_state_distribution(const State &s, const Action &a,
+                              const std::size_t * = nullptr) {
+    return NextStateDistribution{{{next(s, a), 1.0}}};
+  }
+
+  EnvironmentOutcome sample(const State &s, const Action &a,
+                            const std::size_t * = nullptr) {
+    State ns = next(s, a);
+    return EnvironmentOutcome{ns, get_transition_value(s, a, ns),
+                              is_terminal(ns)};
+  }
+
+  Value get_transition_value(const State &, const Action &a, const State &,
+                             const std::size_t * = nullptr) {
+    return Value(a.jump ? 1.2 : 1.0, false);
+  }
+
+  Predicate is_terminal(const State &s, const std::size_t * = nullptr) {
+    return Predicate(s.position == _size);
+  }
+
+private:
+  int _size;
+  std::size_t _capacity;
+
+  State next(const State &s, const Action &a) const {
+    return State(std::min(_size, s.position + 1 + a.jump));
+  }
+};
+
+template <typename Tsolver>
+typename CorridorDomain::Action
+solve_corridor(std::size_t capacity,
+               std::unique_ptr<typename Tsolver::TreePolicy> tree_policy,
+               std::unique_ptr<typename Tsolver::RolloutPolicy> rollout_policy,
+               double &best_value) {
+  CorridorDomain domain(6, capacity);
+  Tsolver solver(
+      domain, 3600000, 4000, 50, 100, 0.0, 1.0, false,
+      [](const Tsolver &, CorridorDomain &, const std::size_t *) {
+        return false;
+      },
+      false, std::move(tree_policy),
+      std::make_unique<typename Tsolver::Expander>(),
+      std::make_unique<typename Tsolver::ActionSelectorOptimization>(),
+      std::make_unique<typename Tsolver::ActionSelectorExecution>(),
+      std::move(rollout_policy));
+  solver.solve(CorridorDomain::State(0));
+  REQUIRE(solver.is_solution_defined_for(CorridorDomain::State(0)));
+  REQUIRE(solver.get_nb_rollouts() > 0);
+  best_value = solver.get_best_value(CorridorDomain::State(0)).reward();
+  return solver.get_best_action(CorridorDomain::State(0));
+}
+
+template <typename Texecution_policy> void check_parallel_policies() {
+  typedef skdecide::MCTSSolver<CorridorDomain, Texecution_policy,
+                               skdecide::DistributionTransitionMode,
+                               skdecide::RootParallelTreePolicy>
+      RootSolver;
+  typedef skdecide::MCTSSolver<
+      CorridorDomain, Texecution_policy, skdecide::DistributionTransitionMode,
+      skdecide::DefaultTreePolicy, skdecide::FullExpand,
+      skdecide::UCB1ActionSelector, skdecide::BestQValueActionSelector,
+      skdecide::LeafParallelRolloutPolicy>
+      LeafSolver;
+
+  double root_value = 0.0;
+  CorridorDomain::Action root_action = solve_corridor<RootSolver>(
+      4, std::make_unique<typename RootSolver::TreePolicy>(1.0),
+      std::make_unique<typename RootSolver::RolloutPolicy>(), root_value);
+  REQUIRE(root_action.jump == 1);
+
+  // 2 tree lanes of 4 rollouts each, then a single tree lane of 3 rollouts
+  // (rollouts beyond the domain's capacity are dropped)
+  for (std::size_t capacity : {8, 3}) {
+    double leaf_value = 0.0;
+    CorridorDomain::Action leaf_action = solve_corridor<LeafSolver>(
+        capacity, std::make_unique<typename LeafSolver::TreePolicy>(),
+        std::make_unique<typename LeafSolver::RolloutPolicy>(4), leaf_value);
+    REQUIRE(leaf_action.jump == 1);
+    REQUIRE(leaf_value == Catch::Approx(root_value).margin(0.5));
+  }
+}
+
+} // namespace
+
+TEST_CASE("MCTS parallelization policies", "[mcts]") {
+  skdecide::LeafParallelRolloutPolicy<
+      skdecide::MCTSSolver<CorridorDomain, skdecide::ParallelExecution>>
+      policy(6);
+  REQUIRE(policy.lanes_per_leaf(4) == 4);
+  REQUIRE(policy.lanes_per_leaf(8) == 6);
+  REQUIRE(policy.lanes_per_leaf(0) == 1);
+
+  skdecide::RootParallelTreePolicy<
+      skdecide::MCTSSolver<CorridorDomain, skdecide::ParallelExecution>>
+      tree_policy;
+  REQUIRE(tree_policy.nb_trees(4) == 4);
+  skdecide::DefaultTreePolicy<
+      skdecide::MCTSSolver<CorridorDomain, skdecide::ParallelExecution>>
+      shared_tree_policy;
+  REQUIRE(shared_tree_policy.nb_trees(4) == 1);
+}
+
+TEST_CASE("MCTS root and leaf parallelization", "[mcts]") {
+  check_parallel_policies<skdecide::SequentialExecution>();
+  check_parallel_policies<skdecide::ParallelExecution>();
+  check_parallel_policies<skdecide::WorkStealingExecution>();
+}
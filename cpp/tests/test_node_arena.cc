@@ -0,0 +1,257 @@
+/* Copyright (c) AIRBUS and its affiliates.
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <cstddef>
+#include <list>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "utils/execution.hh"
+#include "utils/node_arena.hh"
+
+namespace {
+
+struct Counted {
+  static std::atomic<int> alive;
+  int value;
+
+  Counted(int v) : value(v) {
+    if (v < 0) {
+      throw std::invalid_argument("negative value");
+    }
+    alive++;
+  }
+
+  ~Counted() { alive--; }
+};
+
+std::atomic<int> Counted::alive(0);
+
+// Single objects allocated by a container besides its nodes, like the
+// container proxy of MSVC debug builds
+struct Proxy {
+  void *first;
+  void *second;
+};
+
+struct Node {
+  double values[4];
+};
+
+} // namespace
+
+TEST_CASE("Node arena", "[node-arena]") {
+  skdecide::NodeArena<Counted> arena;
+  REQUIRE(arena.empty());
+  REQUIRE(arena.memory_usage() == 0);
+
+  std::vector<Counted *> objects;
+  for (int i = 0; i < 64; i++) {
+    objects.push_back(arena.create(nullptr, i));
+  }
+  REQUIRE(arena.size() == 64);
+  REQUIRE(Counted::alive == 64);
+  const std::size_t first_chunk = arena.memory_usage();
+  REQUIRE(first_chunk > 0);
+  // The first chunk is carved in order
+  const std::size_t slot_size = first_chunk / 64;
+  for (std::size_t i = 1; i < objects.size(); i++) {
+    REQUIRE(reinterpret_cast<char *>(objects[i]) -
+                reinterpret_cast<char *>(objects[i - 1]) ==
+            static_cast<std::ptrdiff_t>(slot_size));
+  }
+
+  // The first chunk is full: a freed slot is reused before a new chunk is
+  // allocated
+  arena.destroy(objects[10]);
+  REQUIRE(arena.create(nullptr, 10) == objects[10]);
+  REQUIRE(arena.memory_usage() == first_chunk);
+
+  // The next chunk is twice as large
+  Counted *extra = arena.create(nullptr, 64);
+  REQUIRE(arena.memory_usage() == 3 * first_chunk);
+
+  // A throwing constructor returns its slot to the arena
+  REQUIRE_THROWS_AS(arena.create(nullptr, -1), std::invalid_argument);
+  REQUIRE(arena.size() == 65);
+
+  REQUIRE_FALSE(arena.release());
+  for (std::size_t i = 0; i < objects.size(); i++) {
+    REQUIRE(objects[i]->value == static_cast<int>(i));
+    arena.destroy(objects[i]);
+  }
+  {
+    auto p = arena.make(nullptr, 7);
+    REQUIRE(p->value == 7);
+  }
+  REQUIRE(arena.size() == 1);
+  arena.destroy(extra);
+  REQUIRE(arena.empty());
+  REQUIRE(Counted::alive == 0);
+  REQUIRE(arena.release());
+  REQUIRE(arena.memory_usage() == 0);
+
+  // The arena starts over from the smallest chunk
+  arena.destroy(arena.create(nullptr, 0));
+  REQUIRE(arena.memory_usage() == first_chunk);
+}
+
+TEST_CASE("Node arena lanes", "[node-arena]") {
+  const std::size_t nb_threads = 4;
+  const int nb_objects = 10000;
+  skdecide::NodeArena<Counted, skdecide::WorkStealingExecution> arena(
+      nb_threads);
+  std::vector<std::vector<Counted *>> objects(nb_threads);
+
+  // Each thread allocates from its lane, then frees the objects of the next
+  // thread to the shared free list, which the lanes then reuse
+  auto run = [&](std::size_t thread_id) {
+    for (int i = 0; i < nb_objects; i++) {
+      objects[thread_id].push_back(
+          arena.create(&thread_id, static_cast<int>(thread_id) + i));
+    }
+  };
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < nb_threads; t++) {
+    threads.emplace_back(run, t);
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  threads.clear();
+  REQUIRE(arena.size() == nb_threads * nb_objects);
+
+  for (std::size_t t = 0; t < nb_threads; t++) {
+    threads.emplace_back([&, t]() {
+      auto &o = objects[(t + 1) % nb_threads];
+      for (int i = 0; i < nb_objects / 2; i++) {
+        arena.destroy(o[i]);
+      }
+    });
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  threads.clear();
+  REQUIRE(arena.size() == nb_threads * nb_objects / 2);
+
+  for (std::size_t t = 0; t < nb_threads; t++) {
+    objects[t].erase(objects[t].begin(), objects[t].begin() + nb_objects / 2);
+    threads.emplace_back([&, t]() {
+      std::size_t thread_id = t;
+      for (int i = 0; i < nb_objects / 2; i++) {
+        objects[t].push_back(arena.create(
+            &thread_id, nb_objects + static_cast<int>(t) + i));
+      }
+    });
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+
+  // Objects are allocated without thread_id from the shared free list
+  Counted *shared = arena.create(nullptr, 0);
+  arena.destroy(shared);
+
+  std::set<Counted *> distinct;
+  for (std::size_t t = 0; t < nb_threads; t++) {
+    REQUIRE(objects[t].size() == nb_objects);
+    for (int i = 0; i < nb_objects; i++) {
+      REQUIRE(objects[t][i]->value ==
+              nb_objects / 2 + static_cast<int>(t) + i);
+      distinct.insert(objects[t][i]);
+    }
+  }
+  REQUIRE(distinct.size() == nb_threads * nb_objects);
+
+  for (auto o : distinct) {
+    arena.destroy(o);
+  }
+  REQUIRE(Counted::alive == 0);
+  REQUIRE(arena.release());
+}
+
+TEST_CASE("Node arena allocator", "[node-arena]") {
+  SECTION("Binding to the node type") {
+    // The container allocates another single object before its nodes: each
+    // type gets its own arena
+    skdecide::NodeArenaAllocator<int> allocator;
+    skdecide::NodeArenaAllocator<Proxy> proxy_allocator(allocator);
+    skdecide::NodeArenaAllocator<Node> node_allocator(allocator);
+    Proxy *proxy = proxy_allocator.allocate(1);
+    std::vector<Node *> nodes;
+    for (int i = 0; i < 10; i++) {
+      nodes.push_back(node_allocator.allocate(1));
+    }
+    for (std::size_t i = 1; i < nodes.size(); i++) {
+      REQUIRE(nodes[i] == nodes[i - 1] + 1);
+    }
+    REQUIRE(allocator.memory_usage() == 64 * (sizeof(Proxy) + sizeof(Node)));
+
+    // Arrays go to the standard allocator
+    Node *array = node_allocator.allocate(3);
+    node_allocator.deallocate(array, 3);
+    REQUIRE(allocator.memory_usage() == 64 * (sizeof(Proxy) + sizeof(Node)));
+
+    // Arenas are released when they become empty
+    for (auto n : nodes) {
+      node_allocator.deallocate(n, 1);
+    }
+    REQUIRE(allocator.memory_usage() == 64 * sizeof(Proxy));
+    skdecide::NodeArenaAllocator<Node> other_node_allocator(proxy_allocator);
+    REQUIRE(other_node_allocator == node_allocator);
+    Node *n = other_node_allocator.allocate(1);
+    REQUIRE(allocator.memory_usage() == 64 * (sizeof(Proxy) + sizeof(Node)));
+    node_allocator.deallocate(n, 1);
+    proxy_allocator.deallocate(proxy, 1);
+    REQUIRE(allocator.memory_usage() == 0);
+    REQUIRE(skdecide::NodeArenaAllocator<int>() != allocator);
+  }
+
+  SECTION("Node-based containers") {
+    typedef skdecide::NodeArenaAllocator<int> Allocator;
+    std::unordered_set<int, std::hash<int>, std::equal_to<int>, Allocator> s;
+    std::set<int, std::less<int>, Allocator> o;
+    std::list<int, Allocator> l;
+    for (int i = 0; i < 1000; i++) {
+      s.insert(i);
+      o.insert(i);
+      l.push_back(i);
+    }
+    for (int i = 0; i < 1000; i += 2) {
+      s.erase(i);
+      o.erase(i);
+    }
+    l.remove_if([](int i) { return i % 2 == 0; });
+    REQUIRE(s.size() == 500);
+    REQUIRE(o.size() == 500);
+    REQUIRE(l.size() == 500);
+    for (int i = 0; i < 1000; i++) {
+      REQUIRE((s.count(i) == 1) == (i % 2 == 1));
+    }
+    REQUIRE(o == std::set<int, std::less<int>, Allocator>(l.begin(), l.end()));
+    REQUIRE(s.get_allocator().memory_usage() > 0);
+
+    // Copies get their own arenas
+    auto c = s;
+    REQUIRE(c.get_allocator() != s.get_allocator());
+    REQUIRE(c == s);
+
+    s.clear();
+    o.clear();
+    l.clear();
+    REQUIRE(s.get_allocator().memory_usage() == 0);
+    REQUIRE(o.get_allocator().memory_usage() == 0);
+    REQUIRE(l.get_allocator().memory_usage() == 0);
+    REQUIRE(c.get_allocator().memory_usage() > 0);
+    s.insert(3);
+    REQUIRE(c.count(3) == 1);
+    REQUIRE(s.size() == 1);
+  }
+}
@@ -3,11 +3,209 @@
  * LICENSE file in the root directory of this source tree.
  */
 #include <catch.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <deque>
 #include <filesystem>
+#include <iostream>
+#include <memory>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <clingo.hh>
 
 #include "hub/domain/pddl/pddl.hh"
+#include "hub/domain/pddl/semantics/applicable_actions_generator.hh"
+#include "hub/domain/pddl/semantics/compiled_operator.hh"
+#include "hub/domain/pddl/semantics/packed_state.hh"
+#include "hub/domain/pddl/semantics/successor_generator.hh"
+#include "hub/domain/pddl/semantics/task.hh"
+#include "hub/solver/pddl/pddl_domain_adapter.hh"
 #include "config.h"
 
+namespace {
+
+// Parsed domain and problem of a directory of tests/data/pddl-semantics
+struct LoadedTask {
+  skdecide::pddl::PDDL pddl;
+  std::unique_ptr<skdecide::pddl::Task> task;
+
+  LoadedTask(const std::string &name) {
+    auto dir = std::filesystem::path(SKDECIDE_SOURCE_DIR) / "tests" / "data" /
+               "pddl-semantics" / name;
+    pddl.load(
+        {(dir / "domain.pddl").string(), (dir / "problem.pddl").string()});
+    task = std::make_unique<skdecide::pddl::Task>(pddl.get_domains().front(),
+                                                  pddl.get_problems().front());
+  }
+};
+
+struct StateHash {
+  std::size_t operator()(const skdecide::pddl::State &s) const {
+    return s.hash();
+  }
+};
+
+// States reachable from the initial state in breadth-first order
+std::vector<skdecide::pddl::State>
+reachable_states(const skdecide::pddl::Task &task, std::size_t max_states) {
+  skdecide::pddl::ApplicableActionsGenerator actions(task);
+  skdecide::pddl::SuccessorGenerator successors(task);
+  std::unordered_set<skdecide::pddl::State, StateHash> visited;
+  std::vector<skdecide::pddl::State> states;
+  std::deque<skdecide::pddl::State> open;
+  visited.insert(task.initial_state());
+  open.push_back(task.initial_state());
+  while (!open.empty() && states.size() < max_states) {
+    states.push_back(std::move(open.front()));
+    open.pop_front();
+    for (auto &a : actions.get_applicable_actions(states.back())) {
+      for (auto &s : successors.get_successors(states.back(), a)) {
+        if (visited.insert(s.state).second) {
+          open.push_back(std::move(s.state));
+        }
+      }
+    }
+  }
+  return states;
+}
+
+// Applicable actions computed like before the ground action tree, i.e. by
+// assigning the state to the externals of the task's ASP program and solving
+// it, then checking the preconditions which are not encoded in the program
+class ClingoApplicableActions {
+public:
+  ClingoApplicableActions(const skdecide::pddl::Task &task) : _task(task) {
+    _ctl.add("base", {}, task.generate_asp_program().c_str());
+    _ctl.ground({{"base", {}}});
+  }
+
+  std::vector<std::pair<int, std::vector<int>>>
+  operator()(const skdecide::pddl::State &state) {
+    for (int pid = 0; pid < _task.num_predicates(); ++pid) {
+      std::string name = _task.predicate_name(pid);
+      std::replace(name.begin(), name.end(), '-', '_');
+      for (auto &tuple : state.atoms[pid]) {
+        std::vector<Clingo::Symbol> args;
+        for (int obj_id : tuple) {
+          args.push_back(Clingo::Number(obj_id));
+        }
+        Clingo::Symbol atom =
+            tuple.empty()
+                ? Clingo::Id(name.c_str())
+                : Clingo::Function(name.c_str(), {args.data(), args.size()});
+        _ctl.assign_external(atom, Clingo::TruthValue::True);
+      }
+    }
+
+    std::vector<std::pair<int, std::vector<int>>> result;
+    for (auto &model : _ctl.solve()) {
+      for (auto &sym : model.symbols(Clingo::ShowType::Shown)) {
+        std::string name = sym.name();
+        if (name.substr(0, 11) != "applicable_") {
+          continue;
+        }
+        int action_id = std::stoi(name.substr(11));
+        auto &action = _task.actions()[action_id];
+        skdecide::pddl::Binding binding;
+        std::vector<int> arguments;
+        for (std::size_t i = 0; i < sym.arguments().size(); ++i) {
+          arguments.push_back(sym.arguments()[i].number());
+          binding[action->get_variables()[i]->get_name()] = arguments.back();
+        }
+        if (!action->get_condition() ||
+            action->get_condition()->holds(state, _task, binding)) {
+          result.emplace_back(action_id, std::move(arguments));
+        }
+      }
+    }
+
+    for (auto &sa : _ctl.symbolic_atoms()) {
+      if (sa.is_external()) {
+        _ctl.assign_external(sa.symbol(), Clingo::TruthValue::False);
+      }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+  }
+
+private:
+  const skdecide::pddl::Task &_task;
+  Clingo::Control _ctl;
+};
+
+// Type-consistent argument tuples of an action
+std::vector<std::vector<int>>
+argument_tuples(const skdecide::pddl::Task &task,
+                const skdecide::pddl::Action &action) {
+  std::vector<std::vector<int>> tuples = {{}};
+  for (auto &variable : action.get_variables()) {
+    auto &types = variable->get_types();
+    const std::vector<int> &objects = task.objects_of_type(
+        types.empty() ? "object" : (*types.begin())->get_name());
+    std::vector<std::vector<int>> extended;
+    for (auto &tuple : tuples) {
+      for (int o : objects) {
+        extended.push_back(tuple);
+        extended.back().push_back(o);
+      }
+    }
+    tuples = std::move(extended);
+  }
+  return tuples;
+}
+
+// Outcomes are equal up to their order
+bool same_outcomes(const skdecide::pddl::Effect::Outcomes &outcomes1,
+                   const skdecide::pddl::Effect::Outcomes &outcomes2) {
+  if (outcomes1.size() != outcomes2.size()) {
+    return false;
+  }
+  std::vector<bool> matched(outcomes2.size(), false);
+  for (auto &o1 : outcomes1) {
+    bool found = false;
+    for (std::size_t i = 0; i < outcomes2.size() && !found; ++i) {
+      found = !matched[i] && std::abs(o1.first - outcomes2[i].first) < 1e-9 &&
+              o1.second == outcomes2[i].second;
+      matched[i] = matched[i] || found;
+    }
+    if (!found) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Number of states expanded per second by a breadth-first search
+double expansion_rate(const skdecide::pddl::PddlDeterministicDomain &domain,
+                      std::size_t max_states, std::size_t &nb_states) {
+  typedef skdecide::pddl::PddlState State;
+  auto start = std::chrono::steady_clock::now();
+  std::unordered_set<State, State::Hash, State::Equal> visited;
+  std::deque<State> open;
+  visited.insert(domain.get_initial_state());
+  open.push_back(domain.get_initial_state());
+  nb_states = 0;
+  while (!open.empty() && nb_states < max_states) {
+    State s = std::move(open.front());
+    open.pop_front();
+    nb_states++;
+    for (auto &a : domain.get_applicable_actions(s).get_elements()) {
+      State ns = domain.get_next_state(s, a);
+      if (visited.insert(ns).second) {
+        open.push_back(std::move(ns));
+      }
+    }
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return nb_states / elapsed.count();
+}
+
+} // namespace
+
 TEST_CASE("PDDL", "[pddl]") {
   for (auto &p : std::filesystem::directory_iterator(
            std::string(SKDECIDE_SOURCE_DIR) + "/tests/data/pddl")) {
@@ -84,3 +282,156 @@ TEST_CASE("PDDL+", "[pddl+]") {
     REQUIRE_NOTHROW(pddl.load(domains));
   }
 }
+
+TEST_CASE("PDDL ground action tree", "[pddl]") {
+  for (const char *name : {"rooms", "blocks"}) {
+    LoadedTask loaded(name);
+    const skdecide::pddl::Task &task = *loaded.task;
+    skdecide::pddl::ApplicableActionsGenerator generator(task);
+    ClingoApplicableActions clingo(task);
+
+    bool negative_precondition = false;
+    bool equality_precondition = false;
+    for (auto &state : reachable_states(task, 2000)) {
+      std::vector<std::pair<int, std::vector<int>>> tree_actions;
+      for (auto &a : generator.get_applicable_actions(state)) {
+        tree_actions.emplace_back(a.action_id, a.arguments);
+        const std::string &action_name = task.action_name(a.action_id);
+        negative_precondition |= (action_name == "move");
+        equality_precondition |= (action_name == "inspect");
+      }
+      std::sort(tree_actions.begin(), tree_actions.end());
+      REQUIRE(tree_actions == clingo(state));
+    }
+    if (std::string(name) == "rooms") {
+      // 'move' requires the target room not to be locked, and 'inspect'
+      // requires both its parameters to be equal
+      REQUIRE(negative_precondition);
+      REQUIRE(equality_precondition);
+    }
+  }
+}
+
+TEST_CASE("PDDL packed states", "[pddl]") {
+  for (const char *name : {"rooms", "blocks"}) {
+    LoadedTask loaded(name);
+    const skdecide::pddl::Task &task = *loaded.task;
+    const skdecide::pddl::FactIndex &index = task.fact_index();
+    REQUIRE(index.num_facts() != skdecide::pddl::FactIndex::npos);
+    skdecide::pddl::SuccessorGenerator successors(task);
+    skdecide::pddl::ApplicableActionsGenerator actions(task);
+
+    auto states = reachable_states(task, 500);
+    std::vector<skdecide::pddl::PackedState> packed_states;
+    for (auto &state : states) {
+      // Round trip and hash of the lifted state
+      auto packed = index.pack(state);
+      REQUIRE(packed);
+      REQUIRE(packed->hash == state.zobrist_hash());
+      REQUIRE(index.unpack(*packed) == state);
+      for (std::size_t f = 0; f < index.num_facts(); ++f) {
+        auto [predicate_id, tuple] = index.fact(f);
+        REQUIRE(index.fact_id(predicate_id, tuple) == f);
+        REQUIRE(packed->test(f) ==
+                (state.atoms[predicate_id].count(tuple) > 0));
+      }
+
+      // Incremental updates towards each successor
+      for (auto &a : actions.get_applicable_actions(state)) {
+        for (auto &successor : successors.get_successors(state, a)) {
+          auto expected = index.pack(successor.state);
+          REQUIRE(expected);
+          skdecide::pddl::PackedState updated = *packed;
+          for (std::size_t f = 0; f < index.num_facts(); ++f) {
+            if (expected->test(f) && !updated.test(f)) {
+              index.add(updated, f);
+            } else if (!expected->test(f) && updated.test(f)) {
+              index.remove(updated, f);
+            }
+          }
+          for (std::size_t f = 0; f < index.num_fluents(); ++f) {
+            double value = expected->fluents[f];
+            double current = updated.fluents[f];
+            if (value != current &&
+                !(std::isnan(value) && std::isnan(current))) {
+              index.assign(updated, f, value);
+            }
+          }
+          REQUIRE(updated.hash == successor.state.zobrist_hash());
+          REQUIRE(updated == *expected);
+        }
+      }
+      packed_states.push_back(std::move(*packed));
+    }
+
+    // Packed states are equal iff their lifted states are, and states with or
+    // without a packed copy hash and compare alike
+    typedef skdecide::pddl::PddlState State;
+    for (std::size_t i = 0; i < states.size(); i += 7) {
+      for (std::size_t j = 0; j < states.size(); j += 11) {
+        REQUIRE((packed_states[i] == packed_states[j]) ==
+                (states[i] == states[j]));
+      }
+      State lifted(states[i]);
+      State packed(states[i]);
+      packed.packed = packed_states[i];
+      REQUIRE(State::Hash()(lifted) == State::Hash()(packed));
+      REQUIRE(State::Equal()(lifted, packed));
+      REQUIRE(State::Equal()(packed, packed));
+      if (i + 1 < states.size()) {
+        State other(states[i + 1]);
+        other.packed = packed_states[i + 1];
+        REQUIRE_FALSE(State::Equal()(packed, other));
+      }
+    }
+  }
+}
+
+TEST_CASE("PDDL packed states benchmark", "[pddl][.benchmark]") {
+  LoadedTask loaded("blocks");
+  std::size_t nb_lifted_states = 0;
+  std::size_t nb_packed_states = 0;
+  double lifted_rate = expansion_rate(
+      skdecide::pddl::PddlDeterministicDomain(*loaded.task, 0), 20000,
+      nb_lifted_states);
+  double packed_rate = expansion_rate(
+      skdecide::pddl::PddlDeterministicDomain(*loaded.task), 20000,
+      nb_packed_states);
+  REQUIRE(nb_lifted_states == nb_packed_states);
+  std::cout << "Breadth-first search on blocks world: " << lifted_rate
+            << " nodes/sec with lifted states, " << packed_rate
+            << " nodes/sec with packed states" << std::endl;
+}
+
+TEST_CASE("PDDL compiled operators", "[pddl]") {
+  for (const char *name : {"rooms", "blocks"}) {
+    LoadedTask loaded(name);
+    const skdecide::pddl::Task &task = *loaded.task;
+    std::size_t nb_applied = 0;
+    for (auto &state : reachable_states(task, 300)) {
+      for (std::size_t aid = 0; aid < task.actions().size(); ++aid) {
+        auto &action = task.actions()[aid];
+        auto &compiled = task.compiled_actions()[aid];
+        for (auto &arguments : argument_tuples(task, *action)) {
+          skdecide::pddl::Binding binding;
+          for (std::size_t i = 0; i < arguments.size(); ++i) {
+            binding[action->get_variables()[i]->get_name()] = arguments[i];
+          }
+          REQUIRE(compiled->arguments(binding) == arguments);
+
+          bool lifted_holds =
+              !action->get_condition() ||
+              action->get_condition()->holds(state, task, binding);
+          REQUIRE(compiled->holds(state, task, arguments) == lifted_holds);
+          if (lifted_holds && action->get_effect()) {
+            REQUIRE(same_outcomes(
+                compiled->apply(state, task, arguments),
+                action->get_effect()->apply(state, task, binding)));
+            nb_applied++;
+          }
+        }
+      }
+    }
+    REQUIRE(nb_applied > 0);
+  }
+}
@@ -0,0 +1,141 @@
+/* Copyright (c) AIRBUS and its affiliates.
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "utils/shm_notification_ring.hh"
+
+#ifdef SK_SHM_NOTIFICATION_RING_POSIX
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+// Unique address per test process so that concurrent test runs do not share
+// segments
+std::string ring_address(const std::string &name) {
+  return std::string(skdecide::ShmNotificationRing::address_prefix) +
+         "skdecide_test_" + name + "_" + std::to_string(::getpid());
+}
+
+} // namespace
+
+TEST_CASE("Shared memory notification ring wrap-around",
+          "[shm-notification-ring]") {
+  const std::string address = ring_address("wrap");
+  const std::size_t nb_messages =
+      10 * skdecide::ShmNotificationRing::capacity + 3;
+  {
+    skdecide::ShmNotificationRing producer(address);
+    skdecide::ShmNotificationRing consumer(address);
+
+    // Fills the ring without waiting, then checks that the producer blocks
+    // until the consumer frees a slot
+    for (std::size_t i = 0; i < skdecide::ShmNotificationRing::capacity; i++) {
+      producer.send(std::to_string(i));
+    }
+    std::atomic<bool> sent(false);
+    std::thread t([&producer, &sent]() {
+      producer.send("last");
+      sent.store(true);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    REQUIRE_FALSE(sent.load());
+    REQUIRE(consumer.recv() == "0");
+    t.join();
+    REQUIRE(sent.load());
+    for (std::size_t i = 1; i < skdecide::ShmNotificationRing::capacity; i++) {
+      REQUIRE(consumer.recv() == std::to_string(i));
+    }
+    REQUIRE(consumer.recv() == "last");
+
+    // Producer and consumer threads race over several turns of the ring, with
+    // messages of various lengths (too long ones are truncated)
+    std::thread p([&producer, nb_messages]() {
+      for (std::size_t i = 0; i < nb_messages; i++) {
+        producer.send(std::string(i % 2000, 'a' + (i % 26)));
+      }
+    });
+    for (std::size_t i = 0; i < nb_messages; i++) {
+      std::size_t size =
+          std::min(i % 2000, skdecide::ShmNotificationRing::slot_size);
+      REQUIRE(consumer.recv() == std::string(size, 'a' + (i % 26)));
+    }
+    p.join();
+  }
+  skdecide::ShmNotificationRing::unlink(address);
+}
+
+TEST_CASE("Shared memory notification ring across processes",
+          "[shm-notification-ring]") {
+  const std::string requests = ring_address("requests");
+  const std::string replies = ring_address("replies");
+  const int nb_round_trips = 1000;
+
+  pid_t pid = ::fork();
+  REQUIRE(pid >= 0);
+  if (pid == 0) {
+    // Child process: echoes requests until it receives "stop"; it must not
+    // return into the test framework
+    int status = 0;
+    try {
+      skdecide::ShmNotificationRing in(requests);
+      skdecide::ShmNotificationRing out(replies);
+      for (std::string m = in.recv(); m != "stop"; m = in.recv()) {
+        out.send(m);
+      }
+    } catch (...) {
+      status = 1;
+    }
+    ::_exit(status);
+  }
+
+  {
+    // Either side may create the segments
+    skdecide::ShmNotificationRing out(requests);
+    skdecide::ShmNotificationRing in(replies);
+    for (int i = 0; i < nb_round_trips; i++) {
+      out.send(std::to_string(i));
+      REQUIRE(in.recv() == std::to_string(i));
+    }
+    out.send("stop");
+  }
+  int status = -1;
+  REQUIRE(::waitpid(pid, &status, 0) == pid);
+  REQUIRE(WIFEXITED(status));
+  REQUIRE(WEXITSTATUS(status) == 0);
+  skdecide::ShmNotificationRing::unlink(requests);
+  skdecide::ShmNotificationRing::unlink(replies);
+}
+
+TEST_CASE("Shared memory notification ring closed while receiving",
+          "[shm-notification-ring]") {
+  const std::string address = ring_address("close");
+  {
+    skdecide::ShmNotificationRing consumer(address);
+    std::atomic<bool> thrown(false);
+    std::thread t([&consumer, &thrown]() {
+      try {
+        consumer.recv();
+      } catch (const std::runtime_error &) {
+        thrown.store(true);
+      }
+    });
+    // Lets the receiver go past its spinning phase and sleep
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    consumer.close();
+    t.join();
+    REQUIRE(thrown.load());
+    REQUIRE_THROWS_AS(consumer.recv(), std::runtime_error);
+    REQUIRE_THROWS_AS(consumer.send("0"), std::runtime_error);
+    consumer.close(); // closing twice is harmless
+  }
+  skdecide::ShmNotificationRing::unlink(address);
+}
+#endif
@@ -434,6 +434,15 @@ class EnumerableTransitions(UncertainTransitions):
             In the Markovian case (memory only holds last state $s$), given an action $a$, this function can
             be mathematically represented by $P(S'|s, a)$, where $S'$ is the next state random variable.
 
+        !!! tip
+            C++ solvers enumerating the state space layer by layer (e.g. VI and PI) send all the queries of a layer
+            at once to a method `get_next_state_distribution_batch(memories, actions)` if the domain defines one,
+            where `memories` and `actions` are lists of the same length, and which must return the list of the
+            corresponding distributions (in the same order). Methods `get_applicable_actions_batch(memories)`,
+            `get_transition_value_batch(memories, actions, next_states)`, `is_goal_batch(states)` and
+            `is_terminal_batch(states)` can be defined likewise. Otherwise, the solvers call this method for each
+            query.
+
         # Parameters
         memory: The source memory (state or history) of the transition.
         action: The action taken in the given memory (state or history) triggering the transition.
@@ -18,18 +18,22 @@ class ParallelSolver:
         self,
         parallel: bool = False,
         shared_memory_proxy=None,
+        ipc_transport: str = "nng",
     ):
         """Creates a parallelizable solver
 
         # Parameters
         parallel: True if the solver is run in parallel mode.
         shared_memory_proxy: Shared memory proxy to use if not None, otherwise run piped parallel domains.
+        ipc_transport: Transport used by the parallel domains to notify C++ solvers of the end of their jobs,
+            either "nng" (pipeline sockets) or "shm" (shared memory ring buffers, POSIX systems only).
 
 
 
         """
         self._parallel = parallel
         self._shared_memory_proxy = shared_memory_proxy
+        self._ipc_transport = ipc_transport
         self._domain = None
         self._lambdas = []  # to define in the inherited class!
         self._ipc_notify = False  # to define in the inherited class!
@@ -47,6 +51,7 @@ class ParallelSolver:
                     self._domain_factory,
                     lambdas=self._lambdas,
                     ipc_notify=self._ipc_notify,
+                    ipc_transport=self._ipc_transport,
                 )
             else:
                 self._domain = ShmParallelDomain(
@@ -54,6 +59,7 @@ class ParallelSolver:
                     self._shared_memory_proxy,
                     lambdas=self._lambdas,
                     ipc_notify=self._ipc_notify,
+                    ipc_transport=self._ipc_transport,
                 )
             # Launch parallel domains before created the algorithm object
             # otherwise spawning new processes (the default on Windows)
@@ -61,6 +61,7 @@ try:
             shared_memory_proxy=None,
             callback: Callable[[BFWS], bool] = lambda slv: False,
             verbose: bool = False,
+            ipc_transport: str = "nng",
         ) -> None:
             """Construct a BFWS solver instance
 
@@ -80,12 +81,16 @@ try:
                 and returning true if the solver must be stopped. Defaults to (lambda slv: False).
             verbose (bool, optional): Boolean indicating whether verbose messages should be
                 logged (True) or not (False). Defaults to False.
+            ipc_transport (str, optional): Transport used by the parallel domains to notify the solver of the end of
+                their jobs, either "nng" (pipeline sockets) or "shm" (shared memory ring buffers, POSIX systems only).
+                Defaults to "nng".
             """
             Solver.__init__(self, domain_factory=domain_factory)
             ParallelSolver.__init__(
                 self,
                 parallel=parallel,
                 shared_memory_proxy=shared_memory_proxy,
+                ipc_transport=ipc_transport,
             )
             self._lambdas = [
                 state_features,
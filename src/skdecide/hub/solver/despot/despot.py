@@ -80,6 +80,7 @@ try:
             callback: Callable[[DESPOT, Optional[int]], bool] = lambda slv,
             i=None: False,
             verbose: bool = False,
+            ipc_transport: str = "nng",
         ) -> None:
             """Construct a DESPOT solver instance.
 
@@ -119,12 +120,16 @@ try:
                 solver and an optional thread_id (int or None) as arguments,
                 returning True to stop. Defaults to never stop.
             verbose: Whether to log verbose messages. Defaults to False.
+            ipc_transport: Transport used by the parallel domains to notify the solver of the end of their jobs,
+                either "nng" (pipeline sockets) or "shm" (shared memory ring buffers, POSIX systems only).
+                Defaults to "nng".
             """
             Solver.__init__(self, domain_factory=domain_factory)
             ParallelSolver.__init__(
                 self,
                 parallel=parallel,
                 shared_memory_proxy=shared_memory_proxy,
+                ipc_transport=ipc_transport,
             )
             self._ipc_notify = True
 
@@ -71,6 +71,7 @@ try:
             shared_memory_proxy=None,
             callback: Callable[[EHC], bool] = lambda slv: False,
             verbose: bool = False,
+            ipc_transport: str = "nng",
         ) -> None:
             """Construct an EHC solver instance.
 
@@ -90,12 +91,16 @@ try:
                 solver as argument. Returns True to stop. Defaults to
                 never stop.
             verbose: Enable verbose logging. Defaults to False.
+            ipc_transport: Transport used by the parallel domains to notify the solver of the end of their jobs,
+                either "nng" (pipeline sockets) or "shm" (shared memory ring buffers, POSIX systems only).
+                Defaults to "nng".
             """
             Solver.__init__(self, domain_factory=domain_factory)
             ParallelSolver.__init__(
                 self,
                 parallel=parallel,
                 shared_memory_proxy=shared_memory_proxy,
+                ipc_transport=ipc_transport,
             )
             self._lambdas = [heuristic]
             if preferred_actions is not None:
@@ -79,6 +79,7 @@ try:
             shared_memory_proxy=None,
             callback: Callable[[FRET], bool] = lambda slv: False,
             verbose: bool = False,
+            ipc_transport: str = "nng",
         ) -> None:
             """Construct a FRET solver instance.
 
@@ -102,6 +103,9 @@ try:
             callback: Called after each FRET iteration. Returns True
                 to stop.
             verbose: Enable verbose logging. Defaults to False.
+            ipc_transport: Transport used by the parallel domains to notify the solver of the end of their jobs,
+                either "nng" (pipeline sockets) or "shm" (shared memory ring buffers, POSIX systems only).
+                Defaults to "nng".
             """
             if inner_solver_factory is None:
                 inner_solver_factory = lambda: ("LRTDP", {})
@@ -112,6 +116,7 @@ try:
                 self,
                 parallel=parallel,
                 shared_memory_proxy=shared_memory_proxy,
+                ipc_transport=ipc_transport,
             )
             self._lambdas = [heuristic]
             self._ipc_notify = True
@@ -74,6 +74,7 @@ try:
             shared_memory_proxy=None,
             callback: Callable[[GPCI], bool] = lambda slv: False,
             verbose: bool = False,
+            ipc_transport: str = "nng",
         ) -> None:
             """Construct a GPCI solver instance.
 
@@ -92,12 +93,16 @@ try:
                 Defaults to never stop.
             verbose: Whether verbose messages should be logged.
                 Defaults to False.
+            ipc_transport: Transport used by the parallel domains to notify the solver of the end of their jobs,
+                either "nng" (pipeline sockets) or "shm" (shared memory ring buffers, POSIX systems only).
+                Defaults to "nng".
             """
             Solver.__init__(self, domain_factory=domain_factory)
             ParallelSolver.__init__(
                 self,
                 parallel=parallel,
                 shared_memory_proxy=shared_memory_proxy,
+                ipc_transport=ipc_transport,
             )
             self._ipc_notify = True
 
@@ -86,6 +86,7 @@ try:
             parallel: bool = False,
             callback: Callable[[HSVI], bool] = lambda slv: False,
             verbose: bool = False,
+            model_cache_path: Optional[str] = None,
         ) -> None:
             """Construct an HSVI solver instance.
 
@@ -108,6 +109,14 @@ try:
             callback: Function called at each iteration. Return True to stop.
                 Defaults to never stop.
             verbose: Whether to log progress messages. Defaults to False.
+            model_cache_path: Path of a file caching the model queried from the
+                domain, loaded instead of querying the domain when it was saved
+                for the same states and actions, and saved otherwise. Delete it
+                when the dynamics of the domain change. States, actions and
+                observations are identified in the file and, when a cache is
+                used, by the solver by their str(), which must tell them apart
+                and must not depend on the process (e.g. on hashes or memory
+                addresses). Defaults to None (no cache).
             """
             Solver.__init__(self, domain_factory=domain_factory)
             ParallelSolver.__init__(self, parallel=parallel)
@@ -128,6 +137,7 @@ try:
                 parallel=parallel,
                 callback=callback,
                 verbose=verbose,
+                model_cache_path=model_cache_path or "",
             )
 
         def close(self):
@@ -256,6 +266,7 @@ try:
             callback: Callable[[GoalHSVI], bool] = lambda slv: False,
             verbose: bool = False,
             dead_end_cost: Optional[float] = None,
+            model_cache_path: Optional[str] = None,
         ) -> None:
             """Construct a Goal-HSVI solver instance.
 
@@ -287,6 +298,14 @@ try:
                 If None (default), automatically computed as
                 max_transition_cost * max_sample_depth (undiscounted) or
                 max_transition_cost / (1 - discount) (discounted).
+            model_cache_path: Path of a file caching the model queried from the
+                domain, loaded instead of querying the domain when it was saved
+                for the same states and actions, and saved otherwise. Delete it
+                when the dynamics of the domain change. States, actions and
+                observations are identified in the file and, when a cache is
+                used, by the solver by their str(), which must tell them apart
+                and must not depend on the process (e.g. on hashes or memory
+                addresses). Defaults to None (no cache).
             """
             Solver.__init__(self, domain_factory=domain_factory)
             ParallelSolver.__init__(self, parallel=parallel)
@@ -310,6 +329,7 @@ try:
                 callback=callback,
                 verbose=verbose,
                 dead_end_cost=dead_end_cost,
+                model_cache_path=model_cache_path or "",
             )
 
         def close(self):
@@ -74,6 +74,8 @@ try:
             shared_memory_proxy=None,
             callback: Callable[[ILAOstar], bool] = lambda slv: False,
             verbose: bool = False,
+            ipc_transport: str = "nng",
+            compact_backups: bool = False,
         ) -> None:
             """Construct a ILAO* solver instance
 
@@ -99,12 +101,19 @@ try:
                 the solver must be stopped. Defaults to (lambda slv: False).
             verbose (bool, optional): Boolean indicating whether verbose messages should be
                 logged (True) or not (False). Defaults to False.
+            ipc_transport (str, optional): Transport used by the parallel domains to notify the solver of the end of
+                their jobs, either "nng" (pipeline sockets) or "shm" (shared memory ring buffers, POSIX systems only).
+                Defaults to "nng".
+            compact_backups (bool, optional): When True, value iteration sweeps a snapshot of the best
+                solution graph stored in contiguous arrays instead of the graph nodes, which is faster on
+                large solution graphs. Only used when per_sweep_graph_update is False. Defaults to False.
             """
             Solver.__init__(self, domain_factory=domain_factory)
             ParallelSolver.__init__(
                 self,
                 parallel=parallel,
                 shared_memory_proxy=shared_memory_proxy,
+                ipc_transport=ipc_transport,
             )
             self._lambdas = [heuristic]
             self._ipc_notify = True
@@ -121,6 +130,7 @@ try:
                 discount=discount,
                 epsilon=epsilon,
                 per_sweep_graph_update=per_sweep_graph_update,
+                compact_backups=compact_backups,
                 parallel=parallel,
                 callback=callback,
                 verbose=verbose,
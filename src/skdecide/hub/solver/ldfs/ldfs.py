@@ -93,6 +93,7 @@ try:
             shared_memory_proxy=None,
             callback: Callable[[LDFS], bool] = lambda slv: False,
             verbose: bool = False,
+            ipc_transport: str = "nng",
         ) -> None:
             """Construct a LDFS solver instance
 
@@ -113,18 +114,26 @@ try:
                 When reached, the DFS backtracks as if the state were unsolved.
                 The driver loop retries, so correctness is preserved — only
                 per-iteration work is bounded. Defaults to 0 (unlimited).
-            parallel: Parallelize action-transition generation. Defaults to False.
+            parallel: Run one LDFS lane per parallel domain process, sharing the
+                explored graph, the values and the solved labels; lanes other
+                than the first one try the actions of a state from a random
+                action. With a single domain process, parallelize
+                action-transition generation instead. Defaults to False.
             shared_memory_proxy: The optional shared memory proxy. Defaults to None.
             callback: Lambda function called at the end of each LDFS pass,
                 taking the solver as argument, returning true to stop.
                 Defaults to never stop.
             verbose: Whether verbose messages should be logged. Defaults to False.
+            ipc_transport: Transport used by the parallel domains to notify the solver of the end of their jobs,
+                either "nng" (pipeline sockets) or "shm" (shared memory ring buffers, POSIX systems only).
+                Defaults to "nng".
             """
             Solver.__init__(self, domain_factory=domain_factory)
             ParallelSolver.__init__(
                 self,
                 parallel=parallel,
                 shared_memory_proxy=shared_memory_proxy,
+                ipc_transport=ipc_transport,
             )
             self._lambdas = [heuristic]
             self._ipc_notify = True
@@ -265,6 +274,7 @@ try:
             shared_memory_proxy=None,
             callback: Callable[[LDFS], bool] = lambda slv: False,
             verbose: bool = False,
+            ipc_transport: str = "nng",
         ) -> None:
             """Construct an IDA* solver instance.
 
@@ -282,12 +292,16 @@ try:
                 taking the solver as argument, returning true to stop.
                 Defaults to never stop.
             verbose: Whether verbose messages should be logged. Defaults to False.
+            ipc_transport: Transport used by the parallel domains to notify the solver of the end of their jobs,
+                either "nng" (pipeline sockets) or "shm" (shared memory ring buffers, POSIX systems only).
+                Defaults to "nng".
             """
             Solver.__init__(self, domain_factory=domain_factory)
             ParallelSolver.__init__(
                 self,
                 parallel=parallel,
                 shared_memory_proxy=shared_memory_proxy,
+                ipc_transport=ipc_transport,
             )
             self._lambdas = [heuristic]
             self._ipc_notify = True
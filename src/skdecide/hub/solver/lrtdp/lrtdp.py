@@ -95,6 +95,7 @@ try:
             callback: Callable[[LRTDP, Optional[int]], bool] = lambda slv,
             i=None: False,
             verbose: bool = False,
+            ipc_transport: str = "nng",
         ) -> None:
             """Construct a LRTDP solver instance
 
@@ -138,12 +139,16 @@ try:
                 callback's process ID argument. Defaults to (lambda slv, i=None: False).
             verbose (bool, optional): Boolean indicating whether verbose messages should be logged (True)
                 or not (False). Defaults to False.
+            ipc_transport (str, optional): Transport used by the parallel domains to notify the solver of the end of
+                their jobs, either "nng" (pipeline sockets) or "shm" (shared memory ring buffers, POSIX systems only).
+                Defaults to "nng".
             """
             Solver.__init__(self, domain_factory=domain_factory)
             ParallelSolver.__init__(
                 self,
                 parallel=parallel,
                 shared_memory_proxy=shared_memory_proxy,
+                ipc_transport=ipc_transport,
             )
             self._lambdas = [heuristic]
             self._continuous_planning = continuous_planning
@@ -374,6 +379,7 @@ try:
             callback: Callable[[LRTDP, Optional[int]], bool] = lambda slv,
             i=None: False,
             verbose: bool = False,
+            ipc_transport: str = "nng",
         ) -> None:
             """Construct an LRTA* solver instance.
 
@@ -390,12 +396,16 @@ try:
             shared_memory_proxy: The optional shared memory proxy. Defaults to None.
             callback: Function called at the end of each trial. Defaults to never stop.
             verbose: Whether verbose messages should be logged. Defaults to False.
+            ipc_transport: Transport used by the parallel domains to notify the solver of the end of their jobs,
+                either "nng" (pipeline sockets) or "shm" (shared memory ring buffers, POSIX systems only).
+                Defaults to "nng".
             """
             Solver.__init__(self, domain_factory=domain_factory)
             ParallelSolver.__init__(
                 self,
                 parallel=parallel,
                 shared_memory_proxy=shared_memory_proxy,
+                ipc_transport=ipc_transport,
             )
             self._lambdas = [heuristic]
             self._continuous_planning = True
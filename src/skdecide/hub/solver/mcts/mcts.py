@@ -162,6 +162,8 @@ try:
             shared_memory_proxy=None,
             callback: Callable[[MCTS, Optional[int]], bool] = lambda slv, i=None: False,
             verbose: bool = False,
+            ipc_transport: str = "nng",
+            virtual_loss: float = 0.0,
         ) -> None:
             """Construct a MCTS solver instance
 
@@ -247,12 +249,19 @@ try:
                 callback's process ID argument. Defaults to (lambda slv, i=None: False).
             verbose (bool, optional): Boolean indicating whether verbose messages should be logged (True)
                 or not (False). Defaults to False.
+            ipc_transport (str, optional): Transport used by the parallel domains to notify the solver of the end of
+                their jobs, either "nng" (pipeline sockets) or "shm" (shared memory ring buffers, POSIX systems only).
+                Defaults to "nng".
+            virtual_loss (float, optional): Virtual loss applied by the tree policy to the actions of the trajectories
+                being simulated in parallel execution, which diverts concurrent threads towards other branches of the
+                tree until the trajectories are back-propagated (0.0 deactivates virtual losses). Defaults to 0.0.
             """
             Solver.__init__(self, domain_factory=domain_factory)
             ParallelSolver.__init__(
                 self,
                 parallel=parallel,
                 shared_memory_proxy=shared_memory_proxy,
+                ipc_transport=ipc_transport,
             )
             self._solver = None
             self._domain = None
@@ -270,6 +279,7 @@ try:
                 epsilon=epsilon,
                 discount=discount,
                 ucb_constant=ucb_constant,
+                virtual_loss=virtual_loss,
                 online_node_garbage=online_node_garbage,
                 custom_policy=(
                     None
@@ -509,6 +519,8 @@ try:
             callback: Callable[[HMCTS, Optional[int]], bool] = lambda slv,
             i=None: False,
             verbose: bool = False,
+            ipc_transport: str = "nng",
+            virtual_loss: float = 0.0,
         ):
             """Construct a HMCTS solver instance
 
@@ -587,6 +599,12 @@ try:
                 callback's process ID argument. Defaults to (lambda slv, i=None: False).
             verbose (bool, optional): Boolean indicating whether verbose messages should be logged (True)
                 or not (False). Defaults to False.
+            ipc_transport (str, optional): Transport used by the parallel domains to notify the solver of the end of
+                their jobs, either "nng" (pipeline sockets) or "shm" (shared memory ring buffers, POSIX systems only).
+                Defaults to "nng".
+            virtual_loss (float, optional): Virtual loss applied by the tree policy to the actions of the trajectories
+                being simulated in parallel execution, which diverts concurrent threads towards other branches of the
+                tree until the trajectories are back-propagated (0.0 deactivates virtual losses). Defaults to 0.0.
             """
             super().__init__(
                 domain_factory=domain_factory,
@@ -597,6 +615,7 @@ try:
                 epsilon=epsilon,
                 discount=discount,
                 ucb_constant=ucb_constant,
+                virtual_loss=virtual_loss,
                 online_node_garbage=online_node_garbage,
                 heuristic=lambda d, o: self._value_heuristic(d, o),
                 custom_policy=lambda d, o: self._policy_heuristic(d, o),
@@ -612,6 +631,7 @@ try:
                 continuous_planning=continuous_planning,
                 parallel=parallel,
                 shared_memory_proxy=shared_memory_proxy,
+                ipc_transport=ipc_transport,
                 callback=callback,
                 verbose=verbose,
             )
@@ -712,6 +732,8 @@ try:
             shared_memory_proxy=None,
             callback: Callable[[UCT, Optional[int]], bool] = lambda slv, i=None: False,
             verbose: bool = False,
+            ipc_transport: str = "nng",
+            virtual_loss: float = 0.0,
         ) -> None:
             """Construct a UCT solver instance
 
@@ -768,6 +790,12 @@ try:
                 callback's process ID argument. Defaults to (lambda slv, i=None: False).
             verbose (bool, optional): Boolean indicating whether verbose messages should be logged (True)
                 or not (False). Defaults to False.
+            ipc_transport (str, optional): Transport used by the parallel domains to notify the solver of the end of
+                their jobs, either "nng" (pipeline sockets) or "shm" (shared memory ring buffers, POSIX systems only).
+                Defaults to "nng".
+            virtual_loss (float, optional): Virtual loss applied by the tree policy to the actions of the trajectories
+                being simulated in parallel execution, which diverts concurrent threads towards other branches of the
+                tree until the trajectories are back-propagated (0.0 deactivates virtual losses). Defaults to 0.0.
             """
             super().__init__(
                 domain_factory=domain_factory,
@@ -778,6 +806,7 @@ try:
                 epsilon=epsilon,
                 discount=discount,
                 ucb_constant=ucb_constant,
+                virtual_loss=virtual_loss,
                 online_node_garbage=online_node_garbage,
                 custom_policy=custom_policy,
                 heuristic=heuristic,
@@ -791,6 +820,7 @@ try:
                 continuous_planning=continuous_planning,
                 parallel=parallel,
                 shared_memory_proxy=shared_memory_proxy,
+                ipc_transport=ipc_transport,
                 callback=callback,
                 verbose=verbose,
             )
@@ -839,6 +869,8 @@ try:
             shared_memory_proxy=None,
             callback: Callable[[HUCT, Optional[int]], bool] = lambda slv, i=None: False,
             verbose: bool = False,
+            ipc_transport: str = "nng",
+            virtual_loss: float = 0.0,
         ) -> None:
             """Construct a HUCT solver instance
 
@@ -888,6 +920,12 @@ try:
                 callback's process ID argument. Defaults to (lambda slv, i=None: False).
             verbose (bool, optional): Boolean indicating whether verbose messages should be logged (True)
                 or not (False). Defaults to False.
+            ipc_transport (str, optional): Transport used by the parallel domains to notify the solver of the end of
+                their jobs, either "nng" (pipeline sockets) or "shm" (shared memory ring buffers, POSIX systems only).
+                Defaults to "nng".
+            virtual_loss (float, optional): Virtual loss applied by the tree policy to the actions of the trajectories
+                being simulated in parallel execution, which diverts concurrent threads towards other branches of the
+                tree until the trajectories are back-propagated (0.0 deactivates virtual losses). Defaults to 0.0.
             """
             super().__init__(
                 domain_factory=domain_factory,
@@ -898,6 +936,7 @@ try:
                 epsilon=epsilon,
                 discount=discount,
                 ucb_constant=ucb_constant,
+                virtual_loss=virtual_loss,
                 online_node_garbage=online_node_garbage,
                 heuristic=heuristic,
                 heuristic_confidence=heuristic_confidence,
@@ -911,6 +950,7 @@ try:
                 continuous_planning=continuous_planning,
                 parallel=parallel,
                 shared_memory_proxy=shared_memory_proxy,
+                ipc_transport=ipc_transport,
                 callback=callback,
                 verbose=verbose,
             )
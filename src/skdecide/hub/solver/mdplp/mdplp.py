@@ -70,6 +70,7 @@ try:
             parallel: bool = False,
             callback: Callable[[MDPLP], bool] = lambda slv: False,
             verbose: bool = False,
+            warm_start: bool = True,
         ) -> None:
             """Construct an MDPLP solver instance.
 
@@ -92,6 +93,10 @@ try:
                 during state enumeration.
             callback: Called after solving. Returns True to stop.
             verbose: Enable verbose logging.
+            warm_start: If True, keep the HiGHS instance between calls to
+                solve() and start each LP from the optimal basis of the
+                previous one, so that re-solving after small domain changes
+                takes few simplex iterations. Defaults to True.
             """
             _supported_variants = ("primal", "dual")
             if variant not in _supported_variants:
@@ -122,6 +127,7 @@ try:
                 epsilon=epsilon,
                 lp_infinity=lp_infinity,
                 lp_callback_interval=lp_callback_interval,
+                warm_start=warm_start,
                 parallel=parallel,
                 callback=callback,
                 verbose=verbose,
@@ -164,6 +170,9 @@ try:
         def get_nb_lp_constraints(self) -> int:
             return self._solver.get_nb_lp_constraints()
 
+        def get_nb_lp_iterations(self) -> int:
+            return self._solver.get_nb_lp_iterations()
+
         def get_solving_time(self) -> int:
             return self._solver.get_solving_time()
 
@@ -173,6 +182,12 @@ try:
         def get_callback_event(self) -> str:
             return self._solver.get_callback_event()
 
+        def clear(self) -> None:
+            """Forget the enumerated states and transitions, so that the next
+            solve() reads the (possibly modified) domain again. The optimal LP
+            basis is kept to warm-start the next LP."""
+            self._solver.clear()
+
     class D_SSP(
         Domain,
         SingleAgent,
@@ -215,6 +230,7 @@ try:
             parallel: bool = False,
             callback: Callable[[SSPLP], bool] = lambda slv: False,
             verbose: bool = False,
+            warm_start: bool = True,
         ) -> None:
             """Construct an SSPLP solver instance.
 
@@ -235,6 +251,10 @@ try:
                 during state enumeration.
             callback: Called after solving. Returns True to stop.
             verbose: Enable verbose logging.
+            warm_start: If True, keep the HiGHS instance between calls to
+                solve() and start each LP from the optimal basis of the
+                previous one, so that re-solving after small domain changes
+                takes few simplex iterations. Defaults to True.
             """
             _supported_variants = ("primal", "dual")
             if variant not in _supported_variants:
@@ -257,6 +277,7 @@ try:
                 epsilon=epsilon,
                 lp_infinity=lp_infinity,
                 lp_callback_interval=lp_callback_interval,
+                warm_start=warm_start,
                 parallel=parallel,
                 callback=callback,
                 verbose=verbose,
@@ -301,6 +322,9 @@ try:
         def get_nb_lp_constraints(self) -> int:
             return self._solver.get_nb_lp_constraints()
 
+        def get_nb_lp_iterations(self) -> int:
+            return self._solver.get_nb_lp_iterations()
+
         def get_solving_time(self) -> int:
             return self._solver.get_solving_time()
 
@@ -310,6 +334,12 @@ try:
         def get_callback_event(self) -> str:
             return self._solver.get_callback_event()
 
+        def clear(self) -> None:
+            """Forget the enumerated states and transitions, so that the next
+            solve() reads the (possibly modified) domain again. The optimal LP
+            basis is kept to warm-start the next LP."""
+            self._solver.clear()
+
 except ImportError:
     print(
         "Scikit-decide C++ hub library not found. "
@@ -8,6 +8,7 @@ from collections.abc import Callable
 from typing import Optional
 
 from discrete_optimization.generic_tools.hyperparameters.hyperparameter import (
+    CategoricalHyperparameter,
     FloatHyperparameter,
 )
 
@@ -48,10 +49,12 @@ try:
         """Policy Iteration solver for Markov Decision Processes.
 
         Enumerates all reachable states via BFS from the initial state, then
-        alternates between policy evaluation (Gauss-Seidel sweeps computing
-        V^pi) and policy improvement (greedy action selection maximizing
-        Q(s,a) = R(s,a) + gamma * sum_s' P(s'|s,a) * V(s')) until the
-        policy stabilizes.
+        compiles the enumerated MDP once in compressed sparse row layout and
+        alternates between policy evaluation (solving the linear system
+        (I - gamma * P_pi) V^pi = R_pi with Gauss-Seidel sweeps or BiCGSTAB,
+        warm-started from the previous values) and policy improvement
+        (greedy action selection maximizing Q(s,a) = R(s,a) + gamma *
+        sum_s' P(s'|s,a) * V(s')) until the policy stabilizes.
 
         Terminal states (where is_terminal() returns true) are absorbing;
         their value is set by the terminal_value functor (defaults to
@@ -74,6 +77,10 @@ try:
         hyperparameters = [
             FloatHyperparameter(name="discount"),
             FloatHyperparameter(name="epsilon"),
+            CategoricalHyperparameter(
+                name="evaluation_mode",
+                choices=["gauss_seidel", "bicgstab"],
+            ),
         ]
 
         def __init__(
@@ -95,6 +102,8 @@ try:
             shared_memory_proxy=None,
             callback: Callable[[PI], bool] = lambda slv: False,
             verbose: bool = False,
+            ipc_transport: str = "nng",
+            evaluation_mode: str = "gauss_seidel",
         ) -> None:
             """Construct a Policy Iteration solver instance
 
@@ -114,11 +123,11 @@ try:
             discount: Value function's discount factor. Defaults to 0.999.
             epsilon: Maximum Bellman error for policy evaluation convergence.
                 Defaults to 0.001.
-            max_eval_sweeps: Maximum number of Gauss-Seidel sweeps per policy
-                evaluation phase. 0 means unlimited (exact evaluation until
-                convergence). A positive value yields modified policy iteration,
-                which can prevent divergence when discount=1.0 and the current
-                policy has cycles. Defaults to 0.
+            max_eval_sweeps: Maximum number of Gauss-Seidel sweeps (or BiCGSTAB
+                iterations) per policy evaluation phase. 0 means unlimited (exact
+                evaluation until convergence). A positive value yields modified policy
+                iteration, which can prevent divergence when discount=1.0 and the
+                current policy has cycles. Defaults to 0.
             parallel: Parallelize evaluation sweeps on different processes.
                 Defaults to False.
             shared_memory_proxy: The optional shared memory proxy. Defaults to None.
@@ -126,12 +135,29 @@ try:
                 iteration, taking the solver as argument, returning true to stop.
                 Defaults to never stop.
             verbose: Whether verbose messages should be logged. Defaults to False.
+            ipc_transport: Transport used by the parallel domains to notify the solver of the end of their jobs,
+                either "nng" (pipeline sockets) or "shm" (shared memory ring buffers, POSIX systems only).
+                Defaults to "nng".
+            evaluation_mode: Linear solver of the policy evaluation phase.
+                "gauss_seidel" runs in-place sweeps over the states, "bicgstab" runs
+                the Jacobi-preconditioned BiCGSTAB Krylov solver and falls back to
+                Gauss-Seidel sweeps if it breaks down or does not converge (e.g. for
+                policies that never reach a terminal state when discount=1.0).
+                Defaults to "gauss_seidel".
             """
+            _supported_evaluation_modes = ("gauss_seidel", "bicgstab")
+            if evaluation_mode not in _supported_evaluation_modes:
+                raise ValueError(
+                    f"PI evaluation_mode must be one of {_supported_evaluation_modes}, "
+                    f"got '{evaluation_mode}'."
+                )
+
             Solver.__init__(self, domain_factory=domain_factory)
             ParallelSolver.__init__(
                 self,
                 parallel=parallel,
                 shared_memory_proxy=shared_memory_proxy,
+                ipc_transport=ipc_transport,
             )
             self._lambdas = [heuristic]
             if initial_policy is not None:
@@ -155,6 +181,7 @@ try:
                 discount=discount,
                 epsilon=epsilon,
                 max_eval_sweeps=max_eval_sweeps,
+                evaluation_mode=evaluation_mode,
                 parallel=parallel,
                 callback=callback,
                 verbose=verbose,
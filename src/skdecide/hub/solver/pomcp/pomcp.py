@@ -84,6 +84,8 @@ try:
             shared_memory_proxy=None,
             callback: Callable[[POMCP], bool] = lambda slv: False,
             verbose: bool = False,
+            ipc_transport: str = "nng",
+            virtual_loss: float = 0.0,
         ) -> None:
             """Construct a POMCP solver instance.
 
@@ -112,12 +114,21 @@ try:
                 the solver as argument, returning True to stop.
                 Defaults to never stop.
             verbose: Whether to log verbose messages. Defaults to False.
+            ipc_transport: Transport used by the parallel domains to notify the solver of the end of their jobs,
+                either "nng" (pipeline sockets) or "shm" (shared memory ring buffers, POSIX systems only).
+                Defaults to "nng".
+            virtual_loss: Virtual loss applied to the actions of the
+                simulations in flight in parallel execution, which diverts
+                concurrent simulations towards other branches of the history
+                tree until they are back-propagated (0.0 deactivates virtual
+                losses). Defaults to 0.0.
             """
             Solver.__init__(self, domain_factory=domain_factory)
             ParallelSolver.__init__(
                 self,
                 parallel=parallel,
                 shared_memory_proxy=shared_memory_proxy,
+                ipc_transport=ipc_transport,
             )
             self._ipc_notify = True
 
@@ -132,6 +143,7 @@ try:
                 time_budget=time_budget,
                 num_particles_belief_update=num_particles_belief_update,
                 ess_threshold_ratio=ess_threshold_ratio,
+                virtual_loss=virtual_loss,
                 parallel=parallel,
                 callback=callback,
                 verbose=verbose,
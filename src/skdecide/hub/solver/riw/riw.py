@@ -85,6 +85,7 @@ try:
             shared_memory_proxy=None,
             callback: Callable[[RIW, Optional[int]], bool] = lambda slv, i=None: False,
             verbose: bool = False,
+            ipc_transport: str = "nng",
         ) -> None:
             """Construct a RIW solver instance
 
@@ -136,12 +137,16 @@ try:
                 callback's process ID argument. Defaults to (lambda slv, i=None: False).
             verbose (bool, optional): Boolean indicating whether verbose messages should be logged (True)
                 or not (False). Defaults to False.
+            ipc_transport (str, optional): Transport used by the parallel domains to notify the solver of the end of
+                their jobs, either "nng" (pipeline sockets) or "shm" (shared memory ring buffers, POSIX systems only).
+                Defaults to "nng".
             """
             Solver.__init__(self, domain_factory=domain_factory)
             ParallelSolver.__init__(
                 self,
                 parallel=parallel,
                 shared_memory_proxy=shared_memory_proxy,
+                ipc_transport=ipc_transport,
             )
             self._continuous_planning = continuous_planning
             self._lambdas = [state_features]
@@ -96,6 +96,7 @@ try:
             callback: Callable[[RTDPBel, Optional[int]], bool] = lambda slv,
             i=None: False,
             verbose: bool = False,
+            ipc_transport: str = "nng",
         ) -> None:
             """Construct an RTDP-Bel solver instance.
 
@@ -119,12 +120,16 @@ try:
                 (solver, thread_id). thread_id is None when running
                 sequentially. Defaults to never stop.
             verbose: Whether to log verbose messages. Defaults to False.
+            ipc_transport: Transport used by the parallel domains to notify the solver of the end of their jobs,
+                either "nng" (pipeline sockets) or "shm" (shared memory ring buffers, POSIX systems only).
+                Defaults to "nng".
             """
             Solver.__init__(self, domain_factory=domain_factory)
             ParallelSolver.__init__(
                 self,
                 parallel=parallel,
                 shared_memory_proxy=shared_memory_proxy,
+                ipc_transport=ipc_transport,
             )
             self._lambdas = [heuristic]
             self._ipc_notify = True
@@ -79,6 +79,9 @@ try:
             shared_memory_proxy=None,
             callback: Callable[[SARSOP], bool] = lambda slv: False,
             verbose: bool = False,
+            ipc_transport: str = "nng",
+            model_cache_path: Optional[str] = None,
+            nb_sampling_threads: int = 0,
         ) -> None:
             """Construct a SARSOP solver instance.
 
@@ -113,12 +116,27 @@ try:
                 solver as argument, returning True to stop. Defaults to
                 never stop.
             verbose: Whether to log verbose messages. Defaults to False.
+            ipc_transport: Transport used by the parallel domains to notify the solver of the end of their jobs,
+                either "nng" (pipeline sockets) or "shm" (shared memory ring buffers, POSIX systems only).
+                Defaults to "nng".
+            model_cache_path: Path of a file caching the model queried from the
+                domain, loaded instead of querying the domain when it was saved
+                for the same states and actions, and saved otherwise. Delete it
+                when the dynamics of the domain change. States, actions and
+                observations are identified in the file and, when a cache is
+                used, by the solver by their str(), which must tell them apart
+                and must not depend on the process (e.g. on hashes or memory
+                addresses). Defaults to None (no cache).
+            nb_sampling_threads: Number of threads sampling belief tree trials
+                concurrently when parallel is True, 0 meaning the number of
+                hardware threads. Ignored when parallel is False. Defaults to 0.
             """
             Solver.__init__(self, domain_factory=domain_factory)
             ParallelSolver.__init__(
                 self,
                 parallel=parallel,
                 shared_memory_proxy=shared_memory_proxy,
+                ipc_transport=ipc_transport,
             )
             self._ipc_notify = True
 
@@ -140,6 +158,8 @@ try:
                 parallel=parallel,
                 callback=callback,
                 verbose=verbose,
+                model_cache_path=model_cache_path or "",
+                nb_sampling_threads=nb_sampling_threads,
             )
 
         def close(self):
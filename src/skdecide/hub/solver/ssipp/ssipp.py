@@ -85,6 +85,7 @@ try:
             shared_memory_proxy=None,
             callback: Callable[[SSiPP], bool] = lambda slv: False,
             verbose: bool = False,
+            ipc_transport: str = "nng",
         ) -> None:
             """Construct an SSiPP solver instance.
 
@@ -107,6 +108,9 @@ try:
             shared_memory_proxy: Optional shared memory proxy.
             callback: Called after each sub-SSP solve. Returns True to stop.
             verbose: Enable verbose logging. Defaults to False.
+            ipc_transport: Transport used by the parallel domains to notify the solver of the end of their jobs,
+                either "nng" (pipeline sockets) or "shm" (shared memory ring buffers, POSIX systems only).
+                Defaults to "nng".
             """
             if inner_solver_factory is None:
                 inner_solver_factory = lambda: ("LRTDP", {})
@@ -117,6 +121,7 @@ try:
                 self,
                 parallel=parallel,
                 shared_memory_proxy=shared_memory_proxy,
+                ipc_transport=ipc_transport,
             )
             self._lambdas = [heuristic]
             self._ipc_notify = True
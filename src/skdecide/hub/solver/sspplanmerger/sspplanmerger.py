@@ -89,6 +89,7 @@ try:
             callback: Callable[[SSPPlanMerger, Optional[int]], bool] = lambda slv,
             i=None: False,
             verbose: bool = False,
+            ipc_transport: str = "nng",
         ) -> None:
             """Construct an SSPPlanMerger solver instance.
 
@@ -121,6 +122,9 @@ try:
             callback: Called after each iteration; return True to stop.
                 Defaults to never stop.
             verbose: Log progress messages. Defaults to False.
+            ipc_transport: Transport used by the parallel domains to notify the solver of the end of their jobs,
+                either "nng" (pipeline sockets) or "shm" (shared memory ring buffers, POSIX systems only).
+                Defaults to "nng".
             """
             if inner_solver_factory is None:
                 inner_solver_factory = lambda: ("Astar", {})
@@ -131,6 +135,7 @@ try:
                 self,
                 parallel=parallel,
                 shared_memory_proxy=shared_memory_proxy,
+                ipc_transport=ipc_transport,
             )
             self._continuous_planning = continuous_planning
             self._lambdas = [heuristic]
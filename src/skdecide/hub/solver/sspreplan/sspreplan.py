@@ -76,6 +76,7 @@ try:
             callback: Callable[[SSPReplan, Optional[int]], bool] = lambda slv,
             i=None: False,
             verbose: bool = False,
+            ipc_transport: str = "nng",
         ) -> None:
             """Construct an SSPReplan solver instance.
 
@@ -98,6 +99,9 @@ try:
             callback: Called after each replan; return True to stop.
                 Defaults to never stop.
             verbose: Log progress messages. Defaults to False.
+            ipc_transport: Transport used by the parallel domains to notify the solver of the end of their jobs,
+                either "nng" (pipeline sockets) or "shm" (shared memory ring buffers, POSIX systems only).
+                Defaults to "nng".
             """
             if inner_solver_factory is None:
                 inner_solver_factory = lambda: ("Astar", {})
@@ -108,6 +112,7 @@ try:
                 self,
                 parallel=parallel,
                 shared_memory_proxy=shared_memory_proxy,
+                ipc_transport=ipc_transport,
             )
             self._lambdas = [heuristic]
             self._ipc_notify = True
@@ -8,6 +8,7 @@ from collections.abc import Callable
 from typing import Optional
 
 from discrete_optimization.generic_tools.hyperparameters.hyperparameter import (
+    CategoricalHyperparameter,
     FloatHyperparameter,
 )
 
@@ -72,6 +73,10 @@ try:
         hyperparameters = [
             FloatHyperparameter(name="discount"),
             FloatHyperparameter(name="epsilon"),
+            CategoricalHyperparameter(
+                name="sweep_mode",
+                choices=["jacobi", "gauss_seidel", "prioritized", "topological"],
+            ),
         ]
 
         def __init__(
@@ -90,6 +95,8 @@ try:
             shared_memory_proxy=None,
             callback: Callable[[VI], bool] = lambda slv: False,
             verbose: bool = False,
+            ipc_transport: str = "nng",
+            sweep_mode: str = "jacobi",
         ) -> None:
             """Construct a Value Iteration solver instance
 
@@ -106,7 +113,8 @@ try:
             max_sweeps: Maximum number of Bellman sweeps. Only active when
                 discount=1.0 to prevent divergence on non-contracting problems.
                 Ignored when discount < 1.0 (convergence is guaranteed).
-                0 means unlimited. Defaults to 0.
+                0 means unlimited. In "topological" mode, it bounds the number of sweeps
+                of each strongly connected component. Defaults to 0.
             discount: Value function's discount factor. Defaults to 1.0.
             epsilon: Maximum Bellman error allowed to decide convergence.
                 Defaults to 0.001.
@@ -115,12 +123,34 @@ try:
             callback: Lambda function called at the end of each Bellman sweep,
                 taking the solver as argument, returning true to stop. Defaults to never stop.
             verbose: Whether verbose messages should be logged. Defaults to False.
+            ipc_transport: Transport used by the parallel domains to notify the solver of the end of their jobs,
+                either "nng" (pipeline sockets) or "shm" (shared memory ring buffers, POSIX systems only).
+                Defaults to "nng".
+            sweep_mode: Order of the Bellman backups. "jacobi" runs synchronous sweeps
+                over all states, "gauss_seidel" runs in-place sweeps over all states,
+                "prioritized" repeatedly backs up the state with the largest bound on its
+                Bellman residual, and "topological" runs in-place sweeps on each strongly
+                connected component of the state graph in reverse topological order.
+                Defaults to "jacobi".
             """
+            _supported_sweep_modes = (
+                "jacobi",
+                "gauss_seidel",
+                "prioritized",
+                "topological",
+            )
+            if sweep_mode not in _supported_sweep_modes:
+                raise ValueError(
+                    f"VI sweep_mode must be one of {_supported_sweep_modes}, "
+                    f"got '{sweep_mode}'."
+                )
+
             Solver.__init__(self, domain_factory=domain_factory)
             ParallelSolver.__init__(
                 self,
                 parallel=parallel,
                 shared_memory_proxy=shared_memory_proxy,
+                ipc_transport=ipc_transport,
             )
             self._lambdas = [heuristic]
             self._ipc_notify = True
@@ -137,6 +167,7 @@ try:
                 discount=discount,
                 epsilon=epsilon,
                 max_sweeps=max_sweeps,
+                sweep_mode=sweep_mode,
                 parallel=parallel,
                 callback=callback,
                 verbose=verbose,
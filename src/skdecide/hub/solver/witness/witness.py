@@ -76,6 +76,7 @@ try:
             shared_memory_proxy=None,
             callback: Callable[[Witness], bool] = lambda slv: False,
             verbose: bool = False,
+            ipc_transport: str = "nng",
         ) -> None:
             """Construct a Witness solver instance.
 
@@ -98,12 +99,16 @@ try:
                 solver as argument, returning True to stop. Defaults to
                 never stop.
             verbose: Whether to log verbose messages. Defaults to False.
+            ipc_transport: Transport used by the parallel domains to notify the solver of the end of their jobs,
+                either "nng" (pipeline sockets) or "shm" (shared memory ring buffers, POSIX systems only).
+                Defaults to "nng".
             """
             Solver.__init__(self, domain_factory=domain_factory)
             ParallelSolver.__init__(
                 self,
                 parallel=parallel,
                 shared_memory_proxy=shared_memory_proxy,
+                ipc_transport=ipc_transport,
             )
             self._ipc_notify = True
 
@@ -26,11 +26,21 @@ class ParallelDomain:
     Each domain listens for incoming domain requests.
     Each request can indicate which domain should serve it, otherwise the first available
     domain i is chosen and its id is returned to the incoming request.
+    When ipc_notify is True, each domain notifies the end of its jobs to the (C++) caller
+    through the ipc_transport, either "nng" (pipeline sockets) or "shm" (lock-free ring
+    buffers in shared memory, lower latency but only available on POSIX systems).
     """
 
     def __init__(
-        self, domain_factory, lambdas=None, nb_domains=os.cpu_count(), ipc_notify=False
+        self,
+        domain_factory,
+        lambdas=None,
+        nb_domains=os.cpu_count(),
+        ipc_notify=False,
+        ipc_transport="nng",
     ):
+        if ipc_transport not in ("nng", "shm"):
+            raise ValueError(f"Unknown IPC transport {ipc_transport}")
         self._domain_factory = domain_factory
         self._lambdas = lambdas
         self._active_domains = mp.Array(
@@ -44,12 +54,24 @@ class ParallelDomain:
         self._ipc_connections = [None] * nb_domains
         self._processes = [None] * nb_domains
         self._ipc_notify = ipc_notify
+        self._ipc_transport = ipc_transport
 
     def open_ipc_connection(self, i):
         self._temp_connections[i] = tempfile.NamedTemporaryFile(delete=True)
-        self._ipc_connections[i] = "ipc://" + self._temp_connections[i].name + ".ipc"
+        if self._ipc_transport == "shm":
+            self._ipc_connections[i] = "shm://skdecide_" + os.path.basename(
+                self._temp_connections[i].name
+            )
+        else:
+            self._ipc_connections[i] = (
+                "ipc://" + self._temp_connections[i].name + ".ipc"
+            )
 
     def close_ipc_connection(self, i):
+        if self._ipc_transport == "shm" and self._ipc_notify:
+            from skdecide.hub.__skdecide_hub_cpp import _ShmNotificationRing_
+
+            _ShmNotificationRing_.unlink(self._ipc_connections[i])
         self._temp_connections[i].close()
         self._ipc_connections[i] = None
 
@@ -189,16 +211,26 @@ class ParallelDomain:
         # TODO: reopen the temp connection from _ipc_connections
 
 
+def _open_ipc_pusher_(ipc_conn):
+    if ipc_conn.startswith("shm://"):
+        from skdecide.hub.__skdecide_hub_cpp import _ShmNotificationRing_
+
+        return _ShmNotificationRing_(ipc_conn)
+    else:
+        pusher = Push0()
+        pusher.dial(
+            ipc_conn, block=False
+        )  # WARNING: recent pynng updates only work with non-blocking dials!
+        return pusher
+
+
 def _launch_domain_server_(
     domain_factory, lambdas, i, job_results, conn, init, cond, ipc_conn, logger
 ):
     domain = domain_factory()
 
     if ipc_conn is not None:
-        pusher = Push0()
-        pusher.dial(
-            ipc_conn, block=False
-        )  # WARNING: recent pynng updates only work with non-blocking dials!
+        pusher = _open_ipc_pusher_(ipc_conn)
 
     with cond:
         init.value = True
@@ -238,9 +270,16 @@ class PipeParallelDomain(ParallelDomain):
     """
 
     def __init__(
-        self, domain_factory, lambdas=None, nb_domains=os.cpu_count(), ipc_notify=False
+        self,
+        domain_factory,
+        lambdas=None,
+        nb_domains=os.cpu_count(),
+        ipc_notify=False,
+        ipc_transport="nng",
     ):
-        super().__init__(domain_factory, lambdas, nb_domains, ipc_notify)
+        super().__init__(
+            domain_factory, lambdas, nb_domains, ipc_notify, ipc_transport
+        )
         self._manager = mp.Manager()
         self._waiting_jobs = [None] * nb_domains
         self._job_results = self._manager.list([None for i in range(nb_domains)])
@@ -333,10 +372,7 @@ def _shm_launch_domain_server_(
     domain = domain_factory()
 
     if ipc_conn is not None:
-        pusher = Push0()
-        pusher.dial(
-            ipc_conn, block=False
-        )  # WARNING: recent pynng updates only work with non-blocking dials!
+        pusher = _open_ipc_pusher_(ipc_conn)
 
     with cond:
         init.value = True
@@ -443,8 +479,11 @@ class ShmParallelDomain(ParallelDomain):
         lambdas=None,
         nb_domains=os.cpu_count(),
         ipc_notify=False,
+        ipc_transport="nng",
     ):
-        super().__init__(domain_factory, lambdas, nb_domains, ipc_notify)
+        super().__init__(
+            domain_factory, lambdas, nb_domains, ipc_notify, ipc_transport
+        )
         self._activations = [mp.Value("b", False, lock=True) for i in range(nb_domains)]
         self._dones = [mp.Value("b", False, lock=True) for i in range(nb_domains)]
         self._shm_proxy = shm_proxy
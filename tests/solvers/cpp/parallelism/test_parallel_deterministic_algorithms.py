@@ -2,6 +2,8 @@
 # This source code is licensed under the MIT license found in the
 # LICENSE file in the root directory of this source tree.
 
+import sys
+import time
 from enum import Enum
 from math import sqrt
 from typing import NamedTuple, Optional
@@ -468,28 +470,40 @@ if __name__ == "__main__":
     # Run loop to ask user input
     domain = MyDomain()  # MyDomain(5,5)
 
-    with tqdm(total=len(solvers) * 100) as pbar:
+    # Compares the IPC transports used by the parallel domains to notify the
+    # C++ solvers of the end of their jobs (POSIX shared memory rings are not
+    # available on Windows)
+    ipc_transports = ["nng"] if sys.platform == "win32" else ["nng", "shm"]
+    timings = []
+
+    with tqdm(total=len(solvers) * len(ipc_transports) * 100) as pbar:
         for s in solvers:
             solver_type = s["entry"]
-            for i in range(50):
-                s["config"]["shared_memory_proxy"] = None
-                with solver_type(**s["config"]) as solver:
-                    solver.solve()
-                    rollout(
-                        domain,
-                        solver,
-                        max_steps=50,
-                        outcome_formatter=lambda o: f"{o.observation} - cost: {o.value.cost:.2f}",
-                    )
-                pbar.update(1)
-            for i in range(50):
-                s["config"]["shared_memory_proxy"] = GridShmProxy()
-                with solver_type(**s["config"]) as solver:
-                    solver.solve()
-                    rollout(
-                        domain,
-                        solver,
-                        max_steps=50,
-                        outcome_formatter=lambda o: f"{o.observation} - cost: {o.value.cost:.2f}",
+            for ipc_transport in ipc_transports:
+                s["config"]["ipc_transport"] = ipc_transport
+                for shared_memory in [False, True]:
+                    start = time.perf_counter()
+                    for i in range(50):
+                        s["config"]["shared_memory_proxy"] = (
+                            GridShmProxy() if shared_memory else None
+                        )
+                        with solver_type(**s["config"]) as solver:
+                            solver.solve()
+                            rollout(
+                                domain,
+                                solver,
+                                max_steps=50,
+                                outcome_formatter=lambda o: f"{o.observation} - cost: {o.value.cost:.2f}",
+                            )
+                        pbar.update(1)
+                    timings.append(
+                        (
+                            s["name"],
+                            ipc_transport,
+                            "shm proxy" if shared_memory else "pipes",
+                            (time.perf_counter() - start) / 50,
+                        )
                     )
-                pbar.update(1)
+
+    for name, ipc_transport, domain_ipc, t in timings:
+        print(f"{name} [{ipc_transport} notifications, {domain_ipc}]: {t:.3f}s/run")
@@ -6,6 +6,7 @@ from __future__ import annotations
 
 import inspect
 import logging
+import sys
 from copy import deepcopy
 from enum import Enum
 from math import sqrt
@@ -486,6 +487,30 @@ def test_solver_cpp(parallel, solver_cpp, shared_memory):
     )
 
 
+@pytest.mark.skipif(sys.platform == "win32", reason="POSIX shared memory only")
+def test_solver_cpp_shm_transport(solver_cpp, shared_memory):
+    dom = GridDomain()
+    solver_type = load_registered_solver(solver_cpp["entry"])
+    if "ipc_transport" not in inspect.signature(solver_type.__init__).parameters:
+        pytest.skip(f"Solver {solver_cpp['entry']} does not run parallel domains.")
+    solver_args = deepcopy(solver_cpp["config"])
+    solver_args["parallel"] = True
+    solver_args["ipc_transport"] = "shm"
+    if (
+        "shared_memory_proxy" in inspect.signature(solver_type.__init__).parameters
+        and shared_memory
+    ):
+        solver_args["shared_memory_proxy"] = GridShmProxy()
+    solver_args["domain_factory"] = lambda: GridDomain()
+
+    with solver_type(**solver_args) as slv:
+        assert slv.get_domain()._ipc_transport == "shm"
+        slv.solve()
+        plan, cost = get_plan(dom, slv)
+
+    assert solver_type.check_domain(dom) and len(plan) > 0
+
+
 class MyCallback:
     """Callback for testing.
 
@@ -641,3 +666,46 @@ def test_lrtastar_domain_check():
 
     dom = GridDomain()
     assert LRTAstar.check_domain(dom)
+
+
+# === ILAO* compact backups test ===
+
+
+def test_ilaostar_compact_backups(parallel):
+    """Sweeping the compact best solution graph must give the values and an
+    optimal policy of the default value iteration."""
+    from skdecide.hub.solver.ilaostar import ILAOstar
+
+    results = []
+    for compact_backups in [False, True]:
+        with ILAOstar(
+            domain_factory=lambda: GridDomain(),
+            heuristic=lambda d, s: Value(
+                cost=sqrt((d.num_cols - 1 - s.x) ** 2 + (d.num_rows - 1 - s.y) ** 2)
+            ),
+            discount=1.0,
+            epsilon=0.001,
+            compact_backups=compact_backups,
+            parallel=parallel,
+        ) as solver:
+            solver.solve()
+            results.append(
+                (solver.get_policy(), solver.get_utility(State(x=0, y=0, s=0)))
+            )
+
+    (default_policy, default_value), (compact_policy, compact_value) = results
+    assert compact_value == pytest.approx(default_value)
+    # Ties between equally good actions may be broken differently: follow the
+    # compact policy from the initial state and check that each of its actions
+    # is optimal with respect to the default values
+    dom = GridDomain()
+    s = State(x=0, y=0, s=0)
+    while not dom.is_goal(s):
+        assert s in compact_policy and s in default_policy
+        action, value = compact_policy[s]
+        assert value == pytest.approx(default_policy[s][1])
+        ns = dom.get_next_state(s, action)
+        cost = dom.get_transition_value(s, action, ns).cost
+        next_value = 0.0 if dom.is_goal(ns) else default_policy[ns][1]
+        assert cost + next_value == pytest.approx(default_policy[s][1])
+        s = ns
@@ -414,6 +414,33 @@ class TestGoalHSVI:
 
         assert t >= 0
 
+    def test_model_cache(self, tmp_path):
+        """A solve from the saved model should match a solve from the domain."""
+        from skdecide.hub.solver.hsvi import GoalHSVI
+
+        cache = tmp_path / "tiger_cost.model"
+        point_belief = DiscreteDistribution([(TigerState(tiger_location="left"), 1.0)])
+        results = []
+        for _ in range(2):
+            with GoalHSVI(
+                domain_factory=lambda: TigerDomainCost(),
+                epsilon=0.5,
+                time_budget=30000,
+                max_sample_depth=50,
+                model_cache_path=str(cache),
+            ) as solver:
+                solver.solve()
+                results.append(
+                    (
+                        solver.get_next_action_from_belief(point_belief),
+                        solver.get_utility_from_belief(point_belief).cost,
+                    )
+                )
+            assert cache.exists()
+
+        assert results[0][0] == results[1][0] == TigerAction.open_right
+        assert abs(results[0][1] - results[1][1]) < 1e-9
+
 
 # --- HSVI Tests ---
 
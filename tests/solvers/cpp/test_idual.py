@@ -244,6 +244,31 @@ def rollout(domain, solver, max_steps=100):
     return actions, total_cost, obs
 
 
+def optimal_cost(domain, tolerance=1e-12):
+    """Optimal expected cost from State(0, 0) by Gauss-Seidel value iteration
+    over all the states of a grid domain."""
+    states = [
+        State(x, y) for x in range(domain.num_cols) for y in range(domain.num_rows)
+    ]
+    values = {s: 0.0 for s in states}
+    residual = tolerance + 1.0
+    while residual > tolerance:
+        residual = 0.0
+        for s in states:
+            if domain._is_goal(s):
+                continue
+            best = min(
+                sum(
+                    p * (domain._get_transition_value(s, a, ns).cost + values[ns])
+                    for ns, p in domain._get_next_state_distribution(s, a).get_values()
+                )
+                for a in Action
+            )
+            residual = max(residual, abs(best - values[s]))
+            values[s] = best
+    return values[State(0, 0)]
+
+
 # --- Unconstrained IDual tests ---
 
 
@@ -331,6 +356,43 @@ class TestIDual:
             f"IDual V(s0)={v_idual} should match VI V*(s0)={v_vi}"
         )
 
+    @pytest.mark.parametrize("use_heuristic", [False, True])
+    @pytest.mark.parametrize(
+        "num_cols, num_rows, expected",
+        [
+            (3, 3, 4.999807366311945),
+            (5, 5, 9.807259264021047),
+            (6, 4, 9.690290190423255),
+        ],
+    )
+    def test_incremental_lp_matches_optimal_value(
+        self, num_cols, num_rows, expected, use_heuristic
+    ):
+        """The LP extended with each newly expanded fringe should give the
+        optimal value of the LP over the whole grid."""
+        from skdecide.hub.solver.idual import IDual
+
+        domain = StochasticGridDomain(num_cols, num_rows)
+        assert abs(optimal_cost(domain) - expected) < 1e-9
+
+        kwargs = {}
+        if use_heuristic:
+            kwargs["heuristic"] = lambda d, s: Value(
+                cost=abs(s.x - num_cols + 1) + abs(s.y - num_rows + 1)
+            )
+        with IDual(
+            domain_factory=lambda: StochasticGridDomain(num_cols, num_rows),
+            **kwargs,
+        ) as idual:
+            idual.solve()
+            v_idual = idual.get_utility(State(0, 0)).cost
+            n_lp_iters = idual.get_nb_lp_iterations()
+
+        assert n_lp_iters > 1
+        assert abs(v_idual - expected) < 1e-4, (
+            f"IDual V(s0)={v_idual} should match V*(s0)={expected}"
+        )
+
     def test_stochastic_grid(self):
         """IDual should find near-optimal policy on stochastic grid."""
         from skdecide.hub.solver.idual import IDual
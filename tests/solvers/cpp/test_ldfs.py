@@ -351,6 +351,45 @@ class TestLDFSStochastic:
         assert abs(v_vi.cost - v_ldfs.cost) < 0.1
 
 
+class TestLDFSParallel:
+    """Parallel LDFS lanes share the values and solved labels."""
+
+    def test_matches_sequential_value(self):
+        from skdecide.hub.solver.ldfs import LDFS
+
+        values = []
+        for parallel in (False, True):
+            with LDFS(
+                domain_factory=lambda: StochasticGridDomain(3, 3),
+                heuristic=lambda d, s: Value(cost=abs(2 - s.x) + abs(2 - s.y)),
+                discount=1.0,
+                epsilon=0.001,
+                parallel=parallel,
+            ) as solver:
+                solver.solve()
+                values.append(solver.get_utility(State(0, 0)).cost)
+                assert State(0, 0) in solver.get_solved_states()
+
+        assert abs(values[0] - values[1]) < 0.1
+
+    def test_deterministic_optimal_cost(self):
+        from skdecide.hub.solver.ldfs import LDFS
+
+        dom = DeterministicGridDomain(4, 4)
+
+        with LDFS(
+            domain_factory=lambda: DeterministicGridDomain(4, 4),
+            heuristic=lambda d, s: Value(cost=abs(3 - s.x) + abs(3 - s.y)),
+            discount=1.0,
+            epsilon=0.001,
+            parallel=True,
+        ) as solver:
+            solver.solve()
+            _, cost = rollout(dom, solver)
+
+        assert cost == 6
+
+
 class TestIDAstar:
     """Test IDAstar (LDFS specialization for deterministic domains)."""
 
@@ -172,6 +172,19 @@ class StochasticGridDomain(DBase):
         return State(nx, ny)
 
 
+class SwampGridDomain(StochasticGridDomain):
+    """Stochastic 5x5 grid where leaving a state costs swamp_costs[state]
+    (1 by default). swamp_costs is shared with the test, which changes it
+    between two solves."""
+
+    def __init__(self, swamp_costs):
+        super().__init__(num_cols=5, num_rows=5)
+        self.swamp_costs = swamp_costs
+
+    def _get_transition_value(self, memory, action, next_state=None):
+        return Value(cost=self.swamp_costs.get(memory, 1.0))
+
+
 def rollout(domain, solver, max_steps=100):
     actions = []
     total_cost = 0.0
@@ -302,6 +315,37 @@ class TestMDPLP:
             assert solver.get_nb_lp_constraints() > 0
             assert solver.get_solving_time() >= 0
 
+    @pytest.mark.parametrize("variant", ["primal", "dual"])
+    def test_warm_start(self, variant):
+        """After a cost change, re-solving from the previous basis should give
+        the new optimum in no more simplex iterations than a cold start."""
+        from skdecide.hub.solver.mdplp import MDPLP
+
+        def solve_before_and_after_change(warm_start):
+            swamp_costs = {}
+            with MDPLP(
+                domain_factory=lambda: SwampGridDomain(swamp_costs),
+                variant=variant,
+                discount=0.99,
+                warm_start=warm_start,
+            ) as solver:
+                solver.solve()
+                v_before = solver.get_utility(State(0, 0)).cost
+                swamp_costs[State(2, 2)] = 10.0
+                solver.clear()
+                solver.solve()
+                v_after = solver.get_utility(State(0, 0)).cost
+                return v_before, v_after, solver.get_nb_lp_iterations()
+
+        v_before, v_warm, nb_iterations_warm = solve_before_and_after_change(True)
+        _, v_cold, nb_iterations_cold = solve_before_and_after_change(False)
+
+        # Optimal values computed by value iteration
+        assert abs(v_before - 9.367387769485584) < 1e-4
+        assert abs(v_warm - 9.748818668828227) < 1e-4
+        assert abs(v_cold - v_warm) < 1e-6
+        assert nb_iterations_warm <= nb_iterations_cold
+
     def test_variant_validation(self):
         """Invalid variant should raise ValueError."""
         from skdecide.hub.solver.mdplp import MDPLP
@@ -420,6 +464,36 @@ class TestSSPLP:
             assert solver.get_nb_lp_constraints() > 0
             assert solver.get_solving_time() >= 0
 
+    @pytest.mark.parametrize("variant", ["primal", "dual"])
+    def test_warm_start(self, variant):
+        """After a cost change, re-solving from the previous basis should give
+        the new optimum in no more simplex iterations than a cold start."""
+        from skdecide.hub.solver.mdplp import SSPLP
+
+        def solve_before_and_after_change(warm_start):
+            swamp_costs = {}
+            with SSPLP(
+                domain_factory=lambda: SwampGridDomain(swamp_costs),
+                variant=variant,
+                warm_start=warm_start,
+            ) as solver:
+                solver.solve()
+                v_before = solver.get_utility(State(0, 0)).cost
+                swamp_costs[State(2, 2)] = 10.0
+                solver.clear()
+                solver.solve()
+                v_after = solver.get_utility(State(0, 0)).cost
+                return v_before, v_after, solver.get_nb_lp_iterations()
+
+        v_before, v_warm, nb_iterations_warm = solve_before_and_after_change(True)
+        _, v_cold, nb_iterations_cold = solve_before_and_after_change(False)
+
+        # Optimal values computed by value iteration
+        assert abs(v_before - 9.807259264021045) < 1e-4
+        assert abs(v_warm - 10.215776918576687) < 1e-4
+        assert abs(v_cold - v_warm) < 1e-6
+        assert nb_iterations_warm <= nb_iterations_cold
+
     def test_variant_validation(self):
         """Invalid variant should raise ValueError."""
         from skdecide.hub.solver.mdplp import SSPLP
@@ -14,6 +14,8 @@ from __future__ import annotations
 from enum import Enum
 from typing import NamedTuple
 
+import pytest
+
 from skdecide import (
     DiscreteDistribution,
     Domain,
@@ -400,3 +402,58 @@ class TestPIStochastic:
             v_pi = pi_solver.get_utility(State(0, 0))
 
         assert abs(v_vi.reward - v_pi.reward) < 0.1
+
+
+class TestPIEvaluationModes:
+    """BiCGSTAB evaluation should converge to the same values as Gauss-Seidel."""
+
+    def test_bicgstab_deterministic_optimal_cost(self):
+        from skdecide.hub.solver.pi import PI
+
+        dom = DeterministicGridDomain(4, 4)
+
+        with PI(
+            domain_factory=lambda: DeterministicGridDomain(4, 4),
+            discount=1.0,
+            epsilon=0.001,
+            max_eval_sweeps=100,
+            evaluation_mode="bicgstab",
+        ) as solver:
+            solver.solve()
+            actions, cost = rollout(dom, solver)
+            v = solver.get_utility(State(0, 0))
+
+        assert cost == 6
+        assert abs(v.reward - (-6.0)) < 0.01
+
+    @pytest.mark.parametrize("max_eval_sweeps", [0, 5])
+    def test_stochastic_values_match_gauss_seidel(self, max_eval_sweeps):
+        from skdecide.hub.solver.pi import PI
+
+        def values(mode):
+            with PI(
+                domain_factory=lambda: StochasticGridDomain(3, 3),
+                discount=0.95,
+                epsilon=1e-6,
+                max_eval_sweeps=max_eval_sweeps,
+                evaluation_mode=mode,
+            ) as solver:
+                solver.solve()
+                return {
+                    State(x, y): solver.get_utility(State(x, y)).reward
+                    for x in range(3)
+                    for y in range(3)
+                }
+
+        reference = values("gauss_seidel")
+        for s, v in values("bicgstab").items():
+            assert abs(v - reference[s]) < 1e-3
+
+    def test_unknown_evaluation_mode_raises(self):
+        from skdecide.hub.solver.pi import PI
+
+        with pytest.raises(ValueError):
+            PI(
+                domain_factory=lambda: DeterministicGridDomain(4, 4),
+                evaluation_mode="jacobi",
+            )
@@ -305,6 +305,31 @@ class TestPOMCP:
             defined = solver.is_solution_defined_for_from_belief(belief)
             assert defined
 
+    def test_parallel_simulations(self):
+        """Concurrent simulations with virtual loss should plan and re-root."""
+        from skdecide.hub.solver.pomcp import POMCP
+
+        with POMCP(
+            domain_factory=TigerPOMDP,
+            num_simulations=2000,
+            max_depth=10,
+            discount=0.95,
+            exploration_constant=110.0,
+            virtual_loss=10.0,
+            parallel=True,
+        ) as solver:
+            solver.solve()
+            belief = DiscreteDistribution(
+                [(TigerState("left"), 0.5), (TigerState("right"), 0.5)]
+            )
+            assert solver.get_next_action_from_belief(belief) is not None
+            assert solver.get_nb_tree_nodes() > 0
+            obs = TigerObservation("left")
+            for _ in range(3):
+                action = solver.sample_action(obs)
+                assert action is not None
+            assert solver.get_nb_tree_nodes() > 0
+
     def test_reset_belief(self):
         """reset_belief should not crash."""
         from skdecide.hub.solver.pomcp import POMCP
@@ -323,3 +348,69 @@ class TestPOMCP:
             solver.solve()
             action = solver.sample_action(obs)
             assert action is not None
+
+    def test_parallel_virtual_loss_policy(self):
+        """Concurrent simulations with virtual loss should find the Tiger policy."""
+        from skdecide.hub.solver.pomcp import POMCP
+
+        with POMCP(
+            domain_factory=TigerPOMDP,
+            num_simulations=20000,
+            max_depth=10,
+            discount=0.95,
+            exploration_constant=110.0,
+            virtual_loss=10.0,
+            parallel=True,
+        ) as solver:
+            solver.solve()
+            uniform = DiscreteDistribution(
+                [(TigerState("left"), 0.5), (TigerState("right"), 0.5)]
+            )
+            assert solver.get_next_action_from_belief(uniform) == TigerAction.listen
+            confident = DiscreteDistribution(
+                [(TigerState("left"), 0.99), (TigerState("right"), 0.01)]
+            )
+            assert solver.get_next_action_from_belief(confident) != (
+                TigerAction.open_left
+            )
+
+    def test_observation_episode(self):
+        """Hearing the tiger on the left should never lead to opening the left
+        door, the tree being re-rooted on each (action, observation) pair."""
+        from skdecide.hub.solver.pomcp import POMCP
+
+        for parallel in [False, True]:
+            with POMCP(
+                domain_factory=TigerPOMDP,
+                num_simulations=5000,
+                max_depth=10,
+                discount=0.95,
+                exploration_constant=110.0,
+                virtual_loss=10.0 if parallel else 0.0,
+                parallel=parallel,
+            ) as solver:
+                solver.solve()
+                obs = TigerObservation("left")
+                for _ in range(6):
+                    action = solver.get_next_action(obs)
+                    assert action != TigerAction.open_left
+                    assert solver.get_nb_tree_nodes() > 1
+                    if action != TigerAction.listen:
+                        break
+
+    def test_reset_belief_then_next_action(self):
+        """get_next_action right after reset_belief should rebuild the tree."""
+        from skdecide.hub.solver.pomcp import POMCP
+
+        with POMCP(
+            domain_factory=TigerPOMDP,
+            num_simulations=500,
+            max_depth=20,
+            discount=0.95,
+        ) as solver:
+            solver.solve()
+            obs = TigerObservation("left")
+            solver.get_next_action(obs)
+            solver.reset_belief()
+            assert solver.get_next_action(obs) is not None
+            assert solver.get_nb_tree_nodes() > 0
@@ -15,7 +15,12 @@ Test domain: Tiger POMDP (classic 2-state POMDP benchmark).
 
 from __future__ import annotations
 
+import json
+import os
+import subprocess
+import sys
 from enum import Enum
+from pathlib import Path
 from typing import NamedTuple
 
 from skdecide import (
@@ -137,6 +142,156 @@ class TigerPOMDP(
         return ListSpace([TigerObservation("left"), TigerObservation("right")])
 
 
+# Treasure POMDP: larger than Tiger, so that the beliefs explored by the solver
+# switch between the dense and sparse representations of the C++ solvers
+# (dense when the belief covers at least a quarter of the states)
+NB_BOXES = 8
+
+
+class TreasureState(NamedTuple):
+    box: int  # box of the treasure, or -1 once a box has been opened
+
+
+class TreasureAction(NamedTuple):
+    kind: str  # "check" or "open"
+    box: int
+
+
+class TreasureObservation(NamedTuple):
+    seen: str  # "treasure", "nothing" or "done"
+
+
+class TreasurePOMDP(
+    Domain,
+    SingleAgent,
+    Sequential,
+    EnumerableTransitions,
+    Actions,
+    Markovian,
+    PartiallyObservable,
+    Rewards,
+    UncertainInitialized,
+):
+    """The treasure is hidden in one of NB_BOXES boxes. Checking a box costs 1
+    and tells whether the treasure is in it; opening a box ends the episode
+    with a reward of +10 if the treasure is in it and -10 otherwise."""
+
+    T_state = TreasureState
+    T_observation = TreasureObservation
+    T_event = TreasureAction
+    T_value = float
+    T_predicate = bool
+    T_info = None
+
+    def _get_initial_state_distribution_(self):
+        return DiscreteDistribution(
+            [(TreasureState(i), 1.0 / NB_BOXES) for i in range(NB_BOXES)]
+        )
+
+    def _state_reset(self):
+        return TreasureState(0)
+
+    def _get_next_state_distribution(self, memory, action):
+        if memory.box < 0 or action.kind == "open":
+            return SingleValueDistribution(TreasureState(-1))
+        return SingleValueDistribution(memory)
+
+    def _get_observation_distribution(self, state, action=None):
+        if state.box < 0 or action is None or action.kind == "open":
+            return SingleValueDistribution(TreasureObservation("done"))
+        return SingleValueDistribution(
+            TreasureObservation("treasure" if action.box == state.box else "nothing")
+        )
+
+    def _get_transition_value(self, memory, action, next_state=None):
+        if memory.box < 0:
+            return Value(reward=0)
+        if action.kind == "check":
+            return Value(reward=-1)
+        return Value(reward=10 if action.box == memory.box else -10)
+
+    def _is_terminal(self, state):
+        return False
+
+    def _get_action_space_(self):
+        return ListSpace(
+            [
+                TreasureAction(kind, i)
+                for kind in ("check", "open")
+                for i in range(NB_BOXES)
+            ]
+        )
+
+    def _get_applicable_actions_from(self, memory):
+        return self._get_action_space_()
+
+    def _get_observation_space_(self):
+        return ListSpace(
+            [
+                TreasureObservation("treasure"),
+                TreasureObservation("nothing"),
+                TreasureObservation("done"),
+            ]
+        )
+
+
+def treasure_value(nb_candidates, discount):
+    """Optimal value of the uniform belief over nb_candidates boxes: either
+    open one of them, or check one and go on with the remaining ones."""
+    value = 10.0
+    for k in range(2, nb_candidates + 1):
+        check = -1 + discount * (10.0 / k + (k - 1.0) / k * value)
+        value = max(10.0 * (2.0 / k - 1.0), check)
+    return value
+
+
+# Solves the Tiger POMDP with a model cache in a fresh interpreter, then hears
+# the tiger on the left 4 times, printing the number of queried observation
+# distributions and the last action
+MODEL_CACHE_SCRIPT = """
+import json
+import sys
+
+from skdecide.hub.solver.sarsop import SARSOP
+from test_sarsop import TigerObservation, TigerPOMDP
+
+nb_queries = 0
+
+
+class CountingTigerPOMDP(TigerPOMDP):
+    def _get_observation_distribution(self, state, action=None):
+        global nb_queries
+        nb_queries += 1
+        return super()._get_observation_distribution(state, action)
+
+
+with SARSOP(
+    domain_factory=CountingTigerPOMDP,
+    epsilon=0.5,
+    discount=0.95,
+    time_budget=30000,
+    model_cache_path=sys.argv[1],
+) as solver:
+    solver.solve()
+    for _ in range(4):
+        action = solver.sample_action(TigerObservation("left"))
+print(json.dumps({"nb_queries": nb_queries, "action": action.name}))
+"""
+
+
+def run_model_cache_script(cache, hash_seed):
+    env = dict(os.environ, PYTHONHASHSEED=str(hash_seed))
+    result = subprocess.run(
+        [sys.executable, "-c", MODEL_CACHE_SCRIPT, str(cache)],
+        cwd=Path(__file__).parent,
+        env=env,
+        capture_output=True,
+        text=True,
+        check=True,
+    )
+    return json.loads(result.stdout.strip().splitlines()[-1])
+
+
 # --- Tests ---
 
 
@@ -224,6 +379,33 @@ class TestSARSOP:
                 f"With tiger-left confidence 0.99, expected OpenRight but got {action}"
             )
 
+    def test_solves_larger_pomdp(self):
+        """Beliefs over the 9 states of the treasure POMDP are dense before the
+        first checks and sparse once two boxes or less remain: the values must
+        match the optimal ones on both representations."""
+        from skdecide.hub.solver.sarsop import SARSOP
+
+        with SARSOP(
+            domain_factory=TreasurePOMDP,
+            epsilon=0.1,
+            discount=0.95,
+            time_budget=5000,
+        ) as solver:
+            solver.solve()
+            uniform = DiscreteDistribution(
+                [(TreasureState(i), 1.0 / NB_BOXES) for i in range(NB_BOXES)]
+            )
+            value = solver.get_utility_from_belief(uniform)
+            assert value <= treasure_value(NB_BOXES, 0.95) + 1e-6
+            assert value > treasure_value(NB_BOXES, 0.95) - 0.1
+            assert solver.get_next_action_from_belief(uniform).kind == "check"
+
+            found = DiscreteDistribution([(TreasureState(3), 1.0)])
+            assert solver.get_next_action_from_belief(found) == TreasureAction(
+                "open", 3
+            )
+            assert abs(solver.get_utility_from_belief(found) - 10.0) < 1e-6
+
     def test_statistics(self):
         """Statistics should be reasonable."""
         from skdecide.hub.solver.sarsop import SARSOP
@@ -293,6 +475,117 @@ class TestSARSOP:
             defined = solver.is_solution_defined_for_from_belief(belief)
             assert defined
 
+    def test_pruning_every_iteration(self):
+        """Pruning after each iteration should keep the solution consistent."""
+        from skdecide.hub.solver.sarsop import SARSOP
+
+        with SARSOP(
+            domain_factory=TigerPOMDP,
+            epsilon=0.5,
+            discount=0.95,
+            time_budget=30000,
+            pruning_interval=1,
+        ) as solver:
+            solver.solve()
+            assert solver.get_nb_alpha_vectors() > 0
+            assert solver.get_lower_bound() <= solver.get_upper_bound() + 0.01
+            belief = DiscreteDistribution(
+                [(TigerState("left"), 0.5), (TigerState("right"), 0.5)]
+            )
+            assert solver.get_next_action_from_belief(belief) == TigerAction.listen
+
+    def test_belief_value_convex(self):
+        """Lower bound values should be a convex function of the belief."""
+        from skdecide.hub.solver.sarsop import SARSOP
+
+        with SARSOP(
+            domain_factory=TigerPOMDP,
+            epsilon=0.5,
+            discount=0.95,
+            time_budget=30000,
+        ) as solver:
+            solver.solve()
+
+            def value(p_left):
+                return solver.get_utility_from_belief(
+                    DiscreteDistribution(
+                        [
+                            (TigerState("left"), p_left),
+                            (TigerState("right"), 1.0 - p_left),
+                        ]
+                    )
+                )
+
+            assert value(0.5) <= 0.5 * (value(1.0) + value(0.0)) + 1e-6
+            assert value(0.4) <= 0.5 * (value(0.2) + value(0.6)) + 1e-6
+
+    def test_model_cache(self, tmp_path):
+        """A solve from the saved model should match a solve from the domain."""
+        from skdecide.hub.solver.sarsop import SARSOP
+
+        cache = tmp_path / "tiger.model"
+        belief = DiscreteDistribution(
+            [(TigerState("left"), 0.5), (TigerState("right"), 0.5)]
+        )
+        values = []
+        for _ in range(2):
+            with SARSOP(
+                domain_factory=TigerPOMDP,
+                epsilon=0.5,
+                discount=0.95,
+                time_budget=30000,
+                model_cache_path=str(cache),
+            ) as solver:
+                solver.solve()
+                assert solver.get_next_action_from_belief(belief) == TigerAction.listen
+                values.append(solver.get_utility_from_belief(belief))
+            assert cache.exists()
+
+        assert abs(values[0] - values[1]) < 1e-9
+
+    def test_model_cache_across_processes(self, tmp_path):
+        """A model saved by a process whose string hashes differ (see
+        PYTHONHASHSEED) should be loaded, and its observations should still
+        update the belief."""
+        cache = tmp_path / "tiger.model"
+
+        saved = run_model_cache_script(cache, hash_seed=1)
+        assert cache.exists()
+        assert saved["nb_queries"] > 0
+        assert saved["action"] == "open_right"
+
+        loaded = run_model_cache_script(cache, hash_seed=2)
+        assert loaded["nb_queries"] == 0
+        assert loaded["action"] == "open_right"
+
+    def test_parallel_sampling(self):
+        """Concurrent trials with background pruning should find the policy."""
+        from skdecide.hub.solver.sarsop import SARSOP
+
+        with SARSOP(
+            domain_factory=TigerPOMDP,
+            epsilon=0.5,
+            discount=0.95,
+            time_budget=30000,
+            pruning_interval=1,
+            parallel=True,
+            nb_sampling_threads=4,
+        ) as solver:
+            solver.solve()
+            assert solver.get_lower_bound() <= solver.get_upper_bound() + 0.01
+            assert solver.get_gap() < 5.0
+            uniform = DiscreteDistribution(
+                [(TigerState("left"), 0.5), (TigerState("right"), 0.5)]
+            )
+            assert solver.get_next_action_from_belief(uniform) == TigerAction.listen
+            confident = DiscreteDistribution(
+                [(TigerState("left"), 0.99), (TigerState("right"), 0.01)]
+            )
+            assert (
+                solver.get_next_action_from_belief(confident)
+                == TigerAction.open_right
+            )
+
     def test_reset_belief(self):
         """reset_belief should not crash."""
         from skdecide.hub.solver.sarsop import SARSOP
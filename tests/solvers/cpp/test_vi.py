@@ -18,6 +18,8 @@ from __future__ import annotations
 from enum import Enum
 from typing import NamedTuple
 
+import pytest
+
 from skdecide import (
     DiscreteDistribution,
     Domain,
@@ -171,6 +173,23 @@ class StochasticGridDomain(DBase):
         return State(nx, ny)
 
 
+class BatchedStochasticGridDomain(StochasticGridDomain):
+    """Stochastic grid answering the next state distribution queries of a whole
+    BFS layer at once, and recording the size of each batch."""
+
+    def __init__(self, num_cols=3, num_rows=3, batch_sizes=None, drop_last=False):
+        super().__init__(num_cols, num_rows)
+        self.batch_sizes = batch_sizes if batch_sizes is not None else []
+        self.drop_last = drop_last
+
+    def get_next_state_distribution_batch(self, memories, actions):
+        self.batch_sizes.append(len(memories))
+        distributions = [
+            self.get_next_state_distribution(m, a) for m, a in zip(memories, actions)
+        ]
+        return distributions[:-1] if self.drop_last else distributions
+
+
 # --- Helpers ---
 
 
@@ -381,3 +400,113 @@ class TestVIStochastic:
             _, cost = rollout(dom, solver, max_steps=200)
 
         assert cost > 0  # did something
+
+
+SWEEP_MODES = ["jacobi", "gauss_seidel", "prioritized", "topological"]
+
+
+class TestVISweepModes:
+    """All sweep modes should converge to the same optimal values."""
+
+    @pytest.mark.parametrize("sweep_mode", SWEEP_MODES)
+    def test_deterministic_optimal_value(self, sweep_mode):
+        from skdecide.hub.solver.vi import VI
+
+        with VI(
+            domain_factory=lambda: DeterministicGridDomain(4, 4),
+            discount=1.0,
+            epsilon=0.001,
+            sweep_mode=sweep_mode,
+        ) as solver:
+            solver.solve()
+            v = solver.get_utility(State(0, 0))
+            converged = solver.get_converged_states()
+
+        assert abs(v.reward - (-6.0)) < 0.01
+        assert len(converged) == 16
+
+    @pytest.mark.parametrize("sweep_mode", SWEEP_MODES[1:])
+    def test_stochastic_values_match_jacobi(self, sweep_mode):
+        from skdecide.hub.solver.vi import VI
+
+        def values(mode):
+            with VI(
+                domain_factory=lambda: StochasticGridDomain(3, 3),
+                discount=0.95,
+                epsilon=1e-6,
+                sweep_mode=mode,
+            ) as solver:
+                solver.solve()
+                return {
+                    State(x, y): solver.get_utility(State(x, y)).reward
+                    for x in range(3)
+                    for y in range(3)
+                }
+
+        reference = values("jacobi")
+        for s, v in values(sweep_mode).items():
+            assert abs(v - reference[s]) < 1e-3
+
+    def test_unknown_sweep_mode_raises(self):
+        from skdecide.hub.solver.vi import VI
+
+        with pytest.raises(ValueError):
+            VI(
+                domain_factory=lambda: DeterministicGridDomain(4, 4),
+                sweep_mode="random",
+            )
+
+
+class TestBatchedDomainCalls:
+    """VI and PI send the next state distribution queries of each BFS layer in
+    one call to the domain's get_next_state_distribution_batch() method when it
+    exists, and call get_next_state_distribution() for each query otherwise.
+
+    From (0,0), the BFS layers of the 3x3 grid are the states at distance 0, 1,
+    2 and 3 of (0,0), with 4 actions per state, the goal (2,2) at distance 4
+    being terminal.
+    """
+
+    @staticmethod
+    def solve(solver_name, domain_factory):
+        if solver_name == "vi":
+            from skdecide.hub.solver.vi import VI
+
+            solver = VI(domain_factory=domain_factory, discount=0.95, epsilon=1e-6)
+        else:
+            from skdecide.hub.solver.pi import PI
+
+            solver = PI(
+                domain_factory=domain_factory,
+                discount=0.95,
+                epsilon=1e-6,
+                max_eval_sweeps=1000,
+            )
+        with solver:
+            solver.solve()
+            return {
+                State(x, y): solver.get_utility(State(x, y)).reward
+                for x in range(3)
+                for y in range(3)
+            }
+
+    @pytest.mark.parametrize("solver_name", ["vi", "pi"])
+    def test_batched_values_match_scalar_calls(self, solver_name):
+        batch_sizes = []
+        batched = self.solve(
+            solver_name, lambda: BatchedStochasticGridDomain(3, 3, batch_sizes)
+        )
+        assert batch_sizes == [4, 8, 12, 8]
+
+        scalar = self.solve(solver_name, lambda: StochasticGridDomain(3, 3))
+        assert batched.keys() == scalar.keys()
+        for s, v in batched.items():
+            assert abs(v - scalar[s]) < 1e-6
+
+    @pytest.mark.parametrize("solver_name", ["vi", "pi"])
+    def test_batch_with_missing_results_raises(self, solver_name):
+        with pytest.raises(RuntimeError, match="as many results as queries"):
+            self.solve(
+                solver_name,
+                lambda: BatchedStochasticGridDomain(3, 3, drop_last=True),
+            )